@@ -38,10 +38,24 @@
 #include "dart/collision/CollisionDetector.hpp"
 #include "dart/dynamics/BodyNode.hpp"
 #include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/SoftMeshShape.hpp"
 
 namespace dart {
 namespace collision {
 
+namespace {
+
+//==============================================================================
+bool isDeformable(const dynamics::ConstShapePtr& shape)
+{
+  // The vertices of SoftMeshShape follow the point masses of the SoftBodyNode,
+  // which do not dirty the transform of the ShapeFrame when they move.
+  return shape
+      && shape->getType() == dynamics::SoftMeshShape::getStaticType();
+}
+
+} // anonymous namespace
+
 //==============================================================================
 CollisionGroup::CollisionGroup(const CollisionDetectorPtr& collisionDetector)
   : mCollisionDetector(collisionDetector),
@@ -72,8 +86,12 @@ void CollisionGroup::addShapeFrame(const dynamics::ShapeFrame* shapeFrame)
 void CollisionGroup::addShapeFrames(
     const std::vector<const dynamics::ShapeFrame*>& shapeFrames)
 {
+  std::vector<CollisionObject*> newObjects;
   for (const auto& shapeFrame : shapeFrames)
-    addShapeFrame(shapeFrame);
+    addShapeFrameImpl(shapeFrame, nullptr, &newObjects);
+
+  if (!newObjects.empty())
+    addCollisionObjectsToEngine(newObjects);
 }
 
 //==============================================================================
@@ -88,16 +106,27 @@ void CollisionGroup::subscribeTo()
   // Do nothing
 }
 
+//==============================================================================
+void CollisionGroup::subscribeTo(
+    const std::vector<dynamics::ConstSkeletonPtr>& skeletons)
+{
+  mSkeletonSources.reserve(mSkeletonSources.size() + skeletons.size());
+
+  std::vector<CollisionObject*> newObjects;
+  for (const auto& skeleton : skeletons)
+    subscribeToImpl(skeleton, &newObjects);
+
+  if (!newObjects.empty())
+    addCollisionObjectsToEngine(newObjects);
+}
+
 //==============================================================================
 void CollisionGroup::removeShapeFrame(const dynamics::ShapeFrame* shapeFrame)
 {
   if (!shapeFrame)
     return;
 
-  const auto search
-      = std::find_if(mObjectInfoList.begin(), mObjectInfoList.end(),
-                     [&](const std::unique_ptr<ObjectInfo>& info)
-                     { return info->mFrame == shapeFrame; });
+  const auto search = findObjectInfo(shapeFrame);
 
   if (mObjectInfoList.end() == search)
     return;
@@ -122,7 +151,7 @@ void CollisionGroup::removeShapeFrame(const dynamics::ShapeFrame* shapeFrame)
     mBodyNodeSources.erase(static_cast<const dynamics::BodyNode*>(source));
   }
 
-  mObjectInfoList.erase(search);
+  eraseObjectInfo(search);
   mObserver.removeShapeFrame(shapeFrame);
 }
 
@@ -130,8 +159,51 @@ void CollisionGroup::removeShapeFrame(const dynamics::ShapeFrame* shapeFrame)
 void CollisionGroup::removeShapeFrames(
     const std::vector<const dynamics::ShapeFrame*>& shapeFrames)
 {
-  for (const auto& shapeFrame : shapeFrames)
-    removeShapeFrame(shapeFrame);
+  if (shapeFrames.size() < 2u)
+  {
+    for (const auto& shapeFrame : shapeFrames)
+      removeShapeFrame(shapeFrame);
+
+    return;
+  }
+
+  // Removing the frames one by one would search mObjectInfoList for each of
+  // them, so we compact the list in a single pass instead.
+  const std::unordered_set<const dynamics::ShapeFrame*> toRemove(
+      shapeFrames.begin(), shapeFrames.end());
+
+  auto last = mObjectInfoList.begin();
+  for (auto it = mObjectInfoList.begin(); it != mObjectInfoList.end(); ++it)
+  {
+    ObjectInfo* info = it->get();
+    if (toRemove.find(info->mFrame) == toRemove.end())
+    {
+      if (last != it)
+        *last = std::move(*it);
+      ++last;
+      continue;
+    }
+
+    removeCollisionObjectFromEngine(info->mObject.get());
+
+    // See removeShapeFrame() for why the sources are unsubscribed here.
+    for (const void* source : info->mSources)
+    {
+      if (nullptr == source)
+        continue;
+
+      if (mSkeletonSources.erase(
+            static_cast<const dynamics::MetaSkeleton*>(source)) > 0)
+        continue;
+
+      mBodyNodeSources.erase(static_cast<const dynamics::BodyNode*>(source));
+    }
+
+    mObserver.removeShapeFrame(info->mFrame);
+    mObjectInfoMap.erase(info->mFrame);
+  }
+
+  mObjectInfoList.erase(last, mObjectInfoList.end());
 }
 
 //==============================================================================
@@ -146,6 +218,7 @@ void CollisionGroup::removeAllShapeFrames()
   removeAllCollisionObjectsFromEngine();
 
   mObjectInfoList.clear();
+  mObjectInfoMap.clear();
   mObserver.removeAllShapeFrames();
 }
 
@@ -153,10 +226,7 @@ void CollisionGroup::removeAllShapeFrames()
 bool CollisionGroup::hasShapeFrame(
     const dynamics::ShapeFrame* shapeFrame) const
 {
-  return std::find_if(mObjectInfoList.begin(), mObjectInfoList.end(),
-                      [&](const std::unique_ptr<ObjectInfo>& info)
-                      { return info->mFrame == shapeFrame; })
-      != mObjectInfoList.end();
+  return mObjectInfoMap.find(shapeFrame) != mObjectInfoMap.end();
 }
 
 //==============================================================================
@@ -249,10 +319,7 @@ void CollisionGroup::removeDeletedShapeFrames()
 {
   for(auto shapeFrame : mObserver.mDeletedFrames)
   {
-    const auto search =
-        std::find_if(mObjectInfoList.begin(), mObjectInfoList.end(),
-                     [&](const std::unique_ptr<ObjectInfo>& info)
-                     { return info->mFrame == shapeFrame; });
+    const auto search = findObjectInfo(shapeFrame);
 
     if(mObjectInfoList.end() == search)
       continue;
@@ -279,7 +346,7 @@ void CollisionGroup::removeDeletedShapeFrames()
     }
 
     removeCollisionObjectFromEngine((*search)->mObject.get());
-    mObjectInfoList.erase(search);
+    eraseObjectInfo(search);
   }
 
   mObserver.mDeletedFrames.clear();
@@ -288,9 +355,33 @@ void CollisionGroup::removeDeletedShapeFrames()
 //==============================================================================
 void CollisionGroup::updateEngineData()
 {
+  mMovedObjects.clear();
+
   for (const auto& info : mObjectInfoList)
+  {
+    // Objects that haven't moved since the last update keep their engine data
+    // (and their bounding volumes in the broadphase) as they are.
+    if (!info->mNeedEngineUpdate && !info->mDeformable)
+      continue;
+
+    // Resolve the world transform of the ShapeFrame (and its parents) so that
+    // the next motion of the ShapeFrame is guaranteed to raise a new transform
+    // update notification.
+    info->mFrame->getWorldTransform();
+
     info->mObject->updateEngineData();
+    info->mNeedEngineUpdate = false;
+
+    mMovedObjects.push_back(info->mObject.get());
+  }
+
+  updateMovedCollisionObjectsInEngine(mMovedObjects);
+}
 
+//==============================================================================
+void CollisionGroup::updateMovedCollisionObjectsInEngine(
+    const std::vector<CollisionObject*>& /*movedObjects*/)
+{
   updateCollisionGroupEngineData();
 }
 
@@ -328,20 +419,22 @@ void CollisionGroup::ShapeFrameObserver::handleDestructionNotification(
 //==============================================================================
 auto CollisionGroup::addShapeFrameImpl(
     const dynamics::ShapeFrame* shapeFrame,
-    const void* source) -> ObjectInfo*
+    const void* source,
+    std::vector<CollisionObject*>* newObjects) -> ObjectInfo*
 {
   if (!shapeFrame)
     return nullptr;
 
-  auto it = std::find_if(mObjectInfoList.begin(), mObjectInfoList.end(),
-              [&](const std::unique_ptr<ObjectInfo>& info)
-              { return info->mFrame == shapeFrame; });
+  auto& info = mObjectInfoMap[shapeFrame];
 
-  if (it == mObjectInfoList.end())
+  if (!info)
   {
     auto collObj = mCollisionDetector->claimCollisionObject(shapeFrame);
 
-    addCollisionObjectToEngine(collObj.get());
+    if (newObjects)
+      newObjects->push_back(collObj.get());
+    else
+      addCollisionObjectToEngine(collObj.get());
 
     const dynamics::ConstShapePtr& shape = shapeFrame->getShape();
 
@@ -353,15 +446,74 @@ auto CollisionGroup::addShapeFrameImpl(
     mObjectInfoList.emplace_back(
           new ObjectInfo{shapeFrame, collObj,
                          shape? shape->getID() : 0,
-                         shape? shape->getVersion() : 0, {}});
+                         shape? shape->getVersion() : 0, {},
+                         common::Connection(), true, isDeformable(shape)});
     mObserver.addShapeFrame(shapeFrame);
+    info = mObjectInfoList.back().get();
+    connectToTransformUpdates(info);
+  }
+
+  info->mSources.insert(source);
+
+  return info;
+}
+
+//==============================================================================
+void CollisionGroup::subscribeToImpl(
+    const dynamics::ConstSkeletonPtr& skeleton,
+    std::vector<CollisionObject*>* newObjects)
+{
+  const auto inserted = mSkeletonSources.insert(
+      SkeletonSources::value_type(
+        skeleton.get(),
+        SkeletonSource(skeleton, skeleton->getVersion()))
+      );
+
+  if(!inserted.second)
+    return;
+
+  SkeletonSource& entry = inserted.first->second;
+
+  const std::size_t numBodies = skeleton->getNumBodyNodes();
+  for (std::size_t i = 0u ; i < numBodies; ++i)
+  {
+    const dynamics::BodyNode* bn = skeleton->getBodyNode(i);
+
+    const auto& collisionShapeNodes =
+        bn->getShapeNodesWith<dynamics::CollisionAspect>();
 
-    it = --mObjectInfoList.end();
+    auto& childInfo = entry.mChildren.insert(
+          std::make_pair(bn, SkeletonSource::ChildInfo(bn->getVersion())))
+        .first->second;
+
+    for (const auto& shapeNode : collisionShapeNodes)
+    {
+      entry.mObjects.insert(
+          {shapeNode,
+           addShapeFrameImpl(shapeNode, skeleton.get(), newObjects)});
+      childInfo.mFrames.insert(shapeNode);
+    }
   }
+}
+
+//==============================================================================
+void CollisionGroup::eraseObjectInfo(ObjectInfoList::iterator it)
+{
+  mObjectInfoMap.erase((*it)->mFrame);
+  mObjectInfoList.erase(it);
+}
 
-  (*it)->mSources.insert(source);
+//==============================================================================
+auto CollisionGroup::findObjectInfo(const dynamics::ShapeFrame* shapeFrame)
+    -> ObjectInfoList::iterator
+{
+  // The map rules out absent frames without scanning the list
+  if (mObjectInfoMap.find(shapeFrame) == mObjectInfoMap.end())
+    return mObjectInfoList.end();
 
-  return it->get();
+  return std::find_if(mObjectInfoList.begin(), mObjectInfoList.end(),
+                      [&](const std::unique_ptr<ObjectInfo>& info)
+                      { return info->mFrame == shapeFrame; });
 }
 
 //==============================================================================
@@ -372,21 +524,18 @@ void CollisionGroup::removeShapeFrameInternal(
   if(!shapeFrame)
     return;
 
-  const auto search =
-      std::find_if(mObjectInfoList.begin(), mObjectInfoList.end(),
-                   [&](const std::unique_ptr<ObjectInfo>& info)
-                   { return info->mFrame == shapeFrame; });
+  const auto search = mObjectInfoMap.find(shapeFrame);
 
-  if(mObjectInfoList.end() == search)
+  if(mObjectInfoMap.end() == search)
     return;
 
-  std::unordered_set<const void*>& objectSources = (*search)->mSources;
+  std::unordered_set<const void*>& objectSources = search->second->mSources;
   objectSources.erase(source);
 
   if(objectSources.empty())
   {
-    removeCollisionObjectFromEngine((*search)->mObject.get());
-    mObjectInfoList.erase(search);
+    removeCollisionObjectFromEngine(search->second->mObject.get());
+    eraseObjectInfo(findObjectInfo(shapeFrame));
     mObserver.removeShapeFrame(shapeFrame);
   }
 }
@@ -603,6 +752,8 @@ bool CollisionGroup::updateShapeFrame(ObjectInfo* object)
 
     object->mLastKnownShapeID = currentID;
     object->mLastKnownVersion = currentVersion;
+    object->mNeedEngineUpdate = true;
+    object->mDeformable = isDeformable(shape);
 
     return true;
   }
@@ -610,5 +761,17 @@ bool CollisionGroup::updateShapeFrame(ObjectInfo* object)
   return false;
 }
 
+//==============================================================================
+void CollisionGroup::connectToTransformUpdates(ObjectInfo* object)
+{
+  // The ObjectInfo disconnects itself on destruction, so it is safe to capture
+  // the raw pointer here.
+  object->mTransformConnection
+      = const_cast<dynamics::ShapeFrame*>(object->mFrame)
+          ->onTransformUpdated.connect(
+            [=](const dynamics::Entity*)
+            { object->mNeedEngineUpdate = true; });
+}
+
 }  // namespace collision
 }  // namespace dart
@@ -42,6 +42,7 @@
 #include "dart/collision/DistanceOption.hpp"
 #include "dart/collision/DistanceResult.hpp"
 #include "dart/common/Observer.hpp"
+#include "dart/common/Signal.hpp"
 #include "dart/dynamics/SmartPointer.hpp"
 
 namespace dart {
@@ -140,6 +141,11 @@ public:
   /// template.
   void subscribeTo();
 
+  /// Add ShapeFrames of multiple skeletons, and also subscribe to them. This is
+  /// equivalent to subscribing to each of them, but the new CollisionObjects
+  /// are handed to the collision detection engine all at once.
+  void subscribeTo(const std::vector<dynamics::ConstSkeletonPtr>& skeletons);
+
   /// Remove a ShapeFrame from this CollisionGroup. If this ShapeFrame was being
   /// provided by any subscriptions, then calling this function will unsubscribe
   /// from those subscriptions, because otherwise this ShapeFrame would simply
@@ -320,6 +326,17 @@ protected:
   /// This function will be called ahead of every collision checking.
   virtual void updateCollisionGroupEngineData() = 0;
 
+  /// Update the collision detection engine data for the CollisionObjects that
+  /// have moved (or deformed) since the last update. This function will be
+  /// called ahead of every collision checking instead of
+  /// updateCollisionGroupEngineData() so that the engines that support
+  /// incremental broadphase updates only need to refit the moved objects.
+  ///
+  /// The default implementation simply calls
+  /// updateCollisionGroupEngineData().
+  virtual void updateMovedCollisionObjectsInEngine(
+      const std::vector<CollisionObject*>& movedObjects);
+
 protected:
 
   /// Collision detector
@@ -355,6 +372,24 @@ protected:
     /// When all sources are cleared out (via unsubscribing), this object will
     /// be removed from this group.
     std::unordered_set<const void*> mSources;
+
+    /// Connection to the transform update signal of the ShapeFrame
+    common::Connection mTransformConnection;
+
+    /// True if the ShapeFrame has moved since the engine data of this object
+    /// was last updated
+    bool mNeedEngineUpdate;
+
+    /// True if the shape deforms without notifying about it through its version
+    /// (e.g., SoftMeshShape), in which case the engine data of this object
+    /// needs to be updated ahead of every collision checking.
+    bool mDeformable;
+
+    /// Destructor
+    ~ObjectInfo()
+    {
+      mTransformConnection.disconnect();
+    }
   };
 
   using ObjectInfoList = std::vector<std::unique_ptr<ObjectInfo>>;
@@ -362,6 +397,9 @@ protected:
   /// Information about ShapeFrames and CollisionObjects that have been added to
   /// this CollisionGroup.
   ObjectInfoList mObjectInfoList;
+
+  /// Entries of mObjectInfoList by ShapeFrame, for constant time lookups
+  std::unordered_map<const dynamics::ShapeFrame*, ObjectInfo*> mObjectInfoMap;
   // CollisionGroup also shares the ownership of CollisionObjects across other
   // CollisionGroups for the same reason with above.
   //
@@ -424,9 +462,29 @@ private:
   /// Implementation of addShapeFrame. The source argument tells us whether this
   /// ShapeFrame is being requested explicitly by the user or implicitly through
   /// a BodyNode, Skeleton, or other CollisionGroup.
+  ///
+  /// If newObjects is not nullptr, a newly created CollisionObject is appended
+  /// to it instead of being added to the collision detection engine, so that
+  /// the caller can add a batch of them with addCollisionObjectsToEngine().
   ObjectInfo* addShapeFrameImpl(
       const dynamics::ShapeFrame* shapeFrame,
-      const void* source);
+      const void* source,
+      std::vector<CollisionObject*>* newObjects = nullptr);
+
+  /// Implementation of subscribeTo() for a single Skeleton. See
+  /// addShapeFrameImpl() for newObjects.
+  void subscribeToImpl(
+      const dynamics::ConstSkeletonPtr& skeleton,
+      std::vector<CollisionObject*>* newObjects = nullptr);
+
+  /// Removes the entry of mObjectInfoList that it points to, and its entry in
+  /// mObjectInfoMap.
+  void eraseObjectInfo(ObjectInfoList::iterator it);
+
+  /// Returns the entry of mObjectInfoList for shapeFrame, or the end of the
+  /// list if there is none.
+  ObjectInfoList::iterator findObjectInfo(
+      const dynamics::ShapeFrame* shapeFrame);
 
   /// Internal version of removeShapeFrame. This will only remove the ShapeFrame
   /// if it is unsubscribed from all sources.
@@ -508,6 +566,14 @@ private:
   /// \returns true if an update was performed
   bool updateShapeFrame(ObjectInfo* object);
 
+  /// Internal function called to start tracking the motion of the ShapeFrame
+  /// of a newly added object
+  void connectToTransformUpdates(ObjectInfo* object);
+
+  /// The CollisionObjects whose engine data was updated by the last call to
+  /// updateEngineData(). This is kept as a member to avoid reallocation.
+  std::vector<CollisionObject*> mMovedObjects;
+
   /// Skeleton sources that this group is subscribed to
   SkeletonSources mSkeletonSources;
 
@@ -84,6 +84,11 @@ std::unique_ptr<btCollisionShape> createBulletCollisionShapeFromAssimpMesh(const
 template <typename HeightmapShapeT>
 std::unique_ptr<BulletCollisionShape> createBulletCollisionShapeFromHeightmap(
     const HeightmapShapeT* heightMap);
+
+bool updateBulletCollisionShape(
+    const dynamics::ConstShapePtr& shape,
+    BulletCollisionShape& bulletCollisionShape,
+    std::size_t lastKnownVersion);
 } // anonymous namespace
 
 //==============================================================================
@@ -367,12 +372,21 @@ BulletCollisionDetector::claimBulletCollisionShape(
   const bool inserted = search.second;
   ShapeInfo& info = search.first->second;
 
-  if (!inserted && currentVersion == info.mLastKnownVersion)
+  if (!inserted)
   {
     const auto& bulletCollShape = info.mShape.lock();
     assert(bulletCollShape);
 
-    return bulletCollShape;
+    if (currentVersion == info.mLastKnownVersion)
+      return bulletCollShape;
+
+    // Some shapes, such as height fields, can be updated in place
+    if (updateBulletCollisionShape(
+            shape, *bulletCollShape, info.mLastKnownVersion))
+    {
+      info.mLastKnownVersion = currentVersion;
+      return bulletCollShape;
+    }
   }
 
   auto newBulletCollisionShape = std::shared_ptr<BulletCollisionShape>(
@@ -957,6 +971,25 @@ std::unique_ptr<btCollisionShape> createBulletCollisionShapeFromAssimpMesh(
   return std::move(gimpactMeshShape);
 }
 
+//==============================================================================
+/// Heights that a btHeightfieldTerrainShape refers to, along with the
+/// parameters it was created with
+template <typename HeightmapShapeT>
+struct BulletHeightfieldData
+{
+  /// Heights of the shape, with the rows going in +y direction
+  typename HeightmapShapeT::HeightField mHeights;
+
+  /// Scale of the shape
+  Eigen::Vector3d mScale;
+
+  /// Minimum height the btHeightfieldTerrainShape was created with
+  typename HeightmapShapeT::S mMinHeight;
+
+  /// Maximum height the btHeightfieldTerrainShape was created with
+  typename HeightmapShapeT::S mMaxHeight;
+};
+
 //==============================================================================
 template <typename HeightmapShapeT>
 std::unique_ptr<BulletCollisionShape>
@@ -984,10 +1017,15 @@ createBulletCollisionShapeFromHeightmap(
         << " min/max = " << minHeight << "/" << maxHeight << " scale = "
         << scale.x() <<", " << scale.y() << ", " << scale.z() << std::endl;*/
 
-  // the y-values in the height field need to be flipped
-  heightMap->flipY();
-
-  const auto& heights = heightMap->getHeightField();
+  // Bullet expects the rows in +y direction, so it needs its own copy of the
+  // heights with the rows flipped. Flipping the shape's heights in place
+  // would change them for every other collision detector sharing them.
+  auto data = std::make_shared<BulletHeightfieldData<HeightmapShapeT>>();
+  data->mHeights = heightMap->getHeightField().colwise().reverse();
+  data->mScale = scale;
+  data->mMinHeight = minHeight;
+  data->mMaxHeight = maxHeight;
+  const auto& heights = data->mHeights;
 
   // create the height field
   const btVector3 localScaling(scale.x(), scale.y(), scale.z());
@@ -1022,8 +1060,75 @@ createBulletCollisionShapeFromHeightmap(
         << max.x() << ", " << max.y() << ", " << max.z() << "}"
         << " (will be translated by z=" << trans.z() << ")" << std::endl;
 
-  return common::make_unique<BulletCollisionShape>(
+  auto bulletCollisionShape = common::make_unique<BulletCollisionShape>(
       std::move(heightFieldShape), relativeShapeTransform);
+  bulletCollisionShape->mReferencedData = std::move(data);
+
+  return bulletCollisionShape;
+}
+
+//==============================================================================
+template <typename HeightmapShapeT>
+bool updateBulletHeightfield(
+    const HeightmapShapeT* heightMap,
+    BulletCollisionShape& bulletCollisionShape,
+    std::size_t lastKnownVersion)
+{
+  auto data = std::static_pointer_cast<BulletHeightfieldData<HeightmapShapeT>>(
+      bulletCollisionShape.mReferencedData);
+  if (!data)
+    return false;
+
+  // The btHeightfieldTerrainShape keeps the dimensions, the scale, and the
+  // height range it was created with
+  const auto& heights = heightMap->getHeightField();
+  if (heights.rows() != data->mHeights.rows()
+      || heights.cols() != data->mHeights.cols()
+      || heightMap->getScale() != data->mScale
+      || heightMap->getMinHeight() < data->mMinHeight
+      || heightMap->getMaxHeight() > data->mMaxHeight
+      || heightMap->getNumTiles() == 0u)
+  {
+    return false;
+  }
+
+  // Only copy the samples of the tiles that changed since, with the rows
+  // flipped like in createBulletCollisionShapeFromHeightmap()
+  const std::size_t depth = heightMap->getDepth();
+  for (std::size_t i = 0u; i < heightMap->getNumTiles(); ++i)
+  {
+    const auto& tile = heightMap->getTile(i);
+    if (tile.mVersion <= lastKnownVersion)
+      continue;
+
+    for (std::size_t r = tile.mRow; r <= tile.mRow + tile.mNumRows; ++r)
+    {
+      data->mHeights.block(depth - 1u - r, tile.mCol, 1u, tile.mNumCols + 1u)
+          = heights.block(r, tile.mCol, 1u, tile.mNumCols + 1u);
+    }
+  }
+
+  return true;
+}
+
+//==============================================================================
+bool updateBulletCollisionShape(
+    const dynamics::ConstShapePtr& shape,
+    BulletCollisionShape& bulletCollisionShape,
+    std::size_t lastKnownVersion)
+{
+  // Bullet doesn't support double height fields, see
+  // createBulletCollisionShape()
+  if (shape->is<dynamics::HeightmapShapef>())
+  {
+    assert(dynamic_cast<const dynamics::HeightmapShapef*>(shape.get()));
+    return updateBulletHeightfield(
+        static_cast<const dynamics::HeightmapShapef*>(shape.get()),
+        bulletCollisionShape,
+        lastKnownVersion);
+  }
+
+  return false;
 }
 
 } // anonymous namespace
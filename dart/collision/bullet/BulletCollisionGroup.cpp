@@ -113,6 +113,20 @@ void BulletCollisionGroup::updateCollisionGroupEngineData()
   mBulletCollisionWorld->updateAabbs();
 }
 
+//==============================================================================
+void BulletCollisionGroup::updateMovedCollisionObjectsInEngine(
+    const std::vector<CollisionObject*>& movedObjects)
+{
+  // Only update the AABBs of the moved objects instead of all the objects in
+  // the collision world.
+  for (auto object : movedObjects)
+  {
+    auto casted = static_cast<BulletCollisionObject*>(object);
+    mBulletCollisionWorld->updateSingleAabb(
+          casted->getBulletCollisionObject());
+  }
+}
+
 //==============================================================================
 btCollisionWorld* BulletCollisionGroup::getBulletCollisionWorld()
 {
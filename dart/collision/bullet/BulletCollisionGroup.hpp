@@ -76,6 +76,10 @@ protected:
   // Documentation inherited
   void updateCollisionGroupEngineData() override;
 
+  // Documentation inherited
+  void updateMovedCollisionObjectsInEngine(
+      const std::vector<CollisionObject*>& movedObjects) override;
+
   /// Return Bullet collision world
   btCollisionWorld* getBulletCollisionWorld();
 
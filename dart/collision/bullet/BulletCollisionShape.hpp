@@ -52,6 +52,10 @@ struct BulletCollisionShape
   /// Defaults to identity.
   std::unique_ptr<btTransform> mRelativeTransform;
 
+  /// Data that mCollisionShape refers to without owning it, such as the
+  /// heights of a btHeightfieldTerrainShape.
+  std::shared_ptr<void> mReferencedData;
+
   BulletCollisionShape(
       std::unique_ptr<btCollisionShape> collisionShape,
       const btTransform& relativeTransform);
@@ -33,6 +33,7 @@
 #include "dart/collision/dart/DARTCollide.hpp"
 #include "dart/collision/CollisionObject.hpp"
 
+#include <limits>
 #include <memory>
 
 #include "dart/math/Helpers.hpp"
@@ -1249,6 +1250,450 @@ int collideCylinderPlane(CollisionObject* o1, CollisionObject* o2, const double&
   return 0;
 }
 
+//==============================================================================
+namespace {
+
+//==============================================================================
+/// Returns the closest point on triangle (a, b, c) to p. See Ericson,
+/// Real-Time Collision Detection, Section 5.1.5.
+Eigen::Vector3d closestPointOnTriangle(
+    const Eigen::Vector3d& p,
+    const Eigen::Vector3d& a,
+    const Eigen::Vector3d& b,
+    const Eigen::Vector3d& c)
+{
+  const Eigen::Vector3d ab = b - a;
+  const Eigen::Vector3d ac = c - a;
+  const Eigen::Vector3d ap = p - a;
+
+  const double d1 = ab.dot(ap);
+  const double d2 = ac.dot(ap);
+  if (d1 <= 0.0 && d2 <= 0.0)
+    return a;
+
+  const Eigen::Vector3d bp = p - b;
+  const double d3 = ab.dot(bp);
+  const double d4 = ac.dot(bp);
+  if (d3 >= 0.0 && d4 <= d3)
+    return b;
+
+  const double vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    return a + d1 / (d1 - d3) * ab;
+
+  const Eigen::Vector3d cp = p - c;
+  const double d5 = ab.dot(cp);
+  const double d6 = ac.dot(cp);
+  if (d6 >= 0.0 && d5 <= d6)
+    return c;
+
+  const double vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    return a + d2 / (d2 - d6) * ac;
+
+  const double va = d3 * d6 - d5 * d4;
+  if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+    return b + (d4 - d3) / ((d4 - d3) + (d5 - d6)) * (c - b);
+
+  const double denom = 1.0 / (va + vb + vc);
+  return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+//==============================================================================
+/// Converts a coordinate of a height field to the index of the cell that
+/// contains it, clamped to [0, numCells - 1].
+std::size_t toCellIndex(double coordinate, std::size_t numCells)
+{
+  if (coordinate <= 0.0)
+    return 0u;
+
+  return std::min(static_cast<std::size_t>(coordinate), numCells - 1u);
+}
+
+//==============================================================================
+/// Range of cells of a height field, with the last row and column included.
+struct CellRange
+{
+  std::size_t mFirstRow;
+  std::size_t mLastRow;
+  std::size_t mFirstCol;
+  std::size_t mLastCol;
+};
+
+//==============================================================================
+/// Computes the cells of a height field that overlap a region in x and y.
+template <typename S>
+CellRange computeCellRange(
+    const dynamics::HeightmapShape<S>& heightmap,
+    const math::BoundingBox& region)
+{
+  const Eigen::Vector3d& scale = heightmap.getScale();
+  const double halfWidth = 0.5 * (heightmap.getWidth() - 1);
+  const double halfDepth = 0.5 * (heightmap.getDepth() - 1);
+  const std::size_t numCellCols = heightmap.getWidth() - 1u;
+  const std::size_t numCellRows = heightmap.getDepth() - 1u;
+
+  CellRange range;
+  range.mFirstCol = toCellIndex(
+      region.getMin().x() / scale.x() + halfWidth, numCellCols);
+  range.mLastCol = toCellIndex(
+      region.getMax().x() / scale.x() + halfWidth, numCellCols);
+  // Rows go in -y direction
+  range.mFirstRow = toCellIndex(
+      halfDepth - region.getMax().y() / scale.y(), numCellRows);
+  range.mLastRow = toCellIndex(
+      halfDepth - region.getMin().y() / scale.y(), numCellRows);
+
+  return range;
+}
+
+//==============================================================================
+/// Calls func(a, b, c) for the triangles of the cells of a height field that
+/// overlap a region, visiting only the tiles whose bounds overlap it. The
+/// triangles are counter-clockwise when seen from above.
+template <typename S, typename Func>
+void forEachHeightmapTriangle(
+    const dynamics::HeightmapShape<S>& heightmap,
+    const math::BoundingBox& region,
+    Func func)
+{
+  std::vector<std::size_t> tiles;
+  heightmap.findTiles(region, tiles);
+  if (tiles.empty())
+    return;
+
+  const CellRange range = computeCellRange(heightmap, region);
+
+  for (const auto index : tiles)
+  {
+    const auto& tile = heightmap.getTile(index);
+    const std::size_t firstRow = std::max(tile.mRow, range.mFirstRow);
+    const std::size_t lastRow
+        = std::min(tile.mRow + tile.mNumRows - 1u, range.mLastRow);
+    const std::size_t firstCol = std::max(tile.mCol, range.mFirstCol);
+    const std::size_t lastCol
+        = std::min(tile.mCol + tile.mNumCols - 1u, range.mLastCol);
+
+    for (std::size_t r = firstRow; r <= lastRow; ++r)
+    {
+      for (std::size_t c = firstCol; c <= lastCol; ++c)
+      {
+        const Eigen::Vector3d v00 = heightmap.getVertex(r, c);
+        const Eigen::Vector3d v01 = heightmap.getVertex(r, c + 1u);
+        const Eigen::Vector3d v10 = heightmap.getVertex(r + 1u, c);
+        const Eigen::Vector3d v11 = heightmap.getVertex(r + 1u, c + 1u);
+
+        func(v00, v10, v11);
+        func(v00, v11, v01);
+      }
+    }
+  }
+}
+
+//==============================================================================
+/// Computes the height of the surface of a height field at the x and y
+/// coordinates of a point, and the upward normal of the surface there. All
+/// in the frame of the height field. Returns false if the point is outside
+/// of the height field.
+template <typename S>
+bool computeHeightmapSurface(
+    const dynamics::HeightmapShape<S>& heightmap,
+    const Eigen::Vector3d& point,
+    double& height,
+    Eigen::Vector3d& normal)
+{
+  const std::size_t width = heightmap.getWidth();
+  const std::size_t depth = heightmap.getDepth();
+  if (width < 2u || depth < 2u)
+    return false;
+
+  const Eigen::Vector3d& scale = heightmap.getScale();
+  const double col = point.x() / scale.x() + 0.5 * (width - 1);
+  const double row = 0.5 * (depth - 1) - point.y() / scale.y();
+  if (col < 0.0 || col > width - 1 || row < 0.0 || row > depth - 1)
+    return false;
+
+  const std::size_t c = toCellIndex(col, width - 1u);
+  const std::size_t r = toCellIndex(row, depth - 1u);
+  const double fx = col - c;
+  const double fy = row - r;
+
+  const Eigen::Vector3d v00 = heightmap.getVertex(r, c);
+  const Eigen::Vector3d v11 = heightmap.getVertex(r + 1u, c + 1u);
+
+  // Each cell is split along the diagonal from (r, c) to (r + 1, c + 1)
+  if (fy >= fx)
+  {
+    const Eigen::Vector3d v10 = heightmap.getVertex(r + 1u, c);
+    height = v00.z() + fy * (v10.z() - v00.z()) + fx * (v11.z() - v10.z());
+    normal = (v10 - v00).cross(v11 - v00).normalized();
+  }
+  else
+  {
+    const Eigen::Vector3d v01 = heightmap.getVertex(r, c + 1u);
+    height = v00.z() + fx * (v01.z() - v00.z()) + fy * (v11.z() - v01.z());
+    normal = (v11 - v00).cross(v01 - v00).normalized();
+  }
+
+  return true;
+}
+
+//==============================================================================
+bool isHeightmap(const std::string& shapeType)
+{
+  return dynamics::HeightmapShapef::getStaticType() == shapeType
+         || dynamics::HeightmapShaped::getStaticType() == shapeType;
+}
+
+//==============================================================================
+/// Collides a height field with a box or a sphere.
+template <typename S>
+int collideHeightmap(
+    CollisionObject* o1, CollisionObject* o2,
+    const dynamics::HeightmapShape<S>& heightmap, const Eigen::Isometry3d& T0,
+    const dynamics::ConstShapePtr& shape, const Eigen::Isometry3d& T1,
+    CollisionResult& result)
+{
+  const auto& shapeType = shape->getType();
+
+  if (dynamics::SphereShape::getStaticType() == shapeType)
+  {
+    const auto* sphere = static_cast<const dynamics::SphereShape*>(shape.get());
+
+    return collideHeightmapSphere(
+        o1, o2, heightmap, T0, sphere->getRadius(), T1, result);
+  }
+  else if (dynamics::BoxShape::getStaticType() == shapeType)
+  {
+    const auto* box = static_cast<const dynamics::BoxShape*>(shape.get());
+
+    return collideHeightmapBox(
+        o1, o2, heightmap, T0, box->getSize(), T1, result);
+  }
+  else if (dynamics::EllipsoidShape::getStaticType() == shapeType)
+  {
+    const auto* ellipsoid
+        = static_cast<const dynamics::EllipsoidShape*>(shape.get());
+
+    return collideHeightmapSphere(
+        o1, o2, heightmap, T0, ellipsoid->getRadii()[0], T1, result);
+  }
+
+  dterr << "[DARTCollisionDetector] Attempting to check for an "
+        << "unsupported shape pair: [" << heightmap.getType()
+        << "] - [" << shapeType << "]. Returning false.\n";
+
+  return false;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+template <typename S>
+int collideHeightmapSphere(
+    CollisionObject* o1, CollisionObject* o2,
+    const dynamics::HeightmapShape<S>& heightmap, const Eigen::Isometry3d& T0,
+    const double& r1, const Eigen::Isometry3d& T1,
+    CollisionResult& result)
+{
+  if (heightmap.getNumTiles() == 0u)
+    return 0;
+
+  // Everything below is in the frame of the height field
+  const Eigen::Vector3d center = T0.inverse() * T1.translation();
+  const double bottom = heightmap.getMinHeight() * heightmap.getScale().z();
+
+  double penetration = 0.0;
+  Eigen::Vector3d point;
+  Eigen::Vector3d normal;
+
+  double height;
+  Eigen::Vector3d surfaceNormal;
+  if (computeHeightmapSurface(heightmap, center, height, surfaceNormal)
+      && center.z() < height && center.z() >= bottom)
+  {
+    // The center is inside the terrain
+    penetration = (height - center.z()) * surfaceNormal.z() + r1;
+    point = Eigen::Vector3d(center.x(), center.y(), height);
+    normal = surfaceNormal;
+  }
+  else
+  {
+    const math::BoundingBox region(
+        center - Eigen::Vector3d::Constant(r1),
+        center + Eigen::Vector3d::Constant(r1));
+
+    forEachHeightmapTriangle(
+        heightmap, region,
+        [&](const Eigen::Vector3d& a,
+            const Eigen::Vector3d& b,
+            const Eigen::Vector3d& c)
+    {
+      const Eigen::Vector3d closest = closestPointOnTriangle(center, a, b, c);
+      const Eigen::Vector3d diff = center - closest;
+      const double distance = diff.norm();
+
+      if (distance < DART_COLLISION_EPS || r1 - distance <= penetration)
+        return;
+
+      penetration = r1 - distance;
+      point = closest;
+      normal = diff / distance;
+    });
+  }
+
+  if (penetration <= 0.0)
+    return 0;
+
+  Contact contact;
+  contact.collisionObject1 = o1;
+  contact.collisionObject2 = o2;
+  contact.point = T0 * point;
+  contact.normal = -(T0.linear() * normal);
+  contact.penetrationDepth = penetration;
+  result.addContact(contact);
+
+  return 1;
+}
+
+//==============================================================================
+template <typename S>
+int collideHeightmapBox(
+    CollisionObject* o1, CollisionObject* o2,
+    const dynamics::HeightmapShape<S>& heightmap, const Eigen::Isometry3d& T0,
+    const Eigen::Vector3d& size1, const Eigen::Isometry3d& T1,
+    CollisionResult& result)
+{
+  if (heightmap.getNumTiles() == 0u)
+    return 0;
+
+  // Everything below is in the frame of the height field unless noted
+  const Eigen::Isometry3d boxTransform = T0.inverse() * T1;
+  const Eigen::Vector3d halfSize = 0.5 * size1;
+  const double bottom = heightmap.getMinHeight() * heightmap.getScale().z();
+
+  Eigen::Vector3d corners[8];
+  Eigen::Vector3d min = Eigen::Vector3d::Constant(
+      std::numeric_limits<double>::max());
+  Eigen::Vector3d max = -min;
+  for (int i = 0; i < 8; ++i)
+  {
+    const Eigen::Vector3d corner(
+        (i & 1) ? halfSize.x() : -halfSize.x(),
+        (i & 2) ? halfSize.y() : -halfSize.y(),
+        (i & 4) ? halfSize.z() : -halfSize.z());
+    corners[i] = boxTransform * corner;
+    min = min.cwiseMin(corners[i]);
+    max = max.cwiseMax(corners[i]);
+  }
+
+  const double top = heightmap.getMaxHeight() * heightmap.getScale().z();
+  if (min.z() > top || max.z() < bottom)
+    return 0;
+
+  int numContacts = 0;
+
+  // Corners of the box inside the terrain
+  for (const auto& corner : corners)
+  {
+    double height;
+    Eigen::Vector3d normal;
+    if (!computeHeightmapSurface(heightmap, corner, height, normal))
+      continue;
+
+    if (corner.z() >= height || corner.z() < bottom)
+      continue;
+
+    Contact contact;
+    contact.collisionObject1 = o1;
+    contact.collisionObject2 = o2;
+    contact.point = T0 * corner;
+    contact.normal = -(T0.linear() * normal);
+    contact.penetrationDepth = (height - corner.z()) * normal.z();
+    result.addContact(contact);
+    ++numContacts;
+  }
+
+  // Samples of the terrain inside the box. Each tile only checks the samples
+  // of its first row and column of cells so that the samples shared by
+  // neighboring tiles are checked once.
+  std::vector<std::size_t> tiles;
+  heightmap.findTiles(math::BoundingBox(min, max), tiles);
+  if (tiles.empty())
+    return numContacts;
+
+  const CellRange range
+      = computeCellRange(heightmap, math::BoundingBox(min, max));
+  const std::size_t lastSampleRow = heightmap.getDepth() - 1u;
+  const std::size_t lastSampleCol = heightmap.getWidth() - 1u;
+  const Eigen::Isometry3d boxInverse = boxTransform.inverse();
+
+  for (const auto index : tiles)
+  {
+    const auto& tile = heightmap.getTile(index);
+    const std::size_t tileLastRow = tile.mRow + tile.mNumRows;
+    const std::size_t tileLastCol = tile.mCol + tile.mNumCols;
+
+    const std::size_t firstRow = std::max(tile.mRow, range.mFirstRow);
+    const std::size_t lastRow = std::min(
+        tileLastRow == lastSampleRow ? tileLastRow : tileLastRow - 1u,
+        range.mLastRow + 1u);
+    const std::size_t firstCol = std::max(tile.mCol, range.mFirstCol);
+    const std::size_t lastCol = std::min(
+        tileLastCol == lastSampleCol ? tileLastCol : tileLastCol - 1u,
+        range.mLastCol + 1u);
+
+    for (std::size_t r = firstRow; r <= lastRow; ++r)
+    {
+      for (std::size_t c = firstCol; c <= lastCol; ++c)
+      {
+        const Eigen::Vector3d vertex = heightmap.getVertex(r, c);
+        const Eigen::Vector3d local = boxInverse * vertex;
+        const Eigen::Vector3d depths = halfSize - local.cwiseAbs();
+
+        if ((depths.array() <= 0.0).any())
+          continue;
+
+        // Push the sample out through the closest face of the box
+        int axis;
+        const double penetration = depths.minCoeff(&axis);
+
+        Contact contact;
+        contact.collisionObject1 = o1;
+        contact.collisionObject2 = o2;
+        contact.point = T0 * vertex;
+        contact.normal = T1.linear().col(axis) * math::sign(local[axis]);
+        contact.penetrationDepth = penetration;
+        result.addContact(contact);
+        ++numContacts;
+      }
+    }
+  }
+
+  return numContacts;
+}
+
+//==============================================================================
+template int collideHeightmapSphere<float>(
+    CollisionObject*, CollisionObject*, const dynamics::HeightmapShape<float>&,
+    const Eigen::Isometry3d&, const double&, const Eigen::Isometry3d&,
+    CollisionResult&);
+
+template int collideHeightmapSphere<double>(
+    CollisionObject*, CollisionObject*, const dynamics::HeightmapShape<double>&,
+    const Eigen::Isometry3d&, const double&, const Eigen::Isometry3d&,
+    CollisionResult&);
+
+template int collideHeightmapBox<float>(
+    CollisionObject*, CollisionObject*, const dynamics::HeightmapShape<float>&,
+    const Eigen::Isometry3d&, const Eigen::Vector3d&, const Eigen::Isometry3d&,
+    CollisionResult&);
+
+template int collideHeightmapBox<double>(
+    CollisionObject*, CollisionObject*, const dynamics::HeightmapShape<double>&,
+    const Eigen::Isometry3d&, const Eigen::Vector3d&, const Eigen::Isometry3d&,
+    CollisionResult&);
+
 //==============================================================================
 int collide(CollisionObject* o1, CollisionObject* o2, CollisionResult& result)
 {
@@ -1264,7 +1709,38 @@ int collide(CollisionObject* o1, CollisionObject* o2, CollisionResult& result)
   const Eigen::Isometry3d& T1 = o1->getTransform();
   const Eigen::Isometry3d& T2 = o2->getTransform();
 
-  if (dynamics::SphereShape::getStaticType() == shapeType1)
+  // Height fields are always checked as the first object, so swap the pair
+  // and flip the resulting contacts if needed.
+  if (isHeightmap(shapeType2) && !isHeightmap(shapeType1))
+  {
+    CollisionResult swappedResult;
+    const int numContacts = collide(o2, o1, swappedResult);
+
+    for (auto contact : swappedResult.getContacts())
+    {
+      std::swap(contact.collisionObject1, contact.collisionObject2);
+      contact.normal = -contact.normal;
+      result.addContact(contact);
+    }
+
+    return numContacts;
+  }
+
+  if (dynamics::HeightmapShapef::getStaticType() == shapeType1)
+  {
+    const auto* heightmap
+        = static_cast<const dynamics::HeightmapShapef*>(shape1.get());
+
+    return collideHeightmap(o1, o2, *heightmap, T1, shape2, T2, result);
+  }
+  else if (dynamics::HeightmapShaped::getStaticType() == shapeType1)
+  {
+    const auto* heightmap
+        = static_cast<const dynamics::HeightmapShaped*>(shape1.get());
+
+    return collideHeightmap(o1, o2, *heightmap, T1, shape2, T2, result);
+  }
+  else if (dynamics::SphereShape::getStaticType() == shapeType1)
   {
     const auto* sphere0
         = static_cast<const dynamics::SphereShape*>(shape1.get());
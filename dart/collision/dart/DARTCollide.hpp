@@ -36,6 +36,7 @@
 #include <vector>
 #include <Eigen/Dense>
 #include "dart/collision/CollisionDetector.hpp"
+#include "dart/dynamics/HeightmapShape.hpp"
 
 namespace dart {
 namespace collision {
@@ -77,6 +78,26 @@ int collideCylinderPlane(
     const Eigen::Vector3d& plane_normal, const Eigen::Isometry3d& T1,
     CollisionResult& result);
 
+/// Collides a height field with a sphere. The height field is treated as
+/// solid from its surface down to its minimum height. Only the tiles of the
+/// height field close to the sphere are visited.
+template <typename S>
+int collideHeightmapSphere(
+    CollisionObject* o1, CollisionObject* o2,
+    const dynamics::HeightmapShape<S>& heightmap, const Eigen::Isometry3d& T0,
+    const double& r1, const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+/// Collides a height field with a box. The height field is treated as solid
+/// from its surface down to its minimum height. Only the tiles of the height
+/// field close to the box are visited.
+template <typename S>
+int collideHeightmapBox(
+    CollisionObject* o1, CollisionObject* o2,
+    const dynamics::HeightmapShape<S>& heightmap, const Eigen::Isometry3d& T0,
+    const Eigen::Vector3d& size1, const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
 }  // namespace collision
 }  // namespace dart
 
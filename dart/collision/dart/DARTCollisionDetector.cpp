@@ -41,6 +41,7 @@
 #include "dart/dynamics/SphereShape.hpp"
 #include "dart/dynamics/BoxShape.hpp"
 #include "dart/dynamics/EllipsoidShape.hpp"
+#include "dart/dynamics/HeightmapShape.hpp"
 
 namespace dart {
 namespace collision {
@@ -287,10 +288,17 @@ void warnUnsupportedShapeType(const dynamics::ShapeFrame* shapeFrame)
       return;
   }
 
+  if (shapeType == dynamics::HeightmapShapef::getStaticType())
+    return;
+
+  if (shapeType == dynamics::HeightmapShaped::getStaticType())
+    return;
+
   dterr << "[DARTCollisionDetector] Attempting to create shape type ["
         << shapeType << "] that is not supported "
-        << "by DARTCollisionDetector. Currently, only BoxShape and "
-        << "EllipsoidShape (only when all the radii are equal) are "
+        << "by DARTCollisionDetector. Currently, only BoxShape, "
+        << "EllipsoidShape (only when all the radii are equal), and "
+        << "HeightmapShape (only against BoxShape and spheres) are "
         << "supported. This shape will always get penetrated by other "
         << "objects.\n";
 }
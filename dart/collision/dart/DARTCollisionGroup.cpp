@@ -54,19 +54,16 @@ void DARTCollisionGroup::initializeEngineData()
 //==============================================================================
 void DARTCollisionGroup::addCollisionObjectToEngine(CollisionObject* object)
 {
-  if (std::find(mCollisionObjects.begin(), mCollisionObjects.end(), object)
-      == mCollisionObjects.end())
-  {
-    mCollisionObjects.push_back(object);
-  }
+  // CollisionGroup only passes objects that are not in the engine yet
+  mCollisionObjects.push_back(object);
 }
 
 //==============================================================================
 void DARTCollisionGroup::addCollisionObjectsToEngine(
     const std::vector<CollisionObject*>& collObjects)
 {
-  for (auto collObject : collObjects)
-    addCollisionObjectToEngine(collObject);
+  mCollisionObjects.insert(
+      mCollisionObjects.end(), collObjects.begin(), collObjects.end());
 }
 
 //==============================================================================
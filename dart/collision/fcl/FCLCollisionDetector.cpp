@@ -32,6 +32,10 @@
 
 #include "dart/collision/fcl/FCLCollisionDetector.hpp"
 
+#include <algorithm>
+#include <limits>
+#include <mutex>
+
 #include <assimp/scene.h>
 
 #include "dart/common/Console.hpp"
@@ -51,6 +55,7 @@
 #include "dart/dynamics/PlaneShape.hpp"
 #include "dart/dynamics/MeshShape.hpp"
 #include "dart/dynamics/SoftMeshShape.hpp"
+#include "dart/dynamics/HeightmapShape.hpp"
 #include "dart/dynamics/VoxelGridShape.hpp"
 
 namespace dart {
@@ -69,6 +74,29 @@ bool distanceCallback(
     void* cdata,
     double& dist);
 
+struct FCLCollisionCallbackData;
+
+struct FCLDistanceCallbackData;
+
+class FCLHeightmap;
+
+const FCLHeightmap* getFCLHeightmap(const fcl::CollisionObject* o);
+
+bool collidePair(
+    fcl::CollisionObject* o1,
+    fcl::CollisionObject* o2,
+    FCLCollisionCallbackData* collData);
+
+void collideHeightmap(
+    fcl::CollisionObject* o1,
+    fcl::CollisionObject* o2,
+    FCLCollisionCallbackData* collData);
+
+void distanceHeightmap(
+    fcl::CollisionObject* o1,
+    fcl::CollisionObject* o2,
+    FCLDistanceCallbackData* distData);
+
 void postProcessFCL(
     const fcl::CollisionResult& fclResult,
     fcl::CollisionObject* o1,
@@ -643,6 +671,188 @@ template<class BV>
   return model;
 }
 
+//==============================================================================
+/// Collision geometry of a HeightmapShape.
+///
+/// To FCL this is a mesh of the bounding box of the height field, which is
+/// what its broadphase sees. The narrow phase is instead done against meshes
+/// of the tiles of the height field close to the other object, and a tile
+/// mesh is only built the first time a query reaches it. It is rebuilt only
+/// once the version of its tile changes.
+class FCLHeightmap : public ::fcl::BVHModel<fcl::OBBRSS>
+{
+public:
+  /// Finds the tiles whose bounds overlap region, which is in the frame of
+  /// the height field.
+  virtual void findTiles(
+      const math::BoundingBox& region,
+      std::vector<std::size_t>& tiles) const = 0;
+
+  /// Returns the number of tiles.
+  virtual std::size_t getNumTiles() const = 0;
+
+  /// Returns the bounding box of a tile in the frame of the height field.
+  virtual math::BoundingBox computeTileBoundingBox(
+      std::size_t index) const = 0;
+
+  /// Returns the mesh of a tile, building it if needed.
+  virtual fcl_shared_ptr<fcl::CollisionGeometry> getTileMesh(
+      std::size_t index) const = 0;
+
+  /// Takes over the tile meshes of the geometry this one replaces. Meshes of
+  /// tiles that changed since are rebuilt when they are next reached.
+  virtual void copyTileMeshes(const FCLHeightmap& previous) = 0;
+};
+
+//==============================================================================
+template <typename S>
+class FCLHeightmapT final : public FCLHeightmap
+{
+public:
+  /// Constructor. The heights are read from the shape when tile meshes are
+  /// built, so the shape must outlive this geometry.
+  explicit FCLHeightmapT(const dynamics::HeightmapShape<S>* heightmap)
+    : mHeightmap(heightmap),
+      mTileMeshes(heightmap->getNumTiles())
+  {
+    const math::BoundingBox& box = heightmap->getBoundingBox();
+    const Eigen::Vector3d& min = box.getMin();
+    const Eigen::Vector3d& max = box.getMax();
+
+    fcl::Vector3 corners[8];
+    for (int i = 0; i < 8; ++i)
+    {
+      corners[i] = fcl::Vector3(
+          (i & 1) ? max.x() : min.x(),
+          (i & 2) ? max.y() : min.y(),
+          (i & 4) ? max.z() : min.z());
+    }
+
+    const int faces[6][4] = {
+      {0, 2, 3, 1},
+      {4, 5, 7, 6},
+      {0, 1, 5, 4},
+      {2, 6, 7, 3},
+      {0, 4, 6, 2},
+      {1, 3, 7, 5}
+    };
+
+    beginModel();
+    for (const auto& face : faces)
+    {
+      addTriangle(corners[face[0]], corners[face[1]], corners[face[2]]);
+      addTriangle(corners[face[0]], corners[face[2]], corners[face[3]]);
+    }
+    endModel();
+  }
+
+  // Documentation inherited
+  void findTiles(
+      const math::BoundingBox& region,
+      std::vector<std::size_t>& tiles) const override
+  {
+    mHeightmap->findTiles(region, tiles);
+  }
+
+  // Documentation inherited
+  std::size_t getNumTiles() const override
+  {
+    return mHeightmap->getNumTiles();
+  }
+
+  // Documentation inherited
+  math::BoundingBox computeTileBoundingBox(std::size_t index) const override
+  {
+    return mHeightmap->computeTileBoundingBox(index);
+  }
+
+  // Documentation inherited
+  fcl_shared_ptr<fcl::CollisionGeometry> getTileMesh(
+      std::size_t index) const override
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Replacing the height field or changing the tile size changes the
+    // tiles, which then all have a new version
+    if (mTileMeshes.size() != mHeightmap->getNumTiles())
+    {
+      mTileMeshes.clear();
+      mTileMeshes.resize(mHeightmap->getNumTiles());
+    }
+
+    // Only the tiles whose heights changed since their mesh was built need a
+    // new one
+    const auto& tile = mHeightmap->getTile(index);
+    auto& entry = mTileMeshes[index];
+    if (entry.mMesh && entry.mVersion == tile.mVersion)
+      return entry.mMesh;
+
+    auto* model = new ::fcl::BVHModel<fcl::OBBRSS>;
+    model->beginModel(
+        static_cast<int>(2u * tile.mNumRows * tile.mNumCols),
+        static_cast<int>(6u * tile.mNumRows * tile.mNumCols));
+    for (std::size_t r = tile.mRow; r < tile.mRow + tile.mNumRows; ++r)
+    {
+      for (std::size_t c = tile.mCol; c < tile.mCol + tile.mNumCols; ++c)
+      {
+        const fcl::Vector3 v00
+            = FCLTypes::convertVector3(mHeightmap->getVertex(r, c));
+        const fcl::Vector3 v01
+            = FCLTypes::convertVector3(mHeightmap->getVertex(r, c + 1u));
+        const fcl::Vector3 v10
+            = FCLTypes::convertVector3(mHeightmap->getVertex(r + 1u, c));
+        const fcl::Vector3 v11
+            = FCLTypes::convertVector3(mHeightmap->getVertex(r + 1u, c + 1u));
+
+        // Same triangulation as the other collision detectors
+        model->addTriangle(v00, v10, v11);
+        model->addTriangle(v00, v11, v01);
+      }
+    }
+    model->endModel();
+
+    entry.mMesh.reset(model);
+    entry.mVersion = tile.mVersion;
+
+    return entry.mMesh;
+  }
+
+  // Documentation inherited
+  void copyTileMeshes(const FCLHeightmap& previous) override
+  {
+    const auto* other = dynamic_cast<const FCLHeightmapT*>(&previous);
+    if (!other || other->mHeightmap != mHeightmap)
+      return;
+
+    std::lock(mMutex, other->mMutex);
+    std::lock_guard<std::mutex> lock(mMutex, std::adopt_lock);
+    std::lock_guard<std::mutex> otherLock(other->mMutex, std::adopt_lock);
+
+    if (other->mTileMeshes.size() == mTileMeshes.size())
+      mTileMeshes = other->mTileMeshes;
+  }
+
+private:
+  /// Mesh of a tile
+  struct TileMesh
+  {
+    /// The mesh, or nullptr if no query reached the tile yet
+    fcl_shared_ptr<fcl::CollisionGeometry> mMesh;
+
+    /// Version of the tile the mesh was built from
+    std::size_t mVersion = 0u;
+  };
+
+  /// The height field
+  const dynamics::HeightmapShape<S>* mHeightmap;
+
+  /// Meshes of the tiles that were reached by queries so far
+  mutable std::vector<TileMesh> mTileMeshes;
+
+  /// Protects mTileMeshes
+  mutable std::mutex mMutex;
+};
+
 } // anonymous namespace
 
 //==============================================================================
@@ -923,6 +1133,19 @@ FCLCollisionDetector::claimFCLCollisionGeometry(
 
   auto newfclCollGeom = createFCLCollisionGeometry(
         shape, mPrimitiveShapeType, FCLCollisionGeometryDeleter(this, shape));
+
+  // The bounds of a height field may have changed with its version, but the
+  // meshes of the tiles that didn't change can be kept
+  if (!inserted)
+  {
+    const auto oldfclCollGeom = info.mShape.lock();
+    const auto* oldHeightmap
+        = dynamic_cast<const FCLHeightmap*>(oldfclCollGeom.get());
+    auto* newHeightmap = dynamic_cast<FCLHeightmap*>(newfclCollGeom.get());
+    if (oldHeightmap && newHeightmap)
+      newHeightmap->copyTileMeshes(*oldHeightmap);
+  }
+
   info.mShape = newfclCollGeom;
   info.mLastKnownVersion = currentVersion;
 
@@ -1056,6 +1279,20 @@ FCLCollisionDetector::createFCLCollisionGeometry(
 
     geom = createSoftMesh<fcl::OBBRSS>(aiMesh);
   }
+  else if (shape->is<dynamics::HeightmapShapef>())
+  {
+    assert(dynamic_cast<const dynamics::HeightmapShapef*>(shape.get()));
+
+    geom = new FCLHeightmapT<float>(
+        static_cast<const dynamics::HeightmapShapef*>(shape.get()));
+  }
+  else if (shape->is<dynamics::HeightmapShaped>())
+  {
+    assert(dynamic_cast<const dynamics::HeightmapShaped*>(shape.get()));
+
+    geom = new FCLHeightmapT<double>(
+        static_cast<const dynamics::HeightmapShaped*>(shape.get()));
+  }
 #if HAVE_OCTOMAP
   else if (VoxelGridShape::getStaticType() == shapeType)
   {
@@ -1065,6 +1302,10 @@ FCLCollisionDetector::createFCLCollisionGeometry(
     auto octreeShape = static_cast<const VoxelGridShape*>(shape.get());
     auto octree = octreeShape->getOctree();
 
+    // fcl::OcTree queries the octomap tree directly and bounds it by the
+    // fixed volume of its root node, so occupancy updates of the shape are
+    // picked up without rebuilding this geometry. VoxelGridShape therefore
+    // only increments its version when the octree itself is replaced.
     geom = new fcl::OcTree(octree);
 #else
     dterr << "[FCLCollisionDetector::createFCLCollisionGeometry] "
@@ -1125,9 +1366,6 @@ bool collisionCallback(
   if (collData->done)
     return true;
 
-  const auto& fclRequest  = collData->fclRequest;
-        auto& fclResult   = collData->fclResult;
-        auto* result      = collData->result;
   const auto& option      = collData->option;
   const auto& filter      = option.collisionFilter;
 
@@ -1143,6 +1381,27 @@ bool collisionCallback(
       return collData->done;
   }
 
+  // Height fields are checked tile by tile
+  if (getFCLHeightmap(o1) || getFCLHeightmap(o2))
+  {
+    collideHeightmap(o1, o2, collData);
+    return collData->done;
+  }
+
+  return collidePair(o1, o2, collData);
+}
+
+//==============================================================================
+bool collidePair(
+    fcl::CollisionObject* o1,
+    fcl::CollisionObject* o2,
+    FCLCollisionCallbackData* collData)
+{
+  const auto& fclRequest  = collData->fclRequest;
+        auto& fclResult   = collData->fclResult;
+        auto* result      = collData->result;
+  const auto& option      = collData->option;
+
   // Clear previous results
   fclResult.clear();
 
@@ -1216,6 +1475,13 @@ bool distanceCallback(
   fclResult.clear();
 
   // Perform narrow-phase check
+  if (getFCLHeightmap(o1) || getFCLHeightmap(o2))
+  {
+    // Height fields are checked tile by tile
+    distanceHeightmap(o1, o2, distData);
+    return distData->done;
+  }
+
   ::fcl::distance(o1, o2, fclRequest, fclResult);
 
   // Store the minimum distance just in case result is nullptr.
@@ -1230,6 +1496,189 @@ bool distanceCallback(
   return distData->done;
 }
 
+//==============================================================================
+const FCLHeightmap* getFCLHeightmap(const fcl::CollisionObject* o)
+{
+  return dynamic_cast<const FCLHeightmap*>(o->collisionGeometry().get());
+}
+
+//==============================================================================
+/// Computes the bounding box of the shape of other in the frame of the height
+/// field object.
+math::BoundingBox computeRegionInHeightmapFrame(
+    const fcl::CollisionObject* heightmapObject,
+    const fcl::CollisionObject* other)
+{
+  const auto* dartHeightmapObject
+      = static_cast<FCLCollisionObject*>(heightmapObject->getUserData());
+  const auto* dartOther = static_cast<FCLCollisionObject*>(other->getUserData());
+  assert(dartHeightmapObject);
+  assert(dartOther);
+
+  const Eigen::Isometry3d relative
+      = dartHeightmapObject->getTransform().inverse()
+        * dartOther->getTransform();
+  const math::BoundingBox& box = dartOther->getShape()->getBoundingBox();
+
+  Eigen::Vector3d min = Eigen::Vector3d::Constant(
+      std::numeric_limits<double>::max());
+  Eigen::Vector3d max = -min;
+  for (int i = 0; i < 8; ++i)
+  {
+    const Eigen::Vector3d corner(
+        (i & 1) ? box.getMax().x() : box.getMin().x(),
+        (i & 2) ? box.getMax().y() : box.getMin().y(),
+        (i & 4) ? box.getMax().z() : box.getMin().z());
+    const Eigen::Vector3d transformed = relative * corner;
+    min = min.cwiseMin(transformed);
+    max = max.cwiseMax(transformed);
+  }
+
+  return math::BoundingBox(min, max);
+}
+
+//==============================================================================
+void collideHeightmap(
+    fcl::CollisionObject* o1,
+    fcl::CollisionObject* o2,
+    FCLCollisionCallbackData* collData)
+{
+  const FCLHeightmap* heightmap = getFCLHeightmap(o1);
+  const bool heightmapFirst = (heightmap != nullptr);
+  if (!heightmapFirst)
+    heightmap = getFCLHeightmap(o2);
+
+  fcl::CollisionObject* heightmapObject = heightmapFirst ? o1 : o2;
+  fcl::CollisionObject* other = heightmapFirst ? o2 : o1;
+
+  if (getFCLHeightmap(other))
+  {
+    dtwarn << "[FCLCollisionDetector] Collisions between two HeightmapShapes "
+           << "are not supported. Ignoring this pair.\n";
+    return;
+  }
+
+  std::vector<std::size_t> tiles;
+  heightmap->findTiles(
+      computeRegionInHeightmapFrame(heightmapObject, other), tiles);
+
+  for (const auto index : tiles)
+  {
+    fcl::CollisionObject tileObject(
+        heightmap->getTileMesh(index), heightmapObject->getTransform());
+    tileObject.setUserData(heightmapObject->getUserData());
+
+    if (heightmapFirst)
+      collidePair(&tileObject, other, collData);
+    else
+      collidePair(other, &tileObject, collData);
+
+    if (collData->done)
+      return;
+  }
+}
+
+//==============================================================================
+/// Returns the distance between two bounding boxes, or zero if they overlap.
+double computeDistance(const math::BoundingBox& box1,
+                       const math::BoundingBox& box2)
+{
+  const Eigen::Vector3d gap
+      = (box1.getMin() - box2.getMax())
+        .cwiseMax(box2.getMin() - box1.getMax())
+        .cwiseMax(Eigen::Vector3d::Zero());
+
+  return gap.norm();
+}
+
+//==============================================================================
+void distanceHeightmap(
+    fcl::CollisionObject* o1,
+    fcl::CollisionObject* o2,
+    FCLDistanceCallbackData* distData)
+{
+  const FCLHeightmap* heightmap = getFCLHeightmap(o1);
+  const bool heightmapFirst = (heightmap != nullptr);
+  if (!heightmapFirst)
+    heightmap = getFCLHeightmap(o2);
+
+  fcl::CollisionObject* heightmapObject = heightmapFirst ? o1 : o2;
+  fcl::CollisionObject* other = heightmapFirst ? o2 : o1;
+
+  if (getFCLHeightmap(other))
+  {
+    dtwarn << "[FCLCollisionDetector] Distance queries between two "
+           << "HeightmapShapes are not supported. Ignoring this pair.\n";
+    return;
+  }
+
+  // Visit the tiles in order of the distance to their bounding boxes, which
+  // is a lower bound of the distance to their meshes, and stop once no
+  // remaining tile can be closer than the closest one found so far.
+  const math::BoundingBox region
+      = computeRegionInHeightmapFrame(heightmapObject, other);
+
+  std::vector<std::pair<double, std::size_t>> tiles;
+  tiles.reserve(heightmap->getNumTiles());
+  for (std::size_t i = 0u; i < heightmap->getNumTiles(); ++i)
+  {
+    tiles.emplace_back(
+        computeDistance(heightmap->computeTileBoundingBox(i), region), i);
+  }
+  std::sort(tiles.begin(), tiles.end());
+
+  auto& fclResult = distData->fclResult;
+  fcl::CollisionObject* closestTile = nullptr;
+  std::unique_ptr<fcl::CollisionObject> tileObject;
+  std::unique_ptr<fcl::CollisionObject> closestTileObject;
+
+  for (const auto& tile : tiles)
+  {
+    if (closestTile && tile.first >= fclResult.min_distance)
+      break;
+
+    tileObject.reset(new fcl::CollisionObject(
+        heightmap->getTileMesh(tile.second), heightmapObject->getTransform()));
+    tileObject->setUserData(heightmapObject->getUserData());
+
+    // FCL only updates the result if the new distance is smaller
+    const double previousDistance = fclResult.min_distance;
+    if (heightmapFirst)
+      ::fcl::distance(tileObject.get(), other, distData->fclRequest, fclResult);
+    else
+      ::fcl::distance(other, tileObject.get(), distData->fclRequest, fclResult);
+
+    if (!closestTile || fclResult.min_distance < previousDistance)
+    {
+      closestTileObject = std::move(tileObject);
+      closestTile = closestTileObject.get();
+    }
+  }
+
+  if (!closestTile)
+    return;
+
+  // Store the minimum distance just in case result is nullptr.
+  distData->unclampedMinDistance = fclResult.min_distance;
+
+  if (distData->result)
+  {
+    if (heightmapFirst)
+    {
+      interpreteDistanceResult(
+          fclResult, closestTile, other, distData->option, *distData->result);
+    }
+    else
+    {
+      interpreteDistanceResult(
+          fclResult, other, closestTile, distData->option, *distData->result);
+    }
+  }
+
+  if (distData->unclampedMinDistance <= distData->option.distanceLowerBound)
+    distData->done = true;
+}
+
 //==============================================================================
 Eigen::Vector3d getDiff(const Contact& contact1, const Contact& contact2)
 {
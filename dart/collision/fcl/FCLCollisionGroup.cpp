@@ -100,6 +100,26 @@ void FCLCollisionGroup::updateCollisionGroupEngineData()
   mBroadPhaseAlg->update();
 }
 
+//==============================================================================
+void FCLCollisionGroup::updateMovedCollisionObjectsInEngine(
+    const std::vector<CollisionObject*>& movedObjects)
+{
+  if (movedObjects.empty())
+    return;
+
+  // Only refit the bounding volumes of the moved objects in the broadphase
+  // instead of updating the whole tree.
+  std::vector<dart::collision::fcl::CollisionObject*> fclObjects;
+  fclObjects.reserve(movedObjects.size());
+  for (auto object : movedObjects)
+  {
+    auto casted = static_cast<FCLCollisionObject*>(object);
+    fclObjects.push_back(casted->getFCLCollisionObject());
+  }
+
+  mBroadPhaseAlg->update(fclObjects);
+}
+
 //==============================================================================
 FCLCollisionGroup::FCLCollisionManager*
 FCLCollisionGroup::getFCLCollisionManager()
@@ -79,6 +79,10 @@ protected:
   // Documentation inherited
   void updateCollisionGroupEngineData() override;
 
+  // Documentation inherited
+  void updateMovedCollisionObjectsInEngine(
+      const std::vector<CollisionObject*>& movedObjects) override;
+
   /// Return FCL collision manager that is also a broad-phase algorithm
   FCLCollisionManager* getFCLCollisionManager();
 
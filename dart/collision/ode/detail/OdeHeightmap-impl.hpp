@@ -119,7 +119,9 @@ OdeHeightmap<S>::OdeHeightmap(
 
   // get the heightmap parameters
   const Eigen::Vector3d& scale = heightMap->getScale();
-  const auto& heights = heightMap->getHeightField();
+
+  // ODE doesn't copy the heights, so share them with the shape
+  mHeights = heightMap->getSharedHeightField();
 
   // Create the ODE heightfield
   mOdeHeightfieldId = dGeomHeightfieldDataCreate();
@@ -127,7 +129,7 @@ OdeHeightmap<S>::OdeHeightmap(
   // specify height field details
   setOdeHeightfieldDetails(
       mOdeHeightfieldId,
-      heights.data(),
+      mHeights->data(),
       heightMap->getWidth(),
       heightMap->getDepth(),
       scale);
@@ -55,6 +55,11 @@ public:
 
 private:
   dHeightfieldDataID mOdeHeightfieldId;
+
+  /// Height data shared with the HeightmapShape. ODE reads it in place, so it
+  /// has to outlive the ODE height field.
+  std::shared_ptr<const typename dynamics::HeightmapShape<S>::HeightField>
+      mHeights;
 };
 
 using OdeHeightmapf = OdeHeightmap<float>;
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/common/MemoryResource.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include "dart/common/Console.hpp"
+
+namespace dart {
+namespace common {
+
+//==============================================================================
+MemoryResource::MemoryResource(
+    std::shared_ptr<const void> _data, std::size_t _size)
+  : mData(std::move(_data)),
+    mSize(mData ? _size : 0u),
+    mPosition(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+const void* MemoryResource::getData() const
+{
+  return mData.get();
+}
+
+//==============================================================================
+std::size_t MemoryResource::getSize()
+{
+  return mSize;
+}
+
+//==============================================================================
+std::size_t MemoryResource::tell()
+{
+  return mPosition;
+}
+
+//==============================================================================
+bool MemoryResource::seek(ptrdiff_t _offset, SeekType _origin)
+{
+  ptrdiff_t base;
+  switch(_origin)
+  {
+  case Resource::SEEKTYPE_CUR:
+    base = static_cast<ptrdiff_t>(mPosition);
+    break;
+
+  case Resource::SEEKTYPE_END:
+    base = static_cast<ptrdiff_t>(mSize);
+    break;
+
+  case Resource::SEEKTYPE_SET:
+    base = 0;
+    break;
+
+  default:
+    dtwarn << "[MemoryResource::seek] Invalid origin. Expected"
+              " SEEKTYPE_CUR, SEEKTYPE_END, or SEEKTYPE_SET.\n";
+    return false;
+  }
+
+  const ptrdiff_t position = base + _offset;
+  if (position < 0 || position > static_cast<ptrdiff_t>(mSize))
+  {
+    dtwarn << "[MemoryResource::seek] Failed seeking to offset " << position
+           << " of a resource of size " << mSize << ".\n";
+    return false;
+  }
+
+  mPosition = static_cast<std::size_t>(position);
+  return true;
+}
+
+//==============================================================================
+std::size_t MemoryResource::read(
+    void* _buffer, std::size_t _size, std::size_t _count)
+{
+  if (_size == 0u || _count == 0u)
+    return 0u;
+
+  // Like fread, only read complete elements.
+  const std::size_t count = std::min(_count, (mSize - mPosition) / _size);
+  const std::size_t numBytes = count * _size;
+  if (numBytes == 0u)
+    return 0u;
+
+  std::memcpy(
+      _buffer, static_cast<const char*>(mData.get()) + mPosition, numBytes);
+  mPosition += numBytes;
+
+  return count;
+}
+
+//==============================================================================
+std::string MemoryResource::readAll()
+{
+  if (mSize == 0u)
+    return std::string();
+
+  return std::string(static_cast<const char*>(mData.get()), mSize);
+}
+
+} // namespace common
+} // namespace dart
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COMMON_MEMORYRESOURCE_HPP_
+#define DART_COMMON_MEMORYRESOURCE_HPP_
+
+#include "dart/common/Resource.hpp"
+
+namespace dart {
+namespace common {
+
+/// MemoryResource reads from a block of memory that is already loaded (or
+/// memory-mapped). The block is shared rather than copied, so any number of
+/// MemoryResources can read the same data at the same time, each with its own
+/// position indicator.
+class MemoryResource : public virtual Resource
+{
+public:
+  /// Constructs a resource that reads the first _size bytes of _data.
+  MemoryResource(std::shared_ptr<const void> _data, std::size_t _size);
+
+  virtual ~MemoryResource() = default;
+
+  /// Returns a pointer to the beginning of the underlying memory block.
+  const void* getData() const;
+
+  // Documentation inherited.
+  std::size_t getSize() override;
+
+  // Documentation inherited.
+  std::size_t tell() override;
+
+  // Documentation inherited.
+  bool seek(ptrdiff_t _offset, SeekType _origin) override;
+
+  // Documentation inherited.
+  std::size_t read(void* _buffer, std::size_t _size, std::size_t _count) override;
+
+  // Documentation inherited.
+  std::string readAll() override;
+
+private:
+  std::shared_ptr<const void> mData;
+  std::size_t mSize;
+  std::size_t mPosition;
+};
+
+} // namespace common
+} // namespace dart
+
+#endif // ifndef DART_COMMON_MEMORYRESOURCE_HPP_
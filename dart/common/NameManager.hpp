@@ -35,6 +35,7 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 
 namespace dart {
 namespace common {
@@ -172,6 +173,13 @@ protected:
 
   /// The chunk of text that gets appended to a duplicate name
   std::string mAffix;
+
+  /// The duplication number that issueNewName() last settled on for each
+  /// name. Every smaller number is known to be taken as long as no name has
+  /// been removed since, so the search for a free number resumes from here
+  /// instead of starting over from one. This is cleared whenever a name is
+  /// removed or the pattern changes.
+  mutable std::unordered_map<std::string, int> mDuplicateCounts;
 };
 
 } // namespace common
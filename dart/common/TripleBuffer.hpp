@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COMMON_TRIPLEBUFFER_HPP_
+#define DART_COMMON_TRIPLEBUFFER_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace dart {
+namespace common {
+
+/// TripleBuffer hands data over from a single producer thread to a single
+/// consumer thread without either of them ever blocking the other.
+///
+/// The producer fills getWriteBuffer() and calls publish(); the consumer calls
+/// update() and then reads getReadBuffer(). The buffer being written, the
+/// buffer being read, and the most recently published buffer are always three
+/// distinct objects, so the consumer sees every object in a state that the
+/// producer has fully written. Published data that the consumer did not pick
+/// up in time is overwritten by the next publish() rather than queued.
+///
+/// The buffers are reused in rotation, so types that own heap memory (e.g.,
+/// std::vector) stop allocating once they reach their steady-state size.
+template <typename T>
+class TripleBuffer
+{
+public:
+  /// Default constructor
+  TripleBuffer();
+
+  /// Constructor that initializes all three buffers to \c initialValue
+  explicit TripleBuffer(const T& initialValue);
+
+  TripleBuffer(const TripleBuffer&) = delete;
+  TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+  /// Returns the buffer that the producer should fill next. Only the producer
+  /// thread may call this.
+  T& getWriteBuffer();
+
+  /// Makes the content of getWriteBuffer() available to the consumer and
+  /// hands the producer a new buffer to write into. The new write buffer holds
+  /// stale data, so the producer must overwrite it completely before the next
+  /// publish(). Only the producer thread may call this.
+  void publish();
+
+  /// Returns true if data has been published since the last update(). This may
+  /// be called from any thread.
+  bool hasNewData() const;
+
+  /// Swaps the most recently published data into getReadBuffer(). Returns
+  /// false, leaving the read buffer untouched, if nothing has been published
+  /// since the last update(). Only the consumer thread may call this.
+  bool update();
+
+  /// Returns the data obtained by the last successful update(). Only the
+  /// consumer thread may call this.
+  T& getReadBuffer();
+
+  /// Returns the data obtained by the last successful update(). Only the
+  /// consumer thread may call this.
+  const T& getReadBuffer() const;
+
+private:
+  /// Bits of mShared that hold the index of the published buffer
+  static constexpr std::uint8_t IndexMask = 0x3u;
+
+  /// Bit of mShared that is set when the published buffer is newer than the
+  /// read buffer
+  static constexpr std::uint8_t NewDataBit = 0x4u;
+
+  /// The three buffers
+  std::array<T, 3> mBuffers;
+
+  /// Index of the published buffer combined with NewDataBit. This is the only
+  /// state that is shared between the two threads.
+  std::atomic<std::uint8_t> mShared;
+
+  /// Index of the buffer owned by the producer
+  std::uint8_t mWriteIndex;
+
+  /// Index of the buffer owned by the consumer
+  std::uint8_t mReadIndex;
+};
+
+} // namespace common
+} // namespace dart
+
+#include "dart/common/detail/TripleBuffer-impl.hpp"
+
+#endif // DART_COMMON_TRIPLEBUFFER_HPP_
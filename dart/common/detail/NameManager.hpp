@@ -74,6 +74,7 @@ bool NameManager<T>::setPattern(const std::string& _newPattern)
   mPrefix = _newPattern.substr(0, prefix_end);
   mInfix = _newPattern.substr(prefix_end+2, infix_end-prefix_end-2);
   mAffix = _newPattern.substr(infix_end+2);
+  mDuplicateCounts.clear();
 
   return true;
 }
@@ -85,17 +86,25 @@ std::string NameManager<T>::issueNewName(const std::string& _name) const
   if(!hasName(_name))
     return _name;
 
-  int count = 1;
+  int& count = mDuplicateCounts[_name];
+  if(count < 1)
+    count = 1;
+
   std::string newName;
-  do
+  while(true)
   {
     std::stringstream ss;
     if(mNameBeforeNumber)
-      ss << mPrefix << _name << mInfix << count++ << mAffix;
+      ss << mPrefix << _name << mInfix << count << mAffix;
     else
-      ss << mPrefix << count++ << mInfix << _name << mAffix;
+      ss << mPrefix << count << mInfix << _name << mAffix;
     newName = ss.str();
-  } while (hasName(newName));
+
+    if(!hasName(newName))
+      break;
+
+    ++count;
+  }
 
   dtmsg << "[NameManager::issueNewName] (" << mManagerName << ") The name ["
         << _name << "] is a duplicate, so it has been renamed to ["
@@ -153,6 +162,8 @@ bool NameManager<T>::removeName(const std::string& _name)
   if (it == mMap.end())
     return false;
 
+  mDuplicateCounts.clear();
+
   typename std::map<T, std::string>::iterator rit =
       mReverseMap.find(it->second);
 
@@ -175,6 +186,8 @@ bool NameManager<T>::removeObject(const T& _obj)
   if (rit == mReverseMap.end())
     return false;
 
+  mDuplicateCounts.clear();
+
   typename std::map<std::string, T>::iterator it = mMap.find(rit->second);
   if (it != mMap.end())
     mMap.erase(it);
@@ -198,6 +211,7 @@ void NameManager<T>::clear()
 {
   mMap.clear();
   mReverseMap.clear();
+  mDuplicateCounts.clear();
 }
 
 //==============================================================================
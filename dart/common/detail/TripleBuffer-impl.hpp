@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COMMON_DETAIL_TRIPLEBUFFER_IMPL_HPP_
+#define DART_COMMON_DETAIL_TRIPLEBUFFER_IMPL_HPP_
+
+#include "dart/common/TripleBuffer.hpp"
+
+namespace dart {
+namespace common {
+
+//==============================================================================
+template <typename T>
+constexpr std::uint8_t TripleBuffer<T>::IndexMask;
+
+//==============================================================================
+template <typename T>
+constexpr std::uint8_t TripleBuffer<T>::NewDataBit;
+
+//==============================================================================
+template <typename T>
+TripleBuffer<T>::TripleBuffer() : mShared(1u), mWriteIndex(0u), mReadIndex(2u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename T>
+TripleBuffer<T>::TripleBuffer(const T& initialValue)
+  : mBuffers{{initialValue, initialValue, initialValue}},
+    mShared(1u),
+    mWriteIndex(0u),
+    mReadIndex(2u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename T>
+T& TripleBuffer<T>::getWriteBuffer()
+{
+  return mBuffers[mWriteIndex];
+}
+
+//==============================================================================
+template <typename T>
+void TripleBuffer<T>::publish()
+{
+  // Release makes the writes to the buffer visible to the consumer that
+  // acquires it; acquire makes sure the consumer is done with the buffer that
+  // we get back before we start overwriting it.
+  const std::uint8_t previous = mShared.exchange(
+      static_cast<std::uint8_t>(mWriteIndex | NewDataBit),
+      std::memory_order_acq_rel);
+  mWriteIndex = previous & IndexMask;
+}
+
+//==============================================================================
+template <typename T>
+bool TripleBuffer<T>::hasNewData() const
+{
+  return (mShared.load(std::memory_order_relaxed) & NewDataBit) != 0u;
+}
+
+//==============================================================================
+template <typename T>
+bool TripleBuffer<T>::update()
+{
+  if (!hasNewData())
+    return false;
+
+  // The producer may publish again between the check above and the exchange
+  // below, in which case we simply pick up the newer buffer.
+  const std::uint8_t previous
+      = mShared.exchange(mReadIndex, std::memory_order_acq_rel);
+  mReadIndex = previous & IndexMask;
+
+  return true;
+}
+
+//==============================================================================
+template <typename T>
+T& TripleBuffer<T>::getReadBuffer()
+{
+  return mBuffers[mReadIndex];
+}
+
+//==============================================================================
+template <typename T>
+const T& TripleBuffer<T>::getReadBuffer() const
+{
+  return mBuffers[mReadIndex];
+}
+
+} // namespace common
+} // namespace dart
+
+#endif // DART_COMMON_DETAIL_TRIPLEBUFFER_IMPL_HPP_
@@ -374,6 +374,22 @@ void BallJointConstraint::uniteSkeletons()
   }
 }
 
+//==============================================================================
+Eigen::VectorXd BallJointConstraint::getWarmStartImpulses() const
+{
+  return Eigen::Map<const Eigen::Vector3d>(mOldX);
+}
+
+//==============================================================================
+void BallJointConstraint::setWarmStartImpulses(const Eigen::VectorXd& impulses)
+{
+  if (impulses.size() != 3)
+    return;
+
+  Eigen::Map<Eigen::Vector3d> oldX(mOldX);
+  oldX = impulses;
+}
+
 //==============================================================================
 bool BallJointConstraint::isActive() const
 {
@@ -0,0 +1,599 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "dart/constraint/BlockPgsBoxedLcpSolver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <Eigen/Dense>
+#include "dart/external/odelcpsolver/matrix.h"
+#include "dart/external/odelcpsolver/misc.h"
+
+#define BLOCK_PGS_EPSILON 10e-9
+
+namespace dart {
+namespace constraint {
+
+namespace {
+
+/// Maximum number of rows in a block
+constexpr int maxBlockSize = 3;
+
+/// Number of entries of a diagonal block stored as a 3x3 matrix
+constexpr std::size_t blockStride = maxBlockSize * maxBlockSize;
+
+//==============================================================================
+/// Inverts a symmetric positive definite diagonal block stored as a row-major
+/// 3x3 matrix. Returns false if the block isn't positive definite.
+template <int Size>
+bool invertDiagonalBlock(const double* diagonal, double* inverse)
+{
+  using Matrix = Eigen::Matrix<double, Size, Size>;
+
+  Matrix D;
+  for (int r = 0; r < Size; ++r)
+  {
+    for (int c = 0; c < Size; ++c)
+      D(r, c) = diagonal[maxBlockSize * r + c];
+  }
+
+  const Eigen::LLT<Matrix> llt(D);
+  if (llt.info() != Eigen::Success)
+    return false;
+
+  const Matrix invD = llt.solve(Matrix::Identity());
+  for (int r = 0; r < Size; ++r)
+  {
+    for (int c = 0; c < Size; ++c)
+      inverse[maxBlockSize * r + c] = invD(r, c);
+  }
+
+  return true;
+}
+
+} // namespace
+
+//==============================================================================
+BlockPgsBoxedLcpSolver::Option::Option(
+    int maxIteration,
+    int maxLocalIteration,
+    double deltaXTolerance,
+    double relativeDeltaXTolerance,
+    double epsilonForDivision,
+    bool warmStart)
+  : mMaxIteration(maxIteration),
+    mMaxLocalIteration(maxLocalIteration),
+    mDeltaXThreshold(deltaXTolerance),
+    mRelativeDeltaXTolerance(relativeDeltaXTolerance),
+    mEpsilonForDivision(epsilonForDivision),
+    mWarmStart(warmStart)
+{
+  // Do nothing
+}
+
+//==============================================================================
+const std::string& BlockPgsBoxedLcpSolver::getType() const
+{
+  return getStaticType();
+}
+
+//==============================================================================
+const std::string& BlockPgsBoxedLcpSolver::getStaticType()
+{
+  static const std::string type = "BlockPgsBoxedLcpSolver";
+  return type;
+}
+
+//==============================================================================
+bool BlockPgsBoxedLcpSolver::solve(
+    int n,
+    double* A,
+    double* x,
+    double* b,
+    int nub,
+    double* lo,
+    double* hi,
+    int* findex,
+    bool /*earlyTermination*/)
+{
+  if (n <= 0)
+    return true;
+
+  const int nskip = dPAD(n);
+
+  // If all the variables are unbounded then we can just factor, solve, and
+  // return.
+  if (nub >= n)
+  {
+    mDiagonals.resize(static_cast<std::size_t>(n));
+    std::fill(mDiagonals.begin(), mDiagonals.end(), 0.0);
+
+    dFactorLDLT(A, mDiagonals.data(), n, nskip);
+    dSolveLDLT(A, mDiagonals.data(), b, n, nskip);
+    std::memcpy(x, b, n * sizeof(double));
+
+    mCouplingGroupStarts.clear();
+    return true;
+  }
+
+  if (!mOption.mWarmStart)
+    std::fill(x, x + n, 0.0);
+
+  updateBlocks(n, findex);
+  updateBlockSparseMatrix(n, A);
+
+  // The row coupling only applies to a single solve
+  mCouplingGroupStarts.clear();
+
+  const std::size_t numBlocks = mBlockStarts.size() - 1u;
+  double oldX[maxBlockSize];
+
+  bool possibleToTerminate = false;
+  for (int iter = 0; iter < mOption.mMaxIteration; ++iter)
+  {
+    possibleToTerminate = true;
+
+    for (std::size_t block = 0u; block < numBlocks; ++block)
+    {
+      const int start = mBlockStarts[block];
+      const int size = mBlockStarts[block + 1u] - start;
+      std::copy(x + start, x + start + size, oldX);
+
+      solveBlock(block, x, b, nub, lo, hi, findex);
+
+      if (!possibleToTerminate)
+        continue;
+
+      for (int k = 0; k < size; ++k)
+      {
+        const double newX = x[start + k];
+        if (iter == 0)
+        {
+          if (std::abs(newX - oldX[k]) > mOption.mDeltaXThreshold)
+            possibleToTerminate = false;
+        }
+        else if (std::abs(newX) > mOption.mEpsilonForDivision)
+        {
+          const double relativeDeltaX = std::abs((newX - oldX[k]) / newX);
+          if (relativeDeltaX > mOption.mRelativeDeltaXTolerance)
+            possibleToTerminate = false;
+        }
+      }
+    }
+
+    if (possibleToTerminate)
+      break;
+  }
+
+  return possibleToTerminate;
+}
+
+//==============================================================================
+void BlockPgsBoxedLcpSolver::updateBlocks(int n, const int* findex)
+{
+  mBlockStarts.clear();
+
+  int start = 0;
+  while (start < n)
+  {
+    mBlockStarts.push_back(start);
+
+    int end = start + 1;
+    while (end < n && end - start < maxBlockSize && findex[end] == start)
+      ++end;
+
+    start = end;
+  }
+
+  mBlockStarts.push_back(n);
+}
+
+//==============================================================================
+void BlockPgsBoxedLcpSolver::updateBlockSparseMatrix(int n, const double* A)
+{
+  const int nskip = dPAD(n);
+  const std::size_t numBlocks = mBlockStarts.size() - 1u;
+
+  mRowPointers.clear();
+  mColumnBlocks.clear();
+  mValueOffsets.clear();
+  mValues.clear();
+  mDiagonals.resize(numBlocks * maxBlockSize * maxBlockSize);
+  mInverseDiagonals.resize(numBlocks * maxBlockSize * maxBlockSize);
+  mIsInvertible.resize(numBlocks);
+
+  const bool hasRowCoupling = isRowCouplingValid(n);
+  if (hasRowCoupling)
+    updateCoupledBlocks(n);
+
+  for (std::size_t blockI = 0u; blockI < numBlocks; ++blockI)
+  {
+    const int startI = mBlockStarts[blockI];
+    const int sizeI = mBlockStarts[blockI + 1u] - startI;
+
+    mRowPointers.push_back(static_cast<int>(mColumnBlocks.size()));
+
+    if (hasRowCoupling)
+    {
+      // Only the blocks that share a row coupling group can be nonzero
+      mCoupledBlocks.clear();
+      for (int p = mBlockGroupStarts[blockI]; p < mBlockGroupStarts[blockI + 1u];
+           ++p)
+      {
+        const int group = mBlockGroups[p];
+        for (int q = mGroupBlockStarts[group]; q < mGroupBlockStarts[group + 1];
+             ++q)
+        {
+          const int blockJ = mGroupBlocks[q];
+          if (blockJ == static_cast<int>(blockI)
+              || mBlockMarks[blockJ] == static_cast<int>(blockI))
+            continue;
+
+          mBlockMarks[blockJ] = static_cast<int>(blockI);
+          mCoupledBlocks.push_back(blockJ);
+        }
+      }
+      std::sort(mCoupledBlocks.begin(), mCoupledBlocks.end());
+
+      for (const int blockJ : mCoupledBlocks)
+        addOffDiagonalBlock(blockI, static_cast<std::size_t>(blockJ), n, A);
+    }
+    else
+    {
+      for (std::size_t blockJ = 0u; blockJ < numBlocks; ++blockJ)
+      {
+        if (blockI != blockJ)
+          addOffDiagonalBlock(blockI, blockJ, n, A);
+      }
+    }
+
+    double* diagonal = mDiagonals.data() + blockI * blockStride;
+    for (int r = 0; r < sizeI; ++r)
+    {
+      for (int c = 0; c < sizeI; ++c)
+        diagonal[maxBlockSize * r + c] = A[nskip * (startI + r) + startI + c];
+    }
+
+    // Invert the diagonal block
+    double* inverse = mInverseDiagonals.data() + blockI * blockStride;
+    bool invertible = false;
+    if (sizeI == 1)
+    {
+      invertible = diagonal[0] >= mOption.mEpsilonForDivision;
+      if (invertible)
+        inverse[0] = 1.0 / diagonal[0];
+    }
+    else if (sizeI == 2)
+    {
+      invertible = invertDiagonalBlock<2>(diagonal, inverse);
+    }
+    else
+    {
+      invertible = invertDiagonalBlock<3>(diagonal, inverse);
+    }
+    mIsInvertible[blockI] = invertible;
+  }
+
+  mRowPointers.push_back(static_cast<int>(mColumnBlocks.size()));
+}
+
+//==============================================================================
+bool BlockPgsBoxedLcpSolver::isRowCouplingValid(int n) const
+{
+  if (mCouplingGroupStarts.empty()
+      || mCouplingGroupStarts.front() != 0
+      || mCouplingGroupStarts.back()
+             != static_cast<int>(mCouplingRows.size()))
+  {
+    return false;
+  }
+
+  for (const int row : mCouplingRows)
+  {
+    if (row < 0 || row >= n)
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+void BlockPgsBoxedLcpSolver::updateCoupledBlocks(int n)
+{
+  const std::size_t numBlocks = mBlockStarts.size() - 1u;
+  const std::size_t numGroups = mCouplingGroupStarts.size() - 1u;
+
+  mRowBlocks.resize(static_cast<std::size_t>(n));
+  for (std::size_t block = 0u; block < numBlocks; ++block)
+  {
+    for (int row = mBlockStarts[block]; row < mBlockStarts[block + 1u]; ++row)
+      mRowBlocks[row] = static_cast<int>(block);
+  }
+
+  // Blocks of each group without duplicates
+  mBlockMarks.assign(numBlocks, -1);
+  mGroupBlockStarts.clear();
+  mGroupBlocks.clear();
+  mBlockGroupStarts.assign(numBlocks + 1u, 0);
+  for (std::size_t group = 0u; group < numGroups; ++group)
+  {
+    mGroupBlockStarts.push_back(static_cast<int>(mGroupBlocks.size()));
+    for (int p = mCouplingGroupStarts[group];
+         p < mCouplingGroupStarts[group + 1u];
+         ++p)
+    {
+      const int block = mRowBlocks[mCouplingRows[p]];
+      if (mBlockMarks[block] == static_cast<int>(group))
+        continue;
+
+      mBlockMarks[block] = static_cast<int>(group);
+      mGroupBlocks.push_back(block);
+      ++mBlockGroupStarts[block + 1];
+    }
+  }
+  mGroupBlockStarts.push_back(static_cast<int>(mGroupBlocks.size()));
+
+  // Groups of each block
+  for (std::size_t block = 0u; block < numBlocks; ++block)
+    mBlockGroupStarts[block + 1u] += mBlockGroupStarts[block];
+
+  // mBlockMarks holds the next free position of each block in mBlockGroups
+  mBlockGroups.resize(mGroupBlocks.size());
+  mBlockMarks.assign(
+      mBlockGroupStarts.begin(), mBlockGroupStarts.end() - 1);
+  for (std::size_t group = 0u; group < numGroups; ++group)
+  {
+    for (int q = mGroupBlockStarts[group]; q < mGroupBlockStarts[group + 1u];
+         ++q)
+    {
+      mBlockGroups[mBlockMarks[mGroupBlocks[q]]++] = static_cast<int>(group);
+    }
+  }
+
+  mBlockMarks.assign(numBlocks, -1);
+}
+
+//==============================================================================
+void BlockPgsBoxedLcpSolver::addOffDiagonalBlock(
+    std::size_t blockI, std::size_t blockJ, int n, const double* A)
+{
+  const int nskip = dPAD(n);
+  const int startI = mBlockStarts[blockI];
+  const int sizeI = mBlockStarts[blockI + 1u] - startI;
+  const int startJ = mBlockStarts[blockJ];
+  const int sizeJ = mBlockStarts[blockJ + 1u] - startJ;
+
+  bool isZero = true;
+  for (int r = 0; r < sizeI && isZero; ++r)
+  {
+    const double* row = A + nskip * (startI + r) + startJ;
+    for (int c = 0; c < sizeJ; ++c)
+    {
+      if (row[c] != 0.0)
+      {
+        isZero = false;
+        break;
+      }
+    }
+  }
+
+  if (isZero)
+    return;
+
+  mColumnBlocks.push_back(static_cast<int>(blockJ));
+  mValueOffsets.push_back(static_cast<int>(mValues.size()));
+  for (int r = 0; r < sizeI; ++r)
+  {
+    const double* row = A + nskip * (startI + r) + startJ;
+    mValues.insert(mValues.end(), row, row + sizeJ);
+  }
+}
+
+//==============================================================================
+bool BlockPgsBoxedLcpSolver::project(
+    int row,
+    double* x,
+    int nub,
+    const double* lo,
+    const double* hi,
+    const int* findex) const
+{
+  if (row < nub)
+    return false;
+
+  double lower;
+  double upper;
+  if (findex[row] >= 0)
+  {
+    upper = hi[row] * x[findex[row]];
+    lower = -upper;
+  }
+  else
+  {
+    upper = hi[row];
+    lower = lo[row];
+  }
+
+  if (x[row] > upper)
+  {
+    x[row] = upper;
+    return true;
+  }
+  else if (x[row] < lower)
+  {
+    x[row] = lower;
+    return true;
+  }
+
+  return false;
+}
+
+//==============================================================================
+void BlockPgsBoxedLcpSolver::solveBlock(
+    std::size_t block,
+    double* x,
+    const double* b,
+    int nub,
+    const double* lo,
+    const double* hi,
+    const int* findex)
+{
+  const int start = mBlockStarts[block];
+  const int size = mBlockStarts[block + 1u] - start;
+
+  // Residual of the block while the rest of x is fixed
+  double r[maxBlockSize];
+  for (int k = 0; k < size; ++k)
+    r[k] = b[start + k];
+
+  for (int p = mRowPointers[block]; p < mRowPointers[block + 1u]; ++p)
+  {
+    const int blockJ = mColumnBlocks[p];
+    const int startJ = mBlockStarts[blockJ];
+    const int sizeJ = mBlockStarts[blockJ + 1] - startJ;
+    const double* values = mValues.data() + mValueOffsets[p];
+    for (int k = 0; k < size; ++k)
+    {
+      for (int c = 0; c < sizeJ; ++c)
+        r[k] -= values[sizeJ * k + c] * x[startJ + c];
+    }
+  }
+
+  const double* diagonal = mDiagonals.data() + block * blockStride;
+
+  double oldX[maxBlockSize];
+  std::copy(x + start, x + start + size, oldX);
+
+  // Try the unconstrained solution of the block first. It solves the coupling
+  // between the normal and friction rows of a contact exactly.
+  if (mIsInvertible[block])
+  {
+    const double* inverse = mInverseDiagonals.data() + block * blockStride;
+    for (int k = 0; k < size; ++k)
+    {
+      double value = 0.0;
+      for (int c = 0; c < size; ++c)
+        value += inverse[maxBlockSize * k + c] * r[c];
+      x[start + k] = value;
+    }
+
+    bool projected = false;
+    for (int k = 0; k < size; ++k)
+      projected |= project(start + k, x, nub, lo, hi, findex);
+
+    if (!projected)
+      return;
+
+    std::copy(oldX, oldX + size, x + start);
+  }
+
+  // Some of the bounds are active. Fall back to projected Gauss-Seidel
+  // iterations within the block. They continue from the previous iterate so
+  // that the local iterations accumulate over the outer iterations.
+  for (int iter = 0; iter < mOption.mMaxLocalIteration; ++iter)
+  {
+    for (int k = 0; k < size; ++k)
+    {
+      const double Dkk = diagonal[maxBlockSize * k + k];
+      if (Dkk < mOption.mEpsilonForDivision)
+      {
+        x[start + k] = 0.0;
+        continue;
+      }
+
+      double newX = r[k];
+      for (int c = 0; c < size; ++c)
+      {
+        if (c != k)
+          newX -= diagonal[maxBlockSize * k + c] * x[start + c];
+      }
+
+      x[start + k] = newX / Dkk;
+      project(start + k, x, nub, lo, hi, findex);
+    }
+  }
+}
+
+//==============================================================================
+void BlockPgsBoxedLcpSolver::setRowCoupling(
+    const std::vector<int>& groupStarts, const std::vector<int>& rows)
+{
+  mCouplingGroupStarts = groupStarts;
+  mCouplingRows = rows;
+}
+
+#ifndef NDEBUG
+//==============================================================================
+bool BlockPgsBoxedLcpSolver::canSolve(int n, const double* A)
+{
+  const int nskip = dPAD(n);
+
+  // Return false if A has zero-diagonal or A is nonsymmetric matrix
+  for (auto i = 0; i < n; ++i)
+  {
+    if (A[nskip * i + i] < BLOCK_PGS_EPSILON)
+      return false;
+
+    for (auto j = 0; j < n; ++j)
+    {
+      if (std::abs(A[nskip * i + j] - A[nskip * j + i]) > BLOCK_PGS_EPSILON)
+        return false;
+    }
+  }
+
+  return true;
+}
+#endif
+
+//==============================================================================
+void BlockPgsBoxedLcpSolver::setOption(
+    const BlockPgsBoxedLcpSolver::Option& option)
+{
+  mOption = option;
+}
+
+//==============================================================================
+const BlockPgsBoxedLcpSolver::Option& BlockPgsBoxedLcpSolver::getOption() const
+{
+  return mOption;
+}
+
+//==============================================================================
+std::size_t BlockPgsBoxedLcpSolver::getNumOffDiagonalBlocks() const
+{
+  return mColumnBlocks.size();
+}
+
+} // namespace constraint
+} // namespace dart
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef DART_CONSTRAINT_BLOCKPGSBOXEDLCPSOLVER_HPP_
+#define DART_CONSTRAINT_BLOCKPGSBOXEDLCPSOLVER_HPP_
+
+#include <vector>
+#include "dart/constraint/BoxedLcpSolver.hpp"
+
+namespace dart {
+namespace constraint {
+
+/// Implementation of block projected Gauss-Seidel (PGS) LCP solver.
+///
+/// The rows of the LCP are grouped into blocks of up to three rows where a
+/// block consists of a row and the following rows whose friction index points
+/// to it, e.g., the normal and the two friction rows of a contact. A is
+/// compressed into a block-sparse matrix that only keeps the nonzero blocks,
+/// so each iteration costs O(number of nonzero blocks) instead of O(n^2).
+/// When the row coupling is set by setRowCoupling(), only the blocks of
+/// coupled rows are read from A. Otherwise, all of A is scanned for nonzero
+/// blocks.
+/// Every block is solved at once using the inverse of its diagonal block and
+/// projected onto the bounds, which converges faster than scalar PGS for
+/// frictional contacts.
+///
+/// All the workspace is kept between calls and only grows with the problem
+/// size. When warm starting is enabled, the x passed to solve() is used as the
+/// initial guess.
+class BlockPgsBoxedLcpSolver : public BoxedLcpSolver
+{
+public:
+  struct Option
+  {
+    int mMaxIteration;
+    int mMaxLocalIteration;
+    double mDeltaXThreshold;
+    double mRelativeDeltaXTolerance;
+    double mEpsilonForDivision;
+    bool mWarmStart;
+
+    Option(
+        int maxIteration = 30,
+        int maxLocalIteration = 4,
+        double deltaXTolerance = 1e-6,
+        double relativeDeltaXTolerance = 1e-3,
+        double epsilonForDivision = 1e-9,
+        bool warmStart = true);
+  };
+
+  // Documentation inherited.
+  const std::string& getType() const override;
+
+  /// Returns type for this class
+  static const std::string& getStaticType();
+
+  // Documentation inherited.
+  bool solve(
+      int n,
+      double* A,
+      double* x,
+      double* b,
+      int nub,
+      double* lo,
+      double* hi,
+      int* findex,
+      bool earlyTermination) override;
+
+  // Documentation inherited.
+  void setRowCoupling(
+      const std::vector<int>& groupStarts,
+      const std::vector<int>& rows) override;
+
+#ifndef NDEBUG
+  // Documentation inherited.
+  bool canSolve(int n, const double* A) override;
+#endif
+
+  /// Sets options
+  void setOption(const Option& option);
+
+  /// Returns options.
+  const Option& getOption() const;
+
+  /// Returns the number of nonzero off-diagonal blocks of the last solved
+  /// problem
+  std::size_t getNumOffDiagonalBlocks() const;
+
+protected:
+  /// Groups the rows into blocks
+  void updateBlocks(int n, const int* findex);
+
+  /// Compresses A into the block-sparse representation
+  void updateBlockSparseMatrix(int n, const double* A);
+
+  /// Returns false if the row coupling doesn't fit a problem of n rows
+  bool isRowCouplingValid(int n) const;
+
+  /// Finds the blocks that are coupled through the row coupling groups
+  void updateCoupledBlocks(int n);
+
+  /// Appends the off-diagonal block (blockI, blockJ) of A unless it's zero
+  void addOffDiagonalBlock(
+      std::size_t blockI, std::size_t blockJ, int n, const double* A);
+
+  /// Projects x[row] onto its bounds. Returns true if x[row] was changed.
+  bool project(
+      int row,
+      double* x,
+      int nub,
+      const double* lo,
+      const double* hi,
+      const int* findex) const;
+
+  /// Solves a block while the rest of x is fixed
+  void solveBlock(
+      std::size_t block,
+      double* x,
+      const double* b,
+      int nub,
+      const double* lo,
+      const double* hi,
+      const int* findex);
+
+  Option mOption;
+
+  /// First row of each block followed by n
+  std::vector<int> mBlockStarts;
+
+  /// Offsets into mColumnBlocks of the off-diagonal blocks of each block row
+  /// followed by the total number of off-diagonal blocks
+  std::vector<int> mRowPointers;
+
+  /// Block column index of each off-diagonal block
+  std::vector<int> mColumnBlocks;
+
+  /// Offset into mValues of each off-diagonal block
+  std::vector<int> mValueOffsets;
+
+  /// Values of the off-diagonal blocks in row-major order
+  std::vector<double> mValues;
+
+  /// Diagonal blocks as row-major 3x3 matrices
+  std::vector<double> mDiagonals;
+
+  /// Inverses of the diagonal blocks as row-major 3x3 matrices
+  std::vector<double> mInverseDiagonals;
+
+  /// Whether the diagonal block could be inverted
+  std::vector<char> mIsInvertible;
+
+  /// Row coupling groups of the next solve in compressed form. Empty if the
+  /// row coupling isn't set.
+  std::vector<int> mCouplingGroupStarts;
+
+  /// Rows of the row coupling groups
+  std::vector<int> mCouplingRows;
+
+  /// Block of each row
+  std::vector<int> mRowBlocks;
+
+  /// Offsets into mGroupBlocks of the blocks of each row coupling group
+  std::vector<int> mGroupBlockStarts;
+
+  /// Blocks of the row coupling groups
+  std::vector<int> mGroupBlocks;
+
+  /// Offsets into mBlockGroups of the row coupling groups of each block
+  std::vector<int> mBlockGroupStarts;
+
+  /// Row coupling groups of the blocks
+  std::vector<int> mBlockGroups;
+
+  /// Marks to skip duplicated blocks
+  std::vector<int> mBlockMarks;
+
+  /// Off-diagonal blocks of the current block row in increasing order
+  std::vector<int> mCoupledBlocks;
+};
+
+} // namespace constraint
+} // namespace dart
+
+#endif // DART_CONSTRAINT_BLOCKPGSBOXEDLCPSOLVER_HPP_
@@ -44,6 +44,8 @@
 #include "dart/constraint/ConstraintBase.hpp"
 #include "dart/constraint/DantzigBoxedLcpSolver.hpp"
 #include "dart/constraint/PgsBoxedLcpSolver.hpp"
+#include "dart/dynamics/Joint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
 #include "dart/lcpsolver/Lemke.hpp"
 
 namespace dart {
@@ -79,7 +81,9 @@ BoxedLcpConstraintSolver::BoxedLcpConstraintSolver(
 //==============================================================================
 BoxedLcpConstraintSolver::BoxedLcpConstraintSolver(
     BoxedLcpSolverPtr boxedLcpSolver, BoxedLcpSolverPtr secondaryBoxedLcpSolver)
-  : ConstraintSolver()
+  : ConstraintSolver(),
+    mDelassusAssembly(DelassusAssembly::AUTO),
+    mHasSkeletonConstraints(false)
 {
   if (boxedLcpSolver)
   {
@@ -144,6 +148,19 @@ ConstBoxedLcpSolverPtr BoxedLcpConstraintSolver::getSecondaryBoxedLcpSolver()
   return mSecondaryBoxedLcpSolver;
 }
 
+//==============================================================================
+void BoxedLcpConstraintSolver::setDelassusAssembly(DelassusAssembly assembly)
+{
+  mDelassusAssembly = assembly;
+}
+
+//==============================================================================
+BoxedLcpConstraintSolver::DelassusAssembly
+BoxedLcpConstraintSolver::getDelassusAssembly() const
+{
+  return mDelassusAssembly;
+}
+
 //==============================================================================
 void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
 {
@@ -195,43 +212,19 @@ void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
     // Fill vectors: lo, hi, b, w
     constraint->getInformation(&constInfo);
 
-    // Fill a matrix by impulse tests: A
-    constraint->excite();
+    // Adjust findex for global index
     for (std::size_t j = 0; j < constraint->getDimension(); ++j)
     {
-      // Adjust findex for global index
       if (mFIndex[mOffset[i] + j] >= 0)
         mFIndex[mOffset[i] + j] += mOffset[i];
-
-      // Apply impulse for mipulse test
-      constraint->applyUnitImpulse(j);
-
-      // Fill upper triangle blocks of A matrix
-      int index = nSkip * (mOffset[i] + j) + mOffset[i];
-      constraint->getVelocityChange(mA.data() + index, true);
-      for (std::size_t k = i + 1; k < numConstraints; ++k)
-      {
-        index = nSkip * (mOffset[i] + j) + mOffset[k];
-        group.getConstraint(k)->getVelocityChange(mA.data() + index, false);
-      }
-
-      // Filling symmetric part of A matrix
-      for (std::size_t k = 0; k < i; ++k)
-      {
-        const int indexI = mOffset[i] + j;
-        for (std::size_t l = 0; l < group.getConstraint(k)->getDimension(); ++l)
-        {
-          const int indexJ = mOffset[k] + l;
-          mA(indexI, indexJ) = mA(indexJ, indexI);
-        }
-      }
     }
+  }
 
-    assert(isSymmetric(
-        n, mA.data(), mOffset[i], mOffset[i] + constraint->getDimension() - 1));
+  // Fill a matrix: A
+  if (!assembleDelassusMatrixByJacobians(group))
+    assembleDelassusMatrixByImpulseTests(group);
 
-    constraint->unexcite();
-  }
+  setRowCoupling();
 
   assert(isSymmetric(n, mA.data()));
 
@@ -310,6 +303,223 @@ void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
   }
 }
 
+//==============================================================================
+void BoxedLcpConstraintSolver::assembleDelassusMatrixByImpulseTests(
+    ConstrainedGroup& group)
+{
+  const std::size_t numConstraints = group.getNumConstraints();
+  const std::size_t nSkip = static_cast<std::size_t>(mA.cols());
+
+  for (std::size_t i = 0; i < numConstraints; ++i)
+  {
+    const ConstraintBasePtr& constraint = group.getConstraint(i);
+
+    constraint->excite();
+    for (std::size_t j = 0; j < constraint->getDimension(); ++j)
+    {
+      // Apply impulse for mipulse test
+      constraint->applyUnitImpulse(j);
+
+      // Fill upper triangle blocks of A matrix
+      int index = nSkip * (mOffset[i] + j) + mOffset[i];
+      constraint->getVelocityChange(mA.data() + index, true);
+      for (std::size_t k = i + 1; k < numConstraints; ++k)
+      {
+        index = nSkip * (mOffset[i] + j) + mOffset[k];
+        group.getConstraint(k)->getVelocityChange(mA.data() + index, false);
+      }
+
+      // Filling symmetric part of A matrix
+      for (std::size_t k = 0; k < i; ++k)
+      {
+        const int indexI = mOffset[i] + j;
+        for (std::size_t l = 0; l < group.getConstraint(k)->getDimension(); ++l)
+        {
+          const int indexJ = mOffset[k] + l;
+          mA(indexI, indexJ) = mA(indexJ, indexI);
+        }
+      }
+    }
+
+    assert(isSymmetric(
+        static_cast<std::size_t>(mA.rows()),
+        mA.data(),
+        mOffset[i],
+        mOffset[i] + constraint->getDimension() - 1));
+
+    constraint->unexcite();
+  }
+}
+
+//==============================================================================
+static bool isInvMassMatrixEquivalentToImpulseTests(
+    const dynamics::Skeleton* skeleton)
+{
+  // Impulse tests propagate through the point masses of soft bodies and treat
+  // kinematic joints differently from Skeleton::getInvMassMatrix().
+  if (skeleton->getNumSoftBodyNodes() > 0u)
+    return false;
+
+  for (std::size_t i = 0u; i < skeleton->getNumJoints(); ++i)
+  {
+    const dynamics::Joint* joint = skeleton->getJoint(i);
+    if (joint->getNumDofs() > 0u && joint->isKinematic())
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+bool BoxedLcpConstraintSolver::assembleDelassusMatrixByJacobians(
+    ConstrainedGroup& group)
+{
+  mHasSkeletonConstraints = false;
+  if (DelassusAssembly::IMPULSE_TESTS == mDelassusAssembly)
+    return false;
+
+  const std::size_t numConstraints = group.getNumConstraints();
+  if (mJacobians.size() < numConstraints)
+    mJacobians.resize(numConstraints);
+
+  // Collect the constraint Jacobians and group them by skeleton. Constraints
+  // are only coupled in A through the skeletons they share, so A is assembled
+  // block by block per skeleton.
+  mSkeletonConstraints.clear();
+  mSkeletonConstraintsIndices.clear();
+  bool isInvMassMatrixEquivalent = true;
+  for (std::size_t i = 0u; i < numConstraints; ++i)
+  {
+    const ConstraintBasePtr& constraint = group.getConstraint(i);
+    ConstraintJacobian& jacobian = mJacobians[i];
+    if (!constraint->getJacobian(jacobian))
+      return false;
+
+    for (std::size_t k = 0u; k < jacobian.skeletons.size(); ++k)
+    {
+      dynamics::Skeleton* skeleton = jacobian.skeletons[k];
+      const auto result = mSkeletonConstraintsIndices.insert(
+          std::make_pair(skeleton, mSkeletonConstraints.size()));
+      if (result.second)
+      {
+        if (!isInvMassMatrixEquivalentToImpulseTests(skeleton))
+          isInvMassMatrixEquivalent = false;
+
+        mSkeletonConstraints.push_back(SkeletonConstraints{skeleton, {}, 0u});
+      }
+
+      SkeletonConstraints& entry = mSkeletonConstraints[result.first->second];
+      entry.mBlocks.push_back(std::make_pair(i, k));
+      entry.mNumRows += constraint->getDimension();
+    }
+  }
+  mHasSkeletonConstraints = true;
+
+  if (!isInvMassMatrixEquivalent)
+    return false;
+
+  // Computing an inverse mass matrix costs one articulated body sweep per
+  // degree of freedom while impulse tests cost one sweep per constraint row.
+  if (DelassusAssembly::AUTO == mDelassusAssembly)
+  {
+    std::size_t numDofs = 0u;
+    std::size_t numRows = 0u;
+    for (const SkeletonConstraints& entry : mSkeletonConstraints)
+    {
+      numDofs += entry.mSkeleton->getNumDofs();
+      numRows += entry.mNumRows;
+    }
+
+    if (numDofs > numRows)
+      return false;
+  }
+
+  mA.setZero();
+
+  // Fill upper triangle blocks of A matrix: A_ij += J_i * M^-1 * J_j^T
+  for (const SkeletonConstraints& entry : mSkeletonConstraints)
+  {
+    if (entry.mSkeleton->getNumDofs() == 0u)
+      continue;
+
+    const Eigen::MatrixXd& invM = entry.mSkeleton->getInvMassMatrix();
+    for (std::size_t a = 0u; a < entry.mBlocks.size(); ++a)
+    {
+      const std::size_t i = entry.mBlocks[a].first;
+      const Eigen::MatrixXd& Ji = mJacobians[i].blocks[entry.mBlocks[a].second];
+      mJMInv.noalias() = Ji * invM;
+
+      for (std::size_t b = a; b < entry.mBlocks.size(); ++b)
+      {
+        const std::size_t j = entry.mBlocks[b].first;
+        const Eigen::MatrixXd& Jj
+            = mJacobians[j].blocks[entry.mBlocks[b].second];
+        mA.block(mOffset[i], mOffset[j], Ji.rows(), Jj.rows()).noalias()
+            += mJMInv * Jj.transpose();
+      }
+    }
+  }
+
+  // Add small values to the diagonal to keep it away from singular, the same
+  // way getVelocityChange() does with the constraint force mixing parameter
+  for (std::size_t i = 0u; i < numConstraints; ++i)
+  {
+    const double cfm = mJacobians[i].cfm;
+    for (std::size_t j = 0u; j < group.getConstraint(i)->getDimension(); ++j)
+    {
+      const int index = mOffset[i] + j;
+      mA(index, index) += mA(index, index) * cfm;
+    }
+  }
+
+  // Filling symmetric part of A matrix
+  const int n = static_cast<int>(mA.rows());
+  for (int i = 1; i < n; ++i)
+  {
+    for (int j = 0; j < i; ++j)
+      mA(i, j) = mA(j, i);
+  }
+
+  return true;
+}
+
+//==============================================================================
+void BoxedLcpConstraintSolver::setRowCoupling()
+{
+  mCouplingGroupStarts.clear();
+  mCouplingRows.clear();
+
+  // Without the skeletons of all the constraints, the empty coupling makes the
+  // solvers find the coupling in A. It also replaces the coupling of a previous
+  // group that a solver didn't use.
+  if (mHasSkeletonConstraints)
+  {
+    for (const SkeletonConstraints& entry : mSkeletonConstraints)
+    {
+      // Skeletons without degrees of freedom don't couple the constraints
+      if (entry.mSkeleton->getNumDofs() == 0u)
+        continue;
+
+      mCouplingGroupStarts.push_back(static_cast<int>(mCouplingRows.size()));
+      for (const auto& block : entry.mBlocks)
+      {
+        const std::size_t i = block.first;
+        const Eigen::Index dim = mJacobians[i].blocks[block.second].rows();
+        for (Eigen::Index j = 0; j < dim; ++j)
+          mCouplingRows.push_back(mOffset[i] + static_cast<int>(j));
+      }
+    }
+    mCouplingGroupStarts.push_back(static_cast<int>(mCouplingRows.size()));
+  }
+
+  mBoxedLcpSolver->setRowCoupling(mCouplingGroupStarts, mCouplingRows);
+  if (mSecondaryBoxedLcpSolver)
+  {
+    mSecondaryBoxedLcpSolver->setRowCoupling(
+        mCouplingGroupStarts, mCouplingRows);
+  }
+}
+
 //==============================================================================
 #ifndef NDEBUG
 bool BoxedLcpConstraintSolver::isSymmetric(std::size_t n, double* A)
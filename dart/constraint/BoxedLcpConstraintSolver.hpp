@@ -33,6 +33,11 @@
 #ifndef DART_CONSTRAINT_BOXEDLCPCONSTRAINTSOLVER_HPP_
 #define DART_CONSTRAINT_BOXEDLCPCONSTRAINTSOLVER_HPP_
 
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dart/constraint/ConstraintBase.hpp"
 #include "dart/constraint/ConstraintSolver.hpp"
 #include "dart/constraint/SmartPointer.hpp"
 
@@ -42,6 +47,25 @@ namespace constraint {
 class BoxedLcpConstraintSolver : public ConstraintSolver
 {
 public:
+  /// Methods to fill the matrix A (the Delassus matrix) of the boxed LCP
+  enum class DelassusAssembly : int
+  {
+    /// Use JACOBIAN when the constrained group has fewer degrees of freedom
+    /// than constraint rows, and IMPULSE_TESTS otherwise.
+    AUTO = 0,
+
+    /// Apply a unit impulse for every constraint row and measure the velocity
+    /// changes of all the constraints. This costs one articulated body sweep
+    /// per constraint row.
+    IMPULSE_TESTS,
+
+    /// Compute A = J * M^-1 * J^T from the constraint Jacobians and the
+    /// inverse mass matrices of the skeletons. Groups that contain a
+    /// constraint or skeleton that doesn't support this fall back to
+    /// IMPULSE_TESTS.
+    JACOBIAN
+  };
+
   /// Constructor
   ///
   /// \param[in] timeStep Simulation time step
@@ -97,10 +121,46 @@ public:
   /// failed
   ConstBoxedLcpSolverPtr getSecondaryBoxedLcpSolver() const;
 
+  /// Sets the method to fill the matrix of the boxed LCP. The default is
+  /// DelassusAssembly::AUTO.
+  void setDelassusAssembly(DelassusAssembly assembly);
+
+  /// Returns the method to fill the matrix of the boxed LCP
+  DelassusAssembly getDelassusAssembly() const;
+
 protected:
   // Documentation inherited.
   void solveConstrainedGroup(ConstrainedGroup& group) override;
 
+  /// Fills mA by impulse tests
+  void assembleDelassusMatrixByImpulseTests(ConstrainedGroup& group);
+
+  /// Fills mA from the constraint Jacobians. Returns false without touching mA
+  /// when a constraint or a skeleton of the group doesn't support it, or when
+  /// impulse tests are expected to be cheaper in DelassusAssembly::AUTO mode.
+  /// mHasSkeletonConstraints tells whether the Jacobians of all the
+  /// constraints were collected anyway.
+  bool assembleDelassusMatrixByJacobians(ConstrainedGroup& group);
+
+  /// Passes the rows of the constraints that act on the same skeleton to the
+  /// LCP solvers as the row coupling of A, or no coupling if
+  /// mHasSkeletonConstraints is false
+  void setRowCoupling();
+
+  /// Constraints of a constrained group that act on the same skeleton
+  struct SkeletonConstraints
+  {
+    /// The skeleton
+    dynamics::Skeleton* mSkeleton;
+
+    /// Pairs of constraint index in the group and block index in the
+    /// constraint's Jacobian, in increasing order of constraint index
+    std::vector<std::pair<std::size_t, std::size_t>> mBlocks;
+
+    /// Total number of constraint rows acting on the skeleton
+    std::size_t mNumRows;
+  };
+
   /// Boxed LCP solver
   BoxedLcpSolverPtr mBoxedLcpSolver;
   // TODO(JS): Hold as unique_ptr because there is no reason to share. Make this
@@ -154,6 +214,31 @@ protected:
   /// Cache data for boxed LCP formulation
   Eigen::VectorXi mOffset;
 
+  /// Method to fill the matrix of the boxed LCP
+  DelassusAssembly mDelassusAssembly;
+
+  /// Cache data for the Jacobian-based assembly of the LCP matrix
+  std::vector<ConstraintJacobian> mJacobians;
+
+  /// Cache data for the Jacobian-based assembly of the LCP matrix
+  std::vector<SkeletonConstraints> mSkeletonConstraints;
+
+  /// Cache data for the Jacobian-based assembly of the LCP matrix
+  std::unordered_map<const dynamics::Skeleton*, std::size_t>
+      mSkeletonConstraintsIndices;
+
+  /// Cache data for the Jacobian-based assembly of the LCP matrix
+  Eigen::MatrixXd mJMInv;
+
+  /// Whether mSkeletonConstraints holds all the constraints of the group
+  bool mHasSkeletonConstraints;
+
+  /// Cache data for the row coupling of the LCP matrix
+  std::vector<int> mCouplingGroupStarts;
+
+  /// Cache data for the row coupling of the LCP matrix
+  std::vector<int> mCouplingRows;
+
 #ifndef NDEBUG
 private:
   /// Return true if the matrix is symmetric
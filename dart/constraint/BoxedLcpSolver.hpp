@@ -34,6 +34,7 @@
 #define DART_CONSTRAINT_BOXEDLCPSOLVER_HPP_
 
 #include <string>
+#include <vector>
 #include <Eigen/Core>
 
 namespace dart {
@@ -101,6 +102,15 @@ public:
       bool earlyTermination = false)
       = 0;
 
+  /// Sets which rows of A can be coupled in the next call of solve(), e.g.,
+  /// the rows of the constraints that act on the same skeleton. A[i][j] may
+  /// only be nonzero if rows i and j share a group, and the rows of group g
+  /// are rows[groupStarts[g]], ..., rows[groupStarts[g + 1] - 1]. Solvers that
+  /// exploit the sparsity of A use this instead of scanning A. The default
+  /// implementation ignores it.
+  virtual void setRowCoupling(
+      const std::vector<int>& groupStarts, const std::vector<int>& rows);
+
 #ifndef NDEBUG
   virtual bool canSolve(int n, const double* A) = 0;
 #endif
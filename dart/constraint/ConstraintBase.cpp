@@ -37,11 +37,39 @@
 #include <iomanip>
 #include <iostream>
 
+#include "dart/dynamics/Joint.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 
 namespace dart {
 namespace constraint {
 
+//==============================================================================
+void ConstraintJacobian::clear()
+{
+  skeletons.clear();
+}
+
+//==============================================================================
+Eigen::MatrixXd& ConstraintJacobian::getBlock(
+    dynamics::Skeleton* skeleton, std::size_t dim)
+{
+  for (std::size_t i = 0u; i < skeletons.size(); ++i)
+  {
+    if (skeletons[i] == skeleton)
+      return blocks[i];
+  }
+
+  skeletons.push_back(skeleton);
+  if (blocks.size() < skeletons.size())
+    blocks.resize(skeletons.size());
+
+  Eigen::MatrixXd& block = blocks[skeletons.size() - 1u];
+  block.setZero(
+      static_cast<int>(dim), static_cast<int>(skeleton->getNumDofs()));
+
+  return block;
+}
+
 //==============================================================================
 ConstraintBase::ConstraintBase()
   : mDim(0)
@@ -59,6 +87,54 @@ std::size_t ConstraintBase::getDimension() const
   return mDim;
 }
 
+//==============================================================================
+bool ConstraintBase::getJacobian(ConstraintJacobian& /*jacobian*/)
+{
+  return false;
+}
+
+//==============================================================================
+Eigen::VectorXd ConstraintBase::getWarmStartImpulses() const
+{
+  return Eigen::VectorXd();
+}
+
+//==============================================================================
+void ConstraintBase::setWarmStartImpulses(const Eigen::VectorXd& /*impulses*/)
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool ConstraintBase::getJointJacobian(
+    dynamics::Joint* joint,
+    const bool* active,
+    double cfm,
+    ConstraintJacobian& jacobian) const
+{
+  jacobian.clear();
+  jacobian.cfm = cfm;
+
+  Eigen::MatrixXd& block
+      = jacobian.getBlock(joint->getSkeleton().get(), mDim);
+
+  std::size_t localIndex = 0;
+  std::size_t dof = joint->getNumDofs();
+  for (std::size_t i = 0; i < dof; ++i)
+  {
+    if (active[i] == false)
+      continue;
+
+    block(localIndex, joint->getIndexInSkeleton(i)) = 1.0;
+
+    ++localIndex;
+  }
+
+  assert(localIndex == mDim);
+
+  return true;
+}
+
 //==============================================================================
 void ConstraintBase::uniteSkeletons()
 {
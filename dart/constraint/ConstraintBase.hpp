@@ -34,12 +34,16 @@
 #define DART_CONSTRAINT_CONSTRAINTBASE_HPP_
 
 #include <cstddef>
+#include <vector>
+
+#include <Eigen/Dense>
 
 #include "dart/dynamics/SmartPointer.hpp"
 
 namespace dart {
 
 namespace dynamics {
+class Joint;
 class Skeleton;
 }  // namespace dynamics
 
@@ -70,6 +74,32 @@ struct ConstraintInfo
   double invTimeStep;
 };
 
+/// ConstraintJacobian holds the generalized Jacobian of a constraint split into
+/// one dense block per skeleton that the constraint acts on. It allows the
+/// constraint solver to assemble the Delassus matrix J * M^-1 * J^T directly
+/// instead of running one impulse test per constraint row.
+struct ConstraintJacobian
+{
+  /// Skeletons whose generalized velocities the constraint depends on
+  std::vector<dynamics::Skeleton*> skeletons;
+
+  /// Jacobian blocks of size (constraint dimension x skeleton DOFs). The i-th
+  /// block belongs to the i-th skeleton. There can be more blocks than
+  /// skeletons so that the memory of unused blocks can be reused.
+  std::vector<Eigen::MatrixXd> blocks;
+
+  /// Constraint force mixing that getVelocityChange() scales the diagonal of
+  /// the constraint block with
+  double cfm = 0.0;
+
+  /// Removes all the skeletons while keeping the memory of the blocks
+  void clear();
+
+  /// Returns the block of skeleton, adding a zero block of size
+  /// (dim x skeleton DOFs) when the skeleton wasn't added yet
+  Eigen::MatrixXd& getBlock(dynamics::Skeleton* skeleton, std::size_t dim);
+};
+
 /// Constraint is a base class of concrete constraints classes
 class ConstraintBase
 {
@@ -98,6 +128,23 @@ public:
   /// Apply computed constraint impulse to constrained skeletons
   virtual void applyImpulse(double* lambda) = 0;
 
+  /// Fill the generalized Jacobian of this constraint. The velocity change that
+  /// getVelocityChange() reports for a unit impulse on row j has to be equal to
+  /// J * M^-1 * J^T e_j, where M is the mass matrix of the skeletons in
+  /// jacobian. Return false when the constraint can't be expressed this way,
+  /// in which case the constraint solver falls back to impulse tests. The
+  /// default implementation returns false.
+  virtual bool getJacobian(ConstraintJacobian& jacobian);
+
+  /// Return the impulses that the next solve starts from, e.g., the impulses
+  /// of the last solve. The default implementation returns an empty vector
+  /// for constraints that don't warm start.
+  virtual Eigen::VectorXd getWarmStartImpulses() const;
+
+  /// Set the impulses that the next solve starts from. The default
+  /// implementation does nothing.
+  virtual void setWarmStartImpulses(const Eigen::VectorXd& impulses);
+
   /// Return true if this constraint is active
   virtual bool isActive() const = 0;
 
@@ -127,6 +174,15 @@ protected:
   /// Destructor
   virtual ~ConstraintBase();
 
+  /// Fill the Jacobian of a constraint on the DOFs of joint for which active
+  /// is true, with one unit row per active DOF. This is the Jacobian of the
+  /// joint constraints.
+  bool getJointJacobian(
+      dynamics::Joint* joint,
+      const bool* active,
+      double cfm,
+      ConstraintJacobian& jacobian) const;
+
 protected:
   /// Dimension of constraint
   std::size_t mDim;
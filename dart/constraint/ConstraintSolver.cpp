@@ -112,14 +112,42 @@ void ConstraintSolver::addSkeleton(const SkeletonPtr& skeleton)
 
   mCollisionGroup->subscribeTo(skeleton);
   mSkeletons.push_back(skeleton);
+  mSkeletonSet.insert(skeleton.get());
   mConstrainedGroups.reserve(mSkeletons.size());
 }
 
 //==============================================================================
 void ConstraintSolver::addSkeletons(const std::vector<SkeletonPtr>& skeletons)
 {
+  mSkeletons.reserve(mSkeletons.size() + skeletons.size());
+  mSkeletonSet.reserve(mSkeletonSet.size() + skeletons.size());
+
+  std::vector<dynamics::ConstSkeletonPtr> added;
+  added.reserve(skeletons.size());
+
   for (const auto& skeleton : skeletons)
-    addSkeleton(skeleton);
+  {
+    assert(skeleton
+        && "Null pointer skeleton is now allowed to add to ConstraintSover.");
+
+    if (containSkeleton(skeleton))
+    {
+      dtwarn << "[ConstraintSolver::addSkeletons] Attempting to add "
+             << "skeleton '" << skeleton->getName()
+             << "', which already exists in the ConstraintSolver.\n";
+
+      continue;
+    }
+
+    mSkeletons.push_back(skeleton);
+    mSkeletonSet.insert(skeleton.get());
+    added.push_back(skeleton);
+  }
+
+  // Subscribing to all the skeletons at once lets the collision group hand
+  // their collision objects to the engine in a single batch.
+  mCollisionGroup->subscribeTo(added);
+  mConstrainedGroups.reserve(mSkeletons.size());
 }
 
 //==============================================================================
@@ -144,6 +172,7 @@ void ConstraintSolver::removeSkeleton(const SkeletonPtr& skeleton)
   mCollisionGroup->removeShapeFramesOf(skeleton.get());
   mSkeletons.erase(remove(mSkeletons.begin(), mSkeletons.end(), skeleton),
                    mSkeletons.end());
+  mSkeletonSet.erase(skeleton.get());
   mConstrainedGroups.reserve(mSkeletons.size());
 }
 
@@ -151,8 +180,53 @@ void ConstraintSolver::removeSkeleton(const SkeletonPtr& skeleton)
 void ConstraintSolver::removeSkeletons(
     const std::vector<SkeletonPtr>& skeletons)
 {
+  if (skeletons.size() < 2u)
+  {
+    for (const auto& skeleton : skeletons)
+      removeSkeleton(skeleton);
+
+    return;
+  }
+
+  // Gather the collision shapes of all the skeletons so that the collision
+  // group and mSkeletons are each updated in a single pass.
+  std::vector<const dynamics::ShapeFrame*> shapeFrames;
   for (const auto& skeleton : skeletons)
-    removeSkeleton(skeleton);
+  {
+    assert(skeleton
+        && "Null pointer skeleton is now allowed to add to ConstraintSover.");
+
+    if (!containSkeleton(skeleton))
+    {
+      dtwarn << "[ConstraintSolver::removeSkeletons] Attempting to remove "
+             << "skeleton '" << skeleton->getName()
+             << "', which doesn't exist in the ConstraintSolver.\n";
+    }
+
+    for (std::size_t i = 0u; i < skeleton->getNumBodyNodes(); ++i)
+    {
+      const auto collisionShapeNodes
+          = skeleton->getBodyNode(i)
+                ->getShapeNodesWith<dynamics::CollisionAspect>();
+      shapeFrames.insert(
+          shapeFrames.end(),
+          collisionShapeNodes.begin(),
+          collisionShapeNodes.end());
+    }
+
+    mSkeletonSet.erase(skeleton.get());
+  }
+
+  mCollisionGroup->removeShapeFrames(shapeFrames);
+
+  mSkeletons.erase(
+      std::remove_if(
+          mSkeletons.begin(),
+          mSkeletons.end(),
+          [this](const SkeletonPtr& skeleton) {
+            return mSkeletonSet.find(skeleton.get()) == mSkeletonSet.end();
+          }),
+      mSkeletons.end());
 }
 
 //==============================================================================
@@ -160,6 +234,7 @@ void ConstraintSolver::removeAllSkeletons()
 {
   mCollisionGroup->removeAllShapeFrames();
   mSkeletons.clear();
+  mSkeletonSet.clear();
 }
 
 //==============================================================================
@@ -379,6 +454,25 @@ DART_SUPPRESS_DEPRECATED_END
   solveConstrainedGroups();
 }
 
+//==============================================================================
+void ConstraintSolver::saveWarmStarts()
+{
+  mSavedWarmStarts.resize(mManualConstraints.size());
+  for (std::size_t i = 0u; i < mManualConstraints.size(); ++i)
+    mSavedWarmStarts[i] = mManualConstraints[i]->getWarmStartImpulses();
+}
+
+//==============================================================================
+void ConstraintSolver::restoreWarmStarts()
+{
+  // The manual constraints may have changed since saveWarmStarts()
+  if (mSavedWarmStarts.size() != mManualConstraints.size())
+    return;
+
+  for (std::size_t i = 0u; i < mManualConstraints.size(); ++i)
+    mManualConstraints[i]->setWarmStartImpulses(mSavedWarmStarts[i]);
+}
+
 //==============================================================================
 void ConstraintSolver::setFromOtherConstraintSolver(
     const ConstraintSolver& other)
@@ -395,14 +489,7 @@ bool ConstraintSolver::containSkeleton(const ConstSkeletonPtr& _skeleton) const
 {
   assert(_skeleton != nullptr && "Not allowed to insert null pointer skeleton.");
 
-  for (std::vector<SkeletonPtr>::const_iterator it = mSkeletons.begin();
-       it != mSkeletons.end(); ++it)
-  {
-    if ((*it) == _skeleton)
-      return true;
-  }
-
-  return false;
+  return mSkeletonSet.find(_skeleton.get()) != mSkeletonSet.end();
 }
 
 //==============================================================================
@@ -411,6 +498,7 @@ bool ConstraintSolver::checkAndAddSkeleton(const SkeletonPtr& skeleton)
   if (!containSkeleton(skeleton))
   {
     mSkeletons.push_back(skeleton);
+    mSkeletonSet.insert(skeleton.get());
     return true;
   }
   else
@@ -546,6 +634,11 @@ DART_SUPPRESS_DEPRECATED_END
   // Create new joint constraints
   for (const auto& skel : mSkeletons)
   {
+    // Sleeping skeletons are at rest, so their joints don't need to be
+    // constrained.
+    if (skel->isSleeping())
+      continue;
+
     const std::size_t numJoints = skel->getNumJoints();
     for (std::size_t i = 0; i < numJoints; i++)
     {
@@ -668,6 +761,60 @@ void ConstraintSolver::buildConstrainedGroups()
     mConstrainedGroups[skel->mUnionIndex].addConstraint(activeConstraint);
   }
 
+  //----------------------------------------------------------------------------
+  // Handle sleeping skeletons
+  //----------------------------------------------------------------------------
+  // A group is awake if it contains at least one mobile skeleton that is not
+  // sleeping. The sleeping skeletons in awake groups are constrained with (e.g.,
+  // in contact with) awake skeletons, so they are woken up. The groups that
+  // only consist of sleeping and immobile skeletons don't need to be solved.
+  const bool hasSleepingSkeleton
+      = std::any_of(mSkeletons.begin(), mSkeletons.end(),
+                    [](const SkeletonPtr& skeleton)
+                    { return skeleton->isSleeping(); });
+
+  if (hasSleepingSkeleton)
+  {
+    const std::size_t numGroups = mConstrainedGroups.size();
+    std::vector<std::size_t> groupIndices(mSkeletons.size(), numGroups);
+    std::vector<bool> isGroupAwake(numGroups, false);
+
+    for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+    {
+      const auto& skeleton = mSkeletons[i];
+      const auto root = ConstraintBase::getRootSkeleton(skeleton);
+
+      // The union index is only valid for the roots of the groups built above
+      const std::size_t index = root->mUnionIndex;
+      if (index >= numGroups || mConstrainedGroups[index].mRootSkeleton != root)
+        continue;
+
+      groupIndices[i] = index;
+
+      if (skeleton->isMobile() && !skeleton->isSleeping())
+        isGroupAwake[index] = true;
+    }
+
+    for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+    {
+      const std::size_t index = groupIndices[i];
+      if (index < numGroups && isGroupAwake[index])
+        mSkeletons[i]->wakeUp();
+    }
+
+    std::size_t numAwakeGroups = 0u;
+    for (std::size_t i = 0u; i < numGroups; ++i)
+    {
+      if (!isGroupAwake[i])
+        continue;
+
+      if (numAwakeGroups != i)
+        mConstrainedGroups[numAwakeGroups] = std::move(mConstrainedGroups[i]);
+      ++numAwakeGroups;
+    }
+    mConstrainedGroups.resize(numAwakeGroups);
+  }
+
   //----------------------------------------------------------------------------
   // Reset union since we don't need union information anymore.
   //----------------------------------------------------------------------------
@@ -33,6 +33,7 @@
 #ifndef DART_CONSTRAINT_CONSTRAINTSOVER_HPP_
 #define DART_CONSTRAINT_CONSTRAINTSOVER_HPP_
 
+#include <unordered_set>
 #include <vector>
 
 #include <Eigen/Dense>
@@ -179,6 +180,15 @@ public:
   /// Solve constraint impulses and apply them to the skeletons
   void solve();
 
+  /// Save the state that the next solve() starts from, i.e., the warm start
+  /// impulses of the manually added constraints, so that a step can be taken
+  /// again from the same state after restoreWarmStarts(). The automatic
+  /// constraints are created anew in every solve() and don't keep warm starts.
+  virtual void saveWarmStarts();
+
+  /// Restore the state saved by the last saveWarmStarts()
+  virtual void restoreWarmStarts();
+
   /// Sets this constraint solver using other constraint solver. All the
   /// properties and registered skeletons and constraints will be copied over.
   virtual void setFromOtherConstraintSolver(const ConstraintSolver& other);
@@ -231,6 +241,9 @@ protected:
   /// Skeleton list
   std::vector<dynamics::SkeletonPtr> mSkeletons;
 
+  /// Skeletons in mSkeletons for constant time membership tests
+  std::unordered_set<const dynamics::Skeleton*> mSkeletonSet;
+
   /// Contact constraints those are automatically created
   std::vector<ContactConstraintPtr> mContactConstraints;
 
@@ -252,6 +265,9 @@ protected:
   /// Constraints that manually added
   std::vector<ConstraintBasePtr> mManualConstraints;
 
+  /// Warm start impulses of mManualConstraints saved by saveWarmStarts()
+  std::vector<Eigen::VectorXd> mSavedWarmStarts;
+
   /// Active constraints
   std::vector<ConstraintBasePtr> mActiveConstraints;
 
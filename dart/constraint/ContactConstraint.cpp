@@ -567,6 +567,41 @@ void ContactConstraint::getVelocityChange(double* vel, bool withCfm)
   }
 }
 
+//==============================================================================
+bool ContactConstraint::getJacobian(ConstraintJacobian& jacobian)
+{
+  jacobian.clear();
+  jacobian.cfm = mConstraintForceMixing;
+
+  // Only the reactive bodies take part in the impulse tests, so the Jacobian
+  // only has contributions from those as well. Both bodies write into the same
+  // block in the self-collision case.
+  const auto addBodyJacobian
+      = [&](dynamics::BodyNode* bodyNode,
+            const Eigen::Matrix<double, 6, Eigen::Dynamic>& spatialNormal) {
+          if (!bodyNode->isReactive())
+            return;
+
+          Eigen::MatrixXd& block
+              = jacobian.getBlock(bodyNode->getSkeleton().get(), mDim);
+          const math::Jacobian& bodyJacobian = bodyNode->getJacobian();
+          for (std::size_t i = 0u; i < bodyNode->getNumDependentGenCoords();
+               ++i)
+          {
+            const int index
+                = static_cast<int>(bodyNode->getDependentGenCoordIndex(i));
+            block.col(index).noalias()
+                += spatialNormal.transpose()
+                   * bodyJacobian.col(static_cast<int>(i));
+          }
+        };
+
+  addBodyJacobian(mBodyNodeA, mSpatialNormalA);
+  addBodyJacobian(mBodyNodeB, mSpatialNormalB);
+
+  return true;
+}
+
 //==============================================================================
 void ContactConstraint::excite()
 {
@@ -114,6 +114,9 @@ protected:
   // Documentation inherited
   void getVelocityChange(double* vel, bool withCfm) override;
 
+  // Documentation inherited
+  bool getJacobian(ConstraintJacobian& jacobian) override;
+
   // Documentation inherited
   void excite() override;
 
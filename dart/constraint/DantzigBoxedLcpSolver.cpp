@@ -37,6 +37,16 @@
 namespace dart {
 namespace constraint {
 
+//==============================================================================
+DantzigBoxedLcpSolver::DantzigBoxedLcpSolver()
+  : mWorkspace(new dLCPWorkspace())
+{
+  // Do nothing
+}
+
+//==============================================================================
+DantzigBoxedLcpSolver::~DantzigBoxedLcpSolver() = default;
+
 //==============================================================================
 const std::string& DantzigBoxedLcpSolver::getType() const
 {
@@ -62,7 +72,18 @@ bool DantzigBoxedLcpSolver::solve(
     int* findex,
     bool earlyTermination)
 {
-  return dSolveLCP(n, A, x, b, nullptr, 0, lo, hi, findex, earlyTermination);
+  return dSolveLCP(
+      n,
+      A,
+      x,
+      b,
+      nullptr,
+      0,
+      lo,
+      hi,
+      findex,
+      earlyTermination,
+      *mWorkspace);
 }
 
 #ifndef NDEBUG
@@ -33,14 +33,23 @@
 #ifndef DART_CONSTRAINT_DANTZIGBOXEDLCPSOLVER_HPP_
 #define DART_CONSTRAINT_DANTZIGBOXEDLCPSOLVER_HPP_
 
+#include <memory>
 #include "dart/constraint/BoxedLcpSolver.hpp"
 
+struct dLCPWorkspace;
+
 namespace dart {
 namespace constraint {
 
 class DantzigBoxedLcpSolver : public BoxedLcpSolver
 {
 public:
+  /// Constructor
+  DantzigBoxedLcpSolver();
+
+  /// Destructor
+  ~DantzigBoxedLcpSolver() override;
+
   // Documentation inherited.
   const std::string& getType() const override;
 
@@ -63,6 +72,11 @@ public:
   // Documentation inherited.
   bool canSolve(int n, const double* A) override;
 #endif
+
+protected:
+  /// Temporary arrays of the Dantzig solver that are reused across the calls
+  /// of solve(). The workspace only grows when a larger problem is solved.
+  std::unique_ptr<dLCPWorkspace> mWorkspace;
 };
 
 } // namespace constraint
@@ -236,6 +236,13 @@ void JointCoulombFrictionConstraint::getVelocityChange(double* _delVel,
   assert(localIndex == mDim);
 }
 
+//==============================================================================
+bool JointCoulombFrictionConstraint::getJacobian(ConstraintJacobian& _jacobian)
+{
+  return getJointJacobian(
+      mJoint, mActive, mConstraintForceMixing, _jacobian);
+}
+
 //==============================================================================
 void JointCoulombFrictionConstraint::excite()
 {
@@ -346,6 +346,13 @@ void JointLimitConstraint::getVelocityChange(double* _delVel, bool _withCfm)
   assert(localIndex == mDim);
 }
 
+//==============================================================================
+bool JointLimitConstraint::getJacobian(ConstraintJacobian& _jacobian)
+{
+  return getJointJacobian(
+      mJoint, mActive, mConstraintForceMixing, _jacobian);
+}
+
 //==============================================================================
 void JointLimitConstraint::excite()
 {
@@ -107,6 +107,9 @@ protected:
   // Documentation inherited
   void getVelocityChange(double* _delVel, bool _withCfm) override;
 
+  // Documentation inherited
+  bool getJacobian(ConstraintJacobian& _jacobian) override;
+
   // Documentation inherited
   void excite() override;
 
@@ -249,6 +249,13 @@ void MimicMotorConstraint::getVelocityChange(double* delVel, bool withCfm)
   assert(localIndex == mDim);
 }
 
+//==============================================================================
+bool MimicMotorConstraint::getJacobian(ConstraintJacobian& jacobian)
+{
+  return getJointJacobian(
+      mJoint, mActive, mConstraintForceMixing, jacobian);
+}
+
 //==============================================================================
 void MimicMotorConstraint::excite()
 {
@@ -36,7 +36,6 @@
 #include <cstring>
 #include <Eigen/Dense>
 #include "dart/external/odelcpsolver/matrix.h"
-#include "dart/external/odelcpsolver/misc.h"
 #include "dart/math/Constants.hpp"
 
 #define PGS_EPSILON 10e-9
@@ -184,7 +183,7 @@ bool PgsBoxedLcpSolver::solve(
         for (std::size_t i = 1; i < mCacheOrder.size(); ++i)
         {
           const int tmp = mCacheOrder[i];
-          const int swapi = dRandInt(i + 1);
+          const int swapi = mRandomStream.uniform<int>(0, static_cast<int>(i));
           mCacheOrder[i] = mCacheOrder[swapi];
           mCacheOrder[swapi] = tmp;
         }
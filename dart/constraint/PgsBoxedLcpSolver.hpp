@@ -35,6 +35,7 @@
 
 #include <vector>
 #include "dart/constraint/BoxedLcpSolver.hpp"
+#include "dart/math/Random.hpp"
 
 namespace dart {
 namespace constraint {
@@ -97,6 +98,10 @@ protected:
   mutable Eigen::MatrixXd mCachedNormalizedB;
   mutable Eigen::VectorXd mCacheZ;
   mutable Eigen::VectorXd mCacheOldX;
+
+  /// Random stream used to shuffle the constraint order. Each solver owns its
+  /// stream so that solvers running in different threads don't share state.
+  math::RandomStream mRandomStream;
 };
 
 } // namespace constraint
@@ -238,6 +238,13 @@ void ServoMotorConstraint::getVelocityChange(double* delVel, bool withCfm)
   assert(localIndex == mDim);
 }
 
+//==============================================================================
+bool ServoMotorConstraint::getJacobian(ConstraintJacobian& jacobian)
+{
+  return getJointJacobian(
+      mJoint, mActive, mConstraintForceMixing, jacobian);
+}
+
 //==============================================================================
 void ServoMotorConstraint::excite()
 {
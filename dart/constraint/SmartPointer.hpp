@@ -54,6 +54,7 @@ DART_COMMON_DECLARE_SHARED_WEAK(JointCoulombFrictionConstraint)
 DART_COMMON_DECLARE_SHARED_WEAK(LCPSolver)
 DART_COMMON_DECLARE_SHARED_WEAK(BoxedLcpSolver)
 DART_COMMON_DECLARE_SHARED_WEAK(PgsBoxedLcpSolver)
+DART_COMMON_DECLARE_SHARED_WEAK(BlockPgsBoxedLcpSolver)
 DART_COMMON_DECLARE_SHARED_WEAK(PsorBoxedLcpSolver)
 DART_COMMON_DECLARE_SHARED_WEAK(JacobiBoxedLcpSolver)
 
@@ -404,6 +404,22 @@ void WeldJointConstraint::uniteSkeletons()
   }
 }
 
+//==============================================================================
+Eigen::VectorXd WeldJointConstraint::getWarmStartImpulses() const
+{
+  return Eigen::Map<const Eigen::Vector6d>(mOldX);
+}
+
+//==============================================================================
+void WeldJointConstraint::setWarmStartImpulses(const Eigen::VectorXd& impulses)
+{
+  if (impulses.size() != 6)
+    return;
+
+  Eigen::Map<Eigen::Vector6d> oldX(mOldX);
+  oldX = impulses;
+}
+
 //==============================================================================
 bool WeldJointConstraint::isActive() const
 {
@@ -87,6 +87,12 @@ protected:
   // Documentation inherited
   void applyImpulse(double* _lambda) override;
 
+  // Documentation inherited
+  Eigen::VectorXd getWarmStartImpulses() const override;
+
+  // Documentation inherited
+  void setWarmStartImpulses(const Eigen::VectorXd& impulses) override;
+
   // Documentation inherited
   bool isActive() const override;
 
@@ -2184,12 +2184,25 @@ void BodyNode::aggregateAugMassMatrix(Eigen::MatrixXd& _MCol, std::size_t _col,
   std::size_t dof = mParentJoint->getNumDofs();
   if (dof > 0)
   {
+    // The PD servo is integrated implicitly like the spring and the damper,
+    // except for the joints whose motion is prescribed
+    const Joint::ActuatorType actuatorType = mParentJoint->getActuatorType();
+    const bool hasImplicitServo = actuatorType != Joint::ACCELERATION
+                                  && actuatorType != Joint::VELOCITY
+                                  && actuatorType != Joint::LOCKED;
+
     Eigen::MatrixXd K = Eigen::MatrixXd::Zero(dof, dof);
     Eigen::MatrixXd D = Eigen::MatrixXd::Zero(dof, dof);
     for (std::size_t i = 0; i < dof; ++i)
     {
       K(i, i) = mParentJoint->getSpringStiffness(i);
       D(i, i) = mParentJoint->getDampingCoefficient(i);
+
+      if (hasImplicitServo)
+      {
+        K(i, i) += mParentJoint->getPositionServoGain(i);
+        D(i, i) += mParentJoint->getVelocityServoGain(i);
+      }
     }
 
     std::size_t iStart = mParentJoint->getIndexInTree(0);
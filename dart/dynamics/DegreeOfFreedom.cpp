@@ -462,6 +462,54 @@ double DegreeOfFreedom::getDampingCoefficient() const
   return mJoint->getDampingCoefficient(mIndexInJoint);
 }
 
+//==============================================================================
+void DegreeOfFreedom::setPositionServoGain(double _kp)
+{
+  mJoint->setPositionServoGain(mIndexInJoint, _kp);
+}
+
+//==============================================================================
+double DegreeOfFreedom::getPositionServoGain() const
+{
+  return mJoint->getPositionServoGain(mIndexInJoint);
+}
+
+//==============================================================================
+void DegreeOfFreedom::setVelocityServoGain(double _kd)
+{
+  mJoint->setVelocityServoGain(mIndexInJoint, _kd);
+}
+
+//==============================================================================
+double DegreeOfFreedom::getVelocityServoGain() const
+{
+  return mJoint->getVelocityServoGain(mIndexInJoint);
+}
+
+//==============================================================================
+void DegreeOfFreedom::setServoTargetPosition(double _position)
+{
+  mJoint->setServoTargetPosition(mIndexInJoint, _position);
+}
+
+//==============================================================================
+double DegreeOfFreedom::getServoTargetPosition() const
+{
+  return mJoint->getServoTargetPosition(mIndexInJoint);
+}
+
+//==============================================================================
+void DegreeOfFreedom::setServoTargetVelocity(double _velocity)
+{
+  mJoint->setServoTargetVelocity(mIndexInJoint, _velocity);
+}
+
+//==============================================================================
+double DegreeOfFreedom::getServoTargetVelocity() const
+{
+  return mJoint->getServoTargetVelocity(mIndexInJoint);
+}
+
 //==============================================================================
 void DegreeOfFreedom::setCoulombFriction(double _friction)
 {
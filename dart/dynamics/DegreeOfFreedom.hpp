@@ -339,6 +339,34 @@ public:
   /// coordinate
   double getDampingCoefficient() const;
 
+  /// Set position gain of the PD servo force for this generalized coordinate
+  void setPositionServoGain(double _kp);
+
+  /// Get position gain of the PD servo force for this generalized coordinate
+  double getPositionServoGain() const;
+
+  /// Set velocity gain of the PD servo force for this generalized coordinate
+  void setVelocityServoGain(double _kd);
+
+  /// Get velocity gain of the PD servo force for this generalized coordinate
+  double getVelocityServoGain() const;
+
+  /// Set target position of the PD servo force for this generalized
+  /// coordinate
+  void setServoTargetPosition(double _position);
+
+  /// Get target position of the PD servo force for this generalized
+  /// coordinate
+  double getServoTargetPosition() const;
+
+  /// Set target velocity of the PD servo force for this generalized
+  /// coordinate
+  void setServoTargetVelocity(double _velocity);
+
+  /// Get target velocity of the PD servo force for this generalized
+  /// coordinate
+  double getServoTargetVelocity() const;
+
   /// Set Coulomb friction force for this generalized coordinate
   void setCoulombFriction(double _friction);
 
@@ -468,6 +468,30 @@ public:
   // Documentation inherited
   double getDampingCoefficient(std::size_t index) const override;
 
+  // Documentation inherited
+  void setPositionServoGain(std::size_t index, double kp) override;
+
+  // Documentation inherited
+  double getPositionServoGain(std::size_t index) const override;
+
+  // Documentation inherited
+  void setVelocityServoGain(std::size_t index, double kd) override;
+
+  // Documentation inherited
+  double getVelocityServoGain(std::size_t index) const override;
+
+  // Documentation inherited
+  void setServoTargetPosition(std::size_t index, double position) override;
+
+  // Documentation inherited
+  double getServoTargetPosition(std::size_t index) const override;
+
+  // Documentation inherited
+  void setServoTargetVelocity(std::size_t index, double velocity) override;
+
+  // Documentation inherited
+  double getServoTargetVelocity(std::size_t index) const override;
+
   // Documentation inherited
   void setCoulombFriction(std::size_t index, double friction) override;
 
@@ -791,6 +815,10 @@ private:
   void updateTotalForceKinematic(const Eigen::Vector6d& bodyForce,
                                  double timeStep);
 
+  /// Returns the PD servo force where the position error is predicted to the
+  /// end of the step
+  Vector computeServoForce(double timeStep) const;
+
   void updateTotalImpulseDynamic(
       const Eigen::Vector6d& bodyImpulse);
 
@@ -33,6 +33,9 @@
 #ifndef DART_DYNAMICS_HEIGHTMAPSHAPE_HPP_
 #define DART_DYNAMICS_HEIGHTMAPSHAPE_HPP_
 
+#include <memory>
+#include <vector>
+
 #include "dart/dynamics/Shape.hpp"
 
 namespace dart {
@@ -40,6 +43,13 @@ namespace dynamics {
 
 /// Shape for a height map.
 ///
+/// The cells of the height field are grouped into square tiles, each of which
+/// knows the range of heights it spans. Collision detectors use the tiles to
+/// only look at the parts of a large terrain that a query can touch.
+///
+/// The height data is held by a shared pointer so that collision detectors
+/// can use it directly instead of copying it.
+///
 /// \tparam S_ Data type used for height map. At this point, only double and
 /// float are supported. Short and char can be added at a later point.
 template <typename S_>
@@ -51,6 +61,37 @@ public:
   using HeightField
       = Eigen::Matrix<S, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
 
+  /// Rectangular block of cells of the height field. Cell (r, c) is spanned
+  /// by the samples (r, c), (r, c + 1), (r + 1, c), and (r + 1, c + 1).
+  struct Tile
+  {
+    /// Index of the first row of cells of this tile
+    std::size_t mRow;
+
+    /// Index of the first column of cells of this tile
+    std::size_t mCol;
+
+    /// Number of rows of cells of this tile
+    std::size_t mNumRows;
+
+    /// Number of columns of cells of this tile
+    std::size_t mNumCols;
+
+    /// Minimum height of the samples of this tile
+    S mMinHeight;
+
+    /// Maximum height of the samples of this tile
+    S mMaxHeight;
+
+    /// Version of the shape in which the geometry of this tile last changed.
+    /// Collision detectors compare it with the version they built their
+    /// geometry of this tile from, so that only changed tiles are rebuilt.
+    std::size_t mVersion;
+  };
+
+  /// Default number of cells along each side of a tile
+  static constexpr std::size_t DefaultTileSize = 32u;
+
   /// Constructor.
   HeightmapShape();
 
@@ -79,15 +120,11 @@ public:
 
   /// Sets the height field.
   ///
-  /// The data in \e heights will be copied locally.
-  /// It would be nice to have the option to use the values in
-  /// \e heights directly instead of copying them locally to a vector in this
-  /// class (this would avoid any data being kept twice). However some
-  /// collision engine implementations may require to transform the height
-  /// values, e.g. bullet needs the y values flipped. Therefore,
-  /// a (mutable) copy of the height values passed in \e heights will be kept
-  /// in this class. The copied data can be modified via
-  /// getHeightFieldModifiable() and with flipY().
+  /// The data in \e heights will be copied into a new buffer, which the
+  /// collision detectors share instead of keeping copies of their own. The
+  /// copied data can be modified block-wise with setHeights(), with flipY(),
+  /// or in place via getHeightFieldModifiable() followed by
+  /// notifyHeightsChanged().
   ///
   /// \param[in] width Width of the field (x axis)
   /// \param[in] depth Depth of the field (-y axis)
@@ -104,14 +141,71 @@ public:
       const std::size_t& depth,
       const std::vector<S>& heights);
 
+  /// Sets the height field without copying it.
+  ///
+  /// \param[in] heights The height data, where each row goes in x direction
+  /// and the rows go in -y direction. See the other overload for details.
+  void setHeightField(HeightField&& heights);
+
+  /// Overwrites a block of the height field, starting at sample (row, col).
+  ///
+  /// Only the tiles overlapping the block are updated and get the new version
+  /// of this shape, which makes this suitable for streaming parts of a large
+  /// terrain in and out. The other ways of changing the heights mark all the
+  /// tiles as changed.
+  void setHeights(std::size_t row, std::size_t col, const HeightField& block);
+
   /// Returns the height field.
   const HeightField& getHeightField() const;
 
+  /// Returns the height field shared with the collision detectors. The
+  /// pointed-to data stays valid even if the height field of this shape is
+  /// replaced afterwards.
+  std::shared_ptr<const HeightField> getSharedHeightField() const;
+
   /// Returns the modified height field. See also setHeightField().
+  ///
+  /// The tile height ranges, the bounding box, and the collision geometries
+  /// built from this shape are not updated when the data is changed through
+  /// this reference. Call notifyHeightsChanged() once done modifying it, or
+  /// use setHeights() instead.
   HeightField& getHeightFieldModifiable() const;
 
+  /// Updates the tile height ranges, the minimum and maximum heights, and
+  /// the version of this shape after the height field was modified via
+  /// getHeightFieldModifiable().
+  void notifyHeightsChanged();
+
   /// Flips the y values in the height field.
-  void flipY() const;
+  void flipY();
+
+  /// Sets the number of cells along each side of a tile.
+  void setTileSize(std::size_t tileSize);
+
+  /// Returns the number of cells along each side of a tile.
+  std::size_t getTileSize() const;
+
+  /// Returns the number of tiles.
+  std::size_t getNumTiles() const;
+
+  /// Returns a tile.
+  const Tile& getTile(std::size_t index) const;
+
+  /// Returns the bounding box of a tile in the frame of this shape, with the
+  /// scale applied.
+  math::BoundingBox computeTileBoundingBox(std::size_t index) const;
+
+  /// Finds the tiles whose bounding boxes overlap a region.
+  ///
+  /// \param[in] region Region in the frame of this shape.
+  /// \param[out] tiles Indices of the overlapping tiles.
+  void findTiles(
+      const math::BoundingBox& region, std::vector<std::size_t>& tiles) const;
+
+  /// Returns the position of the sample at (row, col) in the frame of this
+  /// shape, with the scale applied. The field is centered around the origin
+  /// in x and y.
+  Eigen::Vector3d getVertex(std::size_t row, std::size_t col) const;
 
   /// Returns the width dimension of the height field
   std::size_t getWidth() const;
@@ -141,12 +235,31 @@ protected:
   /// \param[out] max Maxinum of box
   void computeBoundingBox(Eigen::Vector3d& min, Eigen::Vector3d& max) const;
 
+  /// Splits the height field into tiles and computes their height ranges.
+  /// The tiles get the version that the next incrementVersion() sets.
+  void updateTiles() const;
+
+  /// Computes the height range of a tile.
+  void updateTileHeights(Tile& tile) const;
+
+  /// Computes the minimum and maximum heights from the tiles.
+  void updateMinMaxHeights();
+
 private:
   /// Scale of the heightmap
   Eigen::Vector3d mScale;
 
   /// Height field
-  mutable HeightField mHeights;
+  std::shared_ptr<HeightField> mHeights;
+
+  /// Number of cells along each side of a tile
+  std::size_t mTileSize;
+
+  /// Number of tiles along the columns of the height field
+  mutable std::size_t mNumTileCols;
+
+  /// Tiles, in row-major order
+  mutable std::vector<Tile> mTiles;
 
   /// Minimum heights.
   /// Is computed each time the height field is set with setHeightField().
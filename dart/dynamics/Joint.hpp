@@ -582,6 +582,48 @@ public:
   /// \param[in] _index Index of joint axis.
   virtual double getDampingCoefficient(std::size_t _index) const = 0;
 
+  /// Set position gain of the joint PD servo force
+  ///   -kp * (q - target position) - kd * (dq - target velocity).
+  ///
+  /// Like the spring and damping forces, the servo force is integrated
+  /// implicitly in the forward dynamics, so stiff gains stay stable at large
+  /// time steps. It's applied to the joints whose actuator type is FORCE,
+  /// PASSIVE, SERVO, or MIMIC.
+  /// \param[in] _index Index of joint axis.
+  /// \param[in] _kp Position gain.
+  virtual void setPositionServoGain(std::size_t _index, double _kp) = 0;
+
+  /// Get position gain of the joint PD servo force.
+  /// \param[in] _index Index of joint axis.
+  virtual double getPositionServoGain(std::size_t _index) const = 0;
+
+  /// Set velocity gain of the joint PD servo force.
+  /// \param[in] _index Index of joint axis.
+  /// \param[in] _kd Velocity gain.
+  virtual void setVelocityServoGain(std::size_t _index, double _kd) = 0;
+
+  /// Get velocity gain of the joint PD servo force.
+  /// \param[in] _index Index of joint axis.
+  virtual double getVelocityServoGain(std::size_t _index) const = 0;
+
+  /// Set target position of the joint PD servo force.
+  /// \param[in] _index Index of joint axis.
+  /// \param[in] _position Target position.
+  virtual void setServoTargetPosition(std::size_t _index, double _position) = 0;
+
+  /// Get target position of the joint PD servo force.
+  /// \param[in] _index Index of joint axis.
+  virtual double getServoTargetPosition(std::size_t _index) const = 0;
+
+  /// Set target velocity of the joint PD servo force.
+  /// \param[in] _index Index of joint axis.
+  /// \param[in] _velocity Target velocity.
+  virtual void setServoTargetVelocity(std::size_t _index, double _velocity) = 0;
+
+  /// Get target velocity of the joint PD servo force.
+  /// \param[in] _index Index of joint axis.
+  virtual double getServoTargetVelocity(std::size_t _index) const = 0;
+
   /// Set joint Coulomb friction froce.
   /// \param[in] _index Index of joint axis.
   /// \param[in] _friction Joint Coulomb friction froce given index.
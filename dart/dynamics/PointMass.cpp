@@ -148,20 +148,6 @@ PointMass::PointMass(SoftBodyNode* _softBodyNode)
     mVelocityChanges(Eigen::Vector3d::Zero()),
     // mImpulse(Eigen::Vector3d::Zero()),
     mConstraintImpulses(Eigen::Vector3d::Zero()),
-    mW(Eigen::Vector3d::Zero()),
-    mX(Eigen::Vector3d::Zero()),
-    mV(Eigen::Vector3d::Zero()),
-    mEta(Eigen::Vector3d::Zero()),
-    mAlpha(Eigen::Vector3d::Zero()),
-    mBeta(Eigen::Vector3d::Zero()),
-    mA(Eigen::Vector3d::Zero()),
-    mF(Eigen::Vector3d::Zero()),
-    mPsi(0.0),
-    mImplicitPsi(0.0),
-    mPi(0.0),
-    mImplicitPi(0.0),
-    mB(Eigen::Vector3d::Zero()),
-    mFext(Eigen::Vector3d::Zero()),
     mIsColliding(false),
     mDelV(Eigen::Vector3d::Zero()),
     mImpB(Eigen::Vector3d::Zero()),
@@ -220,28 +206,28 @@ double PointMass::getMass() const
 double PointMass::getPsi() const
 {
   mParentSoftBodyNode->checkArticulatedInertiaUpdate();
-  return mPsi;
+  return mParentSoftBodyNode->mPointData.mPsi[mIndex];
 }
 
 //==============================================================================
 double PointMass::getImplicitPsi() const
 {
   mParentSoftBodyNode->checkArticulatedInertiaUpdate();
-  return mImplicitPsi;
+  return mParentSoftBodyNode->mPointData.mImplicitPsi[mIndex];
 }
 
 //==============================================================================
 double PointMass::getPi() const
 {
   mParentSoftBodyNode->checkArticulatedInertiaUpdate();
-  return mPi;
+  return mParentSoftBodyNode->mPointData.mPi[mIndex];
 }
 
 //==============================================================================
 double PointMass::getImplicitPi() const
 {
   mParentSoftBodyNode->checkArticulatedInertiaUpdate();
-  return mImplicitPi;
+  return mParentSoftBodyNode->mPointData.mImplicitPi[mIndex];
 }
 
 //==============================================================================
@@ -251,6 +237,7 @@ void PointMass::addConnectedPointMass(PointMass* _pointMass)
 
   mParentSoftBodyNode->mAspectProperties.mPointProps[mIndex].
       mConnectedPointMassIndices.push_back(_pointMass->mIndex);
+  mParentSoftBodyNode->mPointData.mNeedNeighborsUpdate = true;
   mParentSoftBodyNode->incrementVersion();
 }
 
@@ -420,7 +407,7 @@ const Vector3d& PointMass::getPartialAccelerations() const
 {
   if(mNotifier->needsPartialAccelerationUpdate())
     mParentSoftBodyNode->updatePartialAcceleration();
-  return mEta;
+  return mParentSoftBodyNode->mPointData.mEta[mIndex];
 }
 
 //==============================================================================
@@ -523,21 +510,23 @@ void PointMass::integrateVelocities(double _dt)
 //==============================================================================
 void PointMass::addExtForce(const Eigen::Vector3d& _force, bool _isForceLocal)
 {
+  Eigen::Vector3d& fext = mParentSoftBodyNode->mPointData.mFext[mIndex];
+
   if (_isForceLocal)
   {
-    mFext += _force;
+    fext += _force;
   }
   else
   {
-    mFext += mParentSoftBodyNode->getWorldTransform().linear().transpose()
-             * _force;
+    fext += mParentSoftBodyNode->getWorldTransform().linear().transpose()
+            * _force;
   }
 }
 
 //==============================================================================
 void PointMass::clearExtForce()
 {
-  mFext.setZero();
+  mParentSoftBodyNode->mPointData.mFext[mIndex].setZero();
 }
 
 //==============================================================================
@@ -615,7 +604,7 @@ const Eigen::Vector3d& PointMass::getLocalPosition() const
 {
   if(mNotifier->needsTransformUpdate())
     mParentSoftBodyNode->updateTransform();
-  return mX;
+  return mParentSoftBodyNode->mPointData.mX[mIndex];
 }
 
 //==============================================================================
@@ -623,7 +612,7 @@ const Eigen::Vector3d& PointMass::getWorldPosition() const
 {
   if(mNotifier && mNotifier->needsTransformUpdate())
     mParentSoftBodyNode->updateTransform();
-  return mW;
+  return mParentSoftBodyNode->mPointData.mW[mIndex];
 }
 
 //==============================================================================
@@ -691,7 +680,7 @@ const Eigen::Vector3d&PointMass::getBodyVelocity() const
 {
   if(mNotifier->needsVelocityUpdate())
     mParentSoftBodyNode->updateVelocity();
-  return mV;
+  return mParentSoftBodyNode->mPointData.mV[mIndex];
 }
 
 //==============================================================================
@@ -705,7 +694,7 @@ const Eigen::Vector3d& PointMass::getBodyAcceleration() const
 {
   if(mNotifier->needsAccelerationUpdate())
     mParentSoftBodyNode->updateAccelerationID();
-  return mA;
+  return mParentSoftBodyNode->mPointData.mA[mIndex];
 }
 
 //==============================================================================
@@ -720,167 +709,6 @@ void PointMass::init()
   mDependentGenCoordIndices = mParentSoftBodyNode->getDependentGenCoordIndices();
 }
 
-//==============================================================================
-void PointMass::updateTransform() const
-{
-  // Local translation
-  mX = getPositions() + getRestingPosition();
-  assert(!math::isNan(mX));
-
-  // World translation
-  const Eigen::Isometry3d& parentW = mParentSoftBodyNode->getWorldTransform();
-  mW = parentW.translation() + parentW.linear() * mX;
-  assert(!math::isNan(mW));
-}
-
-//==============================================================================
-void PointMass::updateVelocity() const
-{
-  // v = w(parent) x mX + v(parent) + dq
-  const Eigen::Vector6d& v_parent = mParentSoftBodyNode->getSpatialVelocity();
-  mV = v_parent.head<3>().cross(getLocalPosition()) + v_parent.tail<3>()
-       + getVelocities();
-  assert(!math::isNan(mV));
-}
-
-//==============================================================================
-void PointMass::updatePartialAcceleration() const
-{
-  // eta = w(parent) x dq
-  const Eigen::Vector3d& dq = getVelocities();
-  mEta = mParentSoftBodyNode->getSpatialVelocity().head<3>().cross(dq);
-  assert(!math::isNan(mEta));
-}
-
-//==============================================================================
-void PointMass::updateAccelerationID() const
-{
-  // dv = dw(parent) x mX + dv(parent) + eata + ddq
-  const Eigen::Vector6d& a_parent = mParentSoftBodyNode->getSpatialAcceleration();
-  mA = a_parent.head<3>().cross(getLocalPosition()) + a_parent.tail<3>()
-       + getPartialAccelerations() + getAccelerations();
-  assert(!math::isNan(mA));
-}
-
-//==============================================================================
-void PointMass::updateTransmittedForceID(const Eigen::Vector3d& _gravity,
-                                         bool /*_withExternalForces*/)
-{
-  // f = m*dv + w(parent) x m*v - fext
-  mF.noalias() = getMass() * getBodyAcceleration();
-  mF += mParentSoftBodyNode->getSpatialVelocity().head<3>().cross(
-        getMass() * getBodyVelocity()) - mFext;
-  if (mParentSoftBodyNode->getGravityMode() == true)
-  {
-    mF -= getMass() * (mParentSoftBodyNode->getWorldTransform().linear().transpose()
-                   * _gravity);
-  }
-  assert(!math::isNan(mF));
-}
-
-//==============================================================================
-void PointMass::updateArtInertiaFD(double _timeStep) const
-{
-  // Articulated inertia
-  // - Do nothing
-
-  // Cache data: PsiK and Psi
-  mPsi = 1.0 / getMass();
-  mImplicitPsi
-      = 1.0 / (getMass()
-               + _timeStep * mParentSoftBodyNode->getDampingCoefficient()
-               + _timeStep * _timeStep
-                 * mParentSoftBodyNode->getVertexSpringStiffness());
-  assert(!math::isNan(mImplicitPsi));
-
-  // Cache data: AI_S_Psi
-  // - Do nothing
-
-  // Cache data: Pi
-  mPi         = getMass() - getMass() * getMass() * mPsi;
-  mImplicitPi = getMass() - getMass() * getMass() * mImplicitPsi;
-  assert(!math::isNan(mPi));
-  assert(!math::isNan(mImplicitPi));
-}
-
-//==============================================================================
-void PointMass::updateJointForceID(double /*_timeStep*/,
-                                   double /*_withDampingForces*/,
-                                   double /*_withSpringForces*/)
-{
-  // tau = f
-  getState().mForces = mF;
-  // TODO: need to add spring and damping forces
-}
-
-//==============================================================================
-void PointMass::updateBiasForceFD(double _dt, const Eigen::Vector3d& _gravity)
-{
-  // B = w(parent) x m*v - fext - fgravity
-  // - w(parent) x m*v - fext
-  mB = mParentSoftBodyNode->getSpatialVelocity().head<3>().cross(
-        getMass() * getBodyVelocity()) - mFext;
-  // - fgravity
-  if (mParentSoftBodyNode->getGravityMode() == true)
-  {
-    mB -= getMass()
-          * (mParentSoftBodyNode->getWorldTransform().linear().transpose()
-             * _gravity);
-  }
-  assert(!math::isNan(mB));
-
-  const State& state = getState();
-
-  // Cache data: alpha
-  double kv = mParentSoftBodyNode->getVertexSpringStiffness();
-  double ke = mParentSoftBodyNode->getEdgeSpringStiffness();
-  double kd = mParentSoftBodyNode->getDampingCoefficient();
-  int nN = getNumConnectedPointMasses();
-  mAlpha = state.mForces
-           - (kv + nN * ke) * getPositions()
-           - (_dt * (kv + nN * ke) + kd) * getVelocities()
-           - getMass() * getPartialAccelerations()
-           - mB;
-  for (std::size_t i = 0; i < getNumConnectedPointMasses(); ++i)
-  {
-    const State& i_state = getConnectedPointMass(i)->getState();
-    mAlpha += ke * (i_state.mPositions + _dt * i_state.mVelocities);
-  }
-  assert(!math::isNan(mAlpha));
-
-  // Cache data: beta
-  mBeta = mB;
-  mBeta.noalias() += getMass() * (getPartialAccelerations() + getImplicitPsi() * mAlpha);
-  assert(!math::isNan(mBeta));
-}
-
-//==============================================================================
-void PointMass::updateAccelerationFD()
-{
-  // ddq = imp_psi*(alpha - m*(dw(parent) x mX + dv(parent))
-  const Eigen::Vector3d& X = getLocalPosition();
-  const Eigen::Vector6d& a_parent = mParentSoftBodyNode->getSpatialAcceleration();
-  Eigen::Vector3d ddq =
-      getImplicitPsi()
-      * (mAlpha - getMass() * (a_parent.head<3>().cross(X) + a_parent.tail<3>()));
-  setAccelerations(ddq);
-  assert(!math::isNan(ddq));
-
-  // dv = dw(parent) x mX + dv(parent) + eata + ddq
-  mA = a_parent.head<3>().cross(X) + a_parent.tail<3>()
-       + getPartialAccelerations() + getAccelerations();
-  assert(!math::isNan(mA));
-}
-
-//==============================================================================
-void PointMass::updateTransmittedForce()
-{
-  // f = m*dv + B
-  mF = mB;
-  mF.noalias() += getMass() * getBodyAcceleration();
-  assert(!math::isNan(mF));
-}
-
 //==============================================================================
 void PointMass::updateMassMatrix()
 {
@@ -957,7 +785,7 @@ void PointMass::updateConstrainedTermsFD(double _timeStep)
   setAccelerations( getAccelerations() + mDelV / _timeStep );
 
   ///
-  mF += _timeStep * mImpF;
+  mParentSoftBodyNode->mPointData.mF[mIndex] += _timeStep * mImpF;
 }
 
 //==============================================================================
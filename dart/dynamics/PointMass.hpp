@@ -420,54 +420,17 @@ protected:
   /// \{ \name Recursive dynamics routines
   //----------------------------------------------------------------------------
 
-  /// \brief Update transformation.
-  void updateTransform() const;
-
-  /// \brief Update body velocity.
-  void updateVelocity() const;
-
-  /// \brief Update partial body acceleration due to parent joint's velocity.
-  void updatePartialAcceleration() const;
-
-  /// \brief Update articulated body inertia. Forward dynamics routine.
-  /// \param[in] _timeStep Rquired for implicit joint stiffness and damping.
-  void updateArtInertiaFD(double _timeStep) const;
-
-  /// \brief Update bias force associated with the articulated body inertia.
-  /// Forward dynamics routine.
-  /// \param[in] _gravity Vector of gravitational acceleration
-  /// \param[in] _timeStep Rquired for implicit joint stiffness and damping.
-  void updateBiasForceFD(double _dt, const Eigen::Vector3d& _gravity);
-
   /// \brief Update bias impulse associated with the articulated body inertia.
   /// Impulse-based forward dynamics routine.
   void updateBiasImpulseFD();
 
-  /// \brief Update body acceleration with the partial body acceleration.
-  void updateAccelerationID() const;
-
-  /// \brief Update body acceleration. Forward dynamics routine.
-  void updateAccelerationFD();
-
   /// \brief Update body velocity change. Impluse-based forward dynamics
   /// routine.
   void updateVelocityChangeFD();
 
-  /// \brief Update body force. Inverse dynamics routine.
-  void updateTransmittedForceID(const Eigen::Vector3d& _gravity,
-                                bool _withExternalForces = false);
-
-  /// \brief Update body force. Forward dynamics routine.
-  void updateTransmittedForce();
-
   /// \brief Update body force. Impulse-based forward dynamics routine.
   void updateTransmittedImpulse();
 
-  /// \brief Update the joint force. Inverse dynamics routine.
-  void updateJointForceID(double _timeStep,
-                          double _withDampingForces,
-                          double _withSpringForces);
-
   /// \brief Update constrained terms due to the constraint impulses. Foward
   /// dynamics routine.
   void updateConstrainedTermsFD(double _timeStep);
@@ -595,47 +558,9 @@ protected:
 
   //----------------------------------------------------------------------------
 
-  /// Current position viewed in world frame.
-  mutable Eigen::Vector3d mW;
-
-  /// Current position viewed in parent soft body node frame.
-  mutable Eigen::Vector3d mX;
-
-  /// Current velocity viewed in parent soft body node frame.
-  mutable Eigen::Vector3d mV;
-
-  /// Partial Acceleration of this PointMass
-  mutable Eigen::Vector3d mEta;
-
-  ///
-  Eigen::Vector3d mAlpha;
-
-  ///
-  Eigen::Vector3d mBeta;
-
-  /// Current acceleration viewed in parent body node frame.
-  mutable Eigen::Vector3d mA;
-
-  ///
-  Eigen::Vector3d mF;
-
-  ///
-  mutable double mPsi;
-
-  ///
-  mutable double mImplicitPsi;
-
-  ///
-  mutable double mPi;
-
-  ///
-  mutable double mImplicitPi;
-
-  /// Bias force
-  Eigen::Vector3d mB;
-
-  /// External force.
-  Eigen::Vector3d mFext;
+  // The position, velocity, acceleration and force caches of the recursive
+  // dynamics routines, as well as the external force, are stored contiguously
+  // in the parent SoftBodyNode; see SoftBodyNode::PointMassData.
 
   /// A increasingly sorted list of dependent dof indices.
   std::vector<std::size_t> mDependentGenCoordIndices;
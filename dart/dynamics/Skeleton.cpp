@@ -418,6 +418,10 @@ SkeletonPtr Skeleton::cloneSkeleton(const std::string& cloneName) const
 {
   SkeletonPtr skelClone = Skeleton::create(cloneName);
 
+  // The clone has the same structure as this Skeleton, so the total mass and
+  // the cache dimensions only need to be computed once at the end
+  skelClone->beginBulkConstruction();
+
   for(std::size_t i=0; i<getNumBodyNodes(); ++i)
   {
     // Create a clone of the parent Joint
@@ -426,10 +430,11 @@ SkeletonPtr Skeleton::cloneSkeleton(const std::string& cloneName) const
     // Identify the original parent BodyNode
     const BodyNode* originalParent = getBodyNode(i)->getParentBodyNode();
 
-    // Grab the parent BodyNode clone (using its name, which is guaranteed to be
-    // unique), or use nullptr if this is a root BodyNode
+    // Grab the parent BodyNode clone, which has the same index as the original
+    // parent because the BodyNodes are cloned in order, or use nullptr if this
+    // is a root BodyNode
     BodyNode* parentClone = (originalParent == nullptr)? nullptr :
-          skelClone->getBodyNode(originalParent->getName());
+          skelClone->getBodyNode(originalParent->getIndexInSkeleton());
 
     if( (nullptr != originalParent) && (nullptr == parentClone) )
     {
@@ -460,11 +465,14 @@ SkeletonPtr Skeleton::cloneSkeleton(const std::string& cloneName) const
     for(const auto& node : nodeType.second)
     {
       const BodyNode* originalBn = node->getBodyNodePtr();
-      BodyNode* newBn = skelClone->getBodyNode(originalBn->getName());
+      BodyNode* newBn
+          = skelClone->getBodyNode(originalBn->getIndexInSkeleton());
       node->cloneNode(newBn)->attach();
     }
   }
 
+  skelClone->endBulkConstruction();
+
   skelClone->setProperties(getAspectProperties());
   skelClone->setName(cloneName);
   skelClone->setState(getState());
@@ -759,6 +767,31 @@ bool Skeleton::isMobile() const
   return mAspectProperties.mIsMobile;
 }
 
+//==============================================================================
+void Skeleton::putToSleep()
+{
+  if (mIsSleeping)
+    return;
+
+  const std::size_t numDofs = getNumDofs();
+  setVelocities(Eigen::VectorXd::Zero(numDofs));
+  setAccelerations(Eigen::VectorXd::Zero(numDofs));
+
+  mIsSleeping = true;
+}
+
+//==============================================================================
+void Skeleton::wakeUp()
+{
+  mIsSleeping = false;
+}
+
+//==============================================================================
+bool Skeleton::isSleeping() const
+{
+  return mIsSleeping;
+}
+
 //==============================================================================
 void Skeleton::setTimeStep(double _timeStep)
 {
@@ -790,6 +823,42 @@ const Eigen::Vector3d& Skeleton::getGravity() const
   return mAspectProperties.mGravity;
 }
 
+//==============================================================================
+void Skeleton::beginBulkConstruction()
+{
+  ++mBulkConstructionDepth;
+}
+
+//==============================================================================
+void Skeleton::endBulkConstruction()
+{
+  if (0u == mBulkConstructionDepth)
+  {
+    dtwarn << "[Skeleton::endBulkConstruction] Attempting to end the bulk "
+           << "construction of Skeleton [" << getName() << "], which was not "
+           << "begun.\n";
+    return;
+  }
+
+  if (--mBulkConstructionDepth > 0u)
+    return;
+
+  updateTotalMass();
+
+  for (std::size_t i = 0u; i < mTreeCache.size(); ++i)
+  {
+    updateCacheDimensions(mTreeCache[i]);
+    dirtyArticulatedInertia(i);
+  }
+  updateCacheDimensions(mSkelCache);
+}
+
+//==============================================================================
+bool Skeleton::isInBulkConstruction() const
+{
+  return mBulkConstructionDepth > 0u;
+}
+
 //==============================================================================
 std::size_t Skeleton::getNumBodyNodes() const
 {
@@ -1495,10 +1564,7 @@ void Skeleton::integratePositions(double _dt)
     mSkelCache.mBodyNodes[i]->getParentJoint()->integratePositions(_dt);
 
   for (std::size_t i = 0; i < mSoftBodyNodes.size(); ++i)
-  {
-    for (std::size_t j = 0; j < mSoftBodyNodes[i]->getNumPointMasses(); ++j)
-      mSoftBodyNodes[i]->getPointMass(j)->integratePositions(_dt);
-  }
+    mSoftBodyNodes[i]->integratePointMassPositions(_dt);
 }
 
 //==============================================================================
@@ -1508,10 +1574,7 @@ void Skeleton::integrateVelocities(double _dt)
     mSkelCache.mBodyNodes[i]->getParentJoint()->integrateVelocities(_dt);
 
   for (std::size_t i = 0; i < mSoftBodyNodes.size(); ++i)
-  {
-    for (std::size_t j = 0; j < mSoftBodyNodes[i]->getNumPointMasses(); ++j)
-      mSoftBodyNodes[i]->getPointMass(j)->integrateVelocities(_dt);
-  }
+    mSoftBodyNodes[i]->integratePointMassVelocities(_dt);
 }
 
 //==============================================================================
@@ -2074,6 +2137,8 @@ const Eigen::VectorXd& Skeleton::getConstraintForces() const
 Skeleton::Skeleton(const AspectPropertiesData& properties)
   : mTotalMass(0.0),
     mIsImpulseApplied(false),
+    mIsSleeping(false),
+    mBulkConstructionDepth(0u),
     mUnionSize(1)
 {
   createAspect<Aspect>(properties);
@@ -2686,6 +2751,9 @@ void Skeleton::receiveBodyNodeTree(const std::vector<BodyNode*>& _tree)
 //==============================================================================
 void Skeleton::updateTotalMass()
 {
+  if (mBulkConstructionDepth > 0u)
+    return;
+
   mTotalMass = 0.0;
   for(std::size_t i=0; i<getNumBodyNodes(); ++i)
     mTotalMass += getBodyNode(i)->getMass();
@@ -2694,6 +2762,9 @@ void Skeleton::updateTotalMass()
 //==============================================================================
 void Skeleton::updateCacheDimensions(Skeleton::DataCache& _cache)
 {
+  if (mBulkConstructionDepth > 0u)
+    return;
+
   std::size_t dof = _cache.mDofs.size();
   _cache.mM        = Eigen::MatrixXd::Zero(dof, dof);
   _cache.mAugM     = Eigen::MatrixXd::Zero(dof, dof);
@@ -2709,6 +2780,9 @@ void Skeleton::updateCacheDimensions(Skeleton::DataCache& _cache)
 //==============================================================================
 void Skeleton::updateCacheDimensions(std::size_t _treeIdx)
 {
+  if (mBulkConstructionDepth > 0u)
+    return;
+
   updateCacheDimensions(mTreeCache[_treeIdx]);
   updateCacheDimensions(mSkelCache);
 
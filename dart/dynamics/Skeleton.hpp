@@ -303,6 +303,24 @@ public:
   /// \return True if this skeleton is mobile.
   bool isMobile() const;
 
+  /// Put this skeleton to sleep. A sleeping skeleton is at rest, so its
+  /// generalized velocities and accelerations are set to zero, and it is
+  /// skipped by the forward dynamics, the integration, and the constraint
+  /// solving of simulation::World until it gets woken up.
+  ///
+  /// This is usually done by simulation::World when sleeping is enabled.
+  void putToSleep();
+
+  /// Wake up this skeleton so that it gets simulated again.
+  ///
+  /// simulation::World wakes up sleeping skeletons when they are disturbed by
+  /// external forces, commands, or state changes, and ConstraintSolver wakes
+  /// up sleeping skeletons that are constrained with awake skeletons.
+  void wakeUp();
+
+  /// Return true if this skeleton is sleeping.
+  bool isSleeping() const;
+
   /// Set time step. This timestep is used for implicit joint damping
   /// force.
   void setTimeStep(double _timeStep);
@@ -358,6 +376,23 @@ public:
   // TODO: Workaround for MSVC bug on template function specialization with
   // default argument. Please see #487 for detail
 
+  /// Begin adding many BodyNodes at once. Until the matching call to
+  /// endBulkConstruction(), adding or removing BodyNodes or changing their
+  /// masses does not update the total mass or resize the dynamics caches,
+  /// which otherwise happens once per BodyNode and makes building a Skeleton
+  /// quadratic in its number of BodyNodes. The mass and dynamics quantities of
+  /// this Skeleton must not be queried before the construction ends. Calls
+  /// may be nested; only the outermost endBulkConstruction() finalizes.
+  void beginBulkConstruction();
+
+  /// End adding many BodyNodes at once, and update the total mass and the
+  /// dimensions of the dynamics caches of every tree.
+  void endBulkConstruction();
+
+  /// Returns true if this Skeleton is between beginBulkConstruction() and
+  /// endBulkConstruction().
+  bool isInBulkConstruction() const;
+
   // Documentation inherited
   std::size_t getNumBodyNodes() const override;
 
@@ -1304,6 +1339,12 @@ protected:
   /// Flag for status of impulse testing.
   bool mIsImpulseApplied;
 
+  /// Whether this skeleton is sleeping
+  bool mIsSleeping;
+
+  /// Nesting depth of beginBulkConstruction() calls
+  std::size_t mBulkConstructionDepth;
+
   mutable std::mutex mMutex;
 
 public:
@@ -0,0 +1,945 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/dynamics/SkeletonBatch.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "dart/common/Console.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/Joint.hpp"
+#include "dart/dynamics/PrismaticJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/ScrewJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/TranslationalJoint.hpp"
+
+namespace dart {
+namespace dynamics {
+
+namespace {
+
+/// One scalar quantity for every instance of a pack. Eigen evaluates the
+/// arithmetic on these with its packet math, i.e., with SSE2/NEON by default
+/// and with AVX/AVX-512 when DART_ENABLE_SIMD is on.
+using Lanes = Eigen::Array<double, SkeletonBatch::NumLanes, 1>;
+
+using LanesVector = std::vector<Lanes, Eigen::aligned_allocator<Lanes>>;
+
+//==============================================================================
+// Layout of the lane storage. Every entry is a Lanes. The gravity of the
+// instances comes first and is followed by the data of each BodyNode:
+//
+//   T     : 12     relative transform of the parent Joint; the rotation in
+//                  column-major order followed by the translation
+//   V     : 6      spatial velocity
+//   eta   : 6      partial acceleration
+//   g     : 3      gravity in the body frame
+//   I     : 36     spatial inertia (column-major)
+//   AI    : 36     implicit articulated inertia (column-major)
+//   B     : 6      bias force
+//   A     : 6      spatial acceleration
+//   Fext  : 6      external force
+//   mode  : 1      gravity mode (0 or 1)
+//   S     : 6n     relative Jacobian of the parent Joint (column-major)
+//   dS    : 6n     time derivative of the relative Jacobian
+//   AIS   : 6n     AI * S
+//   Y     : 6n     P^-1 * (AI * S)^T (n x 6, column-major)
+//   dq    : n      joint velocities
+//   f     : n      joint forces without the transmitted body force
+//   d     : n      implicit damping, spring, and servo terms
+//   u     : n      total joint forces
+//   ddq   : n      joint accelerations
+//   P     : n*n    LDL^T factor of S^T * AI * S + diag(d)
+//==============================================================================
+
+constexpr std::size_t GravityOffset = 0u;
+constexpr std::size_t BodiesOffset = 3u;
+
+constexpr std::size_t TOffset = 0u;
+constexpr std::size_t VOffset = 12u;
+constexpr std::size_t EtaOffset = 18u;
+constexpr std::size_t GOffset = 24u;
+constexpr std::size_t IOffset = 27u;
+constexpr std::size_t AIOffset = 63u;
+constexpr std::size_t BOffset = 99u;
+constexpr std::size_t AOffset = 105u;
+constexpr std::size_t FextOffset = 111u;
+constexpr std::size_t ModeOffset = 117u;
+constexpr std::size_t DofOffset = 118u;
+
+//==============================================================================
+std::size_t getBodySize(std::size_t n)
+{
+  return DofOffset + 24u * n + 5u * n + n * n;
+}
+
+//==============================================================================
+/// Pointers into the lane storage of one BodyNode
+struct BodyLanes
+{
+  BodyLanes(Lanes* data, std::size_t n)
+    : T(data + TOffset),
+      V(data + VOffset),
+      eta(data + EtaOffset),
+      g(data + GOffset),
+      I(data + IOffset),
+      AI(data + AIOffset),
+      B(data + BOffset),
+      A(data + AOffset),
+      Fext(data + FextOffset),
+      mode(data + ModeOffset),
+      S(data + DofOffset),
+      dS(S + 6u * n),
+      AIS(dS + 6u * n),
+      Y(AIS + 6u * n),
+      dq(Y + 6u * n),
+      f(dq + n),
+      d(f + n),
+      u(d + n),
+      ddq(u + n),
+      P(ddq + n),
+      n(n)
+  {
+    // Do nothing
+  }
+
+  Lanes* T;
+  Lanes* V;
+  Lanes* eta;
+  Lanes* g;
+  Lanes* I;
+  Lanes* AI;
+  Lanes* B;
+  Lanes* A;
+  Lanes* Fext;
+  Lanes* mode;
+  Lanes* S;
+  Lanes* dS;
+  Lanes* AIS;
+  Lanes* Y;
+  Lanes* dq;
+  Lanes* f;
+  Lanes* d;
+  Lanes* u;
+  Lanes* ddq;
+  Lanes* P;
+  std::size_t n;
+};
+
+//==============================================================================
+/// res = a x b
+void cross(const Lanes* a, const Lanes* b, Lanes* res)
+{
+  res[0] = a[1] * b[2] - a[2] * b[1];
+  res[1] = a[2] * b[0] - a[0] * b[2];
+  res[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+//==============================================================================
+/// res = R * x
+void rotate(const Lanes* T, const Lanes* x, Lanes* res)
+{
+  for (std::size_t r = 0u; r < 3u; ++r)
+    res[r] = T[r] * x[0] + T[r + 3u] * x[1] + T[r + 6u] * x[2];
+}
+
+//==============================================================================
+/// res = R^T * x
+void rotateInv(const Lanes* T, const Lanes* x, Lanes* res)
+{
+  for (std::size_t r = 0u; r < 3u; ++r)
+    res[r] = T[3u * r] * x[0] + T[3u * r + 1u] * x[1] + T[3u * r + 2u] * x[2];
+}
+
+//==============================================================================
+/// res = math::AdInvT(T, V)
+void adInvT(const Lanes* T, const Lanes* V, Lanes* res)
+{
+  Lanes tmp[3];
+  cross(V, T + 9u, tmp);
+  for (std::size_t i = 0u; i < 3u; ++i)
+    tmp[i] += V[i + 3u];
+
+  rotateInv(T, V, res);
+  rotateInv(T, tmp, res + 3u);
+}
+
+//==============================================================================
+/// res += math::dAdInvT(T, F)
+void addDAdInvT(const Lanes* T, const Lanes* F, Lanes* res)
+{
+  Lanes f[3];
+  rotate(T, F + 3u, f);
+
+  Lanes m[3];
+  rotate(T, F, m);
+
+  Lanes pf[3];
+  cross(T + 9u, f, pf);
+
+  for (std::size_t i = 0u; i < 3u; ++i)
+  {
+    res[i] += m[i] + pf[i];
+    res[i + 3u] += f[i];
+  }
+}
+
+//==============================================================================
+/// res = math::ad(V, W)
+void ad(const Lanes* V, const Lanes* W, Lanes* res)
+{
+  Lanes tmp[3];
+  cross(V, W, res);
+  cross(V, W + 3u, res + 3u);
+  cross(V + 3u, W, tmp);
+  for (std::size_t i = 0u; i < 3u; ++i)
+    res[i + 3u] += tmp[i];
+}
+
+//==============================================================================
+/// res = math::dad(V, F)
+void dad(const Lanes* V, const Lanes* F, Lanes* res)
+{
+  Lanes tmp[3];
+  cross(F, V, res);
+  cross(F + 3u, V + 3u, tmp);
+  for (std::size_t i = 0u; i < 3u; ++i)
+    res[i] += tmp[i];
+  cross(F + 3u, V, res + 3u);
+}
+
+//==============================================================================
+/// res = M * x for a 6x6 matrix M
+void multiply6(const Lanes* M, const Lanes* x, Lanes* res)
+{
+  for (std::size_t r = 0u; r < 6u; ++r)
+  {
+    res[r] = M[r] * x[0];
+    for (std::size_t c = 1u; c < 6u; ++c)
+      res[r] += M[r + 6u * c] * x[c];
+  }
+}
+
+//==============================================================================
+/// res = J * x for a 6xn matrix J
+void multiplyJacobian(const Lanes* J, const Lanes* x, std::size_t n, Lanes* res)
+{
+  for (std::size_t r = 0u; r < 6u; ++r)
+  {
+    res[r] = Lanes::Zero();
+    for (std::size_t j = 0u; j < n; ++j)
+      res[r] += J[r + 6u * j] * x[j];
+  }
+}
+
+//==============================================================================
+/// res = J^T * x for a 6xn matrix J
+void multiplyJacobianTranspose(
+    const Lanes* J, const Lanes* x, std::size_t n, Lanes* res)
+{
+  for (std::size_t j = 0u; j < n; ++j)
+  {
+    res[j] = J[6u * j] * x[0];
+    for (std::size_t r = 1u; r < 6u; ++r)
+      res[j] += J[r + 6u * j] * x[r];
+  }
+}
+
+//==============================================================================
+/// Factorizes the symmetric positive definite nxn matrix P in place into
+/// L * D * L^T. The strictly lower part of P holds L and its diagonal holds
+/// the inverse of D.
+void factorize(Lanes* P, std::size_t n)
+{
+  for (std::size_t j = 0u; j < n; ++j)
+  {
+    Lanes dj = P[j + n * j];
+    for (std::size_t k = 0u; k < j; ++k)
+      dj -= P[j + n * k] * P[j + n * k] / P[k + n * k];
+
+    const Lanes invDj = dj.inverse();
+    P[j + n * j] = invDj;
+
+    for (std::size_t i = j + 1u; i < n; ++i)
+    {
+      Lanes lij = P[i + n * j];
+      for (std::size_t k = 0u; k < j; ++k)
+        lij -= P[i + n * k] * P[j + n * k] / P[k + n * k];
+      P[i + n * j] = lij * invDj;
+    }
+  }
+}
+
+//==============================================================================
+/// Solves P * x = b in place using the factor computed by factorize()
+void solve(const Lanes* P, std::size_t n, Lanes* b)
+{
+  for (std::size_t i = 0u; i < n; ++i)
+    for (std::size_t k = 0u; k < i; ++k)
+      b[i] -= P[i + n * k] * b[k];
+
+  for (std::size_t i = 0u; i < n; ++i)
+    b[i] *= P[i + n * i];
+
+  for (std::size_t i = n; i-- > 0u;)
+    for (std::size_t k = i + 1u; k < n; ++k)
+      b[i] -= P[k + n * i] * b[k];
+}
+
+//==============================================================================
+/// res = R * X * R^T for the 3x3 block of the 6x6 matrix M that starts at
+/// index offset. res is column-major.
+void rotateBlock(const Lanes* T, const Lanes* M, std::size_t offset, Lanes* res)
+{
+  // tmp = R * X
+  Lanes tmp[9];
+  for (std::size_t c = 0u; c < 3u; ++c)
+  {
+    const Lanes* x = M + offset + 6u * c;
+    rotate(T, x, tmp + 3u * c);
+  }
+
+  // res = tmp * R^T, i.e., column c of res is tmp * (row c of R)
+  for (std::size_t c = 0u; c < 3u; ++c)
+    for (std::size_t r = 0u; r < 3u; ++r)
+      res[r + 3u * c] = tmp[r] * T[c] + tmp[r + 3u] * T[c + 3u]
+                        + tmp[r + 6u] * T[c + 6u];
+}
+
+//==============================================================================
+/// res += math::transformInertia(T.inverse(), X)
+void addTransformedInertia(const Lanes* T, const Lanes* X, Lanes* res)
+{
+  //--------------------------------------------------------------------------
+  // With X = | A   B |, the blocks are rotated into the parent frame, e.g.,
+  //          | B^T C |
+  // A' = R A R^T, and then shifted by q = -p:
+  //
+  // | A' + B1 [q] - [q] B'^T   B1 |,  where B1 = B' - [q] C'.
+  // | B1^T                     C' |
+  //--------------------------------------------------------------------------
+  Lanes A[9];
+  Lanes B[9];
+  Lanes C[9];
+  rotateBlock(T, X, 0u, A);
+  rotateBlock(T, X, 18u, B);
+  rotateBlock(T, X, 21u, C);
+
+  const Lanes q[3] = {-T[9], -T[10], -T[11]};
+
+  // B1 = B' - [q] C'
+  Lanes B1[9];
+  for (std::size_t c = 0u; c < 3u; ++c)
+  {
+    Lanes qc[3];
+    cross(q, C + 3u * c, qc);
+    for (std::size_t r = 0u; r < 3u; ++r)
+      B1[r + 3u * c] = B[r + 3u * c] - qc[r];
+  }
+
+  // [q] B'^T, whose column c is q x (row c of B')
+  Lanes qBt[9];
+  for (std::size_t c = 0u; c < 3u; ++c)
+  {
+    const Lanes row[3] = {B[c], B[c + 3u], B[c + 6u]};
+    cross(q, row, qBt + 3u * c);
+  }
+
+  // B1 [q]
+  Lanes B1q[9];
+  for (std::size_t r = 0u; r < 3u; ++r)
+  {
+    B1q[r] = q[2] * B1[r + 3u] - q[1] * B1[r + 6u];
+    B1q[r + 3u] = q[0] * B1[r + 6u] - q[2] * B1[r];
+    B1q[r + 6u] = q[1] * B1[r] - q[0] * B1[r + 3u];
+  }
+
+  for (std::size_t c = 0u; c < 3u; ++c)
+  {
+    for (std::size_t r = 0u; r < 3u; ++r)
+    {
+      const std::size_t i = r + 3u * c;
+      res[r + 6u * c] += A[i] + B1q[i] - qBt[i];
+      res[r + 6u * (c + 3u)] += B1[i];
+      res[c + 3u + 6u * r] += B1[i];
+      res[r + 3u + 6u * (c + 3u)] += C[i];
+    }
+  }
+}
+
+} // namespace
+
+//==============================================================================
+constexpr std::size_t SkeletonBatch::NumLanes;
+
+//==============================================================================
+struct SkeletonBatch::Pack
+{
+  /// Lane storage
+  LanesVector mData;
+
+  /// Index of the first instance of this pack
+  std::size_t mFirstIndex;
+
+  /// Number of lanes that hold an instance. The remaining lanes repeat the
+  /// last instance and are not written back.
+  std::size_t mNumValidLanes;
+
+  /// Joint spring stiffnesses, with one row per DOF and one column per lane
+  Eigen::MatrixXd mSpringStiffnesses;
+
+  /// Joint rest positions, laid out like mSpringStiffnesses
+  Eigen::MatrixXd mRestPositions;
+
+  /// Joint damping coefficients, laid out like mSpringStiffnesses
+  Eigen::MatrixXd mDampingCoefficients;
+
+  /// Joint position servo gains, laid out like mSpringStiffnesses
+  Eigen::MatrixXd mPositionServoGains;
+
+  /// Joint velocity servo gains, laid out like mSpringStiffnesses
+  Eigen::MatrixXd mVelocityServoGains;
+};
+
+//==============================================================================
+SkeletonBatch::SkeletonBatch()
+{
+  // Do nothing
+}
+
+//==============================================================================
+SkeletonBatch::SkeletonBatch(const std::vector<SkeletonPtr>& skeletons)
+{
+  setSkeletons(skeletons);
+}
+
+//==============================================================================
+SkeletonBatch::~SkeletonBatch()
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool SkeletonBatch::setSkeletons(const std::vector<SkeletonPtr>& skeletons)
+{
+  mSkeletons.clear();
+  mBodyLayouts.clear();
+  mPacks.clear();
+
+  if (skeletons.empty())
+    return true;
+
+  const SkeletonPtr& reference = skeletons.front();
+  if (!reference)
+  {
+    dterr << "[SkeletonBatch::setSkeletons] Attempting to add a nullptr "
+          << "Skeleton.\n";
+    return false;
+  }
+
+  // Capture and validate the topology of the reference Skeleton
+  std::vector<BodyLayout> layouts;
+  layouts.reserve(reference->getNumBodyNodes());
+  std::size_t offset = BodiesOffset;
+  for (std::size_t i = 0u; i < reference->getNumBodyNodes(); ++i)
+  {
+    const BodyNode* bodyNode = reference->getBodyNode(i);
+    const Joint* joint = bodyNode->getParentJoint();
+
+    if (bodyNode->asSoftBodyNode())
+    {
+      dterr << "[SkeletonBatch::setSkeletons] BodyNode [" << bodyNode->getName()
+            << "] of Skeleton [" << reference->getName()
+            << "] is a SoftBodyNode, which is not supported.\n";
+      return false;
+    }
+
+    const Joint::ActuatorType type = joint->getActuatorType();
+    if (type != Joint::FORCE && type != Joint::PASSIVE && type != Joint::SERVO
+        && type != Joint::MIMIC)
+    {
+      dterr << "[SkeletonBatch::setSkeletons] Joint [" << joint->getName()
+            << "] of Skeleton [" << reference->getName()
+            << "] has an ACCELERATION, VELOCITY, or LOCKED actuator, which is "
+            << "not supported.\n";
+      return false;
+    }
+
+    const BodyNode* parent = bodyNode->getParentBodyNode();
+
+    const std::string& jointType = joint->getType();
+
+    BodyLayout layout;
+    layout.mParentIndex
+        = parent ? static_cast<int>(parent->getIndexInSkeleton()) : -1;
+    layout.mNumDofs = joint->getNumDofs();
+    layout.mFirstDofIndex
+        = layout.mNumDofs > 0u ? joint->getIndexInSkeleton(0u) : 0u;
+    layout.mIsForce = type == Joint::FORCE;
+    layout.mHasConstantJacobian
+        = jointType == RevoluteJoint::getStaticType()
+          || jointType == PrismaticJoint::getStaticType()
+          || jointType == ScrewJoint::getStaticType()
+          || jointType == TranslationalJoint::getStaticType();
+    layout.mOffset = offset;
+    assert(layout.mParentIndex < static_cast<int>(i));
+
+    offset += getBodySize(layout.mNumDofs);
+    layouts.push_back(layout);
+  }
+
+  // Every other Skeleton must have the same topology
+  for (const SkeletonPtr& skel : skeletons)
+  {
+    bool identical = skel && skel->getNumBodyNodes() == layouts.size();
+
+    for (std::size_t i = 0u; identical && i < layouts.size(); ++i)
+    {
+      const BodyNode* bodyNode = skel->getBodyNode(i);
+      const BodyNode* parent = bodyNode->getParentBodyNode();
+      const Joint* joint = bodyNode->getParentJoint();
+      const Joint* referenceJoint = reference->getJoint(i);
+
+      identical = !bodyNode->asSoftBodyNode()
+                  && (parent ? static_cast<int>(parent->getIndexInSkeleton())
+                             : -1) == layouts[i].mParentIndex
+                  && joint->getType() == referenceJoint->getType()
+                  && joint->getNumDofs() == layouts[i].mNumDofs
+                  && joint->getActuatorType() == referenceJoint->getActuatorType();
+    }
+
+    if (!identical)
+    {
+      dterr << "[SkeletonBatch::setSkeletons] Skeleton ["
+            << (skel ? skel->getName() : std::string("nullptr"))
+            << "] is not topologically identical to Skeleton ["
+            << reference->getName() << "].\n";
+      return false;
+    }
+  }
+
+  mSkeletons = skeletons;
+  mBodyLayouts = std::move(layouts);
+
+  const std::size_t numDofs = reference->getNumDofs();
+  const std::size_t numPacks = (mSkeletons.size() + NumLanes - 1u) / NumLanes;
+  mPacks.reserve(numPacks);
+  for (std::size_t k = 0u; k < numPacks; ++k)
+  {
+    std::unique_ptr<Pack> pack(new Pack);
+    pack->mData.resize(offset, Lanes::Zero());
+    pack->mFirstIndex = k * NumLanes;
+    pack->mNumValidLanes
+        = std::min(NumLanes, mSkeletons.size() - pack->mFirstIndex);
+    pack->mSpringStiffnesses.resize(numDofs, NumLanes);
+    pack->mRestPositions.resize(numDofs, NumLanes);
+    pack->mDampingCoefficients.resize(numDofs, NumLanes);
+    pack->mPositionServoGains.resize(numDofs, NumLanes);
+    pack->mVelocityServoGains.resize(numDofs, NumLanes);
+    mPacks.push_back(std::move(pack));
+  }
+
+  mAccelerations.resize(numDofs);
+
+  updateProperties();
+
+  return true;
+}
+
+//==============================================================================
+void SkeletonBatch::updateProperties()
+{
+  for (std::size_t k = 0u; k < mPacks.size(); ++k)
+    gatherProperties(k);
+}
+
+//==============================================================================
+const std::vector<SkeletonPtr>& SkeletonBatch::getSkeletons() const
+{
+  return mSkeletons;
+}
+
+//==============================================================================
+std::size_t SkeletonBatch::getNumSkeletons() const
+{
+  return mSkeletons.size();
+}
+
+//==============================================================================
+void SkeletonBatch::computeForwardDynamics()
+{
+  for (std::size_t k = 0u; k < mPacks.size(); ++k)
+  {
+    gather(k);
+
+    Lanes* data = mPacks[k]->mData.data();
+    const Lanes* gravity = data + GravityOffset;
+    const std::size_t numBodies = mBodyLayouts.size();
+
+    // Forward recursion: velocities, partial accelerations, and the body terms
+    // of the articulated inertias and bias forces
+    for (std::size_t i = 0u; i < numBodies; ++i)
+    {
+      const BodyLayout& layout = mBodyLayouts[i];
+      BodyLanes body(data + layout.mOffset, layout.mNumDofs);
+
+      if (layout.mParentIndex >= 0)
+      {
+        const BodyLayout& parentLayout = mBodyLayouts[layout.mParentIndex];
+        const BodyLanes parent(
+            data + parentLayout.mOffset, parentLayout.mNumDofs);
+        adInvT(body.T, parent.V, body.V);
+        rotateInv(body.T, parent.g, body.g);
+      }
+      else
+      {
+        for (std::size_t r = 0u; r < 6u; ++r)
+          body.V[r] = Lanes::Zero();
+        rotateInv(body.T, gravity, body.g);
+      }
+
+      // V = AdInvT(T, V_parent) + S * dq
+      Lanes Sdq[6];
+      multiplyJacobian(body.S, body.dq, body.n, Sdq);
+      for (std::size_t r = 0u; r < 6u; ++r)
+        body.V[r] += Sdq[r];
+
+      // eta = ad(V, S * dq) + dS * dq
+      Lanes dSdq[6];
+      ad(body.V, Sdq, body.eta);
+      multiplyJacobian(body.dS, body.dq, body.n, dSdq);
+      for (std::size_t r = 0u; r < 6u; ++r)
+        body.eta[r] += dSdq[r];
+
+      // AI = I
+      std::copy(body.I, body.I + 36, body.AI);
+
+      // B = -dad(V, I * V) - Fext - I * (0, g)
+      Lanes IV[6];
+      Lanes coriolis[6];
+      multiply6(body.I, body.V, IV);
+      dad(body.V, IV, coriolis);
+
+      Lanes Fg[6];
+      const Lanes g[6] = {Lanes::Zero(),
+                          Lanes::Zero(),
+                          Lanes::Zero(),
+                          body.mode[0] * body.g[0],
+                          body.mode[0] * body.g[1],
+                          body.mode[0] * body.g[2]};
+      multiply6(body.I, g, Fg);
+
+      for (std::size_t r = 0u; r < 6u; ++r)
+        body.B[r] = -coriolis[r] - body.Fext[r] - Fg[r];
+    }
+
+    // Backward recursion: articulated inertias, bias forces, and total joint
+    // forces
+    for (std::size_t i = numBodies; i-- > 0u;)
+    {
+      const BodyLayout& layout = mBodyLayouts[i];
+      BodyLanes body(data + layout.mOffset, layout.mNumDofs);
+      const std::size_t n = body.n;
+
+      // AIS = AI * S
+      for (std::size_t j = 0u; j < n; ++j)
+        multiply6(body.AI, body.S + 6u * j, body.AIS + 6u * j);
+
+      // P = S^T * AI * S + diag(d)
+      for (std::size_t b = 0u; b < n; ++b)
+        multiplyJacobianTranspose(body.S, body.AIS + 6u * b, n, body.P + n * b);
+      for (std::size_t j = 0u; j < n; ++j)
+        body.P[j + n * j] += body.d[j];
+      factorize(body.P, n);
+
+      // u = f - S^T * (AI * eta + B)
+      Lanes bodyForce[6];
+      multiply6(body.AI, body.eta, bodyForce);
+      for (std::size_t r = 0u; r < 6u; ++r)
+        bodyForce[r] += body.B[r];
+      multiplyJacobianTranspose(body.S, bodyForce, n, body.u);
+      for (std::size_t j = 0u; j < n; ++j)
+        body.u[j] = body.f[j] - body.u[j];
+
+      // ddq holds P^-1 * u until the forward recursion below
+      std::copy(body.u, body.u + n, body.ddq);
+      solve(body.P, n, body.ddq);
+
+      if (layout.mParentIndex < 0)
+        continue;
+
+      const BodyLayout& parentLayout = mBodyLayouts[layout.mParentIndex];
+      BodyLanes parent(data + parentLayout.mOffset, parentLayout.mNumDofs);
+
+      // Y = P^-1 * AIS^T
+      for (std::size_t c = 0u; c < 6u; ++c)
+      {
+        Lanes* y = body.Y + n * c;
+        for (std::size_t j = 0u; j < n; ++j)
+          y[j] = body.AIS[c + 6u * j];
+        solve(body.P, n, y);
+      }
+
+      // AI_parent += transformInertia(T^-1, AI - AIS * Y)
+      Lanes PI[36];
+      for (std::size_t c = 0u; c < 6u; ++c)
+      {
+        for (std::size_t r = 0u; r < 6u; ++r)
+        {
+          Lanes value = body.AI[r + 6u * c];
+          for (std::size_t j = 0u; j < n; ++j)
+            value -= body.AIS[r + 6u * j] * body.Y[j + n * c];
+          PI[r + 6u * c] = value;
+        }
+      }
+      addTransformedInertia(body.T, PI, parent.AI);
+
+      // B_parent += dAdInvT(T, B + AI * (eta + S * P^-1 * u))
+      Lanes acc[6];
+      multiplyJacobian(body.S, body.ddq, n, acc);
+      for (std::size_t r = 0u; r < 6u; ++r)
+        acc[r] += body.eta[r];
+
+      Lanes beta[6];
+      multiply6(body.AI, acc, beta);
+      for (std::size_t r = 0u; r < 6u; ++r)
+        beta[r] += body.B[r];
+      addDAdInvT(body.T, beta, parent.B);
+    }
+
+    // Forward recursion: joint and spatial accelerations
+    for (std::size_t i = 0u; i < numBodies; ++i)
+    {
+      const BodyLayout& layout = mBodyLayouts[i];
+      BodyLanes body(data + layout.mOffset, layout.mNumDofs);
+      const std::size_t n = body.n;
+
+      if (layout.mParentIndex >= 0)
+      {
+        const BodyLayout& parentLayout = mBodyLayouts[layout.mParentIndex];
+        const BodyLanes parent(
+            data + parentLayout.mOffset, parentLayout.mNumDofs);
+
+        // ddq = P^-1 * (u - S^T * AI * a) = P^-1 * u - Y * a
+        adInvT(body.T, parent.A, body.A);
+        for (std::size_t j = 0u; j < n; ++j)
+          for (std::size_t c = 0u; c < 6u; ++c)
+            body.ddq[j] -= body.Y[j + n * c] * body.A[c];
+      }
+      else
+      {
+        for (std::size_t r = 0u; r < 6u; ++r)
+          body.A[r] = Lanes::Zero();
+      }
+
+      // A = AdInvT(T, A_parent) + eta + S * ddq
+      Lanes Sddq[6];
+      multiplyJacobian(body.S, body.ddq, n, Sddq);
+      for (std::size_t r = 0u; r < 6u; ++r)
+        body.A[r] += body.eta[r] + Sddq[r];
+    }
+
+    scatter(k);
+  }
+}
+
+//==============================================================================
+void SkeletonBatch::gatherProperties(std::size_t packIndex)
+{
+  Pack& pack = *mPacks[packIndex];
+  Lanes* data = pack.mData.data();
+
+  for (std::size_t lane = 0u; lane < NumLanes; ++lane)
+  {
+    const std::size_t index
+        = pack.mFirstIndex + std::min(lane, pack.mNumValidLanes - 1u);
+    const Skeleton* skel = mSkeletons[index].get();
+
+    for (std::size_t i = 0u; i < mBodyLayouts.size(); ++i)
+    {
+      const BodyLayout& layout = mBodyLayouts[i];
+      BodyLanes body(data + layout.mOffset, layout.mNumDofs);
+      const BodyNode* bodyNode = skel->getBodyNode(i);
+      const Joint* joint = bodyNode->getParentJoint();
+
+      const Eigen::Matrix6d& I = bodyNode->getSpatialInertia();
+      for (std::size_t j = 0u; j < 36u; ++j)
+        body.I[j][lane] = I.data()[j];
+
+      body.mode[0][lane] = bodyNode->getGravityMode() ? 1.0 : 0.0;
+
+      if (body.n == 0u)
+        continue;
+
+      if (layout.mHasConstantJacobian)
+      {
+        const math::Jacobian S = joint->getRelativeJacobian();
+        for (std::size_t j = 0u; j < 6u * body.n; ++j)
+        {
+          body.S[j][lane] = S.data()[j];
+          body.dS[j][lane] = 0.0;
+        }
+      }
+
+      for (std::size_t j = 0u; j < body.n; ++j)
+      {
+        const std::size_t dof = layout.mFirstDofIndex + j;
+        pack.mSpringStiffnesses(dof, lane) = joint->getSpringStiffness(j);
+        pack.mRestPositions(dof, lane) = joint->getRestPosition(j);
+        pack.mDampingCoefficients(dof, lane)
+            = joint->getDampingCoefficient(j);
+        pack.mPositionServoGains(dof, lane) = joint->getPositionServoGain(j);
+        pack.mVelocityServoGains(dof, lane) = joint->getVelocityServoGain(j);
+      }
+    }
+  }
+}
+
+//==============================================================================
+void SkeletonBatch::gather(std::size_t packIndex)
+{
+  Pack& pack = *mPacks[packIndex];
+  Lanes* data = pack.mData.data();
+
+  for (std::size_t lane = 0u; lane < NumLanes; ++lane)
+  {
+    const std::size_t index
+        = pack.mFirstIndex + std::min(lane, pack.mNumValidLanes - 1u);
+    const Skeleton* skel = mSkeletons[index].get();
+    const double timeStep = skel->getTimeStep();
+
+    const Eigen::Vector3d& gravity = skel->getGravity();
+    for (std::size_t r = 0u; r < 3u; ++r)
+      data[GravityOffset + r][lane] = gravity[r];
+
+    mPositions = skel->getPositions();
+    mVelocities = skel->getVelocities();
+    mCommands = skel->getCommands();
+
+    for (std::size_t i = 0u; i < mBodyLayouts.size(); ++i)
+    {
+      const BodyLayout& layout = mBodyLayouts[i];
+      BodyLanes body(data + layout.mOffset, layout.mNumDofs);
+      const BodyNode* bodyNode = skel->getBodyNode(i);
+      const Joint* joint = bodyNode->getParentJoint();
+
+      const Eigen::Isometry3d& T = joint->getRelativeTransform();
+      for (std::size_t c = 0u; c < 3u; ++c)
+        for (std::size_t r = 0u; r < 3u; ++r)
+          body.T[r + 3u * c][lane] = T.linear()(r, c);
+      for (std::size_t r = 0u; r < 3u; ++r)
+        body.T[9u + r][lane] = T.translation()[r];
+
+      const Eigen::Vector6d& Fext = bodyNode->getExternalForceLocal();
+      for (std::size_t r = 0u; r < 6u; ++r)
+        body.Fext[r][lane] = Fext[r];
+
+      if (body.n == 0u)
+        continue;
+
+      if (!layout.mHasConstantJacobian)
+      {
+        const math::Jacobian S = joint->getRelativeJacobian();
+        const math::Jacobian dS = joint->getRelativeJacobianTimeDeriv();
+        for (std::size_t j = 0u; j < 6u * body.n; ++j)
+        {
+          body.S[j][lane] = S.data()[j];
+          body.dS[j][lane] = dS.data()[j];
+        }
+      }
+
+      for (std::size_t j = 0u; j < body.n; ++j)
+      {
+        const std::size_t dof = layout.mFirstDofIndex + j;
+        const double q = mPositions[dof];
+        const double dq = mVelocities[dof];
+        const double k = pack.mSpringStiffnesses(dof, lane);
+        const double c = pack.mDampingCoefficients(dof, lane);
+        const double kp = pack.mPositionServoGains(dof, lane);
+        const double kd = pack.mVelocityServoGains(dof, lane);
+
+        // Same terms as GenericJoint::updateTotalForceDynamic() and
+        // GenericJoint::updateInvProjArtInertiaImplicitDynamic()
+        double force = (layout.mIsForce ? mCommands[dof] : 0.0)
+                       - k * (q - pack.mRestPositions(dof, lane)
+                              + dq * timeStep)
+                       - c * dq;
+
+        // The servo targets may change between steps like the commands, so
+        // they are read here, but only for the DOFs that have servo gains.
+        if (kp != 0.0)
+        {
+          force -= kp * (q - joint->getServoTargetPosition(j)
+                         + dq * timeStep);
+        }
+        if (kd != 0.0)
+          force -= kd * (dq - joint->getServoTargetVelocity(j));
+
+        body.dq[j][lane] = dq;
+        body.f[j][lane] = force;
+        body.d[j][lane]
+            = timeStep * (c + kd) + timeStep * timeStep * (k + kp);
+      }
+    }
+  }
+}
+
+//==============================================================================
+void SkeletonBatch::scatter(std::size_t packIndex)
+{
+  const Pack& pack = *mPacks[packIndex];
+  const Lanes* data = pack.mData.data();
+
+  for (std::size_t lane = 0u; lane < pack.mNumValidLanes; ++lane)
+  {
+    Skeleton* skel = mSkeletons[pack.mFirstIndex + lane].get();
+
+    for (std::size_t i = 0u; i < mBodyLayouts.size(); ++i)
+    {
+      const BodyLayout& layout = mBodyLayouts[i];
+      if (layout.mNumDofs == 0u)
+        continue;
+
+      const Lanes* ddq = data + layout.mOffset + DofOffset
+                         + 24u * layout.mNumDofs + 4u * layout.mNumDofs;
+      for (std::size_t j = 0u; j < layout.mNumDofs; ++j)
+        mAccelerations[layout.mFirstDofIndex + j] = ddq[j][lane];
+    }
+
+    skel->setAccelerations(mAccelerations);
+  }
+}
+
+} // namespace dynamics
+} // namespace dart
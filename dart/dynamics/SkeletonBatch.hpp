@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_SKELETONBATCH_HPP_
+#define DART_DYNAMICS_SKELETONBATCH_HPP_
+
+#include <memory>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "dart/dynamics/SmartPointer.hpp"
+
+namespace dart {
+namespace dynamics {
+
+/// SkeletonBatch evaluates the forward dynamics of many topologically
+/// identical Skeletons at once, e.g., the parallel environments of a
+/// reinforcement learning setup.
+///
+/// The instances are processed NumLanes at a time. Within such a pack, every
+/// spatial vector, 6x6 (articulated) inertia, and joint space quantity of the
+/// articulated body algorithm is stored component by component with one SIMD
+/// lane per instance, so each arithmetic operation of the recursion advances
+/// all instances of the pack together. The joint kinematics (relative
+/// transforms and Jacobians) are still taken from each Skeleton, except for
+/// the constant Jacobians of revolute, prismatic, screw, and translational
+/// Joints.
+///
+/// The properties that don't change while simulating (inertias, gravity modes,
+/// constant Joint Jacobians, and joint spring, damping, and servo gains) are
+/// captured once by setSkeletons(). Call updateProperties() after changing any
+/// of them.
+///
+/// The instances must have the same BodyNode tree with the same Joint types,
+/// but may differ in their state, inertial properties, joint properties,
+/// external forces, gravity, and time step. SoftBodyNodes and Joints with
+/// ACCELERATION, VELOCITY, or LOCKED actuators are not supported.
+class SkeletonBatch
+{
+public:
+  /// Number of instances processed together in one SIMD pack
+  static constexpr std::size_t NumLanes = 4u;
+
+  /// Constructor
+  SkeletonBatch();
+
+  /// Constructor
+  explicit SkeletonBatch(const std::vector<SkeletonPtr>& skeletons);
+
+  /// Destructor
+  ~SkeletonBatch();
+
+  /// Sets the Skeletons of this batch. Returns false and leaves this batch
+  /// empty if the Skeletons are not topologically identical or contain
+  /// unsupported BodyNodes or Joints. The topology is captured here; call this
+  /// again after changing the structure of the Skeletons.
+  bool setSkeletons(const std::vector<SkeletonPtr>& skeletons);
+
+  /// Captures the inertias, gravity modes, constant Joint Jacobians, and joint
+  /// spring, damping, and servo gains of the Skeletons again. Call this after
+  /// changing any of them.
+  void updateProperties();
+
+  /// Returns the Skeletons of this batch
+  const std::vector<SkeletonPtr>& getSkeletons() const;
+
+  /// Returns the number of Skeletons in this batch
+  std::size_t getNumSkeletons() const;
+
+  /// Computes the joint accelerations of every Skeleton in this batch from its
+  /// current positions, velocities, commands, and external forces, and stores
+  /// them in the Skeleton. The accelerations match those of
+  /// Skeleton::computeForwardDynamics() up to round-off, including the
+  /// implicit joint damping, spring, and servo terms. Unlike
+  /// Skeleton::computeForwardDynamics(), the transmitted body forces are not
+  /// updated.
+  void computeForwardDynamics();
+
+protected:
+  /// Topology of one BodyNode, shared by all instances
+  struct BodyLayout
+  {
+    /// Index of the parent BodyNode, or -1 for a root BodyNode
+    int mParentIndex;
+
+    /// Number of DOFs of the parent Joint
+    std::size_t mNumDofs;
+
+    /// Index of the first DOF of the parent Joint in the Skeleton
+    std::size_t mFirstDofIndex;
+
+    /// True if the parent Joint has a FORCE actuator
+    bool mIsForce;
+
+    /// True if the relative Jacobian of the parent Joint is constant and its
+    /// time derivative is zero
+    bool mHasConstantJacobian;
+
+    /// Offset of this BodyNode's data in the lane storage of a pack
+    std::size_t mOffset;
+  };
+
+  /// Lane storage of one pack of instances
+  struct Pack;
+
+  /// Captures the properties of the instances of a pack into its lanes. See
+  /// updateProperties().
+  void gatherProperties(std::size_t packIndex);
+
+  /// Gathers the state of the instances of a pack into its lanes
+  void gather(std::size_t packIndex);
+
+  /// Writes the joint accelerations of the valid lanes of a pack back to the
+  /// instances
+  void scatter(std::size_t packIndex);
+
+  /// Skeletons of this batch
+  std::vector<SkeletonPtr> mSkeletons;
+
+  /// Topology of the BodyNodes in the order of the Skeletons
+  std::vector<BodyLayout> mBodyLayouts;
+
+  /// Lane storage of every pack
+  std::vector<std::unique_ptr<Pack>> mPacks;
+
+  /// Scratch buffers for the state of a Skeleton
+  Eigen::VectorXd mPositions;
+  Eigen::VectorXd mVelocities;
+  Eigen::VectorXd mCommands;
+
+  /// Scratch buffer for the accelerations of a Skeleton
+  Eigen::VectorXd mAccelerations;
+};
+
+} // namespace dynamics
+} // namespace dart
+
+#endif // DART_DYNAMICS_SKELETONBATCH_HPP_
@@ -0,0 +1,544 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "dart/dynamics/SkeletonDerivatives.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "dart/common/Console.hpp"
+#include "dart/math/Geometry.hpp"
+#include "dart/dynamics/BallJoint.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/Joint.hpp"
+#include "dart/dynamics/PrismaticJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/ScrewJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/TranslationalJoint.hpp"
+#include "dart/dynamics/TranslationalJoint2D.hpp"
+#include "dart/dynamics/WeldJoint.hpp"
+
+namespace dart {
+namespace dynamics {
+
+namespace {
+
+/// Step of the central differences of the relative Jacobian
+constexpr double JacobianStep = 1e-6;
+
+/// Step of the nested central differences of dS * dq
+constexpr double JacobianDerivStep = 1e-4;
+
+//==============================================================================
+/// Returns true if the relative Jacobian of joint does not depend on its
+/// positions, in which case the time derivative of the Jacobian is zero as
+/// well
+bool hasConstantRelativeJacobian(const Joint* joint)
+{
+  const std::string& type = joint->getType();
+
+  return type == RevoluteJoint::getStaticType()
+         || type == PrismaticJoint::getStaticType()
+         || type == ScrewJoint::getStaticType()
+         || type == TranslationalJoint::getStaticType()
+         || type == TranslationalJoint2D::getStaticType()
+         || type == BallJoint::getStaticType()
+         || type == FreeJoint::getStaticType()
+         || type == WeldJoint::getStaticType();
+}
+
+//==============================================================================
+/// Returns the derivative of the positions of joint with respect to a motion
+/// along its velocities, i.e., of the positions after
+/// Joint::integratePositions() with respect to the integrated velocities
+Eigen::MatrixXd getPositionTangentMap(const Joint* joint)
+{
+  const std::size_t numDofs = joint->getNumDofs();
+  Eigen::MatrixXd map = Eigen::MatrixXd::Identity(numDofs, numDofs);
+
+  const std::string& type = joint->getType();
+  if (type != BallJoint::getStaticType() && type != FreeJoint::getStaticType())
+    return map;
+
+  // The rotation is updated as R * exp(w * dt), so its exponential coordinates
+  // move with the inverse of the right Jacobian of SO(3). The translation of a
+  // FreeJoint is updated as p + R * v * dt.
+  const Eigen::VectorXd positions = joint->getPositions();
+  const Eigen::Vector3d rotation = positions.head<3>();
+  map.topLeftCorner<3, 3>() = math::expMapJac(rotation).transpose().inverse();
+
+  if (type == FreeJoint::getStaticType())
+    map.bottomRightCorner<3, 3>() = math::expMapRot(rotation);
+
+  return map;
+}
+
+} // namespace
+
+//==============================================================================
+SkeletonDerivatives::SkeletonDerivatives()
+{
+  // Do nothing
+}
+
+//==============================================================================
+SkeletonDerivatives::SkeletonDerivatives(const SkeletonPtr& skeleton)
+{
+  setSkeleton(skeleton);
+}
+
+//==============================================================================
+SkeletonDerivatives::~SkeletonDerivatives()
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool SkeletonDerivatives::setSkeleton(const SkeletonPtr& skeleton)
+{
+  mSkeleton = nullptr;
+  mBodies.clear();
+
+  if (!skeleton)
+    return true;
+
+  common::aligned_vector<BodyData> bodies(skeleton->getNumBodyNodes());
+  for (std::size_t i = 0u; i < bodies.size(); ++i)
+  {
+    const BodyNode* bodyNode = skeleton->getBodyNode(i);
+    const Joint* joint = bodyNode->getParentJoint();
+
+    if (bodyNode->asSoftBodyNode())
+    {
+      dterr << "[SkeletonDerivatives::setSkeleton] BodyNode ["
+            << bodyNode->getName() << "] of Skeleton [" << skeleton->getName()
+            << "] is a SoftBodyNode, which is not supported.\n";
+      return false;
+    }
+
+    const BodyNode* parent = bodyNode->getParentBodyNode();
+
+    BodyData& body = bodies[i];
+    body.mParentIndex
+        = parent ? static_cast<int>(parent->getIndexInSkeleton()) : -1;
+    body.mNumDofs = joint->getNumDofs();
+    body.mDofIndex
+        = body.mNumDofs > 0u ? joint->getIndexInSkeleton(0) : 0u;
+    body.mHasConstantJacobian = hasConstantRelativeJacobian(joint);
+    assert(body.mParentIndex < static_cast<int>(i));
+
+    if (!body.mHasConstantJacobian)
+    {
+      body.mSDerivs.resize(body.mNumDofs);
+      body.mdSdqDerivs.resize(body.mNumDofs);
+    }
+  }
+
+  mSkeleton = skeleton;
+  mBodies = std::move(bodies);
+
+  const std::size_t numDofs = mSkeleton->getNumDofs();
+  mDtauDq = Eigen::MatrixXd::Zero(numDofs, numDofs);
+  mDtauDdq = Eigen::MatrixXd::Zero(numDofs, numDofs);
+  mDddqDq = Eigen::MatrixXd::Zero(numDofs, numDofs);
+  mDddqDdq = Eigen::MatrixXd::Zero(numDofs, numDofs);
+  mDddqDtau = Eigen::MatrixXd::Zero(numDofs, numDofs);
+
+  return true;
+}
+
+//==============================================================================
+const SkeletonPtr& SkeletonDerivatives::getSkeleton() const
+{
+  return mSkeleton;
+}
+
+//==============================================================================
+void SkeletonDerivatives::computeInverseDynamicsDerivatives(
+    bool withExternalForces, bool withDampingForces, bool withSpringForces)
+{
+  if (!mSkeleton || mSkeleton->getNumDofs() == 0u)
+    return;
+
+  assert(mSkeleton->getNumBodyNodes() == mBodies.size());
+  gather(withExternalForces);
+
+  for (std::size_t i = 0u; i < mBodies.size(); ++i)
+  {
+    const BodyData& body = mBodies[i];
+    for (std::size_t k = 0u; k < body.mNumDofs; ++k)
+    {
+      propagate(i, k, true, mDtauDq.col(body.mDofIndex + k));
+      propagate(i, k, false, mDtauDdq.col(body.mDofIndex + k));
+    }
+  }
+
+  addJointForceDerivatives(
+      withDampingForces, withSpringForces, mDtauDq, mDtauDdq);
+}
+
+//==============================================================================
+const Eigen::MatrixXd& SkeletonDerivatives::getForcesPositionDerivatives() const
+{
+  return mDtauDq;
+}
+
+//==============================================================================
+const Eigen::MatrixXd& SkeletonDerivatives::getForcesVelocityDerivatives() const
+{
+  return mDtauDdq;
+}
+
+//==============================================================================
+bool SkeletonDerivatives::computeForwardDynamicsDerivatives()
+{
+  if (!mSkeleton)
+    return true;
+
+  for (std::size_t i = 0u; i < mSkeleton->getNumJoints(); ++i)
+  {
+    const Joint* joint = mSkeleton->getJoint(i);
+    const Joint::ActuatorType type = joint->getActuatorType();
+    if (type == Joint::ACCELERATION || type == Joint::VELOCITY
+        || type == Joint::LOCKED)
+    {
+      dterr << "[SkeletonDerivatives::computeForwardDynamicsDerivatives] "
+            << "Joint [" << joint->getName() << "] of Skeleton ["
+            << mSkeleton->getName() << "] has an ACCELERATION, VELOCITY, or "
+            << "LOCKED actuator, which is not supported.\n";
+      return false;
+    }
+  }
+
+  const std::size_t numDofs = mSkeleton->getNumDofs();
+  if (numDofs == 0u)
+    return true;
+
+  mSkeleton->computeForwardDynamics();
+
+  // The forward dynamics solves ID(q, dq, ddq) + D * ddq = f(q, dq, tau), where
+  // ID are the joint forces of the inverse dynamics with external forces, D
+  // holds the implicit terms h * (c + kd) + h^2 * (k + kp), and f the commands
+  // and the explicit spring, damping, and servo forces. The derivatives of
+  // ID - f match those of the inverse dynamics with all the joint forces.
+  computeInverseDynamicsDerivatives(true, true, true);
+
+  // The augmented mass matrix is M + D
+  mAugM = mSkeleton->getAugMassMatrix();
+
+  mDddqDtau = mAugM.llt().solve(Eigen::MatrixXd::Identity(numDofs, numDofs));
+  mDddqDq.noalias() = -mDddqDtau * mDtauDq;
+  mDddqDdq.noalias() = -mDddqDtau * mDtauDdq;
+
+  return true;
+}
+
+//==============================================================================
+const Eigen::MatrixXd&
+SkeletonDerivatives::getAccelerationsPositionDerivatives() const
+{
+  return mDddqDq;
+}
+
+//==============================================================================
+const Eigen::MatrixXd&
+SkeletonDerivatives::getAccelerationsVelocityDerivatives() const
+{
+  return mDddqDdq;
+}
+
+//==============================================================================
+const Eigen::MatrixXd&
+SkeletonDerivatives::getAccelerationsForceDerivatives() const
+{
+  return mDddqDtau;
+}
+
+//==============================================================================
+void SkeletonDerivatives::gather(bool withExternalForces)
+{
+  const Eigen::Vector3d& gravity = mSkeleton->getGravity();
+
+  for (std::size_t i = 0u; i < mBodies.size(); ++i)
+  {
+    BodyData& body = mBodies[i];
+    const BodyNode* bodyNode = mSkeleton->getBodyNode(i);
+    const Joint* joint = bodyNode->getParentJoint();
+
+    body.mT = joint->getRelativeTransform();
+    body.mS = joint->getRelativeJacobian();
+    body.mdS = joint->getRelativeJacobianTimeDeriv();
+    body.mdq = joint->getVelocities();
+    body.mddq = joint->getAccelerations();
+    body.mI = bodyNode->getSpatialInertia();
+    body.mV = bodyNode->getSpatialVelocity();
+    body.mA = bodyNode->getSpatialAcceleration();
+    body.mG = math::AdInvRLinear(bodyNode->getWorldTransform(), gravity);
+    body.mGravityMode = bodyNode->getGravityMode();
+
+    // Recover the quantities of the recursion that the BodyNode does not keep
+    const Eigen::Vector6d Sdq = body.mS * body.mdq;
+    body.mParentV = body.mV - Sdq;
+    body.mEta = math::ad(body.mV, Sdq) + body.mdS * body.mdq;
+    body.mParentA = body.mA - body.mEta - body.mS * body.mddq;
+
+    // Same terms as BodyNode::updateTransmittedForceID() without the child
+    // forces, which are added below
+    const Eigen::Vector6d IV = body.mI * body.mV;
+    body.mF.noalias() = body.mI * body.mA;
+    body.mF -= math::dad(body.mV, IV);
+    if (withExternalForces)
+      body.mF -= bodyNode->getExternalForceLocal();
+    if (body.mGravityMode)
+      body.mF.noalias() -= body.mI * body.mG;
+
+    if (body.mHasConstantJacobian)
+      continue;
+
+    // Derivatives of the relative Jacobian by central differences of the Joint
+    const Eigen::VectorXd q = joint->getPositions();
+    const double scale = std::max(1.0, body.mdq.lpNorm<Eigen::Infinity>());
+    const double eps = JacobianDerivStep / scale;
+
+    // D_dq S(x) * dq, i.e., dS * dq at the positions x
+    auto getdSdq = [&](const Eigen::VectorXd& x) -> Eigen::Vector6d
+    {
+      return (joint->getRelativeJacobian(x + eps * body.mdq)
+              - joint->getRelativeJacobian(x - eps * body.mdq))
+             * body.mdq / (2.0 * eps);
+    };
+
+    for (std::size_t k = 0u; k < body.mNumDofs; ++k)
+    {
+      Eigen::VectorXd plus = q;
+      Eigen::VectorXd minus = q;
+      plus[k] += JacobianStep;
+      minus[k] -= JacobianStep;
+      body.mSDerivs[k] = (joint->getRelativeJacobian(plus)
+                          - joint->getRelativeJacobian(minus))
+                         / (2.0 * JacobianStep);
+
+      if (body.mdq.isZero(0.0))
+      {
+        body.mdSdqDerivs[k].setZero();
+        continue;
+      }
+
+      plus[k] = q[k] + JacobianDerivStep;
+      minus[k] = q[k] - JacobianDerivStep;
+      body.mdSdqDerivs[k]
+          = (getdSdq(plus) - getdSdq(minus)) / (2.0 * JacobianDerivStep);
+    }
+  }
+
+  // Add the transmitted forces of the children
+  for (std::size_t i = mBodies.size(); i-- > 0u;)
+  {
+    const BodyData& body = mBodies[i];
+    if (body.mParentIndex >= 0)
+      mBodies[body.mParentIndex].mF += math::dAdInvT(body.mT, body.mF);
+  }
+}
+
+//==============================================================================
+void SkeletonDerivatives::propagate(
+    std::size_t index,
+    std::size_t dof,
+    bool wrtPositions,
+    Eigen::Ref<Eigen::VectorXd> column)
+{
+  column.setZero();
+
+  for (std::size_t i = 0u; i < index; ++i)
+  {
+    mBodies[i].mIsAffected = false;
+    mBodies[i].mHasForceDeriv = false;
+    mBodies[i].mDF.setZero();
+  }
+
+  //--------------------------------------------------------------------------
+  // Forward recursion: only the subtree of the Joint is affected. With s the
+  // column dof of S, a position of the Joint changes T by T * [s], so
+  // AdInvT(T, X) changes by -ad(s, AdInvT(T, X)) = ad(AdInvT(T, X), s).
+  //--------------------------------------------------------------------------
+  BodyData& joint = mBodies[index];
+  const Eigen::Vector6d s = joint.mS.col(dof);
+  const Eigen::Vector6d Sdq = joint.mV - joint.mParentV;
+
+  if (wrtPositions)
+  {
+    joint.mDV = math::ad(joint.mParentV, s);
+    joint.mDG = math::ad(joint.mG, s);
+    joint.mDA = math::ad(joint.mParentA, s);
+
+    if (!joint.mHasConstantJacobian)
+    {
+      const math::Jacobian& dS = joint.mSDerivs[dof];
+      const Eigen::Vector6d dSdq = dS * joint.mdq;
+      joint.mDV += dSdq;
+      joint.mDA += dS * joint.mddq + math::ad(joint.mV, dSdq)
+                   + joint.mdSdqDerivs[dof];
+    }
+
+    // Derivative of the partial acceleration ad(V, S * dq) + dS * dq
+    joint.mDA += math::ad(joint.mDV, Sdq);
+  }
+  else
+  {
+    joint.mDV = s;
+    joint.mDG.setZero();
+    joint.mDA = math::ad(s, Sdq) + math::ad(joint.mV, s);
+
+    if (!joint.mHasConstantJacobian)
+      joint.mDA += joint.mSDerivs[dof] * joint.mdq + joint.mdS.col(dof);
+  }
+
+  for (std::size_t i = index; i < mBodies.size(); ++i)
+  {
+    BodyData& body = mBodies[i];
+
+    if (i != index)
+    {
+      body.mIsAffected = body.mParentIndex >= static_cast<int>(index)
+                         && mBodies[body.mParentIndex].mIsAffected;
+      if (!body.mIsAffected)
+      {
+        body.mHasForceDeriv = false;
+        body.mDF.setZero();
+        continue;
+      }
+
+      const BodyData& parent = mBodies[body.mParentIndex];
+      body.mDV = math::AdInvT(body.mT, parent.mDV);
+      body.mDG = math::AdInvT(body.mT, parent.mDG);
+      body.mDA = math::AdInvT(body.mT, parent.mDA)
+                 + math::ad(body.mDV, body.mV - body.mParentV);
+    }
+    else
+    {
+      body.mIsAffected = true;
+    }
+
+    // Derivative of the terms of BodyNode::updateTransmittedForceID()
+    body.mDF.noalias() = body.mI * body.mDA;
+    body.mDF -= math::dad(body.mDV, body.mI * body.mV);
+    body.mDF -= math::dad(body.mV, body.mI * body.mDV);
+    if (body.mGravityMode)
+      body.mDF.noalias() -= body.mI * body.mDG;
+    body.mHasForceDeriv = true;
+  }
+
+  //--------------------------------------------------------------------------
+  // Backward recursion: the subtree and the ancestors of the Joint are
+  // affected
+  //--------------------------------------------------------------------------
+  for (std::size_t i = mBodies.size(); i-- > 0u;)
+  {
+    const BodyData& body = mBodies[i];
+    if (!body.mHasForceDeriv)
+      continue;
+
+    if (body.mNumDofs > 0u)
+    {
+      column.segment(body.mDofIndex, body.mNumDofs).noalias()
+          += body.mS.transpose() * body.mDF;
+    }
+
+    if (i == index && wrtPositions && !body.mHasConstantJacobian)
+    {
+      column.segment(body.mDofIndex, body.mNumDofs).noalias()
+          += body.mSDerivs[dof].transpose() * body.mF;
+    }
+
+    if (body.mParentIndex < 0)
+      continue;
+
+    BodyData& parent = mBodies[body.mParentIndex];
+    parent.mDF += math::dAdInvT(body.mT, body.mDF);
+    if (i == index && wrtPositions)
+      parent.mDF -= math::dAdInvT(body.mT, math::dad(s, body.mF));
+    parent.mHasForceDeriv = true;
+  }
+}
+
+//==============================================================================
+void SkeletonDerivatives::addJointForceDerivatives(
+    bool withDampingForces,
+    bool withSpringForces,
+    Eigen::MatrixXd& dtauDq,
+    Eigen::MatrixXd& dtauDdq) const
+{
+  const double timeStep = mSkeleton->getTimeStep();
+
+  for (std::size_t i = 0u; i < mBodies.size(); ++i)
+  {
+    const BodyData& body = mBodies[i];
+    const std::size_t n = body.mNumDofs;
+    if (n == 0u)
+      continue;
+
+    const Joint* joint = mSkeleton->getJoint(i);
+
+    // Same terms as GenericJoint::updateForceID(), where the position servo
+    // term counts as spring and the velocity servo term as damping
+    Eigen::VectorXd stiffness = Eigen::VectorXd::Zero(n);
+    for (std::size_t k = 0u; k < n; ++k)
+    {
+      const std::size_t index = body.mDofIndex + k;
+
+      if (withSpringForces)
+      {
+        stiffness[k] = joint->getSpringStiffness(k)
+                       + joint->getPositionServoGain(k);
+        dtauDdq(index, index) += timeStep * stiffness[k];
+      }
+
+      if (withDampingForces)
+      {
+        dtauDdq(index, index) += joint->getDampingCoefficient(k)
+                                 + joint->getVelocityServoGain(k);
+      }
+    }
+
+    if (!stiffness.isZero(0.0))
+    {
+      dtauDq.block(body.mDofIndex, body.mDofIndex, n, n)
+          += stiffness.asDiagonal() * getPositionTangentMap(joint);
+    }
+  }
+}
+
+} // namespace dynamics
+} // namespace dart
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef DART_DYNAMICS_SKELETONDERIVATIVES_HPP_
+#define DART_DYNAMICS_SKELETONDERIVATIVES_HPP_
+
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "dart/common/Memory.hpp"
+#include "dart/math/MathTypes.hpp"
+#include "dart/dynamics/SmartPointer.hpp"
+
+namespace dart {
+namespace dynamics {
+
+/// SkeletonDerivatives computes the analytical derivatives of the inverse and
+/// forward dynamics of a Skeleton with respect to its positions, velocities,
+/// and joint forces, e.g., for trajectory optimization and model predictive
+/// control.
+///
+/// The derivatives are propagated through the same recursion as
+/// Skeleton::computeInverseDynamics(), using the transforms, Jacobians,
+/// velocities, and accelerations of the BodyNodes. One recursion per DOF
+/// replaces the full dynamics evaluation per DOF of finite differencing.
+///
+/// The derivative with respect to the positions of a Joint is taken along its
+/// velocities, i.e., in the direction that Joint::integratePositions() moves
+/// the positions. For BallJoint and FreeJoint this is the tangent space of the
+/// rotation, and for every other Joint it is the ordinary partial derivative.
+/// For Joints whose relative Jacobian depends on their positions (EulerJoint,
+/// UniversalJoint, and PlanarJoint), the derivatives of that Jacobian are
+/// obtained by central differences of Joint::getRelativeJacobian(positions),
+/// which only evaluates the Joint itself.
+///
+/// SoftBodyNodes are not supported.
+class SkeletonDerivatives
+{
+public:
+  /// Constructor
+  SkeletonDerivatives();
+
+  /// Constructor
+  explicit SkeletonDerivatives(const SkeletonPtr& skeleton);
+
+  /// Destructor
+  ~SkeletonDerivatives();
+
+  /// Sets the Skeleton. Returns false and leaves this object empty if the
+  /// Skeleton contains SoftBodyNodes. The topology is captured here; call this
+  /// again after changing the structure of the Skeleton.
+  bool setSkeleton(const SkeletonPtr& skeleton);
+
+  /// Returns the Skeleton
+  const SkeletonPtr& getSkeleton() const;
+
+  /// Computes the derivatives of the joint forces of
+  /// Skeleton::computeInverseDynamics() with the same arguments with respect to
+  /// the positions and the velocities, at the current positions, velocities,
+  /// and accelerations of the Skeleton.
+  void computeInverseDynamicsDerivatives(
+      bool withExternalForces = false,
+      bool withDampingForces = false,
+      bool withSpringForces = false);
+
+  /// Returns the derivative of the joint forces with respect to the positions
+  /// computed by the last call to computeInverseDynamicsDerivatives()
+  const Eigen::MatrixXd& getForcesPositionDerivatives() const;
+
+  /// Returns the derivative of the joint forces with respect to the velocities
+  /// computed by the last call to computeInverseDynamicsDerivatives()
+  const Eigen::MatrixXd& getForcesVelocityDerivatives() const;
+
+  /// Calls Skeleton::computeForwardDynamics() and computes the derivatives of
+  /// the resulting accelerations with respect to the positions, the
+  /// velocities, and the joint forces. The implicit joint damping, spring, and
+  /// servo terms of the forward dynamics are included. Returns false if a
+  /// Joint has an ACCELERATION, VELOCITY, or LOCKED actuator, which is not
+  /// supported.
+  ///
+  /// This calls computeInverseDynamicsDerivatives(true, true, true) at the
+  /// resulting accelerations, so the inverse dynamics derivatives are
+  /// overwritten.
+  bool computeForwardDynamicsDerivatives();
+
+  /// Returns the derivative of the accelerations with respect to the positions
+  /// computed by computeForwardDynamicsDerivatives()
+  const Eigen::MatrixXd& getAccelerationsPositionDerivatives() const;
+
+  /// Returns the derivative of the accelerations with respect to the
+  /// velocities computed by computeForwardDynamicsDerivatives()
+  const Eigen::MatrixXd& getAccelerationsVelocityDerivatives() const;
+
+  /// Returns the derivative of the accelerations with respect to the joint
+  /// forces computed by computeForwardDynamicsDerivatives(). This is the
+  /// inverse of the mass matrix augmented by the implicit joint terms. For
+  /// Joints that are not FORCE actuated, the columns are the derivatives with
+  /// respect to an additional generalized force.
+  const Eigen::MatrixXd& getAccelerationsForceDerivatives() const;
+
+protected:
+  /// Recursion data of one BodyNode and its parent Joint
+  struct BodyData
+  {
+    /// Index of the parent BodyNode, or -1 for a root BodyNode
+    int mParentIndex;
+
+    /// Number of DOFs of the parent Joint
+    std::size_t mNumDofs;
+
+    /// Index of the first DOF of the parent Joint in the Skeleton
+    std::size_t mDofIndex;
+
+    /// Whether the relative Jacobian of the parent Joint is independent of its
+    /// positions
+    bool mHasConstantJacobian;
+
+    /// Relative transform of the parent Joint
+    Eigen::Isometry3d mT;
+
+    /// Relative Jacobian of the parent Joint
+    math::Jacobian mS;
+
+    /// Time derivative of the relative Jacobian of the parent Joint
+    math::Jacobian mdS;
+
+    /// Velocities of the parent Joint
+    Eigen::VectorXd mdq;
+
+    /// Accelerations of the parent Joint
+    Eigen::VectorXd mddq;
+
+    /// Spatial inertia
+    Eigen::Matrix6d mI;
+
+    /// Spatial velocity
+    Eigen::Vector6d mV;
+
+    /// Spatial velocity of the parent expressed in this frame
+    Eigen::Vector6d mParentV;
+
+    /// Partial acceleration, i.e., ad(V, S * dq) + dS * dq
+    Eigen::Vector6d mEta;
+
+    /// Spatial acceleration
+    Eigen::Vector6d mA;
+
+    /// Spatial acceleration of the parent expressed in this frame
+    Eigen::Vector6d mParentA;
+
+    /// Gravity expressed in this frame as a spatial acceleration
+    Eigen::Vector6d mG;
+
+    /// Whether gravity acts on this BodyNode
+    bool mGravityMode;
+
+    /// Transmitted body force
+    Eigen::Vector6d mF;
+
+    /// Derivatives of the relative Jacobian with respect to each position of
+    /// the parent Joint. Empty if the Jacobian is constant.
+    std::vector<math::Jacobian> mSDerivs;
+
+    /// Derivatives of dS * dq with respect to each position of the parent
+    /// Joint. Empty if the Jacobian is constant.
+    common::aligned_vector<Eigen::Vector6d> mdSdqDerivs;
+
+    /// Derivative of the spatial velocity in the current direction
+    Eigen::Vector6d mDV;
+
+    /// Derivative of the gravity in the current direction
+    Eigen::Vector6d mDG;
+
+    /// Derivative of the spatial acceleration in the current direction
+    Eigen::Vector6d mDA;
+
+    /// Derivative of the transmitted body force in the current direction
+    Eigen::Vector6d mDF;
+
+    /// Whether the kinematic derivatives are nonzero in the current direction
+    bool mIsAffected;
+
+    /// Whether the force derivative is nonzero in the current direction
+    bool mHasForceDeriv;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  /// Reads the recursion data from the Skeleton and computes the transmitted
+  /// body forces
+  void gather(bool withExternalForces);
+
+  /// Propagates the derivative with respect to the local DOF dof of the
+  /// parent Joint of BodyNode index through the recursion and writes the
+  /// derivative of the joint forces into column
+  void propagate(
+      std::size_t index,
+      std::size_t dof,
+      bool wrtPositions,
+      Eigen::Ref<Eigen::VectorXd> column);
+
+  /// Adds the derivatives of the joint damping, spring, and servo forces
+  /// computed from the current state to dtauDq and dtauDdq
+  void addJointForceDerivatives(
+      bool withDampingForces,
+      bool withSpringForces,
+      Eigen::MatrixXd& dtauDq,
+      Eigen::MatrixXd& dtauDdq) const;
+
+  /// Skeleton
+  SkeletonPtr mSkeleton;
+
+  /// Recursion data of the BodyNodes in the order of the Skeleton
+  common::aligned_vector<BodyData> mBodies;
+
+  /// Derivative of the joint forces with respect to the positions
+  Eigen::MatrixXd mDtauDq;
+
+  /// Derivative of the joint forces with respect to the velocities
+  Eigen::MatrixXd mDtauDdq;
+
+  /// Derivative of the accelerations with respect to the positions
+  Eigen::MatrixXd mDddqDq;
+
+  /// Derivative of the accelerations with respect to the velocities
+  Eigen::MatrixXd mDddqDdq;
+
+  /// Derivative of the accelerations with respect to the joint forces
+  Eigen::MatrixXd mDddqDtau;
+
+  /// Scratch buffer for the augmented mass matrix
+  Eigen::MatrixXd mAugM;
+};
+
+} // namespace dynamics
+} // namespace dart
+
+#endif // DART_DYNAMICS_SKELETONDERIVATIVES_HPP_
@@ -48,6 +48,43 @@
 namespace dart {
 namespace dynamics {
 
+namespace {
+
+//==============================================================================
+/// Add the articulated inertia of point masses with scalar articulated
+/// inertias _pi located at _x to the articulated body inertia _AI.
+///
+/// Each point mass contributes
+///   [ -pi*[x]*[x]  pi*[x] ]
+///   [ -pi*[x]      pi*1   ],
+/// which is summed over all the point masses at once using
+/// [x]*[x] = x*x^T - (x^T*x)*1.
+void addPointMassArtInertia(Eigen::Matrix6d& _AI,
+                            const std::vector<Eigen::Vector3d>& _x,
+                            const std::vector<double>& _pi)
+{
+  double sumPi = 0.0;
+  Eigen::Vector3d sumPiX = Eigen::Vector3d::Zero();
+  Eigen::Matrix3d sumPiXXt = Eigen::Matrix3d::Zero();
+
+  for (std::size_t i = 0u; i < _pi.size(); ++i)
+  {
+    sumPi += _pi[i];
+    sumPiX.noalias() += _pi[i] * _x[i];
+    sumPiXXt.noalias() += (_pi[i] * _x[i]) * _x[i].transpose();
+  }
+
+  const Eigen::Matrix3d skewSumPiX = math::makeSkewSymmetric(sumPiX);
+
+  _AI.topLeftCorner<3, 3>() -= sumPiXXt;
+  _AI.topLeftCorner<3, 3>().diagonal().array() += sumPiXXt.trace();
+  _AI.topRightCorner<3, 3>() += skewSumPiX;
+  _AI.bottomLeftCorner<3, 3>() -= skewSumPiX;
+  _AI.bottomRightCorner<3, 3>().diagonal().array() += sumPi;
+}
+
+} // namespace
+
 namespace detail {
 
 //==============================================================================
@@ -118,6 +155,33 @@ SoftBodyNodeProperties::SoftBodyNodeProperties(
 
 } // namespace detail
 
+//==============================================================================
+SoftBodyNode::PointMassData::PointMassData()
+  : mNeedNeighborsUpdate(true)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void SoftBodyNode::PointMassData::resize(std::size_t _numPointMasses)
+{
+  mX.resize(_numPointMasses, Eigen::Vector3d::Zero());
+  mW.resize(_numPointMasses, Eigen::Vector3d::Zero());
+  mV.resize(_numPointMasses, Eigen::Vector3d::Zero());
+  mEta.resize(_numPointMasses, Eigen::Vector3d::Zero());
+  mA.resize(_numPointMasses, Eigen::Vector3d::Zero());
+  mF.resize(_numPointMasses, Eigen::Vector3d::Zero());
+  mB.resize(_numPointMasses, Eigen::Vector3d::Zero());
+  mFext.resize(_numPointMasses, Eigen::Vector3d::Zero());
+  mAlpha.resize(_numPointMasses, Eigen::Vector3d::Zero());
+  mBeta.resize(_numPointMasses, Eigen::Vector3d::Zero());
+  mPsi.resize(_numPointMasses, 0.0);
+  mImplicitPsi.resize(_numPointMasses, 0.0);
+  mPi.resize(_numPointMasses, 0.0);
+  mImplicitPi.resize(_numPointMasses, 0.0);
+  mNeedNeighborsUpdate = true;
+}
+
 //==============================================================================
 SoftBodyNode::~SoftBodyNode()
 {
@@ -286,6 +350,9 @@ void SoftBodyNode::configurePointMasses(ShapeNode* softNode)
   std::size_t newCount = softProperties.mPointProps.size();
   std::size_t oldCount = mPointMasses.size();
 
+  // The connectivity might have changed even if the count did not
+  mPointData.mNeedNeighborsUpdate = true;
+
   if(newCount == oldCount)
     return;
 
@@ -311,6 +378,9 @@ void SoftBodyNode::configurePointMasses(ShapeNode* softNode)
   mAspectState.mPointStates.resize(
         softProperties.mPointProps.size(), PointMass::State());
 
+  // Resize the per point mass caches
+  mPointData.resize(newCount);
+
   // Access the SoftMeshShape and reallocate its meshes
   if(softNode)
   {
@@ -339,6 +409,30 @@ void SoftBodyNode::configurePointMasses(ShapeNode* softNode)
   mNotifier->dirtyTransform();
 }
 
+//==============================================================================
+void SoftBodyNode::integratePointMassPositions(double _dt)
+{
+  if(mPointMasses.empty())
+    return;
+
+  for (auto& state : mAspectState.mPointStates)
+    state.mPositions.noalias() += _dt * state.mVelocities;
+
+  mNotifier->dirtyTransform();
+}
+
+//==============================================================================
+void SoftBodyNode::integratePointMassVelocities(double _dt)
+{
+  if(mPointMasses.empty())
+    return;
+
+  for (auto& state : mAspectState.mPointStates)
+    state.mVelocities.noalias() += _dt * state.mAccelerations;
+
+  mNotifier->dirtyVelocity();
+}
+
 //==============================================================================
 void SoftBodyNode::init(const SkeletonPtr& _skeleton)
 {
@@ -385,6 +479,26 @@ void SoftBodyNode::init(const SkeletonPtr& _skeleton)
 //  }
 //}
 
+//==============================================================================
+const std::vector<Eigen::Vector3d>&
+SoftBodyNode::getPointMassLocalPositions() const
+{
+  if(mNotifier->needsTransformUpdate())
+    const_cast<SoftBodyNode*>(this)->updateTransform();
+
+  return mPointData.mX;
+}
+
+//==============================================================================
+const std::vector<Eigen::Vector3d>&
+SoftBodyNode::getPointMassWorldPositions() const
+{
+  if(mNotifier->needsTransformUpdate())
+    const_cast<SoftBodyNode*>(this)->updateTransform();
+
+  return mPointData.mW;
+}
+
 //==============================================================================
 PointMassNotifier* SoftBodyNode::getNotifier()
 {
@@ -402,8 +516,8 @@ double SoftBodyNode::getMass() const
 {
   double totalMass = BodyNode::getMass();
 
-  for (std::size_t i = 0; i < mPointMasses.size(); ++i)
-    totalMass += mPointMasses.at(i)->getMass();
+  for (const auto& pointProps : mAspectProperties.mPointProps)
+    totalMass += pointProps.mMass;
 
   return totalMass;
 }
@@ -465,7 +579,6 @@ double SoftBodyNode::getDampingCoefficient() const
 //==============================================================================
 void SoftBodyNode::removeAllPointMasses()
 {
-  mPointMasses.clear();
   mAspectProperties.mPointProps.clear();
   mAspectProperties.mFaces.clear();
   configurePointMasses(mSoftShapeNode.lock());
@@ -474,8 +587,6 @@ void SoftBodyNode::removeAllPointMasses()
 //==============================================================================
 PointMass* SoftBodyNode::addPointMass(const PointMass::Properties& _properties)
 {
-  mPointMasses.push_back(new PointMass(this));
-  mPointMasses.back()->mIndex = mPointMasses.size()-1;
   mAspectProperties.mPointProps.push_back(_properties);
   configurePointMasses(mSoftShapeNode.lock());
 
@@ -518,8 +629,8 @@ void SoftBodyNode::clearConstraintImpulse()
 {
   BodyNode::clearConstraintImpulse();
 
-  for (std::size_t i = 0; i < mPointMasses.size(); ++i)
-    mPointMasses.at(i)->clearConstraintImpulse();
+  for (auto& pointMass : mPointMasses)
+    pointMass->clearConstraintImpulse();
 }
 
 //==============================================================================
@@ -530,13 +641,54 @@ void SoftBodyNode::checkArticulatedInertiaUpdate() const
     skel->updateArticulatedInertia(mTreeIndex);
 }
 
+//==============================================================================
+void SoftBodyNode::updatePointMassNeighbors() const
+{
+  if (!mPointData.mNeedNeighborsUpdate)
+    return;
+
+  const auto& props = mAspectProperties.mPointProps;
+  const std::size_t numPointMasses = props.size();
+
+  mPointData.mNeighborOffsets.resize(numPointMasses + 1u);
+  mPointData.mNeighbors.clear();
+
+  for (std::size_t i = 0u; i < numPointMasses; ++i)
+  {
+    mPointData.mNeighborOffsets[i] = mPointData.mNeighbors.size();
+    mPointData.mNeighbors.insert(
+          mPointData.mNeighbors.end(),
+          props[i].mConnectedPointMassIndices.begin(),
+          props[i].mConnectedPointMassIndices.end());
+  }
+  mPointData.mNeighborOffsets[numPointMasses] = mPointData.mNeighbors.size();
+
+  mPointData.mNeedNeighborsUpdate = false;
+}
+
 //==============================================================================
 void SoftBodyNode::updateTransform()
 {
   BodyNode::updateTransform();
 
-  for (std::size_t i = 0; i < mPointMasses.size(); ++i)
-    mPointMasses.at(i)->updateTransform();
+  const auto& states = mAspectState.mPointStates;
+  const auto& props = mAspectProperties.mPointProps;
+  const Eigen::Isometry3d& W = getWorldTransform();
+  const Eigen::Matrix3d R = W.linear();
+  const Eigen::Vector3d p = W.translation();
+
+  for (std::size_t i = 0u; i < mPointMasses.size(); ++i)
+  {
+    // Local translation
+    Eigen::Vector3d& X = mPointData.mX[i];
+    X = states[i].mPositions + props[i].mX0;
+    assert(!math::isNan(X));
+
+    // World translation
+    mPointData.mW[i] = p;
+    mPointData.mW[i].noalias() += R * X;
+    assert(!math::isNan(mPointData.mW[i]));
+  }
 
   mNotifier->clearTransformNotice();
 }
@@ -546,8 +698,18 @@ void SoftBodyNode::updateVelocity()
 {
   BodyNode::updateVelocity();
 
-  for (std::size_t i = 0; i < mPointMasses.size(); ++i)
-    mPointMasses.at(i)->updateVelocity();
+  const auto& states = mAspectState.mPointStates;
+  const auto& X = getPointMassLocalPositions();
+  const Eigen::Vector6d& V = getSpatialVelocity();
+  const Eigen::Vector3d w = V.head<3>();
+  const Eigen::Vector3d v = V.tail<3>();
+
+  // v = w(parent) x mX + v(parent) + dq
+  for (std::size_t i = 0u; i < mPointMasses.size(); ++i)
+  {
+    mPointData.mV[i] = w.cross(X[i]) + v + states[i].mVelocities;
+    assert(!math::isNan(mPointData.mV[i]));
+  }
 
   mNotifier->clearVelocityNotice();
 }
@@ -557,8 +719,15 @@ void SoftBodyNode::updatePartialAcceleration() const
 {
   BodyNode::updatePartialAcceleration();
 
-  for (std::size_t i = 0; i < mPointMasses.size(); ++i)
-    mPointMasses.at(i)->updatePartialAcceleration();
+  const auto& states = mAspectState.mPointStates;
+  const Eigen::Vector3d w = getSpatialVelocity().head<3>();
+
+  // eta = w(parent) x dq
+  for (std::size_t i = 0u; i < mPointMasses.size(); ++i)
+  {
+    mPointData.mEta[i] = w.cross(states[i].mVelocities);
+    assert(!math::isNan(mPointData.mEta[i]));
+  }
 
   mNotifier->clearPartialAccelerationNotice();
 }
@@ -568,8 +737,22 @@ void SoftBodyNode::updateAccelerationID()
 {
   BodyNode::updateAccelerationID();
 
-  for (std::size_t i = 0; i < mPointMasses.size(); ++i)
-    mPointMasses.at(i)->updateAccelerationID();
+  if (mNotifier->needsPartialAccelerationUpdate())
+    updatePartialAcceleration();
+
+  const auto& states = mAspectState.mPointStates;
+  const auto& X = getPointMassLocalPositions();
+  const Eigen::Vector6d& A = getSpatialAcceleration();
+  const Eigen::Vector3d dw = A.head<3>();
+  const Eigen::Vector3d dv = A.tail<3>();
+
+  // dv = dw(parent) x mX + dv(parent) + eata + ddq
+  for (std::size_t i = 0u; i < mPointMasses.size(); ++i)
+  {
+    mPointData.mA[i] = dw.cross(X[i]) + dv + mPointData.mEta[i]
+                       + states[i].mAccelerations;
+    assert(!math::isNan(mPointData.mA[i]));
+  }
 
   mNotifier->clearAccelerationNotice();
 }
@@ -580,8 +763,29 @@ void SoftBodyNode::updateTransmittedForceID(const Eigen::Vector3d& _gravity,
 {
   const Eigen::Matrix6d& mI =
       BodyNode::mAspectProperties.mInertia.getSpatialTensor();
-  for (auto& pointMass : mPointMasses)
-    pointMass->updateTransmittedForceID(_gravity, _withExternalForces);
+
+  if (mNotifier->needsVelocityUpdate())
+    updateVelocity();
+  if (mNotifier->needsAccelerationUpdate())
+    updateAccelerationID();
+
+  // f = m*dv + w(parent) x m*v - fext - fgravity
+  const auto& props = mAspectProperties.mPointProps;
+  const Eigen::Vector3d w = getSpatialVelocity().head<3>();
+  const bool gravityMode = BodyNode::mAspectProperties.mGravityMode;
+  const Eigen::Vector3d localGravity
+      = getWorldTransform().linear().transpose() * _gravity;
+  for (std::size_t i = 0u; i < mPointMasses.size(); ++i)
+  {
+    const double mass = props[i].mMass;
+    Eigen::Vector3d& f = mPointData.mF[i];
+
+    f.noalias() = mass * mPointData.mA[i];
+    f += w.cross(mass * mPointData.mV[i]) - mPointData.mFext[i];
+    if (gravityMode)
+      f -= mass * localGravity;
+    assert(!math::isNan(f));
+  }
 
   // Gravity force
   if (BodyNode::mAspectProperties.mGravityMode == true)
@@ -615,10 +819,11 @@ void SoftBodyNode::updateTransmittedForceID(const Eigen::Vector3d& _gravity,
     mF += math::dAdInvT(childJoint->getRelativeTransform(),
                         childBodyNode->getBodyForce());
   }
-  for (auto& pointMass : mPointMasses)
+  const auto& X = getPointMassLocalPositions();
+  for (std::size_t i = 0u; i < mPointMasses.size(); ++i)
   {
-    mF.head<3>() += pointMass->getLocalPosition().cross(pointMass->mF);
-    mF.tail<3>() += pointMass->mF;
+    mF.head<3>() += X[i].cross(mPointData.mF[i]);
+    mF.tail<3>() += mPointData.mF[i];
   }
 
   // Verification
@@ -630,10 +835,11 @@ void SoftBodyNode::updateJointForceID(double _timeStep,
                                       bool _withDampingForces,
                                       bool _withSpringForces)
 {
-  for (std::size_t i = 0; i < mPointMasses.size(); ++i)
-    mPointMasses.at(i)->updateJointForceID(_timeStep,
-                                           _withDampingForces,
-                                           _withSpringForces);
+  // tau = f
+  // TODO: need to add spring and damping forces
+  auto& states = mAspectState.mPointStates;
+  for (std::size_t i = 0u; i < mPointMasses.size(); ++i)
+    states[i].mForces = mPointData.mF[i];
 
   BodyNode::updateJointForceID(_timeStep,
                                _withDampingForces,
@@ -661,8 +867,28 @@ void SoftBodyNode::updateArtInertia(double _timeStep) const
 {
   const Eigen::Matrix6d& mI =
       BodyNode::mAspectProperties.mInertia.getSpatialTensor();
-  for (auto& pointMass : mPointMasses)
-    pointMass->updateArtInertiaFD(_timeStep);
+
+  // Articulated inertia of the point masses
+  // - PsiK and Psi
+  // - Pi
+  const auto& props = mAspectProperties.mPointProps;
+  const double kd = getDampingCoefficient();
+  const double kv = getVertexSpringStiffness();
+  for (std::size_t i = 0u; i < mPointMasses.size(); ++i)
+  {
+    const double mass = props[i].mMass;
+    const double psi = 1.0 / mass;
+    const double implicitPsi
+        = 1.0 / (mass + _timeStep * kd + _timeStep * _timeStep * kv);
+    assert(!math::isNan(implicitPsi));
+
+    mPointData.mPsi[i] = psi;
+    mPointData.mImplicitPsi[i] = implicitPsi;
+    mPointData.mPi[i] = mass - mass * mass * psi;
+    mPointData.mImplicitPi[i] = mass - mass * mass * implicitPsi;
+    assert(!math::isNan(mPointData.mPi[i]));
+    assert(!math::isNan(mPointData.mImplicitPi[i]));
+  }
 
   assert(mParentJoint != nullptr);
 
@@ -681,12 +907,9 @@ void SoftBodyNode::updateArtInertia(double _timeStep) const
   }
 
   //
-  for (const auto& pointMass : mPointMasses)
-  {
-    _addPiToArtInertia(pointMass->getLocalPosition(), pointMass->mPi);
-    _addPiToArtInertiaImplicit(pointMass->getLocalPosition(),
-                               pointMass->mImplicitPi);
-  }
+  const auto& X = getPointMassLocalPositions();
+  addPointMassArtInertia(mArtInertia, X, mPointData.mPi);
+  addPointMassArtInertia(mArtInertiaImplicit, X, mPointData.mImplicitPi);
 
   // Verification
   assert(!math::isNan(mArtInertia));
@@ -707,8 +930,61 @@ void SoftBodyNode::updateBiasForce(const Eigen::Vector3d& _gravity,
 {
   const Eigen::Matrix6d& mI =
       BodyNode::mAspectProperties.mInertia.getSpatialTensor();
-  for (auto& pointMass : mPointMasses)
-    pointMass->updateBiasForceFD(_timeStep, _gravity);
+
+  if (mNotifier->needsVelocityUpdate())
+    updateVelocity();
+  if (mNotifier->needsPartialAccelerationUpdate())
+    updatePartialAcceleration();
+  checkArticulatedInertiaUpdate();
+  updatePointMassNeighbors();
+
+  const auto& states = mAspectState.mPointStates;
+  const auto& props = mAspectProperties.mPointProps;
+  const auto& offsets = mPointData.mNeighborOffsets;
+  const auto& neighbors = mPointData.mNeighbors;
+  const Eigen::Vector3d w = getSpatialVelocity().head<3>();
+  const bool gravityMode = BodyNode::mAspectProperties.mGravityMode;
+  const Eigen::Vector3d localGravity
+      = getWorldTransform().linear().transpose() * _gravity;
+  const double kv = getVertexSpringStiffness();
+  const double ke = getEdgeSpringStiffness();
+  const double kd = getDampingCoefficient();
+
+  for (std::size_t i = 0u; i < mPointMasses.size(); ++i)
+  {
+    const double mass = props[i].mMass;
+    const PointMass::State& state = states[i];
+
+    // B = w(parent) x m*v - fext - fgravity
+    Eigen::Vector3d& B = mPointData.mB[i];
+    B = w.cross(mass * mPointData.mV[i]) - mPointData.mFext[i];
+    if (gravityMode)
+      B -= mass * localGravity;
+    assert(!math::isNan(B));
+
+    // Cache data: alpha
+    const std::size_t numNeighbors = offsets[i + 1u] - offsets[i];
+    const double k = kv + numNeighbors * ke;
+    Eigen::Vector3d& alpha = mPointData.mAlpha[i];
+    alpha = state.mForces
+            - k * state.mPositions
+            - (_timeStep * k + kd) * state.mVelocities
+            - mass * mPointData.mEta[i]
+            - B;
+    for (std::size_t j = offsets[i]; j < offsets[i + 1u]; ++j)
+    {
+      const PointMass::State& neighbor = states[neighbors[j]];
+      alpha += ke * (neighbor.mPositions + _timeStep * neighbor.mVelocities);
+    }
+    assert(!math::isNan(alpha));
+
+    // Cache data: beta
+    Eigen::Vector3d& beta = mPointData.mBeta[i];
+    beta = B;
+    beta.noalias() += mass * (mPointData.mEta[i]
+                              + mPointData.mImplicitPsi[i] * alpha);
+    assert(!math::isNan(beta));
+  }
 
   // Gravity force
   if (BodyNode::mAspectProperties.mGravityMode == true)
@@ -735,10 +1011,11 @@ void SoftBodyNode::updateBiasForce(const Eigen::Vector3d& _gravity,
   }
 
   //
-  for (const auto& pointMass : mPointMasses)
+  const auto& X = getPointMassLocalPositions();
+  for (std::size_t i = 0u; i < mPointMasses.size(); ++i)
   {
-    mBiasForce.head<3>() += pointMass->getLocalPosition().cross(pointMass->mBeta);
-    mBiasForce.tail<3>() += pointMass->mBeta;
+    mBiasForce.head<3>() += X[i].cross(mPointData.mBeta[i]);
+    mBiasForce.tail<3>() += mPointData.mBeta[i];
   }
 
   // Verifycation
@@ -756,8 +1033,31 @@ void SoftBodyNode::updateAccelerationFD()
 {
   BodyNode::updateAccelerationFD();
 
-  for (auto& pointMass : mPointMasses)
-    pointMass->updateAccelerationFD();
+  if (mNotifier->needsPartialAccelerationUpdate())
+    updatePartialAcceleration();
+  checkArticulatedInertiaUpdate();
+
+  auto& states = mAspectState.mPointStates;
+  const auto& props = mAspectProperties.mPointProps;
+  const auto& X = getPointMassLocalPositions();
+  const Eigen::Vector6d& A = getSpatialAcceleration();
+  const Eigen::Vector3d dw = A.head<3>();
+  const Eigen::Vector3d dv = A.tail<3>();
+
+  for (std::size_t i = 0u; i < mPointMasses.size(); ++i)
+  {
+    const Eigen::Vector3d parentAcc = dw.cross(X[i]) + dv;
+
+    // ddq = imp_psi*(alpha - m*(dw(parent) x mX + dv(parent))
+    Eigen::Vector3d& ddq = states[i].mAccelerations;
+    ddq = mPointData.mImplicitPsi[i]
+          * (mPointData.mAlpha[i] - props[i].mMass * parentAcc);
+    assert(!math::isNan(ddq));
+
+    // dv = dw(parent) x mX + dv(parent) + eata + ddq
+    mPointData.mA[i] = parentAcc + mPointData.mEta[i] + ddq;
+    assert(!math::isNan(mPointData.mA[i]));
+  }
 
   mNotifier->clearAccelerationNotice();
 }
@@ -767,8 +1067,17 @@ void SoftBodyNode::updateTransmittedForceFD()
 {
   BodyNode::updateTransmittedForceFD();
 
-  for (auto& pointMass : mPointMasses)
-    pointMass->updateTransmittedForce();
+  if (mNotifier->needsAccelerationUpdate())
+    updateAccelerationID();
+
+  // f = m*dv + B
+  const auto& props = mAspectProperties.mPointProps;
+  for (std::size_t i = 0u; i < mPointMasses.size(); ++i)
+  {
+    mPointData.mF[i] = mPointData.mB[i];
+    mPointData.mF[i].noalias() += props[i].mMass * mPointData.mA[i];
+    assert(!math::isNan(mPointData.mF[i]));
+  }
 }
 
 //==============================================================================
@@ -1183,11 +1492,11 @@ void SoftBodyNode::aggregateExternalForces(Eigen::VectorXd& _Fext)
                              (*it)->mFext_F);
   }
 
-  for (std::vector<PointMass*>::iterator it = mPointMasses.begin();
-       it != mPointMasses.end(); ++it)
+  const auto& X = getPointMassLocalPositions();
+  for (std::size_t i = 0u; i < mPointMasses.size(); ++i)
   {
-    mFext_F.head<3>() += (*it)->getLocalPosition().cross((*it)->mFext);
-    mFext_F.tail<3>() += (*it)->mFext;
+    mFext_F.head<3>() += X[i].cross(mPointData.mFext[i]);
+    mFext_F.tail<3>() += mPointData.mFext[i];
   }
 
   int nGenCoords = mParentJoint->getNumDofs();
@@ -1205,8 +1514,8 @@ void SoftBodyNode::clearExternalForces()
 {
   BodyNode::clearExternalForces();
 
-  for (std::size_t i = 0; i < mPointMasses.size(); ++i)
-    mPointMasses.at(i)->clearExtForce();
+  for (auto& fext : mPointData.mFext)
+    fext.setZero();
 }
 
 //==============================================================================
@@ -1218,35 +1527,6 @@ void SoftBodyNode::clearInternalForces()
     mPointMasses[i]->resetForces();
 }
 
-//==============================================================================
-void SoftBodyNode::_addPiToArtInertia(const Eigen::Vector3d& _p, double _Pi) const
-{
-  Eigen::Matrix3d tmp = math::makeSkewSymmetric(_p);
-
-  mArtInertia.topLeftCorner<3, 3>()    -= _Pi * tmp * tmp;
-  mArtInertia.topRightCorner<3, 3>()   += _Pi * tmp;
-  mArtInertia.bottomLeftCorner<3, 3>() -= _Pi * tmp;
-
-  mArtInertia(3, 3) += _Pi;
-  mArtInertia(4, 4) += _Pi;
-  mArtInertia(5, 5) += _Pi;
-}
-
-//==============================================================================
-void SoftBodyNode::_addPiToArtInertiaImplicit(const Eigen::Vector3d& _p,
-                                              double _ImplicitPi) const
-{
-  Eigen::Matrix3d tmp = math::makeSkewSymmetric(_p);
-
-  mArtInertiaImplicit.topLeftCorner<3, 3>()    -= _ImplicitPi * tmp * tmp;
-  mArtInertiaImplicit.topRightCorner<3, 3>()   += _ImplicitPi * tmp;
-  mArtInertiaImplicit.bottomLeftCorner<3, 3>() -= _ImplicitPi * tmp;
-
-  mArtInertiaImplicit(3, 3) += _ImplicitPi;
-  mArtInertiaImplicit(4, 4) += _ImplicitPi;
-  mArtInertiaImplicit(5, 5) += _ImplicitPi;
-}
-
 //==============================================================================
 void SoftBodyNode::updateInertiaWithPointMass()
 {
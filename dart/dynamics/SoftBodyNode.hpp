@@ -136,6 +136,14 @@ public:
   /// Return all the point masses in this SoftBodyNode
   const std::vector<PointMass*>& getPointMasses() const;
 
+  /// Return the positions of all the point masses, viewed in the frame of this
+  /// SoftBodyNode, as one contiguous array indexed by point mass index
+  const std::vector<Eigen::Vector3d>& getPointMassLocalPositions() const;
+
+  /// Return the positions of all the point masses, viewed in the world frame,
+  /// as one contiguous array indexed by point mass index
+  const std::vector<Eigen::Vector3d>& getPointMassWorldPositions() const;
+
   /// \brief
   void connectPointMasses(std::size_t _idx1, std::size_t _idx2);
 
@@ -166,6 +174,12 @@ protected:
   /// SoftMeshShape
   void configurePointMasses(ShapeNode* softNode);
 
+  /// Integrate the positions of all the point masses at once
+  void integratePointMassPositions(double _dt);
+
+  /// Integrate the velocities of all the point masses at once
+  void integratePointMassVelocities(double _dt);
+
   //--------------------------------------------------------------------------
   // Sub-functions for Recursive Kinematics Algorithms
   //--------------------------------------------------------------------------
@@ -185,6 +199,10 @@ protected:
   /// Update articulated inertia if necessary
   void checkArticulatedInertiaUpdate() const;
 
+  /// Rebuild the edge spring adjacency in mPointData if the connectivity of
+  /// the point masses has changed
+  void updatePointMassNeighbors() const;
+
   // Documentation inherited.
   void updateTransform() override;
 
@@ -299,6 +317,75 @@ protected:
   /// \brief List of point masses composing deformable mesh.
   std::vector<PointMass*> mPointMasses;
 
+  /// Caches of the recursive dynamics routines for all the point masses,
+  /// stored as one contiguous array per quantity and indexed by point mass
+  /// index, so that each routine runs over the point masses in a single tight
+  /// loop instead of calling into every PointMass.
+  struct PointMassData
+  {
+    /// Positions viewed in this SoftBodyNode frame
+    std::vector<Eigen::Vector3d> mX;
+
+    /// Positions viewed in the world frame
+    std::vector<Eigen::Vector3d> mW;
+
+    /// Velocities viewed in this SoftBodyNode frame
+    std::vector<Eigen::Vector3d> mV;
+
+    /// Partial accelerations
+    std::vector<Eigen::Vector3d> mEta;
+
+    /// Accelerations viewed in this SoftBodyNode frame
+    std::vector<Eigen::Vector3d> mA;
+
+    /// Transmitted forces
+    std::vector<Eigen::Vector3d> mF;
+
+    /// Bias forces
+    std::vector<Eigen::Vector3d> mB;
+
+    /// External forces viewed in this SoftBodyNode frame
+    std::vector<Eigen::Vector3d> mFext;
+
+    ///
+    std::vector<Eigen::Vector3d> mAlpha;
+
+    ///
+    std::vector<Eigen::Vector3d> mBeta;
+
+    ///
+    std::vector<double> mPsi;
+
+    ///
+    std::vector<double> mImplicitPsi;
+
+    ///
+    std::vector<double> mPi;
+
+    ///
+    std::vector<double> mImplicitPi;
+
+    /// Edge springs in compressed row form. The point masses connected to
+    /// point mass i are mNeighbors[mNeighborOffsets[i]] up to (excluding)
+    /// mNeighbors[mNeighborOffsets[i + 1]].
+    std::vector<std::size_t> mNeighborOffsets;
+
+    ///
+    std::vector<std::size_t> mNeighbors;
+
+    /// Whether mNeighborOffsets and mNeighbors need to be rebuilt
+    bool mNeedNeighborsUpdate;
+
+    /// Constructor
+    PointMassData();
+
+    /// Resize all the arrays to hold _numPointMasses point masses
+    void resize(std::size_t _numPointMasses);
+  };
+
+  /// Per point mass caches
+  mutable PointMassData mPointData;
+
   /// An Entity which tracks when the point masses need to be updated
   PointMassNotifier* mNotifier;
 
@@ -315,13 +402,6 @@ protected:
   math::Inertia mArtInertiaImplicit2;
 
 private:
-  /// \brief
-  void _addPiToArtInertia(const Eigen::Vector3d& _p, double _Pi) const;
-
-  /// \brief
-  void _addPiToArtInertiaImplicit(const Eigen::Vector3d& _p,
-                                  double _ImplicitPi) const;
-
   ///
   void updateInertiaWithPointMass();
 };
@@ -142,15 +142,13 @@ void SoftMeshShape::_buildMesh()
 
 void SoftMeshShape::update()
 {
-  std::size_t nVertices = mSoftBodyNode->getNumPointMasses();
+  const std::vector<Eigen::Vector3d>& vertices
+      = mSoftBodyNode->getPointMassLocalPositions();
 
-  aiVector3D itAIVector3d;
-  for (std::size_t i = 0; i < nVertices; ++i)
+  for (std::size_t i = 0; i < vertices.size(); ++i)
   {
-    PointMass* itPointMass        = mSoftBodyNode->getPointMass(i);
-    const Eigen::Vector3d& vertex = itPointMass->getLocalPosition();
-    itAIVector3d.Set(vertex[0], vertex[1], vertex[2]);
-    mAssimpMesh->mVertices[i] = itAIVector3d;
+    const Eigen::Vector3d& vertex = vertices[i];
+    mAssimpMesh->mVertices[i].Set(vertex[0], vertex[1], vertex[2]);
   }
 }
 
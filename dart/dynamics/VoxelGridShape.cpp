@@ -34,7 +34,10 @@
 
 #if HAVE_OCTOMAP
 
+#include <algorithm>
+
 #include "dart/common/Console.hpp"
+#include "dart/common/detail/ParallelFor.hpp"
 #include "dart/math/Helpers.hpp"
 
 namespace dart {
@@ -62,16 +65,88 @@ octomap::pose6d toPose6d(const Eigen::Isometry3d& frame)
       toPoint3d(frame.translation()), toQuaternion(frame.linear()));
 }
 
+//==============================================================================
+Eigen::Vector3d toVector3d(const octomap::point3d& point)
+{
+  return Eigen::Vector3d(point.x(), point.y(), point.z());
+}
+
+//==============================================================================
+/// Voxels to update for a single point cloud, and the region they lie in.
+struct PointCloudUpdate
+{
+  octomap::KeySet mFreeCells;
+  octomap::KeySet mOccupiedCells;
+  Eigen::Vector3d mMin;
+  Eigen::Vector3d mMax;
+};
+
+//==============================================================================
+/// Casts the rays of pointCloud in the same way as
+/// octomap::OccupancyOcTreeBase::computeUpdate(), but only through const
+/// queries of the octree so that several point clouds can be processed
+/// concurrently.
+void computePointCloudUpdate(
+    const octomap::OcTree& octree,
+    const octomap::Pointcloud& pointCloud,
+    const Eigen::Vector3d& sensorOrigin,
+    const octomap::pose6d& frameOrigin,
+    double maxRange,
+    PointCloudUpdate& update)
+{
+  // Transform with octomap's own (single precision) arithmetic so that the
+  // result is identical to octomap::OcTree::insertPointCloud().
+  const octomap::point3d origin
+      = frameOrigin.transform(toPoint3d(sensorOrigin));
+
+  update.mMin = toVector3d(origin);
+  update.mMax = update.mMin;
+
+  octomap::KeyRay ray;
+  for (const auto& localPoint : pointCloud)
+  {
+    const octomap::point3d point = frameOrigin.transform(localPoint);
+
+    octomap::point3d end = point;
+    const bool truncated
+        = maxRange > 0.0 && (point - origin).norm() > maxRange;
+    if (truncated)
+      end = origin + (point - origin).normalized() * maxRange;
+
+    // Free cells along the ray
+    if (octree.computeRayKeys(origin, end, ray))
+      update.mFreeCells.insert(ray.begin(), ray.end());
+
+    // Occupied end point
+    octomap::OcTreeKey key;
+    if (!truncated && octree.coordToKeyChecked(end, key))
+      update.mOccupiedCells.insert(key);
+
+    update.mMin = update.mMin.cwiseMin(toVector3d(end));
+    update.mMax = update.mMax.cwiseMax(toVector3d(end));
+  }
+
+  // Prefer occupied cells over free ones
+  for (const auto& key : update.mOccupiedCells)
+    update.mFreeCells.erase(key);
+}
+
 } // namespace
 
 //==============================================================================
-VoxelGridShape::VoxelGridShape(double resolution) : Shape()
+VoxelGridShape::VoxelGridShape(double resolution)
+  : Shape(),
+    mOccupancyVersion(0u),
+    onOccupancyChanged(mOccupancyChangedSignal)
 {
   setOctree(fcl_make_shared<octomap::OcTree>(resolution));
 }
 
 //==============================================================================
-VoxelGridShape::VoxelGridShape(fcl_shared_ptr<octomap::OcTree> octree) : Shape()
+VoxelGridShape::VoxelGridShape(fcl_shared_ptr<octomap::OcTree> octree)
+  : Shape(),
+    mOccupancyVersion(0u),
+    onOccupancyChanged(mOccupancyChangedSignal)
 {
   if (!octree)
   {
@@ -137,7 +212,7 @@ void VoxelGridShape::updateOccupancy(
 {
   mOctree->updateNode(toPoint3d(point), occupied);
 
-  incrementVersion();
+  notifyOccupancyChanged(point, point);
 }
 
 //==============================================================================
@@ -146,7 +221,7 @@ void VoxelGridShape::updateOccupancy(
 {
   mOctree->insertRay(toPoint3d(from), toPoint3d(to));
 
-  incrementVersion();
+  notifyOccupancyChanged(from.cwiseMin(to), from.cwiseMax(to));
 }
 
 //==============================================================================
@@ -158,7 +233,15 @@ void VoxelGridShape::updateOccupancy(
   if (relativeTo == Frame::World())
   {
     mOctree->insertPointCloud(pointCloud, toPoint3d(sensorOrigin));
-    incrementVersion();
+
+    Eigen::Vector3d min = sensorOrigin;
+    Eigen::Vector3d max = sensorOrigin;
+    for (const auto& point : pointCloud)
+    {
+      min = min.cwiseMin(toVector3d(point));
+      max = max.cwiseMax(toVector3d(point));
+    }
+    notifyOccupancyChanged(min, max);
   }
   else
   {
@@ -175,7 +258,83 @@ void VoxelGridShape::updateOccupancy(
   mOctree->insertPointCloud(
       pointCloud, toPoint3d(sensorOrigin), toPose6d(relativeTo));
 
-  incrementVersion();
+  Eigen::Vector3d min = relativeTo * sensorOrigin;
+  Eigen::Vector3d max = min;
+  for (const auto& point : pointCloud)
+  {
+    const Eigen::Vector3d transformed = relativeTo * toVector3d(point);
+    min = min.cwiseMin(transformed);
+    max = max.cwiseMax(transformed);
+  }
+  notifyOccupancyChanged(min, max);
+}
+
+//==============================================================================
+void VoxelGridShape::updateOccupancy(
+    const std::vector<octomap::Pointcloud>& pointClouds,
+    const std::vector<Eigen::Vector3d>& sensorOrigins,
+    const Eigen::Isometry3d& relativeTo,
+    double maxRange,
+    std::size_t numThreads)
+{
+  if (pointClouds.size() != sensorOrigins.size())
+  {
+    dterr << "[VoxelGridShape::updateOccupancy] The number of point clouds ("
+          << pointClouds.size() << ") and sensor origins ("
+          << sensorOrigins.size() << ") don't match. Ignoring this query.\n";
+    return;
+  }
+
+  if (pointClouds.empty())
+    return;
+
+  // The bounding box limit of the octree is not available through const
+  // queries, so let octomap handle that case one point cloud at a time.
+  const octomap::pose6d frameOrigin = toPose6d(relativeTo);
+  if (mOctree->bbxSet())
+  {
+    for (std::size_t i = 0u; i < pointClouds.size(); ++i)
+    {
+      mOctree->insertPointCloud(
+          pointClouds[i], toPoint3d(sensorOrigins[i]), frameOrigin, maxRange);
+    }
+
+    notifyOccupancyChanged(
+        Eigen::Vector3d::Constant(-mOctree->getNodeSize(0) * 0.5),
+        Eigen::Vector3d::Constant(mOctree->getNodeSize(0) * 0.5));
+    return;
+  }
+
+  // Cast the rays of each point cloud concurrently. This only reads the
+  // octree.
+  std::vector<PointCloudUpdate> updates(pointClouds.size());
+  common::detail::parallelFor(
+      pointClouds.size(), numThreads, [&](std::size_t i)
+  {
+    computePointCloudUpdate(
+        *mOctree, pointClouds[i], sensorOrigins[i], frameOrigin, maxRange,
+        updates[i]);
+  });
+
+  // Apply the updates in order so that the result is the same as inserting
+  // the point clouds one by one, but defer updating the inner nodes.
+  Eigen::Vector3d min = updates.front().mMin;
+  Eigen::Vector3d max = updates.front().mMax;
+  for (const auto& update : updates)
+  {
+    for (const auto& key : update.mFreeCells)
+      mOctree->updateNode(key, false, true);
+
+    for (const auto& key : update.mOccupiedCells)
+      mOctree->updateNode(key, true, true);
+
+    min = min.cwiseMin(update.mMin);
+    max = max.cwiseMax(update.mMax);
+  }
+
+  mOctree->updateInnerOccupancy();
+
+  notifyOccupancyChanged(min, max);
 }
 
 //==============================================================================
@@ -188,6 +347,12 @@ double VoxelGridShape::getOccupancy(const Eigen::Vector3d& point) const
     return 0.0;
 }
 
+//==============================================================================
+std::size_t VoxelGridShape::getOccupancyVersion() const
+{
+  return mOccupancyVersion;
+}
+
 //==============================================================================
 Eigen::Matrix3d VoxelGridShape::computeInertia(double /*mass*/) const
 {
@@ -196,6 +361,19 @@ Eigen::Matrix3d VoxelGridShape::computeInertia(double /*mass*/) const
   return Eigen::Matrix3d::Identity();
 }
 
+//==============================================================================
+void VoxelGridShape::notifyOccupancyChanged(
+    const Eigen::Vector3d& min, const Eigen::Vector3d& max)
+{
+  // Grow the region by half a voxel so that it covers every voxel touched.
+  const Eigen::Vector3d margin
+      = Eigen::Vector3d::Constant(0.5 * mOctree->getResolution());
+
+  ++mOccupancyVersion;
+  mOccupancyChangedSignal.raise(
+      this, math::BoundingBox(min - margin, max + margin));
+}
+
 //==============================================================================
 void VoxelGridShape::updateBoundingBox() const
 {
@@ -37,8 +37,11 @@
 
 #if HAVE_OCTOMAP
 
+#include <vector>
+
 #include <octomap/octomap.h>
 #include "dart/collision/fcl/BackwardCompatibility.hpp"
+#include "dart/common/Signal.hpp"
 #include "dart/dynamics/Frame.hpp"
 #include "dart/dynamics/Shape.hpp"
 
@@ -46,9 +49,18 @@ namespace dart {
 namespace dynamics {
 
 /// VoxelGridShape represents a probabilistic 3D occupancy voxel grid.
+///
+/// Only replacing the octree (setOctree()) increments the version of this
+/// shape. Occupancy updates change the content of the same octree, which
+/// collision geometries built on it read directly, so they don't invalidate
+/// anything derived from the shape. Instead, they increment the occupancy
+/// version and raise onOccupancyChanged with the region that was affected.
 class VoxelGridShape : public Shape
 {
 public:
+  using OccupancyChangedSignal = common::Signal<void(
+      const VoxelGridShape* shape, const math::BoundingBox& region)>;
+
   /// Constructor.
   /// \param[in] resolution Size of voxel. Default is 0.01.
   explicit VoxelGridShape(double resolution = 0.01);
@@ -137,9 +149,38 @@ public:
       const Eigen::Vector3d& sensorOrigin,
       const Eigen::Isometry3d& relativeTo);
 
+  /// Updates the occupancy probability of the voxels given a batch of sensor
+  /// measurements. The resulting occupancies are the same as when inserting
+  /// the point clouds one by one with updateOccupancy(PointCloud, ...).
+  ///
+  /// The rays of all the point clouds are cast on up to \c numThreads threads
+  /// (0 means one per hardware thread). The resulting voxel updates are then
+  /// applied in order, and the inner nodes of the octree are updated once for
+  /// the whole batch. The octree is not pruned afterwards; call
+  /// getOctree()->prune() to compact it if needed.
+  ///
+  /// \param[in] pointClouds Point clouds relative to frame.
+  /// \param[in] sensorOrigins Origin of the sensor of each point cloud
+  /// relative to frame. Must have the same size as \c pointClouds.
+  /// \param[in] relativeTo Reference frame of the point clouds and the sensor
+  /// origins.
+  /// \param[in] maxRange Rays are truncated to this length if positive.
+  /// \param[in] numThreads Number of threads used to cast the rays.
+  void updateOccupancy(
+      const std::vector<octomap::Pointcloud>& pointClouds,
+      const std::vector<Eigen::Vector3d>& sensorOrigins,
+      const Eigen::Isometry3d& relativeTo = Eigen::Isometry3d::Identity(),
+      double maxRange = -1.0,
+      std::size_t numThreads = 0u);
+
   /// Returns occupancy probability of a node that contains \c point.
   double getOccupancy(const Eigen::Vector3d& point) const;
 
+  /// Returns the number of occupancy updates made to this shape. Unlike
+  /// getVersion(), this changes whenever the occupancy of any voxel may have
+  /// changed.
+  std::size_t getOccupancyVersion() const;
+
   // Documentation inherited.
   Eigen::Matrix3d computeInertia(double mass) const override;
 
@@ -150,9 +191,26 @@ protected:
   // Documentation inherited.
   void updateVolume() const override;
 
+  /// Increments the occupancy version and raises onOccupancyChanged for the
+  /// voxels in [min, max].
+  void notifyOccupancyChanged(
+      const Eigen::Vector3d& min, const Eigen::Vector3d& max);
+
   /// Octree.
   fcl_shared_ptr<octomap::OcTree> mOctree;
   // TODO(JS): Use std::shared_ptr once we drop supporting FCL (< 0.5)
+
+  /// Number of occupancy updates made to this shape
+  std::size_t mOccupancyVersion;
+
+private:
+  /// Triggered by occupancy updates
+  OccupancyChangedSignal mOccupancyChangedSignal;
+
+public:
+  /// Use this to subscribe to occupancy changes, e.g., to redraw only the
+  /// part of the grid that changed.
+  common::SlotRegister<OccupancyChangedSignal> onOccupancyChanged;
 };
 
 } // namespace dynamics
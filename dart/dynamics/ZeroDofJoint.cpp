@@ -642,6 +642,54 @@ double ZeroDofJoint::getDampingCoefficient(std::size_t /*_index*/) const
   return 0.0;
 }
 
+//==============================================================================
+void ZeroDofJoint::setPositionServoGain(std::size_t /*_index*/, double /*_kp*/)
+{
+  // Do nothing
+}
+
+//==============================================================================
+double ZeroDofJoint::getPositionServoGain(std::size_t /*_index*/) const
+{
+  return 0.0;
+}
+
+//==============================================================================
+void ZeroDofJoint::setVelocityServoGain(std::size_t /*_index*/, double /*_kd*/)
+{
+  // Do nothing
+}
+
+//==============================================================================
+double ZeroDofJoint::getVelocityServoGain(std::size_t /*_index*/) const
+{
+  return 0.0;
+}
+
+//==============================================================================
+void ZeroDofJoint::setServoTargetPosition(std::size_t /*_index*/, double /*_position*/)
+{
+  // Do nothing
+}
+
+//==============================================================================
+double ZeroDofJoint::getServoTargetPosition(std::size_t /*_index*/) const
+{
+  return 0.0;
+}
+
+//==============================================================================
+void ZeroDofJoint::setServoTargetVelocity(std::size_t /*_index*/, double /*_velocity*/)
+{
+  // Do nothing
+}
+
+//==============================================================================
+double ZeroDofJoint::getServoTargetVelocity(std::size_t /*_index*/) const
+{
+  return 0.0;
+}
+
 //==============================================================================
 void ZeroDofJoint::setCoulombFriction(std::size_t /*_index*/, double /*_friction*/)
 {
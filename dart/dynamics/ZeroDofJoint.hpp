@@ -378,6 +378,30 @@ public:
   // Documentation inherited
   double getDampingCoefficient(std::size_t _index) const override;
 
+  // Documentation inherited
+  void setPositionServoGain(std::size_t _index, double _kp) override;
+
+  // Documentation inherited
+  double getPositionServoGain(std::size_t _index) const override;
+
+  // Documentation inherited
+  void setVelocityServoGain(std::size_t _index, double _kd) override;
+
+  // Documentation inherited
+  double getVelocityServoGain(std::size_t _index) const override;
+
+  // Documentation inherited
+  void setServoTargetPosition(std::size_t _index, double _position) override;
+
+  // Documentation inherited
+  double getServoTargetPosition(std::size_t _index) const override;
+
+  // Documentation inherited
+  void setServoTargetVelocity(std::size_t _index, double _velocity) override;
+
+  // Documentation inherited
+  double getServoTargetVelocity(std::size_t _index) const override;
+
   // Documentation inherited
   void setCoulombFriction(std::size_t _index, double _friction) override;
 
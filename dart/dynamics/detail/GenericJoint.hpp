@@ -142,6 +142,10 @@ void GenericJoint<ConfigSpaceT>::setAspectProperties(
     setRestPosition          (i, properties.mRestPositions[i]          );
     setDampingCoefficient    (i, properties.mDampingCoefficients[i]    );
     setCoulombFriction       (i, properties.mFrictions[i]              );
+    setPositionServoGain     (i, properties.mPositionServoGains[i]     );
+    setVelocityServoGain     (i, properties.mVelocityServoGains[i]     );
+    setServoTargetPosition   (i, properties.mServoTargetPositions[i]   );
+    setServoTargetVelocity   (i, properties.mServoTargetVelocities[i]  );
   }
 }
 
@@ -1531,6 +1535,114 @@ double GenericJoint<ConfigSpaceT>::getDampingCoefficient(size_t index) const
   return Base::mAspectProperties.mDampingCoefficients[index];
 }
 
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::setPositionServoGain(size_t index, double kp)
+{
+  if (index >= getNumDofs())
+  {
+    GenericJoint_REPORT_OUT_OF_RANGE(setPositionServoGain, index);
+    return;
+  }
+
+  assert(kp >= 0.0);
+
+  GenericJoint_SET_IF_DIFFERENT( mPositionServoGains[index], kp );
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+double GenericJoint<ConfigSpaceT>::getPositionServoGain(size_t index) const
+{
+  if (index >= getNumDofs())
+  {
+    GenericJoint_REPORT_OUT_OF_RANGE(getPositionServoGain, index);
+    return 0.0;
+  }
+
+  return Base::mAspectProperties.mPositionServoGains[index];
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::setVelocityServoGain(size_t index, double kd)
+{
+  if (index >= getNumDofs())
+  {
+    GenericJoint_REPORT_OUT_OF_RANGE(setVelocityServoGain, index);
+    return;
+  }
+
+  assert(kd >= 0.0);
+
+  GenericJoint_SET_IF_DIFFERENT( mVelocityServoGains[index], kd );
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+double GenericJoint<ConfigSpaceT>::getVelocityServoGain(size_t index) const
+{
+  if (index >= getNumDofs())
+  {
+    GenericJoint_REPORT_OUT_OF_RANGE(getVelocityServoGain, index);
+    return 0.0;
+  }
+
+  return Base::mAspectProperties.mVelocityServoGains[index];
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::setServoTargetPosition(size_t index, double position)
+{
+  if (index >= getNumDofs())
+  {
+    GenericJoint_REPORT_OUT_OF_RANGE(setServoTargetPosition, index);
+    return;
+  }
+
+  GenericJoint_SET_IF_DIFFERENT( mServoTargetPositions[index], position );
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+double GenericJoint<ConfigSpaceT>::getServoTargetPosition(size_t index) const
+{
+  if (index >= getNumDofs())
+  {
+    GenericJoint_REPORT_OUT_OF_RANGE(getServoTargetPosition, index);
+    return 0.0;
+  }
+
+  return Base::mAspectProperties.mServoTargetPositions[index];
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::setServoTargetVelocity(size_t index, double velocity)
+{
+  if (index >= getNumDofs())
+  {
+    GenericJoint_REPORT_OUT_OF_RANGE(setServoTargetVelocity, index);
+    return;
+  }
+
+  GenericJoint_SET_IF_DIFFERENT( mServoTargetVelocities[index], velocity );
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+double GenericJoint<ConfigSpaceT>::getServoTargetVelocity(size_t index) const
+{
+  if (index >= getNumDofs())
+  {
+    GenericJoint_REPORT_OUT_OF_RANGE(getServoTargetVelocity, index);
+    return 0.0;
+  }
+
+  return Base::mAspectProperties.mServoTargetVelocities[index];
+}
+
 //==============================================================================
 template <class ConfigSpaceT>
 void GenericJoint<ConfigSpaceT>::setCoulombFriction(
@@ -1963,10 +2075,16 @@ void GenericJoint<ConfigSpaceT>::updateInvProjArtInertiaImplicitDynamic(
   const JacobianMatrix& Jacobian = getRelativeJacobianStatic();
   Matrix projAI = Jacobian.transpose() * artInertia * Jacobian;
 
-  // Add additional inertia for implicit damping and spring force
+  // Add additional inertia for implicit damping, spring, and PD servo force.
+  // Linearizing the forces at the end of the step, i.e., at dq + h * ddq and
+  // q + h * dq + h^2 * ddq, moves h * (d + kd) + h^2 * (k + kp) to the left
+  // hand side.
   projAI +=
-      (timeStep * Base::mAspectProperties.mDampingCoefficients
-       + timeStep * timeStep * Base::mAspectProperties.mSpringStiffnesses).asDiagonal();
+      (timeStep * (Base::mAspectProperties.mDampingCoefficients
+                   + Base::mAspectProperties.mVelocityServoGains)
+       + timeStep * timeStep
+             * (Base::mAspectProperties.mSpringStiffnesses
+                + Base::mAspectProperties.mPositionServoGains)).asDiagonal();
 
   // Inversion of projected articulated inertia
   mInvProjArtInertiaImplicit = math::inverse<ConfigSpaceT>(projAI);
@@ -2197,9 +2315,26 @@ void GenericJoint<ConfigSpaceT>::updateTotalForceDynamic(
   mTotalForce = this->mAspectState.mForces
       + springForce
       + dampingForce
+      + computeServoForce(timeStep)
       - getRelativeJacobianStatic().transpose() * bodyForce;
 }
 
+//==============================================================================
+template <class ConfigSpaceT>
+typename GenericJoint<ConfigSpaceT>::Vector
+GenericJoint<ConfigSpaceT>::computeServoForce(double timeStep) const
+{
+  // The position error is predicted to the end of the step in the same way as
+  // the spring force
+  return -Base::mAspectProperties.mPositionServoGains.cwiseProduct(
+        getPositionsStatic()
+        - Base::mAspectProperties.mServoTargetPositions
+        + getVelocitiesStatic() * timeStep)
+      - Base::mAspectProperties.mVelocityServoGains.cwiseProduct(
+        getVelocitiesStatic()
+        - Base::mAspectProperties.mServoTargetVelocities);
+}
+
 //==============================================================================
 template <class ConfigSpaceT>
 void GenericJoint<ConfigSpaceT>::updateTotalForceKinematic(
@@ -2386,6 +2521,25 @@ void GenericJoint<ConfigSpaceT>::updateForceID(
           + getVelocitiesStatic() * timeStep);
     this->mAspectState.mForces -= springForces;
   }
+
+  // PD servo force, where the velocity term is treated as damping and the
+  // position term is treated as spring
+  if (withDampingForces)
+  {
+    this->mAspectState.mForces
+        += Base::mAspectProperties.mVelocityServoGains.cwiseProduct(
+          getVelocitiesStatic()
+          - Base::mAspectProperties.mServoTargetVelocities);
+  }
+
+  if (withSpringForces)
+  {
+    this->mAspectState.mForces
+        += Base::mAspectProperties.mPositionServoGains.cwiseProduct(
+          getPositionsStatic()
+          - Base::mAspectProperties.mServoTargetPositions
+          + getVelocitiesStatic() * timeStep);
+  }
 }
 
 //==============================================================================
@@ -133,6 +133,18 @@ struct GenericJointUniqueProperties
   /// Joint Coulomb friction
   Vector mFrictions;
 
+  /// Position gains of the joint PD servo force
+  Vector mPositionServoGains;
+
+  /// Velocity gains of the joint PD servo force
+  Vector mVelocityServoGains;
+
+  /// Target positions of the joint PD servo force
+  EuclideanPoint mServoTargetPositions;
+
+  /// Target velocities of the joint PD servo force
+  Vector mServoTargetVelocities;
+
   /// True if the name of the corresponding DOF is not allowed to be
   /// overwritten
   BoolArray mPreserveDofNames;
@@ -155,7 +167,11 @@ struct GenericJointUniqueProperties
       const Vector& springStiffness = Vector::Zero(),
       const EuclideanPoint& restPosition = EuclideanPoint::Zero(),
       const Vector& dampingCoefficient = Vector::Zero(),
-      const Vector& coulombFrictions = Vector::Zero());
+      const Vector& coulombFrictions = Vector::Zero(),
+      const Vector& positionServoGains = Vector::Zero(),
+      const Vector& velocityServoGains = Vector::Zero(),
+      const EuclideanPoint& servoTargetPositions = EuclideanPoint::Zero(),
+      const Vector& servoTargetVelocities = Vector::Zero());
 
   /// Copy constructor
   // Note: we only need this because VS2013 lacks full support for std::array
@@ -234,7 +250,11 @@ GenericJointUniqueProperties<ConfigSpaceT>::GenericJointUniqueProperties(
     const Vector& springStiffness,
     const EuclideanPoint& restPosition,
     const Vector& dampingCoefficient,
-    const Vector& coulombFrictions)
+    const Vector& coulombFrictions,
+    const Vector& positionServoGains,
+    const Vector& velocityServoGains,
+    const EuclideanPoint& servoTargetPositions,
+    const Vector& servoTargetVelocities)
   : mPositionLowerLimits(positionLowerLimits),
     mPositionUpperLimits(positionUpperLimits),
     mInitialPositions(initialPositions),
@@ -248,7 +268,11 @@ GenericJointUniqueProperties<ConfigSpaceT>::GenericJointUniqueProperties(
     mSpringStiffnesses(springStiffness),
     mRestPositions(restPosition),
     mDampingCoefficients(dampingCoefficient),
-    mFrictions(coulombFrictions)
+    mFrictions(coulombFrictions),
+    mPositionServoGains(positionServoGains),
+    mVelocityServoGains(velocityServoGains),
+    mServoTargetPositions(servoTargetPositions),
+    mServoTargetVelocities(servoTargetVelocities)
 {
   for (auto i = 0u; i < NumDofs; ++i)
   {
@@ -274,7 +298,11 @@ GenericJointUniqueProperties<ConfigSpaceT>::GenericJointUniqueProperties(
     mSpringStiffnesses(_other.mSpringStiffnesses),
     mRestPositions(_other.mRestPositions),
     mDampingCoefficients(_other.mDampingCoefficients),
-    mFrictions(_other.mFrictions)
+    mFrictions(_other.mFrictions),
+    mPositionServoGains(_other.mPositionServoGains),
+    mVelocityServoGains(_other.mVelocityServoGains),
+    mServoTargetPositions(_other.mServoTargetPositions),
+    mServoTargetVelocities(_other.mServoTargetVelocities)
 {
   for (auto i = 0u; i < NumDofs; ++i)
   {
@@ -43,7 +43,16 @@ namespace dynamics {
 
 //==============================================================================
 template <typename S>
-HeightmapShape<S>::HeightmapShape() : Shape(HEIGHTMAP), mScale(1, 1, 1)
+constexpr std::size_t HeightmapShape<S>::DefaultTileSize;
+
+//==============================================================================
+template <typename S>
+HeightmapShape<S>::HeightmapShape()
+  : Shape(HEIGHTMAP),
+    mScale(1, 1, 1),
+    mHeights(std::make_shared<HeightField>()),
+    mTileSize(DefaultTileSize),
+    mNumTileCols(0u)
 {
   static_assert(
       std::is_same<S, float>::value || std::is_same<S, double>::value,
@@ -77,6 +86,11 @@ void HeightmapShape<S>::setScale(const Eigen::Vector3d& scale)
   mIsBoundingBoxDirty = true;
   mIsVolumeDirty = true;
 
+  // The vertices of every tile move
+  const std::size_t version = getVersion() + 1u;
+  for (auto& tile : mTiles)
+    tile.mVersion = version;
+
   incrementVersion();
 }
 
@@ -106,25 +120,73 @@ void HeightmapShape<S>::setHeightField(
     dtwarn << "Empty height field makes no sense." << std::endl;
     return;
   }
-  mHeights = HeightField(depth, width);
-  for (size_t r = 0; r < depth; ++r)
+  // Copy into a new buffer rather than overwriting the current one, which
+  // collision detectors may still be using.
+  setHeightField(HeightField(
+      Eigen::Map<const HeightField>(heights.data(), depth, width)));
+}
+
+//==============================================================================
+template <typename S>
+void HeightmapShape<S>::setHeightField(HeightField&& heights)
+{
+  if (heights.size() == 0)
   {
-    for (size_t c = 0; c < width; ++c)
-    {
-      mHeights(r, c) = heights[r * width + c];
-    }
+    dtwarn << "Empty height field makes no sense." << std::endl;
+    return;
   }
 
-  // compute minimum and maximum height
-  mMinHeight = std::numeric_limits<S>::max();
-  mMaxHeight = -std::numeric_limits<S>::max();
-  for (auto it = heights.begin(); it != heights.end(); ++it)
+  mHeights = std::make_shared<HeightField>(std::move(heights));
+
+  updateTiles();
+  updateMinMaxHeights();
+
+  mIsBoundingBoxDirty = true;
+  mIsVolumeDirty = true;
+
+  incrementVersion();
+}
+
+//==============================================================================
+template <typename S>
+void HeightmapShape<S>::setHeights(
+    std::size_t row, std::size_t col, const HeightField& block)
+{
+  if (row + static_cast<std::size_t>(block.rows()) > getDepth()
+      || col + static_cast<std::size_t>(block.cols()) > getWidth())
   {
-    if (*it < mMinHeight)
-      mMinHeight = *it;
-    if (*it > mMaxHeight)
-      mMaxHeight = *it;
+    dterr << "[HeightmapShape::setHeights] Block of size " << block.rows()
+          << "x" << block.cols() << " at (" << row << ", " << col
+          << ") exceeds the height field of size " << getDepth() << "x"
+          << getWidth() << ". Ignoring this request.\n";
+    return;
   }
+
+  if (block.size() == 0)
+    return;
+
+  mHeights->block(row, col, block.rows(), block.cols()) = block;
+
+  // Only update the tiles sharing samples with the block. A sample on the
+  // border of a tile also belongs to its neighbors. The tiles are tagged with
+  // the version set below, before its subscribers are notified.
+  const std::size_t version = getVersion() + 1u;
+  const std::size_t lastRow = row + block.rows() - 1u;
+  const std::size_t lastCol = col + block.cols() - 1u;
+  for (auto& tile : mTiles)
+  {
+    if (tile.mRow > lastRow || tile.mRow + tile.mNumRows < row
+        || tile.mCol > lastCol || tile.mCol + tile.mNumCols < col)
+    {
+      continue;
+    }
+
+    updateTileHeights(tile);
+    tile.mVersion = version;
+  }
+
+  updateMinMaxHeights();
+
   mIsBoundingBoxDirty = true;
   mIsVolumeDirty = true;
 
@@ -134,6 +196,14 @@ void HeightmapShape<S>::setHeightField(
 //==============================================================================
 template <typename S>
 auto HeightmapShape<S>::getHeightField() const -> const HeightField&
+{
+  return *mHeights;
+}
+
+//==============================================================================
+template <typename S>
+auto HeightmapShape<S>::getSharedHeightField() const
+    -> std::shared_ptr<const HeightField>
 {
   return mHeights;
 }
@@ -142,14 +212,159 @@ auto HeightmapShape<S>::getHeightField() const -> const HeightField&
 template <typename S>
 auto HeightmapShape<S>::getHeightFieldModifiable() const -> HeightField&
 {
-  return mHeights;
+  return *mHeights;
 }
 
 //==============================================================================
 template <typename S>
-void HeightmapShape<S>::flipY() const
+void HeightmapShape<S>::notifyHeightsChanged()
 {
-  mHeights = mHeights.colwise().reverse().eval();
+  updateTiles();
+  updateMinMaxHeights();
+
+  mIsBoundingBoxDirty = true;
+  mIsVolumeDirty = true;
+
+  incrementVersion();
+}
+
+//==============================================================================
+template <typename S>
+void HeightmapShape<S>::flipY()
+{
+  const std::size_t depth = getDepth();
+  for (std::size_t r = 0u; r < depth / 2u; ++r)
+    mHeights->row(r).swap(mHeights->row(depth - 1u - r));
+
+  // The heights of each tile change, but not their overall range.
+  updateTiles();
+
+  incrementVersion();
+}
+
+//==============================================================================
+template <typename S>
+void HeightmapShape<S>::setTileSize(std::size_t tileSize)
+{
+  assert(tileSize > 0u);
+  if (tileSize == 0u || tileSize == mTileSize)
+    return;
+
+  mTileSize = tileSize;
+  updateTiles();
+
+  incrementVersion();
+}
+
+//==============================================================================
+template <typename S>
+std::size_t HeightmapShape<S>::getTileSize() const
+{
+  return mTileSize;
+}
+
+//==============================================================================
+template <typename S>
+std::size_t HeightmapShape<S>::getNumTiles() const
+{
+  return mTiles.size();
+}
+
+//==============================================================================
+template <typename S>
+auto HeightmapShape<S>::getTile(std::size_t index) const -> const Tile&
+{
+  assert(index < mTiles.size());
+  return mTiles[index];
+}
+
+//==============================================================================
+template <typename S>
+math::BoundingBox HeightmapShape<S>::computeTileBoundingBox(
+    std::size_t index) const
+{
+  const Tile& tile = getTile(index);
+
+  // Rows go in -y direction
+  const Eigen::Vector3d topLeft = getVertex(tile.mRow, tile.mCol);
+  const Eigen::Vector3d bottomRight = getVertex(
+      tile.mRow + tile.mNumRows, tile.mCol + tile.mNumCols);
+
+  return math::BoundingBox(
+      Eigen::Vector3d(
+          topLeft.x(), bottomRight.y(), tile.mMinHeight * mScale.z()),
+      Eigen::Vector3d(
+          bottomRight.x(), topLeft.y(), tile.mMaxHeight * mScale.z()));
+}
+
+//==============================================================================
+template <typename S>
+void HeightmapShape<S>::findTiles(
+    const math::BoundingBox& region, std::vector<std::size_t>& tiles) const
+{
+  tiles.clear();
+
+  if (mTiles.empty())
+    return;
+
+  const Eigen::Vector3d& min = region.getMin();
+  const Eigen::Vector3d& max = region.getMax();
+
+  // Convert the region to (fractional) cell coordinates
+  const double halfWidth = 0.5 * (getWidth() - 1);
+  const double halfDepth = 0.5 * (getDepth() - 1);
+  const double minCol = min.x() / mScale.x() + halfWidth;
+  const double maxCol = max.x() / mScale.x() + halfWidth;
+  const double minRow = halfDepth - max.y() / mScale.y();
+  const double maxRow = halfDepth - min.y() / mScale.y();
+
+  const double numCellCols = static_cast<double>(getWidth() - 1);
+  const double numCellRows = static_cast<double>(getDepth() - 1);
+  if (maxCol < 0.0 || minCol > numCellCols || maxRow < 0.0
+      || minRow > numCellRows)
+  {
+    return;
+  }
+
+  const std::size_t numTileRows = mTiles.size() / mNumTileCols;
+  const auto toTileIndex = [this](double cell, std::size_t numTiles) {
+    const auto index = static_cast<std::size_t>(std::max(cell, 0.0))
+                       / mTileSize;
+    return std::min(index, numTiles - 1u);
+  };
+
+  const std::size_t tileColBegin = toTileIndex(minCol, mNumTileCols);
+  const std::size_t tileColEnd = toTileIndex(maxCol, mNumTileCols);
+  const std::size_t tileRowBegin = toTileIndex(minRow, numTileRows);
+  const std::size_t tileRowEnd = toTileIndex(maxRow, numTileRows);
+
+  for (std::size_t i = tileRowBegin; i <= tileRowEnd; ++i)
+  {
+    for (std::size_t j = tileColBegin; j <= tileColEnd; ++j)
+    {
+      const std::size_t index = i * mNumTileCols + j;
+      const Tile& tile = mTiles[index];
+
+      if (tile.mMaxHeight * mScale.z() < min.z()
+          || tile.mMinHeight * mScale.z() > max.z())
+      {
+        continue;
+      }
+
+      tiles.push_back(index);
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+Eigen::Vector3d HeightmapShape<S>::getVertex(
+    std::size_t row, std::size_t col) const
+{
+  return Eigen::Vector3d(
+      (col - 0.5 * (getWidth() - 1)) * mScale.x(),
+      (0.5 * (getDepth() - 1) - row) * mScale.y(),
+      (*mHeights)(row, col) * mScale.z());
 }
 
 //==============================================================================
@@ -170,14 +385,14 @@ auto HeightmapShape<S>::getMinHeight() const -> S
 template <typename S>
 std::size_t HeightmapShape<S>::getWidth() const
 {
-  return mHeights.cols();
+  return mHeights->cols();
 }
 
 //==============================================================================
 template <typename S>
 std::size_t HeightmapShape<S>::getDepth() const
 {
-  return mHeights.rows();
+  return mHeights->rows();
 }
 
 //==============================================================================
@@ -203,6 +418,74 @@ void HeightmapShape<S>::computeBoundingBox(
   max = min + Eigen::Vector3d(dimX, dimY, dimZ);
 }
 
+//==============================================================================
+template <typename S>
+void HeightmapShape<S>::updateTiles() const
+{
+  mTiles.clear();
+  mNumTileCols = 0u;
+
+  // A field with a single row or column of samples has no cells
+  if (getWidth() < 2u || getDepth() < 2u)
+    return;
+
+  const std::size_t numCellRows = getDepth() - 1u;
+  const std::size_t numCellCols = getWidth() - 1u;
+  mNumTileCols = (numCellCols + mTileSize - 1u) / mTileSize;
+  const std::size_t numTileRows = (numCellRows + mTileSize - 1u) / mTileSize;
+
+  // The callers increment the version once done
+  const std::size_t version = getVersion() + 1u;
+
+  mTiles.reserve(numTileRows * mNumTileCols);
+  for (std::size_t i = 0u; i < numTileRows; ++i)
+  {
+    for (std::size_t j = 0u; j < mNumTileCols; ++j)
+    {
+      Tile tile;
+      tile.mRow = i * mTileSize;
+      tile.mCol = j * mTileSize;
+      tile.mNumRows = std::min(mTileSize, numCellRows - tile.mRow);
+      tile.mNumCols = std::min(mTileSize, numCellCols - tile.mCol);
+      updateTileHeights(tile);
+      tile.mVersion = version;
+
+      mTiles.push_back(tile);
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void HeightmapShape<S>::updateTileHeights(Tile& tile) const
+{
+  const auto samples = mHeights->block(
+      tile.mRow, tile.mCol, tile.mNumRows + 1u, tile.mNumCols + 1u);
+
+  tile.mMinHeight = samples.minCoeff();
+  tile.mMaxHeight = samples.maxCoeff();
+}
+
+//==============================================================================
+template <typename S>
+void HeightmapShape<S>::updateMinMaxHeights()
+{
+  if (mTiles.empty())
+  {
+    mMinHeight = mHeights->minCoeff();
+    mMaxHeight = mHeights->maxCoeff();
+    return;
+  }
+
+  mMinHeight = std::numeric_limits<S>::max();
+  mMaxHeight = -std::numeric_limits<S>::max();
+  for (const auto& tile : mTiles)
+  {
+    mMinHeight = std::min(mMinHeight, tile.mMinHeight);
+    mMaxHeight = std::max(mMaxHeight, tile.mMaxHeight);
+  }
+}
+
 //==============================================================================
 template <typename S>
 void HeightmapShape<S>::updateBoundingBox() const
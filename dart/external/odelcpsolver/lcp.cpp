@@ -779,6 +779,14 @@ void dLCP::unpermute()
 
 bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
                 dReal *outer_w/*=nullptr*/, int nub, dReal *lo, dReal *hi, int *findex, bool earlyTermination)
+{
+  dLCPWorkspace workspace;
+  return dSolveLCP (n, A, x, b, outer_w, nub, lo, hi, findex, earlyTermination, workspace);
+}
+
+bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
+                dReal *outer_w, int nub, dReal *lo, dReal *hi, int *findex, bool earlyTermination,
+                dLCPWorkspace &workspace)
 {
   dAASSERT (n>0 && A && x && b && lo && hi && nub >= 0 && nub <= n);
 # ifndef dNODEBUG
@@ -788,11 +796,12 @@ bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
   }
 # endif
 
+  workspace.reserve (n);
 
   // if all the variables are unbounded then we can just factor, solve,
   // and return
   if (nub >= n) {
-    dReal *d = new dReal[n];
+    dReal *d = workspace.d;
     dSetZero (d, n);
 
     int nskip = dPAD(n);
@@ -800,28 +809,27 @@ bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
     dSolveLDLT (A, d, b, n, nskip);
     memcpy (x, b, n*sizeof(dReal));
 
-    delete[] d;
     return true;
   }
 
   const int nskip = dPAD(n);
-  dReal *L = new dReal[ (n*nskip)];
-  dReal *d = new dReal[ (n)];
-  dReal *w = outer_w ? outer_w : (new dReal[n]);
-  dReal *delta_w = new dReal[ (n)];
-  dReal *delta_x = new dReal[ (n)];
-  dReal *Dell = new dReal[ (n)];
-  dReal *ell = new dReal[ (n)];
+  dReal *L = workspace.L;
+  dReal *d = workspace.d;
+  dReal *w = outer_w ? outer_w : workspace.w;
+  dReal *delta_w = workspace.delta_w;
+  dReal *delta_x = workspace.delta_x;
+  dReal *Dell = workspace.Dell;
+  dReal *ell = workspace.ell;
 #ifdef ROWPTRS
-  dReal **Arows = new dReal* [n];
+  dReal **Arows = workspace.Arows;
 #else
   dReal **Arows = nullptr;
 #endif
-  int *p = new int[n];
-  int *C = new int[n];
+  int *p = workspace.p;
+  int *C = workspace.C;
 
   // for i in N, state[i] is 0 if x(i)==lo(i) or 1 if x(i)==hi(i)
-  bool *state = new bool[n];
+  bool *state = workspace.state;
 
   // create LCP object. note that tmp is set to delta_w to save space, this
   // optimization relies on knowledge of how tmp is used, so be careful!
@@ -1007,22 +1015,6 @@ bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
         if (s <= REAL(0.0)) {
 
           if (earlyTermination) {
-            if (!outer_w)
-              delete[] w;
-            delete[] L;
-            delete[] d;
-            delete[] delta_w;
-            delete[] delta_x;
-            delete[] Dell;
-            delete[] ell;
-          #ifdef ROWPTRS
-            delete[] Arows;
-          #endif
-            delete[] p;
-            delete[] C;
-
-            delete[] state;
-
             return false;
           }
 
@@ -1074,12 +1066,12 @@ bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
         case 5:		// keep going
           x[si] = lo[si];
           state[si] = false;
-          lcp.transfer_i_from_C_to_N (si, nullptr);
+          lcp.transfer_i_from_C_to_N (si, workspace.tmpbuf);
           break;
         case 6:		// keep going
           x[si] = hi[si];
           state[si] = true;
-          lcp.transfer_i_from_C_to_N (si, nullptr);
+          lcp.transfer_i_from_C_to_N (si, workspace.tmpbuf);
           break;
         }
 
@@ -1094,22 +1086,6 @@ bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
 
   lcp.unpermute();
 
-  if (!outer_w)
-	  delete[] w;
-  delete[] L;
-  delete[] d;
-  delete[] delta_w;
-  delete[] delta_x;
-  delete[] Dell;
-  delete[] ell;
-#ifdef ROWPTRS
-  delete[] Arows;
-#endif
-  delete[] p;
-  delete[] C;
-
-  delete[] state;
-
   return true;
 }
 
@@ -1138,6 +1114,83 @@ size_t dEstimateSolveLCPMemoryReq(int n, bool outer_w_avail)
 }
 
 
+//***************************************************************************
+// persistent workspace of dSolveLCP
+
+dLCPWorkspace::dLCPWorkspace()
+  : L(nullptr), d(nullptr), w(nullptr), delta_w(nullptr), delta_x(nullptr),
+    Dell(nullptr), ell(nullptr), Arows(nullptr), p(nullptr), C(nullptr),
+    state(nullptr), tmpbuf(nullptr), m_buffer(nullptr), m_capacity(0)
+{
+  // Do nothing
+}
+
+dLCPWorkspace::~dLCPWorkspace()
+{
+  delete[] m_buffer;
+}
+
+// carves an array of the given size out of the buffer, keeping every array
+// aligned to dLCP_WORKSPACE_ALIGNMENT so the SIMD friendly kernels can work
+// on it
+static char *dCarveWorkspace (char *&cursor, size_t size)
+{
+  char *res = cursor;
+  cursor += (size + (dLCP_WORKSPACE_ALIGNMENT-1))
+      & ~((size_t)(dLCP_WORKSPACE_ALIGNMENT-1));
+  return res;
+}
+
+static size_t dEstimateWorkspaceSize (int n)
+{
+  const int nskip = dPAD(n);
+  const size_t padding = dLCP_WORKSPACE_ALIGNMENT - 1;
+
+  size_t res = padding; // for aligning the first array
+  res += sizeof(dReal) * (n * nskip) + padding; // for L
+  res += 6 * (sizeof(dReal) * nskip + padding); // for d, w, delta_w, delta_x, Dell, ell
+  res += sizeof(dReal *) * n + padding; // for Arows
+  res += 2 * (sizeof(int) * n + padding); // for p, C
+  res += sizeof(bool) * n + padding; // for state
+  res += dLCP::estimate_transfer_i_from_C_to_N_mem_req(n, nskip) + padding; // for tmpbuf
+
+  return res;
+}
+
+void dLCPWorkspace::reserve (int n)
+{
+  if (n <= m_capacity)
+    return;
+
+  delete[] m_buffer;
+  m_buffer = new char[dEstimateWorkspaceSize(n)];
+  m_capacity = n;
+
+  const int nskip = dPAD(n);
+  char *cursor = (char *)((((size_t)m_buffer) + (dLCP_WORKSPACE_ALIGNMENT-1))
+      & ~((size_t)(dLCP_WORKSPACE_ALIGNMENT-1)));
+
+  L = (dReal *)dCarveWorkspace (cursor, sizeof(dReal) * (n * nskip));
+  d = (dReal *)dCarveWorkspace (cursor, sizeof(dReal) * nskip);
+  w = (dReal *)dCarveWorkspace (cursor, sizeof(dReal) * nskip);
+  delta_w = (dReal *)dCarveWorkspace (cursor, sizeof(dReal) * nskip);
+  delta_x = (dReal *)dCarveWorkspace (cursor, sizeof(dReal) * nskip);
+  Dell = (dReal *)dCarveWorkspace (cursor, sizeof(dReal) * nskip);
+  ell = (dReal *)dCarveWorkspace (cursor, sizeof(dReal) * nskip);
+  Arows = (dReal **)dCarveWorkspace (cursor, sizeof(dReal *) * n);
+  p = (int *)dCarveWorkspace (cursor, sizeof(int) * n);
+  C = (int *)dCarveWorkspace (cursor, sizeof(int) * n);
+  state = (bool *)dCarveWorkspace (cursor, sizeof(bool) * n);
+  tmpbuf = dCarveWorkspace (cursor,
+      dLCP::estimate_transfer_i_from_C_to_N_mem_req(n, nskip));
+}
+
+int dLCPWorkspace::capacity() const
+{
+  return m_capacity;
+}
+
+
 //***************************************************************************
 // accuracy and timing test
 
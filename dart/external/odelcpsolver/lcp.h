@@ -57,9 +57,55 @@ to be implemented. the first `nub' variables are assumed to have findex < 0.
 #include "dart/external/odelcpsolver/odeconfig.h"
 #include "dart/external/odelcpsolver/common.h"
 
+/* alignment of the arrays in dLCPWorkspace, which is enough for the SIMD
+ * friendly kernels (_dDot, _dFactorLDLT, _dSolveL1, ...) */
+#define dLCP_WORKSPACE_ALIGNMENT 32
+
+/* persistent workspace of dSolveLCP. all the temporary arrays of a solve are
+ * carved out of a single aligned buffer, which is only reallocated when a
+ * problem larger than any of the previous ones is solved. rows of L are
+ * padded to dPAD(n). */
+struct dLCPWorkspace
+{
+  dLCPWorkspace();
+  ~dLCPWorkspace();
+
+  dLCPWorkspace(const dLCPWorkspace&) = delete;
+  dLCPWorkspace& operator=(const dLCPWorkspace&) = delete;
+
+  /* makes sure the workspace can hold a problem of dimension n */
+  void reserve (int n);
+
+  /* returns the largest problem dimension the workspace can hold */
+  int capacity() const;
+
+  dReal *L;
+  dReal *d;
+  dReal *w;
+  dReal *delta_w;
+  dReal *delta_x;
+  dReal *Dell;
+  dReal *ell;
+  dReal **Arows;
+  int *p;
+  int *C;
+  bool *state;
+  void *tmpbuf;
+
+private:
+  char *m_buffer;
+  int m_capacity;
+};
+
 bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b, dReal *w,
   int nub, dReal *lo, dReal *hi, int *findex, bool earlyTermination = false);
 
+/* same as above, but uses the given workspace instead of allocating the
+ * temporary arrays on every call */
+bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b, dReal *w,
+  int nub, dReal *lo, dReal *hi, int *findex, bool earlyTermination,
+  dLCPWorkspace &workspace);
+
 size_t dEstimateSolveLCPMemoryReq(int n, bool outer_w_avail);
 
 
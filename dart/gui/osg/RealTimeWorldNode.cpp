@@ -31,7 +31,12 @@
  */
 
 #include "dart/gui/osg/RealTimeWorldNode.hpp"
+
+#include <algorithm>
+#include <chrono>
+
 #include "dart/common/Console.hpp"
+#include "dart/common/Memory.hpp"
 #include "dart/simulation/World.hpp"
 
 namespace dart {
@@ -50,11 +55,23 @@ RealTimeWorldNode::RealTimeWorldNode(
     mTargetSimTimeLapse(targetRealTimeFactor * mTargetRealTimeLapse),
     mLastRealTimeFactor(0.0),
     mLowestRealTimeFactor(std::numeric_limits<double>::infinity()),
-    mHighestRealTimeFactor(0.0)
+    mHighestRealTimeFactor(0.0),
+    mSimulationThreaded(false),
+    mStopSimulationThread(false),
+    mThreadSimulating(false),
+    mThreadTargetRealTimeFactor(targetRealTimeFactor),
+    mThreadTargetRealTimeLapse(mTargetRealTimeLapse),
+    mLastSnapshotTime(0.0)
 {
   // Do nothing
 }
 
+//==============================================================================
+RealTimeWorldNode::~RealTimeWorldNode()
+{
+  stopSimulationThread();
+}
+
 //==============================================================================
 void RealTimeWorldNode::setTargetFrequency(double targetFrequency)
 {
@@ -99,9 +116,38 @@ double RealTimeWorldNode::getHighestRealTimeFactor() const
   return mHighestRealTimeFactor;
 }
 
+//==============================================================================
+void RealTimeWorldNode::setSimulationThreaded(bool threaded)
+{
+  mSimulationThreaded = threaded;
+
+  // The thread is started by the next refresh cycle, once it is clear which
+  // World it should step.
+  if (!threaded)
+    stopSimulationThread();
+}
+
+//==============================================================================
+bool RealTimeWorldNode::isSimulationThreaded() const
+{
+  return mSimulationThreaded;
+}
+
+//==============================================================================
+std::unique_lock<std::mutex> RealTimeWorldNode::lockSimulation()
+{
+  return std::unique_lock<std::mutex>(mSimulationMutex);
+}
+
 //==============================================================================
 void RealTimeWorldNode::refresh()
 {
+  if (mSimulationThreaded)
+  {
+    refreshThreaded();
+    return;
+  }
+
   customPreRefresh();
   clearChildUtilizationFlags();
 
@@ -161,6 +207,189 @@ void RealTimeWorldNode::refresh()
   customPostRefresh();
 }
 
+//==============================================================================
+void RealTimeWorldNode::refreshThreaded()
+{
+  customPreRefresh();
+  clearChildUtilizationFlags();
+
+  if (mThreadWorld != mWorld)
+  {
+    stopSimulationThread();
+    if (mWorld)
+      startSimulationThread();
+  }
+
+  mThreadSimulating = mSimulating;
+  mThreadTargetRealTimeFactor = getTargetRealTimeFactor();
+  mThreadTargetRealTimeLapse = mTargetRealTimeLapse;
+
+  if (mSnapshots)
+  {
+    const bool updated = mSnapshots->update();
+    const simulation::WorldSnapshot& snapshot = mSnapshots->getReadBuffer();
+
+    if (mSimulating)
+    {
+      if (mFirstRefresh)
+      {
+        mRefreshTimer.setStartTick();
+        mLastSnapshotTime = snapshot.getTime();
+        mFirstRefresh = false;
+      }
+      else if (updated)
+      {
+        const double realTimeLapse = mRefreshTimer.time_s();
+        if (realTimeLapse > 0.0)
+        {
+          mLastRealTimeFactor
+              = (snapshot.getTime() - mLastSnapshotTime) / realTimeLapse;
+          mLowestRealTimeFactor
+              = std::min(mLastRealTimeFactor, mLowestRealTimeFactor);
+          mHighestRealTimeFactor
+              = std::max(mLastRealTimeFactor, mHighestRealTimeFactor);
+        }
+
+        mLastSnapshotTime = snapshot.getTime();
+        mRefreshTimer.setStartTick();
+      }
+    }
+    else
+    {
+      mFirstRefresh = true;
+    }
+
+    // The last snapshot is rendered again if no new one has arrived, so that
+    // its nodes are not cleared as unused. The snapshot holds everything that
+    // World::step() changes, so this does not wait for the simulation thread.
+    refreshSnapshot(snapshot);
+  }
+
+  clearUnusedNodes();
+
+  customPostRefresh();
+}
+
+//==============================================================================
+void RealTimeWorldNode::startSimulationThread()
+{
+  mThreadWorld = mWorld;
+  mStopSimulationThread = false;
+  mSnapshots = common::make_unique<
+      common::TripleBuffer<simulation::WorldSnapshot>>();
+
+  mSimulationThread
+      = std::thread(&RealTimeWorldNode::runSimulation, this, mThreadWorld);
+}
+
+//==============================================================================
+void RealTimeWorldNode::stopSimulationThread()
+{
+  if (mSimulationThread.joinable())
+  {
+    mStopSimulationThread = true;
+    mSimulationThread.join();
+  }
+
+  // Release the Skeletons that the snapshots keep alive
+  mSnapshots.reset();
+  mThreadWorld.reset();
+  mFirstRefresh = true;
+}
+
+//==============================================================================
+void RealTimeWorldNode::runSimulation(
+    const std::shared_ptr<simulation::World>& world)
+{
+  using Clock = std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<double>;
+
+  {
+    std::lock_guard<std::mutex> lock(mSimulationMutex);
+    publishSnapshot(*world);
+  }
+
+  bool wasSimulating = false;
+  double targetRTF = 0.0;
+  Clock::time_point startRealTime;
+  double startSimTime = 0.0;
+  Clock::time_point lastPublishTime = Clock::now();
+
+  while (!mStopSimulationThread)
+  {
+    const double targetRealTimeLapse = mThreadTargetRealTimeLapse;
+    const Seconds publishPeriod(targetRealTimeLapse);
+
+    if (!mThreadSimulating || mThreadTargetRealTimeFactor <= 0.0)
+    {
+      // Keep showing changes that are made to the World while it is paused
+      wasSimulating = false;
+      {
+        std::lock_guard<std::mutex> lock(mSimulationMutex);
+        publishSnapshot(*world);
+      }
+      std::this_thread::sleep_for(publishPeriod);
+      continue;
+    }
+
+    const Clock::time_point now = Clock::now();
+    std::unique_lock<std::mutex> lock(mSimulationMutex);
+
+    if (!wasSimulating || targetRTF != mThreadTargetRealTimeFactor)
+    {
+      wasSimulating = true;
+      targetRTF = mThreadTargetRealTimeFactor;
+      startRealTime = now;
+      startSimTime = world->getTime();
+    }
+
+    // Do not try to catch up on more than one refresh cycle worth of
+    // simulation time if the steps are too expensive to keep up.
+    const double maxLag = targetRTF * targetRealTimeLapse;
+    double targetSimTime
+        = startSimTime + targetRTF * Seconds(now - startRealTime).count();
+    if (targetSimTime - world->getTime() > maxLag)
+    {
+      startSimTime -= targetSimTime - world->getTime() - maxLag;
+      targetSimTime = world->getTime() + maxLag;
+    }
+
+    const double timeStep = world->getTimeStep();
+    const bool behind = world->getTime() + timeStep <= targetSimTime;
+
+    if (behind)
+    {
+      customPreStep();
+      world->step();
+      customPostStep();
+    }
+
+    // Publish once we have caught up, or at least once per refresh cycle
+    if (!behind || now - lastPublishTime >= publishPeriod)
+    {
+      publishSnapshot(*world);
+      lastPublishTime = now;
+    }
+
+    const double waitTime
+        = (world->getTime() + timeStep - targetSimTime) / targetRTF;
+
+    lock.unlock();
+
+    // Sleep until the next step is due
+    if (!behind)
+      std::this_thread::sleep_for(
+          Seconds(std::min(waitTime, targetRealTimeLapse)));
+  }
+}
+
+//==============================================================================
+void RealTimeWorldNode::publishSnapshot(const simulation::World& world)
+{
+  mSnapshots->getWriteBuffer().capture(world);
+  mSnapshots->publish();
+}
+
 } // namespace osg
 } // namespace gui
 } // namespace dart
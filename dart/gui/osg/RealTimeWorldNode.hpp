@@ -33,9 +33,16 @@
 #ifndef DART_GUI_OSG_REALTIMEWORLDNODE_HPP_
 #define DART_GUI_OSG_REALTIMEWORLDNODE_HPP_
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include <osg/Timer>
 
+#include "dart/common/TripleBuffer.hpp"
 #include "dart/gui/osg/WorldNode.hpp"
+#include "dart/simulation/WorldSnapshot.hpp"
 
 namespace dart {
 namespace gui {
@@ -96,10 +103,68 @@ public:
   /// Turn the text displaying the real time factor on or off
   void setRealTimeFactorDisplay(bool on);
 
+  /// Pass in true to step the World on a dedicated simulation thread instead
+  /// of during the render cycles. The simulation thread then keeps pace with
+  /// the target real time factor on its own, and hands over a
+  /// simulation::WorldSnapshot of the transforms and shapes of all ShapeFrames
+  /// to the rendering side whenever it has made progress. Rendering consumes
+  /// the latest snapshot for the transforms of the ShapeFrames, so a slow
+  /// frame does not hold up the simulation, and an expensive step does not
+  /// hold up rendering.
+  ///
+  /// The snapshot also copies what World::step() changes besides the
+  /// transforms and what the render nodes read in every cycle: the colors and
+  /// visibility of the VisualAspects, and the vertices of SoftMeshShapes. The
+  /// rendering side reads those from the snapshot without taking
+  /// lockSimulation(), so it never waits for a step to finish. The other
+  /// parameters of the Shapes (e.g., the size of a BoxShape) are read from the
+  /// Shapes themselves, so they should not be changed while the simulation is
+  /// threaded.
+  ///
+  /// While the simulation is threaded:
+  /// - customPreStep() and customPostStep() are called on the simulation
+  ///   thread.
+  /// - Any code that modifies the World from another thread (e.g., event
+  ///   handlers or customPreRefresh()) must hold lockSimulation() while doing
+  ///   so. This includes changing VisualAspects.
+  ///
+  /// Classes that override customPreStep() or customPostStep() should turn the
+  /// threading off in their destructor, so that the simulation thread is
+  /// stopped before their overrides are destroyed.
+  void setSimulationThreaded(bool threaded);
+
+  /// Returns true iff the simulation is stepped on a dedicated thread
+  bool isSimulationThreaded() const;
+
+  /// Returns a lock that keeps the simulation thread from stepping the World
+  /// until it is released. Locking is harmless when the simulation is not
+  /// threaded.
+  std::unique_lock<std::mutex> lockSimulation();
+
   // Documentation inherited
   void refresh() override;
 
 protected:
+  /// Destructor
+  ~RealTimeWorldNode() override;
+
+  /// The refresh cycle used when the simulation is threaded
+  void refreshThreaded();
+
+  /// Start stepping mWorld on a simulation thread
+  void startSimulationThread();
+
+  /// Stop the simulation thread, if it is running, and wait for it to finish
+  void stopSimulationThread();
+
+  /// The function that runs on the simulation thread
+  void runSimulation(const std::shared_ptr<dart::simulation::World>& world);
+
+  /// Capture the current state of \c world and hand it over to the rendering
+  /// side. This is called on the simulation thread while holding
+  /// mSimulationMutex.
+  void publishSnapshot(const dart::simulation::World& world);
+
   /// Reset each time the simulation is paused
   bool mFirstRefresh;
 
@@ -120,6 +185,37 @@ protected:
 
   /// The highest RTF that has been achieved
   double mHighestRealTimeFactor;
+
+  /// True iff the simulation should be stepped on a dedicated thread
+  bool mSimulationThreaded;
+
+  /// The simulation thread
+  std::thread mSimulationThread;
+
+  /// The World that the simulation thread is stepping
+  std::shared_ptr<dart::simulation::World> mThreadWorld;
+
+  /// Held by the simulation thread while it modifies or reads the World
+  std::mutex mSimulationMutex;
+
+  /// Tells the simulation thread to finish
+  std::atomic<bool> mStopSimulationThread;
+
+  /// Copy of mSimulating for the simulation thread
+  std::atomic<bool> mThreadSimulating;
+
+  /// Copy of the target real time factor for the simulation thread
+  std::atomic<double> mThreadTargetRealTimeFactor;
+
+  /// Copy of the target real time lapse for the simulation thread
+  std::atomic<double> mThreadTargetRealTimeLapse;
+
+  /// Snapshots handed over from the simulation thread to the rendering side
+  std::unique_ptr<common::TripleBuffer<dart::simulation::WorldSnapshot>>
+      mSnapshots;
+
+  /// Simulation time of the last snapshot that was rendered while simulating
+  double mLastSnapshotTime;
 };
 
 } // namespace osg
@@ -77,12 +77,27 @@ ShapeFrameNode::ShapeFrameNode(
   : mShapeFrame(_frame),
     mWorldNode(_worldNode),
     mRenderShapeNode(nullptr),
+    mSnapshotState(nullptr),
     mUtilized(false)
 {
   refresh();
   setName(_frame->getName()+" [frame]");
 }
 
+//==============================================================================
+ShapeFrameNode::ShapeFrameNode(
+    const dart::simulation::WorldSnapshot::ShapeFrameState& state,
+    WorldNode* worldNode)
+  : mShapeFrame(state.mShapeFrame),
+    mWorldNode(worldNode),
+    mRenderShapeNode(nullptr),
+    mSnapshotState(nullptr),
+    mUtilized(false)
+{
+  refresh(state);
+  setName(mShapeFrame->getName()+" [frame]");
+}
+
 //==============================================================================
 dart::dynamics::ShapeFrame* ShapeFrameNode::getShapeFrame()
 {
@@ -115,21 +130,30 @@ void ShapeFrameNode::refresh(bool shortCircuitIfUtilized)
 
   mUtilized = true;
 
-  auto shape = mShapeFrame->getShape();
+  refreshRenderData(mShapeFrame->getWorldTransform(),
+                    mShapeFrame->getShape(),
+                    mShapeFrame->getVisualAspect() != nullptr);
+}
 
-  setMatrix(eigToOsgMatrix(mShapeFrame->getWorldTransform()));
-  // TODO(JS): Maybe the data varicance information should be in ShapeFrame and
-  // checked here.
+//==============================================================================
+void ShapeFrameNode::refresh(
+    const dart::simulation::WorldSnapshot::ShapeFrameState& state)
+{
+  if(mUtilized)
+    return;
 
-  if(shape && mShapeFrame->getVisualAspect())
-  {
-    refreshShapeNode(shape);
-  }
-  else if(mRenderShapeNode)
-  {
-    removeChild(mRenderShapeNode->getNode());
-    mRenderShapeNode = nullptr;
-  }
+  mUtilized = true;
+
+  mSnapshotState = &state;
+  refreshRenderData(state.mTransform, state.mShape, state.mHasVisualAspect);
+  mSnapshotState = nullptr;
+}
+
+//==============================================================================
+const dart::simulation::WorldSnapshot::ShapeFrameState*
+ShapeFrameNode::getSnapshotState() const
+{
+  return mSnapshotState;
 }
 
 //==============================================================================
@@ -150,6 +174,27 @@ ShapeFrameNode::~ShapeFrameNode()
   // Do nothing
 }
 
+//==============================================================================
+void ShapeFrameNode::refreshRenderData(
+    const Eigen::Isometry3d& transform,
+    const std::shared_ptr<dart::dynamics::Shape>& shape,
+    bool hasVisualAspect)
+{
+  setMatrix(eigToOsgMatrix(transform));
+  // TODO(JS): Maybe the data varicance information should be in ShapeFrame and
+  // checked here.
+
+  if(shape && hasVisualAspect)
+  {
+    refreshShapeNode(shape);
+  }
+  else if(mRenderShapeNode)
+  {
+    removeChild(mRenderShapeNode->getNode());
+    mRenderShapeNode = nullptr;
+  }
+}
+
 //==============================================================================
 void ShapeFrameNode::refreshShapeNode(
     const std::shared_ptr<dart::dynamics::Shape>& shape)
@@ -37,6 +37,7 @@
 #include <memory>
 #include <osg/MatrixTransform>
 #include "dart/dynamics/SmartPointer.hpp"
+#include "dart/simulation/WorldSnapshot.hpp"
 
 namespace dart {
 namespace dynamics {
@@ -63,6 +64,12 @@ public:
   ShapeFrameNode(dart::dynamics::ShapeFrame* frame,
                  WorldNode* worldNode);
 
+  /// Create a ShapeFrameNode from the state of a ShapeFrame that was recorded
+  /// in a WorldSnapshot
+  ShapeFrameNode(
+      const dart::simulation::WorldSnapshot::ShapeFrameState& state,
+      WorldNode* worldNode);
+
   /// Pointer to the ShapeFrame associated with this ShapeFrameNode
   dart::dynamics::ShapeFrame* getShapeFrame();
 
@@ -80,6 +87,17 @@ public:
   /// this function if short circuiting is going to be used.
   void refresh(bool shortCircuitIfUtilized = false);
 
+  /// Update all rendering data for this ShapeFrame from a state recorded in a
+  /// WorldSnapshot rather than from the ShapeFrame itself. This skips the
+  /// refresh process if mUtilized is already set to true.
+  void refresh(const dart::simulation::WorldSnapshot::ShapeFrameState& state);
+
+  /// Returns the state that this ShapeFrameNode is being refreshed from, or
+  /// nullptr if it is not being refreshed from a WorldSnapshot. The render
+  /// nodes read the colors and soft mesh vertices from this state, if any.
+  const dart::simulation::WorldSnapshot::ShapeFrameState*
+  getSnapshotState() const;
+
   /// True iff this ShapeFrameNode has been utilized on the latest update
   bool wasUtilized() const;
 
@@ -92,6 +110,12 @@ protected:
 
   void refreshShapeNode(const std::shared_ptr<dart::dynamics::Shape>& shape);
 
+  /// Update the transform and the render node of the shape
+  void refreshRenderData(
+      const Eigen::Isometry3d& transform,
+      const std::shared_ptr<dart::dynamics::Shape>& shape,
+      bool hasVisualAspect);
+
   void createShapeNode(const std::shared_ptr<dart::dynamics::Shape>& shape);
 
   /// Pointer to the ShapeFrame that this ShapeFrameNode is associated with
@@ -102,6 +126,9 @@ protected:
 
   render::ShapeNode* mRenderShapeNode;
 
+  /// State that this ShapeFrameNode is being refreshed from, if any
+  const dart::simulation::WorldSnapshot::ShapeFrameState* mSnapshotState;
+
   /// True iff this ShapeFrameNode has been utilized on the latest update.
   /// If it has not, that is an indication that it is no longer being
   /// used and should be deleted.
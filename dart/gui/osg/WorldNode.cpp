@@ -217,12 +217,12 @@ void WorldNode::clearUnusedNodes()
   for(dart::dynamics::Frame* frame : unused)
   {
     NodeMap::iterator it = mFrameToNode.find(frame);
-    ShapeFrameNode* node = it->second;
-    if(!node->getShapeFrame() || !node->getShapeFrame()->hasVisualAspect() || !node->getShapeFrame()->getVisualAspect(true)->getShadowed()) {
-      mNormalGroup->removeChild(node);
-    }
-    else
-      mShadowedGroup->removeChild(node);
+    ::osg::ref_ptr<ShapeFrameNode> node = it->second;
+    // Remove the node from whichever group it is in, without asking the
+    // ShapeFrame, which may have been destroyed or may be being simulated on
+    // another thread
+    while(node->getNumParents() > 0)
+      node->getParent(0)->removeChild(node.get());
     mFrameToNode.erase(it);
   }
 }
@@ -322,6 +322,48 @@ void WorldNode::refreshShapeFrameNode(dart::dynamics::Frame* frame)
     mShadowedGroup->addChild(node);
 }
 
+//==============================================================================
+void WorldNode::refreshSnapshot(
+    const dart::simulation::WorldSnapshot& snapshot)
+{
+  for(const auto& state : snapshot.getShapeFrameStates())
+    refreshShapeFrameNode(state);
+}
+
+//==============================================================================
+void WorldNode::refreshShapeFrameNode(
+    const dart::simulation::WorldSnapshot::ShapeFrameState& state)
+{
+  ::osg::Group* group = state.mShadowed ? mShadowedGroup.get()
+                                        : mNormalGroup.get();
+
+  std::pair<NodeMap::iterator, bool> insertion =
+      mFrameToNode.insert(std::make_pair(state.mShapeFrame, nullptr));
+  NodeMap::iterator it = insertion.first;
+  bool inserted = insertion.second;
+
+  if(!inserted)
+  {
+    ::osg::ref_ptr<ShapeFrameNode> node = it->second;
+    if(!node)
+      return;
+
+    // update the group that ShapeFrameNode should be
+    if(node->getParent(0) != group)
+    {
+      node->getParent(0)->removeChild(node);
+      group->addChild(node);
+    }
+
+    node->refresh(state);
+    return;
+  }
+
+  ::osg::ref_ptr<ShapeFrameNode> node = new ShapeFrameNode(state, this);
+  it->second = node;
+  group->addChild(node);
+}
+
 //==============================================================================
 bool WorldNode::isShadowed() const
 {
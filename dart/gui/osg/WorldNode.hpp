@@ -39,6 +39,7 @@
 #include <memory>
 
 #include "dart/gui/osg/Viewer.hpp"
+#include "dart/simulation/WorldSnapshot.hpp"
 
 namespace dart {
 
@@ -173,6 +174,16 @@ protected:
 
   void refreshShapeFrameNode(dart::dynamics::Frame* frame);
 
+  /// Refresh the rendering data of all the ShapeFrames in a snapshot. The
+  /// transforms, the colors and visibility of the VisualAspects, and the
+  /// vertices of SoftMeshShapes are read from the snapshot. The other
+  /// parameters of the Shapes, and the names of newly seen ShapeFrames, are
+  /// still read from the Shapes and Frames, which the snapshot keeps alive.
+  void refreshSnapshot(const dart::simulation::WorldSnapshot& snapshot);
+
+  void refreshShapeFrameNode(
+      const dart::simulation::WorldSnapshot::ShapeFrameState& state);
+
   using NodeMap = std::unordered_map<dart::dynamics::Frame*, ShapeFrameNode*>;
 
   /// Map from Frame pointers to FrameNode pointers
@@ -69,7 +69,7 @@ class BoxShapeDrawable : public ::osg::ShapeDrawable
 public:
 
   BoxShapeDrawable(dart::dynamics::BoxShape* shape,
-                   dart::dynamics::VisualAspect* visualAspect);
+                   BoxShapeGeode* parent);
 
   void refresh(bool firstTime);
 
@@ -78,7 +78,7 @@ protected:
   virtual ~BoxShapeDrawable();
 
   dart::dynamics::BoxShape* mBoxShape;
-  dart::dynamics::VisualAspect* mVisualAspect;
+  BoxShapeGeode* mParent;
 
 };
 
@@ -90,7 +90,7 @@ BoxShapeNode::BoxShapeNode(std::shared_ptr<dart::dynamics::BoxShape> shape,
     mGeode(nullptr)
 {
   extractData(true);
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 }
 
 //==============================================================================
@@ -98,7 +98,7 @@ void BoxShapeNode::refresh()
 {
   mUtilized = true;
 
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 
   if(mShape->getDataVariance() == dart::dynamics::Shape::STATIC)
     return;
@@ -150,7 +150,7 @@ void BoxShapeGeode::extractData()
 {
   if(nullptr == mDrawable)
   {
-    mDrawable = new BoxShapeDrawable(mBoxShape.get(), mVisualAspect);
+    mDrawable = new BoxShapeDrawable(mBoxShape.get(), this);
     addDrawable(mDrawable);
     return;
   }
@@ -166,9 +166,9 @@ BoxShapeGeode::~BoxShapeGeode()
 
 //==============================================================================
 BoxShapeDrawable::BoxShapeDrawable(dart::dynamics::BoxShape* shape,
-                                   dart::dynamics::VisualAspect* visualAspect)
+                                   BoxShapeGeode* parent)
   : mBoxShape(shape),
-    mVisualAspect(visualAspect)
+    mParent(parent)
 {
   refresh(true);
 }
@@ -194,7 +194,7 @@ void BoxShapeDrawable::refresh(bool firstTime)
   if(mBoxShape->checkDataVariance(dart::dynamics::Shape::DYNAMIC_COLOR)
      || firstTime)
   {
-    setColor(eigToOsgVec4(mVisualAspect->getRGBA()));
+    setColor(eigToOsgVec4(mParent->getRGBA()));
   }
 }
 
@@ -71,7 +71,6 @@ class CapsuleShapeDrawable : public ::osg::ShapeDrawable
 public:
 
   CapsuleShapeDrawable(dart::dynamics::CapsuleShape* shape,
-                       dart::dynamics::VisualAspect* visualAspect,
                        CapsuleShapeGeode* parent);
 
   void refresh(bool firstTime);
@@ -81,7 +80,6 @@ protected:
   virtual ~CapsuleShapeDrawable();
 
   dart::dynamics::CapsuleShape* mCapsuleShape;
-  dart::dynamics::VisualAspect* mVisualAspect;
 
   CapsuleShapeGeode* mParent;
 
@@ -96,7 +94,7 @@ CapsuleShapeNode::CapsuleShapeNode(
     mGeode(nullptr)
 {
   extractData(true);
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 }
 
 //==============================================================================
@@ -104,7 +102,7 @@ void CapsuleShapeNode::refresh()
 {
   mUtilized = true;
 
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 
   if(mShape->getDataVariance() == dart::dynamics::Shape::STATIC)
     return;
@@ -157,7 +155,7 @@ void CapsuleShapeGeode::extractData()
 {
   if(nullptr == mDrawable)
   {
-    mDrawable = new CapsuleShapeDrawable(mCapsuleShape, mVisualAspect, this);
+    mDrawable = new CapsuleShapeDrawable(mCapsuleShape, this);
     addDrawable(mDrawable);
     return;
   }
@@ -174,10 +172,8 @@ CapsuleShapeGeode::~CapsuleShapeGeode()
 //==============================================================================
 CapsuleShapeDrawable::CapsuleShapeDrawable(
     dart::dynamics::CapsuleShape* shape,
-    dart::dynamics::VisualAspect* visualAspect,
     CapsuleShapeGeode* parent)
   : mCapsuleShape(shape),
-    mVisualAspect(visualAspect),
     mParent(parent)
 {
   refresh(true);
@@ -205,7 +201,7 @@ void CapsuleShapeDrawable::refresh(bool firstTime)
   if(mCapsuleShape->checkDataVariance(dart::dynamics::Shape::DYNAMIC_COLOR)
      || firstTime)
   {
-    setColor(eigToOsgVec4(mVisualAspect->getRGBA()));
+    setColor(eigToOsgVec4(mParent->getRGBA()));
   }
 }
 
@@ -71,7 +71,6 @@ class ConeShapeDrawable : public ::osg::ShapeDrawable
 public:
 
   ConeShapeDrawable(dart::dynamics::ConeShape* shape,
-                    dart::dynamics::VisualAspect* visualAspect,
                     ConeShapeGeode* parent);
 
   void refresh(bool firstTime);
@@ -81,7 +80,6 @@ protected:
   virtual ~ConeShapeDrawable();
 
   dart::dynamics::ConeShape* mConeShape;
-  dart::dynamics::VisualAspect* mVisualAspect;
 
   ConeShapeGeode* mParent;
 
@@ -96,7 +94,7 @@ ConeShapeNode::ConeShapeNode(
     mGeode(nullptr)
 {
   extractData(true);
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 }
 
 //==============================================================================
@@ -104,7 +102,7 @@ void ConeShapeNode::refresh()
 {
   mUtilized = true;
 
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 
   if(mShape->getDataVariance() == dart::dynamics::Shape::STATIC)
     return;
@@ -157,7 +155,7 @@ void ConeShapeGeode::extractData()
 {
   if(nullptr == mDrawable)
   {
-    mDrawable = new ConeShapeDrawable(mConeShape, mVisualAspect, this);
+    mDrawable = new ConeShapeDrawable(mConeShape, this);
     addDrawable(mDrawable);
     return;
   }
@@ -174,10 +172,8 @@ ConeShapeGeode::~ConeShapeGeode()
 //==============================================================================
 ConeShapeDrawable::ConeShapeDrawable(
     dart::dynamics::ConeShape* shape,
-    dart::dynamics::VisualAspect* visualAspect,
     ConeShapeGeode* parent)
   : mConeShape(shape),
-    mVisualAspect(visualAspect),
     mParent(parent)
 {
   refresh(true);
@@ -205,7 +201,7 @@ void ConeShapeDrawable::refresh(bool firstTime)
   if(mConeShape->checkDataVariance(dart::dynamics::Shape::DYNAMIC_COLOR)
      || firstTime)
   {
-    setColor(eigToOsgVec4(mVisualAspect->getRGBA()));
+    setColor(eigToOsgVec4(mParent->getRGBA()));
   }
 }
 
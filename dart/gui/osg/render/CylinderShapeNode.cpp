@@ -70,7 +70,6 @@ class CylinderShapeDrawable : public ::osg::ShapeDrawable
 public:
 
   CylinderShapeDrawable(dart::dynamics::CylinderShape* shape,
-                        dart::dynamics::VisualAspect* visualAspect,
                         CylinderShapeGeode* parent);
 
   void refresh(bool firstTime);
@@ -80,7 +79,6 @@ protected:
   virtual ~CylinderShapeDrawable();
 
   dart::dynamics::CylinderShape* mCylinderShape;
-  dart::dynamics::VisualAspect* mVisualAspect;
 
   CylinderShapeGeode* mParent;
 
@@ -95,7 +93,7 @@ CylinderShapeNode::CylinderShapeNode(
     mGeode(nullptr)
 {
   extractData(true);
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 }
 
 //==============================================================================
@@ -103,7 +101,7 @@ void CylinderShapeNode::refresh()
 {
   mUtilized = true;
 
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 
   if(mShape->getDataVariance() == dart::dynamics::Shape::STATIC)
     return;
@@ -156,7 +154,7 @@ void CylinderShapeGeode::extractData()
 {
   if(nullptr == mDrawable)
   {
-    mDrawable = new CylinderShapeDrawable(mCylinderShape, mVisualAspect, this);
+    mDrawable = new CylinderShapeDrawable(mCylinderShape, this);
     addDrawable(mDrawable);
     return;
   }
@@ -173,10 +171,8 @@ CylinderShapeGeode::~CylinderShapeGeode()
 //==============================================================================
 CylinderShapeDrawable::CylinderShapeDrawable(
     dart::dynamics::CylinderShape* shape,
-    dart::dynamics::VisualAspect* visualAspect,
     CylinderShapeGeode* parent)
   : mCylinderShape(shape),
-    mVisualAspect(visualAspect),
     mParent(parent)
 {
   refresh(true);
@@ -204,7 +200,7 @@ void CylinderShapeDrawable::refresh(bool firstTime)
   if(mCylinderShape->checkDataVariance(dart::dynamics::Shape::DYNAMIC_COLOR)
      || firstTime)
   {
-    setColor(eigToOsgVec4(mVisualAspect->getRGBA()));
+    setColor(eigToOsgVec4(mParent->getRGBA()));
   }
 }
 
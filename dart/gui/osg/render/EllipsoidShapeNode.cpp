@@ -73,7 +73,6 @@ class EllipsoidShapeDrawable : public ::osg::ShapeDrawable
 public:
 
   EllipsoidShapeDrawable(dart::dynamics::EllipsoidShape* shape,
-                         dart::dynamics::VisualAspect* visualAspect,
                          EllipsoidShapeGeode* parent);
 
   void refresh(bool firstTime);
@@ -83,7 +82,6 @@ protected:
   virtual ~EllipsoidShapeDrawable();
 
   dart::dynamics::EllipsoidShape* mEllipsoidShape;
-  dart::dynamics::VisualAspect* mVisualAspect;
   EllipsoidShapeGeode* mParent;
 
 };
@@ -97,7 +95,7 @@ EllipsoidShapeNode::EllipsoidShapeNode(
     mGeode(nullptr)
 {
   extractData(true);
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 }
 
 //==============================================================================
@@ -105,7 +103,7 @@ void EllipsoidShapeNode::refresh()
 {
   mUtilized = true;
 
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 
   if(mShape->getDataVariance() == dart::dynamics::Shape::STATIC)
     return;
@@ -176,7 +174,7 @@ void EllipsoidShapeGeode::extractData()
 {
   if(nullptr == mDrawable)
   {
-    mDrawable = new EllipsoidShapeDrawable(mEllipsoidShape, mVisualAspect, this);
+    mDrawable = new EllipsoidShapeDrawable(mEllipsoidShape, this);
     addDrawable(mDrawable);
     return;
   }
@@ -193,10 +191,8 @@ EllipsoidShapeGeode::~EllipsoidShapeGeode()
 //==============================================================================
 EllipsoidShapeDrawable::EllipsoidShapeDrawable(
     dart::dynamics::EllipsoidShape* shape,
-    dart::dynamics::VisualAspect* visualAspect,
     EllipsoidShapeGeode* parent)
   : mEllipsoidShape(shape),
-    mVisualAspect(visualAspect),
     mParent(parent)
 {
   refresh(true);
@@ -224,7 +220,7 @@ void EllipsoidShapeDrawable::refresh(bool firstTime)
   if(mEllipsoidShape->checkDataVariance(dart::dynamics::Shape::DYNAMIC_COLOR)
      || firstTime)
   {
-    setColor(eigToOsgVec4(mVisualAspect->getRGBA()));
+    setColor(eigToOsgVec4(mParent->getRGBA()));
   }
 }
 
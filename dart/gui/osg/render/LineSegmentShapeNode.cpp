@@ -74,7 +74,7 @@ class LineSegmentShapeDrawable : public ::osg::Geometry
 public:
 
   LineSegmentShapeDrawable(dart::dynamics::LineSegmentShape* shape,
-                           dart::dynamics::VisualAspect* visualAspect);
+                           LineSegmentShapeGeode* parent);
 
   void refresh(bool firstTime);
 
@@ -83,7 +83,7 @@ protected:
   virtual ~LineSegmentShapeDrawable();
 
   dart::dynamics::LineSegmentShape* mLineSegmentShape;
-  dart::dynamics::VisualAspect* mVisualAspect;
+  LineSegmentShapeGeode* mParent;
 
   ::osg::ref_ptr<::osg::Vec3Array> mVertices;
   ::osg::ref_ptr<::osg::Vec4Array> mColors;
@@ -99,7 +99,7 @@ LineSegmentShapeNode::LineSegmentShapeNode(
 {
   mNode = this;
   extractData(true);
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 }
 
 //==============================================================================
@@ -107,7 +107,7 @@ void LineSegmentShapeNode::refresh()
 {
   mUtilized = true;
 
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 
   if(mShape->getDataVariance() == dart::dynamics::Shape::STATIC)
     return;
@@ -168,7 +168,7 @@ void LineSegmentShapeGeode::extractData(bool firstTime)
 
   if(nullptr == mDrawable)
   {
-    mDrawable = new LineSegmentShapeDrawable(mLineSegmentShape.get(), mVisualAspect);
+    mDrawable = new LineSegmentShapeDrawable(mLineSegmentShape.get(), this);
     addDrawable(mDrawable);
     return;
   }
@@ -185,9 +185,9 @@ LineSegmentShapeGeode::~LineSegmentShapeGeode()
 //==============================================================================
 LineSegmentShapeDrawable::LineSegmentShapeDrawable(
     dart::dynamics::LineSegmentShape* shape,
-    dart::dynamics::VisualAspect* visualAspect)
+    LineSegmentShapeGeode* parent)
   : mLineSegmentShape(shape),
-    mVisualAspect(visualAspect),
+    mParent(parent),
     mVertices(new ::osg::Vec3Array),
     mColors(new ::osg::Vec4Array)
 {
@@ -244,7 +244,7 @@ void LineSegmentShapeDrawable::refresh(bool firstTime)
     if(mColors->size() != 1)
       mColors->resize(1);
 
-    (*mColors)[0] = eigToOsgVec4(mVisualAspect->getRGBA());
+    (*mColors)[0] = eigToOsgVec4(mParent->getRGBA());
 
     setColorArray(mColors, ::osg::Array::BIND_OVERALL);
   }
@@ -180,7 +180,7 @@ MeshShapeNode::MeshShapeNode(std::shared_ptr<dart::dynamics::MeshShape> shape,
     mRootAiNode(nullptr)
 {
   extractData(true);
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 }
 
 //==============================================================================
@@ -188,7 +188,7 @@ void MeshShapeNode::refresh()
 {
   mUtilized = true;
 
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 
   if(mShape->getDataVariance() == dart::dynamics::Shape::STATIC)
     return;
@@ -741,7 +741,7 @@ void MeshShapeGeometry::extractData(bool firstTime)
     if(!isColored
        || mMeshShape->getColorMode() == dart::dynamics::MeshShape::SHAPE_COLOR)
     {
-      const Eigen::Vector4d& c = mVisualAspect->getRGBA();
+      const Eigen::Vector4d c = getRGBA();
 
       if(mColors->size() != 1)
         mColors->resize(1);
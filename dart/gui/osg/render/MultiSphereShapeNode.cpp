@@ -74,7 +74,6 @@ class MultiSphereShapeDrawable : public ::osg::ShapeDrawable
 public:
 
   MultiSphereShapeDrawable(dart::dynamics::MultiSphereConvexHullShape* shape,
-                           dart::dynamics::VisualAspect* visualAspect,
                            MultiSphereShapeGeode* parent);
 
   void refresh(bool firstTime);
@@ -84,7 +83,6 @@ protected:
   virtual ~MultiSphereShapeDrawable();
 
   dart::dynamics::MultiSphereConvexHullShape* mMultiSphereShape;
-  dart::dynamics::VisualAspect* mVisualAspect;
   MultiSphereShapeGeode* mParent;
 
 };
@@ -98,7 +96,7 @@ MultiSphereShapeNode::MultiSphereShapeNode(
     mGeode(nullptr)
 {
   extractData(true);
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 }
 
 //==============================================================================
@@ -106,7 +104,7 @@ void MultiSphereShapeNode::refresh()
 {
   mUtilized = true;
 
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 
   if(mShape->getDataVariance() == dart::dynamics::Shape::STATIC)
     return;
@@ -162,7 +160,7 @@ void MultiSphereShapeGeode::extractData()
   if(nullptr == mDrawable)
   {
     mDrawable = new MultiSphereShapeDrawable(
-          mMultiSphereShape, mVisualAspect, this);
+          mMultiSphereShape, this);
     addDrawable(mDrawable);
     return;
   }
@@ -179,10 +177,8 @@ MultiSphereShapeGeode::~MultiSphereShapeGeode()
 //==============================================================================
 MultiSphereShapeDrawable::MultiSphereShapeDrawable(
     dart::dynamics::MultiSphereConvexHullShape* shape,
-    dart::dynamics::VisualAspect* visualAspect,
     MultiSphereShapeGeode* parent)
   : mMultiSphereShape(shape),
-    mVisualAspect(visualAspect),
     mParent(parent)
 {
   refresh(true);
@@ -221,7 +217,7 @@ void MultiSphereShapeDrawable::refresh(bool firstTime)
        dart::dynamics::Shape::DYNAMIC_COLOR)
      || firstTime)
   {
-    setColor(eigToOsgVec4(mVisualAspect->getRGBA()));
+    setColor(eigToOsgVec4(mParent->getRGBA()));
   }
 }
 
@@ -70,7 +70,6 @@ class PlaneShapeDrawable : public ::osg::ShapeDrawable
 public:
 
   PlaneShapeDrawable(dart::dynamics::PlaneShape* shape,
-                     dart::dynamics::VisualAspect* visualAspect,
                      PlaneShapeGeode* parent);
 
   void refresh(bool firstTime);
@@ -80,7 +79,6 @@ protected:
   virtual ~PlaneShapeDrawable();
 
   dart::dynamics::PlaneShape* mPlaneShape;
-  dart::dynamics::VisualAspect* mVisualAspect;
   PlaneShapeGeode* mParent;
 
 };
@@ -94,7 +92,7 @@ PlaneShapeNode::PlaneShapeNode(
     mGeode(nullptr)
 {
   extractData(true);
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 }
 
 //==============================================================================
@@ -102,7 +100,7 @@ void PlaneShapeNode::refresh()
 {
   mUtilized = true;
 
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 
   if(mShape->getDataVariance() == dart::dynamics::Shape::STATIC)
     return;
@@ -154,7 +152,7 @@ void PlaneShapeGeode::extractData()
 {
   if(nullptr == mDrawable)
   {
-    mDrawable = new PlaneShapeDrawable(mPlaneShape, mVisualAspect, this);
+    mDrawable = new PlaneShapeDrawable(mPlaneShape, this);
     addDrawable(mDrawable);
     return;
   }
@@ -170,10 +168,8 @@ PlaneShapeGeode::~PlaneShapeGeode()
 
 //==============================================================================
 PlaneShapeDrawable::PlaneShapeDrawable(dart::dynamics::PlaneShape* shape,
-                                       dart::dynamics::VisualAspect* visualAspect,
                                        PlaneShapeGeode* parent)
   : mPlaneShape(shape),
-    mVisualAspect(visualAspect),
     mParent(parent)
 {
   refresh(true);
@@ -203,7 +199,7 @@ void PlaneShapeDrawable::refresh(bool firstTime)
   if(mPlaneShape->checkDataVariance(dart::dynamics::Shape::DYNAMIC_COLOR)
      || firstTime)
   {
-    setColor(eigToOsgVec4(mVisualAspect->getRGBA()));
+    setColor(eigToOsgVec4(mParent->getRGBA()));
   }
 }
 
@@ -48,7 +48,10 @@ ShapeNode::ShapeNode(std::shared_ptr<dart::dynamics::Shape> shape,
     mUtilized(true)
 {
   mShapeFrame = mParentShapeFrameNode->getShapeFrame();
-  mVisualAspect = mShapeFrame->getVisualAspect();
+
+  const auto* state = mParentShapeFrameNode->getSnapshotState();
+  mVisualAspect
+      = state ? state->mVisualAspect : mShapeFrame->getVisualAspect();
   assert(mVisualAspect);
 }
 
@@ -82,6 +85,26 @@ const dart::dynamics::VisualAspect* ShapeNode::getVisualAspect() const
   return mVisualAspect;
 }
 
+//==============================================================================
+bool ShapeNode::isHidden() const
+{
+  const auto* state = mParentShapeFrameNode->getSnapshotState();
+  if (state)
+    return state->mHidden;
+
+  return mVisualAspect->isHidden();
+}
+
+//==============================================================================
+Eigen::Vector4d ShapeNode::getRGBA() const
+{
+  const auto* state = mParentShapeFrameNode->getSnapshotState();
+  if (state)
+    return state->mRGBA;
+
+  return mVisualAspect->getRGBA();
+}
+
 //==============================================================================
 ::osg::Node* ShapeNode::getNode()
 {
@@ -36,6 +36,8 @@
 #include <memory>
 #include <osg/Node>
 
+#include <Eigen/Core>
+
 namespace dart {
 
 namespace dynamics {
@@ -89,6 +91,15 @@ public:
   /// Update all rendering data for this ShapeNode
   virtual void refresh() = 0;
 
+  /// Returns true iff the VisualAspect is hidden. This is read from the
+  /// WorldSnapshot that the parent ShapeFrameNode is being refreshed from, if
+  /// any, or else from the VisualAspect itself.
+  bool isHidden() const;
+
+  /// Returns the color of the VisualAspect, including its alpha. This is read
+  /// from the same place as isHidden().
+  Eigen::Vector4d getRGBA() const;
+
   /// True iff this ShapeNode has been utilized on the latest update
   bool wasUtilized() const;
 
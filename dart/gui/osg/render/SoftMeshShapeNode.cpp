@@ -35,6 +35,7 @@
 
 #include "dart/gui/osg/render/SoftMeshShapeNode.hpp"
 #include "dart/gui/osg/Utils.hpp"
+#include "dart/gui/osg/ShapeFrameNode.hpp"
 
 #include "dart/dynamics/SoftMeshShape.hpp"
 #include "dart/dynamics/SoftBodyNode.hpp"
@@ -62,7 +63,6 @@ protected:
   virtual ~SoftMeshShapeGeode();
 
   dart::dynamics::SoftMeshShape* mSoftMeshShape;
-  dart::dynamics::VisualAspect* mVisualAspect;
   SoftMeshShapeDrawable* mDrawable;
 
 };
@@ -73,7 +73,7 @@ class SoftMeshShapeDrawable : public ::osg::Geometry
 public:
 
   SoftMeshShapeDrawable(dart::dynamics::SoftMeshShape* shape,
-                        dart::dynamics::VisualAspect* visualAspect);
+                        SoftMeshShapeGeode* parent);
 
   void refresh(bool firstTime);
 
@@ -87,8 +87,13 @@ protected:
 
   std::vector<Eigen::Vector3d> mEigNormals;
 
+  /// Vertices and faces read from the SoftBodyNode when the mesh is not
+  /// refreshed from a WorldSnapshot
+  std::vector<Eigen::Vector3d> mEigVertices;
+  std::vector<Eigen::Vector3i> mEigFaces;
+
   dart::dynamics::SoftMeshShape* mSoftMeshShape;
-  dart::dynamics::VisualAspect* mVisualAspect;
+  SoftMeshShapeGeode* mParent;
 
 };
 
@@ -101,7 +106,7 @@ SoftMeshShapeNode::SoftMeshShapeNode(
     mGeode(nullptr)
 {
   extractData(true);
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 }
 
 //==============================================================================
@@ -109,7 +114,7 @@ void SoftMeshShapeNode::refresh()
 {
   mUtilized = true;
 
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 
   if(mShape->getDataVariance() == dart::dynamics::Shape::STATIC)
     return;
@@ -143,7 +148,6 @@ SoftMeshShapeGeode::SoftMeshShapeGeode(
     SoftMeshShapeNode* parentNode)
   : ShapeNode(parentNode->getShape(), parentShapeFrame, this),
     mSoftMeshShape(shape),
-    mVisualAspect(parentNode->getVisualAspect()),
     mDrawable(nullptr)
 {
   getOrCreateStateSet()->setMode(GL_BLEND, ::osg::StateAttribute::ON);
@@ -163,7 +167,7 @@ void SoftMeshShapeGeode::extractData()
 {
   if(nullptr == mDrawable)
   {
-    mDrawable = new SoftMeshShapeDrawable(mSoftMeshShape, mVisualAspect);
+    mDrawable = new SoftMeshShapeDrawable(mSoftMeshShape, this);
     addDrawable(mDrawable);
     return;
   }
@@ -180,23 +184,24 @@ SoftMeshShapeGeode::~SoftMeshShapeGeode()
 //==============================================================================
 SoftMeshShapeDrawable::SoftMeshShapeDrawable(
     dart::dynamics::SoftMeshShape* shape,
-    dart::dynamics::VisualAspect* visualAspect)
+    SoftMeshShapeGeode* parent)
   : mVertices(new ::osg::Vec3Array),
     mNormals(new ::osg::Vec3Array),
     mColors(new ::osg::Vec4Array),
     mSoftMeshShape(shape),
-    mVisualAspect(visualAspect)
+    mParent(parent)
 {
   refresh(true);
 }
 
-static Eigen::Vector3d normalFromVertex(const dart::dynamics::SoftBodyNode* bn,
-                                        const Eigen::Vector3i& face,
-                                        std::size_t v)
+static Eigen::Vector3d normalFromVertex(
+    const std::vector<Eigen::Vector3d>& vertices,
+    const Eigen::Vector3i& face,
+    std::size_t v)
 {
-  const Eigen::Vector3d& v0 = bn->getPointMass(face[v])->getLocalPosition();
-  const Eigen::Vector3d& v1 = bn->getPointMass(face[(v+1)%3])->getLocalPosition();
-  const Eigen::Vector3d& v2 = bn->getPointMass(face[(v+2)%3])->getLocalPosition();
+  const Eigen::Vector3d& v0 = vertices[face[v]];
+  const Eigen::Vector3d& v1 = vertices[face[(v+1)%3]];
+  const Eigen::Vector3d& v2 = vertices[face[(v+2)%3]];
 
   const Eigen::Vector3d dv1 = v1-v0;
   const Eigen::Vector3d dv2 = v2-v0;
@@ -209,16 +214,16 @@ static Eigen::Vector3d normalFromVertex(const dart::dynamics::SoftBodyNode* bn,
 }
 
 static void computeNormals(std::vector<Eigen::Vector3d>& normals,
-                           const dart::dynamics::SoftBodyNode* bn)
+                           const std::vector<Eigen::Vector3d>& vertices,
+                           const std::vector<Eigen::Vector3i>& faces)
 {
   for(std::size_t i=0; i<normals.size(); ++i)
     normals[i] = Eigen::Vector3d::Zero();
 
-  for(std::size_t i=0; i<bn->getNumFaces(); ++i)
+  for(const Eigen::Vector3i& face : faces)
   {
-    const Eigen::Vector3i& face = bn->getFace(i);
     for(std::size_t j=0; j<3; ++j)
-      normals[face[j]] += normalFromVertex(bn, face, j);
+      normals[face[j]] += normalFromVertex(vertices, face, j);
   }
 
   for(std::size_t i=0; i<normals.size(); ++i)
@@ -233,18 +238,42 @@ void SoftMeshShapeDrawable::refresh(bool firstTime)
   else
     setDataVariance(::osg::Object::DYNAMIC);
 
-  const dart::dynamics::SoftBodyNode* bn = mSoftMeshShape->getSoftBodyNode();
+  // The PointMasses are moved by World::step(), so read them from the
+  // snapshot of the World if the mesh is being refreshed from one
+  const auto* state = mParent->getParentShapeFrameNode()->getSnapshotState();
+  const std::vector<Eigen::Vector3d>* vertices = nullptr;
+  const std::vector<Eigen::Vector3i>* faces = nullptr;
+  if(state)
+  {
+    vertices = &state->mSoftMeshVertices;
+    faces = &state->mSoftMeshFaces;
+  }
+  else
+  {
+    const dart::dynamics::SoftBodyNode* bn =
+        mSoftMeshShape->getSoftBodyNode();
+
+    mEigVertices.resize(bn->getNumPointMasses());
+    for(std::size_t i=0; i < bn->getNumPointMasses(); ++i)
+      mEigVertices[i] = bn->getPointMass(i)->getLocalPosition();
+
+    mEigFaces.resize(bn->getNumFaces());
+    for(std::size_t i=0; i < bn->getNumFaces(); ++i)
+      mEigFaces[i] = bn->getFace(i);
+
+    vertices = &mEigVertices;
+    faces = &mEigFaces;
+  }
 
   if(mSoftMeshShape->checkDataVariance(dart::dynamics::Shape::DYNAMIC_ELEMENTS)
      || firstTime)
   {
     ::osg::ref_ptr<::osg::DrawElementsUInt> elements =
         new ::osg::DrawElementsUInt(GL_TRIANGLES);
-    elements->reserve(3*bn->getNumFaces());
+    elements->reserve(3*faces->size());
 
-    for(std::size_t i=0; i < bn->getNumFaces(); ++i)
+    for(const Eigen::Vector3i& F : *faces)
     {
-      const Eigen::Vector3i& F = bn->getFace(i);
       for(std::size_t j=0; j<3; ++j)
         elements->push_back(F[j]);
     }
@@ -256,19 +285,21 @@ void SoftMeshShapeDrawable::refresh(bool firstTime)
      || mSoftMeshShape->checkDataVariance(dart::dynamics::Shape::DYNAMIC_ELEMENTS)
      || firstTime)
   {
-    if(mVertices->size() != bn->getNumPointMasses())
-      mVertices->resize(bn->getNumPointMasses());
+    const std::size_t numVertices = vertices->size();
+
+    if(mVertices->size() != numVertices)
+      mVertices->resize(numVertices);
 
-    if(mNormals->size() != bn->getNumPointMasses())
-      mNormals->resize(bn->getNumPointMasses());
+    if(mNormals->size() != numVertices)
+      mNormals->resize(numVertices);
 
-    if(mEigNormals.size() != bn->getNumPointMasses())
-      mEigNormals.resize(bn->getNumPointMasses());
+    if(mEigNormals.size() != numVertices)
+      mEigNormals.resize(numVertices);
 
-    computeNormals(mEigNormals, bn);
-    for(std::size_t i=0; i<bn->getNumPointMasses(); ++i)
+    computeNormals(mEigNormals, *vertices, *faces);
+    for(std::size_t i=0; i<numVertices; ++i)
     {
-      (*mVertices)[i] = eigToOsgVec3(bn->getPointMass(i)->getLocalPosition());
+      (*mVertices)[i] = eigToOsgVec3((*vertices)[i]);
       (*mNormals)[i] = eigToOsgVec3(mEigNormals[i]);
     }
 
@@ -282,7 +313,7 @@ void SoftMeshShapeDrawable::refresh(bool firstTime)
     if(mColors->size() != 1)
       mColors->resize(1);
 
-    (*mColors)[0] = eigToOsgVec4(mVisualAspect->getRGBA());
+    (*mColors)[0] = eigToOsgVec4(mParent->getRGBA());
 
     setColorArray(mColors, ::osg::Array::BIND_OVERALL);
   }
@@ -73,7 +73,6 @@ class SphereShapeDrawable : public ::osg::ShapeDrawable
 public:
 
   SphereShapeDrawable(dart::dynamics::SphereShape* shape,
-                         dart::dynamics::VisualAspect* visualAspect,
                          SphereShapeGeode* parent);
 
   void refresh(bool firstTime);
@@ -83,7 +82,6 @@ protected:
   virtual ~SphereShapeDrawable();
 
   dart::dynamics::SphereShape* mSphereShape;
-  dart::dynamics::VisualAspect* mVisualAspect;
   SphereShapeGeode* mParent;
 
 };
@@ -97,7 +95,7 @@ SphereShapeNode::SphereShapeNode(
     mGeode(nullptr)
 {
   extractData(true);
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 }
 
 //==============================================================================
@@ -105,7 +103,7 @@ void SphereShapeNode::refresh()
 {
   mUtilized = true;
 
-  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+  setNodeMask(isHidden()? 0x0 : ~0x0);
 
   if(mShape->getDataVariance() == dart::dynamics::Shape::STATIC)
     return;
@@ -158,7 +156,7 @@ void SphereShapeGeode::extractData()
 {
   if(nullptr == mDrawable)
   {
-    mDrawable = new SphereShapeDrawable(mSphereShape, mVisualAspect, this);
+    mDrawable = new SphereShapeDrawable(mSphereShape, this);
     addDrawable(mDrawable);
     return;
   }
@@ -175,10 +173,8 @@ SphereShapeGeode::~SphereShapeGeode()
 //==============================================================================
 SphereShapeDrawable::SphereShapeDrawable(
     dart::dynamics::SphereShape* shape,
-    dart::dynamics::VisualAspect* visualAspect,
     SphereShapeGeode* parent)
   : mSphereShape(shape),
-    mVisualAspect(visualAspect),
     mParent(parent)
 {
   refresh(true);
@@ -205,7 +201,7 @@ void SphereShapeDrawable::refresh(bool firstTime)
   if(mSphereShape->checkDataVariance(dart::dynamics::Shape::DYNAMIC_COLOR)
      || firstTime)
   {
-    setColor(eigToOsgVec4(mVisualAspect->getRGBA()));
+    setColor(eigToOsgVec4(mParent->getRGBA()));
   }
 }
 
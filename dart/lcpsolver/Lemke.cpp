@@ -33,8 +33,6 @@
 #include "dart/lcpsolver/Lemke.hpp"
 
 #include <cmath>
-#include <iostream>
-#include <vector>
 
 #include "dart/math/Helpers.hpp"
 
@@ -57,121 +55,134 @@ namespace lcpsolver {
 //  return temp;
 // }
 
+namespace {
+
+/// Tolerance of the ratio test
+constexpr double zer_tol = 1e-5;
+
+/// Minimum pivot element
+constexpr double piv_tol = 1e-8;
+
+/// Number of column replacements before the basis is refactorized
+constexpr int maxNumEtas = 50;
+
+} // namespace
+
 //==============================================================================
-int Lemke(
-    const Eigen::MatrixXd& _M, const Eigen::VectorXd& _q, Eigen::VectorXd* _z)
+LemkeSolver::LemkeSolver()
+  : mMaxIterations(1000), mIsBaseNegativeIdentity(true), mNumEtas(0)
 {
-  int n = _q.size();
+  // Do nothing
+}
 
-  const double zer_tol = 1e-5;
-  const double piv_tol = 1e-8;
-  int maxiter = 1000;
+//==============================================================================
+int LemkeSolver::solve(
+    const Eigen::MatrixXd& M, const Eigen::VectorXd& q, Eigen::VectorXd* z)
+{
+  const int n = static_cast<int>(q.size());
   int err = 0;
 
-  if (_q.minCoeff() >= 0)
+  mBasis.clear();
+
+  if (q.minCoeff() >= 0)
   {
-    // LOG(INFO) << "Trivial solution exists.";
-    *_z = Eigen::VectorXd::Zero(n);
+    z->setZero(n);
+    mWarmStartBasis.clear();
     return err;
   }
 
-  // solve trivial case for n=1
-  //   if (n==1){
-  //     if (_M(0)>0){
-  //         *_z = (- _q(0)/_M(0) )*Eigen::VectorXd::Ones(n);
-  //         return err;
-  //     } else {
-  //         *_z = Eigen::VectorXd::Zero(n);
-  //         err = 4; // no solution
-  //         return err;
-  //     }
-  //   }
-
-  *_z = Eigen::VectorXd::Zero(2 * n);
-  int iter = 0;
-  // double theta = 0;
-  double ratio = 0;
-  int leaving = 0;
-  Eigen::VectorXd Be = Eigen::VectorXd::Constant(n, 1);
-  Eigen::VectorXd x = _q;
-  std::vector<int> bas;
-  std::vector<int> nonbas;
-
-  int t = 2 * n;
-  int entering = t;
+  resize(n);
 
-  bas.clear();
-  nonbas.clear();
+  // Build the initial basis where the warm start z variables come first and
+  // the w variables of the rest follow
+  std::fill(mIsInitialBasis.begin(), mIsInitialBasis.end(), 0);
+  mBasisVariables.clear();
+  for (const int index : mWarmStartBasis)
+  {
+    if (index < 0 || index >= n || mIsInitialBasis[index])
+      continue;
+
+    mIsInitialBasis[index] = 1;
+    mBasisVariables.push_back(index);
+  }
+  mWarmStartBasis.clear();
 
-  // TODO: here suppose initial guess z0 is [0,0,0,...], this contradicts to
-  // ODE's w always initilized as 0
+  const std::size_t numWarmStart = mBasisVariables.size();
   for (int i = 0; i < n; ++i)
   {
-    nonbas.push_back(i);
+    if (!mIsInitialBasis[i])
+      mBasisVariables.push_back(i + n);
   }
 
-  Eigen::MatrixXd B = -Eigen::MatrixXd::Identity(n, n);
+  mB.setIdentity();
+  mB *= -1.0;
+  mIsBaseNegativeIdentity = true;
+  mNumEtas = 0;
 
-  if (!bas.empty())
+  if (numWarmStart > 0u)
   {
-    Eigen::MatrixXd B_copy = B;
-    for (std::size_t i = 0; i < bas.size(); ++i)
+    for (std::size_t i = 0u; i < mBasisVariables.size(); ++i)
     {
-      B.col(i) = _M.col(bas[i]);
+      const int variable = mBasisVariables[i];
+      const auto col = static_cast<Eigen::Index>(i);
+      if (variable < n)
+        mB.col(col) = M.col(variable);
+      else
+        mB.col(col) = -Eigen::VectorXd::Unit(n, variable - n);
     }
-    for (std::size_t i = 0; i < nonbas.size(); ++i)
-    {
-      B.col(bas.size() + i) = B_copy.col(nonbas[i]);
-    }
-    // TODO: check the condition number to return err = 3
-    Eigen::JacobiSVD<Eigen::MatrixXd> svd(B);
-    double cond = svd.singularValues()(0)
-                  / svd.singularValues()(svd.singularValues().size() - 1);
-    if (cond > 1e16)
+
+    refactorize();
+    if (mLu.rcond() < 1e-16)
     {
-      (*_z) = Eigen::VectorXd::Zero(n);
-      err = 3;
-      return err;
+      // The warm start basis is singular. Fall back to the cold start.
+      for (int i = 0; i < n; ++i)
+        mBasisVariables[static_cast<std::size_t>(i)] = i + n;
+      mB.setIdentity();
+      mB *= -1.0;
+      mIsBaseNegativeIdentity = true;
     }
-    x = -B.householderQr().solve(_q);
   }
 
+  solveBasis(q, mX);
+  mX *= -1.0;
+
   // Check if initial basis provides solution
-  if (x.minCoeff() >= 0)
+  if (mX.minCoeff() >= 0)
   {
-    Eigen::VectorXd __z = Eigen::VectorXd::Zero(2 * n);
-    for (std::size_t i = 0; i < bas.size(); ++i)
+    z->setZero(n);
+    for (std::size_t i = 0u; i < mBasisVariables.size(); ++i)
     {
-      (__z).row(bas[i]) = x.row(i);
+      const int variable = mBasisVariables[i];
+      if (variable < n)
+      {
+        (*z)[variable] = mX[static_cast<Eigen::Index>(i)];
+        mBasis.push_back(variable);
+      }
     }
-    (*_z) = __z.head(n);
     return err;
   }
 
+  const int t = 2 * n;
+  int entering = t;
+
   // Determine initial leaving variable
-  Eigen::VectorXd minuxX = -x;
   int lvindex;
-  double tval = minuxX.maxCoeff(&lvindex);
-  for (std::size_t i = 0; i < nonbas.size(); ++i)
-  {
-    bas.push_back(nonbas[i] + n);
-  }
-  leaving = bas[lvindex];
+  const double tval = (-mX).maxCoeff(&lvindex);
+  int leaving = mBasisVariables[static_cast<std::size_t>(lvindex)];
 
-  bas[lvindex] = t; // pivoting in the artificial variable
+  // Pivot in the artificial variable
+  mBasisVariables[static_cast<std::size_t>(lvindex)] = t;
 
-  Eigen::VectorXd U = Eigen::VectorXd::Zero(n);
   for (int i = 0; i < n; ++i)
-  {
-    if (x[i] < 0)
-      U[i] = 1;
-  }
-  Be = -(B * U);
-  x += tval * U;
-  x[lvindex] = tval;
-  B.col(lvindex) = Be;
+    mU[i] = (mX[i] < 0) ? 1.0 : 0.0;
+  mBe.noalias() = -(mB * mU);
+  mX += tval * mU;
+  mX[lvindex] = tval;
+  mD = -mU;
+  replaceBasisColumn(lvindex, mBe, mD);
 
-  for (iter = 0; iter < maxiter; ++iter)
+  int iter = 0;
+  for (iter = 0; iter < mMaxIterations; ++iter)
   {
     if (leaving == t)
     {
@@ -180,161 +191,206 @@ int Lemke(
     else if (leaving < n)
     {
       entering = n + leaving;
-      Be = Eigen::VectorXd::Zero(n);
-      Be[leaving] = -1;
+      mBe.setZero();
+      mBe[leaving] = -1;
     }
     else
     {
       entering = leaving - n;
-      Be = _M.col(entering);
+      mBe = M.col(entering);
     }
 
-    Eigen::VectorXd d = B.householderQr().solve(Be);
+    solveBasis(mBe, mD);
 
     // Find new leaving variable
-    std::vector<int> j;
+    bool hasPivot = false;
+    double theta = 0.0;
     for (int i = 0; i < n; ++i)
     {
-      if (d[i] > piv_tol)
-        j.push_back(i);
+      if (mD[i] <= piv_tol)
+        continue;
+
+      const double ratio = (mX[i] + zer_tol) / mD[i];
+      if (!hasPivot || ratio < theta)
+        theta = ratio;
+      hasPivot = true;
     }
-    if (j.empty()) // no new pivots - ray termination
+    if (!hasPivot) // no new pivots - ray termination
     {
       err = 2;
       break;
     }
 
-    std::size_t jSize = j.size();
-    Eigen::VectorXd minRatio(jSize);
-    for (std::size_t i = 0; i < jSize; ++i)
+    // Among the candidates within the ratio, always use the artificial if
+    // possible. Otherwise, choose the one with the largest pivot where the
+    // first is preferred if there are multiple.
+    lvindex = -1;
+    int artificialIndex = -1;
+    double maxPivot = 0.0;
+    for (int i = 0; i < n; ++i)
     {
-      minRatio[i] = (x[j[i]] + zer_tol) / d[j[i]];
-    }
-    double theta = minRatio.minCoeff();
+      if (mD[i] <= piv_tol || mX[i] / mD[i] > theta)
+        continue;
 
-    std::vector<int> tmpJ;
-    std::vector<double> tmpd;
-    for (std::size_t i = 0; i < jSize; ++i)
-    {
-      if (x[j[i]] / d[j[i]] <= theta)
+      if (mBasisVariables[static_cast<std::size_t>(i)] == t)
+        artificialIndex = i;
+
+      if (lvindex == -1 || mD[i] - maxPivot > piv_tol)
       {
-        tmpJ.push_back(j[i]);
-        tmpd.push_back(d[j[i]]);
+        maxPivot = mD[i];
+        lvindex = i;
       }
     }
 
-    //    if (tmpJ.empty())
-    //    {
-    //      LOG(WARNING) << "tmpJ should never be empty!!!";
-    //      LOG(WARNING) << "dumping data:";
-    //      LOG(WARNING) << "theta:" << theta;
-    //      for (int i = 0; i < jSize; ++i)
-    //      {
-    //        LOG(WARNING) << "x(" << j[i] << "): " << x[j[i]] << "d: " <<
-    //        d[j[i]];
-    //      }
-    //    }
-
-    j = tmpJ;
-    jSize = j.size();
-    if (jSize == 0)
+    if (lvindex == -1)
     {
       err = 4;
       break;
     }
-    lvindex = -1;
-
-    // Check if artificial among these
-    for (std::size_t i = 0; i < jSize; ++i)
-    {
-      if (bas[j[i]] == t)
-        lvindex = i;
-    }
-
-    if (lvindex != -1)
-    {
-      lvindex = j[lvindex]; // Always use artificial if possible
-    }
-    else
-    {
-      theta = tmpd[0];
-      lvindex = 0;
-      for (std::size_t i = 0; i < jSize; ++i)
-      {
-        if (tmpd[i] - theta > piv_tol)
-        { // Bubble sorting
-          theta = tmpd[i];
-          lvindex = i;
-        }
-      }
-      lvindex = j[lvindex]; // choose the first if there are multiple
-    }
 
-    leaving = bas[lvindex];
+    if (artificialIndex != -1)
+      lvindex = artificialIndex;
 
-    ratio = x[lvindex] / d[lvindex];
+    leaving = mBasisVariables[static_cast<std::size_t>(lvindex)];
 
-    //    bool bDiverged = false;
-    //    for (int i = 0; i < n; ++i) {
-    //      if (isnan(x[i]) || isinf(x[i])) {
-    //        bDiverged = true;
-    //        break;
-    //      }
-    //    }
-    //    if (bDiverged) {
-    //      err = 4;
-    //      break;
-    //    }
+    const double ratio = mX[lvindex] / mD[lvindex];
 
     // Perform pivot
-    x = x - ratio * d;
-    x[lvindex] = ratio;
-    B.col(lvindex) = Be;
-    bas[lvindex] = entering;
+    mX -= ratio * mD;
+    mX[lvindex] = ratio;
+    replaceBasisColumn(lvindex, mBe, mD);
+    mBasisVariables[static_cast<std::size_t>(lvindex)] = entering;
   }
 
-  if (iter >= maxiter && leaving != t)
+  if (iter >= mMaxIterations && leaving != t)
   {
     err = 1;
   }
 
   if (err == 0)
   {
-    for (std::size_t i = 0; i < bas.size(); ++i)
+    z->setZero(n);
+    for (std::size_t i = 0u; i < mBasisVariables.size(); ++i)
     {
-      if (bas[i] < _z->size())
+      const int variable = mBasisVariables[i];
+      if (variable < n)
       {
-        (*_z)[bas[i]] = x[i];
+        (*z)[variable] = mX[static_cast<Eigen::Index>(i)];
+        mBasis.push_back(variable);
       }
     }
 
-    Eigen::VectorXd __z = _z->head(n);
-    *_z = __z;
-
-    if (!validate(_M, *_z, _q))
+    if (!validate(M, *z, q))
     {
-      // _z = VectorXd::Zero(n);
       err = 3;
+      mBasis.clear();
+      z->setZero(n);
     }
   }
   else
   {
-    *_z = Eigen::VectorXd::Zero(n); // solve failed, return a 0 vector
+    z->setZero(n); // solve failed, return a 0 vector
   }
 
-  //  if (err == 1)
-  //    LOG(ERROR) << "LCP Solver: Iterations exceeded limit";
-  //  else if (err == 2)
-  //    LOG(ERROR) << "LCP Solver: Unbounded ray";
-  //  else if (err == 3)
-  //    LOG(ERROR) << "LCP Solver: Solver converged with numerical issues. "
-  //               << "Validation failed.";
-  //  else if (err == 4)
-  //    LOG(ERROR) << "LCP Solver: Iteration diverged.";
-
   return err;
 }
 
+//==============================================================================
+void LemkeSolver::setWarmStartBasis(const std::vector<int>& basis)
+{
+  mWarmStartBasis = basis;
+}
+
+//==============================================================================
+const std::vector<int>& LemkeSolver::getBasis() const
+{
+  return mBasis;
+}
+
+//==============================================================================
+void LemkeSolver::setMaxIterations(int maxIterations)
+{
+  mMaxIterations = maxIterations;
+}
+
+//==============================================================================
+int LemkeSolver::getMaxIterations() const
+{
+  return mMaxIterations;
+}
+
+//==============================================================================
+void LemkeSolver::resize(int n)
+{
+  if (mB.rows() == n)
+    return;
+
+  mB.resize(n, n);
+  mEtas.resize(n, maxNumEtas);
+  mEtaIndices.resize(maxNumEtas);
+  mIsInitialBasis.resize(static_cast<std::size_t>(n));
+  mBasisVariables.reserve(static_cast<std::size_t>(n));
+  mBasis.reserve(static_cast<std::size_t>(n));
+  mX.resize(n);
+  mD.resize(n);
+  mBe.resize(n);
+  mU.resize(n);
+}
+
+//==============================================================================
+void LemkeSolver::refactorize()
+{
+  mLu.compute(mB);
+  mIsBaseNegativeIdentity = false;
+  mNumEtas = 0;
+}
+
+//==============================================================================
+void LemkeSolver::solveBasis(const Eigen::VectorXd& rhs, Eigen::VectorXd& out)
+{
+  if (mIsBaseNegativeIdentity)
+    out = -rhs;
+  else
+    out = mLu.solve(rhs);
+
+  // Apply the inverses of the eta matrices in order. The k-th eta matrix is
+  // the identity with the column at mEtaIndices[k] replaced by the k-th eta
+  // column.
+  for (int k = 0; k < mNumEtas; ++k)
+  {
+    const int r = mEtaIndices[static_cast<std::size_t>(k)];
+    const auto eta = mEtas.col(k);
+    const double outR = out[r] / eta[r];
+    out -= outR * eta;
+    out[r] = outR;
+  }
+}
+
+//==============================================================================
+void LemkeSolver::replaceBasisColumn(
+    int index, const Eigen::VectorXd& column, const Eigen::VectorXd& eta)
+{
+  mB.col(index) = column;
+
+  if (mNumEtas == maxNumEtas)
+  {
+    refactorize();
+    return;
+  }
+
+  mEtas.col(mNumEtas) = eta;
+  mEtaIndices[static_cast<std::size_t>(mNumEtas)] = index;
+  ++mNumEtas;
+}
+
+//==============================================================================
+int Lemke(
+    const Eigen::MatrixXd& _M, const Eigen::VectorXd& _q, Eigen::VectorXd* _z)
+{
+  LemkeSolver solver;
+  return solver.solve(_M, _q, _z);
+}
+
 //==============================================================================
 bool validate(
     const Eigen::MatrixXd& _M,
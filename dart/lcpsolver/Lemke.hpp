@@ -33,11 +33,110 @@
 #ifndef DART_LCPSOLVER_LEMKE_HPP_
 #define DART_LCPSOLVER_LEMKE_HPP_
 
+#include <vector>
 #include <Eigen/Dense>
 
 namespace dart {
 namespace lcpsolver {
 
+/// Lemke's complementary pivoting solver for the LCP w = Mz + q, w >= 0,
+/// z >= 0, w^T z = 0.
+///
+/// Instead of factorizing the basis from scratch at every pivot, the solver
+/// keeps an LU factorization of the basis at the last refactorization and
+/// represents the following column replacements in product form, i.e., as a
+/// sequence of eta matrices. Solving with the basis then costs O(n^2) per
+/// pivot rather than O(n^3). The basis is refactorized after a fixed number
+/// of updates to bound the growth of the eta file.
+///
+/// All the workspace is kept between calls and only reallocated when the
+/// problem size changes.
+class LemkeSolver
+{
+public:
+  /// Constructor
+  LemkeSolver();
+
+  /// Solves the LCP. Returns 0 on success, 1 if the iteration limit is
+  /// exceeded, 2 on ray termination, 3 if the solution doesn't pass
+  /// validate(), and 4 if the iteration diverged. On failure, z is set to
+  /// zero. An ill-conditioned initial basis is not a failure; the solve falls
+  /// back to the cold start instead.
+  int solve(
+      const Eigen::MatrixXd& M, const Eigen::VectorXd& q, Eigen::VectorXd* z);
+
+  /// Sets the indices of the z variables that form the initial basis of the
+  /// next solve, e.g., getBasis() of a previous solve of a similar problem.
+  /// Invalid indices are ignored. If the initial basis is singular, the solve
+  /// falls back to the cold start.
+  void setWarmStartBasis(const std::vector<int>& basis);
+
+  /// Returns the indices of the z variables in the basis of the last
+  /// successful solve
+  const std::vector<int>& getBasis() const;
+
+  /// Sets the maximum number of pivots
+  void setMaxIterations(int maxIterations);
+
+  /// Returns the maximum number of pivots
+  int getMaxIterations() const;
+
+protected:
+  /// Resizes the workspace for a problem of size n
+  void resize(int n);
+
+  /// Factorizes the current basis and clears the eta file
+  void refactorize();
+
+  /// Solves B * out = rhs with the current basis B
+  void solveBasis(const Eigen::VectorXd& rhs, Eigen::VectorXd& out);
+
+  /// Replaces the column of the basis at index with column where eta is the
+  /// solution of B * eta = column with the basis before the replacement
+  void replaceBasisColumn(
+      int index, const Eigen::VectorXd& column, const Eigen::VectorXd& eta);
+
+  /// Maximum number of pivots
+  int mMaxIterations;
+
+  /// Warm start basis of the next solve
+  std::vector<int> mWarmStartBasis;
+
+  /// Indices of the z variables in the basis of the last solve
+  std::vector<int> mBasis;
+
+  /// Variable of each column of the basis where [0, n) are z, [n, 2n) are w,
+  /// and 2n is the artificial variable
+  std::vector<int> mBasisVariables;
+
+  /// Whether each z variable is in the initial basis
+  std::vector<char> mIsInitialBasis;
+
+  /// Basis matrix
+  Eigen::MatrixXd mB;
+
+  /// LU factorization of the basis at the last refactorization
+  Eigen::PartialPivLU<Eigen::MatrixXd> mLu;
+
+  /// Whether the basis at the last refactorization is -I, which doesn't need
+  /// to be factorized
+  bool mIsBaseNegativeIdentity;
+
+  /// Eta columns of the column replacements since the last refactorization
+  Eigen::MatrixXd mEtas;
+
+  /// Replaced basis column of each eta column
+  std::vector<int> mEtaIndices;
+
+  /// Number of column replacements since the last refactorization
+  int mNumEtas;
+
+  Eigen::VectorXd mX;
+  Eigen::VectorXd mD;
+  Eigen::VectorXd mBe;
+  Eigen::VectorXd mU;
+};
+
 /// \brief
 int Lemke(
     const Eigen::MatrixXd& _M, const Eigen::VectorXd& _q, Eigen::VectorXd* _z);
@@ -67,7 +67,7 @@ bool ODELCPSolver::Solve(
 {
   if (!_bUseODESolver)
   {
-    int err = Lemke(_A, _b, _x);
+    int err = mLemkeSolver.solve(_A, _b, _x);
     return (err == 0);
   }
   else
@@ -34,6 +34,7 @@
 #define DART_LCPSOLVER_ODELCPSOLVER_HPP_
 
 #include <Eigen/Dense>
+#include "dart/lcpsolver/Lemke.hpp"
 
 namespace dart {
 namespace lcpsolver {
@@ -80,6 +81,9 @@ private:
       const Eigen::MatrixXd& _A,
       const Eigen::VectorXd& _b,
       const Eigen::VectorXd& _x);
+
+  /// Lemke solver that keeps its workspace across the calls of Solve()
+  LemkeSolver mLemkeSolver;
 };
 
 } // namespace lcpsolver
@@ -41,6 +41,7 @@
 
 #include "dart/common/Console.hpp"
 #include "dart/math/Helpers.hpp"
+#include "dart/math/detail/GeometrySimd.hpp"
 
 #define DART_EPSILON 1e-6
 
@@ -627,6 +628,13 @@ Eigen::Vector6d AdT(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _V) {
   // v' = p x R*w + R*v
   //--------------------------------------------------------------------------
   Eigen::Vector6d res;
+#if DART_MATH_HAVE_AVX2_KERNELS
+  if (detail::isAvx2Enabled())
+  {
+    detail::AdTAvx2(_T, _V, res);
+    return res;
+  }
+#endif
   res.head<3>().noalias() = _T.linear() * _V.head<3>();
   res.tail<3>().noalias() = _T.linear() * _V.tail<3>() +
                             _T.translation().cross(res.head<3>());
@@ -713,6 +721,13 @@ Eigen::Vector6d AdTLinear(const Eigen::Isometry3d& _T,
 // re = Inv(T)*s*T
 Eigen::Vector6d AdInvT(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _V) {
   Eigen::Vector6d res;
+#if DART_MATH_HAVE_AVX2_KERNELS
+  if (detail::isAvx2Enabled())
+  {
+    detail::AdInvTAvx2(_T, _V, res);
+    return res;
+  }
+#endif
   res.head<3>().noalias() = _T.linear().transpose() * _V.head<3>();
   res.tail<3>().noalias() =
       _T.linear().transpose()
@@ -750,6 +765,13 @@ Eigen::Vector6d ad(const Eigen::Vector6d& _X, const Eigen::Vector6d& _Y) {
   //              | [v1]w2 + [w1]v2 |
   //--------------------------------------------------------------------------
   Eigen::Vector6d res;
+#if DART_MATH_HAVE_AVX2_KERNELS
+  if (detail::isAvx2Enabled())
+  {
+    detail::adAvx2(_X, _Y, res);
+    return res;
+  }
+#endif
   res.head<3>() = _X.head<3>().cross(_Y.head<3>());
   res.tail<3>() = _X.head<3>().cross(_Y.tail<3>()) +
                   _X.tail<3>().cross(_Y.head<3>());
@@ -784,6 +806,13 @@ Eigen::Vector6d dAdT(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _F) {
 Eigen::Vector6d dAdInvT(const Eigen::Isometry3d& _T,
                         const Eigen::Vector6d& _F) {
   Eigen::Vector6d res;
+#if DART_MATH_HAVE_AVX2_KERNELS
+  if (detail::isAvx2Enabled())
+  {
+    detail::dAdInvTAvx2(_T, _F, res);
+    return res;
+  }
+#endif
   res.tail<3>().noalias() = _T.linear() * _F.tail<3>();
   res.head<3>().noalias() = _T.linear() * _F.head<3>();
   res.head<3>() += _T.translation().cross(res.tail<3>());
@@ -1302,6 +1331,13 @@ Eigen::Isometry3d expAngular(const Eigen::Vector3d& _s) {
 
 Eigen::Vector6d dad(const Eigen::Vector6d& _s, const Eigen::Vector6d& _t) {
   Eigen::Vector6d res;
+#if DART_MATH_HAVE_AVX2_KERNELS
+  if (detail::isAvx2Enabled())
+  {
+    detail::dadAvx2(_s, _t, res);
+    return res;
+  }
+#endif
   res.head<3>() = _t.head<3>().cross(_s.head<3>())
                   + _t.tail<3>().cross(_s.tail<3>());
   res.tail<3>() = _t.tail<3>().cross(_s.head<3>());
@@ -1311,7 +1347,14 @@ Eigen::Vector6d dad(const Eigen::Vector6d& _s, const Eigen::Vector6d& _t) {
 Inertia transformInertia(const Eigen::Isometry3d& _T, const Inertia& _I) {
   // operation count: multiplication = 186, addition = 117, subtract = 21
 
-  Inertia ret = Inertia::Identity();
+  Inertia ret;
+#if DART_MATH_HAVE_AVX2_KERNELS
+  if (detail::isAvx2Enabled())
+  {
+    detail::transformInertiaAvx2(_T, _I, ret);
+    return ret;
+  }
+#endif
 
   double d0 = _I(0, 3) + _T(2, 3) * _I(3, 4) - _T(1, 3) * _I(3, 5);
   double d1 = _I(1, 3) - _T(2, 3) * _I(3, 3) + _T(0, 3) * _I(3, 5);
@@ -416,7 +416,11 @@ Eigen::Vector6d ad(const Eigen::Vector6d& _X, const Eigen::Vector6d& _Y);
 /// , where @f$F=(m,f)@in se^{@,*}(3), @quad V=(w,v)@in se(3) @f$.
 Eigen::Vector6d dad(const Eigen::Vector6d& _s, const Eigen::Vector6d& _t);
 
-/// \brief
+/// \brief Returns Ad_T^T * AI * Ad_T, the (articulated) inertia AI expressed
+/// in the frame T.
+/// \note This and AdT, AdInvT, dAdInvT, ad, and dad dispatch at runtime to
+/// AVX2/FMA kernels when the CPU supports them. See
+/// dart/math/detail/GeometrySimd.hpp.
 Inertia transformInertia(const Eigen::Isometry3d& _T, const Inertia& _AI);
 
 /// Use the Parallel Axis Theorem to compute the moment of inertia of a body
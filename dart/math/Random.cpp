@@ -65,6 +65,12 @@ unsigned int Random::getSeed()
   return getSeedMutable();
 }
 
+//==============================================================================
+RandomStream Random::createStream(unsigned int streamId)
+{
+  return RandomStream(getSeed(), streamId);
+}
+
 //==============================================================================
 unsigned int& Random::getSeedMutable()
 {
@@ -72,5 +78,40 @@ unsigned int& Random::getSeedMutable()
   return seed;
 }
 
+//==============================================================================
+RandomStream::RandomStream(unsigned int seed, unsigned int streamId)
+{
+  setSeed(seed, streamId);
+}
+
+//==============================================================================
+void RandomStream::setSeed(unsigned int seed, unsigned int streamId)
+{
+  // The stream id is mixed into the seed sequence so that streams sharing the
+  // same seed start from well separated generator states.
+  std::seed_seq seq{seed, streamId};
+  mSeed = seed;
+  mStreamId = streamId;
+  mGenerator.seed(seq);
+}
+
+//==============================================================================
+unsigned int RandomStream::getSeed() const
+{
+  return mSeed;
+}
+
+//==============================================================================
+unsigned int RandomStream::getStreamId() const
+{
+  return mStreamId;
+}
+
+//==============================================================================
+RandomStream::GeneratorType& RandomStream::getGenerator()
+{
+  return mGenerator;
+}
+
 } // namespace math
 } // namespace dart
@@ -40,6 +40,14 @@
 namespace dart {
 namespace math {
 
+class RandomStream;
+
+/// Random number generation backed by a single process-wide generator.
+///
+/// The static functions of this class share one generator and are therefore
+/// not safe to call concurrently from multiple threads. Code that samples from
+/// several threads should give each thread (or each object) its own
+/// RandomStream instead, for example one created by createStream().
 class Random final
 {
 public:
@@ -73,6 +81,17 @@ public:
   /// \return The current seed value.
   static unsigned int getSeed();
 
+  /// Creates an independent random stream derived from the current seed.
+  ///
+  /// Streams created with the same seed and stream id produce the same
+  /// sequence of random values, and streams with different ids are
+  /// uncorrelated. Assigning a fixed id to each unit of parallel work (rather
+  /// than to each thread) keeps the results reproducible however the work is
+  /// scheduled.
+  ///
+  /// \param[in] streamId The identifier of the stream.
+  static RandomStream createStream(unsigned int streamId);
+
   /// Returns a random number from an uniform distribution.
   ///
   ///
@@ -212,11 +231,145 @@ public:
   template <typename S>
   static S normal(S mean, S sigma);
 
+  /// Fills a vector or matrix with random values from an uniform distribution.
+  ///
+  /// Unlike uniform(), the result is written to \c out in place, so that
+  /// blocks and other writable expressions such as \c m.col(i) can be filled
+  /// without a temporary. Floating-point coefficients are sampled in blocks:
+  /// a buffer of raw generator output is converted to the distribution with
+  /// Eigen array operations. Integer coefficients are sampled one at a time.
+  /// The coefficients are visited in column-major order regardless of the
+  /// storage order of \c out.
+  ///
+  /// \param[out] out The vector, matrix, or writable expression to fill.
+  /// \param[in] min Lower bound of the distribution.
+  /// \param[in] max Upper bound of the distribution.
+  template <typename Derived>
+  static void fillUniform(
+      const Eigen::MatrixBase<Derived>& out,
+      typename Derived::Scalar min,
+      typename Derived::Scalar max);
+
+  /// Fills a floating-point vector or matrix with random values from a normal
+  /// distribution.
+  ///
+  /// Like fillUniform(), the coefficients are sampled in blocks, using the
+  /// Box-Muller transform on the raw generator output.
+  ///
+  /// \param[out] out The vector, matrix, or writable expression to fill.
+  /// \param[in] mean Mean of the normal distribution.
+  /// \param[in] sigma Standard deviation of the distribution.
+  template <typename Derived>
+  static void fillNormal(
+      const Eigen::MatrixBase<Derived>& out,
+      typename Derived::Scalar mean,
+      typename Derived::Scalar sigma);
+
 private:
   /// \return A mutable reference to the seed.
   static unsigned int& getSeedMutable();
 };
 
+/// Independent stream of random numbers.
+///
+/// Each RandomStream owns its own generator, so separate streams can be used
+/// concurrently without any synchronization. A stream is fully determined by
+/// its seed and stream id. The sampling functions mirror the ones of Random.
+class RandomStream final
+{
+public:
+  using GeneratorType = Random::GeneratorType;
+
+  /// Constructor
+  ///
+  /// \param[in] seed The seed value.
+  /// \param[in] streamId The identifier of the stream.
+  explicit RandomStream(unsigned int seed = 0u, unsigned int streamId = 0u);
+
+  /// Reseeds this stream.
+  ///
+  /// \param[in] seed The seed value.
+  /// \param[in] streamId The identifier of the stream.
+  void setSeed(unsigned int seed, unsigned int streamId = 0u);
+
+  /// \return The seed value of this stream.
+  unsigned int getSeed() const;
+
+  /// \return The identifier of this stream.
+  unsigned int getStreamId() const;
+
+  /// Returns a mutable reference to the random generator of this stream
+  GeneratorType& getGenerator();
+
+  /// Returns a random number from an uniform distribution.
+  ///
+  /// \sa Random::uniform()
+  template <typename S>
+  S uniform(S min, S max);
+
+  /// Returns a random fixed-size vector or matrix from an uniform
+  /// distribution.
+  ///
+  /// \sa Random::uniform()
+  template <typename FixedSizeT>
+  FixedSizeT uniform(
+      typename FixedSizeT::Scalar min, typename FixedSizeT::Scalar max);
+
+  /// Returns a random dynamic-size vector from an uniform distribution.
+  ///
+  /// \sa Random::uniform()
+  template <typename DynamicSizeVectorT>
+  DynamicSizeVectorT uniform(
+      int size,
+      typename DynamicSizeVectorT::Scalar min,
+      typename DynamicSizeVectorT::Scalar max);
+
+  /// Returns a random dynamic-size matrix from an uniform distribution.
+  ///
+  /// \sa Random::uniform()
+  template <typename DynamicSizeMatrixT>
+  DynamicSizeMatrixT uniform(
+      int rows,
+      int cols,
+      typename DynamicSizeMatrixT::Scalar min,
+      typename DynamicSizeMatrixT::Scalar max);
+
+  /// Returns a random number from a normal distribution.
+  ///
+  /// \sa Random::normal()
+  template <typename S>
+  S normal(S mean, S sigma);
+
+  /// Fills a vector or matrix with random values from an uniform distribution.
+  ///
+  /// \sa Random::fillUniform()
+  template <typename Derived>
+  void fillUniform(
+      const Eigen::MatrixBase<Derived>& out,
+      typename Derived::Scalar min,
+      typename Derived::Scalar max);
+
+  /// Fills a floating-point vector or matrix with random values from a normal
+  /// distribution.
+  ///
+  /// \sa Random::fillNormal()
+  template <typename Derived>
+  void fillNormal(
+      const Eigen::MatrixBase<Derived>& out,
+      typename Derived::Scalar mean,
+      typename Derived::Scalar sigma);
+
+private:
+  /// Seed value
+  unsigned int mSeed;
+
+  /// Stream identifier
+  unsigned int mStreamId;
+
+  /// Random generator
+  GeneratorType mGenerator;
+};
+
 } // namespace math
 } // namespace dart
 
@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/math/detail/GeometrySimd.hpp"
+
+#include <atomic>
+
+#if DART_MATH_HAVE_AVX2_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace dart {
+namespace math {
+namespace detail {
+
+namespace {
+
+//==============================================================================
+bool detectAvx2()
+{
+#if DART_MATH_HAVE_AVX2_KERNELS
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+  return false;
+#endif
+}
+
+// Both flags are resolved during static initialization. Any call made before
+// that (e.g., from another translation unit's static initializer) sees false
+// and takes the scalar path.
+const bool gAvx2Supported = detectAvx2();
+std::atomic<bool> gAvx2Enabled{gAvx2Supported};
+
+} // namespace
+
+//==============================================================================
+bool isAvx2Supported()
+{
+  return gAvx2Supported;
+}
+
+//==============================================================================
+bool isAvx2Enabled()
+{
+  return gAvx2Enabled.load(std::memory_order_relaxed);
+}
+
+//==============================================================================
+void setAvx2Enabled(bool enabled)
+{
+  gAvx2Enabled.store(enabled && gAvx2Supported, std::memory_order_relaxed);
+}
+
+#if DART_MATH_HAVE_AVX2_KERNELS
+
+//==============================================================================
+// A 3-vector is held in the lower three lanes of a __m256d with the fourth lane
+// zeroed. Eigen::Isometry3d stores a column-major 4x4 matrix, so the columns of
+// the rotation and the translation are loaded directly from T.data().
+//==============================================================================
+
+#define DART_AVX2_TARGET __attribute__((target("avx2,fma")))
+
+namespace {
+
+//==============================================================================
+DART_AVX2_TARGET inline __m256d load3(const double* p)
+{
+  return _mm256_maskload_pd(p, _mm256_set_epi64x(0, -1, -1, -1));
+}
+
+//==============================================================================
+/// Stores the 3-vectors w and v contiguously as a 6-vector. Plain stores are
+/// used rather than masked ones so that the caller can read the result back
+/// through store-to-load forwarding.
+DART_AVX2_TARGET inline void store6(double* p, __m256d w, __m256d v)
+{
+  // (w0, w1, w2, v0) and (v1, v2)
+  const __m256d v0 = _mm256_permute4x64_pd(v, 0x00);
+  _mm256_storeu_pd(p, _mm256_blend_pd(w, v0, 0x8));
+  const __m256d v12 = _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 3, 2, 1));
+  _mm_storeu_pd(p + 4, _mm256_castpd256_pd128(v12));
+}
+
+//==============================================================================
+/// Stores the 3-vectors a, b, c, and d contiguously as 12 doubles.
+DART_AVX2_TARGET inline void store12(
+    double* p, __m256d a, __m256d b, __m256d c, __m256d d)
+{
+  // (a0, a1, a2, b0)
+  const __m256d b0 = _mm256_permute4x64_pd(b, 0x00);
+  _mm256_storeu_pd(p, _mm256_blend_pd(a, b0, 0x8));
+
+  // (b1, b2, c0, c1)
+  const __m256d b12 = _mm256_permute4x64_pd(b, _MM_SHUFFLE(3, 3, 2, 1));
+  const __m256d c01 = _mm256_permute4x64_pd(c, _MM_SHUFFLE(1, 0, 3, 3));
+  _mm256_storeu_pd(p + 4, _mm256_blend_pd(b12, c01, 0xC));
+
+  // (c2, d0, d1, d2)
+  const __m256d c2 = _mm256_permute4x64_pd(c, 0xAA);
+  const __m256d d012 = _mm256_permute4x64_pd(d, _MM_SHUFFLE(2, 1, 0, 0));
+  _mm256_storeu_pd(p + 8, _mm256_blend_pd(d012, c2, 0x1));
+}
+
+//==============================================================================
+DART_AVX2_TARGET inline __m256d broadcastLane(__m256d v, int lane)
+{
+  switch (lane)
+  {
+    case 0:
+      return _mm256_permute4x64_pd(v, 0x00);
+    case 1:
+      return _mm256_permute4x64_pd(v, 0x55);
+    default:
+      return _mm256_permute4x64_pd(v, 0xAA);
+  }
+}
+
+//==============================================================================
+/// Returns a x b.
+DART_AVX2_TARGET inline __m256d cross(__m256d a, __m256d b)
+{
+  // (y, z, x) and (z, x, y) permutations; the fourth lane stays in place
+  const __m256d a1 = _mm256_permute4x64_pd(a, _MM_SHUFFLE(3, 0, 2, 1));
+  const __m256d a2 = _mm256_permute4x64_pd(a, _MM_SHUFFLE(3, 1, 0, 2));
+  const __m256d b1 = _mm256_permute4x64_pd(b, _MM_SHUFFLE(3, 0, 2, 1));
+  const __m256d b2 = _mm256_permute4x64_pd(b, _MM_SHUFFLE(3, 1, 0, 2));
+  return _mm256_fmsub_pd(a1, b2, _mm256_mul_pd(a2, b1));
+}
+
+//==============================================================================
+/// Returns M * x where cols are the columns of M and x is read from memory.
+DART_AVX2_TARGET inline __m256d multiply(const __m256d* cols, const double* x)
+{
+  __m256d res = _mm256_mul_pd(cols[0], _mm256_broadcast_sd(x));
+  res = _mm256_fmadd_pd(cols[1], _mm256_broadcast_sd(x + 1), res);
+  return _mm256_fmadd_pd(cols[2], _mm256_broadcast_sd(x + 2), res);
+}
+
+//==============================================================================
+/// Returns M * x where cols are the columns of M.
+DART_AVX2_TARGET inline __m256d multiply(const __m256d* cols, __m256d x)
+{
+  __m256d res = _mm256_mul_pd(cols[0], broadcastLane(x, 0));
+  res = _mm256_fmadd_pd(cols[1], broadcastLane(x, 1), res);
+  return _mm256_fmadd_pd(cols[2], broadcastLane(x, 2), res);
+}
+
+//==============================================================================
+DART_AVX2_TARGET inline void loadRotationColumns(const double* t, __m256d* cols)
+{
+  cols[0] = load3(t);
+  cols[1] = load3(t + 4);
+  cols[2] = load3(t + 8);
+}
+
+//==============================================================================
+/// Loads the rows of the rotation, which are the columns of its transpose.
+DART_AVX2_TARGET inline void loadRotationRows(const double* t, __m256d* rows)
+{
+  const __m256d c0 = _mm256_loadu_pd(t);
+  const __m256d c1 = _mm256_loadu_pd(t + 4);
+  const __m256d c2 = _mm256_loadu_pd(t + 8);
+  const __m256d zero = _mm256_setzero_pd();
+
+  const __m256d t0 = _mm256_unpacklo_pd(c0, c1);
+  const __m256d t1 = _mm256_unpackhi_pd(c0, c1);
+  const __m256d t2 = _mm256_unpacklo_pd(c2, zero);
+  const __m256d t3 = _mm256_unpackhi_pd(c2, zero);
+
+  rows[0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+  rows[1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+  rows[2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+}
+
+//==============================================================================
+/// Computes R^T * X * R for the 3x3 block X of a 6x6 column-major matrix that
+/// starts at x. rows are the rows of R and t is the data of the transform.
+DART_AVX2_TARGET inline void rotateBlock(
+    const __m256d* rows, const double* t, const double* x, __m256d* res)
+{
+  // Unrolled by hand; otherwise -O2 keeps the loops and spills to the stack
+  const __m256d tmp[3]
+      = {multiply(rows, x), multiply(rows, x + 6), multiply(rows, x + 12)};
+
+  res[0] = multiply(tmp, t);
+  res[1] = multiply(tmp, t + 4);
+  res[2] = multiply(tmp, t + 8);
+}
+
+//==============================================================================
+/// Computes M * [q] where [q] is the skew-symmetric matrix of q.
+DART_AVX2_TARGET inline void multiplySkew(
+    const __m256d* m, __m256d q, __m256d* res)
+{
+  const __m256d q0 = broadcastLane(q, 0);
+  const __m256d q1 = broadcastLane(q, 1);
+  const __m256d q2 = broadcastLane(q, 2);
+
+  res[0] = _mm256_fmsub_pd(q2, m[1], _mm256_mul_pd(q1, m[2]));
+  res[1] = _mm256_fmsub_pd(q0, m[2], _mm256_mul_pd(q2, m[0]));
+  res[2] = _mm256_fmsub_pd(q1, m[0], _mm256_mul_pd(q0, m[1]));
+}
+
+} // namespace
+
+//==============================================================================
+DART_AVX2_TARGET void AdTAvx2(
+    const Eigen::Isometry3d& T, const Eigen::Vector6d& V, Eigen::Vector6d& res)
+{
+  // w' = R*w
+  // v' = p x R*w + R*v
+  const double* t = T.data();
+  const double* v = V.data();
+
+  __m256d R[3];
+  loadRotationColumns(t, R);
+
+  const __m256d w = multiply(R, v);
+  const __m256d u = _mm256_add_pd(multiply(R, v + 3), cross(load3(t + 12), w));
+
+  store6(res.data(), w, u);
+}
+
+//==============================================================================
+DART_AVX2_TARGET void AdInvTAvx2(
+    const Eigen::Isometry3d& T, const Eigen::Vector6d& V, Eigen::Vector6d& res)
+{
+  // w' = R^T*w
+  // v' = R^T*(v + w x p)
+  const double* t = T.data();
+  const double* v = V.data();
+
+  __m256d Rt[3];
+  loadRotationRows(t, Rt);
+
+  const __m256d w = load3(v);
+  const __m256d u = _mm256_add_pd(load3(v + 3), cross(w, load3(t + 12)));
+
+  store6(res.data(), multiply(Rt, v), multiply(Rt, u));
+}
+
+//==============================================================================
+DART_AVX2_TARGET void dAdInvTAvx2(
+    const Eigen::Isometry3d& T, const Eigen::Vector6d& F, Eigen::Vector6d& res)
+{
+  // f' = R*f
+  // m' = R*m + p x R*f
+  const double* t = T.data();
+  const double* f = F.data();
+
+  __m256d R[3];
+  loadRotationColumns(t, R);
+
+  const __m256d lin = multiply(R, f + 3);
+  const __m256d ang = _mm256_add_pd(multiply(R, f), cross(load3(t + 12), lin));
+
+  store6(res.data(), ang, lin);
+}
+
+//==============================================================================
+DART_AVX2_TARGET void adAvx2(
+    const Eigen::Vector6d& X, const Eigen::Vector6d& Y, Eigen::Vector6d& res)
+{
+  const __m256d w1 = load3(X.data());
+  const __m256d v1 = load3(X.data() + 3);
+  const __m256d w2 = load3(Y.data());
+  const __m256d v2 = load3(Y.data() + 3);
+
+  store6(
+      res.data(),
+      cross(w1, w2),
+      _mm256_add_pd(cross(w1, v2), cross(v1, w2)));
+}
+
+//==============================================================================
+DART_AVX2_TARGET void dadAvx2(
+    const Eigen::Vector6d& s, const Eigen::Vector6d& t, Eigen::Vector6d& res)
+{
+  const __m256d sw = load3(s.data());
+  const __m256d sv = load3(s.data() + 3);
+  const __m256d tw = load3(t.data());
+  const __m256d tv = load3(t.data() + 3);
+
+  store6(
+      res.data(),
+      _mm256_add_pd(cross(tw, sw), cross(tv, sv)),
+      cross(tv, sw));
+}
+
+//==============================================================================
+DART_AVX2_TARGET void transformInertiaAvx2(
+    const Eigen::Isometry3d& T, const Inertia& I, Inertia& res)
+{
+  //--------------------------------------------------------------------------
+  // With I = | A   B |, the result Ad_T^T * I * Ad_T is computed as
+  //          | B^T C |
+  //
+  // | A' + B1 [q] - [q] B'^T   B1 |,  where X' = R^T X R, q = R^T p, and
+  // | B1^T                     C' |   B1 = B' - [q] C'.
+  //
+  // B1^T = B'^T + C' [q] follows from the symmetry of C. Every block is
+  // assembled column by column, so no transposition is needed.
+  //--------------------------------------------------------------------------
+  const double* t = T.data();
+  const double* i = I.data();
+  double* out = res.data();
+
+  __m256d Rt[3];
+  loadRotationRows(t, Rt);
+  const __m256d q = multiply(Rt, load3(t + 12));
+
+  __m256d A[3];
+  __m256d B[3];
+  __m256d Bt[3];
+  __m256d C[3];
+  rotateBlock(Rt, t, i, A);
+  rotateBlock(Rt, t, i + 18, B);
+  rotateBlock(Rt, t, i + 3, Bt);
+  rotateBlock(Rt, t, i + 21, C);
+
+  __m256d Cq[3];
+  multiplySkew(C, q, Cq);
+
+  B[0] = _mm256_sub_pd(B[0], cross(q, C[0]));
+  B[1] = _mm256_sub_pd(B[1], cross(q, C[1]));
+  B[2] = _mm256_sub_pd(B[2], cross(q, C[2]));
+
+  __m256d Bq[3];
+  multiplySkew(B, q, Bq);
+
+  A[0] = _mm256_sub_pd(_mm256_add_pd(A[0], Bq[0]), cross(q, Bt[0]));
+  A[1] = _mm256_sub_pd(_mm256_add_pd(A[1], Bq[1]), cross(q, Bt[1]));
+  A[2] = _mm256_sub_pd(_mm256_add_pd(A[2], Bq[2]), cross(q, Bt[2]));
+
+  // Column j of the result is stored at out + 6 * j
+  store12(
+      out,
+      A[0],
+      _mm256_add_pd(Bt[0], Cq[0]),
+      A[1],
+      _mm256_add_pd(Bt[1], Cq[1]));
+  store12(out + 12, A[2], _mm256_add_pd(Bt[2], Cq[2]), B[0], C[0]);
+  store12(out + 24, B[1], C[1], B[2], C[2]);
+}
+
+#undef DART_AVX2_TARGET
+
+#endif // DART_MATH_HAVE_AVX2_KERNELS
+
+} // namespace detail
+} // namespace math
+} // namespace dart
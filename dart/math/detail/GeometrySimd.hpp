@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_MATH_DETAIL_GEOMETRYSIMD_HPP_
+#define DART_MATH_DETAIL_GEOMETRYSIMD_HPP_
+
+#include <Eigen/Dense>
+
+#include "dart/math/MathTypes.hpp"
+
+// The explicitly vectorized spatial algebra kernels rely on per-function
+// target attributes so that they can be compiled into a baseline (SSE2) build
+// and selected at runtime. They are only available on x86 with GCC or Clang;
+// elsewhere the Eigen implementations (SSE2/NEON vectorized by Eigen when
+// enabled at compile time) are always used.
+#if (defined(__GNUC__) || defined(__clang__))                                  \
+    && (defined(__x86_64__) || defined(__i386__))
+#define DART_MATH_HAVE_AVX2_KERNELS 1
+#else
+#define DART_MATH_HAVE_AVX2_KERNELS 0
+#endif
+
+namespace dart {
+namespace math {
+namespace detail {
+
+/// Returns true if the CPU running this process supports AVX2 and FMA, and
+/// the AVX2 spatial algebra kernels were compiled in.
+bool isAvx2Supported();
+
+/// Returns true if the spatial algebra functions in dart/math/Geometry.hpp
+/// (AdT, AdInvT, dAdInvT, ad, dad, and transformInertia) are currently
+/// dispatched to the AVX2 kernels. This is enabled by default whenever
+/// isAvx2Supported() is true.
+bool isAvx2Enabled();
+
+/// Enables or disables the AVX2 spatial algebra kernels at runtime. Enabling
+/// has no effect if isAvx2Supported() is false. This is meant for testing and
+/// benchmarking against the scalar implementations.
+void setAvx2Enabled(bool enabled);
+
+#if DART_MATH_HAVE_AVX2_KERNELS
+
+/// AVX2 version of AdT(). Must only be called if isAvx2Supported() is true.
+void AdTAvx2(
+    const Eigen::Isometry3d& T, const Eigen::Vector6d& V, Eigen::Vector6d& res);
+
+/// AVX2 version of AdInvT(). Must only be called if isAvx2Supported() is true.
+void AdInvTAvx2(
+    const Eigen::Isometry3d& T, const Eigen::Vector6d& V, Eigen::Vector6d& res);
+
+/// AVX2 version of dAdInvT(). Must only be called if isAvx2Supported() is
+/// true.
+void dAdInvTAvx2(
+    const Eigen::Isometry3d& T, const Eigen::Vector6d& F, Eigen::Vector6d& res);
+
+/// AVX2 version of ad(). Must only be called if isAvx2Supported() is true.
+void adAvx2(
+    const Eigen::Vector6d& X, const Eigen::Vector6d& Y, Eigen::Vector6d& res);
+
+/// AVX2 version of dad(). Must only be called if isAvx2Supported() is true.
+void dadAvx2(
+    const Eigen::Vector6d& s, const Eigen::Vector6d& t, Eigen::Vector6d& res);
+
+/// AVX2 version of transformInertia(). Must only be called if
+/// isAvx2Supported() is true.
+void transformInertiaAvx2(
+    const Eigen::Isometry3d& T, const Inertia& I, Inertia& res);
+
+#endif // DART_MATH_HAVE_AVX2_KERNELS
+
+} // namespace detail
+} // namespace math
+} // namespace dart
+
+#endif // DART_MATH_DETAIL_GEOMETRYSIMD_HPP_
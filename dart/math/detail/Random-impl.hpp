@@ -30,8 +30,23 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
 #include "dart/math/Random.hpp"
 
+namespace dart {
+namespace math {
+namespace detail {
+
+template <typename S, typename Enable = void>
+struct UniformScalarImpl;
+
+} // namespace detail
+} // namespace math
+} // namespace dart
+
 //==============================================================================
 // This workaround is necessary for old Eigen (< 3.3). See the details here:
 // http://eigen.tuxfamily.org/bz/show_bug.cgi?id=1286
@@ -47,18 +62,20 @@ struct UniformScalarFromMatrixFunctor
   using S = typename Derived::Scalar;
 
   UniformScalarFromMatrixFunctor(
+      Random::GeneratorType& generator,
       const Eigen::MatrixBase<Derived>& min,
       const Eigen::MatrixBase<Derived>& max)
-    : mMin(min), mMax(max)
+    : mGenerator(generator), mMin(min), mMax(max)
   {
     // Do nothing
   }
 
   S operator()(int i, int j) const
   {
-    return Random::uniform<S>(mMin(i, j), mMax(i, j));
+    return UniformScalarImpl<S>::run(mGenerator, mMin(i, j), mMax(i, j));
   }
 
+  Random::GeneratorType& mGenerator;
   const Eigen::MatrixBase<Derived>& mMin;
   const Eigen::MatrixBase<Derived>& mMax;
 };
@@ -69,18 +86,20 @@ struct UniformScalarFromVectorFunctor
   using S = typename Derived::Scalar;
 
   UniformScalarFromVectorFunctor(
+      Random::GeneratorType& generator,
       const Eigen::MatrixBase<Derived>& min,
       const Eigen::MatrixBase<Derived>& max)
-    : mMin(min), mMax(max)
+    : mGenerator(generator), mMin(min), mMax(max)
   {
     // Do nothing
   }
 
   S operator()(int i) const
   {
-    return Random::uniform<S>(mMin[i], mMax[i]);
+    return UniformScalarImpl<S>::run(mGenerator, mMin[i], mMax[i]);
   }
 
+  Random::GeneratorType& mGenerator;
   const Eigen::MatrixBase<Derived>& mMin;
   const Eigen::MatrixBase<Derived>& mMax;
 };
@@ -168,7 +187,7 @@ struct is_compatible_to_uniform_int_distribution<
 // clang-format on
 
 //==============================================================================
-template <typename S, typename Enable = void>
+template <typename S, typename Enable>
 struct UniformScalarImpl
 {
   // Define nothing
@@ -181,12 +200,12 @@ struct UniformScalarImpl<
     S,
     typename std::enable_if<std::is_floating_point<S>::value>::type>
 {
-  static S run(S min, S max)
+  static S run(Random::GeneratorType& generator, S min, S max)
   {
     // Distribution objects are lightweight so we simply construct a new
     // distribution for each random number generation.
     Random::UniformRealDist<S> d(min, max);
-    return d(Random::getGenerator());
+    return d(generator);
   }
 };
 
@@ -198,12 +217,12 @@ struct UniformScalarImpl<
     typename std::enable_if<
         is_compatible_to_uniform_int_distribution<S>::value>::type>
 {
-  static S run(S min, S max)
+  static S run(Random::GeneratorType& generator, S min, S max)
   {
     // Distribution objects are lightweight so we simply construct a new
     // distribution for each random number generation.
     Random::UniformIntDist<S> d(min, max);
-    return d(Random::getGenerator());
+    return d(generator);
   }
 };
 
@@ -224,12 +243,14 @@ struct UniformMatrixImpl<
         && Derived::SizeAtCompileTime == Eigen::Dynamic>::type>
 {
   static typename Derived::PlainObject run(
+      Random::GeneratorType& generator,
       const Eigen::MatrixBase<Derived>& min,
       const Eigen::MatrixBase<Derived>& max)
   {
 #if EIGEN_VERSION_AT_LEAST(3, 3, 0)
     const auto uniformFunc = [&](int i, int j) {
-      return Random::uniform<typename Derived::Scalar>(min(i, j), max(i, j));
+      return UniformScalarImpl<typename Derived::Scalar>::run(
+          generator, min(i, j), max(i, j));
     };
     return Derived::PlainObject::NullaryExpr(
         min.rows(), min.cols(), uniformFunc);
@@ -237,7 +258,7 @@ struct UniformMatrixImpl<
     return Derived::PlainObject::NullaryExpr(
         min.rows(),
         min.cols(),
-        detail::UniformScalarFromMatrixFunctor<Derived>(min, max));
+        detail::UniformScalarFromMatrixFunctor<Derived>(generator, min, max));
 #endif
   }
 };
@@ -252,17 +273,19 @@ struct UniformMatrixImpl<
         && Derived::SizeAtCompileTime == Eigen::Dynamic>::type>
 {
   static typename Derived::PlainObject run(
+      Random::GeneratorType& generator,
       const Eigen::MatrixBase<Derived>& min,
       const Eigen::MatrixBase<Derived>& max)
   {
 #if EIGEN_VERSION_AT_LEAST(3, 3, 0)
     const auto uniformFunc = [&](int i) {
-      return Random::uniform<typename Derived::Scalar>(min[i], max[i]);
+      return UniformScalarImpl<typename Derived::Scalar>::run(
+          generator, min[i], max[i]);
     };
     return Derived::PlainObject::NullaryExpr(min.size(), uniformFunc);
 #else
     return Derived::PlainObject::NullaryExpr(
-        min.size(), detail::UniformScalarFromVectorFunctor<Derived>(min, max));
+        min.size(), detail::UniformScalarFromVectorFunctor<Derived>(generator, min, max));
 #endif
   }
 };
@@ -277,17 +300,19 @@ struct UniformMatrixImpl<
         && Derived::SizeAtCompileTime != Eigen::Dynamic>::type>
 {
   static typename Derived::PlainObject run(
+      Random::GeneratorType& generator,
       const Eigen::MatrixBase<Derived>& min,
       const Eigen::MatrixBase<Derived>& max)
   {
 #if EIGEN_VERSION_AT_LEAST(3, 3, 0)
     const auto uniformFunc = [&](int i, int j) {
-      return Random::uniform<typename Derived::Scalar>(min(i, j), max(i, j));
+      return UniformScalarImpl<typename Derived::Scalar>::run(
+          generator, min(i, j), max(i, j));
     };
     return Derived::PlainObject::NullaryExpr(uniformFunc);
 #else
     return Derived::PlainObject::NullaryExpr(
-        detail::UniformScalarFromMatrixFunctor<Derived>(min, max));
+        detail::UniformScalarFromMatrixFunctor<Derived>(generator, min, max));
 #endif
   }
 };
@@ -302,17 +327,19 @@ struct UniformMatrixImpl<
         && Derived::SizeAtCompileTime != Eigen::Dynamic>::type>
 {
   static typename Derived::PlainObject run(
+      Random::GeneratorType& generator,
       const Eigen::MatrixBase<Derived>& min,
       const Eigen::MatrixBase<Derived>& max)
   {
 #if EIGEN_VERSION_AT_LEAST(3, 3, 0)
     const auto uniformFunc = [&](int i) {
-      return Random::uniform<typename Derived::Scalar>(min[i], max[i]);
+      return UniformScalarImpl<typename Derived::Scalar>::run(
+          generator, min[i], max[i]);
     };
     return Derived::PlainObject::NullaryExpr(uniformFunc);
 #else
     return Derived::PlainObject::NullaryExpr(
-        detail::UniformScalarFromVectorFunctor<Derived>(min, max));
+        detail::UniformScalarFromVectorFunctor<Derived>(generator, min, max));
 #endif
   }
 };
@@ -330,9 +357,9 @@ struct UniformImpl<
     T,
     typename std::enable_if<std::is_arithmetic<T>::value>::type>
 {
-  static T run(T min, T max)
+  static T run(Random::GeneratorType& generator, T min, T max)
   {
-    return UniformScalarImpl<T>::run(min, max);
+    return UniformScalarImpl<T>::run(generator, min, max);
   }
 };
 
@@ -342,9 +369,12 @@ struct UniformImpl<
     T,
     typename std::enable_if<is_base_of_matrix<T>::value>::type>
 {
-  static T run(const Eigen::MatrixBase<T>& min, const Eigen::MatrixBase<T>& max)
+  static T run(
+      Random::GeneratorType& generator,
+      const Eigen::MatrixBase<T>& min,
+      const Eigen::MatrixBase<T>& max)
   {
-    return UniformMatrixImpl<T>::run(min, max);
+    return UniformMatrixImpl<T>::run(generator, min, max);
   }
 };
 
@@ -362,10 +392,10 @@ struct NormalScalarImpl<
     S,
     typename std::enable_if<std::is_floating_point<S>::value>::type>
 {
-  static S run(S mean, S sigma)
+  static S run(Random::GeneratorType& generator, S mean, S sigma)
   {
     Random::NormalRealDist<S> d(mean, sigma);
-    return d(Random::getGenerator());
+    return d(generator);
   }
 };
 
@@ -377,10 +407,11 @@ struct NormalScalarImpl<
     typename std::enable_if<
         is_compatible_to_uniform_int_distribution<S>::value>::type>
 {
-  static S run(S mean, S sigma)
+  static S run(Random::GeneratorType& generator, S mean, S sigma)
   {
     using DefaultFloatType = float;
-    const DefaultFloatType realNormal = Random::normal(
+    const DefaultFloatType realNormal = NormalScalarImpl<DefaultFloatType>::run(
+        generator,
         static_cast<DefaultFloatType>(mean),
         static_cast<DefaultFloatType>(sigma));
     return static_cast<S>(std::round(realNormal));
@@ -400,19 +431,221 @@ struct NormalImpl<
     T,
     typename std::enable_if<std::is_arithmetic<T>::value>::type>
 {
-  static T run(T min, T max)
+  static T run(Random::GeneratorType& generator, T mean, T sigma)
   {
-    return NormalScalarImpl<T>::run(min, max);
+    return NormalScalarImpl<T>::run(generator, mean, sigma);
   }
 };
 
+//==============================================================================
+template <typename S, typename Enable = void>
+struct UniformDistImpl
+{
+  // Define nothing
+};
+
+//==============================================================================
+// Floating-point case
+template <typename S>
+struct UniformDistImpl<
+    S,
+    typename std::enable_if<std::is_floating_point<S>::value>::type>
+{
+  using type = Random::UniformRealDist<S>;
+};
+
+//==============================================================================
+// Integer case
+template <typename S>
+struct UniformDistImpl<
+    S,
+    typename std::enable_if<
+        is_compatible_to_uniform_int_distribution<S>::value>::type>
+{
+  using type = Random::UniformIntDist<S>;
+};
+
+//==============================================================================
+template <typename Derived, typename Distribution>
+void fillFromDistribution(
+    Random::GeneratorType& generator,
+    const Eigen::MatrixBase<Derived>& out,
+    Distribution& d)
+{
+  // out is taken by const reference so that temporary expressions such as
+  // blocks can be passed in, following the Eigen documentation on writing
+  // functions taking Eigen types as parameters.
+  Eigen::MatrixBase<Derived>& result = out.const_cast_derived();
+
+  // A single distribution object is shared by all the coefficients rather than
+  // constructing one per coefficient as the scalar variants do. This matters
+  // for the normal distribution, which generates its samples in pairs.
+  //
+  // The coefficients are always visited in column-major order so that the
+  // same generator state gives the same matrix regardless of the storage
+  // order of Derived.
+  using Index = typename Derived::Index;
+  for (Index j = 0; j < result.cols(); ++j)
+    for (Index i = 0; i < result.rows(); ++i)
+      result.coeffRef(i, j) = d(generator);
+}
+
+//==============================================================================
+/// Number of coefficients that fillUniform() and fillNormal() sample at once
+constexpr Eigen::Index kFillBlockSize = 256;
+
+//==============================================================================
+/// Draws size numbers uniformly distributed in [0, 1) with 53 bits of
+/// precision, taking two words from the generator for each of them. The words
+/// are copied into raw buffers first and converted together with array
+/// operations.
+inline void generateCanonical(
+    Random::GeneratorType& generator,
+    Eigen::Index size,
+    Eigen::ArrayXd& canonical)
+{
+  static_assert(
+      Random::GeneratorType::min() == 0u
+          && Random::GeneratorType::max() == 0xffffffffu,
+      "generateCanonical() expects a generator of 32-bit words.");
+
+  Eigen::Array<std::uint32_t, Eigen::Dynamic, 1> high(size);
+  Eigen::Array<std::uint32_t, Eigen::Dynamic, 1> low(size);
+  for (Eigen::Index i = 0; i < size; ++i)
+  {
+    high[i] = static_cast<std::uint32_t>(generator()) >> 5;
+    low[i] = static_cast<std::uint32_t>(generator()) >> 6;
+  }
+
+  // (high * 2^26 + low) / 2^53
+  canonical = (high.cast<double>() * 67108864.0 + low.cast<double>())
+              * (1.0 / 9007199254740992.0);
+}
+
+//==============================================================================
+/// Writes values to out in column-major order, starting at the linear index
+/// offset
+template <typename Derived, typename ValuesT>
+void scatterColumnMajor(
+    Eigen::MatrixBase<Derived>& out,
+    Eigen::Index offset,
+    const Eigen::ArrayBase<ValuesT>& values)
+{
+  const Eigen::Index rows = out.rows();
+  for (Eigen::Index k = 0; k < values.size(); ++k)
+  {
+    const Eigen::Index index = offset + k;
+    out.coeffRef(index % rows, index / rows)
+        = static_cast<typename Derived::Scalar>(values[k]);
+  }
+}
+
+//==============================================================================
+// Floating-point case, which samples blocks of coefficients at once
+template <typename Derived>
+void fillUniform(
+    Random::GeneratorType& generator,
+    const Eigen::MatrixBase<Derived>& out,
+    typename Derived::Scalar min,
+    typename Derived::Scalar max,
+    std::true_type /*isFloatingPoint*/)
+{
+  Eigen::MatrixBase<Derived>& result = out.const_cast_derived();
+
+  const double lower = static_cast<double>(min);
+  const double range = static_cast<double>(max) - lower;
+
+  Eigen::ArrayXd canonical;
+  const Eigen::Index size = result.size();
+  for (Eigen::Index offset = 0; offset < size; offset += kFillBlockSize)
+  {
+    generateCanonical(
+        generator, std::min(kFillBlockSize, size - offset), canonical);
+    scatterColumnMajor(result, offset, lower + range * canonical);
+  }
+}
+
+//==============================================================================
+// Integer case, which samples the coefficients one at a time
+template <typename Derived>
+void fillUniform(
+    Random::GeneratorType& generator,
+    const Eigen::MatrixBase<Derived>& out,
+    typename Derived::Scalar min,
+    typename Derived::Scalar max,
+    std::false_type /*isFloatingPoint*/)
+{
+  typename UniformDistImpl<typename Derived::Scalar>::type d(min, max);
+  fillFromDistribution(generator, out, d);
+}
+
+//==============================================================================
+template <typename Derived>
+void fillUniform(
+    Random::GeneratorType& generator,
+    const Eigen::MatrixBase<Derived>& out,
+    typename Derived::Scalar min,
+    typename Derived::Scalar max)
+{
+  fillUniform(
+      generator,
+      out,
+      min,
+      max,
+      std::is_floating_point<typename Derived::Scalar>());
+}
+
+//==============================================================================
+template <typename Derived>
+void fillNormal(
+    Random::GeneratorType& generator,
+    const Eigen::MatrixBase<Derived>& out,
+    typename Derived::Scalar mean,
+    typename Derived::Scalar sigma)
+{
+  static_assert(
+      std::is_floating_point<typename Derived::Scalar>::value,
+      "fillNormal() only supports floating-point matrices.");
+
+  Eigen::MatrixBase<Derived>& result = out.const_cast_derived();
+
+  // Box-Muller transform of pairs of uniform numbers, each of which gives a
+  // pair of normal numbers
+  const double pi = 3.14159265358979323846;
+
+  Eigen::ArrayXd u1;
+  Eigen::ArrayXd u2;
+  Eigen::ArrayXd values(kFillBlockSize);
+  const Eigen::Index size = result.size();
+  for (Eigen::Index offset = 0; offset < size; offset += kFillBlockSize)
+  {
+    const Eigen::Index count = std::min(kFillBlockSize, size - offset);
+    const Eigen::Index numPairs = (count + 1) / 2;
+
+    generateCanonical(generator, numPairs, u1);
+    generateCanonical(generator, numPairs, u2);
+
+    // 1 - u1 is in (0, 1], so its logarithm is finite
+    const Eigen::ArrayXd radius = (-2.0 * (1.0 - u1).log()).sqrt();
+    const Eigen::ArrayXd angle = (2.0 * pi) * u2;
+    values.head(numPairs) = radius * angle.cos();
+    values.segment(numPairs, numPairs) = radius * angle.sin();
+
+    scatterColumnMajor(
+        result,
+        offset,
+        static_cast<double>(mean)
+            + static_cast<double>(sigma) * values.head(count));
+  }
+}
+
 } // namespace detail
 
 //==============================================================================
 template <typename S>
 S Random::uniform(S min, S max)
 {
-  return detail::UniformImpl<S>::run(min, max);
+  return detail::UniformImpl<S>::run(getGenerator(), min, max);
 }
 
 //==============================================================================
@@ -453,7 +686,95 @@ DynamicSizeMatrixT Random::uniform(
 template <typename S>
 S Random::normal(S min, S max)
 {
-  return detail::NormalImpl<S>::run(min, max);
+  return detail::NormalImpl<S>::run(getGenerator(), min, max);
+}
+
+//==============================================================================
+template <typename Derived>
+void Random::fillUniform(
+    const Eigen::MatrixBase<Derived>& out,
+    typename Derived::Scalar min,
+    typename Derived::Scalar max)
+{
+  detail::fillUniform(getGenerator(), out, min, max);
+}
+
+//==============================================================================
+template <typename Derived>
+void Random::fillNormal(
+    const Eigen::MatrixBase<Derived>& out,
+    typename Derived::Scalar mean,
+    typename Derived::Scalar sigma)
+{
+  detail::fillNormal(getGenerator(), out, mean, sigma);
+}
+
+//==============================================================================
+template <typename S>
+S RandomStream::uniform(S min, S max)
+{
+  return detail::UniformImpl<S>::run(mGenerator, min, max);
+}
+
+//==============================================================================
+template <typename FixedSizeT>
+FixedSizeT RandomStream::uniform(
+    typename FixedSizeT::Scalar min, typename FixedSizeT::Scalar max)
+{
+  return uniform<FixedSizeT>(
+      FixedSizeT::Constant(min), FixedSizeT::Constant(max));
+}
+
+//==============================================================================
+template <typename DynamicSizeVectorT>
+DynamicSizeVectorT RandomStream::uniform(
+    int size,
+    typename DynamicSizeVectorT::Scalar min,
+    typename DynamicSizeVectorT::Scalar max)
+{
+  return uniform<DynamicSizeVectorT>(
+      DynamicSizeVectorT::Constant(size, min),
+      DynamicSizeVectorT::Constant(size, max));
+}
+
+//==============================================================================
+template <typename DynamicSizeMatrixT>
+DynamicSizeMatrixT RandomStream::uniform(
+    int rows,
+    int cols,
+    typename DynamicSizeMatrixT::Scalar min,
+    typename DynamicSizeMatrixT::Scalar max)
+{
+  return uniform<DynamicSizeMatrixT>(
+      DynamicSizeMatrixT::Constant(rows, cols, min),
+      DynamicSizeMatrixT::Constant(rows, cols, max));
+}
+
+//==============================================================================
+template <typename S>
+S RandomStream::normal(S mean, S sigma)
+{
+  return detail::NormalImpl<S>::run(mGenerator, mean, sigma);
+}
+
+//==============================================================================
+template <typename Derived>
+void RandomStream::fillUniform(
+    const Eigen::MatrixBase<Derived>& out,
+    typename Derived::Scalar min,
+    typename Derived::Scalar max)
+{
+  detail::fillUniform(mGenerator, out, min, max);
+}
+
+//==============================================================================
+template <typename Derived>
+void RandomStream::fillNormal(
+    const Eigen::MatrixBase<Derived>& out,
+    typename Derived::Scalar mean,
+    typename Derived::Scalar sigma)
+{
+  detail::fillNormal(mGenerator, out, mean, sigma);
 }
 
 } // namespace math
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/planning/KdTree.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <utility>
+
+#include "dart/common/Console.hpp"
+
+namespace dart {
+namespace planning {
+
+//==============================================================================
+KdTree::KdTree(std::size_t dimension)
+  : mDimension(dimension)
+{
+  // Do nothing
+}
+
+//==============================================================================
+std::size_t KdTree::getDimension() const
+{
+  return mDimension;
+}
+
+//==============================================================================
+std::size_t KdTree::getNumPoints() const
+{
+  return mNodes.size();
+}
+
+//==============================================================================
+void KdTree::reserve(std::size_t numPoints)
+{
+  mPoints.reserve(numPoints * mDimension);
+  mNodes.reserve(numPoints);
+}
+
+//==============================================================================
+void KdTree::clear()
+{
+  mPoints.clear();
+  mNodes.clear();
+}
+
+//==============================================================================
+std::size_t KdTree::addPoint(const Eigen::VectorXd& point)
+{
+  assert(mDimension > 0u);
+  assert(static_cast<std::size_t>(point.size()) == mDimension);
+
+  const int index = static_cast<int>(mNodes.size());
+  mPoints.insert(mPoints.end(), point.data(), point.data() + mDimension);
+
+  if (mNodes.empty())
+  {
+    mNodes.push_back(Node{-1, -1, 0});
+    return 0u;
+  }
+
+  // Descend to the leaf whose empty child should hold the new point
+  int current = 0;
+  while (true)
+  {
+    Node& node = mNodes[current];
+    const double split = getPointData(current)[node.mAxis];
+    int& child = (point[node.mAxis] < split) ? node.mLeft : node.mRight;
+
+    if (child < 0)
+    {
+      const int axis = static_cast<int>((node.mAxis + 1) % mDimension);
+      child = index;
+      mNodes.push_back(Node{-1, -1, axis});
+      break;
+    }
+
+    current = child;
+  }
+
+  return static_cast<std::size_t>(index);
+}
+
+//==============================================================================
+Eigen::Map<const Eigen::VectorXd> KdTree::getPoint(std::size_t index) const
+{
+  assert(index < mNodes.size());
+
+  return Eigen::Map<const Eigen::VectorXd>(
+        getPointData(index), static_cast<int>(mDimension));
+}
+
+//==============================================================================
+int KdTree::getNearest(
+    const Eigen::VectorXd& query, double* squaredDistance) const
+{
+  if (mNodes.empty())
+  {
+    if (squaredDistance)
+      *squaredDistance = std::numeric_limits<double>::infinity();
+
+    return -1;
+  }
+
+  if (static_cast<std::size_t>(query.size()) != mDimension)
+  {
+    dterr << "[KdTree::getNearest] The dimension of the query ("
+          << query.size() << ") does not match the dimension of the tree ("
+          << mDimension << ").\n";
+    return -1;
+  }
+
+  int nearest = -1;
+  double best = std::numeric_limits<double>::infinity();
+
+  // Each entry is a node to visit and a lower bound of the squared distance
+  // from the query to any point in its subtree.
+  std::vector<std::pair<int, double>> stack;
+  stack.reserve(64u);
+  stack.emplace_back(0, 0.0);
+
+  while (!stack.empty())
+  {
+    const int current = stack.back().first;
+    const double bound = stack.back().second;
+    stack.pop_back();
+
+    if (bound >= best)
+      continue;
+
+    const double* point = getPointData(current);
+    double distance = 0.0;
+    for (std::size_t i = 0u; i < mDimension; ++i)
+    {
+      const double diff = query[i] - point[i];
+      distance += diff * diff;
+    }
+
+    if (distance < best)
+    {
+      best = distance;
+      nearest = current;
+    }
+
+    const Node& node = mNodes[current];
+    const double diff = query[node.mAxis] - point[node.mAxis];
+    const int nearChild = (diff < 0.0) ? node.mLeft : node.mRight;
+    const int farChild = (diff < 0.0) ? node.mRight : node.mLeft;
+
+    // Push the far side first so that the near side is visited first and
+    // tightens the bound before the far side is tested.
+    if (farChild >= 0)
+      stack.emplace_back(farChild, std::max(bound, diff * diff));
+
+    if (nearChild >= 0)
+      stack.emplace_back(nearChild, bound);
+  }
+
+  if (squaredDistance)
+    *squaredDistance = best;
+
+  return nearest;
+}
+
+//==============================================================================
+const double* KdTree::getPointData(std::size_t index) const
+{
+  return mPoints.data() + index * mDimension;
+}
+
+} // namespace planning
+} // namespace dart
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_PLANNING_KDTREE_HPP_
+#define DART_PLANNING_KDTREE_HPP_
+
+#include <cstddef>
+#include <vector>
+#include <Eigen/Core>
+
+namespace dart {
+namespace planning {
+
+/// KdTree is an incremental k-d tree for exact nearest neighbor queries in
+/// Euclidean spaces. Points are appended to a single contiguous buffer and are
+/// never moved or rebalanced, so inserting a point costs one descent of the
+/// tree and no allocation beyond the amortized growth of the buffers. This
+/// suits sampling-based planners whose samples arrive in random order.
+class KdTree
+{
+public:
+  /// Constructor
+  explicit KdTree(std::size_t dimension = 0u);
+
+  /// Returns the dimension of the points
+  std::size_t getDimension() const;
+
+  /// Returns the number of points in the tree
+  std::size_t getNumPoints() const;
+
+  /// Reserves memory for the given number of points
+  void reserve(std::size_t numPoints);
+
+  /// Removes all the points. The dimension is kept.
+  void clear();
+
+  /// Adds a point to the tree and returns its index. Indices are assigned in
+  /// insertion order starting from zero.
+  std::size_t addPoint(const Eigen::VectorXd& point);
+
+  /// Returns the point of the given index. The returned map is invalidated by
+  /// the next call of addPoint() or reserve().
+  Eigen::Map<const Eigen::VectorXd> getPoint(std::size_t index) const;
+
+  /// Returns the index of the point nearest to the query point, or -1 if the
+  /// tree is empty. If squaredDistance is not nullptr, the squared distance to
+  /// the nearest point is written to it. Concurrent queries are safe as long as
+  /// no point is added at the same time.
+  int getNearest(
+      const Eigen::VectorXd& query, double* squaredDistance = nullptr) const;
+
+protected:
+  /// Node of the tree. Node i holds point i and splits the space along
+  /// mAxis at the coordinate of its point.
+  struct Node
+  {
+    int mLeft;
+    int mRight;
+    int mAxis;
+  };
+
+  /// Returns a pointer to the coordinates of the point of the given index
+  const double* getPointData(std::size_t index) const;
+
+  /// Dimension of the points
+  std::size_t mDimension;
+
+  /// Coordinates of all the points, stored point after point
+  std::vector<double> mPoints;
+
+  /// Nodes of the tree. The root is the first node.
+  std::vector<Node> mNodes;
+};
+
+} // namespace planning
+} // namespace dart
+
+#endif // DART_PLANNING_KDTREE_HPP_
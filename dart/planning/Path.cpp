@@ -53,7 +53,8 @@ public:
 	LinearPathSegment(const Eigen::VectorXd &start, const Eigen::VectorXd &end) :
     PathSegment((end-start).norm()),
 		start(start),
-    end(end)
+    end(end),
+		tangent((end - start) / length)
 	{
 	}
 
@@ -64,7 +65,7 @@ public:
 	}
 
 	Eigen::VectorXd getTangent(double /* s */) const {
-		return (end - start) / length;
+		return tangent;
 	}
 
 	Eigen::VectorXd getCurvature(double /* s */) const {
@@ -79,9 +80,14 @@ public:
 		return new LinearPathSegment(*this);
 	}
 
+	bool isStraight() const {
+		return true;
+	}
+
 private:
 	Eigen::VectorXd start;
 	Eigen::VectorXd end;
+	Eigen::VectorXd tangent;
 };
 
 
@@ -219,8 +225,10 @@ Path::Path(const list<VectorXd> &path, double maxDeviation) :
 	}
 
 	// create list of switching point candidates, calculate total path length and absolute positions of path segments
-  for(list<PathSegment*>::iterator segment = pathSegments.begin(); segment != pathSegments.end(); ++segment) {
+  segmentPositions.reserve(pathSegments.size());
+  for(vector<PathSegment*>::iterator segment = pathSegments.begin(); segment != pathSegments.end(); ++segment) {
 		(*segment)->position = length;
+		segmentPositions.push_back(length);
 		list<double> localSwitchingPoints = (*segment)->getSwitchingPoints();
     for(list<double>::const_iterator point = localSwitchingPoints.begin(); point != localSwitchingPoints.end(); ++point) {
 			switchingPoints.push_back(make_pair(length + *point, false));
@@ -233,15 +241,17 @@ Path::Path(const list<VectorXd> &path, double maxDeviation) :
 
 Path::Path(const Path &path) :
 	length(path.length),
-	switchingPoints(path.switchingPoints)
+	switchingPoints(path.switchingPoints),
+	segmentPositions(path.segmentPositions)
 {
-  for(list<PathSegment*>::const_iterator it = path.pathSegments.begin(); it != path.pathSegments.end(); ++it) {
+  pathSegments.reserve(path.pathSegments.size());
+  for(vector<PathSegment*>::const_iterator it = path.pathSegments.begin(); it != path.pathSegments.end(); ++it) {
 		pathSegments.push_back((*it)->clone());
 	}
 }
 
 Path::~Path() {
-  for(list<PathSegment*>::iterator it = pathSegments.begin(); it != pathSegments.end(); ++it) {
+  for(vector<PathSegment*>::iterator it = pathSegments.begin(); it != pathSegments.end(); ++it) {
 		delete *it;
 	}
 }
@@ -250,16 +260,26 @@ double Path::getLength() const {
 	return length;
 }
 
+std::size_t Path::getPathSegmentIndex(double s) const {
+	// the segment is the last one that starts at or before s, and the first one if none does
+	vector<double>::const_iterator it = upper_bound(segmentPositions.begin() + 1, segmentPositions.end(), s);
+	return (it - segmentPositions.begin()) - 1;
+}
+
 PathSegment* Path::getPathSegment(double &s) const {
-	list<PathSegment*>::const_iterator it = pathSegments.begin();
-	list<PathSegment*>::const_iterator next = it;
-  ++next;
-	while(next != pathSegments.end() && s >= (*next)->position) {
-		it = next;
-    ++next;
-	}
-	s -= (*it)->position;
-	return *it;
+	PathSegment* pathSegment = pathSegments[getPathSegmentIndex(s)];
+	s -= pathSegment->position;
+	return pathSegment;
+}
+
+bool Path::isStraight(double s) const {
+	return pathSegments[getPathSegmentIndex(s)]->isStraight();
+}
+
+void Path::getSegmentRange(double s, double &start, double &end) const {
+	const PathSegment* pathSegment = pathSegments[getPathSegmentIndex(s)];
+	start = pathSegment->position;
+	end = pathSegment->position + pathSegment->getLength();
 }
 
 VectorXd Path::getConfig(double s) const {
@@ -292,7 +312,7 @@ double Path::getNextSwitchingPoint(double s, bool &discontinuity) const {
 	}
 }
 
-list<pair<double, bool> > Path::getSwitchingPoints() const {
+const list<pair<double, bool> > &Path::getSwitchingPoints() const {
 	return switchingPoints;
 }
 
@@ -36,6 +36,7 @@
 #define DART_PLANNING_PATH_HPP_
 
 #include <list>
+#include <vector>
 #include <Eigen/Core>
 
 namespace dart {
@@ -60,6 +61,11 @@ public:
 	virtual std::list<double> getSwitchingPoints() const = 0;
 	virtual PathSegment* clone() const = 0;
 
+	/// Returns true if the curvature is zero along the whole segment
+	virtual bool isStraight() const {
+		return false;
+	}
+
 	double position;
 protected:
 	double length;
@@ -78,12 +84,20 @@ public:
 	Eigen::VectorXd getTangent(double s) const;
 	Eigen::VectorXd getCurvature(double s) const;
 	double getNextSwitchingPoint(double s, bool &discontinuity) const;
-	std::list<std::pair<double, bool> > getSwitchingPoints() const;
+	const std::list<std::pair<double, bool> > &getSwitchingPoints() const;
+
+	/// Returns true if the path is straight at s, i.e., its curvature is zero
+	bool isStraight(double s) const;
+
+	/// Returns the path positions at which the segment that contains s starts and ends
+	void getSegmentRange(double s, double &start, double &end) const;
 private:
+	std::size_t getPathSegmentIndex(double s) const;
 	PathSegment* getPathSegment(double &s) const;
 	double length;
 	std::list<std::pair<double, bool> > switchingPoints;
-	std::list<PathSegment*> pathSegments;
+	std::vector<PathSegment*> pathSegments;
+	std::vector<double> segmentPositions; ///< Start positions of the segments, for binary search
 };
 
 } // namespace planning
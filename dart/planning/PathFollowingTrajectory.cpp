@@ -34,8 +34,11 @@
 
 #include "dart/planning/PathFollowingTrajectory.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <iostream>
+#include <iterator>
 #include <fstream>
 
 using namespace Eigen;
@@ -57,8 +60,12 @@ PathFollowingTrajectory::PathFollowingTrajectory(const Path &path, const VectorX
 	maxAcceleration(maxAcceleration),
 	n(maxVelocity.size()),
 	valid(true),
-    cachedTime(numeric_limits<double>::max())
+	nextPathSample(0)
 {
+	for(std::size_t i = 0; i < numPathSamples; i++) {
+		pathSamples[i].pathPos = numeric_limits<double>::quiet_NaN();
+	}
+
 	// debug
 	//{
 	//ofstream file("maxVelocity.txt");
@@ -91,17 +98,15 @@ PathFollowingTrajectory::PathFollowingTrajectory(const Path &path, const VectorX
 	double beforeAcceleration = getMinMaxPathAcceleration(path.getLength(), 0.0, false);
 	integrateBackward(endTrajectory, startTrajectory, beforeAcceleration);
 	
-	this->trajectory = startTrajectory;
+	// store the steps contiguously so that the segments can be found by binary search
+	this->trajectory.assign(startTrajectory.begin(), startTrajectory.end());
 
 	// calculate timing
-    list<TrajectoryStep>::iterator previous = trajectory.begin();
-    list<TrajectoryStep>::iterator it = previous;
-	it->time = 0.0;
-  ++it;
-	while(it != trajectory.end()) {
-		it->time = previous->time + (it->pathPos - previous->pathPos) / ((it->pathVel + previous->pathVel) / 2.0);
-		previous = it;
-    ++it;
+	trajectory.front().time = 0.0;
+	for(std::size_t i = 1; i < trajectory.size(); i++) {
+		const TrajectoryStep &previous = trajectory[i - 1];
+		TrajectoryStep &step = trajectory[i];
+		step.time = previous.time + (step.pathPos - previous.pathPos) / ((step.pathVel + previous.pathVel) / 2.0);
 	}
 
 	// debug
@@ -202,6 +207,11 @@ bool PathFollowingTrajectory::getNextVelocitySwitchingPoint(double pathPos, Traj
 	do {
 		pathPos += stepSize;
 
+		// On straight parts of the path the limit curve is flat while the minimum phase slope is
+		// negative, so no velocity switching point can start there.
+		if(!start && path.isStraight(pathPos)) {
+			continue;
+		}
 
 		if(getMinMaxPhaseSlope(pathPos, getVelocityMaxPathVelocity(pathPos), false) >= getVelocityMaxPathVelocityDeriv(pathPos)) {
 			start = true;
@@ -236,8 +246,8 @@ bool PathFollowingTrajectory::integrateForward(list<TrajectoryStep> &trajectory,
 	double pathPos = trajectory.back().pathPos;
 	double pathVel = trajectory.back().pathVel;
 	
-    list<pair<double, bool> > switchingPoints = path.getSwitchingPoints();
-    list<pair<double, bool> >::iterator nextDiscontinuity = switchingPoints.begin();
+    const list<pair<double, bool> > &switchingPoints = path.getSwitchingPoints();
+    list<pair<double, bool> >::const_iterator nextDiscontinuity = switchingPoints.begin();
 
 	while(true)
 	{
@@ -285,6 +295,17 @@ bool PathFollowingTrajectory::integrateForward(list<TrajectoryStep> &trajectory,
 		trajectory.push_back(TrajectoryStep(pathPos, pathVel));
 		acceleration = getMinMaxPathAcceleration(pathPos, pathVel, true);
 
+		// skip the steps that the closed-form solution on a straight segment makes unnecessary
+		TrajectoryStep skipStep;
+		if(getStraightForwardStep(pathPos, pathVel, acceleration,
+			nextDiscontinuity != switchingPoints.end() ? nextDiscontinuity->first : path.getLength(), skipStep))
+		{
+			pathPos = skipStep.pathPos;
+			pathVel = skipStep.pathVel;
+			trajectory.push_back(skipStep);
+			acceleration = getMinMaxPathAcceleration(pathPos, pathVel, true);
+		}
+
 		if(pathVel > getAccelerationMaxPathVelocity(pathPos) || pathVel > getVelocityMaxPathVelocity(pathPos)) {
 			// find more accurate intersection with max-velocity curve using bisection
 			TrajectoryStep overshoot = trajectory.back();
@@ -332,15 +353,25 @@ void PathFollowingTrajectory::integrateBackward(list<TrajectoryStep> &trajectory
     list<TrajectoryStep>::reverse_iterator before = startTrajectory.rbegin();
 	double pathPos = trajectory.front().pathPos;
 	double pathVel = trajectory.front().pathVel;
+	bool isAccelerationLimit = false;
 
 	while(true)
 	{
 		//pathPos -= timeStep * pathVel;
 		//pathVel -= timeStep * acceleration;
 
-		double oldPathVel = pathVel;
-		pathVel -= timeStep * acceleration;
-		pathPos -= timeStep * 0.5 * (oldPathVel + pathVel);
+		// skip the steps that the closed-form solution on a straight segment makes unnecessary
+		TrajectoryStep skipStep;
+		if(isAccelerationLimit && getStraightBackwardStep(pathPos, pathVel, acceleration, startTrajectory, before, skipStep)) {
+			pathPos = skipStep.pathPos;
+			pathVel = skipStep.pathVel;
+		}
+		else {
+			double oldPathVel = pathVel;
+			pathVel -= timeStep * acceleration;
+			pathPos -= timeStep * 0.5 * (oldPathVel + pathVel);
+		}
+		isAccelerationLimit = true;
 
 		trajectory.push_front(TrajectoryStep(pathPos, pathVel));
 		acceleration = getMinMaxPathAcceleration(pathPos, pathVel, false);
@@ -357,7 +388,7 @@ void PathFollowingTrajectory::integrateBackward(list<TrajectoryStep> &trajectory
 
 		bool error = false;
 
-		if(before != startTrajectory.rbegin() && pathVel >= before->pathVel + getSlope(before.base()) * (pathPos - before->pathPos)) {
+		if(before != startTrajectory.rbegin() && pathVel * pathVel >= getSquaredPathVel(*before, *before.base(), pathPos)) {
 			TrajectoryStep overshoot = trajectory.front();
 			trajectory.pop_front();
             list<TrajectoryStep>::iterator after = before.base();
@@ -426,23 +457,28 @@ inline double PathFollowingTrajectory::getSlope(const TrajectoryStep &point1, co
 	return (point2.pathVel - point1.pathVel) / (point2.pathPos - point1.pathPos);
 }
 
-inline double PathFollowingTrajectory::getSlope(list<TrajectoryStep>::const_iterator lineEnd) {
-	list<TrajectoryStep>::const_iterator lineStart = lineEnd;
-  --lineStart;
-	return getSlope(*lineStart, *lineEnd);
+inline double PathFollowingTrajectory::getSquaredSlope(const TrajectoryStep &point1, const TrajectoryStep &point2) {
+	return (point2.pathVel * point2.pathVel - point1.pathVel * point1.pathVel) / (point2.pathPos - point1.pathPos);
 }
 
+inline double PathFollowingTrajectory::getSquaredPathVel(const TrajectoryStep &point1, const TrajectoryStep &point2, double pathPos) {
+	return point1.pathVel * point1.pathVel + getSquaredSlope(point1, point2) * (pathPos - point1.pathPos);
+}
+
+// The trajectories are intersected in the plane of the path position and the squared path velocity,
+// in which a curve of constant acceleration is a line. This keeps the intersection exact where the
+// steps are far apart on straight segments.
 PathFollowingTrajectory::TrajectoryStep PathFollowingTrajectory::getIntersection(const list<TrajectoryStep> &trajectory, list<TrajectoryStep>::iterator &it, const TrajectoryStep &linePoint1, const TrajectoryStep &linePoint2) {
 	
-	const double lineSlope = getSlope(linePoint1, linePoint2);
+	const double lineSlope = getSquaredSlope(linePoint1, linePoint2);
 	it--;
 
 	double factor = 1.0;
-	if(it->pathVel > linePoint1.pathVel + lineSlope * (it->pathPos - linePoint1.pathPos))
+	if(it->pathVel * it->pathVel > getSquaredPathVel(linePoint1, linePoint2, it->pathPos))
 		factor = -1.0;
 	it++;
 	
-	while(it != trajectory.end() && factor * it->pathVel < factor * (linePoint1.pathVel + lineSlope * (it->pathPos - linePoint1.pathPos))) {
+	while(it != trajectory.end() && factor * it->pathVel * it->pathVel < factor * getSquaredPathVel(linePoint1, linePoint2, it->pathPos)) {
 		it++;
 	}
 
@@ -450,18 +486,109 @@ PathFollowingTrajectory::TrajectoryStep PathFollowingTrajectory::getIntersection
 		return TrajectoryStep(0.0, 0.0);
 	}
 	else {
-		const double trajectorySlope = getSlope(it);
-		const double intersectionPathPos = (it->pathVel - linePoint1.pathVel + lineSlope * linePoint1.pathPos - trajectorySlope * it->pathPos)
-			/ (lineSlope - trajectorySlope);
-		const double intersectionPathVel = linePoint1.pathVel + lineSlope * (intersectionPathPos - linePoint1.pathPos);
+		const double trajectorySlope = getSquaredSlope(*prev(it), *it);
+		const double intersectionPathPos = (it->pathVel * it->pathVel - linePoint1.pathVel * linePoint1.pathVel
+			+ lineSlope * linePoint1.pathPos - trajectorySlope * it->pathPos) / (lineSlope - trajectorySlope);
+		const double intersectionPathVel = sqrt(max(0.0, getSquaredPathVel(linePoint1, linePoint2, intersectionPathPos)));
 		return TrajectoryStep(intersectionPathPos, intersectionPathVel);
 	}
 }
 
+bool PathFollowingTrajectory::getStraightForwardStep(double pathPos, double pathVel, double acceleration,
+	double endPathPos, TrajectoryStep &step)
+{
+	if(acceleration <= 0.0 || !path.isStraight(pathPos)) {
+		return false;
+	}
+
+	double segmentStart, segmentEnd;
+	path.getSegmentRange(pathPos, segmentStart, segmentEnd);
+	endPathPos = min(endPathPos, segmentEnd);
+
+	// Accelerate until the velocity limit is reached and keep the velocity from there on, but stop
+	// one step before the end of the segment so that stepping takes over where the limits change.
+	const double maxPathVel = getVelocityMaxPathVelocity(pathPos);
+	const double limitPathPos = pathPos + (maxPathVel * maxPathVel - pathVel * pathVel) / (2.0 * acceleration);
+	if(pathVel >= maxPathVel) {
+		step = TrajectoryStep(endPathPos - timeStep * pathVel, pathVel);
+	}
+	else if(limitPathPos < endPathPos) {
+		step = TrajectoryStep(limitPathPos, maxPathVel);
+	}
+	else {
+		const double endPathVel = sqrt(pathVel * pathVel + 2.0 * acceleration * (endPathPos - pathPos));
+		step.pathPos = endPathPos - timeStep * endPathVel;
+		step.pathVel = sqrt(max(0.0, pathVel * pathVel + 2.0 * acceleration * (step.pathPos - pathPos)));
+	}
+
+	// only skip if it saves steps
+	return step.pathPos > pathPos + timeStep * (pathVel + timeStep * acceleration);
+}
+
+bool PathFollowingTrajectory::getStraightBackwardStep(double pathPos, double pathVel, double acceleration,
+	const list<TrajectoryStep> &startTrajectory, list<TrajectoryStep>::const_reverse_iterator before,
+	TrajectoryStep &step)
+{
+	if(acceleration >= 0.0 || !path.isStraight(pathPos)) {
+		return false;
+	}
+
+	double segmentStart, segmentEnd;
+	path.getSegmentRange(pathPos, segmentStart, segmentEnd);
+
+	// Going backward the velocity increases. Stop one step after the start of the segment, or one
+	// step after the velocity limit is reached.
+	const double startPathVel = sqrt(pathVel * pathVel + 2.0 * acceleration * (segmentStart - pathPos));
+	step.pathPos = segmentStart + timeStep * startPathVel;
+	const double maxPathVel = getVelocityMaxPathVelocity(pathPos);
+	if(startPathVel > maxPathVel) {
+		const double limitPathPos = pathPos + (maxPathVel * maxPathVel - pathVel * pathVel) / (2.0 * acceleration);
+		step.pathPos = max(step.pathPos, limitPathPos + timeStep * maxPathVel);
+	}
+
+	// Stop at the first step of the start trajectory that is not above the curve, which is where
+	// the stepping would have detected the intersection. Between the steps both curves are lines
+	// in the plane of the squared velocity, so checking the steps is enough.
+	for(; before != startTrajectory.rend() && before->pathPos >= step.pathPos; ++before) {
+		if(before != startTrajectory.rbegin() && before->pathPos < pathPos
+			&& pathVel * pathVel + 2.0 * acceleration * (before->pathPos - pathPos) >= before->pathVel * before->pathVel)
+		{
+			step.pathPos = before->pathPos;
+			break;
+		}
+	}
+
+	if(step.pathPos >= pathPos - timeStep * (pathVel - timeStep * acceleration)) {
+		return false;
+	}
+
+	step.pathVel = sqrt(pathVel * pathVel + 2.0 * acceleration * (step.pathPos - pathPos));
+	return true;
+}
+
+
+PathFollowingTrajectory::PathSample &PathFollowingTrajectory::getPathSample(double pathPos) {
+	for(std::size_t i = 0; i < numPathSamples; i++) {
+		if(pathSamples[i].pathPos == pathPos) {
+			return pathSamples[i];
+		}
+	}
+
+	PathSample &sample = pathSamples[nextPathSample];
+	nextPathSample = (nextPathSample + 1) % numPathSamples;
+	sample.pathPos = pathPos;
+	sample.tangent = path.getTangent(pathPos);
+	sample.curvature = path.getCurvature(pathPos);
+	sample.isStraight = (sample.curvature.array() == 0.0).all();
+	sample.hasAccelerationMaxPathVelocity = false;
+	sample.hasVelocityMaxPathVelocity = false;
+	return sample;
+}
 
 double PathFollowingTrajectory::getMinMaxPathAcceleration(double pathPos, double pathVel, bool max) {
-	VectorXd configDeriv = path.getTangent(pathPos);
-	VectorXd configDeriv2 = path.getCurvature(pathPos);
+	const PathSample &sample = getPathSample(pathPos);
+	const VectorXd &configDeriv = sample.tangent;
+	const VectorXd &configDeriv2 = sample.curvature;
 	double factor = max ? 1.0 : -1.0;
 	double maxPathAcceleration = numeric_limits<double>::max();
 	for(unsigned int i = 0; i < n; i++) {
@@ -478,10 +605,16 @@ double PathFollowingTrajectory::getMinMaxPhaseSlope(double pathPos, double pathV
 }
 
 double PathFollowingTrajectory::getAccelerationMaxPathVelocity(double pathPos) {
+	PathSample &sample = getPathSample(pathPos);
+	if(sample.hasAccelerationMaxPathVelocity) {
+		return sample.accelerationMaxPathVelocity;
+	}
+
+	// without curvature none of the terms below limits the velocity
 	double maxPathVelocity = numeric_limits<double>::infinity();
-	const VectorXd configDeriv = path.getTangent(pathPos);
-	const VectorXd configDeriv2 = path.getCurvature(pathPos);
-	for(unsigned int i = 0; i < n; i++) {
+	const VectorXd &configDeriv = sample.tangent;
+	const VectorXd &configDeriv2 = sample.curvature;
+	for(unsigned int i = 0; i < n && !sample.isStraight; i++) {
 		if(configDeriv[i] != 0.0) {
 			for(unsigned int j = i + 1; j < n; j++) {
 				if(configDeriv[j] != 0.0) {
@@ -498,16 +631,25 @@ double PathFollowingTrajectory::getAccelerationMaxPathVelocity(double pathPos) {
       maxPathVelocity = min(maxPathVelocity, sqrt(maxAcceleration[i] / std::abs(configDeriv2[i])));
 		}
 	}
+	sample.accelerationMaxPathVelocity = maxPathVelocity;
+	sample.hasAccelerationMaxPathVelocity = true;
 	return maxPathVelocity;
 }
 
 
 double PathFollowingTrajectory::getVelocityMaxPathVelocity(double pathPos) {
-	const VectorXd tangent = path.getTangent(pathPos);
+	PathSample &sample = getPathSample(pathPos);
+	if(sample.hasVelocityMaxPathVelocity) {
+		return sample.velocityMaxPathVelocity;
+	}
+
+	const VectorXd &tangent = sample.tangent;
 	double maxPathVelocity = numeric_limits<double>::max();
 	for(unsigned int i = 0; i < n; i++) {
     maxPathVelocity = min(maxPathVelocity, maxVelocity[i] / std::abs(tangent[i]));
 	}
+	sample.velocityMaxPathVelocity = maxPathVelocity;
+	sample.hasVelocityMaxPathVelocity = true;
 	return maxPathVelocity;
 }
 
@@ -516,7 +658,8 @@ double PathFollowingTrajectory::getAccelerationMaxPathVelocityDeriv(double pathP
 }
 
 double PathFollowingTrajectory::getVelocityMaxPathVelocityDeriv(double pathPos) {
-	const VectorXd tangent = path.getTangent(pathPos);
+	const PathSample &sample = getPathSample(pathPos);
+	const VectorXd &tangent = sample.tangent;
 	double maxPathVelocity = numeric_limits<double>::max();
   unsigned int activeConstraint = 0;
 	for(unsigned int i = 0; i < n; i++) {
@@ -526,7 +669,7 @@ double PathFollowingTrajectory::getVelocityMaxPathVelocityDeriv(double pathPos)
 			activeConstraint = i;
 		}
 	}
-	return - (maxVelocity[activeConstraint] * path.getCurvature(pathPos)[activeConstraint])
+	return - (maxVelocity[activeConstraint] * sample.curvature[activeConstraint])
     / (tangent[activeConstraint] * std::abs(tangent[activeConstraint]));
 }
 
@@ -538,72 +681,90 @@ double PathFollowingTrajectory::getDuration() const {
 	return trajectory.back().time;
 }
 
-list<PathFollowingTrajectory::TrajectoryStep>::const_iterator PathFollowingTrajectory::getTrajectorySegment(double time) const {
-	if(time >= trajectory.back().time) {
-		list<TrajectoryStep>::const_iterator last = trajectory.end();
-    --last;
+std::size_t PathFollowingTrajectory::getTrajectorySegment(double time, std::size_t first) const {
+	// the segment ends at the first step after the given time
+	const std::size_t last = trajectory.size() - 1;
+	if(time >= trajectory.back().time || first >= last) {
 		return last;
 	}
-	else {
-		if(time < cachedTime) {
-			cachedTrajectorySegment = trajectory.begin();
-		}
-		while(time >= cachedTrajectorySegment->time) {
-      ++cachedTrajectorySegment;
-		}
-		cachedTime = time;
-		return cachedTrajectorySegment;
-	}
+	vector<TrajectoryStep>::const_iterator it = upper_bound(trajectory.begin() + max<std::size_t>(first, 1), trajectory.end() - 1, time,
+		[](double time, const TrajectoryStep &step) { return time < step.time; });
+	return it - trajectory.begin();
 }
 
-VectorXd PathFollowingTrajectory::getPosition(double time) const {
-	list<TrajectoryStep>::const_iterator it = getTrajectorySegment(time);
-	list<TrajectoryStep>::const_iterator previous = it;
-  --previous;
-	
-	//const double pathPos = previous->pathPos + (time - previous->time) * (previous->pathVel + it->pathVel) / 2.0;
-	
-	double timeStep = it->time - previous->time;
-	const double acceleration = (it->pathPos - previous->pathPos - timeStep * previous->pathVel) / (timeStep * timeStep);
+void PathFollowingTrajectory::getPathState(double time, std::size_t segment, double &pathPos, double &pathVel) const {
+	const TrajectoryStep &previous = trajectory[segment - 1];
+	const TrajectoryStep &step = trajectory[segment];
 
-	timeStep = time - previous->time;
-	const double pathPos = previous->pathPos + timeStep * previous->pathVel + timeStep * timeStep * acceleration; 
-	
+	double timeStep = step.time - previous.time;
+	const double acceleration = (step.pathPos - previous.pathPos - timeStep * previous.pathVel) / (timeStep * timeStep);
+
+	timeStep = time - previous.time;
+	pathPos = previous.pathPos + timeStep * previous.pathVel + timeStep * timeStep * acceleration;
+	pathVel = previous.pathVel + timeStep * acceleration;
+}
+
+VectorXd PathFollowingTrajectory::getPosition(double time) const {
+	double pathPos, pathVel;
+	getPathState(time, getTrajectorySegment(time), pathPos, pathVel);
 	return path.getConfig(pathPos);
 }
 
 VectorXd PathFollowingTrajectory::getVelocity(double time) const {
-	list<TrajectoryStep>::const_iterator it = getTrajectorySegment(time);
-	list<TrajectoryStep>::const_iterator previous = it;
-  --previous;
-	
-	//const double pathPos = previous->pathPos + (time - previous->time) * (previous->pathVel + it->pathVel) / 2.0;
-	
-	double timeStep = it->time - previous->time;
-	const double acceleration = (it->pathPos - previous->pathPos - timeStep * previous->pathVel) / (timeStep * timeStep);
-
-	timeStep = time - previous->time;
-	const double pathPos = previous->pathPos + timeStep * previous->pathVel + timeStep * timeStep * acceleration; 
-	const double pathVel = previous->pathVel + timeStep * acceleration;
-	
+	double pathPos, pathVel;
+	getPathState(time, getTrajectorySegment(time), pathPos, pathVel);
 	return path.getTangent(pathPos) * pathVel;
 }
 
+void PathFollowingTrajectory::sample(const VectorXd &times, MatrixXd &positions, MatrixXd &velocities) const {
+	positions.resize(n, times.size());
+	velocities.resize(n, times.size());
+
+	// search only the remaining steps while the times increase
+	std::size_t segment = 1;
+	for(int i = 0; i < times.size(); i++) {
+		if(i == 0 || times[i] < times[i - 1]) {
+			segment = 1;
+		}
+		segment = getTrajectorySegment(times[i], segment);
+
+		double pathPos, pathVel;
+		getPathState(times[i], segment, pathPos, pathVel);
+		positions.col(i) = path.getConfig(pathPos);
+		velocities.col(i) = path.getTangent(pathPos) * pathVel;
+	}
+}
+
+MatrixXd PathFollowingTrajectory::sample(const VectorXd &times) const {
+	MatrixXd positions(n, times.size());
+	std::size_t segment = 1;
+	for(int i = 0; i < times.size(); i++) {
+		if(i == 0 || times[i] < times[i - 1]) {
+			segment = 1;
+		}
+		segment = getTrajectorySegment(times[i], segment);
+
+		double pathPos, pathVel;
+		getPathState(times[i], segment, pathPos, pathVel);
+		positions.col(i) = path.getConfig(pathPos);
+	}
+	return positions;
+}
+
 double PathFollowingTrajectory::getMaxAccelerationError() {
 	double maxAccelerationError = 0.0;
 
+	std::size_t segment = 1;
 	for(double time = 0.0; time < getDuration(); time += 0.000001) {
-		list<TrajectoryStep>::const_iterator it = getTrajectorySegment(time);
-		list<TrajectoryStep>::const_iterator previous = it;
-    --previous;
+		segment = getTrajectorySegment(time, segment);
+		const TrajectoryStep &previous = trajectory[segment - 1];
+		const TrajectoryStep &step = trajectory[segment];
 
-		double timeStep = it->time - previous->time;
-		const double pathAcceleration = (it->pathPos - previous->pathPos - timeStep * previous->pathVel) / (timeStep * timeStep);
-		
-		timeStep = time - previous->time;
-		const double pathPos = previous->pathPos + timeStep * previous->pathVel + timeStep * timeStep * pathAcceleration;
+		double timeStep = step.time - previous.time;
+		const double pathAcceleration = (step.pathPos - previous.pathPos - timeStep * previous.pathVel) / (timeStep * timeStep);
 
-		const double pathVel = previous->pathVel + timeStep * pathAcceleration;
+		double pathPos, pathVel;
+		getPathState(time, segment, pathPos, pathVel);
 
 		VectorXd acceleration = path.getTangent(pathPos) * pathAcceleration + path.getCurvature(pathPos) * pathVel * pathVel;
 		
@@ -35,6 +35,7 @@
 #ifndef DART_PLANNING_PATHFOLLOWINGTRAJECTORY_HPP_
 #define DART_PLANNING_PATHFOLLOWINGTRAJECTORY_HPP_
 
+#include <vector>
 #include <Eigen/Core>
 #include "dart/planning/Path.hpp"
 #include "dart/planning/Trajectory.hpp"
@@ -54,6 +55,15 @@ public:
 	Eigen::VectorXd getVelocity(double time) const;
 	double getMaxAccelerationError();
 
+	/// Samples the trajectory at the given times, which do not need to be sorted. Column i of
+	/// positions and velocities is the configuration and velocity at times[i]. Sampling does not
+	/// modify the trajectory, so it is safe to sample from several threads at once.
+	void sample(const Eigen::VectorXd &times, Eigen::MatrixXd &positions,
+		Eigen::MatrixXd &velocities) const;
+
+	/// Returns the configurations at the given times, one column per time.
+	Eigen::MatrixXd sample(const Eigen::VectorXd &times) const;
+
 private:
 	struct TrajectoryStep {
 		TrajectoryStep() {}
@@ -67,6 +77,23 @@ private:
 		double time;
 	};
 
+	/// The tangent and curvature of the path at a path position and the limits of the path
+	/// velocity that follow from them. The integration evaluates the same positions several
+	/// times in a row, so the most recent samples are kept.
+	struct PathSample {
+		double pathPos;
+		Eigen::VectorXd tangent;
+		Eigen::VectorXd curvature;
+		bool isStraight;
+		double accelerationMaxPathVelocity;
+		double velocityMaxPathVelocity;
+		bool hasAccelerationMaxPathVelocity;
+		bool hasVelocityMaxPathVelocity;
+	};
+
+	/// Returns the sample at the given path position, evaluating the path if it is not kept
+	PathSample &getPathSample(double pathPos);
+
 	bool getNextSwitchingPoint(double pathPos, TrajectoryStep &nextSwitchingPoint, double &beforeAcceleration, double &afterAcceleration);
 	bool getNextAccelerationSwitchingPoint(double pathPos, TrajectoryStep &nextSwitchingPoint, double &beforeAcceleration, double &afterAcceleration);
 	bool getNextVelocitySwitchingPoint(double pathPos, TrajectoryStep &nextSwitchingPoint, double &beforeAcceleration, double &afterAcceleration);
@@ -81,22 +108,51 @@ private:
 	
 	TrajectoryStep getIntersection(const std::list<TrajectoryStep> &trajectory, std::list<TrajectoryStep>::iterator &it, const TrajectoryStep &linePoint1, const TrajectoryStep &linePoint2);
 	inline double getSlope(const TrajectoryStep &point1, const TrajectoryStep &point2);
-	inline double getSlope(std::list<TrajectoryStep>::const_iterator lineEnd);
+
+	/// Returns the slope of the line through the given steps in the plane of the path position and
+	/// the squared path velocity
+	inline double getSquaredSlope(const TrajectoryStep &point1, const TrajectoryStep &point2);
+
+	/// Returns the squared path velocity at the given path position on the line through the given
+	/// steps in the plane of the path position and the squared path velocity
+	inline double getSquaredPathVel(const TrajectoryStep &point1, const TrajectoryStep &point2, double pathPos);
+
+	/// On a straight segment the acceleration limits are constant, so the forward integration with
+	/// the maximum acceleration has a closed-form solution. Returns the step at which stepping
+	/// resumes, which is where the velocity limit is reached or one step before endPathPos or the
+	/// end of the segment. Returns false if no step is skipped.
+	bool getStraightForwardStep(double pathPos, double pathVel, double acceleration, double endPathPos,
+		TrajectoryStep &step);
+
+	/// The counterpart of getStraightForwardStep() for the backward integration with the minimum
+	/// acceleration. The returned step is also where the backward trajectory reaches the step
+	/// before, or at, its intersection with startTrajectory, as with stepping. before is the last
+	/// step of startTrajectory at or before pathPos.
+	bool getStraightBackwardStep(double pathPos, double pathVel, double acceleration,
+		const std::list<TrajectoryStep> &startTrajectory, std::list<TrajectoryStep>::const_reverse_iterator before,
+		TrajectoryStep &step);
 	
-	std::list<TrajectoryStep>::const_iterator getTrajectorySegment(double time) const;
+	/// Returns the index of the step at the end of the segment that contains the given time. The
+	/// search is a binary search within [first, trajectory.size()).
+	std::size_t getTrajectorySegment(double time, std::size_t first = 1) const;
+
+	/// Returns the path position and velocity at the given time within the segment that ends at
+	/// the given step.
+	void getPathState(double time, std::size_t segment, double &pathPos, double &pathVel) const;
 	
 	Path path;
 	Eigen::VectorXd maxVelocity;
 	Eigen::VectorXd maxAcceleration;
 	unsigned int n;
 	bool valid;
-	std::list<TrajectoryStep> trajectory;
+	std::vector<TrajectoryStep> trajectory;
 
 	static const double eps;
 	static const double timeStep;
 
-	mutable double cachedTime;
-	mutable std::list<TrajectoryStep>::const_iterator cachedTrajectorySegment;
+	static const std::size_t numPathSamples = 4;
+	PathSample pathSamples[numPathSamples];
+	std::size_t nextPathSample;
 };
 
 } // namespace planning
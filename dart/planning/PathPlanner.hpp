@@ -66,6 +66,7 @@ public:
   double stepSize;        ///< Step size from a node in the tree to the random/goal node
   double goalBias;        ///< Choose btw goal and random value (for goal-biased search)
   std::size_t maxNodes;        ///< Maximum number of iterations the sampling would continue
+  bool parallel;           ///< Whether the two trees grow concurrently (bidirectional only)
   simulation::WorldPtr world;  ///< The world that the robot is in (for obstacles and etc.)
 
   // NOTE: It is useful to keep the rrts around after planning for reuse, analysis, and etc.
@@ -75,12 +76,13 @@ public:
 public:
 
   /// The default constructor
-  PathPlanner() : world(nullptr) {}
+  PathPlanner() : parallel(false), world(nullptr) {}
 
   /// The desired constructor - you should use this one.
   PathPlanner(simulation::World& world, bool bidirectional_ = true, bool connect_ = true, double stepSize_ = 0.1,
-    std::size_t maxNodes_ = 1e6, double goalBias_ = 0.3) : world(&world), bidirectional(bidirectional_),
-    connect(connect_), stepSize(stepSize_), maxNodes(maxNodes_), goalBias(goalBias_) {
+    std::size_t maxNodes_ = 1e6, double goalBias_ = 0.3, bool parallel_ = false) :
+    connect(connect_), bidirectional(bidirectional_), stepSize(stepSize_), goalBias(goalBias_),
+    maxNodes(maxNodes_), parallel(parallel_), world(&world) {
   }
 
   /// The destructor
@@ -229,10 +231,21 @@ bool PathPlanner<R>::planBidirectionalRrt(dynamics::Skeleton* robot, const std::
   // NOTE: We use the pointers for the RRTs to swap their roles in extending towards a target
   // (random or goal) node.
   start_rrt = new R(world, robot, dofs, start, stepSize);
-  goal_rrt = new R(world, robot, dofs, goal, stepSize);
+  // A separate stream keeps the goal tree from sampling the same configurations
+  goal_rrt = new R(world, robot, dofs, goal, stepSize, 1u);
   R* rrt1 = start_rrt;
   R* rrt2 = goal_rrt;
 
+  // Grow the trees in their own threads, each checking collisions in a clone of the world
+  if(parallel) {
+    int startNode, goalNode;
+    if(!R::connectParallel(*start_rrt, *goal_rrt, maxNodes, startNode, goalNode))
+      return false;
+    start_rrt->tracePath(startNode, path);
+    goal_rrt->tracePath(goalNode, path, true);
+    return true;
+  }
+
   // Expand the tree until the trees meet or the max # nodes is passed
   double smallestGap = std::numeric_limits<double>::infinity();
   std::size_t numNodes = rrt1->getSize() + rrt2->getSize();
@@ -259,7 +272,7 @@ bool PathPlanner<R>::planBidirectionalRrt(dynamics::Skeleton* robot, const std::
     // NOTE: connect(x) and tryStep(x) functions return true if rrt2 can add the given node
     // in the tree. In this case, this would imply that the two trees meet.
     bool treesMet = false;
-    const Eigen::VectorXd& rrt2target = *(rrt1->configVector[rrt1->activeNode]);
+    const Eigen::VectorXd rrt2target = rrt1->getConfig(rrt1->activeNode);
     if(connect) treesMet = rrt2->connect(rrt2target);
     else treesMet = (rrt2->tryStep(rrt2target) == R::STEP_REACHED);
 
@@ -275,11 +288,11 @@ bool PathPlanner<R>::planBidirectionalRrt(dynamics::Skeleton* robot, const std::
 
     // Print the gap between the trees in debug mode
     if(debug) {
-      double gap = rrt2->getGap(*(rrt1->configVector[rrt1->activeNode]));
+      double gap = rrt2->getGap(rrt1->getConfig(rrt1->activeNode));
       if(gap < smallestGap) {
         smallestGap = gap;
-        std::cout << "Gap: " << smallestGap << "  Sizes: " << start_rrt->configVector.size()
-          << "/" << goal_rrt->configVector.size() << std::endl;
+        std::cout << "Gap: " << smallestGap << "  Sizes: " << start_rrt->getSize()
+          << "/" << goal_rrt->getSize() << std::endl;
       }
     }
   }
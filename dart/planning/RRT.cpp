@@ -46,7 +46,9 @@
 
 #include "dart/planning/RRT.hpp"
 
-#include <flann/flann.hpp>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "dart/simulation/World.hpp"
 #include "dart/dynamics/Skeleton.hpp"
@@ -60,32 +62,57 @@ using namespace dynamics;
 namespace dart {
 namespace planning {
 
+namespace {
+
+/// The clones of the world and the robot in which the calling thread of growParallel() or
+/// connectParallel() checks collisions. They are null in any other thread.
+thread_local World* threadWorld = nullptr;
+thread_local Skeleton* threadRobot = nullptr;
+
+/// Makes the clones of the world and the robot the ones in which the calling thread checks
+/// collisions until the end of its scope
+class ScopedCollisionClone {
+public:
+	ScopedCollisionClone(World& world, Skeleton& robot) {
+		threadWorld = &world;
+		threadRobot = &robot;
+	}
+
+	~ScopedCollisionClone() {
+		threadWorld = nullptr;
+		threadRobot = nullptr;
+	}
+};
+
+} // namespace
+
 /* ********************************************************************************************* */
 RRT::RRT(WorldPtr world, SkeletonPtr robot, const std::vector<std::size_t> &dofs,
-  const VectorXd &root, double stepSize) :
+  const VectorXd &root, double stepSize, unsigned int streamId) :
   ndim(dofs.size()),
   stepSize(stepSize),
 	world(world),
 	robot(robot),
 	dofs(dofs),
-  index(new flann::Index<flann::L2<double> >(flann::KDTreeSingleIndexParams()))
+  index(dofs.size()),
+	randomStream(math::Random::createStream(streamId))
 {
-	// Reset the random number generator and add the given start configuration to the flann structure
-  srand(time(nullptr));
+	// Add the given start configuration to the tree
 	addNode(root, -1);
 }
 
 /* ********************************************************************************************* */
-RRT::RRT(WorldPtr world, SkeletonPtr robot, const std::vector<std::size_t> &dofs, const vector<VectorXd> &roots, double stepSize) :
+RRT::RRT(WorldPtr world, SkeletonPtr robot, const std::vector<std::size_t> &dofs, const vector<VectorXd> &roots, double stepSize,
+	unsigned int streamId) :
   ndim(dofs.size()),
   stepSize(stepSize),
 	world(world),
 	robot(robot),
 	dofs(dofs),
-	index(new flann::Index<flann::L2<double> >(flann::KDTreeSingleIndexParams()))
+	index(dofs.size()),
+	randomStream(math::Random::createStream(streamId))
 {
-	// Reset the random number generator and add the given start configurations to the flann structure
-  srand(time(nullptr));
+	// Add the given start configurations to the tree
   for(std::size_t i = 0; i < roots.size(); i++) {
 		addNode(roots[i], -1);
 	}
@@ -107,7 +134,7 @@ bool RRT::connect(const VectorXd &target) {
 	StepResult result = STEP_PROGRESS;
 	while(result == STEP_PROGRESS) {
 		result = tryStepFromNode(target, NNidx);
-		NNidx = configVector.size() - 1;
+		NNidx = index.getNumPoints() - 1;
 	}
 	return (result == STEP_REACHED);
 }
@@ -128,7 +155,7 @@ RRT::StepResult RRT::tryStep(const VectorXd &qtry) {
 RRT::StepResult RRT::tryStepFromNode(const VectorXd &qtry, int NNidx) {
 
 	// Get the configuration of the nearest neighbor and check if already reached
-	const VectorXd& qnear = *(configVector[NNidx]);
+	const VectorXd qnear = getConfig(NNidx);
 	if((qtry - qnear).norm() < stepSize) {
 		return STEP_REACHED;
 	}
@@ -158,31 +185,17 @@ bool RRT::newConfig(list<VectorXd> &/*intermediatePoints*/, VectorXd &qnew, cons
 /* ********************************************************************************************* */
 int RRT::addNode(const VectorXd &qnew, int parentId) {
 	
-	// Update the graph vector
-	VectorXd* temp = new VectorXd(qnew);
-	configVector.push_back(temp);
+	// Update the graph vector and the kdtree, which stores the configuration
 	parentVector.push_back(parentId);
+	int id = index.addPoint(qnew);
 
-	// Update the underlying flann structure (the kdtree)
-	unsigned int id = configVector.size() - 1;
-	if(id == 0) 
-		index->buildIndex(flann::Matrix<double>((double*)temp->data(), 1, temp->size()));
-	else 
-		index->addPoints(flann::Matrix<double>((double*)temp->data(), 1, temp->size()));
-	
 	activeNode = id;
 	return id;
 }
 
 /* ********************************************************************************************* */
-inline int RRT::getNearestNeighbor(const VectorXd &qsamp) {
-	int nearest;
-	double distance;
-	const flann::Matrix<double> queryMatrix((double*)qsamp.data(), 1, qsamp.size());
-	flann::Matrix<int> nearestMatrix(&nearest, 1, 1);
-	flann::Matrix<double> distanceMatrix(flann::Matrix<double>(&distance, 1, 1));
-	index->knnSearch(queryMatrix, nearestMatrix, distanceMatrix, 1, 
-		flann::SearchParams(flann::FLANN_CHECKS_UNLIMITED));
+int RRT::getNearestNeighbor(const VectorXd &qsamp) {
+	int nearest = index.getNearest(qsamp);
 	activeNode = nearest;
 	return nearest;
 }
@@ -194,7 +207,7 @@ inline double RRT::randomInRange(double min, double max) {
 	assert(max - min < numeric_limits<double>::infinity());
 
 	if(min == max) return min;
-	return min + ((max-min) * ((double)rand() / ((double)RAND_MAX + 1)));
+	return randomStream.uniform(min, max);
 }
 
 /* ********************************************************************************************* */
@@ -210,7 +223,7 @@ VectorXd RRT::getRandomConfig() {
 
 /* ********************************************************************************************* */
 double RRT::getGap(const VectorXd &target) {
-	return (target - *(configVector[activeNode])).norm();
+	return (target - getConfig(activeNode)).norm();
 }
 
 /* ********************************************************************************************* */
@@ -219,21 +232,205 @@ void RRT::tracePath(int node, std::list<VectorXd> &path, bool reverse) {
 	// Keep following the "linked list" in the given direction
 	int x = node;
 	while(x != -1) {
-		if(!reverse) path.push_front(*(configVector[x]));	
-		else path.push_back(*(configVector[x]));
+		if(!reverse) path.push_front(getConfig(x));
+		else path.push_back(getConfig(x));
 		x = parentVector[x];
 	}
 }
 
 /* ********************************************************************************************* */
 bool RRT::checkCollisions(const VectorXd &c) {
-  robot->setPositions(dofs, c);
-	return world->checkCollision();
+	getCollisionRobot().setPositions(dofs, c);
+	return getCollisionWorld().checkCollision();
+}
+
+/* ********************************************************************************************* */
+World& RRT::getCollisionWorld() {
+	return threadWorld ? *threadWorld : *world;
+}
+
+/* ********************************************************************************************* */
+Skeleton& RRT::getCollisionRobot() {
+	return threadRobot ? *threadRobot : *robot;
 }
 
 /* ********************************************************************************************* */
 std::size_t RRT::getSize() {
-	return configVector.size();
+	return index.getNumPoints();
+}
+
+/* ********************************************************************************************* */
+Eigen::Map<const VectorXd> RRT::getConfig(int node) const {
+	return index.getPoint(node);
+}
+
+/* ********************************************************************************************* */
+std::vector<VectorXd> RRT::getConfigVector() const {
+	std::vector<VectorXd> configs;
+	configs.reserve(index.getNumPoints());
+	for(std::size_t i = 0; i < index.getNumPoints(); ++i)
+		configs.push_back(index.getPoint(i));
+	return configs;
+}
+
+/* ********************************************************************************************* */
+RRT::StepResult RRT::tryStepConcurrently(const VectorXd &qtry, int &node) {
+
+	// Copy the nearest configuration out of the tree since the other threads may grow it
+	VectorXd qnear;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		node = getNearestNeighbor(qtry);
+		qnear = getConfig(node);
+	}
+
+	if((qtry - qnear).norm() < stepSize)
+		return STEP_REACHED;
+
+	// Check the new node without holding the lock, which is where the time goes
+	VectorXd qnew = qnear + stepSize * (qtry - qnear).normalized();
+	list<VectorXd> intermediatePoints;
+	if(!newConfig(intermediatePoints, qnew, qnear, qtry))
+		return STEP_COLLISION;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	list<VectorXd>::iterator it = intermediatePoints.begin();
+	for(; it != intermediatePoints.end(); ++it)
+		node = addNode(*it, node);
+	node = addNode(qnew, node);
+	return STEP_PROGRESS;
+}
+
+/* ********************************************************************************************* */
+void RRT::cloneWorld(WorldPtr &worldClone, SkeletonPtr &robotClone) const {
+
+	// Skeleton names are unique in a world, so the clone of the robot can be found by its name.
+	// Since cloning does not copy the states, the positions are copied separately.
+	worldClone = world->clone();
+	for(std::size_t i = 0; i < world->getNumSkeletons(); ++i) {
+		worldClone->getSkeleton(i)->setPositions(world->getSkeleton(i)->getPositions());
+	}
+
+	robotClone = worldClone->getSkeleton(robot->getName());
+	if(robotClone == nullptr || robotClone->getNumDofs() != robot->getNumDofs()) {
+		robotClone = robot->cloneSkeleton();
+		robotClone->setPositions(robot->getPositions());
+	}
+}
+
+/* ********************************************************************************************* */
+std::size_t RRT::growParallel(std::size_t maxNodes, std::size_t numThreads) {
+
+	const std::size_t initialSize = getSize();
+	numThreads = std::max<std::size_t>(numThreads, 1u);
+	index.reserve(maxNodes + numThreads);
+	parentVector.reserve(maxNodes + numThreads);
+
+	// Clone the world for each thread before any of them starts
+	std::vector<WorldPtr> worlds(numThreads);
+	std::vector<SkeletonPtr> robots(numThreads);
+	for(std::size_t i = 0; i < numThreads; ++i)
+		cloneWorld(worlds[i], robots[i]);
+
+	std::vector<std::thread> threads;
+	for(std::size_t i = 0; i < numThreads; ++i) {
+		threads.emplace_back([this, maxNodes, i, &worlds, &robots]() {
+			ScopedCollisionClone clone(*worlds[i], *robots[i]);
+			while(true) {
+				VectorXd qtry;
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if(getSize() >= maxNodes) return;
+					qtry = getRandomConfig();
+				}
+
+				int node;
+				tryStepConcurrently(qtry, node);
+			}
+		});
+	}
+
+	for(std::size_t i = 0; i < threads.size(); ++i)
+		threads[i].join();
+
+	return getSize() - initialSize;
+}
+
+/* ********************************************************************************************* */
+bool RRT::connectParallel(RRT& rrt1, RRT& rrt2, std::size_t maxNodes, int& node1, int& node2) {
+
+	RRT* rrts[2] = {&rrt1, &rrt2};
+	int meetingNodes[2] = {-1, -1};
+	std::atomic<bool> treesMet(false);
+	std::mutex resultMutex;
+
+	WorldPtr worlds[2];
+	SkeletonPtr robots[2];
+	for(std::size_t i = 0; i < 2; ++i)
+		rrts[i]->cloneWorld(worlds[i], robots[i]);
+
+	auto getTotalSize = [&]() {
+		std::size_t size = 0;
+		for(std::size_t i = 0; i < 2; ++i) {
+			std::lock_guard<std::mutex> lock(rrts[i]->mutex);
+			size += rrts[i]->getSize();
+		}
+		return size;
+	};
+
+	// Each thread extends its own tree towards a random configuration and then pulls the other
+	// tree towards the new node until the other tree reaches it or collides.
+	auto grow = [&](std::size_t self) {
+		RRT& tree = *rrts[self];
+		RRT& other = *rrts[1 - self];
+		ScopedCollisionClone clone(*worlds[self], *robots[self]);
+
+		while(!treesMet.load() && getTotalSize() < maxNodes) {
+			VectorXd qtry;
+			{
+				std::lock_guard<std::mutex> lock(tree.mutex);
+				qtry = tree.getRandomConfig();
+			}
+
+			int newNode;
+			if(tree.tryStepConcurrently(qtry, newNode) != STEP_PROGRESS)
+				continue;
+
+			VectorXd target;
+			{
+				std::lock_guard<std::mutex> lock(tree.mutex);
+				target = tree.getConfig(newNode);
+			}
+
+			StepResult result = STEP_PROGRESS;
+			int otherNode = -1;
+			while(result == STEP_PROGRESS && !treesMet.load())
+				result = other.tryStepConcurrently(target, otherNode);
+
+			if(result == STEP_REACHED) {
+				std::lock_guard<std::mutex> lock(resultMutex);
+				if(!treesMet.load()) {
+					meetingNodes[self] = newNode;
+					meetingNodes[1 - self] = otherNode;
+					treesMet.store(true);
+				}
+			}
+		}
+	};
+
+	std::thread thread1(grow, 0u);
+	std::thread thread2(grow, 1u);
+	thread1.join();
+	thread2.join();
+
+	if(!treesMet.load())
+		return false;
+
+	node1 = meetingNodes[0];
+	node2 = meetingNodes[1];
+	rrt1.activeNode = node1;
+	rrt2.activeNode = node2;
+	return true;
 }
 
 } // namespace planning
@@ -49,15 +49,14 @@
 
 #include <vector>
 #include <list>
+#include <mutex>
 #include <Eigen/Core>
 
+#include "dart/common/Deprecated.hpp"
+#include "dart/math/Random.hpp"
 #include "dart/dynamics/SmartPointer.hpp"
 #include "dart/simulation/World.hpp"
-
-namespace flann {
-	template <class A> class L2;
-	template <class A> class Index;
-}
+#include "dart/planning/KdTree.hpp"
 
 namespace dart {
 
@@ -87,22 +86,21 @@ public:
 	const double stepSize;	///< Step size at each node creation
 
 	int activeNode;	 								///< Last added node or the nearest node found after a search
-	std::vector<int> parentVector;		///< The ith node in configVector has parent with index pV[i]
-
-	/// All visited configs
-	// NOTE We are using pointers for the VectorXd's because flann copies the pointers for the
-	// data points and we give it the copies made in the heap
-	std::vector<const Eigen::VectorXd*> configVector; 	
+	std::vector<int> parentVector;		///< The ith node has parent with index pV[i]
 
 public:
 
 	//// Constructor with a single root 
+	///
+	/// The tree samples from math::Random::createStream(streamId), so trees created after the same
+	/// math::Random::setSeed() call with the same stream id sample the same configurations.
     RRT(dart::simulation::WorldPtr world, dart::dynamics::SkeletonPtr robot, const std::vector<std::size_t> &dofs, const Eigen::VectorXd &root,
-      double stepSize = 0.02);
+      double stepSize = 0.02, unsigned int streamId = 0u);
 
-	/// Constructor with multiple roots (so, multiple trees)
+	/// Constructor with multiple roots (so, multiple trees). See the other constructor for
+	/// streamId.
     RRT(simulation::WorldPtr world, dynamics::SkeletonPtr robot, const std::vector<std::size_t> &dofs,
-			const std::vector<Eigen::VectorXd> &roots, double stepSize = 0.02);
+			const std::vector<Eigen::VectorXd> &roots, double stepSize = 0.02, unsigned int streamId = 0u);
 
 	/// Destructor
 	virtual ~RRT() {}
@@ -142,7 +140,35 @@ public:
 	/// Returns the number of nodes in the tree.
     std::size_t getSize();
 
-	/// Implementation-specific function for checking collisions 
+	/// Returns the configuration of the given node. The returned map is invalidated when a node
+	/// is added to the tree.
+	Eigen::Map<const Eigen::VectorXd> getConfig(int node) const;
+
+	/// Returns copies of the configurations of all the nodes
+	///
+	/// \deprecated Deprecated in DART 6.8. The configurations are no longer stored as separate
+	/// vectors. Please use getConfig() instead.
+	DART_DEPRECATED(6.8)
+	std::vector<Eigen::VectorXd> getConfigVector() const;
+
+	/// Grows the tree towards random configurations with the given number of threads until it has
+	/// at least maxNodes nodes. The new nodes go through newConfig() and checkCollisions() as in
+	/// the serial methods, but concurrently. Each thread owns a clone of the world, which
+	/// getCollisionWorld() and getCollisionRobot() return, so only sampling, nearest neighbor
+	/// queries and insertions are serialized. Returns the number of nodes added.
+	std::size_t growParallel(std::size_t maxNodes, std::size_t numThreads);
+
+	/// Grows the two trees concurrently in RRT-Connect fashion, one thread per tree, until they
+	/// meet or have at least maxNodes nodes in total. Each tree steps towards random
+	/// configurations and the other tree connects to every node added this way. If the trees
+	/// meet, returns true and the indices of the meeting nodes in node1 and node2. Collisions are
+	/// checked concurrently as in growParallel().
+	static bool connectParallel(RRT& rrt1, RRT& rrt2, std::size_t maxNodes, int& node1,
+			int& node2);
+
+	/// Implementation-specific function for checking collisions. growParallel() and
+	/// connectParallel() call it from several threads at once, so overrides should check the
+	/// configuration in getCollisionWorld() and getCollisionRobot() rather than in world and robot.
 	virtual bool checkCollisions(const Eigen::VectorXd &c);
 
 	/// Returns a random configuration with the specified node IDs 
@@ -154,8 +180,14 @@ protected:
   dynamics::SkeletonPtr robot;        ///< The ID of the robot for which a plan is generated
     std::vector<std::size_t> dofs;                    ///< The dofs of the robot the planner can manipulate
 
-	/// The underlying flann data structure for fast nearest neighbor searches 
-	flann::Index<flann::L2<double> >* index;
+	/// The nearest neighbor structure, which also stores the configurations of the nodes
+	KdTree index;
+
+	/// Guards the tree while it is grown by multiple threads
+	std::mutex mutex;
+
+	/// Random stream owned by this tree. Samples are drawn while holding mutex.
+	math::RandomStream randomStream;
 
 	/// Returns a random value between the given minimum and maximum value
 	double randomInRange(double min, double max);
@@ -165,6 +197,21 @@ protected:
 
 	/// Adds a new node to the tree
 	virtual int addNode(const Eigen::VectorXd &qnew, int parentId);
+
+	/// Returns the world in which the calling thread checks collisions: the clone owned by the
+	/// thread inside growParallel() and connectParallel(), and world otherwise
+	simulation::World& getCollisionWorld();
+
+	/// Returns the robot in getCollisionWorld()
+	dynamics::Skeleton& getCollisionRobot();
+
+	/// Takes a single step from the nearest node towards qtry while other threads may grow the
+	/// tree. The new node is checked through newConfig() without holding the lock. The index of
+	/// the last added node, or of the nearest node if no node is added, is returned in node.
+	StepResult tryStepConcurrently(const Eigen::VectorXd &qtry, int &node);
+
+	/// Creates a clone of the world and the robot for a thread that checks collisions
+	void cloneWorld(simulation::WorldPtr &worldClone, dynamics::SkeletonPtr &robotClone) const;
 };
 
 } // namespace planning
@@ -38,6 +38,7 @@
 
 #include "dart/simulation/Recording.hpp"
 
+#include <cassert>
 #include <iostream>
 
 #include "dart/dynamics/Skeleton.hpp"
@@ -147,6 +148,26 @@ void Recording::updateNumGenCoords(
     mNumGenCoordsForSkeletons.push_back(_skeletons[i]->getNumDofs());
 }
 
+//==============================================================================
+void Recording::addNumGenCoords(int _numGenCoords)
+{
+  mNumGenCoordsForSkeletons.push_back(_numGenCoords);
+}
+
+//==============================================================================
+void Recording::removeNumGenCoords(const std::vector<bool>& _removed)
+{
+  assert(_removed.size() == mNumGenCoordsForSkeletons.size());
+
+  std::size_t last = 0;
+  for (std::size_t i = 0; i < mNumGenCoordsForSkeletons.size(); ++i)
+  {
+    if (!_removed[i])
+      mNumGenCoordsForSkeletons[last++] = mNumGenCoordsForSkeletons[i];
+  }
+  mNumGenCoordsForSkeletons.resize(last);
+}
+
 }  // namespace simulation
 }  // namespace dart
 
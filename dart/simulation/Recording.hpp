@@ -104,6 +104,13 @@ public:
   /// \brief Update list for number of generalized coordinates
   void updateNumGenCoords(const std::vector<dynamics::SkeletonPtr>& _skeletons);
 
+  /// \brief Append the number of generalized coordinates of a new skeleton
+  void addNumGenCoords(int _numGenCoords);
+
+  /// \brief Remove the numbers of generalized coordinates of the skeletons
+  /// whose flags are set. _removed must have one flag per skeleton.
+  void removeNumGenCoords(const std::vector<bool>& _removed);
+
 private:
   /// \brief Baked states
   std::vector<Eigen::VectorXd> mBakedStates;
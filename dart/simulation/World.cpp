@@ -38,20 +38,122 @@
 
 #include "dart/simulation/World.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "dart/common/Console.hpp"
+#include "dart/math/Helpers.hpp"
 #include "dart/integration/SemiImplicitEulerIntegrator.hpp"
 #include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/SoftBodyNode.hpp"
+#include "dart/dynamics/PointMass.hpp"
 #include "dart/constraint/ConstrainedGroup.hpp"
 #include "dart/constraint/BoxedLcpConstraintSolver.hpp"
 #include "dart/collision/CollisionGroup.hpp"
+#include "dart/collision/CollisionObject.hpp"
+#include "dart/collision/CollisionResult.hpp"
 
 namespace dart {
 namespace simulation {
 
+namespace {
+
+//==============================================================================
+/// Relative tolerance below which a recorded quantity of a sleeping Skeleton
+/// is considered unchanged
+constexpr double kSleepChangeTolerance = 1e-10;
+
+//==============================================================================
+/// Return true if current differs from the value recorded when a Skeleton was
+/// put to sleep. A change of size (e.g., the number of DOFs has changed) is
+/// always a change.
+bool hasChanged(const Eigen::VectorXd& current, const Eigen::VectorXd& recorded)
+{
+  if (current.size() != recorded.size())
+    return true;
+
+  if (current.size() == 0)
+    return false;
+
+  const double scale = std::max(1.0, recorded.cwiseAbs().maxCoeff());
+  return (current - recorded).cwiseAbs().maxCoeff()
+         > kSleepChangeTolerance * scale;
+}
+
+//==============================================================================
+/// Get the number of PointMasses of all the SoftBodyNodes of skel
+std::size_t getNumPointMasses(const dynamics::Skeleton& skel)
+{
+  std::size_t numPointMasses = 0u;
+  for (std::size_t i = 0u; i < skel.getNumSoftBodyNodes(); ++i)
+    numPointMasses += skel.getSoftBodyNode(i)->getNumPointMasses();
+
+  return numPointMasses;
+}
+
+//==============================================================================
+/// Stack the positions and the velocities of all the PointMasses of skel,
+/// which are not part of the generalized coordinates of skel
+void getPointMassStates(
+    const dynamics::Skeleton& skel,
+    Eigen::VectorXd& positions,
+    Eigen::VectorXd& velocities)
+{
+  const auto size = static_cast<Eigen::Index>(3u * getNumPointMasses(skel));
+  positions.resize(size);
+  velocities.resize(size);
+
+  Eigen::Index index = 0;
+  for (std::size_t i = 0u; i < skel.getNumSoftBodyNodes(); ++i)
+  {
+    const dynamics::SoftBodyNode* softBodyNode = skel.getSoftBodyNode(i);
+    for (std::size_t j = 0u; j < softBodyNode->getNumPointMasses(); ++j)
+    {
+      const dynamics::PointMass* pointMass = softBodyNode->getPointMass(j);
+      positions.segment<3>(index) = pointMass->getPositions();
+      velocities.segment<3>(index) = pointMass->getVelocities();
+      index += 3;
+    }
+  }
+}
+
+//==============================================================================
+/// Set the states recorded by getPointMassStates() back to skel
+void setPointMassStates(
+    dynamics::Skeleton& skel,
+    const Eigen::VectorXd& positions,
+    const Eigen::VectorXd& velocities)
+{
+  Eigen::Index index = 0;
+  for (std::size_t i = 0u; i < skel.getNumSoftBodyNodes(); ++i)
+  {
+    dynamics::SoftBodyNode* softBodyNode = skel.getSoftBodyNode(i);
+    for (std::size_t j = 0u; j < softBodyNode->getNumPointMasses(); ++j)
+    {
+      dynamics::PointMass* pointMass = softBodyNode->getPointMass(j);
+      pointMass->setPositions(positions.segment<3>(index));
+      pointMass->setVelocities(velocities.segment<3>(index));
+      index += 3;
+    }
+  }
+}
+
+//==============================================================================
+/// Return the largest coefficient of |a - b|, or 0 if they are empty
+double getMaxDifference(const Eigen::VectorXd& a, const Eigen::VectorXd& b)
+{
+  if (a.size() == 0)
+    return 0.0;
+
+  return (a - b).cwiseAbs().maxCoeff();
+}
+
+} // namespace
+
 //==============================================================================
 std::shared_ptr<World> World::create(const std::string& name)
 {
@@ -67,6 +169,16 @@ World::World(const std::string& _name)
     mTimeStep(0.001),
     mTime(0.0),
     mFrame(0),
+    mSleepingEnabled(false),
+    mSleepVelocityThreshold(0.01),
+    mSleepTimeThreshold(0.5),
+    mAdaptiveTimeSteppingEnabled(false),
+    mAdaptiveTimeStepTolerance(1e-4),
+    mMinAdaptiveTimeStep(1e-5),
+    mMaxAdaptiveTimeStep(0.01),
+    mNextAdaptiveTimeStep(0.001),
+    mLastTimeStep(0.001),
+    mNumRejectedTimeSteps(0u),
     mRecording(new Recording(mSkeletons)),
     onNameChanged(mNameChangedSignal)
 {
@@ -95,16 +207,26 @@ WorldPtr World::clone() const
 
   worldClone->setGravity(mGravity);
   worldClone->setTimeStep(mTimeStep);
+  worldClone->setSleepingEnabled(mSleepingEnabled);
+  worldClone->setSleepVelocityThreshold(mSleepVelocityThreshold);
+  worldClone->setSleepTimeThreshold(mSleepTimeThreshold);
+  worldClone->setAdaptiveTimeSteppingEnabled(mAdaptiveTimeSteppingEnabled);
+  worldClone->setAdaptiveTimeStepTolerance(mAdaptiveTimeStepTolerance);
+  worldClone->setAdaptiveTimeStepLimits(
+      mMinAdaptiveTimeStep, mMaxAdaptiveTimeStep);
 
   auto cd = getConstraintSolver()->getCollisionDetector();
   worldClone->getConstraintSolver()->setCollisionDetector(
       cd->cloneWithoutCollisionObjects());
 
   // Clone and add each Skeleton
+  std::vector<dynamics::SkeletonPtr> skeletonClones;
+  skeletonClones.reserve(mSkeletons.size());
   for(std::size_t i=0; i<mSkeletons.size(); ++i)
   {
-    worldClone->addSkeleton(mSkeletons[i]->cloneSkeleton());
+    skeletonClones.push_back(mSkeletons[i]->cloneSkeleton());
   }
+  worldClone->addSkeletons(skeletonClones);
 
   // Clone and add each SimpleFrame
   for(std::size_t i=0; i<mSimpleFrames.size(); ++i)
@@ -141,6 +263,7 @@ void World::setTimeStep(double _timeStep)
   }
 
   mTimeStep = _timeStep;
+  mNextAdaptiveTimeStep = _timeStep;
   assert(mConstraintSolver);
   mConstraintSolver->setTimeStep(_timeStep);
   for (auto& skel : mSkeletons)
@@ -158,6 +281,8 @@ void World::reset()
 {
   mTime = 0.0;
   mFrame = 0;
+  mNextAdaptiveTimeStep = mTimeStep;
+  mNumRejectedTimeSteps = 0u;
   mRecording->clear();
   mConstraintSolver->clearLastCollisionResult();
 }
@@ -165,42 +290,38 @@ void World::reset()
 //==============================================================================
 void World::step(bool _resetCommand)
 {
-  // Integrate velocity for unconstrained skeletons
-  for (auto& skel : mSkeletons)
-  {
-    if (!skel->isMobile())
-      continue;
+  if (mSleepingEnabled)
+    wakeUpDisturbedSkeletons();
 
-    skel->computeForwardDynamics();
-    skel->integrateVelocities(mTimeStep);
+  if (mAdaptiveTimeSteppingEnabled)
+  {
+    integrateAdaptively();
   }
-
-  // Detect activated constraints and compute constraint impulses
-  mConstraintSolver->solve();
-
-  // Compute velocity changes given constraint impulses
-  for (auto& skel : mSkeletons)
+  else
   {
-    if (!skel->isMobile())
-      continue;
+    integrate(mTimeStep);
+    mLastTimeStep = mTimeStep;
+  }
 
-    if (skel->isImpulseApplied())
+  if (_resetCommand)
+  {
+    // The commands of sleeping skeletons are reset as well so that a command
+    // that stops being set is seen as a disturbance in the next step.
+    for (auto& skel : mSkeletons)
     {
-      skel->computeImpulseForwardDynamics();
-      skel->setImpulseApplied(false);
-    }
-
-    skel->integratePositions(mTimeStep);
+      if (!skel->isMobile())
+        continue;
 
-    if (_resetCommand)
-    {
       skel->clearInternalForces();
       skel->clearExternalForces();
       skel->resetCommands();
     }
   }
 
-  mTime += mTimeStep;
+  if (mSleepingEnabled)
+    updateSleepingSkeletons();
+
+  mTime += mLastTimeStep;
   mFrame++;
 }
 
@@ -222,6 +343,141 @@ int World::getSimFrames() const
   return mFrame;
 }
 
+//==============================================================================
+void World::setSleepingEnabled(bool enabled)
+{
+  if (enabled == mSleepingEnabled)
+    return;
+
+  mSleepingEnabled = enabled;
+
+  if (!mSleepingEnabled)
+  {
+    for (auto& skel : mSkeletons)
+      skel->wakeUp();
+
+    mSleepInfos.clear();
+  }
+}
+
+//==============================================================================
+bool World::isSleepingEnabled() const
+{
+  return mSleepingEnabled;
+}
+
+//==============================================================================
+void World::setSleepVelocityThreshold(double threshold)
+{
+  if (threshold < 0.0)
+  {
+    dtwarn << "[World] Attempting to set negative sleep velocity threshold. "
+           << "Ignoring this request.\n";
+    return;
+  }
+
+  mSleepVelocityThreshold = threshold;
+}
+
+//==============================================================================
+double World::getSleepVelocityThreshold() const
+{
+  return mSleepVelocityThreshold;
+}
+
+//==============================================================================
+void World::setSleepTimeThreshold(double time)
+{
+  if (time < 0.0)
+  {
+    dtwarn << "[World] Attempting to set negative sleep time threshold. "
+           << "Ignoring this request.\n";
+    return;
+  }
+
+  mSleepTimeThreshold = time;
+}
+
+//==============================================================================
+double World::getSleepTimeThreshold() const
+{
+  return mSleepTimeThreshold;
+}
+
+//==============================================================================
+void World::setAdaptiveTimeSteppingEnabled(bool enabled)
+{
+  if (enabled == mAdaptiveTimeSteppingEnabled)
+    return;
+
+  mAdaptiveTimeSteppingEnabled = enabled;
+  mNextAdaptiveTimeStep = mTimeStep;
+}
+
+//==============================================================================
+bool World::isAdaptiveTimeSteppingEnabled() const
+{
+  return mAdaptiveTimeSteppingEnabled;
+}
+
+//==============================================================================
+void World::setAdaptiveTimeStepTolerance(double tolerance)
+{
+  if (tolerance <= 0.0)
+  {
+    dtwarn << "[World] Attempting to set nonpositive adaptive time step "
+           << "tolerance. Ignoring this request.\n";
+    return;
+  }
+
+  mAdaptiveTimeStepTolerance = tolerance;
+}
+
+//==============================================================================
+double World::getAdaptiveTimeStepTolerance() const
+{
+  return mAdaptiveTimeStepTolerance;
+}
+
+//==============================================================================
+void World::setAdaptiveTimeStepLimits(double minTimeStep, double maxTimeStep)
+{
+  if (minTimeStep <= 0.0 || maxTimeStep < minTimeStep)
+  {
+    dtwarn << "[World] Attempting to set invalid adaptive time step limits ["
+           << minTimeStep << ", " << maxTimeStep << "]. Ignoring this "
+           << "request.\n";
+    return;
+  }
+
+  mMinAdaptiveTimeStep = minTimeStep;
+  mMaxAdaptiveTimeStep = maxTimeStep;
+}
+
+//==============================================================================
+double World::getMinAdaptiveTimeStep() const
+{
+  return mMinAdaptiveTimeStep;
+}
+
+//==============================================================================
+double World::getMaxAdaptiveTimeStep() const
+{
+  return mMaxAdaptiveTimeStep;
+}
+
+//==============================================================================
+double World::getLastTimeStep() const
+{
+  return mLastTimeStep;
+}
+
+//==============================================================================
+std::size_t World::getNumRejectedTimeSteps() const
+{
+  return mNumRejectedTimeSteps;
+}
+
 //==============================================================================
 const std::string& World::setName(const std::string& _newName)
 {
@@ -296,34 +552,75 @@ std::string World::addSkeleton(const dynamics::SkeletonPtr& _skeleton)
   }
 
   // If mSkeletons already has _skeleton, then we do nothing.
-  if (find(mSkeletons.begin(), mSkeletons.end(), _skeleton) != mSkeletons.end())
+  if (hasSkeleton(_skeleton))
   {
     dtwarn << "[World::addSkeleton] Skeleton named [" << _skeleton->getName()
               << "] is already in the world." << std::endl;
     return _skeleton->getName();
   }
 
-  mSkeletons.push_back(_skeleton);
-  mMapForSkeletons[_skeleton] = _skeleton;
+  addSkeletonInternal(_skeleton);
+  mConstraintSolver->addSkeleton(_skeleton);
+
+  return _skeleton->getName();
+}
+
+//==============================================================================
+void World::addSkeletons(const std::vector<dynamics::SkeletonPtr>& skeletons)
+{
+  mSkeletons.reserve(mSkeletons.size() + skeletons.size());
+  mNameConnectionsForSkeletons.reserve(
+      mNameConnectionsForSkeletons.size() + skeletons.size());
+  mIndices.reserve(mIndices.size() + skeletons.size());
+
+  std::vector<dynamics::SkeletonPtr> added;
+  added.reserve(skeletons.size());
+
+  for (const auto& skeleton : skeletons)
+  {
+    if (nullptr == skeleton)
+    {
+      dtwarn << "[World::addSkeletons] Attempting to add a nullptr Skeleton "
+             << "to the world!\n";
+      continue;
+    }
+
+    if (hasSkeleton(skeleton))
+    {
+      dtwarn << "[World::addSkeletons] Skeleton named [" << skeleton->getName()
+             << "] is already in the world." << std::endl;
+      continue;
+    }
+
+    addSkeletonInternal(skeleton);
+    added.push_back(skeleton);
+  }
+
+  mConstraintSolver->addSkeletons(added);
+}
+
+//==============================================================================
+void World::addSkeletonInternal(const dynamics::SkeletonPtr& skeleton)
+{
+  mSkeletons.push_back(skeleton);
+  mMapForSkeletons[skeleton] = skeleton;
 
-  mNameConnectionsForSkeletons.push_back(_skeleton->onNameChanged.connect(
+  mNameConnectionsForSkeletons.push_back(skeleton->onNameChanged.connect(
         [=](dynamics::ConstMetaSkeletonPtr skel,
             const std::string&, const std::string&)
         { this->handleSkeletonNameChange(skel); } ));
 
-  _skeleton->setName(mNameMgrForSkeletons.issueNewNameAndAdd(
-                       _skeleton->getName(), _skeleton));
+  skeleton->setName(mNameMgrForSkeletons.issueNewNameAndAdd(
+                      skeleton->getName(), skeleton));
 
-  _skeleton->setTimeStep(mTimeStep);
-  _skeleton->setGravity(mGravity);
+  skeleton->setTimeStep(mTimeStep);
+  skeleton->setGravity(mGravity);
 
-  mIndices.push_back(mIndices.back() + _skeleton->getNumDofs());
-  mConstraintSolver->addSkeleton(_skeleton);
+  const int numDofs = static_cast<int>(skeleton->getNumDofs());
+  mIndices.push_back(mIndices.back() + numDofs);
 
   // Update recording
-  mRecording->updateNumGenCoords(mSkeletons);
-
-  return _skeleton->getName();
+  mRecording->addNumGenCoords(numDofs);
 }
 
 //==============================================================================
@@ -338,47 +635,110 @@ void World::removeSkeleton(const dynamics::SkeletonPtr& _skeleton)
     return;
   }
 
-  // Find index of _skeleton in mSkeleton.
-  std::size_t index = 0;
-  for (; index < mSkeletons.size(); ++index)
-  {
-    if (mSkeletons[index] == _skeleton)
-      break;
-  }
-
-  // If i is equal to the number of skeletons, then _skeleton is not in
-  // mSkeleton. We do nothing.
-  if (index == mSkeletons.size())
+  // If _skeleton is not in mSkeletons, we do nothing.
+  if (!hasSkeleton(_skeleton))
   {
     dtwarn << "[World::removeSkeleton] Skeleton [" << _skeleton->getName()
            << "] is not in the world.\n";
     return;
   }
 
-  // Update mIndices.
-  for (std::size_t i = index+1; i < mSkeletons.size() - 1; ++i)
-    mIndices[i] = mIndices[i+1] - _skeleton->getNumDofs();
-  mIndices.pop_back();
+  removeSkeletonsInternal({_skeleton});
+}
+
+//==============================================================================
+void World::removeSkeletons(
+    const std::vector<dynamics::SkeletonPtr>& skeletons)
+{
+  std::vector<dynamics::SkeletonPtr> removed;
+  removed.reserve(skeletons.size());
+  std::unordered_set<const dynamics::Skeleton*> unique;
+
+  for (const auto& skeleton : skeletons)
+  {
+    if (nullptr == skeleton)
+    {
+      dtwarn << "[World::removeSkeletons] Attempting to remove a nullptr "
+             << "Skeleton from the world!\n";
+      continue;
+    }
+
+    if (!hasSkeleton(skeleton))
+    {
+      dtwarn << "[World::removeSkeletons] Skeleton [" << skeleton->getName()
+             << "] is not in the world.\n";
+      continue;
+    }
+
+    if (unique.insert(skeleton.get()).second)
+      removed.push_back(skeleton);
+  }
+
+  if (!removed.empty())
+    removeSkeletonsInternal(removed);
+}
 
-  // Remove _skeleton from constraint handler.
-  mConstraintSolver->removeSkeleton(_skeleton);
+//==============================================================================
+void World::removeSkeletonsInternal(
+    const std::vector<dynamics::SkeletonPtr>& skeletons)
+{
+  // Remove the skeletons from constraint handler.
+  if (skeletons.size() == 1u)
+    mConstraintSolver->removeSkeleton(skeletons.front());
+  else
+    mConstraintSolver->removeSkeletons(skeletons);
 
-  // Remove _skeleton from mSkeletons
-  mSkeletons.erase(remove(mSkeletons.begin(), mSkeletons.end(), _skeleton),
-                   mSkeletons.end());
+  for (const auto& skeleton : skeletons)
+  {
+    // Remove from NameManager
+    mNameMgrForSkeletons.removeName(skeleton->getName());
 
-  // Disconnect the name change monitor
-  mNameConnectionsForSkeletons[index].disconnect();
-  mNameConnectionsForSkeletons.erase(mNameConnectionsForSkeletons.begin()+index);
+    // Remove from the pointer map
+    mMapForSkeletons.erase(skeleton);
 
-  // Update recording
-  mRecording->updateNumGenCoords(mSkeletons);
+    // A skeleton that was put to sleep by this world would never be woken up
+    // once it leaves this world
+    const auto sleepInfo = mSleepInfos.find(skeleton.get());
+    if (sleepInfo != mSleepInfos.end())
+    {
+      if (sleepInfo->second.mIsSleeping)
+        skeleton->wakeUp();
 
-  // Remove from NameManager
-  mNameMgrForSkeletons.removeName(_skeleton->getName());
+      mSleepInfos.erase(sleepInfo);
+    }
+  }
 
-  // Remove from the pointer map
-  mMapForSkeletons.erase(_skeleton);
+  // Compact mSkeletons and the name change monitors in a single pass, and
+  // rebuild mIndices along the way.
+  std::vector<bool> removedFlags(mSkeletons.size(), false);
+  std::size_t last = 0;
+  for (std::size_t i = 0; i < mSkeletons.size(); ++i)
+  {
+    if (mMapForSkeletons.find(mSkeletons[i]) == mMapForSkeletons.end())
+    {
+      removedFlags[i] = true;
+      mNameConnectionsForSkeletons[i].disconnect();
+      continue;
+    }
+
+    if (last != i)
+    {
+      mSkeletons[last] = std::move(mSkeletons[i]);
+      mNameConnectionsForSkeletons[last]
+          = std::move(mNameConnectionsForSkeletons[i]);
+    }
+
+    mIndices[last + 1]
+        = mIndices[last] + static_cast<int>(mSkeletons[last]->getNumDofs());
+    ++last;
+  }
+
+  mSkeletons.resize(last);
+  mNameConnectionsForSkeletons.resize(last);
+  mIndices.resize(last + 1);
+
+  // Update recording
+  mRecording->removeNumGenCoords(removedFlags);
 }
 
 //==============================================================================
@@ -389,8 +749,8 @@ std::set<dynamics::SkeletonPtr> World::removeAllSkeletons()
       end=mSkeletons.end(); it != end; ++it)
     ptrs.insert(*it);
 
-  while (getNumSkeletons() > 0)
-    removeSkeleton(getSkeleton(0));
+  if (!mSkeletons.empty())
+    removeSkeletonsInternal(std::vector<dynamics::SkeletonPtr>(mSkeletons));
 
   return ptrs;
 }
@@ -398,8 +758,7 @@ std::set<dynamics::SkeletonPtr> World::removeAllSkeletons()
 //==============================================================================
 bool World::hasSkeleton(const dynamics::ConstSkeletonPtr& skeleton) const
 {
-  return std::find(mSkeletons.begin(), mSkeletons.end(), skeleton)
-      != mSkeletons.end();
+  return mMapForSkeletons.find(skeleton) != mMapForSkeletons.end();
 }
 
 //==============================================================================
@@ -608,8 +967,7 @@ void World::handleSkeletonNameChange(
   const std::string& newName = _skeleton->getName();
 
   // Find the shared version of the Skeleton
-  std::map<dynamics::ConstMetaSkeletonPtr, dynamics::SkeletonPtr>::iterator it =
-      mMapForSkeletons.find(_skeleton);
+  const auto it = mMapForSkeletons.find(_skeleton);
   if( it == mMapForSkeletons.end() )
   {
     dterr << "[World::handleSkeletonNameChange] Could not find Skeleton named ["
@@ -641,6 +999,164 @@ void World::handleSkeletonNameChange(
   }
 }
 
+//==============================================================================
+void World::wakeUpDisturbedSkeletons()
+{
+  for (const auto& skel : mSkeletons)
+  {
+    if (skel->isSleeping())
+    {
+      const auto search = mSleepInfos.find(skel.get());
+      if (search == mSleepInfos.end() || !search->second.mIsSleeping)
+      {
+        // This skeleton wasn't put to sleep by this world, so we cannot tell
+        // whether it has been disturbed.
+        skel->wakeUp();
+      }
+      else
+      {
+        SleepInfo& info = search->second;
+
+        if (!skel->getVelocities().isZero(0.0)
+            || hasChanged(skel->getPositions(), info.mPositions)
+            || hasChanged(skel->getCommands(), info.mCommands)
+            || hasChanged(skel->getForces(), info.mForces)
+            || hasChanged(skel->getExternalForces(), info.mExternalForces))
+        {
+          skel->wakeUp();
+          info.mIsSleeping = false;
+          info.mRestTime = 0.0;
+        }
+      }
+    }
+
+    if (skel->isSleeping() || !skel->isMobile() || skel->getNumDofs() == 0u
+        || skel->getNumSoftBodyNodes() > 0u)
+    {
+      continue;
+    }
+
+    // Record the inputs as they are set by the user for this step, before
+    // forward dynamics turns the commands into forces and before they are
+    // reset. A skeleton that is put to sleep at the end of this step stays
+    // asleep as long as the same inputs are set in the following steps.
+    SleepInfo& info = mSleepInfos[skel.get()];
+    info.mCommands = skel->getCommands();
+    info.mForces = skel->getForces();
+    info.mExternalForces = skel->getExternalForces();
+  }
+}
+
+//==============================================================================
+void World::updateSleepingSkeletons()
+{
+  const std::size_t numSkeletons = mSkeletons.size();
+
+  // Skeletons that can be put to sleep. Soft bodies are excluded because their
+  // point masses are not accounted for by the generalized velocities.
+  std::vector<bool> canSleep(numSkeletons, false);
+  std::vector<bool> isAtRest(numSkeletons, false);
+  std::unordered_map<const dynamics::Skeleton*, std::size_t> indices;
+  indices.reserve(numSkeletons);
+
+  for (std::size_t i = 0u; i < numSkeletons; ++i)
+  {
+    const auto& skel = mSkeletons[i];
+    if (!skel->isMobile() || skel->getNumDofs() == 0u)
+      continue;
+
+    indices[skel.get()] = i;
+
+    if (skel->getNumSoftBodyNodes() > 0u)
+      continue;
+
+    canSleep[i] = true;
+
+    SleepInfo& info = mSleepInfos[skel.get()];
+
+    if (skel->isSleeping())
+    {
+      isAtRest[i] = true;
+      continue;
+    }
+
+    if (info.mIsSleeping)
+    {
+      // The skeleton has been woken up since the last step (e.g., by the
+      // constraint solver or by the user).
+      info.mIsSleeping = false;
+      info.mRestTime = 0.0;
+    }
+
+    if (skel->getVelocities().cwiseAbs().maxCoeff() <= mSleepVelocityThreshold)
+      info.mRestTime += mLastTimeStep;
+    else
+      info.mRestTime = 0.0;
+
+    isAtRest[i] = info.mRestTime >= mSleepTimeThreshold;
+  }
+
+  // Unite the mobile skeletons in contact into islands. Immobile skeletons
+  // (e.g., the ground) don't unite the islands they are in contact with.
+  std::vector<std::size_t> islands(numSkeletons);
+  for (std::size_t i = 0u; i < numSkeletons; ++i)
+    islands[i] = i;
+
+  const auto findIsland = [&islands](std::size_t i)
+  {
+    while (islands[i] != i)
+    {
+      islands[i] = islands[islands[i]];
+      i = islands[i];
+    }
+    return i;
+  };
+
+  const auto findIndex = [&indices](const collision::CollisionObject* object)
+  {
+    const dynamics::ShapeNode* shapeNode
+        = object->getShapeFrame()->asShapeNode();
+    if (!shapeNode)
+      return indices.end();
+
+    return indices.find(shapeNode->getSkeleton().get());
+  };
+
+  const auto& result = mConstraintSolver->getLastCollisionResult();
+  for (const auto& contact : result.getContacts())
+  {
+    const auto index1 = findIndex(contact.collisionObject1);
+    const auto index2 = findIndex(contact.collisionObject2);
+    if (index1 == indices.end() || index2 == indices.end())
+      continue;
+
+    islands[findIsland(index1->second)] = findIsland(index2->second);
+  }
+
+  // An island is put to sleep only if all of its skeletons are at rest
+  std::vector<bool> isIslandAtRest(numSkeletons, true);
+  for (const auto& entry : indices)
+  {
+    const std::size_t i = entry.second;
+    if (!canSleep[i] || !isAtRest[i])
+      isIslandAtRest[findIsland(i)] = false;
+  }
+
+  for (const auto& entry : indices)
+  {
+    const std::size_t i = entry.second;
+    const auto& skel = mSkeletons[i];
+    if (skel->isSleeping() || !isIslandAtRest[findIsland(i)])
+      continue;
+
+    skel->putToSleep();
+
+    SleepInfo& info = mSleepInfos[skel.get()];
+    info.mIsSleeping = true;
+    info.mPositions = skel->getPositions();
+  }
+}
+
 //==============================================================================
 void World::handleSimpleFrameNameChange(const dynamics::Entity* _entity)
 {
@@ -691,5 +1207,239 @@ void World::handleSimpleFrameNameChange(const dynamics::Entity* _entity)
 }
 
 
+//==============================================================================
+void World::integrate(double timeStep)
+{
+  // Integrate velocity for unconstrained skeletons
+  for (auto& skel : mSkeletons)
+  {
+    if (!skel->isMobile() || skel->isSleeping())
+      continue;
+
+    skel->computeForwardDynamics();
+    skel->integrateVelocities(timeStep);
+  }
+
+  // Detect activated constraints and compute constraint impulses
+  mConstraintSolver->solve();
+
+  // Compute velocity changes given constraint impulses
+  for (auto& skel : mSkeletons)
+  {
+    if (!skel->isMobile() || skel->isSleeping())
+      continue;
+
+    if (skel->isImpulseApplied())
+    {
+      skel->computeImpulseForwardDynamics();
+      skel->setImpulseApplied(false);
+    }
+
+    skel->integratePositions(timeStep);
+  }
+}
+
+//==============================================================================
+void World::integrateAdaptively()
+{
+  // Semi-implicit Euler is first order, so the local error scales with the
+  // square of the time step.
+  const double safety = 0.9;
+  const double minScale = 0.2;
+  const double maxScale = 2.0;
+
+  saveAdaptiveStates();
+
+  // The constraint solver detects the contacts at the beginning of a step
+  const auto isInContact = [this]() {
+    return mConstraintSolver->getLastCollisionResult().isCollision();
+  };
+
+  // A contact that starts within a step is only seen at the end of the step
+  const auto isInContactAtEnd = [this]() {
+    collision::CollisionOption option = mConstraintSolver->getCollisionOption();
+    option.enableContact = false;
+    option.maxNumContacts = 1u;
+    return mConstraintSolver->getCollisionGroup()->collide(option);
+  };
+
+  // While in contact and at collision onsets, the time step is refined down
+  // to the fixed time step
+  const double contactTimeStep = std::max(mTimeStep, mMinAdaptiveTimeStep);
+
+  double timeStep = math::clip(
+      mNextAdaptiveTimeStep, mMinAdaptiveTimeStep, mMaxAdaptiveTimeStep);
+
+  while (true)
+  {
+    setIntegrationTimeStep(timeStep);
+    integrate(timeStep);
+
+    if (timeStep > contactTimeStep && (isInContact() || isInContactAtEnd()))
+    {
+      restoreAdaptiveStates();
+      ++mNumRejectedTimeSteps;
+      timeStep = std::max(0.5 * timeStep, contactTimeStep);
+      continue;
+    }
+
+    if (isInContact())
+    {
+      mLastTimeStep = timeStep;
+      mNextAdaptiveTimeStep = timeStep;
+      break;
+    }
+
+    // Estimate the local error by taking the same step in two halves
+    for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+    {
+      const auto& skel = mSkeletons[i];
+      if (!skel->isMobile())
+        continue;
+
+      AdaptiveState& state = mAdaptiveStates[i];
+      state.mFullStepPositions = skel->getPositions();
+      state.mFullStepVelocities = skel->getVelocities();
+      getPointMassStates(
+          *skel,
+          state.mFullStepPointPositions,
+          state.mFullStepPointVelocities);
+    }
+
+    restoreAdaptiveStates();
+    const double halfTimeStep = 0.5 * timeStep;
+    setIntegrationTimeStep(halfTimeStep);
+    integrate(halfTimeStep);
+    integrate(halfTimeStep);
+
+    if (isInContact())
+    {
+      // A contact started at the middle of the step. Keep the half steps if
+      // they are fine enough, and refine the step otherwise.
+      if (halfTimeStep > contactTimeStep)
+      {
+        restoreAdaptiveStates();
+        ++mNumRejectedTimeSteps;
+        timeStep = std::max(halfTimeStep, contactTimeStep);
+        continue;
+      }
+
+      mLastTimeStep = timeStep;
+      mNextAdaptiveTimeStep = halfTimeStep;
+      break;
+    }
+
+    double error = 0.0;
+    Eigen::VectorXd pointPositions;
+    Eigen::VectorXd pointVelocities;
+    for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+    {
+      const auto& skel = mSkeletons[i];
+      if (!skel->isMobile())
+        continue;
+
+      const AdaptiveState& state = mAdaptiveStates[i];
+      error = std::max(
+          error,
+          getMaxDifference(skel->getPositions(), state.mFullStepPositions));
+      error = std::max(
+          error,
+          timeStep
+              * getMaxDifference(
+                    skel->getVelocities(), state.mFullStepVelocities));
+
+      // The point masses of soft bodies are integrated along with the
+      // generalized coordinates
+      getPointMassStates(*skel, pointPositions, pointVelocities);
+      error = std::max(
+          error,
+          getMaxDifference(pointPositions, state.mFullStepPointPositions));
+      error = std::max(
+          error,
+          timeStep
+              * getMaxDifference(
+                    pointVelocities, state.mFullStepPointVelocities));
+    }
+
+    const double scale
+        = (error > 0.0)
+              ? safety * std::sqrt(mAdaptiveTimeStepTolerance / error)
+              : maxScale;
+
+    if (error <= mAdaptiveTimeStepTolerance
+        || timeStep <= mMinAdaptiveTimeStep)
+    {
+      mLastTimeStep = timeStep;
+      mNextAdaptiveTimeStep = timeStep * math::clip(scale, minScale, maxScale);
+      break;
+    }
+
+    restoreAdaptiveStates();
+    ++mNumRejectedTimeSteps;
+    timeStep = std::max(
+        mMinAdaptiveTimeStep, timeStep * std::max(scale, minScale));
+  }
+
+  setIntegrationTimeStep(mTimeStep);
+}
+
+//==============================================================================
+void World::setIntegrationTimeStep(double timeStep)
+{
+  mConstraintSolver->setTimeStep(timeStep);
+  for (auto& skel : mSkeletons)
+  {
+    if (skel->getTimeStep() != timeStep)
+      skel->setTimeStep(timeStep);
+  }
+}
+
+//==============================================================================
+void World::saveAdaptiveStates()
+{
+  mAdaptiveStates.resize(mSkeletons.size());
+  for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+  {
+    const auto& skel = mSkeletons[i];
+    if (!skel->isMobile())
+      continue;
+
+    AdaptiveState& state = mAdaptiveStates[i];
+    state.mPositions = skel->getPositions();
+    state.mVelocities = skel->getVelocities();
+    getPointMassStates(*skel, state.mPointPositions, state.mPointVelocities);
+    state.mIsSleeping = skel->isSleeping();
+  }
+
+  mConstraintSolver->saveWarmStarts();
+}
+
+//==============================================================================
+void World::restoreAdaptiveStates()
+{
+  for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+  {
+    const auto& skel = mSkeletons[i];
+    if (!skel->isMobile())
+      continue;
+
+    // Skeletons that stayed asleep weren't integrated
+    const AdaptiveState& state = mAdaptiveStates[i];
+    if (state.mIsSleeping && skel->isSleeping())
+      continue;
+
+    skel->setPositions(state.mPositions);
+    skel->setVelocities(state.mVelocities);
+    setPointMassStates(*skel, state.mPointPositions, state.mPointVelocities);
+
+    // The constraint solver wakes up sleeping skeletons that are constrained
+    // with awake ones
+    if (state.mIsSleeping)
+      skel->putToSleep();
+  }
+
+  mConstraintSolver->restoreWarmStarts();
+}
+
 }  // namespace simulation
 }  // namespace dart
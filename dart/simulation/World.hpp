@@ -42,6 +42,7 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <unordered_map>
 
 #include <Eigen/Dense>
 
@@ -151,9 +152,19 @@ public:
   /// Add a skeleton to this world
   std::string addSkeleton(const dynamics::SkeletonPtr& _skeleton);
 
+  /// Add multiple skeletons to this world. This is equivalent to calling
+  /// addSkeleton() for each of them, but the bookkeeping of the world and the
+  /// constraint solver is updated once for the whole batch.
+  void addSkeletons(const std::vector<dynamics::SkeletonPtr>& skeletons);
+
   /// Remove a skeleton from this world
   void removeSkeleton(const dynamics::SkeletonPtr& _skeleton);
 
+  /// Remove multiple skeletons from this world. The remaining skeletons keep
+  /// their order, and the cost is linear in the number of skeletons in this
+  /// world rather than in the product of both numbers.
+  void removeSkeletons(const std::vector<dynamics::SkeletonPtr>& skeletons);
+
   /// Remove all the skeletons in this world, and return a set of shared
   /// pointers to them, in case you want to recycle them
   std::set<dynamics::SkeletonPtr> removeAllSkeletons();
@@ -231,6 +242,82 @@ public:
   /// getSimpleFrame()
   int getSimFrames() const;
 
+  /// Set whether the Skeletons that stay at rest are put to sleep. Sleeping
+  /// Skeletons are skipped by step() until they get disturbed by external
+  /// forces, commands, state changes, or contacts with awake Skeletons.
+  ///
+  /// A mobile Skeleton is considered at rest while none of its generalized
+  /// velocities exceeds the sleep velocity threshold. It is put to sleep once
+  /// it and all the mobile Skeletons in contact with it (i.e., its contact
+  /// island) have been at rest for the sleep time threshold. Sleeping is
+  /// disabled by default.
+  void setSleepingEnabled(bool enabled);
+
+  /// Return whether the Skeletons that stay at rest are put to sleep.
+  bool isSleepingEnabled() const;
+
+  /// Set the maximum magnitude of the generalized velocities of a Skeleton at
+  /// rest. Default is 0.01.
+  void setSleepVelocityThreshold(double threshold);
+
+  /// Get the maximum magnitude of the generalized velocities of a Skeleton at
+  /// rest.
+  double getSleepVelocityThreshold() const;
+
+  /// Set how long a contact island should be at rest before it is put to
+  /// sleep. Default is 0.5 seconds.
+  void setSleepTimeThreshold(double time);
+
+  /// Get how long a contact island should be at rest before it is put to
+  /// sleep.
+  double getSleepTimeThreshold() const;
+
+  /// Set whether step() adapts the time step to the motion instead of always
+  /// advancing by the fixed time step.
+  ///
+  /// The local error of a step is estimated by step doubling, i.e., comparing
+  /// a full step with two half steps, and the step is retaken with a smaller
+  /// time step if the error exceeds the tolerance. Otherwise, the more
+  /// accurate two half steps are kept and the next time step is chosen from
+  /// the error. While bodies are in contact, the time step is limited to the
+  /// fixed time step (see setTimeStep()). A step that ends in a new contact,
+  /// which is found by a collision check of the configuration at the end of
+  /// the step, is retaken with half the time step until that limit is reached
+  /// so that collision onsets are resolved finely. The positions and
+  /// velocities of the PointMasses of soft bodies are part of the error
+  /// estimate. Rejected steps are rolled back including the PointMasses, the
+  /// warm starts of the constraint solver and the sleep states of the
+  /// Skeletons. Adaptive time stepping is disabled by default.
+  void setAdaptiveTimeSteppingEnabled(bool enabled);
+
+  /// Return whether step() adapts the time step to the motion.
+  bool isAdaptiveTimeSteppingEnabled() const;
+
+  /// Set the tolerance of the local error of an adaptive step, which is
+  /// measured as the largest difference in the generalized positions and the
+  /// generalized velocities times the time step. Default is 1e-4.
+  void setAdaptiveTimeStepTolerance(double tolerance);
+
+  /// Get the tolerance of the local error of an adaptive step.
+  double getAdaptiveTimeStepTolerance() const;
+
+  /// Set the bounds of the adaptive time step. Defaults are 1e-5 and 0.01.
+  void setAdaptiveTimeStepLimits(double minTimeStep, double maxTimeStep);
+
+  /// Get the lower bound of the adaptive time step.
+  double getMinAdaptiveTimeStep() const;
+
+  /// Get the upper bound of the adaptive time step.
+  double getMaxAdaptiveTimeStep() const;
+
+  /// Get the time step that the last step() advanced the world by. This is the
+  /// fixed time step unless adaptive time stepping is enabled.
+  double getLastTimeStep() const;
+
+  /// Get the number of adaptive steps that have been rejected and retaken with
+  /// a smaller time step since the last reset().
+  std::size_t getNumRejectedTimeSteps() const;
+
   //--------------------------------------------------------------------------
   // Constraint
   //--------------------------------------------------------------------------
@@ -255,6 +342,14 @@ public:
 
 protected:
 
+  /// Add a Skeleton that is known to be new to this world, except to the
+  /// constraint solver
+  void addSkeletonInternal(const dynamics::SkeletonPtr& skeleton);
+
+  /// Remove distinct Skeletons that are known to be in this world
+  void removeSkeletonsInternal(
+      const std::vector<dynamics::SkeletonPtr>& skeletons);
+
   /// Register when a Skeleton's name is changed
   void handleSkeletonNameChange(
       const dynamics::ConstMetaSkeletonPtr& _skeleton);
@@ -262,14 +357,41 @@ protected:
   /// Register when a SimpleFrame's name is changed
   void handleSimpleFrameNameChange(const dynamics::Entity* _entity);
 
+  /// Wake up the sleeping Skeletons whose states, commands, forces, or
+  /// external forces differ from the ones recorded when they were put to sleep
+  /// by more than a small relative tolerance, or whose number of DOFs has
+  /// changed. The inputs of the awake Skeletons are recorded for this step.
+  void wakeUpDisturbedSkeletons();
+
+  /// Update how long each Skeleton has been at rest, and put the contact
+  /// islands that have been at rest long enough to sleep
+  void updateSleepingSkeletons();
+
+  /// Calculate the dynamics and integrate the awake mobile Skeletons by
+  /// timeStep without resetting their commands
+  void integrate(double timeStep);
+
+  /// Integrate the world by an adaptive time step, which is stored in
+  /// mLastTimeStep
+  void integrateAdaptively();
+
+  /// Set the time step of the constraint solver and the Skeletons
+  void setIntegrationTimeStep(double timeStep);
+
+  /// Save the states of the mobile Skeletons to roll back rejected steps
+  void saveAdaptiveStates();
+
+  /// Restore the states saved by saveAdaptiveStates()
+  void restoreAdaptiveStates();
+
   /// Name of this World
   std::string mName;
 
   /// Skeletons in this world
   std::vector<dynamics::SkeletonPtr> mSkeletons;
 
-  std::map<dynamics::ConstMetaSkeletonPtr,
-           dynamics::SkeletonPtr> mMapForSkeletons;
+  std::unordered_map<dynamics::ConstMetaSkeletonPtr,
+                     dynamics::SkeletonPtr> mMapForSkeletons;
 
   /// Connections for noticing changes in Skeleton names
   /// TODO(MXG): Consider putting this functionality into NameManager
@@ -312,6 +434,97 @@ protected:
   /// Constraint solver
   std::unique_ptr<constraint::ConstraintSolver> mConstraintSolver;
 
+  /// Sleeping bookkeeping of a Skeleton
+  struct SleepInfo
+  {
+    /// How long the Skeleton has been at rest
+    double mRestTime = 0.0;
+
+    /// Whether the Skeleton has been put to sleep by this World
+    bool mIsSleeping = false;
+
+    /// Generalized positions when the Skeleton was put to sleep
+    Eigen::VectorXd mPositions;
+
+    /// Commands set for the step the Skeleton was put to sleep
+    Eigen::VectorXd mCommands;
+
+    /// Generalized forces set for the step the Skeleton was put to sleep
+    Eigen::VectorXd mForces;
+
+    /// Generalized external forces set for the step the Skeleton was put to
+    /// sleep
+    Eigen::VectorXd mExternalForces;
+  };
+
+  /// Sleeping bookkeeping of the Skeletons in this world
+  std::unordered_map<const dynamics::Skeleton*, SleepInfo> mSleepInfos;
+
+  /// Whether the Skeletons that stay at rest are put to sleep
+  bool mSleepingEnabled;
+
+  /// Maximum magnitude of the generalized velocities of a Skeleton at rest
+  double mSleepVelocityThreshold;
+
+  /// How long a contact island should be at rest before it is put to sleep
+  double mSleepTimeThreshold;
+
+  /// State of a Skeleton for rolling back rejected adaptive steps
+  struct AdaptiveState
+  {
+    /// Generalized positions at the beginning of the step
+    Eigen::VectorXd mPositions;
+
+    /// Generalized velocities at the beginning of the step
+    Eigen::VectorXd mVelocities;
+
+    /// Generalized positions after the full step
+    Eigen::VectorXd mFullStepPositions;
+
+    /// Generalized velocities after the full step
+    Eigen::VectorXd mFullStepVelocities;
+
+    /// Positions of the PointMasses of the soft bodies at the beginning of the
+    /// step, three per PointMass
+    Eigen::VectorXd mPointPositions;
+
+    /// Velocities of the PointMasses at the beginning of the step
+    Eigen::VectorXd mPointVelocities;
+
+    /// Positions of the PointMasses after the full step
+    Eigen::VectorXd mFullStepPointPositions;
+
+    /// Velocities of the PointMasses after the full step
+    Eigen::VectorXd mFullStepPointVelocities;
+
+    /// Whether the Skeleton was sleeping at the beginning of the step
+    bool mIsSleeping;
+  };
+
+  /// States of the Skeletons in this world for adaptive time stepping
+  std::vector<AdaptiveState> mAdaptiveStates;
+
+  /// Whether step() adapts the time step to the motion
+  bool mAdaptiveTimeSteppingEnabled;
+
+  /// Tolerance of the local error of an adaptive step
+  double mAdaptiveTimeStepTolerance;
+
+  /// Lower bound of the adaptive time step
+  double mMinAdaptiveTimeStep;
+
+  /// Upper bound of the adaptive time step
+  double mMaxAdaptiveTimeStep;
+
+  /// Time step that the next adaptive step tries first
+  double mNextAdaptiveTimeStep;
+
+  /// Time step that the last step() advanced the world by
+  double mLastTimeStep;
+
+  /// Number of rejected adaptive steps since the last reset()
+  std::size_t mNumRejectedTimeSteps;
+
   ///
   Recording* mRecording;
 
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/simulation/WorldSnapshot.hpp"
+
+#include <cassert>
+
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/PointMass.hpp"
+#include "dart/dynamics/ShapeFrame.hpp"
+#include "dart/dynamics/SimpleFrame.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/SoftBodyNode.hpp"
+#include "dart/dynamics/SoftMeshShape.hpp"
+#include "dart/simulation/World.hpp"
+
+namespace dart {
+namespace simulation {
+
+//==============================================================================
+WorldSnapshot::WorldSnapshot()
+  : mTime(0.0), mSimFrames(0), mNumCapturedShapeFrames(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void WorldSnapshot::capture(const World& world)
+{
+  // The states of the previous capture are overwritten in place, and the
+  // vectors keep their capacity, so no memory is allocated once the number
+  // of ShapeFrames and PointMasses settles.
+  mSkeletons.clear();
+  mSimpleFrames.clear();
+  mNumCapturedShapeFrames = 0u;
+
+  mTime = world.getTime();
+  mSimFrames = world.getSimFrames();
+
+  for (std::size_t i = 0; i < world.getNumSkeletons(); ++i)
+  {
+    const dynamics::SkeletonPtr& skeleton = world.getSkeleton(i);
+    mSkeletons.push_back(skeleton);
+
+    for (std::size_t j = 0; j < skeleton->getNumTrees(); ++j)
+      captureFrameTree(skeleton->getRootBodyNode(j));
+  }
+
+  for (std::size_t i = 0; i < world.getNumSimpleFrames(); ++i)
+  {
+    mSimpleFrames.push_back(world.getSimpleFrame(i));
+    captureFrameTree(mSimpleFrames.back().get());
+  }
+
+  mShapeFrameStates.resize(mNumCapturedShapeFrames);
+}
+
+//==============================================================================
+void WorldSnapshot::clear()
+{
+  mShapeFrameStates.clear();
+  mSkeletons.clear();
+  mSimpleFrames.clear();
+}
+
+//==============================================================================
+double WorldSnapshot::getTime() const
+{
+  return mTime;
+}
+
+//==============================================================================
+int WorldSnapshot::getSimFrames() const
+{
+  return mSimFrames;
+}
+
+//==============================================================================
+std::size_t WorldSnapshot::getNumShapeFrames() const
+{
+  return mShapeFrameStates.size();
+}
+
+//==============================================================================
+const WorldSnapshot::ShapeFrameState& WorldSnapshot::getShapeFrameState(
+    std::size_t index) const
+{
+  assert(index < mShapeFrameStates.size());
+  return mShapeFrameStates[index];
+}
+
+//==============================================================================
+const common::aligned_vector<WorldSnapshot::ShapeFrameState>&
+WorldSnapshot::getShapeFrameStates() const
+{
+  return mShapeFrameStates;
+}
+
+//==============================================================================
+void WorldSnapshot::captureFrameTree(dynamics::Frame* root)
+{
+  mFrameQueue.clear();
+  mFrameQueue.push_back(root);
+
+  // Breadth first, matching the order in which WorldNode visits the Frames
+  for (std::size_t i = 0; i < mFrameQueue.size(); ++i)
+  {
+    dynamics::Frame* frame = mFrameQueue[i];
+
+    if (frame->isShapeFrame())
+    {
+      if (mNumCapturedShapeFrames == mShapeFrameStates.size())
+        mShapeFrameStates.emplace_back();
+
+      captureShapeFrame(
+          frame->asShapeFrame(),
+          mShapeFrameStates[mNumCapturedShapeFrames]);
+      ++mNumCapturedShapeFrames;
+    }
+
+    for (dynamics::Frame* child : frame->getChildFrames())
+      mFrameQueue.push_back(child);
+  }
+}
+
+//==============================================================================
+void WorldSnapshot::captureShapeFrame(
+    dynamics::ShapeFrame* shapeFrame, ShapeFrameState& state) const
+{
+  dynamics::VisualAspect* visual = shapeFrame->getVisualAspect();
+
+  state.mShapeFrame = shapeFrame;
+  state.mTransform = shapeFrame->getWorldTransform();
+  state.mShape = shapeFrame->getShape();
+  state.mHasVisualAspect = (visual != nullptr);
+  state.mVisualAspect = visual;
+  state.mShadowed = visual && visual->getShadowed();
+  state.mHidden = visual && visual->isHidden();
+  state.mRGBA = visual ? visual->getRGBA() : Eigen::Vector4d::Ones().eval();
+
+  state.mSoftMeshVertices.clear();
+  state.mSoftMeshFaces.clear();
+
+  const auto* softMeshShape
+      = state.mShape && state.mShape->is<dynamics::SoftMeshShape>()
+            ? static_cast<const dynamics::SoftMeshShape*>(state.mShape.get())
+            : nullptr;
+  if (!softMeshShape || !softMeshShape->getSoftBodyNode())
+    return;
+
+  // The vertices of the mesh are the PointMasses, which World::step() moves
+  const dynamics::SoftBodyNode* softBodyNode
+      = softMeshShape->getSoftBodyNode();
+
+  for (std::size_t i = 0; i < softBodyNode->getNumPointMasses(); ++i)
+  {
+    state.mSoftMeshVertices.push_back(
+        softBodyNode->getPointMass(i)->getLocalPosition());
+  }
+
+  for (std::size_t i = 0; i < softBodyNode->getNumFaces(); ++i)
+    state.mSoftMeshFaces.push_back(softBodyNode->getFace(i));
+}
+
+} // namespace simulation
+} // namespace dart
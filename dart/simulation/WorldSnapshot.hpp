@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_SIMULATION_WORLDSNAPSHOT_HPP_
+#define DART_SIMULATION_WORLDSNAPSHOT_HPP_
+
+#include <vector>
+
+#include <Eigen/Geometry>
+
+#include "dart/common/Memory.hpp"
+#include "dart/dynamics/SmartPointer.hpp"
+
+namespace dart {
+
+namespace dynamics {
+class Frame;
+class ShapeFrame;
+class VisualAspect;
+} // namespace dynamics
+
+namespace simulation {
+
+class World;
+
+/// WorldSnapshot records the world transforms and shapes of every ShapeFrame
+/// in a World at one instant, so that they can be read by another thread (e.g.,
+/// a renderer) while the World keeps on being simulated.
+///
+/// Besides the transforms, the snapshot copies the state that World::step()
+/// and the users of a World commonly change while it is simulated: the color
+/// and visibility of the VisualAspects, and the vertices of SoftMeshShapes.
+/// The other parameters of the Shapes (e.g., the size of a BoxShape) are not
+/// copied.
+///
+/// The snapshot keeps the Skeletons and SimpleFrames of the World alive, so
+/// the ShapeFrame pointers it holds stay valid for as long as the snapshot
+/// does. Capturing into a snapshot that has been captured before reuses its
+/// memory, which makes it suitable for use with common::TripleBuffer.
+class WorldSnapshot
+{
+public:
+  /// State of a single ShapeFrame
+  struct ShapeFrameState
+  {
+    /// The ShapeFrame that this state was recorded from
+    dynamics::ShapeFrame* mShapeFrame;
+
+    /// World transform of the ShapeFrame
+    Eigen::Isometry3d mTransform;
+
+    /// Shape of the ShapeFrame. This may be nullptr.
+    dynamics::ShapePtr mShape;
+
+    /// True iff the ShapeFrame has a VisualAspect
+    bool mHasVisualAspect;
+
+    /// VisualAspect of the ShapeFrame, or nullptr. This is only meant to tell
+    /// VisualAspects apart; their content is copied into the fields below.
+    dynamics::VisualAspect* mVisualAspect;
+
+    /// True iff the ShapeFrame has a VisualAspect that casts shadows
+    bool mShadowed;
+
+    /// True iff the ShapeFrame has a VisualAspect that is hidden
+    bool mHidden;
+
+    /// Color of the VisualAspect, including its alpha
+    Eigen::Vector4d mRGBA;
+
+    /// Positions of the PointMasses in the frame of the SoftBodyNode, if the
+    /// Shape is a SoftMeshShape. Empty otherwise.
+    std::vector<Eigen::Vector3d> mSoftMeshVertices;
+
+    /// Faces of the SoftBodyNode, if the Shape is a SoftMeshShape. Empty
+    /// otherwise.
+    std::vector<Eigen::Vector3i> mSoftMeshFaces;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  /// Default constructor
+  WorldSnapshot();
+
+  /// Record the current state of \c world, replacing the previous content of
+  /// this snapshot. This must be called from the thread that simulates the
+  /// World, between steps.
+  void capture(const World& world);
+
+  /// Remove all the content of this snapshot and release the Skeletons and
+  /// SimpleFrames that it keeps alive.
+  void clear();
+
+  /// Get the simulation time of the World when it was captured
+  double getTime() const;
+
+  /// Get the number of simulation frames of the World when it was captured
+  int getSimFrames() const;
+
+  /// Get the number of ShapeFrames in this snapshot
+  std::size_t getNumShapeFrames() const;
+
+  /// Get the state of the ShapeFrame with the given index
+  const ShapeFrameState& getShapeFrameState(std::size_t index) const;
+
+  /// Get the states of all the ShapeFrames in this snapshot, in the breadth
+  /// first order of the Frame trees, Skeletons first
+  const common::aligned_vector<ShapeFrameState>& getShapeFrameStates() const;
+
+protected:
+  /// Record the ShapeFrames of the Frame tree rooted at \c root
+  void captureFrameTree(dynamics::Frame* root);
+
+  /// Record the state of a ShapeFrame into \c state
+  void captureShapeFrame(
+      dynamics::ShapeFrame* shapeFrame, ShapeFrameState& state) const;
+
+  /// Simulation time of the World
+  double mTime;
+
+  /// Number of simulation frames of the World
+  int mSimFrames;
+
+  /// States of the ShapeFrames
+  common::aligned_vector<ShapeFrameState> mShapeFrameStates;
+
+  /// Number of ShapeFrames recorded so far by the ongoing capture()
+  std::size_t mNumCapturedShapeFrames;
+
+  /// Skeletons that own the recorded ShapeFrames
+  std::vector<dynamics::SkeletonPtr> mSkeletons;
+
+  /// SimpleFrames that own the recorded ShapeFrames
+  std::vector<dynamics::SimpleFramePtr> mSimpleFrames;
+
+  /// Scratch queue for traversing the Frame trees
+  std::vector<dynamics::Frame*> mFrameQueue;
+};
+
+} // namespace simulation
+} // namespace dart
+
+#endif // DART_SIMULATION_WORLDSNAPSHOT_HPP_
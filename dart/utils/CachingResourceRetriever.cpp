@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/utils/CachingResourceRetriever.hpp"
+
+#include <vector>
+#include "dart/common/Console.hpp"
+#include "dart/common/LocalResourceRetriever.hpp"
+#include "dart/common/MemoryResource.hpp"
+#include "dart/common/Platform.hpp"
+#include "dart/common/StlHelpers.hpp"
+
+#if DART_OS_LINUX || DART_OS_MACOS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dart {
+namespace utils {
+
+namespace {
+
+//==============================================================================
+/// Maps the regular file at path into memory. Returns false if the file can't
+/// be mapped, in which case the caller should read it instead.
+bool mapFile(
+    const std::string& path, std::shared_ptr<const void>& data,
+    std::size_t& size)
+{
+#if DART_OS_LINUX || DART_OS_MACOS
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd == -1)
+    return false;
+
+  struct stat status;
+  if (::fstat(fd, &status) != 0 || !S_ISREG(status.st_mode)
+      || status.st_size <= 0)
+  {
+    ::close(fd);
+    return false;
+  }
+
+  const std::size_t length = static_cast<std::size_t>(status.st_size);
+  void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // The mapping remains valid after the descriptor is closed.
+  ::close(fd);
+
+  if (address == MAP_FAILED)
+    return false;
+
+  data = std::shared_ptr<const void>(address, [length](const void* mapped)
+  {
+    ::munmap(const_cast<void*>(mapped), length);
+  });
+  size = length;
+
+  return true;
+#else
+  DART_UNUSED(path);
+  DART_UNUSED(data);
+  DART_UNUSED(size);
+  return false;
+#endif
+}
+
+} // anonymous namespace
+
+//==============================================================================
+CachingResourceRetriever::CachingResourceRetriever(
+  const common::ResourceRetrieverPtr& _retriever)
+{
+  if (_retriever)
+    mRetriever = _retriever;
+  else
+    mRetriever = std::make_shared<common::LocalResourceRetriever>();
+}
+
+//==============================================================================
+constexpr std::size_t CachingResourceRetriever::MinMappedFileSize;
+
+//==============================================================================
+bool CachingResourceRetriever::exists(const common::Uri& _uri)
+{
+  Content content;
+  if (find(_uri.toString(), content))
+    return true;
+
+  return mRetriever->exists(_uri);
+}
+
+//==============================================================================
+common::ResourcePtr CachingResourceRetriever::retrieve(const common::Uri& _uri)
+{
+  const std::string key = _uri.toString();
+
+  Content content;
+  if (find(key, content))
+    return std::make_shared<common::MemoryResource>(content.mData, content.mSize);
+
+  // Load outside of the lock so that different resources can be loaded
+  // concurrently. If two threads load the same resource at once, the content
+  // of the first one to finish is kept.
+  if (!load(_uri, content))
+    return nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    content = mContents.emplace(key, content).first->second;
+  }
+
+  return std::make_shared<common::MemoryResource>(content.mData, content.mSize);
+}
+
+//==============================================================================
+std::string CachingResourceRetriever::getFilePath(const common::Uri& uri)
+{
+  return mRetriever->getFilePath(uri);
+}
+
+//==============================================================================
+bool CachingResourceRetriever::evict(const common::Uri& _uri)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mContents.erase(_uri.toString()) > 0u;
+}
+
+//==============================================================================
+void CachingResourceRetriever::clearCache()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mContents.clear();
+}
+
+//==============================================================================
+std::size_t CachingResourceRetriever::getNumCachedResources() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mContents.size();
+}
+
+//==============================================================================
+std::size_t CachingResourceRetriever::getCacheSize() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  std::size_t size = 0u;
+  for (const auto& content : mContents)
+    size += content.second.mSize;
+
+  return size;
+}
+
+//==============================================================================
+bool CachingResourceRetriever::FileStamp::operator==(
+    const FileStamp& other) const
+{
+  return mDevice == other.mDevice && mInode == other.mInode
+         && mSize == other.mSize
+         && mModificationTime == other.mModificationTime;
+}
+
+//==============================================================================
+bool CachingResourceRetriever::getFileStamp(
+    const std::string& _path, FileStamp& _stamp)
+{
+#if DART_OS_LINUX || DART_OS_MACOS
+  struct stat status;
+  if (::stat(_path.c_str(), &status) != 0 || !S_ISREG(status.st_mode))
+    return false;
+
+#if DART_OS_MACOS
+  const struct timespec& time = status.st_mtimespec;
+#else
+  const struct timespec& time = status.st_mtim;
+#endif
+
+  _stamp.mDevice = static_cast<std::uint64_t>(status.st_dev);
+  _stamp.mInode = static_cast<std::uint64_t>(status.st_ino);
+  _stamp.mSize = static_cast<std::uint64_t>(status.st_size);
+  _stamp.mModificationTime
+      = static_cast<std::int64_t>(time.tv_sec) * 1000000000
+        + static_cast<std::int64_t>(time.tv_nsec);
+
+  return true;
+#else
+  DART_UNUSED(_path);
+  DART_UNUSED(_stamp);
+  return false;
+#endif
+}
+
+//==============================================================================
+bool CachingResourceRetriever::find(const std::string& _key, Content& _content)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto it = mContents.find(_key);
+    if (it == mContents.end())
+      return false;
+
+    _content = it->second;
+  }
+
+  if (_content.mPath.empty())
+    return true;
+
+  // Check the file outside of the lock, since it's a system call
+  FileStamp stamp;
+  if (getFileStamp(_content.mPath, stamp) && stamp == _content.mStamp)
+    return true;
+
+  // Drop the stale content unless another thread already replaced it
+  std::lock_guard<std::mutex> lock(mMutex);
+  const auto it = mContents.find(_key);
+  if (it != mContents.end() && it->second.mData == _content.mData)
+    mContents.erase(it);
+
+  return false;
+}
+
+//==============================================================================
+bool CachingResourceRetriever::load(const common::Uri& _uri, Content& _content)
+{
+  // Stamp the file before reading it, so that a change made while reading it
+  // is noticed by the next lookup.
+  const std::string path = mRetriever->getFilePath(_uri);
+  _content.mPath.clear();
+  if (!path.empty() && getFileStamp(path, _content.mStamp))
+  {
+    _content.mPath = path;
+
+    if (_content.mStamp.mSize >= MinMappedFileSize
+        && mapFile(path, _content.mData, _content.mSize))
+    {
+      return true;
+    }
+  }
+
+  const common::ResourcePtr resource = mRetriever->retrieve(_uri);
+  if (!resource)
+    return false;
+
+  const auto buffer = std::make_shared<std::vector<char>>(resource->getSize());
+  if (!buffer->empty() && resource->read(buffer->data(), buffer->size(), 1) != 1)
+  {
+    dtwarn << "[CachingResourceRetriever::load] Failed reading the content of '"
+           << _uri.toString() << "'.\n";
+    return false;
+  }
+
+  // Share ownership of the buffer while pointing at its data.
+  _content.mData = std::shared_ptr<const void>(buffer, buffer->data());
+  _content.mSize = buffer->size();
+
+  return true;
+}
+
+} // namespace utils
+} // namespace dart
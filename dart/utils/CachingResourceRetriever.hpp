@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_UTILS_CACHINGRESOURCERETRIEVER_HPP_
+#define DART_UTILS_CACHINGRESOURCERETRIEVER_HPP_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "dart/common/ResourceRetriever.hpp"
+
+namespace dart {
+namespace utils {
+
+/// CachingResourceRetriever keeps the content of every resource retrieved
+/// through it in memory, so that loading the same asset again (e.g., a mesh
+/// shared by many links or a model that is loaded repeatedly) costs no extra
+/// I/O. Large resources that resolve to a local file are memory-mapped where
+/// the platform supports it instead of being copied into memory.
+///
+/// On Linux and macOS, the size, modification time, and identity of a local
+/// file are checked whenever its cached content is looked up, and the content
+/// is loaded again if the file has changed. Content that doesn't come from a
+/// local file, or from any file on other platforms, is never refreshed; call
+/// evict() or clearCache() if it may have changed.
+///
+/// A memory-mapped file must not be truncated or rewritten in place while
+/// resources retrieved from it are still in use, because their content is the
+/// mapping of the file. Replacing the file (e.g., by renaming a new file over
+/// it) is safe. Files smaller than MinMappedFileSize are copied instead.
+///
+/// The cache is safe to use from several threads.
+///
+/// Example:
+/// @code
+/// auto retriever = std::make_shared<CompositeResourceRetriever>();
+/// // ... register schema retrievers ...
+/// auto cached = std::make_shared<CachingResourceRetriever>(retriever);
+/// auto world = SkelParser::readWorld(uri, cached);
+/// @endcode
+class CachingResourceRetriever : public virtual common::ResourceRetriever
+{
+public:
+  /// Construct a CachingResourceRetriever that caches the resources retrieved
+  /// by \a _retriever. A LocalResourceRetriever is used if it is nullptr.
+  explicit CachingResourceRetriever(
+    const common::ResourceRetrieverPtr& _retriever = nullptr);
+
+  virtual ~CachingResourceRetriever() = default;
+
+  // Documentation inherited.
+  bool exists(const common::Uri& _uri) override;
+
+  // Documentation inherited.
+  common::ResourcePtr retrieve(const common::Uri& _uri) override;
+
+  // Documentation inherited.
+  std::string getFilePath(const common::Uri& uri) override;
+
+  /// Files of at least this size, in bytes, are memory-mapped
+  static constexpr std::size_t MinMappedFileSize = 64u * 1024u;
+
+  /// Drop the cached content of _uri. Returns false if it wasn't cached.
+  bool evict(const common::Uri& _uri);
+
+  /// Drop all cached content.
+  void clearCache();
+
+  /// Returns the number of resources whose content is cached.
+  std::size_t getNumCachedResources() const;
+
+  /// Returns the total size, in bytes, of the cached content.
+  std::size_t getCacheSize() const;
+
+private:
+  /// Identifies a version of a local file
+  struct FileStamp
+  {
+    std::uint64_t mDevice;
+    std::uint64_t mInode;
+    std::uint64_t mSize;
+    std::int64_t mModificationTime;
+
+    bool operator==(const FileStamp& other) const;
+  };
+
+  struct Content
+  {
+    std::shared_ptr<const void> mData;
+    std::size_t mSize;
+
+    /// The local file the content was read from, or empty if there is none or
+    /// it can't be checked for changes
+    std::string mPath;
+
+    /// The version of the file at mPath that the content was read from
+    FileStamp mStamp;
+  };
+
+  /// Returns the stamp of the regular file at _path in _stamp. Returns false if
+  /// there is no such file or the platform isn't supported.
+  static bool getFileStamp(const std::string& _path, FileStamp& _stamp);
+
+  /// Returns the cached content of _key in _content if there is any and it is
+  /// up to date. Stale content is dropped from the cache.
+  bool find(const std::string& _key, Content& _content);
+
+  /// Loads the content of _uri from mRetriever. Returns false on failure.
+  bool load(const common::Uri& _uri, Content& _content);
+
+  common::ResourceRetrieverPtr mRetriever;
+
+  /// Map from a URI to its content
+  std::unordered_map<std::string, Content> mContents;
+
+  /// Protects mContents
+  mutable std::mutex mMutex;
+};
+
+using CachingResourceRetrieverPtr = std::shared_ptr<CachingResourceRetriever>;
+
+} // namespace utils
+} // namespace dart
+
+#endif // ifndef DART_UTILS_CACHINGRESOURCERETRIEVER_HPP_
@@ -30,6 +30,7 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
 #include <iostream>
 #include "dart/common/Console.hpp"
 #include "dart/common/Uri.hpp"
@@ -43,6 +44,7 @@ void CompositeResourceRetriever::addDefaultRetriever(
   const common::ResourceRetrieverPtr& _resourceRetriever)
 {
   mDefaultResourceRetrievers.push_back(_resourceRetriever);
+  clearResolvedRetrievers();
 }
 
 //==============================================================================
@@ -66,6 +68,7 @@ bool CompositeResourceRetriever::addSchemaRetriever(
   }
 
   mResourceRetrievers[_schema].push_back(_resourceRetriever);
+  clearResolvedRetrievers();
   return true;
 }
 
@@ -76,7 +79,10 @@ bool CompositeResourceRetriever::exists(const common::Uri& _uri)
       : getRetrievers(_uri))
   {
     if(resourceRetriever->exists(_uri))
+    {
+      setResolvedRetriever(_uri, resourceRetriever);
       return true;
+    }
   }
   return false;
 }
@@ -90,7 +96,10 @@ common::ResourcePtr CompositeResourceRetriever::retrieve(
   for(const common::ResourceRetrieverPtr& resourceRetriever : retrievers)
   {
     if(common::ResourcePtr resource = resourceRetriever->retrieve(_uri))
+    {
+      setResolvedRetriever(_uri, resourceRetriever);
       return resource;
+    }
   }
 
   dtwarn << "[CompositeResourceRetriever::retrieve] All ResourceRetrievers"
@@ -107,7 +116,10 @@ std::string CompositeResourceRetriever::getFilePath(const common::Uri& uri)
   {
     const auto path = resourceRetriever->getFilePath(uri);
     if (!path.empty())
+    {
+      setResolvedRetriever(uri, resourceRetriever);
       return path;
+    }
   }
 
   return "";
@@ -133,6 +145,23 @@ std::vector<common::ResourceRetrieverPtr>
     std::begin(mDefaultResourceRetrievers),
     std::end(mDefaultResourceRetrievers));
 
+  // Try the retriever that succeeded for this URI last time first.
+  common::ResourceRetrieverPtr resolvedRetriever;
+  {
+    std::lock_guard<std::mutex> lock(mResolvedRetrieversMutex);
+    const auto resolved = mResolvedRetrievers.find(_uri.toString());
+    if(resolved != std::end(mResolvedRetrievers))
+      resolvedRetriever = resolved->second;
+  }
+
+  if(resolvedRetriever)
+  {
+    const auto position = std::find(
+      std::begin(retrievers), std::end(retrievers), resolvedRetriever);
+    if(position != std::end(retrievers))
+      std::rotate(std::begin(retrievers), position, position + 1);
+  }
+
   if(retrievers.empty())
   {
     dtwarn << "[CompositeResourceRetriever::retrieve] There are no resource"
@@ -144,5 +173,21 @@ std::vector<common::ResourceRetrieverPtr>
   return retrievers;
 }
 
+//==============================================================================
+void CompositeResourceRetriever::setResolvedRetriever(
+  const common::Uri& _uri,
+  const common::ResourceRetrieverPtr& _resourceRetriever)
+{
+  std::lock_guard<std::mutex> lock(mResolvedRetrieversMutex);
+  mResolvedRetrievers[_uri.toString()] = _resourceRetriever;
+}
+
+//==============================================================================
+void CompositeResourceRetriever::clearResolvedRetrievers()
+{
+  std::lock_guard<std::mutex> lock(mResolvedRetrieversMutex);
+  mResolvedRetrievers.clear();
+}
+
 } // namespace utils
 } // namespace dart
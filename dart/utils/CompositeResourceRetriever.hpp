@@ -33,6 +33,7 @@
 #ifndef DART_UTILS_COMPOSITERESOURCERETRIEVER_HPP_
 #define DART_UTILS_COMPOSITERESOURCERETRIEVER_HPP_
 
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include "dart/common/ResourceRetriever.hpp"
@@ -44,6 +45,9 @@ namespace utils {
 /// used interchangably by: (1) associating each \ref ResourceRetriever with a
 /// particular URI schema and/or (2) providing a precedence order for trying
 /// multiple retrievers.
+///
+/// The retriever that last succeeded for a URI is remembered and is tried
+/// first the next time the same URI is requested.
 class CompositeResourceRetriever : public virtual common::ResourceRetriever
 {
 public:
@@ -79,9 +83,25 @@ private:
   std::vector<common::ResourceRetrieverPtr> getRetrievers(
     const common::Uri& _uri) const;
 
+  /// Remembers that _resourceRetriever succeeded for _uri.
+  void setResolvedRetriever(
+    const common::Uri& _uri,
+    const common::ResourceRetrieverPtr& _resourceRetriever);
+
+  /// Forgets every remembered retriever.
+  void clearResolvedRetrievers();
+
   std::unordered_map<std::string,
     std::vector<common::ResourceRetrieverPtr> > mResourceRetrievers;
   std::vector<common::ResourceRetrieverPtr> mDefaultResourceRetrievers;
+
+  /// Map from a URI to the retriever that last succeeded for it
+  std::unordered_map<std::string, common::ResourceRetrieverPtr>
+    mResolvedRetrievers;
+
+  /// Protects mResolvedRetrievers, since resources may be retrieved
+  /// concurrently
+  mutable std::mutex mResolvedRetrieversMutex;
 };
 
 using CompositeResourceRetrieverPtr
@@ -70,19 +70,19 @@ bool DartResourceRetriever::exists(const common::Uri& uri)
 
   if (uri.mAuthority.get() == "sample")
   {
-    for (const auto& dataPath : mDataDirectories)
+    for (const auto& fileUri : getCandidateUris(uri, relativePath))
     {
-      common::Uri fileUri;
-      fileUri.fromPath(dataPath + relativePath);
-
       if (mLocalRetriever->exists(fileUri))
+      {
+        setResolvedUri(uri, fileUri);
         return true;
-
-      dtwarn << "Failed to retrieve a resource from '" << uri.toString()
-             << "'. Please make sure you set the environment variable for DART "
-             << "data path. For example:\n"
-             << "  $ export DART_DATA_PATH=/usr/local/share/doc/dart/data/\n";
+      }
     }
+
+    dtwarn << "Failed to retrieve a resource from '" << uri.toString()
+           << "'. Please make sure you set the environment variable for DART "
+           << "data path. For example:\n"
+           << "  $ export DART_DATA_PATH=/usr/local/share/doc/dart/data/\n";
   }
   else
   {
@@ -102,13 +102,13 @@ common::ResourcePtr DartResourceRetriever::retrieve(const common::Uri& uri)
 
   if (uri.mAuthority.get() == "sample")
   {
-    for (const auto& dataPath : mDataDirectories)
+    for (const auto& fileUri : getCandidateUris(uri, relativePath))
     {
-      common::Uri fileUri;
-      fileUri.fromPath(dataPath + relativePath);
-
       if (const auto resource = mLocalRetriever->retrieve(fileUri))
+      {
+        setResolvedUri(uri, fileUri);
         return resource;
+      }
     }
 
     dtwarn << "Failed to retrieve a resource from '" << uri.toString()
@@ -134,16 +134,16 @@ std::string DartResourceRetriever::getFilePath(const common::Uri& uri)
 
   if (uri.mAuthority.get() == "sample")
   {
-    for (const auto& dataPath : mDataDirectories)
+    for (const auto& fileUri : getCandidateUris(uri, relativePath))
     {
-      common::Uri fileUri;
-      fileUri.fromPath(dataPath + relativePath);
-
       const auto path = mLocalRetriever->getFilePath(fileUri);
 
       // path is empty if the file specified by fileUri doesn't exist.
       if (!path.empty())
+      {
+        setResolvedUri(uri, fileUri);
         return path;
+      }
     }
     
     dtwarn << "Failed to retrieve a resource from '" << uri.toString()
@@ -201,5 +201,43 @@ bool DartResourceRetriever::resolveDataUri(
   return true;
 }
 
+//==============================================================================
+std::vector<common::Uri> DartResourceRetriever::getCandidateUris(
+    const common::Uri& uri, const std::string& relativePath) const
+{
+  std::vector<common::Uri> candidates;
+  candidates.reserve(mDataDirectories.size() + 1u);
+
+  std::string resolvedUri;
+  {
+    std::lock_guard<std::mutex> lock(mResolvedUrisMutex);
+    const auto it = mResolvedUris.find(uri.toString());
+    if (it != mResolvedUris.end())
+    {
+      candidates.push_back(it->second);
+      resolvedUri = it->second.toString();
+    }
+  }
+
+  for (const auto& dataPath : mDataDirectories)
+  {
+    common::Uri fileUri;
+    fileUri.fromPath(dataPath + relativePath);
+
+    if (resolvedUri.empty() || fileUri.toString() != resolvedUri)
+      candidates.push_back(fileUri);
+  }
+
+  return candidates;
+}
+
+//==============================================================================
+void DartResourceRetriever::setResolvedUri(
+    const common::Uri& uri, const common::Uri& fileUri)
+{
+  std::lock_guard<std::mutex> lock(mResolvedUrisMutex);
+  mResolvedUris[uri.toString()] = fileUri;
+}
+
 } // namespace utils
 } // namespace dart
@@ -33,6 +33,7 @@
 #ifndef DART_UTILS_DARTRESOURCERETRIEVER_HPP_
 #define DART_UTILS_DARTRESOURCERETRIEVER_HPP_
 
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include "dart/common/ResourceRetriever.hpp"
@@ -60,6 +61,9 @@ namespace utils {
 ///    (e.g., Linux: /usr/local/share/doc/dart/data/).
 /// 3) environment variable, DART_DATA_PATH: Path to the data directory
 ///    specified by the user.
+///
+/// The data directory that a URI was found in is remembered, so later requests
+/// for the same URI don't probe the other directories again.
 class DartResourceRetriever : public common::ResourceRetriever
 {
 public:
@@ -91,10 +95,24 @@ private:
 
   bool resolveDataUri(const common::Uri& uri, std::string& relativePath) const;
 
+  /// Returns the file URIs in the data directories that a sample URI may
+  /// resolve to, starting with the one it was previously resolved to.
+  std::vector<common::Uri> getCandidateUris(
+      const common::Uri& uri, const std::string& relativePath) const;
+
+  /// Remembers that uri resolved to fileUri.
+  void setResolvedUri(const common::Uri& uri, const common::Uri& fileUri);
+
 private:
   common::ResourceRetrieverPtr mLocalRetriever;
 
   std::vector<std::string> mDataDirectories;
+
+  /// Map from a sample URI to the file URI it was last resolved to
+  std::unordered_map<std::string, common::Uri> mResolvedUris;
+
+  /// Protects mResolvedUris, since resources may be retrieved concurrently
+  mutable std::mutex mResolvedUrisMutex;
 };
 
 using DartResourceRetrieverPtr = std::shared_ptr<DartResourceRetriever>;
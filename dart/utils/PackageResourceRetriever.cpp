@@ -64,64 +64,65 @@ void PackageResourceRetriever::addPackageDirectory(
     normalizedPackageDirectory = _packageDirectory;
 
   mPackageMap[_packageName].push_back(normalizedPackageDirectory);
+
+  clearResolutionCache();
 }
 
 //==============================================================================
-bool PackageResourceRetriever::exists(const common::Uri& _uri)
+void PackageResourceRetriever::clearResolutionCache()
 {
-  std::string packageName, relativePath;
-  if (!resolvePackageUri(_uri, packageName, relativePath))
-    return false;
+  std::lock_guard<std::mutex> lock(mResolvedUrisMutex);
+  mResolvedUris.clear();
+}
 
-  for (const std::string& packagePath : getPackagePaths(packageName))
+//==============================================================================
+bool PackageResourceRetriever::exists(const common::Uri& _uri)
+{
+  for (const common::Uri& fileUri : getCandidateUris(_uri))
   {
-    common::Uri fileUri;
-    fileUri.fromPath(packagePath + relativePath);
-
     if (mLocalRetriever->exists(fileUri))
+    {
+      setResolvedUri(_uri, fileUri);
       return true;
+    }
   }
 
+  removeResolvedUri(_uri);
   return false;
 }
 
 //==============================================================================
 common::ResourcePtr PackageResourceRetriever::retrieve(const common::Uri& _uri)
 {
-  std::string packageName, relativePath;
-  if (!resolvePackageUri(_uri, packageName, relativePath))
-    return nullptr;
-
-  for(const std::string& packagePath : getPackagePaths(packageName))
+  for(const common::Uri& fileUri : getCandidateUris(_uri))
   {
-    common::Uri fileUri;
-    fileUri.fromPath(packagePath + relativePath);
-
     if(const auto resource = mLocalRetriever->retrieve(fileUri))
+    {
+      setResolvedUri(_uri, fileUri);
       return resource;
+    }
   }
+
+  removeResolvedUri(_uri);
   return nullptr;
 }
 
 //==============================================================================
 std::string PackageResourceRetriever::getFilePath(const common::Uri& uri)
 {
-  std::string packageName, relativePath;
-  if (!resolvePackageUri(uri, packageName, relativePath))
-    return "";
-
-  for(const std::string& packagePath : getPackagePaths(packageName))
+  for(const common::Uri& fileUri : getCandidateUris(uri))
   {
-    common::Uri fileUri;
-    fileUri.fromPath(packagePath + relativePath);
-
     const auto path = mLocalRetriever->getFilePath(fileUri);
 
     // path is empty if the file specified by fileUri doesn't exist.
     if (!path.empty())
+    {
+      setResolvedUri(uri, fileUri);
       return path;
+    }
   }
 
+  removeResolvedUri(uri);
   return "";
 }
 
@@ -171,5 +172,54 @@ bool PackageResourceRetriever::resolvePackageUri(
   return true;
 }
 
+//==============================================================================
+std::vector<common::Uri> PackageResourceRetriever::getCandidateUris(
+  const common::Uri& _uri) const
+{
+  std::vector<common::Uri> candidates;
+
+  std::string packageName, relativePath;
+  if (!resolvePackageUri(_uri, packageName, relativePath))
+    return candidates;
+
+  std::string resolvedUri;
+  {
+    std::lock_guard<std::mutex> lock(mResolvedUrisMutex);
+    const auto it = mResolvedUris.find(_uri.toString());
+    if (it != mResolvedUris.end())
+    {
+      candidates.push_back(it->second);
+      resolvedUri = it->second.toString();
+    }
+  }
+
+  for (const std::string& packagePath : getPackagePaths(packageName))
+  {
+    common::Uri fileUri;
+    fileUri.fromPath(packagePath + relativePath);
+
+    // Don't probe the previously resolved file twice.
+    if (resolvedUri.empty() || fileUri.toString() != resolvedUri)
+      candidates.push_back(fileUri);
+  }
+
+  return candidates;
+}
+
+//==============================================================================
+void PackageResourceRetriever::setResolvedUri(
+  const common::Uri& _uri, const common::Uri& _fileUri)
+{
+  std::lock_guard<std::mutex> lock(mResolvedUrisMutex);
+  mResolvedUris[_uri.toString()] = _fileUri;
+}
+
+//==============================================================================
+void PackageResourceRetriever::removeResolvedUri(const common::Uri& _uri)
+{
+  std::lock_guard<std::mutex> lock(mResolvedUrisMutex);
+  mResolvedUris.erase(_uri.toString());
+}
+
 } // namespace utils
 } // namespace dart
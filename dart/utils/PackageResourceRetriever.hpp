@@ -33,6 +33,7 @@
 #ifndef DART_UTILS_PACKAGERESOURCERETRIEVER_HPP_
 #define DART_UTILS_PACKAGERESOURCERETRIEVER_HPP_
 
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include "dart/common/ResourceRetriever.hpp"
@@ -45,6 +46,10 @@ namespace utils {
 /// \ref ResourceRetriever. This class uses requires you to manually provide the
 /// base URI of every package that you wish to resolve using the
 /// \ref addPackageDirectory method.
+///
+/// The package path that a URI resolved to is remembered, so later requests
+/// for the same URI go straight to that file instead of probing every
+/// candidate package path again.
 class PackageResourceRetriever : public virtual common::ResourceRetriever
 {
 public:
@@ -85,6 +90,11 @@ public:
   void addPackageDirectory(const std::string& _packageName,
                            const std::string& _packageDirectory);
 
+  /// Forget which package path each URI resolved to. This is done
+  /// automatically by addPackageDirectory(), but must be called manually if
+  /// files are moved between package directories.
+  void clearResolutionCache();
+
   // Documentation inherited.
   bool exists(const common::Uri& _uri) override;
 
@@ -98,10 +108,26 @@ private:
   common::ResourceRetrieverPtr mLocalRetriever;
   std::unordered_map<std::string, std::vector<std::string> > mPackageMap;
 
+  /// Map from a package URI to the file URI it was last resolved to
+  std::unordered_map<std::string, common::Uri> mResolvedUris;
+
+  /// Protects mResolvedUris, since resources may be retrieved concurrently
+  mutable std::mutex mResolvedUrisMutex;
+
   const std::vector<std::string>& getPackagePaths(
     const std::string& _packageName) const;
   bool resolvePackageUri(const common::Uri& _uri,
     std::string& _packageName, std::string& _relativePath) const;
+
+  /// Returns the file URIs that _uri may resolve to, in the order they should
+  /// be tried. The previously resolved file URI, if any, comes first.
+  std::vector<common::Uri> getCandidateUris(const common::Uri& _uri) const;
+
+  /// Remembers that _uri resolved to _fileUri.
+  void setResolvedUri(const common::Uri& _uri, const common::Uri& _fileUri);
+
+  /// Forgets the file URI that _uri resolved to.
+  void removeResolvedUri(const common::Uri& _uri);
 };
 
 using PackageResourceRetrieverPtr = std::shared_ptr<PackageResourceRetriever>;
@@ -41,6 +41,7 @@
 
 #include "dart/config.hpp"
 #include "dart/common/Console.hpp"
+#include "dart/common/detail/ParallelFor.hpp"
 #include "dart/collision/CollisionObject.hpp"
 #include "dart/collision/dart/DARTCollisionDetector.hpp"
 #include "dart/collision/fcl/FCLCollisionDetector.hpp"
@@ -128,7 +129,8 @@ using JointToIndex = std::map<std::string, std::size_t>;
 simulation::WorldPtr readWorld(
     tinyxml2::XMLElement* _worldElement,
     const common::Uri& _baseUri,
-    const common::ResourceRetrieverPtr& _retriever);
+    const common::ResourceRetrieverPtr& _retriever,
+    std::size_t _numThreads);
 
 dart::dynamics::SkeletonPtr readSkeleton(
     tinyxml2::XMLElement* _skeletonElement,
@@ -253,7 +255,8 @@ tinyxml2::XMLElement* checkFormatAndGetWorldElement(
 simulation::WorldPtr readWorld(
   tinyxml2::XMLElement* _worldElement,
   const common::Uri& _baseUri,
-  const common::ResourceRetrieverPtr& _retriever);
+  const common::ResourceRetrieverPtr& _retriever,
+  std::size_t _numThreads);
 
 NextResult getNextJointAndNodePair(
     JointMap::iterator& it,
@@ -401,7 +404,8 @@ common::ResourceRetrieverPtr getRetriever(
 //==============================================================================
 simulation::WorldPtr SkelParser::readWorld(
   const common::Uri& _uri,
-  const common::ResourceRetrieverPtr& _retriever)
+  const common::ResourceRetrieverPtr& _retriever,
+  std::size_t _numThreads)
 {
   const common::ResourceRetrieverPtr retriever = getRetriever(_retriever);
 
@@ -427,14 +431,15 @@ simulation::WorldPtr SkelParser::readWorld(
     return nullptr;
   }
 
-  return ::dart::utils::readWorld(worldElement, _uri, retriever);
+  return ::dart::utils::readWorld(worldElement, _uri, retriever, _numThreads);
 }
 
 //==============================================================================
 simulation::WorldPtr SkelParser::readWorldXML(
   const std::string& _xmlString,
   const common::Uri& _baseUri,
-  const common::ResourceRetrieverPtr& _retriever)
+  const common::ResourceRetrieverPtr& _retriever,
+  std::size_t _numThreads)
 {
   const common::ResourceRetrieverPtr retriever = getRetriever(_retriever);
 
@@ -452,7 +457,8 @@ simulation::WorldPtr SkelParser::readWorldXML(
     return nullptr;
   }
 
-  return ::dart::utils:: readWorld(worldElement, _baseUri, retriever);
+  return ::dart::utils::readWorld(
+        worldElement, _baseUri, retriever, _numThreads);
 }
 
 //==============================================================================
@@ -688,7 +694,8 @@ createFclMeshCollisionDetector()
 simulation::WorldPtr readWorld(
   tinyxml2::XMLElement* _worldElement,
   const common::Uri& _baseUri,
-  const common::ResourceRetrieverPtr& _retriever)
+  const common::ResourceRetrieverPtr& _retriever,
+  std::size_t _numThreads)
 {
   assert(_worldElement != nullptr);
 
@@ -763,14 +770,23 @@ simulation::WorldPtr readWorld(
 
   //--------------------------------------------------------------------------
   // Load soft skeletons
+  std::vector<tinyxml2::XMLElement*> skeletonElements;
   ElementEnumerator SkeletonElements(_worldElement, "skeleton");
   while (SkeletonElements.next())
+    skeletonElements.push_back(SkeletonElements.get());
+
+  // The skeletons are independent of each other and of the world, so they are
+  // built concurrently and only added to the world afterwards, in the order
+  // they appear in the file.
+  std::vector<dynamics::SkeletonPtr> skeletons(skeletonElements.size());
+  common::detail::parallelFor(
+      skeletonElements.size(), _numThreads, [&](std::size_t i)
   {
-    dynamics::SkeletonPtr newSkeleton
-        = ::dart::utils::readSkeleton(SkeletonElements.get(), _baseUri, _retriever);
+    skeletons[i] = ::dart::utils::readSkeleton(
+          skeletonElements[i], _baseUri, _retriever);
+  });
 
-    newWorld->addSkeleton(newSkeleton);
-  }
+  newWorld->addSkeletons(skeletons);
 
   return newWorld;
 }
@@ -987,6 +1003,7 @@ dynamics::SkeletonPtr readSkeleton(
 
   //--------------------------------------------------------------------------
   // Assemble skeleton
+  newSkeleton->beginBulkConstruction();
   JointMap::iterator it = joints.find(order.begin()->second);
   BodyMap::const_iterator child;
   dynamics::BodyNode* parent;
@@ -1031,6 +1048,7 @@ dynamics::SkeletonPtr readSkeleton(
 
     it = joints.find(nextJoint->second);
   }
+  newSkeleton->endBulkConstruction();
 
   // Read aspects here since aspects cannot be added if the BodyNodes haven't
   // created yet.
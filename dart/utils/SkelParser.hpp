@@ -33,6 +33,7 @@
 #ifndef DART_UTILS_SKELPARSER_HPP_
 #define DART_UTILS_SKELPARSER_HPP_
 
+#include <cstddef>
 #include <string>
 #include "dart/common/Uri.hpp"
 #include "dart/common/LocalResourceRetriever.hpp"
@@ -45,15 +46,23 @@ namespace utils {
 namespace SkelParser {
 
   /// Read World from skel file
+  ///
+  /// The skeletons of the world are independent of each other, so they can be
+  /// built on up to numThreads threads (0 means one per hardware thread). They
+  /// are always added to the World in the order they appear in the file. The
+  /// retriever must be safe to use from several threads when numThreads is not
+  /// 1.
   simulation::WorldPtr readWorld(
     const common::Uri& uri,
-    const common::ResourceRetrieverPtr& retriever = nullptr);
+    const common::ResourceRetrieverPtr& retriever = nullptr,
+    std::size_t numThreads = 1u);
 
-  /// Read World from an xml-formatted string
+  /// Read World from an xml-formatted string. See readWorld() for numThreads.
   simulation::WorldPtr readWorldXML(
     const std::string& xmlString,
     const common::Uri& baseUri = "",
-    const common::ResourceRetrieverPtr& retriever = nullptr);
+    const common::ResourceRetrieverPtr& retriever = nullptr,
+    std::size_t numThreads = 1u);
 
   /// Read Skeleton from skel file
   dynamics::SkeletonPtr readSkeleton(
@@ -37,12 +37,14 @@
 #include <fstream>
 #include <string>
 #include <functional>
+#include <vector>
 
 #include <Eigen/Dense>
 #include <Eigen/StdVector>
 #include <tinyxml2.h>
 
 #include "dart/common/Console.hpp"
+#include "dart/common/detail/ParallelFor.hpp"
 #include "dart/common/LocalResourceRetriever.hpp"
 #include "dart/common/ResourceRetriever.hpp"
 #include "dart/common/Uri.hpp"
@@ -102,7 +104,8 @@ using JointMap = std::map<std::string, SDFJoint>;
 simulation::WorldPtr readWorld(
     tinyxml2::XMLElement* worldElement,
     const common::Uri& baseUri,
-    const common::ResourceRetrieverPtr& retriever);
+    const common::ResourceRetrieverPtr& retriever,
+    std::size_t numThreads);
 
 void readPhysics(
     tinyxml2::XMLElement* physicsElement,
@@ -254,7 +257,8 @@ simulation::WorldPtr readSdfFile(
 //==============================================================================
 simulation::WorldPtr readWorld(
     const common::Uri& uri,
-    const common::ResourceRetrieverPtr& nullOrRetriever)
+    const common::ResourceRetrieverPtr& nullOrRetriever,
+    std::size_t numThreads)
 {
   const auto retriever = getRetriever(nullOrRetriever);
 
@@ -300,7 +304,7 @@ simulation::WorldPtr readWorld(
   if (worldElement == nullptr)
     return nullptr;
 
-  return readWorld(worldElement, uri, retriever);
+  return readWorld(worldElement, uri, retriever, numThreads);
 }
 
 //==============================================================================
@@ -364,7 +368,8 @@ namespace {
 simulation::WorldPtr readWorld(
     tinyxml2::XMLElement* worldElement,
     const common::Uri& baseUri,
-    const common::ResourceRetrieverPtr& retriever)
+    const common::ResourceRetrieverPtr& retriever,
+    std::size_t numThreads)
 {
   assert(worldElement != nullptr);
 
@@ -386,14 +391,22 @@ simulation::WorldPtr readWorld(
 
   //--------------------------------------------------------------------------
   // Load skeletons
+  std::vector<tinyxml2::XMLElement*> modelElements;
   ElementEnumerator skeletonElements(worldElement, "model");
   while (skeletonElements.next())
+    modelElements.push_back(skeletonElements.get());
+
+  // Models do not refer to each other, so they are parsed (and their meshes
+  // loaded) concurrently into detached skeletons, which are then added to the
+  // world in document order.
+  std::vector<dynamics::SkeletonPtr> skeletons(modelElements.size());
+  common::detail::parallelFor(
+      modelElements.size(), numThreads, [&](std::size_t i)
   {
-    dynamics::SkeletonPtr newSkeleton
-            = readSkeleton(skeletonElements.get(), baseUri, retriever);
+    skeletons[i] = readSkeleton(modelElements[i], baseUri, retriever);
+  });
 
-    newWorld->addSkeleton(newSkeleton);
-  }
+  newWorld->addSkeletons(skeletons);
 
   return newWorld;
 }
@@ -451,6 +464,7 @@ dynamics::SkeletonPtr readSkeleton(
 
   // Iterate through the collected properties and construct the Skeleton from
   // the root nodes downward
+  newSkeleton->beginBulkConstruction();
   BodyMap::iterator body = sdfBodyNodes.begin();
   JointMap::const_iterator parentJoint;
   dynamics::BodyNode* parentBody{nullptr};
@@ -488,6 +502,7 @@ dynamics::SkeletonPtr readSkeleton(
     sdfBodyNodes.erase(body);
     body = sdfBodyNodes.begin();
   }
+  newSkeleton->endBulkConstruction();
 
   // Read aspects here since aspects cannot be added if the BodyNodes haven't
   // created yet.
@@ -33,6 +33,8 @@
 #ifndef DART_UTILS_SDFPARSER_HPP_
 #define DART_UTILS_SDFPARSER_HPP_
 
+#include <cstddef>
+
 #include "dart/common/Deprecated.hpp"
 #include "dart/common/ResourceRetriever.hpp"
 #include "dart/dynamics/Skeleton.hpp"
@@ -48,9 +50,14 @@ simulation::WorldPtr readSdfFile(
     const common::Uri& uri,
     const common::ResourceRetrieverPtr& retriever = nullptr);
 
+/// Read World from an SDF file. The models of the world are parsed on up to
+/// numThreads threads (0 means one per hardware thread) and are added to the
+/// World in the order they appear in the file. The retriever must be safe to
+/// use from several threads when numThreads is not 1.
 simulation::WorldPtr readWorld(
     const common::Uri& uri,
-    const common::ResourceRetrieverPtr& retriever = nullptr);
+    const common::ResourceRetrieverPtr& retriever = nullptr,
+    std::size_t numThreads = 1u);
 
 dynamics::SkeletonPtr readSkeleton(
     const common::Uri& uri,
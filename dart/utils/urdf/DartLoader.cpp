@@ -35,10 +35,12 @@
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #include <urdf_parser/urdf_parser.h>
 #include <urdf_world/world.h>
 
+#include "dart/common/detail/ParallelFor.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/dynamics/BodyNode.hpp"
 #include "dart/dynamics/Joint.hpp"
@@ -125,7 +127,8 @@ dynamics::SkeletonPtr DartLoader::parseSkeletonString(
 
 simulation::WorldPtr DartLoader::parseWorld(
   const common::Uri& _uri,
-  const common::ResourceRetrieverPtr& _resourceRetriever)
+  const common::ResourceRetrieverPtr& _resourceRetriever,
+  std::size_t _numThreads)
 {
   const common::ResourceRetrieverPtr resourceRetriever
     = getResourceRetriever(_resourceRetriever);
@@ -134,12 +137,13 @@ simulation::WorldPtr DartLoader::parseWorld(
   if (!readFileToString(resourceRetriever, _uri, content))
     return nullptr;
 
-  return parseWorldString(content, _uri, _resourceRetriever);
+  return parseWorldString(content, _uri, _resourceRetriever, _numThreads);
 }
 
 simulation::WorldPtr DartLoader::parseWorldString(
     const std::string& _urdfString, const common::Uri& _baseUri,
-    const common::ResourceRetrieverPtr& _resourceRetriever)
+    const common::ResourceRetrieverPtr& _resourceRetriever,
+    std::size_t _numThreads)
 {
   const common::ResourceRetrieverPtr resourceRetriever
     = getResourceRetriever(_resourceRetriever);
@@ -162,29 +166,42 @@ simulation::WorldPtr DartLoader::parseWorldString(
 
   simulation::WorldPtr world = simulation::World::create();
 
-  for(std::size_t i = 0; i < worldInterface->models.size(); ++i)
+  // The robots only share the (read-only) resource retriever, so they are
+  // converted concurrently and added to the world afterwards in the order
+  // they appear in the file.
+  std::vector<dynamics::SkeletonPtr> skeletons(worldInterface->models.size());
+  common::detail::parallelFor(
+      skeletons.size(), _numThreads, [&](std::size_t i)
   {
     const urdf_parsing::Entity& entity = worldInterface->models[i];
     dynamics::SkeletonPtr skeleton = modelInterfaceToSkeleton(
       entity.model.get(), entity.uri, resourceRetriever);
 
     if(!skeleton)
-    {
-      dtwarn << "[DartLoader::parseWorldString] Robot " << worldInterface->models[i].model->getName()
-             << " was not correctly parsed!\n";
-      continue;
-    }
+      return;
 
     // Initialize position and RPY
     dynamics::Joint* rootJoint = skeleton->getRootBodyNode()->getParentJoint();
-    Eigen::Isometry3d transform = toEigen(worldInterface->models[i].origin);
+    Eigen::Isometry3d transform = toEigen(entity.origin);
 
     if (dynamic_cast<dynamics::FreeJoint*>(rootJoint))
       rootJoint->setPositions(dynamics::FreeJoint::convertToPositions(transform));
     else
       rootJoint->setTransformFromParentBodyNode(transform);
 
-    world->addSkeleton(skeleton);
+    skeletons[i] = std::move(skeleton);
+  });
+
+  for(std::size_t i = 0; i < skeletons.size(); ++i)
+  {
+    if(!skeletons[i])
+    {
+      dtwarn << "[DartLoader::parseWorldString] Robot " << worldInterface->models[i].model->getName()
+             << " was not correctly parsed!\n";
+      continue;
+    }
+
+    world->addSkeleton(skeletons[i]);
   }
 
   return world;
@@ -197,6 +214,7 @@ dynamics::SkeletonPtr DartLoader::modelInterfaceToSkeleton(
   const common::ResourceRetrieverPtr& resourceRetriever)
 {
   dynamics::SkeletonPtr skeleton = dynamics::Skeleton::create(model->getName());
+  skeleton->beginBulkConstruction();
 
   dynamics::BodyNode* rootNode = nullptr;
   const urdf::Link* root = model->getRoot().get();
@@ -254,6 +272,8 @@ dynamics::SkeletonPtr DartLoader::modelInterfaceToSkeleton(
     }
   }
 
+  skeleton->endBulkConstruction();
+
   // Find mimic joints
   for(std::size_t i = 0; i < root->child_links.size(); i++)
     addMimicJointsRecursive(model, skeleton, root->child_links[i].get());
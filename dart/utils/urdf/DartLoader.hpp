@@ -113,14 +113,20 @@ class DartLoader {
       const std::string& _urdfString, const common::Uri& _baseUri,
       const common::ResourceRetrieverPtr& _resourceRetriever = nullptr);
 
-    /// Parse a file to produce a World
+    /// Parse a file to produce a World. The robots of the world are converted
+    /// into Skeletons on up to _numThreads threads (0 means one per hardware
+    /// thread) and are added to the World in the order they appear in the
+    /// file.
     dart::simulation::WorldPtr parseWorld(const common::Uri& _uri,
-      const common::ResourceRetrieverPtr& _resourceRetriever = nullptr);
+      const common::ResourceRetrieverPtr& _resourceRetriever = nullptr,
+      std::size_t _numThreads = 1u);
 
-    /// Parse a text string to produce a World
+    /// Parse a text string to produce a World. See parseWorld() for
+    /// _numThreads.
     dart::simulation::WorldPtr parseWorldString(
       const std::string& _urdfString, const common::Uri& _baseUri,
-      const common::ResourceRetrieverPtr& _resourceRetriever = nullptr);
+      const common::ResourceRetrieverPtr& _resourceRetriever = nullptr,
+      std::size_t _numThreads = 1u);
 
 private:
     typedef std::shared_ptr<dynamics::BodyNode::Properties> BodyPropPtr;
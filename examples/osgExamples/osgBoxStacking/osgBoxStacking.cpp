@@ -300,6 +300,8 @@ public:
       ImGui::RadioButton("Dantzig", &solverType, 1);
       ImGui::SameLine();
       ImGui::RadioButton("PGS", &solverType, 2);
+      ImGui::SameLine();
+      ImGui::RadioButton("Block PGS", &solverType, 3);
       setLcpSolver(solverType);
 
       ImGui::Text("Time: %.3f", mWorld->getTime());
@@ -375,6 +377,13 @@ protected:
           lcpSolver);
       mWorld->setConstraintSolver(std::move(solver));
     }
+    else if (solverType == 3)
+    {
+      auto lcpSolver = std::make_shared<constraint::BlockPgsBoxedLcpSolver>();
+      auto solver = common::make_unique<constraint::BoxedLcpConstraintSolver>(
+          lcpSolver);
+      mWorld->setConstraintSolver(std::move(solver));
+    }
     else
     {
       dtwarn << "Unsupported boxed-LCP solver selected: " << solverType << "\n";
@@ -0,0 +1,16 @@
+get_filename_component(example_name ${CMAKE_CURRENT_LIST_DIR} NAME)
+
+if(NOT TARGET dart-planning)
+  return()
+endif()
+
+file(GLOB srcs "*.cpp" "*.hpp")
+
+add_executable(${example_name} ${srcs})
+target_link_libraries(${example_name} dart dart-planning)
+set_target_properties(${example_name}
+  PROPERTIES
+    RUNTIME_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/bin"
+)
+
+dart_add_example(${example_name})
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <numeric>
+#include <string>
+
+#include <dart/dart.hpp>
+#include <dart/planning/planning.hpp>
+
+#include "ReferencePathFollowingTrajectory.hpp"
+
+std::list<Eigen::VectorXd> createRandomPath(std::size_t numWaypoints,
+                                            std::size_t numDofs)
+{
+  std::list<Eigen::VectorXd> waypoints;
+  for(std::size_t i=0; i<numWaypoints; ++i)
+  {
+    Eigen::VectorXd waypoint(numDofs);
+    for(std::size_t j=0; j<numDofs; ++j)
+      waypoint[j] = dart::math::Random::uniform(-1.0, 1.0);
+    waypoints.push_back(waypoint);
+  }
+
+  return waypoints;
+}
+
+struct ParameterizationResult
+{
+  double time;
+  double referenceTime;
+  double maxPositionDifference;
+};
+
+ParameterizationResult testTimeParameterizationSpeed(
+    std::size_t numWaypoints,
+    std::size_t numDofs = 7,
+    double maxDeviation = 0.1)
+{
+  const std::list<Eigen::VectorXd> waypoints
+      = createRandomPath(numWaypoints, numDofs);
+  const Eigen::VectorXd maxVelocity = Eigen::VectorXd::Constant(numDofs, 1.0);
+  const Eigen::VectorXd maxAcceleration
+      = Eigen::VectorXd::Constant(numDofs, 1.0);
+
+  ParameterizationResult result;
+  std::chrono::time_point<std::chrono::system_clock> start, end;
+
+  start = std::chrono::system_clock::now();
+  dart::planning::Path path(waypoints, maxDeviation);
+  dart::planning::PathFollowingTrajectory trajectory(
+        path, maxVelocity, maxAcceleration);
+  end = std::chrono::system_clock::now();
+  result.time = std::chrono::duration<double>(end-start).count();
+
+  start = std::chrono::system_clock::now();
+  reference::Path referencePath(waypoints, maxDeviation);
+  reference::PathFollowingTrajectory referenceTrajectory(
+        referencePath, maxVelocity, maxAcceleration);
+  end = std::chrono::system_clock::now();
+  result.referenceTime = std::chrono::duration<double>(end-start).count();
+
+  if(!trajectory.isValid() || !referenceTrajectory.isValid())
+    std::cout << "Trajectory generation failed" << std::endl;
+
+  // Both implementations have to agree on the resulting trajectory
+  result.maxPositionDifference = 0.0;
+  const double duration = std::min(
+        trajectory.getDuration(), referenceTrajectory.getDuration());
+  const std::size_t numChecks = 1000;
+  for(std::size_t i=0; i<=numChecks; ++i)
+  {
+    const double time = duration * i / numChecks;
+    result.maxPositionDifference = std::max(
+          result.maxPositionDifference,
+          (trajectory.getPosition(time)
+           - referenceTrajectory.getPosition(time)).cwiseAbs().maxCoeff());
+  }
+  result.maxPositionDifference = std::max(
+        result.maxPositionDifference,
+        std::abs(trajectory.getDuration()
+                 - referenceTrajectory.getDuration()));
+
+  return result;
+}
+
+double testSamplingSpeed(std::size_t numWaypoints,
+                         std::size_t numSamples = 100000,
+                         std::size_t numDofs = 7)
+{
+  dart::planning::Path path(createRandomPath(numWaypoints, numDofs), 0.1);
+  dart::planning::PathFollowingTrajectory trajectory(
+        path,
+        Eigen::VectorXd::Constant(numDofs, 1.0),
+        Eigen::VectorXd::Constant(numDofs, 1.0));
+
+  // Random times, as seen by controllers that sample at arbitrary times
+  Eigen::VectorXd times(numSamples);
+  for(std::size_t i=0; i<numSamples; ++i)
+    times[i] = dart::math::Random::uniform(0.0, trajectory.getDuration());
+
+  std::chrono::time_point<std::chrono::system_clock> start, end;
+  start = std::chrono::system_clock::now();
+
+  Eigen::MatrixXd positions;
+  Eigen::MatrixXd velocities;
+  trajectory.sample(times, positions, velocities);
+
+  end = std::chrono::system_clock::now();
+
+  std::chrono::duration<double> elapsed_seconds = end-start;
+  return elapsed_seconds.count();
+}
+
+void print_results(const std::vector<double>& result)
+{
+  double sum = std::accumulate(result.begin(), result.end(), 0.0);
+  double mean = sum/result.size();
+  std::cout << "Average: " << mean << "\n";
+  double sqSum = 0.0;
+  for(std::size_t i=0; i<result.size(); ++i)
+    sqSum += (result[i] - mean) * (result[i] - mean);
+  std::cout << "Std Dev: " << std::sqrt(sqSum/result.size()) << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+  std::size_t numTrials = 5;
+  if(argc > 1)
+    numTrials = std::max(1, std::atoi(argv[1]));
+
+  dart::math::Random::setSeed(0);
+
+  const std::size_t waypointCounts[] = {10, 100, 1000};
+  for(const std::size_t numWaypoints : waypointCounts)
+  {
+    std::cout << "\nRandom joint-space paths with " << numWaypoints
+              << " waypoints" << std::endl;
+
+    std::vector<double> parameterization_results;
+    std::vector<double> reference_parameterization_results;
+    std::vector<double> sampling_results;
+    double maxDifference = 0.0;
+    for(std::size_t i=0; i<numTrials; ++i)
+    {
+      const ParameterizationResult result
+          = testTimeParameterizationSpeed(numWaypoints);
+      parameterization_results.push_back(result.time);
+      reference_parameterization_results.push_back(result.referenceTime);
+      maxDifference = std::max(maxDifference, result.maxPositionDifference);
+      sampling_results.push_back(testSamplingSpeed(numWaypoints));
+    }
+
+    std::cout << "Time parameterization [s]\n";
+    print_results(parameterization_results);
+
+    std::cout << "Time parameterization, reference implementation [s]\n";
+    print_results(reference_parameterization_results);
+
+    std::cout << "Speedup: "
+              << std::accumulate(reference_parameterization_results.begin(),
+                                 reference_parameterization_results.end(), 0.0)
+                 / std::accumulate(parameterization_results.begin(),
+                                   parameterization_results.end(), 0.0)
+              << "\n";
+    std::cout << "Max difference to the reference trajectory [rad, s]: "
+              << maxDifference << "\n";
+
+    std::cout << "Sampling 100000 random times [s]\n";
+    print_results(sampling_results);
+  }
+}
@@ -9,6 +9,24 @@ extern "C" {
 
 DARTC_DECLARE_HANDLE(WorldId);
 
+/// Contact data as reported by dart_world_get_contacts(). All vectors are
+/// expressed in the world frame.
+typedef struct
+{
+  double point[3];
+  double normal[3];
+  /// Contact force acting on the first body
+  double force[3];
+  double penetration_depth;
+  /// Index of the skeleton in the world, or -1 if the contact does not involve
+  /// a skeleton of this world
+  int skeleton_index1;
+  int skeleton_index2;
+  /// Index of the body node in its skeleton, or -1
+  int body_node_index1;
+  int body_node_index2;
+} DartContact;
+
 WorldId dart_world_create(const char* name = "");
 
 void dart_world_destroy(WorldId world);
@@ -33,6 +51,48 @@ SkeletonId dart_world_get_skeleton(WorldId world, int skeletonIndex);
 
 void dart_world_remove_all_skeletons(WorldId world);
 
+void dart_world_set_time_step(WorldId world, double time_step);
+
+double dart_world_get_time_step(WorldId world);
+
+double dart_world_get_time(WorldId world);
+
+/// Steps the world num_steps times in a single call. The commands of the
+/// skeletons are cleared after every step unless reset_command is zero.
+void dart_world_step(WorldId world, int num_steps = 1, int reset_command = 1);
+
+/// Returns the total number of DOFs of all the skeletons in the world, which
+/// is the size of the buffers expected by the bulk state functions below.
+int dart_world_get_num_dofs(WorldId world);
+
+/// The bulk state functions read or write the state of all the skeletons in
+/// the world in a single call, concatenated in the order of the skeletons.
+/// They return the number of values copied, or -1 if the buffer size does not
+/// match dart_world_get_num_dofs().
+int dart_world_get_positions(WorldId world, double* positions, int size);
+
+int dart_world_set_positions(WorldId world, const double* positions, int size);
+
+int dart_world_get_velocities(WorldId world, double* velocities, int size);
+
+int dart_world_set_velocities(
+    WorldId world, const double* velocities, int size);
+
+int dart_world_get_forces(WorldId world, double* forces, int size);
+
+int dart_world_set_forces(WorldId world, const double* forces, int size);
+
+int dart_world_set_commands(WorldId world, const double* commands, int size);
+
+/// Returns the number of contacts found in the last step.
+int dart_world_get_num_contacts(WorldId world);
+
+/// Copies up to max_contacts contacts of the last step into the caller-owned
+/// buffer and returns the total number of contacts, which may be larger than
+/// max_contacts.
+int dart_world_get_contacts(
+    WorldId world, DartContact* contacts, int max_contacts);
+
 #ifdef __cplusplus
 }
 #endif
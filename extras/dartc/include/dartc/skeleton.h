@@ -19,18 +19,49 @@ int dart_skeleton_get_num_dofs(SkeletonId skel);
 void dart_skeleton_set_positions(
     SkeletonId skel, double* positions, int num_poisitions);
 
+/// Returns the positions of the skeleton. The returned array is owned by the
+/// library and stays valid until the next call to this function on the same
+/// thread. Prefer dart_skeleton_get_positions_into() for repeated queries.
 double* dart_skeleton_get_positions(SkeletonId skel);
 
+/// Copies the positions of the skeleton into the caller-owned buffer.
+/// Returns the number of values written, or -1 if num_positions does not
+/// match the number of DOFs of the skeleton.
+int dart_skeleton_get_positions_into(
+    SkeletonId skel, double* positions, int num_positions);
+
 void dart_skeleton_set_velocities(
     SkeletonId skel, double* velocities, int num_velocities);
 
+/// Returns the velocities of the skeleton. The returned array is owned by the
+/// library and stays valid until the next call to this function on the same
+/// thread.
 double* dart_skeleton_get_velocities(SkeletonId skel);
 
+/// Copies the velocities of the skeleton into the caller-owned buffer.
+/// Returns the number of values written, or -1 on size mismatch.
+int dart_skeleton_get_velocities_into(
+    SkeletonId skel, double* velocities, int num_velocities);
+
 void dart_skeleton_set_accelerations(
     SkeletonId skel, double* accelerations, int num_accelerations);
 
+/// Returns the accelerations of the skeleton. The returned array is owned by
+/// the library and stays valid until the next call to this function on the
+/// same thread.
 double* dart_skeleton_get_accelerations(SkeletonId skel);
 
+/// Copies the accelerations of the skeleton into the caller-owned buffer.
+/// Returns the number of values written, or -1 on size mismatch.
+int dart_skeleton_get_accelerations_into(
+    SkeletonId skel, double* accelerations, int num_accelerations);
+
+void dart_skeleton_set_forces(SkeletonId skel, double* forces, int num_forces);
+
+/// Copies the generalized forces of the skeleton into the caller-owned buffer.
+/// Returns the number of values written, or -1 on size mismatch.
+int dart_skeleton_get_forces_into(SkeletonId skel, double* forces, int num_forces);
+
 #ifdef __cplusplus
 }
 #endif
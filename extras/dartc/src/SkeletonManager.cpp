@@ -1,21 +1,59 @@
 #include "SkeletonManager.hpp"
 
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+using OwnerMap
+    = std::unordered_map<dart::dynamics::Skeleton*, dart::dynamics::SkeletonPtr>;
+
 //==============================================================================
-std::unordered_map<dart::dynamics::Skeleton*, dart::dynamics::SkeletonPtr>
-    SkeletonManager::mMap;
+/// Skeletons created through the C API, kept alive until destroyed. Only
+/// create() and destroy() touch it; every other call uses the handle directly.
+OwnerMap& getOwners()
+{
+  static OwnerMap owners;
+  return owners;
+}
+
+//==============================================================================
+std::mutex& getOwnersMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+} // namespace
 
 //==============================================================================
 dart::dynamics::Skeleton* SkeletonManager::create(const std::string& name)
 {
   auto skel = dart::dynamics::Skeleton::create(name);
-  mMap[skel.get()] = skel;
+  std::lock_guard<std::mutex> lock(getOwnersMutex());
+  getOwners().emplace(skel.get(), skel);
   return skel.get();
 }
 
 //==============================================================================
 void SkeletonManager::destroy(dart::dynamics::Skeleton* skel)
 {
-  mMap.erase(skel);
+  if (!skel)
+    return;
+
+  // Release the skeleton outside of the lock, since destroying it may run
+  // arbitrary destructors.
+  dart::dynamics::SkeletonPtr owner;
+  {
+    std::lock_guard<std::mutex> lock(getOwnersMutex());
+    auto& owners = getOwners();
+    const auto it = owners.find(skel);
+    if (it == owners.end())
+      return;
+
+    owner = std::move(it->second);
+    owners.erase(it);
+  }
 }
 
 //==============================================================================
@@ -28,11 +66,17 @@ void SkeletonManager::destroy(void* skel)
 dart::dynamics::SkeletonPtr SkeletonManager::asShared(
     dart::dynamics::Skeleton* skel)
 {
-  return mMap[skel];
+  // Skeletons are always owned by a shared_ptr, including the ones handed out
+  // by dart_world_get_skeleton() that never went through create(), so there
+  // is no need to look them up in the owner table.
+  if (!skel)
+    return nullptr;
+
+  return skel->getPtr();
 }
 
 //==============================================================================
 dart::dynamics::SkeletonPtr SkeletonManager::asShared(void* skel)
 {
-  return mMap[static_cast<dart::dynamics::Skeleton*>(skel)];
+  return asShared(static_cast<dart::dynamics::Skeleton*>(skel));
 }
@@ -1,7 +1,10 @@
-
-#include <unordered_map>
 #include <dart/dynamics/Skeleton.hpp>
 
+/// Owns the skeletons created through the C API. A SkeletonId is the raw
+/// Skeleton pointer, so that skeletons created with dart_skeleton_create()
+/// and the ones returned by dart_world_get_skeleton() are interchangeable and
+/// compare equal. The owning pointers are therefore kept in a table keyed by
+/// that address rather than behind the handle itself.
 struct SkeletonManager final
 {
   static dart::dynamics::Skeleton* create(const std::string& name);
@@ -14,8 +17,4 @@ struct SkeletonManager final
   static dart::dynamics::SkeletonPtr asShared(dart::dynamics::Skeleton* skel);
 
   static dart::dynamics::SkeletonPtr asShared(void* skel);
-
-  static std::unordered_map<dart::dynamics::Skeleton*,
-                            dart::dynamics::SkeletonPtr>
-      mMap;
 };
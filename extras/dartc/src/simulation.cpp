@@ -1,17 +1,106 @@
 #include "dartc/simulation.h"
 
+#include <algorithm>
+
+#include <dart/collision/CollisionObject.hpp>
+#include <dart/collision/CollisionResult.hpp>
+#include <dart/dynamics/BodyNode.hpp>
+#include <dart/dynamics/DegreeOfFreedom.hpp>
+#include <dart/dynamics/ShapeNode.hpp>
 #include <dart/simulation/World.hpp>
 #include "SkeletonManager.hpp"
 
-#ifdef __cplusplus
-extern "C" {
-#endif
-
 using namespace dart::dynamics;
 using namespace dart::simulation;
 
 #define CAST_WORLD(name) static_cast<World*>(name)
 
+namespace {
+
+//==============================================================================
+std::size_t getNumWorldDofs(const World* world)
+{
+  std::size_t numDofs = 0u;
+  for (std::size_t i = 0u; i < world->getNumSkeletons(); ++i)
+    numDofs += world->getSkeleton(i)->getNumDofs();
+
+  return numDofs;
+}
+
+//==============================================================================
+template <double (DegreeOfFreedom::*getter)() const>
+int getWorldDofValues(WorldId world, double* values, int size)
+{
+  const World* w = CAST_WORLD(world);
+  const std::size_t numDofs = getNumWorldDofs(w);
+  if (size < 0 || static_cast<std::size_t>(size) != numDofs)
+    return -1;
+
+  std::size_t index = 0u;
+  for (std::size_t i = 0u; i < w->getNumSkeletons(); ++i)
+  {
+    const Skeleton* skel = w->getSkeleton(i).get();
+    for (std::size_t j = 0u; j < skel->getNumDofs(); ++j)
+      values[index++] = (skel->getDof(j)->*getter)();
+  }
+
+  return static_cast<int>(numDofs);
+}
+
+//==============================================================================
+template <void (DegreeOfFreedom::*setter)(double)>
+int setWorldDofValues(WorldId world, const double* values, int size)
+{
+  World* w = CAST_WORLD(world);
+  const std::size_t numDofs = getNumWorldDofs(w);
+  if (size < 0 || static_cast<std::size_t>(size) != numDofs)
+    return -1;
+
+  std::size_t index = 0u;
+  for (std::size_t i = 0u; i < w->getNumSkeletons(); ++i)
+  {
+    Skeleton* skel = w->getSkeleton(i).get();
+    for (std::size_t j = 0u; j < skel->getNumDofs(); ++j)
+      (skel->getDof(j)->*setter)(values[index++]);
+  }
+
+  return static_cast<int>(numDofs);
+}
+
+//==============================================================================
+void getContactBody(
+    const World* world,
+    const dart::collision::CollisionObject* object,
+    int& skeletonIndex,
+    int& bodyNodeIndex)
+{
+  skeletonIndex = -1;
+  bodyNodeIndex = -1;
+
+  const ShapeNode* shapeNode = object->getShapeFrame()->asShapeNode();
+  if (!shapeNode)
+    return;
+
+  const BodyNode* bodyNode = shapeNode->getBodyNodePtr().get();
+  bodyNodeIndex = static_cast<int>(bodyNode->getIndexInSkeleton());
+
+  const Skeleton* skel = bodyNode->getSkeleton().get();
+  for (std::size_t i = 0u; i < world->getNumSkeletons(); ++i)
+  {
+    if (world->getSkeleton(i).get() == skel)
+    {
+      skeletonIndex = static_cast<int>(i);
+      return;
+    }
+  }
+}
+
+} // namespace
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 //==============================================================================
 WorldId dart_world_create(const char* name)
 {
@@ -87,6 +176,124 @@ void dart_world_remove_all_skeletons(WorldId world)
   CAST_WORLD(world)->removeAllSkeletons();
 }
 
+//==============================================================================
+void dart_world_set_time_step(WorldId world, double time_step)
+{
+  CAST_WORLD(world)->setTimeStep(time_step);
+}
+
+//==============================================================================
+double dart_world_get_time_step(WorldId world)
+{
+  return CAST_WORLD(world)->getTimeStep();
+}
+
+//==============================================================================
+double dart_world_get_time(WorldId world)
+{
+  return CAST_WORLD(world)->getTime();
+}
+
+//==============================================================================
+void dart_world_step(WorldId world, int num_steps, int reset_command)
+{
+  World* w = CAST_WORLD(world);
+  for (int i = 0; i < num_steps; ++i)
+    w->step(reset_command != 0);
+}
+
+//==============================================================================
+int dart_world_get_num_dofs(WorldId world)
+{
+  return static_cast<int>(getNumWorldDofs(CAST_WORLD(world)));
+}
+
+//==============================================================================
+int dart_world_get_positions(WorldId world, double* positions, int size)
+{
+  return getWorldDofValues<&DegreeOfFreedom::getPosition>(
+      world, positions, size);
+}
+
+//==============================================================================
+int dart_world_set_positions(WorldId world, const double* positions, int size)
+{
+  return setWorldDofValues<&DegreeOfFreedom::setPosition>(
+      world, positions, size);
+}
+
+//==============================================================================
+int dart_world_get_velocities(WorldId world, double* velocities, int size)
+{
+  return getWorldDofValues<&DegreeOfFreedom::getVelocity>(
+      world, velocities, size);
+}
+
+//==============================================================================
+int dart_world_set_velocities(
+    WorldId world, const double* velocities, int size)
+{
+  return setWorldDofValues<&DegreeOfFreedom::setVelocity>(
+      world, velocities, size);
+}
+
+//==============================================================================
+int dart_world_get_forces(WorldId world, double* forces, int size)
+{
+  return getWorldDofValues<&DegreeOfFreedom::getForce>(world, forces, size);
+}
+
+//==============================================================================
+int dart_world_set_forces(WorldId world, const double* forces, int size)
+{
+  return setWorldDofValues<&DegreeOfFreedom::setForce>(world, forces, size);
+}
+
+//==============================================================================
+int dart_world_set_commands(WorldId world, const double* commands, int size)
+{
+  return setWorldDofValues<&DegreeOfFreedom::setCommand>(
+      world, commands, size);
+}
+
+//==============================================================================
+int dart_world_get_num_contacts(WorldId world)
+{
+  return static_cast<int>(
+      CAST_WORLD(world)->getLastCollisionResult().getNumContacts());
+}
+
+//==============================================================================
+int dart_world_get_contacts(
+    WorldId world, DartContact* contacts, int max_contacts)
+{
+  const World* w = CAST_WORLD(world);
+  const auto& result = w->getLastCollisionResult().getContacts();
+  const std::size_t numCopies = std::min(
+      result.size(), static_cast<std::size_t>(std::max(max_contacts, 0)));
+
+  for (std::size_t i = 0u; i < numCopies; ++i)
+  {
+    const dart::collision::Contact& contact = result[i];
+    DartContact& out = contacts[i];
+
+    for (int j = 0; j < 3; ++j)
+    {
+      out.point[j] = contact.point[j];
+      out.normal[j] = contact.normal[j];
+      out.force[j] = contact.force[j];
+    }
+    out.penetration_depth = contact.penetrationDepth;
+
+    getContactBody(
+        w, contact.collisionObject1, out.skeleton_index1, out.body_node_index1);
+    getContactBody(
+        w, contact.collisionObject2, out.skeleton_index2, out.body_node_index2);
+  }
+
+  return static_cast<int>(result.size());
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,19 +1,52 @@
 #include "dartc/skeleton.h"
 
-#include <unordered_map>
+#include <vector>
 
+#include <dart/dynamics/DegreeOfFreedom.hpp>
 #include <dart/dynamics/Skeleton.hpp>
 
 #include "SkeletonManager.hpp"
 
 #define CAST_SKELETON(name) static_cast<Skeleton*>(name)
 
+using namespace dart::dynamics;
+
+namespace {
+
+//==============================================================================
+template <double (DegreeOfFreedom::*getter)() const>
+int copyDofValues(SkeletonId skel, double* values, int numValues)
+{
+  const Skeleton* skeleton = CAST_SKELETON(skel);
+  const std::size_t numDofs = skeleton->getNumDofs();
+  if (numValues < 0 || static_cast<std::size_t>(numValues) != numDofs)
+    return -1;
+
+  for (std::size_t i = 0u; i < numDofs; ++i)
+    values[i] = (skeleton->getDof(i)->*getter)();
+
+  return static_cast<int>(numDofs);
+}
+
+//==============================================================================
+template <double (DegreeOfFreedom::*getter)() const>
+double* copyDofValuesToThreadBuffer(SkeletonId skel)
+{
+  // The values of a skeleton are stored per joint, so there is no contiguous
+  // array we could hand out. Copy them into a thread local buffer instead of
+  // returning the data of a temporary.
+  thread_local std::vector<double> buffer;
+  buffer.resize(CAST_SKELETON(skel)->getNumDofs());
+  copyDofValues<getter>(skel, buffer.data(), static_cast<int>(buffer.size()));
+  return buffer.data();
+}
+
+} // namespace
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-using namespace dart::dynamics;
-
 //==============================================================================
 SkeletonId dart_skeleton_create(const char* name)
 {
@@ -50,7 +83,14 @@ void dart_skeleton_set_positions(
 //==============================================================================
 double* dart_skeleton_get_positions(SkeletonId skel)
 {
-  return CAST_SKELETON(skel)->getPositions().data();
+  return copyDofValuesToThreadBuffer<&DegreeOfFreedom::getPosition>(skel);
+}
+
+//==============================================================================
+int dart_skeleton_get_positions_into(
+    SkeletonId skel, double* positions, int num_positions)
+{
+  return copyDofValues<&DegreeOfFreedom::getPosition>(skel, positions, num_positions);
 }
 
 //==============================================================================
@@ -64,7 +104,14 @@ void dart_skeleton_set_velocities(
 //==============================================================================
 double* dart_skeleton_get_velocities(SkeletonId skel)
 {
-  return CAST_SKELETON(skel)->getVelocities().data();
+  return copyDofValuesToThreadBuffer<&DegreeOfFreedom::getVelocity>(skel);
+}
+
+//==============================================================================
+int dart_skeleton_get_velocities_into(
+    SkeletonId skel, double* velocities, int num_velocities)
+{
+  return copyDofValues<&DegreeOfFreedom::getVelocity>(skel, velocities, num_velocities);
 }
 
 //==============================================================================
@@ -79,7 +126,27 @@ void dart_skeleton_set_accelerations(
 //==============================================================================
 double* dart_skeleton_get_accelerations(SkeletonId skel)
 {
-  return CAST_SKELETON(skel)->getAccelerations().data();
+  return copyDofValuesToThreadBuffer<&DegreeOfFreedom::getAcceleration>(skel);
+}
+
+//==============================================================================
+int dart_skeleton_get_accelerations_into(
+    SkeletonId skel, double* accelerations, int num_accelerations)
+{
+  return copyDofValues<&DegreeOfFreedom::getAcceleration>(skel, accelerations, num_accelerations);
+}
+
+//==============================================================================
+void dart_skeleton_set_forces(SkeletonId skel, double* forces, int num_forces)
+{
+  const Eigen::Map<Eigen::VectorXd> eigForces(forces, num_forces);
+  CAST_SKELETON(skel)->setForces(eigForces);
+}
+
+//==============================================================================
+int dart_skeleton_get_forces_into(SkeletonId skel, double* forces, int num_forces)
+{
+  return copyDofValues<&DegreeOfFreedom::getForce>(skel, forces, num_forces);
 }
 
 #ifdef __cplusplus
@@ -1,4 +1,9 @@
+#include <vector>
 #include <gtest/gtest.h>
+#include <dart/dynamics/BoxShape.hpp>
+#include <dart/dynamics/FreeJoint.hpp>
+#include <dart/dynamics/Skeleton.hpp>
+#include <dart/dynamics/WeldJoint.hpp>
 #include "dartc/skeleton.h"
 #include "dartc/simulation.h"
 
@@ -39,3 +44,76 @@ GTEST_TEST(dartc_simulation, set_get_gravity)
   EXPECT_DOUBLE_EQ(dart_world_get_gravity_z(world), 3);
   dart_world_destroy(world);
 }
+
+//==============================================================================
+SkeletonId createBox(const char* name, const Eigen::Vector3d& size, bool fixed)
+{
+  using namespace dart::dynamics;
+
+  SkeletonId skelId = dart_skeleton_create(name);
+  auto skel = static_cast<Skeleton*>(skelId);
+
+  BodyNode* body
+      = fixed ? skel->createJointAndBodyNodePair<WeldJoint>().second
+              : skel->createJointAndBodyNodePair<FreeJoint>().second;
+  body->createShapeNodeWith<CollisionAspect, DynamicsAspect>(
+      std::make_shared<BoxShape>(size));
+
+  return skelId;
+}
+
+//==============================================================================
+GTEST_TEST(dartc_simulation, bulk_state_and_contacts)
+{
+  WorldId world = dart_world_create();
+  SkeletonId ground
+      = createBox("ground", Eigen::Vector3d(10.0, 10.0, 0.1), true);
+  SkeletonId box = createBox("box", Eigen::Vector3d(0.5, 0.5, 0.5), false);
+  dart_world_add_skeleton(world, ground);
+  dart_world_add_skeleton(world, box);
+  EXPECT_EQ(dart_world_get_skeleton(world, 1), box);
+
+  const int numDofs = dart_world_get_num_dofs(world);
+  ASSERT_EQ(numDofs, 6);
+
+  std::vector<double> q(numDofs, 0.0);
+  q[5] = 0.5;
+  EXPECT_EQ(dart_world_set_positions(world, q.data(), numDofs), numDofs);
+  EXPECT_EQ(dart_world_set_positions(world, q.data(), numDofs - 1), -1);
+
+  std::vector<double> buffer(numDofs);
+  EXPECT_EQ(dart_world_get_positions(world, buffer.data(), numDofs), numDofs);
+  EXPECT_DOUBLE_EQ(buffer[5], 0.5);
+
+  // Let the box fall onto the ground
+  dart_world_set_time_step(world, 0.001);
+  dart_world_step(world, 500);
+  EXPECT_NEAR(dart_world_get_time(world), 0.5, 1e-9);
+
+  EXPECT_EQ(dart_world_get_positions(world, buffer.data(), numDofs), numDofs);
+  EXPECT_LT(buffer[5], 0.5);
+  EXPECT_EQ(
+      dart_world_get_velocities(world, buffer.data(), numDofs), numDofs);
+
+  const int numContacts = dart_world_get_num_contacts(world);
+  ASSERT_GT(numContacts, 0);
+
+  std::vector<DartContact> contacts(numContacts);
+  EXPECT_EQ(
+      dart_world_get_contacts(world, contacts.data(), numContacts),
+      numContacts);
+  EXPECT_EQ(dart_world_get_contacts(world, nullptr, 0), numContacts);
+  for (const DartContact& contact : contacts)
+  {
+    EXPECT_NEAR(std::abs(contact.normal[2]), 1.0, 1e-6);
+    EXPECT_TRUE(contact.skeleton_index1 == 0 || contact.skeleton_index1 == 1);
+    EXPECT_TRUE(contact.skeleton_index2 == 0 || contact.skeleton_index2 == 1);
+    EXPECT_NE(contact.skeleton_index1, contact.skeleton_index2);
+    EXPECT_EQ(contact.body_node_index1, 0);
+    EXPECT_EQ(contact.body_node_index2, 0);
+  }
+
+  dart_world_destroy(world);
+  dart_skeleton_destroy(ground);
+  dart_skeleton_destroy(box);
+}
@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <dart/dynamics/FreeJoint.hpp>
+#include <dart/dynamics/Skeleton.hpp>
 #include "dartc/skeleton.h"
 
 GTEST_TEST(dartc_skeleton, dart_skeleton_create)
@@ -9,3 +11,40 @@ GTEST_TEST(dartc_skeleton, dart_skeleton_create)
   EXPECT_TRUE(dart_skeleton_get_num_dofs(skel) == 0);
   dart_skeleton_destroy(skel);
 }
+
+//==============================================================================
+GTEST_TEST(dartc_skeleton, get_state_into_caller_buffers)
+{
+  SkeletonId skel = dart_skeleton_create();
+  static_cast<dart::dynamics::Skeleton*>(skel)
+      ->createJointAndBodyNodePair<dart::dynamics::FreeJoint>();
+  ASSERT_EQ(dart_skeleton_get_num_dofs(skel), 6);
+
+  double positions[6] = {0.1, 0.2, 0.3, 1.0, 2.0, 3.0};
+  dart_skeleton_set_positions(skel, positions, 6);
+  double velocities[6] = {-1.0, -2.0, -3.0, -4.0, -5.0, -6.0};
+  dart_skeleton_set_velocities(skel, velocities, 6);
+
+  double buffer[6];
+  EXPECT_EQ(dart_skeleton_get_positions_into(skel, buffer, 6), 6);
+  for (int i = 0; i < 6; ++i)
+    EXPECT_DOUBLE_EQ(buffer[i], positions[i]);
+
+  EXPECT_EQ(dart_skeleton_get_velocities_into(skel, buffer, 6), 6);
+  for (int i = 0; i < 6; ++i)
+    EXPECT_DOUBLE_EQ(buffer[i], velocities[i]);
+
+  // Mismatching buffer sizes are rejected
+  EXPECT_EQ(dart_skeleton_get_positions_into(skel, buffer, 5), -1);
+
+  // The pointer returned by the legacy getters must remain readable
+  const double* legacyPositions = dart_skeleton_get_positions(skel);
+  const double* legacyVelocities = dart_skeleton_get_velocities(skel);
+  for (int i = 0; i < 6; ++i)
+  {
+    EXPECT_DOUBLE_EQ(legacyPositions[i], positions[i]);
+    EXPECT_DOUBLE_EQ(legacyVelocities[i], velocities[i]);
+  }
+
+  dart_skeleton_destroy(skel);
+}
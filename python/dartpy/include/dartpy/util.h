@@ -31,6 +31,23 @@ void discard_method_return(T *instance, Args&&... args)
     (instance->*fn)(std::forward<Args>(args)...);
 }
 
+// Releases the GIL for the lifetime of this object, so that other Python
+// threads can run while a long C++ call (e.g., World::step) is in progress.
+// Nothing that touches Python objects may be called while it is alive.
+class scoped_gil_release
+{
+public:
+    scoped_gil_release() : state_(PyEval_SaveThread()) {}
+
+    ~scoped_gil_release() { PyEval_RestoreThread(state_); }
+
+    scoped_gil_release(const scoped_gil_release&) = delete;
+    scoped_gil_release& operator=(const scoped_gil_release&) = delete;
+
+private:
+    PyThreadState* state_;
+};
+
 // from_python converter for iterable collections. The container_type must
 // have: (1) have a container_type::value_type typedef and (2) a constructor
 // that accepts two forward_iterator<container_type::value_type>.
@@ -0,0 +1,388 @@
+#include <dartpy/pointers.h>
+#include <dartpy/util.h>
+#include <dart/dart.hpp>
+
+/* precontent */
+#include <boost/python.hpp>
+
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+
+/* postinclude */
+
+namespace {
+
+using dart::python::util::scoped_gil_release;
+
+//==============================================================================
+// Makes the NumPy C API available to this translation unit. import_array() is a
+// macro that returns on failure, so it needs a function of its own.
+#if PY_MAJOR_VERSION >= 3
+void* import_numpy()
+{
+  import_array();
+  return nullptr;
+}
+#else
+void import_numpy()
+{
+  import_array();
+}
+#endif
+
+//==============================================================================
+// Returns a read-only NumPy array that references the column-major data of
+// matrix without copying it. The array keeps owner alive, and reflects the
+// content of matrix for as long as matrix is not resized or destroyed. NumPy
+// reads the memory directly, so nothing can check this on access; see
+// kViewDoc for what the Python side is told.
+template <typename Derived>
+boost::python::object make_view(
+  const Eigen::PlainObjectBase<Derived>& matrix,
+  const boost::python::object& owner)
+{
+  const bool isVector = (Derived::ColsAtCompileTime == 1);
+
+  npy_intp dims[2] = {matrix.rows(), matrix.cols()};
+  npy_intp strides[2] = {
+    static_cast<npy_intp>(sizeof(double)),
+    static_cast<npy_intp>(matrix.outerStride() * sizeof(double))};
+
+  PyObject* array = PyArray_New(
+    &PyArray_Type, isVector ? 1 : 2, dims, NPY_DOUBLE, strides,
+    const_cast<double*>(matrix.data()), 0, 0, nullptr);
+  if (!array)
+    boost::python::throw_error_already_set();
+
+  // PyArray_SetBaseObject steals a reference
+  Py_INCREF(owner.ptr());
+  if (PyArray_SetBaseObject(
+        reinterpret_cast<PyArrayObject*>(array), owner.ptr()) < 0)
+  {
+    Py_DECREF(array);
+    boost::python::throw_error_already_set();
+  }
+
+  return boost::python::object(boost::python::handle<>(array));
+}
+
+//==============================================================================
+// Returns the data of a contiguous float64 NumPy array with the given number
+// of elements, or raises a ValueError if array is not one.
+double* get_buffer(
+  const boost::python::object& array, std::size_t size, bool writeable)
+{
+  PyObject* object = array.ptr();
+  if (!PyArray_Check(object))
+  {
+    PyErr_SetString(PyExc_TypeError, "Expected a numpy.ndarray");
+    boost::python::throw_error_already_set();
+  }
+
+  PyArrayObject* ndarray = reinterpret_cast<PyArrayObject*>(object);
+  const bool valid = PyArray_TYPE(ndarray) == NPY_DOUBLE
+    && (writeable ? PyArray_ISCARRAY(ndarray) : PyArray_ISCARRAY_RO(ndarray))
+    && static_cast<std::size_t>(PyArray_SIZE(ndarray)) == size;
+  if (!valid)
+  {
+    const std::string message = std::string("Expected a C-contiguous")
+      + (writeable ? ", writeable" : "") + " float64 array with "
+      + std::to_string(size) + " elements";
+    PyErr_SetString(PyExc_ValueError, message.c_str());
+    boost::python::throw_error_already_set();
+  }
+
+  return static_cast<double*>(PyArray_DATA(ndarray));
+}
+
+//==============================================================================
+std::size_t getNumDofs(const dart::simulation::World& world)
+{
+  std::size_t numDofs = 0u;
+  for (std::size_t i = 0u; i < world.getNumSkeletons(); ++i)
+    numDofs += world.getSkeleton(i)->getNumDofs();
+
+  return numDofs;
+}
+
+//==============================================================================
+// Copies a per-DOF quantity of skeleton into data, which must have room for
+// all of its DOFs
+template <double (dart::dynamics::DegreeOfFreedom::*Getter)() const>
+void readDofs(const dart::dynamics::Skeleton& skeleton, double* data)
+{
+  for (std::size_t i = 0u; i < skeleton.getNumDofs(); ++i)
+    data[i] = (skeleton.getDof(i)->*Getter)();
+}
+
+//==============================================================================
+template <void (dart::dynamics::DegreeOfFreedom::*Setter)(double)>
+void writeDofs(dart::dynamics::Skeleton& skeleton, const double* data)
+{
+  for (std::size_t i = 0u; i < skeleton.getNumDofs(); ++i)
+    (skeleton.getDof(i)->*Setter)(data[i]);
+}
+
+//==============================================================================
+template <double (dart::dynamics::DegreeOfFreedom::*Getter)() const>
+void Skeleton_readInto(
+  const dart::dynamics::Skeleton* skeleton, boost::python::object out)
+{
+  readDofs<Getter>(*skeleton, get_buffer(out, skeleton->getNumDofs(), true));
+}
+
+//==============================================================================
+template <void (dart::dynamics::DegreeOfFreedom::*Setter)(double)>
+void Skeleton_writeFrom(
+  dart::dynamics::Skeleton* skeleton, boost::python::object values)
+{
+  writeDofs<Setter>(
+    *skeleton, get_buffer(values, skeleton->getNumDofs(), false));
+}
+
+//==============================================================================
+// Copies a per-DOF quantity of all the skeletons of world into out, one
+// skeleton after the other in the order of World::getSkeleton()
+template <double (dart::dynamics::DegreeOfFreedom::*Getter)() const>
+void World_readInto(
+  const dart::simulation::World* world, boost::python::object out)
+{
+  double* data = get_buffer(out, getNumDofs(*world), true);
+  for (std::size_t i = 0u; i < world->getNumSkeletons(); ++i)
+  {
+    const dart::dynamics::Skeleton& skeleton = *world->getSkeleton(i);
+    readDofs<Getter>(skeleton, data);
+    data += skeleton.getNumDofs();
+  }
+}
+
+//==============================================================================
+template <void (dart::dynamics::DegreeOfFreedom::*Setter)(double)>
+void World_writeFrom(
+  dart::simulation::World* world, boost::python::object values)
+{
+  const double* data = get_buffer(values, getNumDofs(*world), false);
+  for (std::size_t i = 0u; i < world->getNumSkeletons(); ++i)
+  {
+    dart::dynamics::Skeleton& skeleton = *world->getSkeleton(i);
+    writeDofs<Setter>(skeleton, data);
+    data += skeleton.getNumDofs();
+  }
+}
+
+//==============================================================================
+// Docstring of the methods that return views made by make_view()
+const char* const kViewDoc
+  = "Returns a read-only numpy array that references the data of the C++ "
+    "object without copying it.\n\n"
+    "The array keeps the object alive, but it is only valid until the next "
+    "structural change of the Skeleton. Adding or removing BodyNodes or "
+    "DegreesOfFreedom reallocates the data, after which the array reads "
+    "freed memory. Call this method again after such a change, and use "
+    "numpy.array(view) to keep a copy that outlives it.\n\n"
+    "The content is recomputed lazily, like the C++ getter, so call this "
+    "method again after changing the state of the Skeleton.";
+
+//==============================================================================
+// Removes the bindings that chimera generated for name, so that the overloads
+// added by add_method() are the only ones.
+void remove_method(boost::python::object& cls, const char* name)
+{
+  if (PyObject_HasAttrString(cls.ptr(), name)
+      && PyObject_DelAttrString(cls.ptr(), name) < 0)
+    boost::python::throw_error_already_set();
+}
+
+//==============================================================================
+template <typename Fn, typename... Keywords>
+void add_method(
+  boost::python::object& cls, const char* name, Fn fn,
+  const Keywords&... keywords)
+{
+  boost::python::objects::add_to_namespace(
+    cls, name, boost::python::make_function(
+      fn, boost::python::default_call_policies(), keywords...));
+}
+
+//==============================================================================
+// Adds a method that returns a view made by make_view(), with kViewDoc as its
+// docstring
+template <typename Fn>
+void add_view_method(boost::python::object& cls, const char* name, Fn fn)
+{
+  boost::python::objects::add_to_namespace(
+    cls, name, boost::python::make_function(fn), kViewDoc);
+}
+
+} // namespace
+
+void state_views()
+{
+  using dart::dynamics::DegreeOfFreedom;
+  using boost::python::arg;
+  using boost::python::object;
+
+  import_numpy();
+
+  object scope = ::boost::python::scope();
+
+  //----------------------------------------------------------------------------
+  // dart::dynamics::Skeleton
+  //----------------------------------------------------------------------------
+  object skeleton = scope.attr("dynamics").attr("Skeleton");
+
+  add_method(skeleton, "getPositionsInto",
+    &Skeleton_readInto<&DegreeOfFreedom::getPosition>, (arg("out")));
+  add_method(skeleton, "getVelocitiesInto",
+    &Skeleton_readInto<&DegreeOfFreedom::getVelocity>, (arg("out")));
+  add_method(skeleton, "getForcesInto",
+    &Skeleton_readInto<&DegreeOfFreedom::getForce>, (arg("out")));
+  add_method(skeleton, "setPositionsFrom",
+    &Skeleton_writeFrom<&DegreeOfFreedom::setPosition>, (arg("positions")));
+  add_method(skeleton, "setVelocitiesFrom",
+    &Skeleton_writeFrom<&DegreeOfFreedom::setVelocity>, (arg("velocities")));
+  add_method(skeleton, "setForcesFrom",
+    &Skeleton_writeFrom<&DegreeOfFreedom::setForce>, (arg("forces")));
+  add_method(skeleton, "setCommandsFrom",
+    &Skeleton_writeFrom<&DegreeOfFreedom::setCommand>, (arg("commands")));
+
+  // The views are recomputed lazily like their Eigen counterparts, so the
+  // getter has to be called again after the state changes; it does not copy.
+  add_view_method(skeleton, "getMassMatrixView", +[](object self) -> object {
+    const dart::dynamics::Skeleton& s
+      = boost::python::extract<const dart::dynamics::Skeleton&>(self);
+    return make_view(s.getMassMatrix(), self);
+  });
+  add_view_method(skeleton, "getInvMassMatrixView", +[](object self) -> object {
+    const dart::dynamics::Skeleton& s
+      = boost::python::extract<const dart::dynamics::Skeleton&>(self);
+    return make_view(s.getInvMassMatrix(), self);
+  });
+  add_view_method(skeleton, "getCoriolisAndGravityForcesView",
+    +[](object self) -> object {
+      const dart::dynamics::Skeleton& s
+        = boost::python::extract<const dart::dynamics::Skeleton&>(self);
+      return make_view(s.getCoriolisAndGravityForces(), self);
+    });
+
+  //----------------------------------------------------------------------------
+  // dart::dynamics::BodyNode
+  //----------------------------------------------------------------------------
+  object bodyNode = scope.attr("dynamics").attr("BodyNode");
+
+  add_view_method(bodyNode, "getJacobianView", +[](object self) -> object {
+    const dart::dynamics::BodyNode& bn
+      = boost::python::extract<const dart::dynamics::BodyNode&>(self);
+    return make_view(bn.getJacobian(), self);
+  });
+  add_view_method(bodyNode, "getWorldJacobianView", +[](object self) -> object {
+    const dart::dynamics::BodyNode& bn
+      = boost::python::extract<const dart::dynamics::BodyNode&>(self);
+    return make_view(bn.getWorldJacobian(), self);
+  });
+
+  //----------------------------------------------------------------------------
+  // dart::simulation::World
+  //----------------------------------------------------------------------------
+  object world = scope.attr("simulation").attr("World");
+
+  remove_method(world, "step");
+  add_method(world, "step", +[](dart::simulation::World* self) {
+    scoped_gil_release release;
+    self->step();
+  });
+  add_method(world, "step",
+    +[](dart::simulation::World* self, bool resetCommand) {
+      scoped_gil_release release;
+      self->step(resetCommand);
+    }, (arg("resetCommand")));
+
+  add_method(world, "getNumDofs",
+    +[](const dart::simulation::World* self) -> std::size_t {
+      return getNumDofs(*self);
+    });
+  add_method(world, "getPositionsInto",
+    &World_readInto<&DegreeOfFreedom::getPosition>, (arg("out")));
+  add_method(world, "getVelocitiesInto",
+    &World_readInto<&DegreeOfFreedom::getVelocity>, (arg("out")));
+  add_method(world, "setPositionsFrom",
+    &World_writeFrom<&DegreeOfFreedom::setPosition>, (arg("positions")));
+  add_method(world, "setVelocitiesFrom",
+    &World_writeFrom<&DegreeOfFreedom::setVelocity>, (arg("velocities")));
+  add_method(world, "setCommandsFrom",
+    &World_writeFrom<&DegreeOfFreedom::setCommand>, (arg("commands")));
+
+  //----------------------------------------------------------------------------
+  // dart::collision::CollisionGroup
+  //----------------------------------------------------------------------------
+  object collisionGroup = scope.attr("collision").attr("CollisionGroup");
+
+  remove_method(collisionGroup, "collide");
+  add_method(collisionGroup, "collide",
+    +[](dart::collision::CollisionGroup* self) -> bool {
+      scoped_gil_release release;
+      return self->collide();
+    });
+  add_method(collisionGroup, "collide",
+    +[](dart::collision::CollisionGroup* self,
+        const dart::collision::CollisionOption& option,
+        dart::collision::CollisionResult* result) -> bool {
+      scoped_gil_release release;
+      return self->collide(option, result);
+    }, (arg("option"), arg("result") = object()));
+  add_method(collisionGroup, "collide",
+    +[](dart::collision::CollisionGroup* self,
+        dart::collision::CollisionGroup* otherGroup,
+        const dart::collision::CollisionOption& option,
+        dart::collision::CollisionResult* result) -> bool {
+      scoped_gil_release release;
+      return self->collide(otherGroup, option, result);
+    }, (arg("otherGroup"), arg("option"), arg("result") = object()));
+
+  remove_method(collisionGroup, "distance");
+  add_method(collisionGroup, "distance",
+    +[](dart::collision::CollisionGroup* self) -> double {
+      scoped_gil_release release;
+      return self->distance();
+    });
+  add_method(collisionGroup, "distance",
+    +[](dart::collision::CollisionGroup* self,
+        const dart::collision::DistanceOption& option,
+        dart::collision::DistanceResult* result) -> double {
+      scoped_gil_release release;
+      return self->distance(option, result);
+    }, (arg("option"), arg("result") = object()));
+  add_method(collisionGroup, "distance",
+    +[](dart::collision::CollisionGroup* self,
+        dart::collision::CollisionGroup* otherGroup,
+        const dart::collision::DistanceOption& option,
+        dart::collision::DistanceResult* result) -> double {
+      scoped_gil_release release;
+      return self->distance(otherGroup, option, result);
+    }, (arg("otherGroup"), arg("option"), arg("result") = object()));
+
+  //----------------------------------------------------------------------------
+  // dart::dynamics::InverseKinematics and dart::dynamics::HierarchicalIK
+  //----------------------------------------------------------------------------
+  object ik = scope.attr("dynamics").attr("InverseKinematics");
+
+  remove_method(ik, "solveAndApply");
+  add_method(ik, "solveAndApply",
+    +[](dart::dynamics::InverseKinematics* self,
+        bool allowIncompleteResult) -> bool {
+      scoped_gil_release release;
+      return self->solveAndApply(allowIncompleteResult);
+    }, (arg("allowIncompleteResult") = true));
+
+  object hierarchicalIK = scope.attr("dynamics").attr("HierarchicalIK");
+
+  remove_method(hierarchicalIK, "solveAndApply");
+  add_method(hierarchicalIK, "solveAndApply",
+    +[](dart::dynamics::HierarchicalIK* self,
+        bool allowIncompleteResult) -> bool {
+      scoped_gil_release release;
+      return self->solveAndApply(allowIncompleteResult);
+    }, (arg("allowIncompleteResult") = true));
+}
+
+/* footer */
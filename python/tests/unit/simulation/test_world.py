@@ -1,7 +1,15 @@
+import gc
 import platform
+import threading
+import time
+import weakref
+import numpy as np
 import pytest
+import dartpy
 from dartpy.simulation import World
 
+from tests.util import get_asset_path
+
 
 def test_empty_world():
     world = World.create()
@@ -9,5 +17,141 @@ def test_empty_world():
     assert world.getNumSimpleFrames() is 0
 
 
+
+def test_bulk_state_access():
+    world = dartpy.utils.skel.readWorld(get_asset_path('skel/cubes.skel'))
+    num_dofs = world.getNumDofs()
+    assert num_dofs > 0
+
+    positions = np.linspace(0.0, 1.0, num_dofs)
+    world.setPositionsFrom(positions)
+    out = np.empty(num_dofs)
+    world.getPositionsInto(out)
+    assert np.allclose(out, positions)
+
+    # The state of the world is the state of its skeletons, one after another
+    offset = 0
+    for i in range(world.getNumSkeletons()):
+        skel = world.getSkeleton(i)
+        skel_positions = np.empty(skel.getNumDofs())
+        skel.getPositionsInto(skel_positions)
+        assert np.allclose(
+            skel_positions, positions[offset:offset + skel.getNumDofs()])
+        offset += skel.getNumDofs()
+
+    with pytest.raises(ValueError):
+        world.getPositionsInto(np.empty(num_dofs + 1))
+    with pytest.raises(ValueError):
+        world.getVelocitiesInto(np.empty(num_dofs, dtype=np.float32))
+
+
+def test_state_views():
+    world = dartpy.utils.skel.readWorld(get_asset_path('skel/cubes.skel'))
+
+    # A clone is not owned by the world, so only the views can keep it alive
+    skel = world.getSkeleton(1).clone()
+    expected = np.array(skel.getMassMatrix())
+
+    mass_matrix = skel.getMassMatrixView()
+    assert mass_matrix.shape == (skel.getNumDofs(), skel.getNumDofs())
+    assert not mass_matrix.flags.writeable
+
+    jacobian = skel.getBodyNode(0).getWorldJacobianView()
+    assert jacobian.shape == (6, skel.getNumDofs())
+
+    skel_ref = weakref.ref(skel)
+    del skel
+    del world
+    gc.collect()
+
+    # The views keep the skeleton alive
+    assert skel_ref() is not None
+    assert np.allclose(mass_matrix, expected)
+    assert np.all(np.isfinite(jacobian))
+
+    del mass_matrix
+    del jacobian
+    gc.collect()
+    assert skel_ref() is None
+
+
+def test_state_views_after_structural_change():
+    world = dartpy.utils.skel.readWorld(get_asset_path('skel/cubes.skel'))
+    skel = world.getSkeleton(1)
+    other = world.getSkeleton(2)
+    num_dofs = skel.getNumDofs()
+
+    # A view does not survive structural changes, which its docstring says
+    for getter in (skel.getMassMatrixView,
+                   skel.getBodyNode(0).getWorldJacobianView):
+        assert 'structural change' in getter.__doc__
+
+    mass_matrix = skel.getMassMatrixView()
+    saved = np.array(mass_matrix)
+    assert mass_matrix.shape == (num_dofs, num_dofs)
+    del mass_matrix
+
+    # Moving the BodyNodes of another skeleton into this one adds DOFs, so the
+    # view has to be taken again
+    other.getRootBodyNode().moveTo(skel.getRootBodyNode())
+    assert skel.getNumDofs() > num_dofs
+
+    mass_matrix = skel.getMassMatrixView()
+    assert mass_matrix.shape == (skel.getNumDofs(), skel.getNumDofs())
+    assert np.allclose(mass_matrix, skel.getMassMatrix())
+
+    # The copy is unaffected
+    assert saved.shape == (num_dofs, num_dofs)
+    assert np.all(np.isfinite(saved))
+
+
+def _count_progress_during(call):
+    """Returns how fast another Python thread makes progress, in iterations per
+    second, while call() runs on this thread."""
+    counter = [0]
+    started = threading.Event()
+    done = threading.Event()
+
+    def count():
+        started.set()
+        while not done.is_set():
+            counter[0] += 1
+            # Yield the GIL on every iteration, so that the main thread gets
+            # it back as soon as it needs it
+            time.sleep(0)
+
+    thread = threading.Thread(target=count)
+    thread.start()
+    started.wait()
+
+    before = counter[0]
+    start = time.perf_counter()
+    call()
+    elapsed = time.perf_counter() - start
+    progress = counter[0] - before
+
+    done.set()
+    thread.join()
+
+    return progress / elapsed
+
+
+def test_step_runs_alongside_python_threads():
+    world = dartpy.utils.skel.readWorld(get_asset_path('skel/cubes.skel'))
+
+    # Make a single step long enough to measure by piling up many cubes
+    for _ in range(100):
+        world.addSkeleton(world.getSkeleton(1).clone())
+
+    # World.clone holds the GIL, so the other thread can barely make progress
+    # while it runs, whereas World.step releases it for the whole step.
+    held = _count_progress_during(lambda: world.clone())
+    released = _count_progress_during(lambda: world.step())
+
+    assert world.getSimFrames() == 1
+    assert released > 0
+    assert released > 10 * held
+
+
 if __name__ == "__main__":
     pytest.main()
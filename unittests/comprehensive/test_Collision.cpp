@@ -1304,6 +1304,14 @@ TEST_F(COLLISION, testHeightmapBox)
   testHeightmapBox<float>(bullet.get(), false, false);
 
 #endif
+
+  auto fcl = FCLCollisionDetector::create();
+  testHeightmapBox<float>(fcl.get(), false, false);
+  testHeightmapBox<double>(fcl.get(), false, false);
+
+  auto dart = DARTCollisionDetector::create();
+  testHeightmapBox<float>(dart.get(), true, false);
+  testHeightmapBox<double>(dart.get(), true, false);
 }
 
 //==============================================================================
@@ -1315,7 +1323,9 @@ TEST_F(COLLISION, HeightmapFlipY)
   std::vector<S> heights1 = {-1, -2, 2, 1};
   auto shape = std::make_shared<HeightmapShape<S>>();
   shape->setHeightField(2, 2, heights1);
+  const auto version = shape->getVersion();
   shape->flipY();
+  EXPECT_NE(version, shape->getVersion());
   EXPECT_EQ(shape->getHeightField().data()[0], heights1[2]);
   EXPECT_EQ(shape->getHeightField().data()[1], heights1[3]);
   EXPECT_EQ(shape->getHeightField().data()[2], heights1[0]);
@@ -1391,6 +1401,195 @@ TEST_F(COLLISION, HeightmapFlipY)
   EXPECT_EQ(shape->getHeightField().data()[0], heights8[0]);
 }
 
+//==============================================================================
+TEST_F(COLLISION, HeightmapTiles)
+{
+  using S = float;
+  using HeightField = HeightmapShape<S>::HeightField;
+
+  const std::size_t width = 100u;
+  const std::size_t depth = 70u;
+  auto shape = std::make_shared<HeightmapShape<S>>();
+  shape->setHeightField(HeightField::Random(depth, width));
+  shape->setScale(Eigen::Vector3d(0.5, 0.25, 2.0));
+  shape->setTileSize(16u);
+
+  // 99 x 69 cells
+  EXPECT_EQ(7u * 5u, shape->getNumTiles());
+
+  // The tile bounds contain all of their samples
+  for (std::size_t i = 0u; i < shape->getNumTiles(); ++i)
+  {
+    const auto& tile = shape->getTile(i);
+    const math::BoundingBox box = shape->computeTileBoundingBox(i);
+
+    for (std::size_t r = tile.mRow; r <= tile.mRow + tile.mNumRows; ++r)
+    {
+      for (std::size_t c = tile.mCol; c <= tile.mCol + tile.mNumCols; ++c)
+      {
+        const Eigen::Vector3d vertex = shape->getVertex(r, c);
+        EXPECT_TRUE((vertex.array() >= box.getMin().array() - 1e-9).all());
+        EXPECT_TRUE((vertex.array() <= box.getMax().array() + 1e-9).all());
+      }
+    }
+  }
+
+  // findTiles() finds every tile overlapping a region
+  std::vector<std::size_t> tiles;
+  for (int i = 0; i < 100; ++i)
+  {
+    const Eigen::Vector3d min = Random::uniform<Eigen::Vector3d>(
+        Eigen::Vector3d(-30.0, -10.0, -3.0), Eigen::Vector3d(30.0, 10.0, 3.0));
+    const Eigen::Vector3d max = min + Random::uniform<Eigen::Vector3d>(
+        Eigen::Vector3d::Zero(), Eigen::Vector3d(5.0, 5.0, 1.0));
+    shape->findTiles(math::BoundingBox(min, max), tiles);
+
+    for (std::size_t j = 0u; j < shape->getNumTiles(); ++j)
+    {
+      const math::BoundingBox box = shape->computeTileBoundingBox(j);
+      if ((box.getMin().array() <= max.array()).all()
+          && (box.getMax().array() >= min.array()).all())
+      {
+        EXPECT_NE(std::find(tiles.begin(), tiles.end(), j), tiles.end());
+      }
+    }
+  }
+
+  // Updating a block only changes the tiles sharing its samples
+  const auto heights = shape->getSharedHeightField();
+  EXPECT_EQ(heights.get(), &shape->getHeightField());
+  const auto version = shape->getVersion();
+  shape->setHeights(16u, 32u, HeightField::Constant(3, 4, 5.0f));
+  EXPECT_EQ(5.0f, shape->getMaxHeight());
+  EXPECT_NE(version, shape->getVersion());
+
+  std::size_t numRaisedTiles = 0u;
+  for (std::size_t i = 0u; i < shape->getNumTiles(); ++i)
+  {
+    const auto& tile = shape->getTile(i);
+    if (tile.mMaxHeight == 5.0f)
+    {
+      ++numRaisedTiles;
+      EXPECT_EQ(shape->getVersion(), tile.mVersion);
+    }
+    else
+    {
+      EXPECT_LE(tile.mVersion, version);
+    }
+  }
+  // Sample (16, 32) is a corner of four tiles
+  EXPECT_EQ(4u, numRaisedTiles);
+
+  // Changing the scale moves every tile
+  shape->setScale(Eigen::Vector3d(0.5, 0.5, 2.0));
+  for (std::size_t i = 0u; i < shape->getNumTiles(); ++i)
+    EXPECT_EQ(shape->getVersion(), shape->getTile(i).mVersion);
+
+  // Replacing the height field leaves the shared data untouched
+  shape->setHeightField(HeightField::Zero(depth, width));
+  EXPECT_NE(heights.get(), &shape->getHeightField());
+  EXPECT_EQ(5.0f, (*heights)(16, 32));
+}
+
+//==============================================================================
+template <typename S>
+void testHeightmapSphere(CollisionDetector* cd, bool checkNormals)
+{
+  using HeightField = typename HeightmapShape<S>::HeightField;
+
+  // Large flat terrain at z = 1 with a bump far away from the origin
+  HeightField heights = HeightField::Constant(513, 513, 1.0);
+  heights(400, 400) = 2.0;
+
+  auto terrainShape = std::make_shared<HeightmapShape<S>>();
+  terrainShape->setHeightField(std::move(heights));
+  terrainShape->setScale(Eigen::Vector3d(0.1, 0.1, 1.0));
+
+  const Eigen::Vector3d bump = terrainShape->getVertex(400, 400);
+  EXPECT_DOUBLE_EQ(2.0, bump.z());
+
+  auto terrainFrame = SimpleFrame::createShared(Frame::World());
+  auto sphereFrame = SimpleFrame::createShared(Frame::World());
+  terrainFrame->setShape(terrainShape);
+  sphereFrame->setShape(std::make_shared<SphereShape>(0.05));
+
+  auto group = cd->createCollisionGroup(terrainFrame.get(), sphereFrame.get());
+
+  collision::CollisionOption option;
+  collision::CollisionResult result;
+
+  // Above the flat part
+  sphereFrame->setTranslation(Eigen::Vector3d(-10.0, 3.0, 1.06));
+  EXPECT_FALSE(group->collide(option, &result));
+
+  // Check both orders of the pair
+  auto reversedGroup
+      = cd->createCollisionGroup(sphereFrame.get(), terrainFrame.get());
+  sphereFrame->setTranslation(Eigen::Vector3d(-10.0, 3.0, 1.04));
+  for (auto* checkedGroup : {group.get(), reversedGroup.get()})
+  {
+    EXPECT_TRUE(checkedGroup->collide(option, &result));
+    ASSERT_GT(result.getNumContacts(), 0u);
+    if (!checkNormals)
+      continue;
+
+    for (const auto& contact : result.getContacts())
+    {
+      // The normal points from the second object to the first one
+      const double sign
+          = (contact.collisionObject1->getShapeFrame() == terrainFrame.get())
+                ? -1.0
+                : 1.0;
+      EXPECT_GT(sign * contact.normal.z(), 0.9);
+    }
+  }
+
+  // Just above the tip of the bump
+  sphereFrame->setTranslation(bump + Eigen::Vector3d(0.0, 0.0, 0.06));
+  EXPECT_FALSE(group->collide(option, &result));
+
+  sphereFrame->setTranslation(bump + Eigen::Vector3d(0.0, 0.0, 0.04));
+  EXPECT_TRUE(group->collide(option, &result));
+
+  // Outside of the terrain
+  sphereFrame->setTranslation(Eigen::Vector3d(30.0, 0.0, 1.0));
+  EXPECT_FALSE(group->collide(option, &result));
+
+  // Raise the flat part under the sphere in place
+  sphereFrame->setTranslation(Eigen::Vector3d(-10.0, 3.0, 1.06));
+  EXPECT_FALSE(group->collide(option, &result));
+  const auto version = terrainShape->getVersion();
+  terrainShape->getHeightFieldModifiable().block(220, 150, 13, 13).setConstant(
+      1.5);
+  terrainShape->notifyHeightsChanged();
+  EXPECT_NE(version, terrainShape->getVersion());
+  std::vector<std::size_t> tiles;
+  terrainShape->findTiles(
+      math::BoundingBox(
+          Eigen::Vector3d(-10.1, 2.9, 1.4), Eigen::Vector3d(-9.9, 3.1, 1.5)),
+      tiles);
+  EXPECT_FALSE(tiles.empty());
+  EXPECT_TRUE(group->collide(option, &result));
+
+  // Lower it again block-wise, which only changes the tiles of the block
+  terrainShape->setHeights(220u, 150u, HeightField::Constant(13, 13, 1.0));
+  EXPECT_FALSE(group->collide(option, &result));
+  sphereFrame->setTranslation(Eigen::Vector3d(-10.0, 3.0, 1.04));
+  EXPECT_TRUE(group->collide(option, &result));
+}
+
+//==============================================================================
+TEST_F(COLLISION, HeightmapSphere)
+{
+  auto fcl = FCLCollisionDetector::create();
+  testHeightmapSphere<float>(fcl.get(), false);
+  testHeightmapSphere<double>(fcl.get(), false);
+
+  auto dart = DARTCollisionDetector::create();
+  testHeightmapSphere<float>(dart.get(), true);
+  testHeightmapSphere<double>(dart.get(), true);
+}
+
 //==============================================================================
 TEST_F(COLLISION, Options)
 {
@@ -1762,4 +1961,101 @@ TEST_F(COLLISION, VoxelGrid)
   EXPECT_TRUE(group->collide(option, &result));
   EXPECT_TRUE(result.getNumContacts() >= 1u);
 }
+
+//==============================================================================
+TEST_F(COLLISION, VoxelGridIncrementalUpdate)
+{
+  auto simpleFrame1 = SimpleFrame::createShared(Frame::World());
+  auto simpleFrame2 = SimpleFrame::createShared(Frame::World());
+
+  auto shape1 = std::make_shared<VoxelGridShape>(0.01);
+  auto shape2 = std::make_shared<SphereShape>(0.001);
+
+  simpleFrame1->setShape(shape1);
+  simpleFrame2->setShape(shape2);
+  simpleFrame2->setTranslation(Eigen::Vector3d(0.5, 0.0, 0.0));
+
+  auto cd = FCLCollisionDetector::create();
+  auto group = cd->createCollisionGroup(simpleFrame1.get(), simpleFrame2.get());
+  EXPECT_FALSE(group->collide());
+
+  const auto geometry = cd->claimFCLCollisionGeometry(shape1);
+  const auto version = shape1->getVersion();
+
+  std::size_t numNotifications = 0u;
+  math::BoundingBox lastRegion;
+  auto connection = shape1->onOccupancyChanged.connect(
+      [&](const VoxelGridShape*, const math::BoundingBox& region)
+  {
+    ++numNotifications;
+    lastRegion = region;
+  });
+
+  // Occupancy updates don't invalidate the collision geometry, but are still
+  // seen by collision checking.
+  shape1->updateOccupancy(Eigen::Vector3d(0.5, 0.0, 0.0), true);
+  EXPECT_EQ(version, shape1->getVersion());
+  EXPECT_EQ(1u, shape1->getOccupancyVersion());
+  EXPECT_EQ(1u, numNotifications);
+  const Eigen::Array3d updatedPoint(0.5, 0.0, 0.0);
+  EXPECT_TRUE((lastRegion.getMin().array() <= updatedPoint).all());
+  EXPECT_TRUE((lastRegion.getMax().array() >= updatedPoint).all());
+  EXPECT_TRUE(group->collide());
+  EXPECT_EQ(geometry, cd->claimFCLCollisionGeometry(shape1));
+
+  // Batched insertion matches inserting the point clouds one by one.
+  auto batchShape = std::make_shared<VoxelGridShape>(0.05);
+  auto serialShape = std::make_shared<VoxelGridShape>(0.05);
+
+  std::vector<octomap::Pointcloud> clouds(8);
+  std::vector<Eigen::Vector3d> origins(clouds.size());
+  for (std::size_t i = 0u; i < clouds.size(); ++i)
+  {
+    origins[i] = Random::uniform<Eigen::Vector3d>(
+        Eigen::Vector3d::Constant(-0.1), Eigen::Vector3d::Constant(0.1));
+    for (int j = 0; j < 200; ++j)
+    {
+      const Eigen::Vector3d point = Random::uniform<Eigen::Vector3d>(
+          Eigen::Vector3d::Constant(-1.0), Eigen::Vector3d::Constant(1.0));
+      clouds[i].push_back(point.x(), point.y(), point.z());
+    }
+  }
+
+  Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+  tf.translation() = Eigen::Vector3d(0.1, -0.2, 0.3);
+  tf.linear() = math::expMapRot(Eigen::Vector3d(0.1, 0.2, -0.3));
+
+  const double maxRange = 1.2;
+  batchShape->updateOccupancy(clouds, origins, tf, maxRange, 4u);
+  for (std::size_t i = 0u; i < clouds.size(); ++i)
+  {
+    const Eigen::Quaterniond quat(tf.linear());
+    serialShape->getOctree()->insertPointCloud(
+        clouds[i],
+        octomap::point3d(origins[i].x(), origins[i].y(), origins[i].z()),
+        octomap::pose6d(
+            octomap::point3d(
+                tf.translation().x(), tf.translation().y(),
+                tf.translation().z()),
+            octomath::Quaternion(quat.w(), quat.x(), quat.y(), quat.z())),
+        maxRange);
+  }
+
+  EXPECT_EQ(1u, batchShape->getOccupancyVersion());
+  for (std::size_t i = 0u; i < clouds.size(); ++i)
+  {
+    for (const auto& point : clouds[i])
+    {
+      // Sample both the end points and the middle of the rays
+      const Eigen::Vector3d end
+          = tf * Eigen::Vector3d(point.x(), point.y(), point.z());
+      const Eigen::Vector3d middle = 0.5 * (end + tf * origins[i]);
+
+      EXPECT_DOUBLE_EQ(serialShape->getOccupancy(end),
+                       batchShape->getOccupancy(end));
+      EXPECT_DOUBLE_EQ(serialShape->getOccupancy(middle),
+                       batchShape->getOccupancy(middle));
+    }
+  }
+}
 #endif // HAVE_OCTOMAP && FCL_HAVE_OCTOMAP
@@ -30,12 +30,20 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <atomic>
 #include <chrono>
 #include <future>
+#include <mutex>
+#include <thread>
 
 #include <gtest/gtest.h>
 
+#include "dart/common/TripleBuffer.hpp"
+#include "dart/dynamics/PointMass.hpp"
+#include "dart/dynamics/SoftBodyNode.hpp"
+#include "dart/dynamics/SoftMeshShape.hpp"
 #include "dart/simulation/World.hpp"
+#include "dart/simulation/WorldSnapshot.hpp"
 
 #include "TestHelpers.hpp"
 
@@ -77,3 +85,256 @@ TEST(Concurrency, FrameDeletion)
   EXPECT_EQ(Frame::World()->getNumChildEntities(), 0);
   EXPECT_EQ(Frame::World()->getNumChildFrames(), 0);
 }
+
+//==============================================================================
+TEST(Concurrency, TripleBuffer)
+{
+  struct Pair
+  {
+    int mValue;
+    int mNegated;
+  };
+
+  common::TripleBuffer<Pair> buffer(Pair{0, 0});
+  EXPECT_FALSE(buffer.hasNewData());
+  EXPECT_FALSE(buffer.update());
+
+  // Publishing twice before an update only hands over the latest value
+  buffer.getWriteBuffer() = Pair{1, -1};
+  buffer.publish();
+  buffer.getWriteBuffer() = Pair{2, -2};
+  buffer.publish();
+  EXPECT_TRUE(buffer.hasNewData());
+  EXPECT_TRUE(buffer.update());
+  EXPECT_EQ(buffer.getReadBuffer().mValue, 2);
+  EXPECT_FALSE(buffer.update());
+  EXPECT_EQ(buffer.getReadBuffer().mValue, 2);
+
+  const int numValues = 200000;
+  auto producer = std::async(std::launch::async, [&]() {
+    for (int i = 3; i <= numValues; ++i)
+    {
+      Pair& pair = buffer.getWriteBuffer();
+      pair.mValue = i;
+      pair.mNegated = -i;
+      buffer.publish();
+    }
+  });
+
+  int last = 2;
+  int numUpdates = 0;
+  while (last < numValues)
+  {
+    if (!buffer.update())
+      continue;
+
+    const Pair& pair = buffer.getReadBuffer();
+
+    // Every value that is read must be complete and newer than the last one
+    ASSERT_EQ(pair.mValue, -pair.mNegated);
+    ASSERT_GT(pair.mValue, last);
+    last = pair.mValue;
+    ++numUpdates;
+  }
+
+  producer.get();
+  EXPECT_EQ(last, numValues);
+  EXPECT_GT(numUpdates, 0);
+}
+
+//==============================================================================
+TEST(Concurrency, WorldSnapshotHandoff)
+{
+  auto world = std::make_shared<simulation::World>();
+  world->setGravity(Eigen::Vector3d::Zero());
+
+  auto skeleton = Skeleton::create("skeleton");
+  auto body = skeleton->createJointAndBodyNodePair<FreeJoint>().second;
+  auto shape = std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.1));
+
+  const Eigen::Vector3d offset(0.0, 0.5, 0.0);
+  auto bodyShapeNode = body->createShapeNodeWith<VisualAspect>(shape);
+  auto offsetShapeNode = body->createShapeNodeWith<VisualAspect>(shape);
+  Eigen::Isometry3d offsetTf = Eigen::Isometry3d::Identity();
+  offsetTf.translation() = offset;
+  offsetShapeNode->setRelativeTransform(offsetTf);
+
+  const Eigen::Vector3d velocity(1.0, 0.0, 0.0);
+  FreeJoint::setTransform(body, Eigen::Isometry3d::Identity());
+  Eigen::Vector6d spatialVelocity = Eigen::Vector6d::Zero();
+  spatialVelocity.tail<3>() = velocity;
+  skeleton->setVelocities(spatialVelocity);
+  world->addSkeleton(skeleton);
+
+  auto simpleFrame = std::make_shared<SimpleFrame>(Frame::World(), "marker");
+  simpleFrame->setShape(shape);
+  world->addSimpleFrame(simpleFrame);
+
+  common::TripleBuffer<simulation::WorldSnapshot> buffer;
+
+  // The simulation runs flat out until the reader has received enough
+  // snapshots, so the reader has to keep up with a writer that never waits
+  // for it.
+  const int minSnapshots = 200;
+  const int maxSteps = 1000000;
+  std::atomic<int> numSnapshots(0);
+  std::atomic<bool> done(false);
+  const auto start = std::chrono::steady_clock::now();
+  auto simulation = std::async(std::launch::async, [&]() {
+    int numSteps = 0;
+    while (numSnapshots < minSnapshots && numSteps < maxSteps)
+    {
+      world->step();
+      buffer.getWriteBuffer().capture(*world);
+      buffer.publish();
+      ++numSteps;
+    }
+    done = true;
+    return numSteps;
+  });
+
+  int lastSimFrames = 0;
+  while (!done || buffer.hasNewData())
+  {
+    if (!buffer.update())
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    const simulation::WorldSnapshot& snapshot = buffer.getReadBuffer();
+    ASSERT_GT(snapshot.getSimFrames(), lastSimFrames);
+    lastSimFrames = snapshot.getSimFrames();
+    ++numSnapshots;
+
+    // Skeletons are recorded before SimpleFrames, but the order of the
+    // ShapeNodes of a BodyNode is unspecified
+    ASSERT_EQ(snapshot.getNumShapeFrames(), 3u);
+    const bool bodyFirst
+        = snapshot.getShapeFrameState(0).mShapeFrame == bodyShapeNode;
+    const auto& bodyState = snapshot.getShapeFrameState(bodyFirst ? 0 : 1);
+    const auto& offsetState = snapshot.getShapeFrameState(bodyFirst ? 1 : 0);
+    const auto& markerState = snapshot.getShapeFrameState(2);
+    ASSERT_EQ(bodyState.mShapeFrame, bodyShapeNode);
+    ASSERT_EQ(offsetState.mShapeFrame, offsetShapeNode);
+
+    // All the transforms must belong to the time at which the snapshot was
+    // captured
+    const Eigen::Vector3d expected = velocity * snapshot.getTime();
+    EXPECT_TRUE(bodyState.mTransform.translation().isApprox(expected, 1e-6));
+    EXPECT_TRUE((offsetState.mTransform.translation()
+                 - bodyState.mTransform.translation())
+                    .isApprox(offset, 1e-9));
+    EXPECT_TRUE(markerState.mTransform.isApprox(Eigen::Isometry3d::Identity()));
+
+    EXPECT_EQ(bodyState.mShape, shape);
+    EXPECT_TRUE(bodyState.mHasVisualAspect);
+    EXPECT_FALSE(markerState.mHasVisualAspect);
+    EXPECT_EQ(markerState.mShapeFrame, simpleFrame.get());
+  }
+
+  const int numSteps = simulation.get();
+  const std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - start;
+
+  // The last snapshot is always handed over
+  EXPECT_EQ(lastSimFrames, numSteps);
+
+  // The reader must be able to pick up fresh snapshots at least as often as
+  // a display refreshes
+  EXPECT_GE(numSnapshots.load(), minSnapshots);
+  EXPECT_GT(numSnapshots.load() / elapsed.count(), 60.0);
+}
+
+//==============================================================================
+TEST(Concurrency, WorldSnapshotDuringLongStep)
+{
+  auto world = std::make_shared<simulation::World>();
+  world->setGravity(Eigen::Vector3d::Zero());
+
+  auto skeleton = Skeleton::create("soft");
+  const SoftBodyNode::UniqueProperties softProperties
+      = SoftBodyNodeHelper::makeBoxProperties(
+          Eigen::Vector3d(0.3, 0.4, 0.5), Eigen::Isometry3d::Identity(),
+          Eigen::Vector3i(3, 3, 3), 0.5, 1000.0, 500.0, 0.1);
+  SoftBodyNode* softBody
+      = skeleton->createJointAndBodyNodePair<FreeJoint, SoftBodyNode>(
+            nullptr, FreeJoint::Properties(),
+            SoftBodyNode::Properties(
+                BodyNode::AspectProperties("soft box"), softProperties))
+            .second;
+  for (std::size_t i = 0u; i < softBody->getNumPointMasses(); ++i)
+  {
+    softBody->getPointMass(i)->setVelocities(
+        Eigen::Vector3d(0.0, 0.0, (i % 2u == 0u) ? 0.5 : -0.5));
+  }
+  world->addSkeleton(skeleton);
+
+  ShapeNode* softShapeNode = softBody->getShapeNode(0);
+  ASSERT_TRUE(softShapeNode->getShape()->is<SoftMeshShape>());
+  const Eigen::Vector4d color(0.2, 0.4, 0.6, 0.5);
+  softShapeNode->getVisualAspect()->setRGBA(color);
+
+  // The simulation thread holds the simulation mutex across each step, like
+  // gui::osg::RealTimeWorldNode does, and its second step takes much longer
+  // than a display refresh cycle.
+  common::TripleBuffer<simulation::WorldSnapshot> buffer;
+  std::mutex simulationMutex;
+  std::atomic<bool> longStepStarted(false);
+  std::atomic<bool> longStepFinished(false);
+  const std::chrono::milliseconds longStepDuration(500);
+
+  std::vector<Eigen::Vector3d> capturedVertices;
+  auto simulation = std::async(std::launch::async, [&]() {
+    std::unique_lock<std::mutex> lock(simulationMutex);
+    world->step();
+    for (std::size_t i = 0u; i < softBody->getNumPointMasses(); ++i)
+    {
+      capturedVertices.push_back(
+          softBody->getPointMass(i)->getLocalPosition());
+    }
+    buffer.getWriteBuffer().capture(*world);
+    buffer.publish();
+
+    longStepStarted = true;
+    world->step();
+    std::this_thread::sleep_for(longStepDuration);
+    longStepFinished = true;
+  });
+
+  while (!longStepStarted)
+    std::this_thread::yield();
+
+  // Everything that is rendered can be read from the snapshot while the step
+  // is still running, without waiting for the simulation mutex
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(buffer.update());
+  const simulation::WorldSnapshot& snapshot = buffer.getReadBuffer();
+  EXPECT_EQ(snapshot.getSimFrames(), 1);
+
+  const simulation::WorldSnapshot::ShapeFrameState* softState = nullptr;
+  for (const auto& state : snapshot.getShapeFrameStates())
+  {
+    if (state.mShapeFrame == softShapeNode)
+      softState = &state;
+  }
+  ASSERT_NE(softState, nullptr);
+  EXPECT_TRUE(softState->mHasVisualAspect);
+  EXPECT_FALSE(softState->mHidden);
+  EXPECT_TRUE(softState->mRGBA.isApprox(color));
+  EXPECT_EQ(softState->mSoftMeshFaces.size(), softBody->getNumFaces());
+  ASSERT_EQ(softState->mSoftMeshVertices.size(), capturedVertices.size());
+  for (std::size_t i = 0u; i < capturedVertices.size(); ++i)
+    EXPECT_TRUE(softState->mSoftMeshVertices[i].isApprox(capturedVertices[i]));
+
+  const std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - start;
+  EXPECT_FALSE(longStepFinished.load());
+  EXPECT_LT(elapsed.count(), 0.1);
+
+  simulation.get();
+
+  // The snapshot was not changed by the step that ran meanwhile
+  EXPECT_EQ(snapshot.getSimFrames(), 1);
+  EXPECT_EQ(world->getSimFrames(), 2);
+}
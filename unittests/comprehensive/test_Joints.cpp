@@ -49,6 +49,7 @@
 #include "dart/dynamics/ScrewJoint.hpp"
 #include "dart/dynamics/PlanarJoint.hpp"
 #include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/BoxShape.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/simulation/World.hpp"
 #include "dart/utils/SkelParser.hpp"
@@ -979,6 +980,117 @@ TEST_F(JOINTS, MIMIC_JOINT)
   testMimicJoint();
 }
 
+//==============================================================================
+SkeletonPtr createServoChain(std::size_t numLinks, double kp, double kd)
+{
+  SkeletonPtr chain = Skeleton::create();
+  BodyNode* parent = nullptr;
+
+  for (std::size_t i = 0u; i < numLinks; ++i)
+  {
+    RevoluteJoint::Properties jointProperties;
+    jointProperties.mAxis = Eigen::Vector3d::UnitX();
+    if (parent)
+    {
+      jointProperties.mT_ParentBodyToJoint.translation()
+          = Eigen::Vector3d(0.0, 0.0, 0.2);
+    }
+
+    BodyNode::Properties bodyProperties;
+    bodyProperties.mInertia.setMass(1.0);
+    bodyProperties.mInertia.setLocalCOM(Eigen::Vector3d(0.0, 0.0, 0.1));
+    bodyProperties.mInertia.setMoment(BoxShape::computeInertia(
+        Eigen::Vector3d(0.05, 0.05, 0.2), 1.0));
+
+    parent = chain->createJointAndBodyNodePair<RevoluteJoint>(
+        parent, jointProperties, bodyProperties).second;
+
+    DegreeOfFreedom* dof = chain->getDof(i);
+    dof->setPositionServoGain(kp);
+    dof->setVelocityServoGain(kd);
+    dof->setServoTargetPosition(0.3);
+  }
+
+  return chain;
+}
+
+//==============================================================================
+/// Returns whether the chain settles at the servo target within the given time
+/// where the PD servo force is applied either implicitly by the joints or
+/// explicitly as joint forces.
+bool settlesAtServoTarget(
+    double kp, double kd, double timeStep, bool implicitServo)
+{
+  const std::size_t numLinks = 5u;
+  SkeletonPtr chain = createServoChain(
+      numLinks, implicitServo ? kp : 0.0, implicitServo ? kd : 0.0);
+  chain->setTimeStep(timeStep);
+
+  const Eigen::VectorXd target = Eigen::VectorXd::Constant(numLinks, 0.3);
+  const std::size_t numSteps = static_cast<std::size_t>(3.0 / timeStep);
+  for (std::size_t i = 0u; i < numSteps; ++i)
+  {
+    if (!implicitServo)
+    {
+      chain->setForces(-kp * (chain->getPositions() - target)
+                       - kd * chain->getVelocities());
+    }
+
+    chain->computeForwardDynamics();
+    chain->integrateVelocities(timeStep);
+    chain->integratePositions(timeStep);
+
+    if (!chain->getPositions().allFinite()
+        || chain->getPositions().cwiseAbs().maxCoeff() > 10.0)
+    {
+      return false;
+    }
+  }
+
+  return (chain->getPositions() - target).cwiseAbs().maxCoeff() < 1e-2;
+}
+
+//==============================================================================
+TEST_F(JOINTS, IMPLICIT_SERVO_STABILITY)
+{
+  // Compares the largest stable time step of stiff PD servos applied
+  // explicitly as joint forces with the one of the implicit joint servo. The
+  // explicit servo needs time steps of 0.1 ms or less with these gains while
+  // the implicit one stays stable at 16 ms.
+  const double kp = 1e4;
+  const double kd = 10.0;
+
+  EXPECT_TRUE(settlesAtServoTarget(kp, kd, 1e-4, false));
+  EXPECT_FALSE(settlesAtServoTarget(kp, kd, 1e-3, false));
+  EXPECT_FALSE(settlesAtServoTarget(kp, kd, 4e-3, false));
+
+  for (const double timeStep : {1e-4, 1e-3, 4e-3, 1.6e-2})
+    EXPECT_TRUE(settlesAtServoTarget(kp, kd, timeStep, true));
+
+  // The servo force is zero at the target
+  SkeletonPtr chain = createServoChain(1u, kp, kd);
+  chain->setPositions(Eigen::VectorXd::Constant(1, 0.3));
+  chain->setGravity(Eigen::Vector3d::Zero());
+  chain->computeForwardDynamics();
+  EXPECT_NEAR(chain->getAccelerations()[0], 0.0, 1e-12);
+
+  // The augmented mass matrix includes the implicit servo terms, so it is the
+  // inverse of the implicit inverse mass matrix
+  SkeletonPtr longChain = createServoChain(3u, kp, kd);
+  longChain->setTimeStep(1e-3);
+  longChain->setPositions(Eigen::VectorXd::Constant(3, 0.2));
+  longChain->setVelocities(Eigen::VectorXd::Constant(3, -0.5));
+  EXPECT_TRUE((longChain->getAugMassMatrix()
+               * longChain->getInvAugMassMatrix())
+                  .isApprox(Eigen::MatrixXd::Identity(3, 3), 1e-8));
+
+  // The servo properties are copied with the joint properties
+  SkeletonPtr clone = chain->cloneSkeleton();
+  EXPECT_DOUBLE_EQ(clone->getDof(0)->getPositionServoGain(), kp);
+  EXPECT_DOUBLE_EQ(clone->getDof(0)->getVelocityServoGain(), kd);
+  EXPECT_DOUBLE_EQ(clone->getDof(0)->getServoTargetPosition(), 0.3);
+}
+
 //==============================================================================
 TEST_F(JOINTS, JOINT_COULOMB_FRICTION_AND_POSITION_LIMIT)
 {
@@ -35,6 +35,7 @@
 #include "TestHelpers.hpp"
 
 #include "dart/common/sub_ptr.hpp"
+#include "dart/common/Timer.hpp"
 #include "dart/math/Geometry.hpp"
 #include "dart/utils/SkelParser.hpp"
 #include "dart/dynamics/BodyNode.hpp"
@@ -760,6 +761,102 @@ TEST(Skeleton, CloneNodeOrdering)
   }
 }
 
+TEST(Skeleton, BulkConstruction)
+{
+  auto createSkeleton = [](bool bulk)
+  {
+    SkeletonPtr skel = Skeleton::create();
+    if(bulk)
+    {
+      skel->beginBulkConstruction();
+      skel->beginBulkConstruction();
+      EXPECT_TRUE(skel->isInBulkConstruction());
+    }
+
+    BodyNode* bn = skel->createJointAndBodyNodePair<FreeJoint>().second;
+    bn->setMass(2.0);
+    for(int i=0; i < 5; ++i)
+    {
+      bn = skel->createJointAndBodyNodePair<BallJoint>(bn).second;
+      bn->setMass(1.0);
+      bn->getParentJoint()->setTransformFromParentBodyNode(
+          Eigen::Isometry3d(Eigen::Translation3d(0.0, 0.0, 0.5)));
+    }
+    skel->createJointAndBodyNodePair<RevoluteJoint>().second->setMass(3.0);
+
+    if(bulk)
+    {
+      // Only the outermost call finalizes the construction
+      skel->endBulkConstruction();
+      EXPECT_TRUE(skel->isInBulkConstruction());
+      skel->endBulkConstruction();
+      EXPECT_FALSE(skel->isInBulkConstruction());
+    }
+
+    return skel;
+  };
+
+  SkeletonPtr skel = createSkeleton(true);
+  EXPECT_EQ(skel->getMass(), 10.0);
+  EXPECT_EQ(skel->getMassMatrix().rows(), 22);
+  EXPECT_EQ(skel->getMassMatrix(0).rows(), 21);
+  EXPECT_EQ(skel->getMassMatrix(1).rows(), 1);
+  EXPECT_EQ(skel->getCoriolisAndGravityForces().size(), 22);
+
+  // The result must be the same as that of a Skeleton built one BodyNode at a
+  // time, and of its clone
+  SkeletonPtr reference = createSkeleton(false);
+  SkeletonPtr clone = skel->cloneSkeleton();
+  const Eigen::VectorXd q = Eigen::VectorXd::Random(skel->getNumDofs());
+  for(const SkeletonPtr& other : {reference, clone})
+  {
+    skel->setPositions(q);
+    other->setPositions(q);
+    EXPECT_EQ(other->getMass(), skel->getMass());
+    EXPECT_TRUE(equals(other->getMassMatrix(), skel->getMassMatrix()));
+
+    skel->computeForwardDynamics();
+    other->computeForwardDynamics();
+    EXPECT_TRUE(equals(other->getAccelerations(), skel->getAccelerations()));
+  }
+}
+
+TEST(Skeleton, CloningPerformance)
+{
+  // Reports the cost of cloning one instance of a Skeleton, which is expected
+  // to grow linearly with the number of BodyNodes
+  for(const std::size_t numBodyNodes : {10u, 100u, 1000u})
+  {
+    SkeletonPtr skel = Skeleton::create();
+    skel->beginBulkConstruction();
+    BodyNode* bn = nullptr;
+    for(std::size_t i=0; i < numBodyNodes; ++i)
+    {
+      bn = skel->createJointAndBodyNodePair<BallJoint>(bn).second;
+      bn->createShapeNodeWith<VisualAspect, CollisionAspect>(
+          std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.1)));
+    }
+    skel->endBulkConstruction();
+
+    const std::size_t numClones = 1000u / numBodyNodes;
+    common::Timer timer(
+        "cloneSkeleton() with " + std::to_string(numBodyNodes) + " BodyNodes");
+    timer.start();
+    for(std::size_t i=0; i < numClones; ++i)
+    {
+      SkeletonPtr clone = skel->cloneSkeleton();
+      EXPECT_EQ(clone->getNumDofs(), skel->getNumDofs());
+      EXPECT_TRUE(clone->getBodyNode(0)->getShapeNode(0)->getShape()
+                  == skel->getBodyNode(0)->getShapeNode(0)->getShape());
+    }
+    timer.stop();
+
+    std::cout << "cloneSkeleton() with " << numBodyNodes << " BodyNodes: "
+              << timer.getLastElapsedTime() / numClones * 1e+6
+              << " us per instance" << std::endl;
+  }
+}
+
 TEST(Skeleton, ZeroDofJointInReferential)
 {
   // This is a regression test which makes sure that the BodyNodes of
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iostream>
+#include <gtest/gtest.h>
+#include "TestHelpers.hpp"
+
+#include "dart/common/Timer.hpp"
+#include "dart/dynamics/BallJoint.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/SkeletonBatch.hpp"
+#include "dart/dynamics/WeldJoint.hpp"
+
+using namespace dart;
+using namespace common;
+using namespace math;
+using namespace dynamics;
+
+//==============================================================================
+/// Creates a tree with a floating base, a branch of revolute and ball joints,
+/// and a welded body
+SkeletonPtr createTree()
+{
+  SkeletonPtr skel = Skeleton::create("tree");
+
+  BodyNode* root
+      = skel->createJointAndBodyNodePair<FreeJoint>(nullptr).second;
+
+  BodyNode* parent = root;
+  for (int i = 0; i < 4; ++i)
+  {
+    RevoluteJoint::Properties properties;
+    properties.mAxis = Eigen::Vector3d::Random().normalized();
+    properties.mT_ParentBodyToJoint.translation()
+        = Eigen::Vector3d(0.1, 0.0, 0.5);
+    parent = skel->createJointAndBodyNodePair<RevoluteJoint>(
+        parent, properties).second;
+  }
+
+  BallJoint::Properties ballProperties;
+  ballProperties.mT_ParentBodyToJoint.translation()
+      = Eigen::Vector3d(-0.3, 0.2, 0.0);
+  parent = skel->createJointAndBodyNodePair<BallJoint>(
+      root, ballProperties).second;
+  skel->createJointAndBodyNodePair<RevoluteJoint>(parent);
+  skel->createJointAndBodyNodePair<WeldJoint>(parent);
+
+  return skel;
+}
+
+//==============================================================================
+/// Randomizes the state, inertias, joint properties, and external forces
+void randomize(const SkeletonPtr& skel)
+{
+  for (std::size_t i = 0u; i < skel->getNumBodyNodes(); ++i)
+  {
+    BodyNode* bodyNode = skel->getBodyNode(i);
+    bodyNode->setMass(math::random(0.5, 2.0));
+    bodyNode->setMomentOfInertia(
+        math::random(0.1, 1.0), math::random(0.1, 1.0), math::random(0.1, 1.0),
+        math::random(-0.05, 0.05), math::random(-0.05, 0.05),
+        math::random(-0.05, 0.05));
+    bodyNode->setLocalCOM(Eigen::Vector3d::Random() * 0.2);
+    bodyNode->addExtForce(
+        Eigen::Vector3d::Random(), Eigen::Vector3d::Random() * 0.1, true, true);
+    bodyNode->setGravityMode(i % 3u != 2u);
+  }
+
+  for (std::size_t i = 0u; i < skel->getNumDofs(); ++i)
+  {
+    DegreeOfFreedom* dof = skel->getDof(i);
+    dof->setSpringStiffness(math::random(0.0, 5.0));
+    dof->setRestPosition(math::random(-0.5, 0.5));
+    dof->setDampingCoefficient(math::random(0.0, 2.0));
+  }
+
+  skel->setPositions(Eigen::VectorXd::Random(skel->getNumDofs()));
+  skel->setVelocities(Eigen::VectorXd::Random(skel->getNumDofs()));
+  skel->setCommands(Eigen::VectorXd::Random(skel->getNumDofs()) * 5.0);
+  skel->setTimeStep(math::random(0.0005, 0.002));
+  skel->setGravity(Eigen::Vector3d(0.0, 0.0, -math::random(5.0, 10.0)));
+}
+
+//==============================================================================
+TEST(SkeletonBatch, MatchesScalarForwardDynamics)
+{
+  // Six instances: one full pack and one partially filled pack
+  std::vector<SkeletonPtr> skeletons;
+  for (int i = 0; i < 6; ++i)
+  {
+    skeletons.push_back(i == 0 ? createTree() : skeletons[0]->clone());
+    randomize(skeletons.back());
+  }
+
+  // Servo actuators on one branch of the last instances
+  for (std::size_t i = 4u; i < 6u; ++i)
+  {
+    Joint* joint = skeletons[i]->getJoint(6);
+    joint->setActuatorType(Joint::SERVO);
+    joint->setPositionServoGain(0, 20.0);
+    joint->setVelocityServoGain(0, 2.0);
+    joint->setServoTargetPosition(0, 0.3);
+  }
+
+  // The topology must be identical, so the SERVO actuator of the last
+  // instances is rejected
+  SkeletonBatch batch;
+  EXPECT_FALSE(batch.setSkeletons(skeletons));
+  EXPECT_EQ(batch.getNumSkeletons(), 0u);
+
+  for (std::size_t i = 0u; i < 4u; ++i)
+  {
+    Joint* joint = skeletons[i]->getJoint(6);
+    joint->setActuatorType(Joint::SERVO);
+    joint->setPositionServoGain(0, 10.0);
+    joint->setServoTargetVelocity(0, -0.5);
+  }
+  ASSERT_TRUE(batch.setSkeletons(skeletons));
+  EXPECT_EQ(batch.getNumSkeletons(), 6u);
+
+  const auto expectMatch = [&]() {
+    std::vector<Eigen::VectorXd> expected;
+    for (const SkeletonPtr& skel : skeletons)
+    {
+      skel->computeForwardDynamics();
+      expected.push_back(skel->getAccelerations());
+      skel->setAccelerations(Eigen::VectorXd::Zero(skel->getNumDofs()));
+    }
+
+    batch.computeForwardDynamics();
+
+    for (std::size_t i = 0u; i < skeletons.size(); ++i)
+      EXPECT_TRUE(equals(skeletons[i]->getAccelerations(), expected[i], 1e-9));
+  };
+
+  expectMatch();
+
+  // The state and the servo targets are read on every call
+  for (const SkeletonPtr& skel : skeletons)
+  {
+    skel->setPositions(Eigen::VectorXd::Random(skel->getNumDofs()));
+    skel->setVelocities(Eigen::VectorXd::Random(skel->getNumDofs()));
+    skel->getJoint(6)->setServoTargetPosition(0, -0.2);
+  }
+  expectMatch();
+
+  // The properties are captured again by updateProperties()
+  for (const SkeletonPtr& skel : skeletons)
+    randomize(skel);
+  batch.updateProperties();
+  expectMatch();
+}
+
+//==============================================================================
+TEST(SkeletonBatch, RejectsDifferentTopology)
+{
+  SkeletonPtr skel = createTree();
+  SkeletonPtr other = skel->clone();
+  other->createJointAndBodyNodePair<RevoluteJoint>(other->getBodyNode(2));
+
+  SkeletonBatch batch;
+  EXPECT_FALSE(batch.setSkeletons({skel, other}));
+  EXPECT_TRUE(batch.setSkeletons({skel, skel->clone()}));
+  EXPECT_TRUE(batch.setSkeletons({}));
+}
+
+//==============================================================================
+TEST(SkeletonBatch, PerformanceComparison)
+{
+#ifndef NDEBUG
+  const std::size_t numSkeletons = 8u;
+  const int testCount = 1;
+#else
+  const std::size_t numSkeletons = 64u;
+  const int testCount = 100;
+#endif
+
+  std::vector<SkeletonPtr> skeletons;
+  for (std::size_t i = 0u; i < numSkeletons; ++i)
+  {
+    skeletons.push_back(i == 0u ? createTree() : skeletons[0]->clone());
+    randomize(skeletons.back());
+  }
+
+  SkeletonBatch batch(skeletons);
+  ASSERT_EQ(batch.getNumSkeletons(), numSkeletons);
+
+  Timer scalarTimer("Skeleton::computeForwardDynamics");
+  scalarTimer.start();
+  for (int i = 0; i < testCount; ++i)
+  {
+    for (const SkeletonPtr& skel : skeletons)
+    {
+      // Changing the state invalidates the cached articulated inertias, so
+      // the comparison covers the full recursion
+      skel->setPositions(skel->getPositions());
+      skel->computeForwardDynamics();
+    }
+  }
+  scalarTimer.stop();
+
+  Timer batchTimer("SkeletonBatch::computeForwardDynamics");
+  batchTimer.start();
+  for (int i = 0; i < testCount; ++i)
+  {
+    for (const SkeletonPtr& skel : skeletons)
+      skel->setPositions(skel->getPositions());
+    batch.computeForwardDynamics();
+  }
+  batchTimer.stop();
+
+  scalarTimer.print();
+  batchTimer.print();
+}
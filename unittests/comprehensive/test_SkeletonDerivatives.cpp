@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <iostream>
+#include <gtest/gtest.h>
+#include "TestHelpers.hpp"
+
+#include "dart/common/Timer.hpp"
+#include "dart/dynamics/BallJoint.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/EulerJoint.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/PrismaticJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/SkeletonDerivatives.hpp"
+#include "dart/dynamics/UniversalJoint.hpp"
+#include "dart/dynamics/WeldJoint.hpp"
+
+using namespace dart;
+using namespace common;
+using namespace math;
+using namespace dynamics;
+
+//==============================================================================
+/// Creates a tree with a floating base, a branch of revolute and prismatic
+/// joints, and a branch of ball, Euler, universal, and weld joints
+SkeletonPtr createTree()
+{
+  SkeletonPtr skel = Skeleton::create("tree");
+
+  BodyNode* root
+      = skel->createJointAndBodyNodePair<FreeJoint>(nullptr).second;
+
+  BodyNode* parent = root;
+  for (int i = 0; i < 3; ++i)
+  {
+    RevoluteJoint::Properties properties;
+    properties.mAxis = Eigen::Vector3d::Random().normalized();
+    properties.mT_ParentBodyToJoint.translation()
+        = Eigen::Vector3d(0.1, 0.0, 0.5);
+    parent = skel->createJointAndBodyNodePair<RevoluteJoint>(
+        parent, properties).second;
+  }
+  PrismaticJoint::Properties prismaticProperties;
+  prismaticProperties.mAxis = Eigen::Vector3d::Random().normalized();
+  skel->createJointAndBodyNodePair<PrismaticJoint>(parent, prismaticProperties);
+
+  BallJoint::Properties ballProperties;
+  ballProperties.mT_ParentBodyToJoint.translation()
+      = Eigen::Vector3d(-0.3, 0.2, 0.0);
+  parent = skel->createJointAndBodyNodePair<BallJoint>(
+      root, ballProperties).second;
+
+  EulerJoint::Properties eulerProperties;
+  eulerProperties.mT_ParentBodyToJoint.translation()
+      = Eigen::Vector3d(0.0, 0.3, -0.2);
+  eulerProperties.mT_ChildBodyToJoint.translation()
+      = Eigen::Vector3d(0.1, 0.0, 0.1);
+  parent = skel->createJointAndBodyNodePair<EulerJoint>(
+      parent, eulerProperties).second;
+
+  UniversalJoint::Properties universalProperties;
+  universalProperties.mAxis[0] = Eigen::Vector3d::Random().normalized();
+  universalProperties.mAxis[1] = Eigen::Vector3d::Random().normalized();
+  universalProperties.mT_ParentBodyToJoint.translation()
+      = Eigen::Vector3d(0.2, 0.0, 0.4);
+  skel->createJointAndBodyNodePair<UniversalJoint>(
+      parent, universalProperties);
+  skel->createJointAndBodyNodePair<WeldJoint>(parent);
+
+  return skel;
+}
+
+//==============================================================================
+/// Randomizes the state, inertias, joint properties, and external forces
+void randomize(const SkeletonPtr& skel)
+{
+  for (std::size_t i = 0u; i < skel->getNumBodyNodes(); ++i)
+  {
+    BodyNode* bodyNode = skel->getBodyNode(i);
+    bodyNode->setMass(math::random(0.5, 2.0));
+    bodyNode->setMomentOfInertia(
+        math::random(0.1, 1.0), math::random(0.1, 1.0), math::random(0.1, 1.0),
+        math::random(-0.05, 0.05), math::random(-0.05, 0.05),
+        math::random(-0.05, 0.05));
+    bodyNode->setLocalCOM(Eigen::Vector3d::Random() * 0.2);
+    bodyNode->addExtForce(
+        Eigen::Vector3d::Random(), Eigen::Vector3d::Random() * 0.1, true, true);
+    bodyNode->setGravityMode(i % 3u != 2u);
+  }
+
+  for (std::size_t i = 0u; i < skel->getNumDofs(); ++i)
+  {
+    DegreeOfFreedom* dof = skel->getDof(i);
+    dof->setSpringStiffness(math::random(0.0, 5.0));
+    dof->setRestPosition(math::random(-0.5, 0.5));
+    dof->setDampingCoefficient(math::random(0.0, 2.0));
+  }
+
+  skel->setPositions(Eigen::VectorXd::Random(skel->getNumDofs()));
+  skel->setVelocities(Eigen::VectorXd::Random(skel->getNumDofs()));
+  skel->setAccelerations(Eigen::VectorXd::Random(skel->getNumDofs()));
+  skel->setCommands(Eigen::VectorXd::Random(skel->getNumDofs()) * 5.0);
+  skel->setTimeStep(math::random(0.0005, 0.002));
+  skel->setGravity(Eigen::Vector3d(0.0, 0.0, -math::random(5.0, 10.0)));
+}
+
+//==============================================================================
+/// Moves the positions by step along the velocity of DOF index, which is the
+/// direction that SkeletonDerivatives differentiates with respect to
+void movePositions(
+    const SkeletonPtr& skel,
+    const Eigen::VectorXd& positions,
+    std::size_t index,
+    double step)
+{
+  const Eigen::VectorXd velocities = skel->getVelocities();
+  skel->setPositions(positions);
+  skel->setVelocities(Eigen::VectorXd::Unit(skel->getNumDofs(), index));
+  skel->integratePositions(step);
+  skel->setVelocities(velocities);
+}
+
+//==============================================================================
+/// Returns the joint forces of the inverse dynamics with all the terms
+Eigen::VectorXd computeInverseDynamics(const SkeletonPtr& skel)
+{
+  skel->computeInverseDynamics(true, true, true);
+  return skel->getForces();
+}
+
+//==============================================================================
+/// Returns the accelerations of the forward dynamics
+Eigen::VectorXd computeForwardDynamics(const SkeletonPtr& skel)
+{
+  skel->computeForwardDynamics();
+  return skel->getAccelerations();
+}
+
+//==============================================================================
+/// Computes the derivatives of the function with respect to the positions and
+/// the velocities by central differences
+template <typename Function>
+void computeFiniteDifferences(
+    const SkeletonPtr& skel,
+    Function function,
+    Eigen::MatrixXd& dq,
+    Eigen::MatrixXd& ddq)
+{
+  const double eps = 1e-6;
+  const std::size_t numDofs = skel->getNumDofs();
+  const Eigen::VectorXd positions = skel->getPositions();
+  const Eigen::VectorXd velocities = skel->getVelocities();
+  const Eigen::VectorXd accelerations = skel->getAccelerations();
+
+  dq.resize(numDofs, numDofs);
+  ddq.resize(numDofs, numDofs);
+
+  for (std::size_t i = 0u; i < numDofs; ++i)
+  {
+    movePositions(skel, positions, i, eps);
+    skel->setAccelerations(accelerations);
+    const Eigen::VectorXd plus = function(skel);
+    movePositions(skel, positions, i, -eps);
+    skel->setAccelerations(accelerations);
+    const Eigen::VectorXd minus = function(skel);
+    dq.col(i) = (plus - minus) / (2.0 * eps);
+  }
+  skel->setPositions(positions);
+
+  for (std::size_t i = 0u; i < numDofs; ++i)
+  {
+    Eigen::VectorXd perturbed = velocities;
+    perturbed[i] += eps;
+    skel->setVelocities(perturbed);
+    skel->setAccelerations(accelerations);
+    const Eigen::VectorXd plus = function(skel);
+    perturbed[i] = velocities[i] - eps;
+    skel->setVelocities(perturbed);
+    skel->setAccelerations(accelerations);
+    const Eigen::VectorXd minus = function(skel);
+    ddq.col(i) = (plus - minus) / (2.0 * eps);
+  }
+  skel->setVelocities(velocities);
+  skel->setAccelerations(accelerations);
+}
+
+//==============================================================================
+TEST(SkeletonDerivatives, InverseDynamicsMatchesFiniteDifferences)
+{
+  for (int i = 0; i < 5; ++i)
+  {
+    SkeletonPtr skel = createTree();
+    randomize(skel);
+    skel->getJoint(2)->setActuatorType(Joint::SERVO);
+    skel->getJoint(2)->setPositionServoGain(0, 10.0);
+    skel->getJoint(2)->setVelocityServoGain(0, 1.0);
+
+    SkeletonDerivatives derivatives(skel);
+    derivatives.computeInverseDynamicsDerivatives(true, true, true);
+
+    Eigen::MatrixXd dq;
+    Eigen::MatrixXd ddq;
+    computeFiniteDifferences(skel, computeInverseDynamics, dq, ddq);
+
+    EXPECT_TRUE(equals(derivatives.getForcesPositionDerivatives(), dq, 1e-5));
+    EXPECT_TRUE(equals(derivatives.getForcesVelocityDerivatives(), ddq, 1e-5));
+  }
+}
+
+//==============================================================================
+TEST(SkeletonDerivatives, ForwardDynamicsMatchesFiniteDifferences)
+{
+  for (int i = 0; i < 5; ++i)
+  {
+    SkeletonPtr skel = createTree();
+    randomize(skel);
+    skel->getJoint(3)->setActuatorType(Joint::SERVO);
+    skel->getJoint(3)->setPositionServoGain(0, 10.0);
+    skel->getJoint(3)->setServoTargetVelocity(0, 0.5);
+
+    SkeletonDerivatives derivatives(skel);
+    ASSERT_TRUE(derivatives.computeForwardDynamicsDerivatives());
+    const Eigen::VectorXd accelerations = skel->getAccelerations();
+
+    Eigen::MatrixXd dq;
+    Eigen::MatrixXd ddq;
+    computeFiniteDifferences(skel, computeForwardDynamics, dq, ddq);
+
+    // The accelerations are those of Skeleton::computeForwardDynamics()
+    EXPECT_TRUE(equals(computeForwardDynamics(skel), accelerations));
+
+    EXPECT_TRUE(
+        equals(derivatives.getAccelerationsPositionDerivatives(), dq, 1e-5));
+    EXPECT_TRUE(
+        equals(derivatives.getAccelerationsVelocityDerivatives(), ddq, 1e-5));
+
+    // Derivatives with respect to the commands of the FORCE actuated joints
+    const double eps = 1e-6;
+    const Eigen::VectorXd commands = skel->getCommands();
+    for (std::size_t j = 0u; j < skel->getNumDofs(); ++j)
+    {
+      if (skel->getDof(j)->getJoint()->getActuatorType() != Joint::FORCE)
+        continue;
+
+      skel->setCommand(j, commands[j] + eps);
+      const Eigen::VectorXd plus = computeForwardDynamics(skel);
+      skel->setCommand(j, commands[j] - eps);
+      const Eigen::VectorXd minus = computeForwardDynamics(skel);
+      skel->setCommand(j, commands[j]);
+
+      const Eigen::VectorXd expected = (plus - minus) / (2.0 * eps);
+      const Eigen::VectorXd actual
+          = derivatives.getAccelerationsForceDerivatives().col(j);
+      EXPECT_TRUE(equals(actual, expected, 1e-5));
+    }
+  }
+
+  SkeletonPtr skel = createTree();
+  skel->getJoint(1)->setActuatorType(Joint::VELOCITY);
+  SkeletonDerivatives derivatives(skel);
+  EXPECT_FALSE(derivatives.computeForwardDynamicsDerivatives());
+}
+
+//==============================================================================
+TEST(SkeletonDerivatives, PerformanceComparison)
+{
+#ifndef NDEBUG
+  const int testCount = 1;
+#else
+  const int testCount = 100;
+#endif
+
+  SkeletonPtr skel = createTree();
+  randomize(skel);
+  SkeletonDerivatives derivatives(skel);
+
+  Timer finiteTimer("Finite differences of forward dynamics");
+  finiteTimer.start();
+  for (int i = 0; i < testCount; ++i)
+  {
+    Eigen::MatrixXd dq;
+    Eigen::MatrixXd ddq;
+    computeFiniteDifferences(skel, computeForwardDynamics, dq, ddq);
+  }
+  finiteTimer.stop();
+
+  Timer analyticalTimer("SkeletonDerivatives::computeForwardDynamicsDerivatives");
+  analyticalTimer.start();
+  for (int i = 0; i < testCount; ++i)
+  {
+    // Changing the state invalidates the cached mass matrix, so the comparison
+    // covers the full computation
+    skel->setPositions(skel->getPositions());
+    derivatives.computeForwardDynamicsDerivatives();
+  }
+  analyticalTimer.stop();
+
+  finiteTimer.print();
+  analyticalTimer.print();
+}
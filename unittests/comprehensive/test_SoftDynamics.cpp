@@ -38,6 +38,9 @@
 
 #include "dart/common/Console.hpp"
 #include "dart/math/Constants.hpp"
+#include "dart/math/Geometry.hpp"
+#include "dart/math/Helpers.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
 #include "dart/dynamics/Joint.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/dynamics/SoftBodyNode.hpp"
@@ -458,3 +461,106 @@ TEST_F(SoftDynamicsTest, compareEquationsOfMotion)
 //    compareEquationsOfMotion(getList()[i]);
 //  }
 }
+
+//==============================================================================
+dynamics::SoftBodyNode* createSoftBox(const dynamics::SkeletonPtr& skel)
+{
+  using namespace dynamics;
+
+  SoftBodyNode::UniqueProperties softProperties
+      = SoftBodyNodeHelper::makeBoxProperties(
+          Eigen::Vector3d(0.3, 0.4, 0.5), Eigen::Isometry3d::Identity(),
+          Eigen::Vector3i(4, 4, 4), 0.5, 1000.0, 500.0, 0.1);
+
+  SoftBodyNode::Properties properties(
+        BodyNode::AspectProperties("soft box"), softProperties);
+
+  return skel->createJointAndBodyNodePair<FreeJoint, SoftBodyNode>(
+        nullptr, FreeJoint::Properties(), properties).second;
+}
+
+//==============================================================================
+TEST_F(SoftDynamicsTest, pointMassArrays)
+{
+  auto skel = dynamics::Skeleton::create();
+  dynamics::SoftBodyNode* softBody = createSoftBox(skel);
+  const std::size_t numPointMasses = softBody->getNumPointMasses();
+  ASSERT_GT(numPointMasses, 0u);
+
+  skel->setPositions(Eigen::VectorXd::Random(skel->getNumDofs()));
+  skel->setVelocities(Eigen::VectorXd::Random(skel->getNumDofs()));
+  for (std::size_t i = 0; i < numPointMasses; ++i)
+  {
+    dynamics::PointMass* pm = softBody->getPointMass(i);
+    pm->setPositions(0.01 * Eigen::Vector3d::Random());
+    pm->setVelocities(0.1 * Eigen::Vector3d::Random());
+  }
+
+  const std::vector<Eigen::Vector3d>& localPositions
+      = softBody->getPointMassLocalPositions();
+  const std::vector<Eigen::Vector3d>& worldPositions
+      = softBody->getPointMassWorldPositions();
+  ASSERT_EQ(localPositions.size(), numPointMasses);
+  ASSERT_EQ(worldPositions.size(), numPointMasses);
+
+  const Eigen::Isometry3d& T = softBody->getWorldTransform();
+  const Eigen::Vector6d& V = softBody->getSpatialVelocity();
+  for (std::size_t i = 0; i < numPointMasses; ++i)
+  {
+    const dynamics::PointMass* pm = softBody->getPointMass(i);
+    const Eigen::Vector3d X = pm->getRestingPosition() + pm->getPositions();
+
+    EXPECT_TRUE(equals(localPositions[i], X));
+    EXPECT_TRUE(equals(pm->getLocalPosition(), X));
+    EXPECT_TRUE(equals(worldPositions[i], Eigen::Vector3d(T * X)));
+    EXPECT_TRUE(equals(pm->getWorldPosition(), Eigen::Vector3d(T * X)));
+
+    const Eigen::Vector3d v
+        = V.head<3>().cross(X) + V.tail<3>() + pm->getVelocities();
+    EXPECT_TRUE(equals(pm->getBodyVelocity(), v));
+  }
+
+  // The articulated inertia accumulates the contributions of all the point
+  // masses
+  const double timeStep = 0.001;
+  skel->setTimeStep(timeStep);
+  skel->computeForwardDynamics();
+
+  Eigen::Matrix6d artInertia = softBody->getSpatialInertia();
+  for (std::size_t i = 0; i < numPointMasses; ++i)
+  {
+    const dynamics::PointMass* pm = softBody->getPointMass(i);
+    const Eigen::Matrix3d x = math::makeSkewSymmetric(pm->getLocalPosition());
+    const double pi = pm->getPi();
+
+    artInertia.topLeftCorner<3, 3>() -= pi * x * x;
+    artInertia.topRightCorner<3, 3>() += pi * x;
+    artInertia.bottomLeftCorner<3, 3>() -= pi * x;
+    artInertia.bottomRightCorner<3, 3>() += pi * Eigen::Matrix3d::Identity();
+  }
+  EXPECT_TRUE(equals(softBody->getArticulatedInertia(), artInertia, 1e-10));
+}
+
+//==============================================================================
+TEST_F(SoftDynamicsTest, addAndRemovePointMasses)
+{
+  auto skel = dynamics::Skeleton::create();
+  dynamics::SoftBodyNode* softBody = createSoftBox(skel);
+  const std::size_t numPointMasses = softBody->getNumPointMasses();
+
+  dynamics::PointMass* pm = softBody->addPointMass(
+        dynamics::PointMass::Properties(Eigen::Vector3d::UnitZ(), 0.01));
+  ASSERT_EQ(softBody->getNumPointMasses(), numPointMasses + 1u);
+  EXPECT_EQ(pm, softBody->getPointMass(numPointMasses));
+  EXPECT_EQ(pm->getIndexInSoftBodyNode(), numPointMasses);
+  EXPECT_TRUE(equals(pm->getLocalPosition(), Eigen::Vector3d(0.0, 0.0, 1.0)));
+
+  softBody->connectPointMasses(0u, numPointMasses);
+  skel->computeForwardDynamics();
+  EXPECT_FALSE(math::isNan(pm->getAccelerations()));
+
+  softBody->removeAllPointMasses();
+  EXPECT_EQ(softBody->getNumPointMasses(), 0u);
+  EXPECT_TRUE(softBody->getPointMassLocalPositions().empty());
+  skel->computeForwardDynamics();
+}
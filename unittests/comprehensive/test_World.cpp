@@ -30,15 +30,21 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <chrono>
 #include <iostream>
+#include <limits>
 #include <gtest/gtest.h>
 #include "TestHelpers.hpp"
 
 #include "dart/math/Geometry.hpp"
 #include "dart/utils/SkelParser.hpp"
 #include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
 #include "dart/dynamics/RevoluteJoint.hpp"
 #include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/SoftBodyNode.hpp"
+#include "dart/dynamics/PointMass.hpp"
+#include "dart/dynamics/WeldJoint.hpp"
 #include "dart/collision/collision.hpp"
 #if HAVE_BULLET
   #include "dart/collision/bullet/bullet.hpp"
@@ -172,6 +178,137 @@ TEST(World, AddingAndRemovingSkeletons)
   skeleton1->setName(skeleton4->getName());
 }
 
+//==============================================================================
+TEST(World, AddingAndRemovingSkeletonsInBulk)
+{
+  WorldPtr world = World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+        collision::DARTCollisionDetector::create());
+
+  const std::size_t numSkeletons = 50u;
+  std::vector<SkeletonPtr> skeletons;
+  for (std::size_t i = 0u; i < numSkeletons; ++i)
+  {
+    auto skeleton = createBox(Eigen::Vector3d::Constant(0.1),
+                              Eigen::Vector3d(2.0 * i, 0.0, 0.0));
+    skeleton->setName("box");
+    skeletons.push_back(skeleton);
+  }
+
+  world->addSkeletons(skeletons);
+  EXPECT_EQ(world->getNumSkeletons(), numSkeletons);
+  EXPECT_EQ(world->getConstraintSolver()->getSkeletons().size(), numSkeletons);
+
+  // Adding the same skeletons again doesn't change anything
+  world->addSkeletons(skeletons);
+  EXPECT_EQ(world->getNumSkeletons(), numSkeletons);
+
+  std::set<std::string> names;
+  for (std::size_t i = 0u; i < numSkeletons; ++i)
+  {
+    EXPECT_TRUE(world->getSkeleton(i) == skeletons[i]);
+    EXPECT_TRUE(world->getSkeleton(skeletons[i]->getName()) == skeletons[i]);
+    EXPECT_EQ(world->getIndex(static_cast<int>(i)), static_cast<int>(6u * i));
+    names.insert(skeletons[i]->getName());
+  }
+  EXPECT_EQ(names.size(), numSkeletons);
+
+  // Remove every other skeleton, some of them twice
+  std::vector<SkeletonPtr> removed;
+  std::vector<SkeletonPtr> remaining;
+  for (std::size_t i = 0u; i < numSkeletons; ++i)
+  {
+    if (i % 2u == 0u)
+      removed.push_back(skeletons[i]);
+    else
+      remaining.push_back(skeletons[i]);
+  }
+  const std::string removedName = removed.front()->getName();
+  removed.push_back(removed.front());
+
+  world->removeSkeletons(removed);
+  EXPECT_EQ(world->getNumSkeletons(), remaining.size());
+  EXPECT_EQ(
+      world->getConstraintSolver()->getSkeletons().size(), remaining.size());
+  EXPECT_EQ(world->getRecording()->getNumSkeletons(),
+            static_cast<int>(remaining.size()));
+  EXPECT_TRUE(world->getSkeleton(removedName) == nullptr);
+
+  const auto group = world->getConstraintSolver()->getCollisionGroup();
+  EXPECT_EQ(group->getNumShapeFrames(), remaining.size());
+
+  for (std::size_t i = 0u; i < remaining.size(); ++i)
+  {
+    EXPECT_TRUE(world->getSkeleton(i) == remaining[i]);
+    EXPECT_TRUE(world->hasSkeleton(remaining[i]));
+    EXPECT_EQ(world->getIndex(static_cast<int>(i)), static_cast<int>(6u * i));
+  }
+  EXPECT_EQ(world->getIndex(static_cast<int>(remaining.size())),
+            static_cast<int>(6u * remaining.size()));
+
+  for (const auto& skeleton : removed)
+    EXPECT_FALSE(world->hasSkeleton(skeleton));
+
+  world->step();
+  world->bake();
+  EXPECT_EQ(world->getRecording()->getConfig(0, 1), remaining[1]->getPositions());
+
+  // A removed skeleton gets its old name back when it is added again
+  world->addSkeleton(removed.front());
+  EXPECT_EQ(removed.front()->getName(), removedName);
+
+  world->removeAllSkeletons();
+  EXPECT_EQ(world->getNumSkeletons(), 0u);
+  EXPECT_TRUE(world->getConstraintSolver()->getSkeletons().empty());
+  EXPECT_EQ(group->getNumShapeFrames(), 0u);
+}
+
+//==============================================================================
+double measureAddingSkeletonsInBulk(std::size_t numSkeletons)
+{
+  std::vector<SkeletonPtr> skeletons;
+  skeletons.reserve(numSkeletons);
+  for (std::size_t i = 0u; i < numSkeletons; ++i)
+  {
+    skeletons.push_back(createBox(Eigen::Vector3d::Constant(0.1),
+                                  Eigen::Vector3d(2.0 * i, 0.0, 0.0)));
+  }
+
+  WorldPtr world = World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+        collision::DARTCollisionDetector::create());
+
+  const auto start = std::chrono::steady_clock::now();
+  world->addSkeletons(skeletons);
+  const auto end = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(
+      world->getConstraintSolver()->getCollisionGroup()->getNumShapeFrames(),
+      numSkeletons);
+
+  return std::chrono::duration<double>(end - start).count();
+}
+
+//==============================================================================
+TEST(World, AddingSkeletonsInBulkScalesLinearly)
+{
+  const std::size_t numSkeletons = 2000u;
+
+  // Take the best of a few runs to filter out scheduling noise
+  double smallTime = std::numeric_limits<double>::infinity();
+  double largeTime = std::numeric_limits<double>::infinity();
+  for (int i = 0; i < 3; ++i)
+  {
+    smallTime = std::min(smallTime, measureAddingSkeletonsInBulk(numSkeletons));
+    largeTime = std::min(
+        largeTime, measureAddingSkeletonsInBulk(4u * numSkeletons));
+  }
+
+  // Four times as many skeletons should take about four times as long, while
+  // a quadratic cost would take about sixteen times as long.
+  EXPECT_LT(largeTime, 8.0 * smallTime);
+}
+
 //==============================================================================
 TEST(World, Cloning)
 {
@@ -378,3 +515,288 @@ TEST(World, SetNewConstraintSolver)
   EXPECT_TRUE(world->getConstraintSolver()->getSkeletons().size() == 1);
   EXPECT_TRUE(world->getConstraintSolver()->getConstraints().size() == 1);
 }
+
+//==============================================================================
+TEST(World, Sleeping)
+{
+  auto world = simulation::World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+        collision::DARTCollisionDetector::create());
+  world->setSleepingEnabled(true);
+  world->setSleepVelocityThreshold(0.05);
+  world->setSleepTimeThreshold(0.1);
+
+  auto ground = createGround(Eigen::Vector3d(10.0, 10.0, 1.0),
+                             Eigen::Vector3d(0.0, 0.0, -0.5));
+  ground->setMobile(false);
+  auto box1 = createBox(Eigen::Vector3d::Constant(1.0),
+                        Eigen::Vector3d(0.0, 0.0, 0.5));
+  auto box2 = createBox(Eigen::Vector3d::Constant(1.0),
+                        Eigen::Vector3d(0.0, 0.0, 1.5));
+  auto box3 = createBox(Eigen::Vector3d::Constant(1.0),
+                        Eigen::Vector3d(5.0, 0.0, 3.0));
+
+  world->addSkeleton(ground);
+  world->addSkeleton(box1);
+  world->addSkeleton(box2);
+  world->addSkeleton(box3);
+
+  // The stack of boxes settles down and falls asleep, while the other box is
+  // still falling.
+  for (std::size_t i = 0u; i < 300u; ++i)
+    world->step();
+
+  EXPECT_TRUE(box1->isSleeping());
+  EXPECT_TRUE(box2->isSleeping());
+  EXPECT_FALSE(box3->isSleeping());
+  EXPECT_FALSE(ground->isSleeping());
+
+  // Sleeping skeletons don't move
+  const Eigen::VectorXd positions1 = box1->getPositions();
+  const Eigen::VectorXd positions2 = box2->getPositions();
+  for (std::size_t i = 0u; i < 100u; ++i)
+    world->step();
+  EXPECT_TRUE(box1->isSleeping());
+  EXPECT_TRUE(box2->isSleeping());
+  EXPECT_TRUE(equals(positions1, box1->getPositions(), 0.0));
+  EXPECT_TRUE(equals(positions2, box2->getPositions(), 0.0));
+
+  // An external force wakes up the top box, which then wakes up the bottom box
+  // that it is in contact with.
+  box2->getBodyNode(0)->addExtForce(Eigen::Vector3d(0.0, 0.0, -100.0));
+  world->step();
+  EXPECT_FALSE(box2->isSleeping());
+  world->step();
+  EXPECT_FALSE(box1->isSleeping());
+
+  // Disabling sleeping wakes up all the skeletons
+  for (std::size_t i = 0u; i < 500u; ++i)
+    world->step();
+  EXPECT_TRUE(box1->isSleeping());
+  world->setSleepingEnabled(false);
+  EXPECT_FALSE(box1->isSleeping());
+  EXPECT_FALSE(box2->isSleeping());
+}
+
+//==============================================================================
+TEST(World, SleepingWithPersistentCommand)
+{
+  auto world = simulation::World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+        collision::DARTCollisionDetector::create());
+  world->setSleepingEnabled(true);
+  world->setSleepVelocityThreshold(0.05);
+  world->setSleepTimeThreshold(0.1);
+
+  auto ground = createGround(Eigen::Vector3d(10.0, 10.0, 1.0),
+                             Eigen::Vector3d(0.0, 0.0, -0.5));
+  ground->setMobile(false);
+  auto box = createBox(Eigen::Vector3d::Constant(1.0),
+                       Eigen::Vector3d(0.0, 0.0, 0.5));
+
+  world->addSkeleton(ground);
+  world->addSkeleton(box);
+
+  // A command that presses the box against the ground is set every step. The
+  // box falls asleep once and then stays asleep instead of being woken up by
+  // its own command.
+  const auto stepWithCommand = [&]()
+  {
+    box->setCommand(5u, -10.0);
+    world->step();
+  };
+
+  for (std::size_t i = 0u; i < 300u; ++i)
+    stepWithCommand();
+  ASSERT_TRUE(box->isSleeping());
+
+  for (std::size_t i = 0u; i < 100u; ++i)
+  {
+    stepWithCommand();
+    EXPECT_TRUE(box->isSleeping());
+  }
+
+  // Removing the command is a disturbance
+  world->step();
+  EXPECT_FALSE(box->isSleeping());
+
+  // Changing the number of DOFs of a sleeping skeleton wakes it up instead of
+  // comparing vectors of different sizes
+  for (std::size_t i = 0u; i < 300u; ++i)
+    world->step();
+  ASSERT_TRUE(box->isSleeping());
+  box->getRootBodyNode()->changeParentJointType<dynamics::WeldJoint>();
+  world->step();
+  EXPECT_FALSE(box->isSleeping());
+}
+
+//==============================================================================
+TEST(World, AdaptiveTimeStepping)
+{
+  auto world = simulation::World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+        collision::DARTCollisionDetector::create());
+  world->setAdaptiveTimeSteppingEnabled(true);
+  world->setAdaptiveTimeStepTolerance(1e-3);
+  world->setAdaptiveTimeStepLimits(1e-5, 0.01);
+
+  auto ground = createGround(Eigen::Vector3d(10.0, 10.0, 1.0),
+                             Eigen::Vector3d(0.0, 0.0, -0.5));
+  ground->setMobile(false);
+  auto box = createBox(Eigen::Vector3d::Constant(1.0),
+                       Eigen::Vector3d(0.0, 0.0, 3.0));
+
+  world->addSkeleton(ground);
+  world->addSkeleton(box);
+
+  // The time step grows up to the upper bound in free flight
+  double time = 0.0;
+  for (std::size_t i = 0u; i < 10u; ++i)
+  {
+    world->step();
+    time += world->getLastTimeStep();
+  }
+  EXPECT_DOUBLE_EQ(world->getLastTimeStep(), 0.01);
+  EXPECT_NEAR(world->getTime(), time, 1e-12);
+
+  // The collision onset is refined, and the time step is limited to the fixed
+  // time step while in contact
+  while (world->getTime() < 2.0)
+    world->step();
+  EXPECT_TRUE(world->getLastCollisionResult().isCollision());
+  EXPECT_LE(world->getLastTimeStep(), world->getTimeStep() + 1e-12);
+  EXPECT_GT(world->getNumRejectedTimeSteps(), 0u);
+  EXPECT_GT(box->getPositions()[5], 0.45);
+
+  // Disabling adaptive time stepping restores the fixed time step
+  world->setAdaptiveTimeSteppingEnabled(false);
+  world->step();
+  EXPECT_DOUBLE_EQ(world->getLastTimeStep(), world->getTimeStep());
+}
+
+//==============================================================================
+WorldPtr createSoftBoxWorld()
+{
+  auto world = World::create();
+  world->setGravity(Eigen::Vector3d::Zero());
+
+  auto skel = Skeleton::create("soft");
+  const SoftBodyNode::UniqueProperties softProperties
+      = SoftBodyNodeHelper::makeBoxProperties(
+          Eigen::Vector3d(0.3, 0.4, 0.5), Eigen::Isometry3d::Identity(),
+          Eigen::Vector3i(3, 3, 3), 0.5, 1000.0, 500.0, 0.1);
+  SoftBodyNode* softBody
+      = skel->createJointAndBodyNodePair<FreeJoint, SoftBodyNode>(
+            nullptr, FreeJoint::Properties(),
+            SoftBodyNode::Properties(
+                BodyNode::AspectProperties("soft box"), softProperties))
+            .second;
+
+  // Make the box wobble while it flies
+  Eigen::Vector6d velocities = Eigen::Vector6d::Zero();
+  velocities << 0.5, 0.0, 0.0, 0.0, 0.0, 1.0;
+  skel->setVelocities(velocities);
+  for (std::size_t i = 0u; i < softBody->getNumPointMasses(); ++i)
+  {
+    softBody->getPointMass(i)->setVelocities(
+        Eigen::Vector3d(0.0, 0.0, (i % 2u == 0u) ? 0.5 : -0.5));
+  }
+
+  world->addSkeleton(skel);
+
+  return world;
+}
+
+//==============================================================================
+TEST(World, AdaptiveTimeSteppingWithSoftBodies)
+{
+  // An accepted adaptive step keeps the result of two half steps. The point
+  // masses of soft bodies must be rolled back with the rest of the state, or
+  // they would also be integrated by the full step and by rejected steps.
+  auto world = createSoftBoxWorld();
+  world->setAdaptiveTimeSteppingEnabled(true);
+  world->setAdaptiveTimeStepTolerance(1e-6);
+  world->setAdaptiveTimeStepLimits(1e-5, 0.01);
+
+  auto reference = createSoftBoxWorld();
+
+  SoftBodyNode* softBody = world->getSkeleton(0)->getSoftBodyNode(0);
+  SoftBodyNode* referenceSoftBody
+      = reference->getSkeleton(0)->getSoftBodyNode(0);
+
+  for (std::size_t i = 0u; i < 50u; ++i)
+  {
+    world->step();
+
+    reference->setTimeStep(0.5 * world->getLastTimeStep());
+    reference->step();
+    reference->step();
+
+    ASSERT_TRUE(world->getSkeleton(0)->getPositions().isApprox(
+        reference->getSkeleton(0)->getPositions(), 1e-9));
+    for (std::size_t j = 0u; j < softBody->getNumPointMasses(); ++j)
+    {
+      const PointMass* pointMass = softBody->getPointMass(j);
+      const PointMass* referencePointMass = referenceSoftBody->getPointMass(j);
+      ASSERT_TRUE(pointMass->getPositions().isApprox(
+          referencePointMass->getPositions(), 1e-9));
+      ASSERT_TRUE(pointMass->getVelocities().isApprox(
+          referencePointMass->getVelocities(), 1e-9));
+    }
+  }
+
+  // The wobbling of the point masses is part of the error estimate
+  EXPECT_GT(world->getNumRejectedTimeSteps(), 0u);
+}
+
+//==============================================================================
+TEST(World, AdaptiveTimeSteppingCatchesCollisionOnset)
+{
+  auto world = simulation::World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+        collision::DARTCollisionDetector::create());
+  world->setAdaptiveTimeSteppingEnabled(true);
+  world->setAdaptiveTimeStepTolerance(1e-3);
+  world->setAdaptiveTimeStepLimits(1e-5, 0.01);
+
+  auto ground = createGround(Eigen::Vector3d(10.0, 10.0, 1.0),
+                             Eigen::Vector3d(0.0, 0.0, -0.5));
+  ground->setMobile(false);
+  auto box = createBox(Eigen::Vector3d::Constant(1.0),
+                       Eigen::Vector3d(0.0, 0.0, 3.0));
+
+  world->addSkeleton(ground);
+  world->addSkeleton(box);
+
+  // The box falls from a height of 2.5 m
+  const double impactSpeed = std::sqrt(2.0 * 9.81 * 2.5);
+
+  // Step until the box touches the ground. The step that ran into the contact
+  // must have been refined to the fixed time step.
+  const auto isTouching = [&]() {
+    return box->getBodyNode(0)->getWorldTransform().translation()[2] < 0.5;
+  };
+  while (!isTouching())
+  {
+    ASSERT_LT(world->getTime(), 2.0);
+    world->step();
+  }
+  EXPECT_GT(world->getNumRejectedTimeSteps(), 0u);
+  EXPECT_LE(world->getLastTimeStep(), world->getTimeStep() + 1e-12);
+
+  // The constraint solver sees the contact within the next step at the latest,
+  // so the box penetrates the ground by at most the distance it falls in one
+  // fixed time step.
+  if (!world->getLastCollisionResult().isCollision())
+    world->step();
+  ASSERT_TRUE(world->getLastCollisionResult().isCollision());
+
+  double penetration = 0.0;
+  const auto& result = world->getLastCollisionResult();
+  for (std::size_t i = 0u; i < result.getNumContacts(); ++i)
+    penetration = std::max(penetration, result.getContact(i).penetrationDepth);
+  EXPECT_LT(penetration, 1.1 * impactSpeed * world->getTimeStep());
+
+  // The contact stops the box in the same step
+  EXPECT_GT(box->getVelocities()[5], -0.1 * impactSpeed);
+}
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <limits>
+#include <gtest/gtest.h>
+
+#include "dart/external/odelcpsolver/lcp.h"
+
+#include "dart/constraint/BlockPgsBoxedLcpSolver.hpp"
+#include "dart/constraint/DantzigBoxedLcpSolver.hpp"
+#include "dart/math/Random.hpp"
+
+using namespace dart;
+
+namespace {
+
+//==============================================================================
+/// Boxed LCP with padded row-major A in the layout that BoxedLcpSolver expects
+struct BoxedLcp
+{
+  int n;
+  int nSkip;
+  std::vector<double> A;
+  Eigen::VectorXd b;
+  Eigen::VectorXd lo;
+  Eigen::VectorXd hi;
+  Eigen::VectorXi findex;
+
+  /// Rows of the contacts on each body in the format of
+  /// BoxedLcpSolver::setRowCoupling()
+  std::vector<int> groupStarts;
+  std::vector<int> groupRows;
+
+  double& a(int i, int j)
+  {
+    return A[static_cast<std::size_t>(nSkip * i + j)];
+  }
+};
+
+//==============================================================================
+/// Creates the LCP of numContacts frictional contacts on a chain of free
+/// bodies where contact i is shared by the bodies i and i + 1. Only the
+/// neighboring contacts are coupled, so A is block tridiagonal.
+BoxedLcp createContactChain(int numContacts, double mu)
+{
+  const int numBodies = numContacts + 1;
+  const int n = 3 * numContacts;
+
+  Eigen::MatrixXd J = Eigen::MatrixXd::Zero(n, 6 * numBodies);
+  for (int i = 0; i < numContacts; ++i)
+  {
+    J.block(3 * i, 6 * i, 3, 6)
+        = math::Random::uniform<Eigen::MatrixXd>(3, 6, -1.0, 1.0);
+    J.block(3 * i, 6 * (i + 1), 3, 6)
+        = math::Random::uniform<Eigen::MatrixXd>(3, 6, -1.0, 1.0);
+  }
+  Eigen::MatrixXd dense = J * J.transpose();
+  dense.diagonal() *= 1.0 + 1e-3;
+
+  BoxedLcp lcp;
+  lcp.n = n;
+  lcp.nSkip = dPAD(n);
+  lcp.A.assign(static_cast<std::size_t>(n * lcp.nSkip), 0.0);
+  for (int i = 0; i < n; ++i)
+  {
+    for (int j = 0; j < n; ++j)
+      lcp.a(i, j) = dense(i, j);
+  }
+
+  lcp.b = math::Random::uniform<Eigen::VectorXd>(n, -1.0, 1.0);
+  lcp.lo.resize(n);
+  lcp.hi.resize(n);
+  lcp.findex.resize(n);
+  for (int i = 0; i < numContacts; ++i)
+  {
+    lcp.lo[3 * i] = 0.0;
+    lcp.hi[3 * i] = static_cast<double>(dInfinity);
+    lcp.findex[3 * i] = -1;
+    for (int k = 1; k < 3; ++k)
+    {
+      lcp.lo[3 * i + k] = -mu;
+      lcp.hi[3 * i + k] = mu;
+      lcp.findex[3 * i + k] = 3 * i;
+    }
+  }
+
+  for (int body = 0; body < numBodies; ++body)
+  {
+    lcp.groupStarts.push_back(static_cast<int>(lcp.groupRows.size()));
+    for (int i = std::max(0, body - 1); i < std::min(numContacts, body + 1); ++i)
+    {
+      for (int k = 0; k < 3; ++k)
+        lcp.groupRows.push_back(3 * i + k);
+    }
+  }
+  lcp.groupStarts.push_back(static_cast<int>(lcp.groupRows.size()));
+
+  return lcp;
+}
+
+//==============================================================================
+/// Returns the largest violation of the LCP conditions by x
+double computeViolation(BoxedLcp lcp, const Eigen::VectorXd& x)
+{
+  double violation = 0.0;
+  for (int i = 0; i < lcp.n; ++i)
+  {
+    double w = -lcp.b[i];
+    for (int j = 0; j < lcp.n; ++j)
+      w += lcp.a(i, j) * x[j];
+
+    double lo = lcp.lo[i];
+    double hi = lcp.hi[i];
+    if (lcp.findex[i] >= 0)
+    {
+      hi = lcp.hi[i] * x[lcp.findex[i]];
+      lo = -hi;
+    }
+
+    violation = std::max(violation, std::max(lo - x[i], x[i] - hi));
+    if (hi - lo < 1e-9)
+      continue;
+
+    if (x[i] > lo + 1e-9 && x[i] < hi - 1e-9)
+      violation = std::max(violation, std::abs(w));
+    else if (x[i] <= lo + 1e-9)
+      violation = std::max(violation, -w);
+    else
+      violation = std::max(violation, w);
+  }
+
+  return violation;
+}
+
+//==============================================================================
+bool solve(
+    constraint::BoxedLcpSolver& solver, BoxedLcp lcp, Eigen::VectorXd& x)
+{
+  return solver.solve(
+      lcp.n,
+      lcp.A.data(),
+      x.data(),
+      lcp.b.data(),
+      0,
+      lcp.lo.data(),
+      lcp.hi.data(),
+      lcp.findex.data(),
+      false);
+}
+
+} // namespace
+
+//==============================================================================
+TEST(BlockPgsBoxedLcpSolver, FrictionlessContacts)
+{
+  math::Random::setSeed(0);
+  // Frictionless contacts with a positive definite A have a unique solution
+  const BoxedLcp lcp = createContactChain(20, 0.0);
+
+  constraint::DantzigBoxedLcpSolver dantzig;
+  Eigen::VectorXd expected = Eigen::VectorXd::Zero(lcp.n);
+  ASSERT_TRUE(solve(dantzig, lcp, expected));
+
+  constraint::BlockPgsBoxedLcpSolver solver;
+  solver.setOption(constraint::BlockPgsBoxedLcpSolver::Option(
+      10000, 4, 1e-12, 1e-10, 1e-9, true));
+  Eigen::VectorXd x = Eigen::VectorXd::Zero(lcp.n);
+  EXPECT_TRUE(solve(solver, lcp, x));
+  EXPECT_TRUE(x.isApprox(expected, 1e-6));
+
+  // Only the neighboring contacts are coupled
+  EXPECT_EQ(solver.getNumOffDiagonalBlocks(), 2u * (20u - 1u));
+}
+
+//==============================================================================
+TEST(BlockPgsBoxedLcpSolver, FrictionalContacts)
+{
+  math::Random::setSeed(1);
+  const BoxedLcp lcp = createContactChain(50, 0.5);
+
+  constraint::BlockPgsBoxedLcpSolver solver;
+  solver.setOption(constraint::BlockPgsBoxedLcpSolver::Option(
+      10000, 4, 1e-12, 1e-10, 1e-9, true));
+  Eigen::VectorXd x = Eigen::VectorXd::Zero(lcp.n);
+  EXPECT_TRUE(solve(solver, lcp, x));
+  EXPECT_LT(computeViolation(lcp, x), 1e-6);
+}
+
+//==============================================================================
+TEST(BlockPgsBoxedLcpSolver, WarmStart)
+{
+  math::Random::setSeed(2);
+  const BoxedLcp lcp = createContactChain(30, 0.5);
+
+  constraint::BlockPgsBoxedLcpSolver solver;
+  Eigen::VectorXd x = Eigen::VectorXd::Zero(lcp.n);
+  solver.setOption(constraint::BlockPgsBoxedLcpSolver::Option(
+      10000, 4, 1e-12, 1e-10, 1e-9, true));
+  ASSERT_TRUE(solve(solver, lcp, x));
+  const Eigen::VectorXd solution = x;
+
+  // Starting from the solution, a single iteration is enough
+  solver.setOption(constraint::BlockPgsBoxedLcpSolver::Option(
+      1, 4, 1e-6, 1e-3, 1e-9, true));
+  EXPECT_TRUE(solve(solver, lcp, x));
+  EXPECT_TRUE(x.isApprox(solution, 1e-6));
+
+  // Without warm starting, the same solve starts from zero and doesn't
+  // converge in a single iteration
+  solver.setOption(constraint::BlockPgsBoxedLcpSolver::Option(
+      1, 4, 1e-6, 1e-3, 1e-9, false));
+  EXPECT_FALSE(solve(solver, lcp, x));
+}
+
+//==============================================================================
+TEST(BlockPgsBoxedLcpSolver, RowCoupling)
+{
+  math::Random::setSeed(3);
+  const BoxedLcp lcp = createContactChain(40, 0.5);
+  const constraint::BlockPgsBoxedLcpSolver::Option option(
+      10000, 4, 1e-12, 1e-10, 1e-9, true);
+
+  constraint::BlockPgsBoxedLcpSolver solver;
+  solver.setOption(option);
+  Eigen::VectorXd expected = Eigen::VectorXd::Zero(lcp.n);
+  ASSERT_TRUE(solve(solver, lcp, expected));
+
+  // With the row coupling, the entries of uncoupled rows are never read, so
+  // filling them with NaN doesn't change the solution
+  BoxedLcp corrupted = lcp;
+  for (int i = 0; i < lcp.n; ++i)
+  {
+    for (int j = 0; j < lcp.n; ++j)
+    {
+      if (std::abs(i / 3 - j / 3) > 1)
+        corrupted.a(i, j) = std::numeric_limits<double>::quiet_NaN();
+    }
+  }
+
+  Eigen::VectorXd x = Eigen::VectorXd::Zero(lcp.n);
+  solver.setRowCoupling(lcp.groupStarts, lcp.groupRows);
+  EXPECT_TRUE(solve(solver, corrupted, x));
+  EXPECT_FALSE(x.hasNaN());
+  EXPECT_TRUE(x.isApprox(expected, 1e-6));
+  EXPECT_EQ(solver.getNumOffDiagonalBlocks(), 2u * (40u - 1u));
+
+  // The row coupling only applies to a single solve
+  x.setZero();
+  solve(solver, corrupted, x);
+  EXPECT_TRUE(x.hasNaN());
+}
+
+//==============================================================================
+TEST(DantzigBoxedLcpSolver, ReusesWorkspace)
+{
+  math::Random::setSeed(4);
+  // Solves problems of growing and shrinking size with the same solver, which
+  // reuses its workspace, and compares the solutions with the ones of fresh
+  // solvers.
+  constraint::DantzigBoxedLcpSolver solver;
+  for (const int numContacts : {5, 40, 10, 40, 25})
+  {
+    const BoxedLcp lcp = createContactChain(numContacts, 0.5);
+
+    constraint::DantzigBoxedLcpSolver freshSolver;
+    Eigen::VectorXd expected = Eigen::VectorXd::Zero(lcp.n);
+    ASSERT_TRUE(solve(freshSolver, lcp, expected));
+
+    Eigen::VectorXd x = Eigen::VectorXd::Zero(lcp.n);
+    EXPECT_TRUE(solve(solver, lcp, x));
+    EXPECT_TRUE(x.isApprox(expected));
+  }
+}
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "dart/common/LocalResourceRetriever.hpp"
+#include "dart/common/MemoryResource.hpp"
+#include "dart/common/Platform.hpp"
+#include "dart/utils/CachingResourceRetriever.hpp"
+#include "dart/utils/DartResourceRetriever.hpp"
+#include "TestHelpers.hpp"
+
+using dart::common::LocalResourceRetriever;
+using dart::common::MemoryResource;
+using dart::common::Resource;
+using dart::common::Uri;
+using dart::utils::CachingResourceRetriever;
+using dart::utils::DartResourceRetriever;
+
+//==============================================================================
+TEST(MemoryResource, SeekAndRead)
+{
+  const std::string text = "0123456789";
+  const auto data = std::make_shared<std::string>(text);
+  MemoryResource resource(
+      std::shared_ptr<const void>(data, data->data()), data->size());
+
+  EXPECT_EQ(text.size(), resource.getSize());
+  EXPECT_EQ(0u, resource.tell());
+
+  char buffer[4];
+  EXPECT_EQ(2u, resource.read(buffer, 2, 2));
+  EXPECT_EQ(0, std::strncmp(buffer, "0123", 4));
+  EXPECT_EQ(4u, resource.tell());
+
+  EXPECT_TRUE(resource.seek(-2, Resource::SEEKTYPE_END));
+  EXPECT_EQ(8u, resource.tell());
+
+  // Only complete elements are read
+  EXPECT_EQ(0u, resource.read(buffer, 4, 1));
+  EXPECT_EQ(2u, resource.read(buffer, 1, 4));
+  EXPECT_EQ(0, std::strncmp(buffer, "89", 2));
+
+  EXPECT_FALSE(resource.seek(1, Resource::SEEKTYPE_END));
+  EXPECT_FALSE(resource.seek(-11, Resource::SEEKTYPE_CUR));
+  EXPECT_TRUE(resource.seek(3, Resource::SEEKTYPE_SET));
+  EXPECT_EQ(3u, resource.tell());
+
+  EXPECT_EQ(text, resource.readAll());
+}
+
+//==============================================================================
+TEST(CachingResourceRetriever, RetrievesOnlyOnce)
+{
+  auto mockRetriever = std::make_shared<PresentResourceRetriever>();
+  CachingResourceRetriever retriever(mockRetriever);
+
+  const auto uri = Uri::createFromString("package://test/foo");
+  EXPECT_TRUE(nullptr != retriever.retrieve(uri));
+  EXPECT_TRUE(nullptr != retriever.retrieve(uri));
+  EXPECT_TRUE(retriever.exists(uri));
+
+  EXPECT_EQ(1u, mockRetriever->mRetrieve.size());
+  EXPECT_TRUE(mockRetriever->mExists.empty());
+  EXPECT_EQ(1u, retriever.getNumCachedResources());
+
+  retriever.clearCache();
+  EXPECT_EQ(0u, retriever.getNumCachedResources());
+  EXPECT_TRUE(nullptr != retriever.retrieve(uri));
+  EXPECT_EQ(2u, mockRetriever->mRetrieve.size());
+}
+
+//==============================================================================
+TEST(CachingResourceRetriever, FailuresAreNotCached)
+{
+  auto mockRetriever = std::make_shared<AbsentResourceRetriever>();
+  CachingResourceRetriever retriever(mockRetriever);
+
+  const auto uri = Uri::createFromString("package://test/foo");
+  EXPECT_EQ(nullptr, retriever.retrieve(uri));
+  EXPECT_EQ(nullptr, retriever.retrieve(uri));
+  EXPECT_FALSE(retriever.exists(uri));
+
+  EXPECT_EQ(2u, mockRetriever->mRetrieve.size());
+  EXPECT_EQ(1u, mockRetriever->mExists.size());
+  EXPECT_EQ(0u, retriever.getNumCachedResources());
+}
+
+//==============================================================================
+TEST(CachingResourceRetriever, MatchesUncachedContent)
+{
+  auto dartRetriever = DartResourceRetriever::create();
+  auto retriever = std::make_shared<CachingResourceRetriever>(dartRetriever);
+
+  const std::vector<std::string> uris = {
+    "dart://sample/skel/shapes.skel",
+    "dart://sample/obj/BoxSmall.obj",
+    "dart://sample/urdf/KR5/ground.urdf"
+  };
+
+  std::size_t totalSize = 0u;
+  for (const auto& uri : uris)
+  {
+    const std::string expected = dartRetriever->readAll(uri);
+    totalSize += expected.size();
+
+    EXPECT_EQ(expected, retriever->readAll(uri));
+    EXPECT_EQ(expected, retriever->readAll(uri));
+    EXPECT_EQ(dartRetriever->getFilePath(uri), retriever->getFilePath(uri));
+  }
+
+  EXPECT_EQ(uris.size(), retriever->getNumCachedResources());
+  EXPECT_EQ(totalSize, retriever->getCacheSize());
+
+  // Cached resources can be read from several threads at once, each with its
+  // own position.
+  const std::string expected = dartRetriever->readAll(uris[0]);
+  std::vector<std::thread> threads;
+  std::vector<int> matches(4, 0);
+  for (std::size_t i = 0u; i < matches.size(); ++i)
+  {
+    threads.emplace_back([&, i]()
+    {
+      for (int j = 0; j < 10; ++j)
+        matches[i] += retriever->readAll(uris[0]) == expected;
+    });
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+
+  for (const int match : matches)
+    EXPECT_EQ(10, match);
+}
+
+//==============================================================================
+void writeFile(const std::string& path, const std::string& content)
+{
+  std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+  ofs << content;
+}
+
+//==============================================================================
+TEST(CachingResourceRetriever, Evict)
+{
+  auto mockRetriever = std::make_shared<PresentResourceRetriever>();
+  CachingResourceRetriever retriever(mockRetriever);
+
+  const auto foo = Uri::createFromString("package://test/foo");
+  const auto bar = Uri::createFromString("package://test/bar");
+  EXPECT_TRUE(nullptr != retriever.retrieve(foo));
+  EXPECT_TRUE(nullptr != retriever.retrieve(bar));
+  EXPECT_EQ(2u, retriever.getNumCachedResources());
+
+  EXPECT_TRUE(retriever.evict(foo));
+  EXPECT_FALSE(retriever.evict(foo));
+  EXPECT_EQ(1u, retriever.getNumCachedResources());
+
+  // Only the evicted resource is retrieved again
+  EXPECT_TRUE(nullptr != retriever.retrieve(foo));
+  EXPECT_TRUE(nullptr != retriever.retrieve(bar));
+  EXPECT_EQ(3u, mockRetriever->mRetrieve.size());
+}
+
+#if DART_OS_LINUX || DART_OS_MACOS
+//==============================================================================
+TEST(CachingResourceRetriever, ReloadsChangedSmallFiles)
+{
+  const std::string path = "test_caching_resource_retriever_small.txt";
+  const auto uri = Uri::createFromString(path);
+  CachingResourceRetriever retriever(
+      std::make_shared<LocalResourceRetriever>());
+
+  writeFile(path, "first");
+  EXPECT_EQ("first", retriever.readAll(uri));
+  EXPECT_EQ("first", retriever.readAll(uri));
+
+  // Rewriting the file in place is safe, since small files are copied
+  const auto resource = retriever.retrieve(uri);
+  writeFile(path, "second version");
+  EXPECT_EQ("first", resource->readAll());
+  EXPECT_EQ("second version", retriever.readAll(uri));
+  EXPECT_EQ(1u, retriever.getNumCachedResources());
+  EXPECT_EQ(14u, retriever.getCacheSize());
+
+  std::remove(path.c_str());
+  EXPECT_EQ(nullptr, retriever.retrieve(uri));
+  EXPECT_EQ(0u, retriever.getNumCachedResources());
+}
+
+//==============================================================================
+TEST(CachingResourceRetriever, ReloadsReplacedMappedFiles)
+{
+  const std::string path = "test_caching_resource_retriever_large.bin";
+  const std::string newPath = path + ".new";
+  const auto uri = Uri::createFromString(path);
+  CachingResourceRetriever retriever(
+      std::make_shared<LocalResourceRetriever>());
+
+  const std::string first(CachingResourceRetriever::MinMappedFileSize, 'a');
+  const std::string second(CachingResourceRetriever::MinMappedFileSize, 'b');
+
+  writeFile(path, first);
+  const auto resource = retriever.retrieve(uri);
+  ASSERT_TRUE(nullptr != resource);
+
+  // Replace the file instead of rewriting it, as a mapped file must not be
+  // changed in place.
+  writeFile(newPath, second);
+  ASSERT_EQ(0, std::rename(newPath.c_str(), path.c_str()));
+
+  EXPECT_EQ(second, retriever.readAll(uri));
+  EXPECT_EQ(1u, retriever.getNumCachedResources());
+
+  // Resources retrieved earlier keep the content of the replaced file
+  EXPECT_EQ(first, resource->readAll());
+
+  std::remove(path.c_str());
+}
+#endif
@@ -38,6 +38,7 @@
 #include "dart/dynamics/BoxShape.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include <dart/dynamics/SphereShape.hpp>
+#include "dart/dynamics/SimpleFrame.hpp"
 
 #include "dart/simulation/World.hpp"
 #include "dart/constraint/ConstraintSolver.hpp"
@@ -265,5 +266,60 @@ TEST_P(CollisionGroupsTest, BodyNodeSubscription)
   EXPECT_FALSE(group->collide());
 }
 
+TEST_P(CollisionGroupsTest, MovingShapeFrames)
+{
+  if(!dart::collision::CollisionDetector::getFactory()->canCreate(GetParam()))
+  {
+    std::cout << "Skipping test for [" << GetParam() << "], because it is not "
+              << "available" << std::endl;
+    return;
+  }
+  else
+  {
+    std::cout << "Running CollisionGroups test for [" << GetParam() << "]"
+              << std::endl;
+  }
+
+  auto cd = dart::collision::CollisionDetector::getFactory()
+      ->create(GetParam());
+
+  auto group = cd->createCollisionGroup();
+
+  auto sphere = std::make_shared<dart::dynamics::SphereShape>(0.5);
+
+  // The parent frame doesn't have a shape, so only the motion of its child is
+  // observed by the collision group.
+  auto parent = dart::dynamics::SimpleFrame::createShared(
+        dart::dynamics::Frame::World(), "parent");
+  auto frame1 = parent->spawnChildSimpleFrame("frame1");
+  frame1->setShape(sphere);
+
+  auto frame2 = dart::dynamics::SimpleFrame::createShared(
+        dart::dynamics::Frame::World(), "frame2");
+  frame2->setShape(sphere);
+  frame2->setTranslation(Eigen::Vector3d(2.0, 0.0, 0.0));
+
+  group->addShapeFrames({frame1.get(), frame2.get()});
+  EXPECT_FALSE(group->collide());
+
+  // Only the engine data of the moved frame gets updated, which must still be
+  // reflected in the results.
+  frame2->setTranslation(Eigen::Vector3d(0.5, 0.0, 0.0));
+  EXPECT_TRUE(group->collide());
+
+  // Nothing moved, so the results should stay the same
+  EXPECT_TRUE(group->collide());
+
+  // Moving the parent frame should move its child as well
+  parent->setTranslation(Eigen::Vector3d(0.0, 2.0, 0.0));
+  EXPECT_FALSE(group->collide());
+
+  parent->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.0));
+  EXPECT_TRUE(group->collide());
+
+  frame1->setTranslation(Eigen::Vector3d(-1.0, 0.0, 0.0));
+  EXPECT_FALSE(group->collide());
+}
+
 INSTANTIATE_TEST_CASE_P(CollisionEngine, CollisionGroupsTest,
                         testing::Values("dart", "fcl", "bullet", "ode"));
@@ -268,3 +268,29 @@ TEST(CompositeResourceRetriever, retrieve_DefaultResourceRetrieverSucceeds_Retur
   EXPECT_TRUE(retriever3->mExists.empty());
   EXPECT_TRUE(retriever3->mRetrieve.empty());
 }
+
+TEST(CompositeResourceRetriever, retrieve_TriesLastSuccessfulRetrieverFirst)
+{
+  auto retriever1 = std::make_shared<AbsentResourceRetriever>();
+  auto retriever2 = std::make_shared<PresentResourceRetriever>();
+  CompositeResourceRetriever retriever;
+
+  EXPECT_TRUE(retriever.addSchemaRetriever("package", retriever1));
+  retriever.addDefaultRetriever(retriever2);
+
+  const auto uri = Uri::createFromString("package://test/foo");
+  EXPECT_TRUE(nullptr != retriever.retrieve(uri));
+  EXPECT_TRUE(nullptr != retriever.retrieve(uri));
+  EXPECT_TRUE(retriever.exists(uri));
+
+  // Only the first lookup falls through the failing schema retriever.
+  EXPECT_EQ(1u, retriever1->mRetrieve.size());
+  EXPECT_TRUE(retriever1->mExists.empty());
+  EXPECT_EQ(2u, retriever2->mRetrieve.size());
+  EXPECT_EQ(1u, retriever2->mExists.size());
+
+  // Registering a retriever forgets what was learned.
+  retriever.addDefaultRetriever(std::make_shared<AbsentResourceRetriever>());
+  EXPECT_TRUE(nullptr != retriever.retrieve(uri));
+  EXPECT_EQ(2u, retriever1->mRetrieve.size());
+}
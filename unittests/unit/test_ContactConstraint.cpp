@@ -34,6 +34,8 @@
 
 #include "TestHelpers.hpp"
 
+#include "dart/external/odelcpsolver/lcp.h"
+
 #include "dart/common/common.hpp"
 #include "dart/dynamics/dynamics.hpp"
 #include "dart/constraint/constraint.hpp"
@@ -104,3 +106,151 @@ TEST(ContactConstraint, ContactWithKinematicJoint)
         std::make_shared<constraint::PgsBoxedLcpSolver>(), 1e-4);
 #endif
 }
+
+//==============================================================================
+class DelassusMatrixComparison : public constraint::BoxedLcpConstraintSolver
+{
+public:
+  DelassusMatrixComparison()
+    : constraint::BoxedLcpConstraintSolver(
+          std::make_shared<constraint::DantzigBoxedLcpSolver>())
+  {
+    // Do nothing
+  }
+
+  std::size_t mNumComparedGroups = 0u;
+
+protected:
+  void solveConstrainedGroup(constraint::ConstrainedGroup& group) override
+  {
+    const std::size_t numConstraints = group.getNumConstraints();
+    const std::size_t n = group.getTotalDimension();
+
+    mOffset.resize(n);
+    mOffset[0] = 0;
+    for (std::size_t i = 1; i < numConstraints; ++i)
+      mOffset[i] = mOffset[i - 1] + group.getConstraint(i - 1)->getDimension();
+
+    mA.setZero(n, dPAD(n));
+    assembleDelassusMatrixByImpulseTests(group);
+    const Eigen::MatrixXd expected = mA.leftCols(n);
+
+    setDelassusAssembly(DelassusAssembly::JACOBIAN);
+    mA.setConstant(n, dPAD(n), 1.0);
+    EXPECT_TRUE(assembleDelassusMatrixByJacobians(group));
+    EXPECT_TRUE(equals(expected, Eigen::MatrixXd(mA.leftCols(n)), 1e-9));
+    ++mNumComparedGroups;
+
+    // The row coupling passed to the LCP solvers covers all the nonzero
+    // entries of A
+    setRowCoupling();
+    EXPECT_GT(mCouplingGroupStarts.size(), 1u);
+    Eigen::MatrixXi coupled = Eigen::MatrixXi::Identity(n, n);
+    for (std::size_t g = 0u; g + 1u < mCouplingGroupStarts.size(); ++g)
+    {
+      for (int p = mCouplingGroupStarts[g]; p < mCouplingGroupStarts[g + 1u];
+           ++p)
+      {
+        for (int q = mCouplingGroupStarts[g]; q < mCouplingGroupStarts[g + 1u];
+             ++q)
+        {
+          coupled(mCouplingRows[p], mCouplingRows[q]) = 1;
+        }
+      }
+    }
+    for (std::size_t i = 0u; i < n; ++i)
+    {
+      for (std::size_t j = 0u; j < n; ++j)
+      {
+        if (expected(i, j) != 0.0)
+          EXPECT_EQ(coupled(i, j), 1);
+      }
+    }
+
+    constraint::BoxedLcpConstraintSolver::solveConstrainedGroup(group);
+  }
+};
+
+//==============================================================================
+TEST(ContactConstraint, DelassusMatrixAssembly)
+{
+  auto world = std::make_shared<simulation::World>();
+  auto solver = common::make_unique<DelassusMatrixComparison>();
+  auto* comparison = solver.get();
+  world->setConstraintSolver(std::move(solver));
+
+  auto ground = dynamics::Skeleton::create("ground");
+  auto groundBody
+      = ground->createJointAndBodyNodePair<dynamics::WeldJoint>().second;
+  groundBody->createShapeNodeWith<CollisionAspect, DynamicsAspect>(
+      std::make_shared<dynamics::BoxShape>(Eigen::Vector3d(10.0, 10.0, 1.0)));
+  groundBody->getParentJoint()->setTransformFromParentBodyNode(
+      Eigen::Translation3d(0.0, 0.0, -0.5) * Eigen::Isometry3d::Identity());
+  world->addSkeleton(ground);
+
+  // Stack of boxes
+  for (std::size_t i = 0u; i < 3u; ++i)
+  {
+    auto box = dynamics::Skeleton::create("box" + std::to_string(i));
+    auto body = box->createJointAndBodyNodePair<dynamics::FreeJoint>().second;
+    body->createShapeNodeWith<CollisionAspect, DynamicsAspect>(
+        std::make_shared<dynamics::BoxShape>(Eigen::Vector3d(0.4, 0.4, 0.4)));
+    box->setPosition(3, 0.01 * i);
+    box->setPosition(5, 0.19 + 0.39 * i);
+    box->setPosition(0, 0.1 * i);
+    world->addSkeleton(box);
+  }
+
+  // Chain falling onto the ground with joint limits and joint friction
+  auto chain = dynamics::Skeleton::create("chain");
+  dynamics::BodyNode* parent = nullptr;
+  for (std::size_t i = 0u; i < 3u; ++i)
+  {
+    dynamics::RevoluteJoint::Properties properties;
+    properties.mAxis = Eigen::Vector3d::UnitY();
+    properties.mT_ParentBodyToJoint.translation()
+        = parent ? Eigen::Vector3d(0.0, 0.0, -0.5)
+                 : Eigen::Vector3d(1.5, 0.0, 0.6);
+    properties.mT_ChildBodyToJoint.translation()
+        = Eigen::Vector3d(0.0, 0.0, 0.0);
+    properties.mIsPositionLimitEnforced = true;
+    properties.mPositionLowerLimits[0] = -0.3;
+    properties.mPositionUpperLimits[0] = 0.3;
+    properties.mFrictions[0] = 0.1;
+
+    const dynamics::BodyNode::AspectProperties bodyProperties(
+        "link" + std::to_string(i));
+    dynamics::BodyNode* body = nullptr;
+    if (parent)
+    {
+      properties.mName = "joint" + std::to_string(i);
+      body = chain
+                 ->createJointAndBodyNodePair<dynamics::RevoluteJoint>(
+                     parent, properties, bodyProperties)
+                 .second;
+    }
+    else
+    {
+      body = chain
+                 ->createJointAndBodyNodePair<dynamics::FreeJoint>(
+                     nullptr,
+                     dynamics::FreeJoint::Properties(
+                         dynamics::Joint::Properties("root")),
+                     bodyProperties)
+                 .second;
+    }
+    body->createShapeNodeWith<CollisionAspect, DynamicsAspect>(
+        std::make_shared<dynamics::BoxShape>(Eigen::Vector3d(0.1, 0.1, 0.5)));
+    parent = body;
+  }
+  chain->setPosition(3, 1.5);
+  chain->setPosition(5, 0.6);
+  chain->setPosition(1, 0.7);
+  chain->setVelocity(6, 2.0);
+  world->addSkeleton(chain);
+
+  for (std::size_t i = 0u; i < 200u; ++i)
+    world->step();
+
+  EXPECT_GT(comparison->mNumComparedGroups, 0u);
+}
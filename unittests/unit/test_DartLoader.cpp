@@ -87,6 +87,29 @@ TEST(DartLoader, parseWorld)
       loader.parseWorld("dart://sample/urdf/test/testWorld.urdf"));
 }
 
+TEST(DartLoader, parseWorldInParallel)
+{
+  DartLoader loader;
+  const auto serialWorld
+      = loader.parseWorld("dart://sample/urdf/test/testWorld.urdf");
+  const auto parallelWorld
+      = loader.parseWorld("dart://sample/urdf/test/testWorld.urdf", nullptr, 0u);
+
+  ASSERT_TRUE(nullptr != serialWorld);
+  ASSERT_TRUE(nullptr != parallelWorld);
+  ASSERT_EQ(serialWorld->getNumSkeletons(), parallelWorld->getNumSkeletons());
+
+  for (std::size_t i = 0; i < serialWorld->getNumSkeletons(); ++i)
+  {
+    const auto serialSkel = serialWorld->getSkeleton(i);
+    const auto parallelSkel = parallelWorld->getSkeleton(i);
+    EXPECT_EQ(serialSkel->getName(), parallelSkel->getName());
+    EXPECT_EQ(serialSkel->getNumBodyNodes(), parallelSkel->getNumBodyNodes());
+    EXPECT_TRUE(serialSkel->getPositions().isApprox(
+        parallelSkel->getPositions()));
+  }
+}
+
 TEST(DartLoader, parseJointProperties)
 {
   std::string urdfStr =
@@ -180,6 +180,62 @@ TEST(Lemke, Lemke_12D)
   EXPECT_TRUE(dart::lcpsolver::validate(A,(*f),b));
 }
 
+//==============================================================================
+TEST(Lemke, LemkeSolverLarge)
+{
+  // Large enough for the basis to be refactorized during the pivoting
+  const int n = 120;
+  const Eigen::MatrixXd J = Eigen::MatrixXd::Random(n, n + 6);
+  const Eigen::MatrixXd A
+      = J * J.transpose() + 1e-3 * Eigen::MatrixXd::Identity(n, n);
+  const Eigen::VectorXd b = Eigen::VectorXd::Random(n);
+
+  dart::lcpsolver::LemkeSolver solver;
+  Eigen::VectorXd f;
+  EXPECT_EQ(solver.solve(A, b, &f), 0);
+  EXPECT_TRUE(dart::lcpsolver::validate(A, f, b));
+
+  Eigen::VectorXd expected;
+  EXPECT_EQ(dart::lcpsolver::Lemke(A, b, &expected), 0);
+  EXPECT_TRUE(f.isApprox(expected));
+}
+
+//==============================================================================
+TEST(Lemke, LemkeSolverWarmStart)
+{
+  const int n = 30;
+  const Eigen::MatrixXd J = Eigen::MatrixXd::Random(n, n + 6);
+  const Eigen::MatrixXd A
+      = J * J.transpose() + 1e-3 * Eigen::MatrixXd::Identity(n, n);
+  const Eigen::VectorXd b = Eigen::VectorXd::Random(n);
+
+  dart::lcpsolver::LemkeSolver solver;
+  Eigen::VectorXd f;
+  ASSERT_EQ(solver.solve(A, b, &f), 0);
+  const Eigen::VectorXd solution = f;
+  const std::vector<int> basis = solver.getBasis();
+  EXPECT_FALSE(basis.empty());
+
+  // The final basis of the previous solve is already a solution, so no pivot
+  // is needed
+  solver.setMaxIterations(0);
+  solver.setWarmStartBasis(basis);
+  EXPECT_EQ(solver.solve(A, b, &f), 0);
+  EXPECT_TRUE(f.isApprox(solution));
+
+  // Without warm start, the solver needs to pivot. A failed solve returns a
+  // zero vector.
+  EXPECT_NE(solver.solve(A, b, &f), 0);
+  EXPECT_EQ(n, f.size());
+  EXPECT_TRUE(f.isZero(0.0));
+
+  // Invalid warm start bases are ignored
+  solver.setMaxIterations(1000);
+  solver.setWarmStartBasis({-1, n, 0, 0});
+  EXPECT_EQ(solver.solve(A, b, &f), 0);
+  EXPECT_TRUE(dart::lcpsolver::validate(A, f, b));
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
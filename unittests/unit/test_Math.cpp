@@ -37,6 +37,7 @@
 #include "dart/common/Timer.hpp"
 #include "dart/math/Geometry.hpp"
 #include "dart/math/Helpers.hpp"
+#include "dart/math/detail/GeometrySimd.hpp"
 #include "dart/dynamics/RevoluteJoint.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/simulation/World.hpp"
@@ -1294,3 +1295,126 @@ TEST(MATH, PerformanceComparisonOfAdTJac)
   // Note: The best function for dynamic size Jacobian is AdTJac2, and the best
   //       function for fixed size Jacobian is AdTJac3
 }
+
+//==============================================================================
+TEST(MATH, Avx2SpatialKernels)
+{
+  if (!math::detail::isAvx2Supported())
+  {
+    std::cout << "AVX2/FMA is not supported on this machine. Skipping.\n";
+    return;
+  }
+
+  const bool wasEnabled = math::detail::isAvx2Enabled();
+
+  for (int i = 0; i < 100; ++i)
+  {
+    const Isometry3d T = expMap(Vector6d::Random());
+    const Vector6d V = Vector6d::Random();
+    const Vector6d F = Vector6d::Random();
+    const Matrix6d M = Matrix6d::Random();
+    const Matrix6d I = M * M.transpose();
+
+    math::detail::setAvx2Enabled(false);
+    EXPECT_FALSE(math::detail::isAvx2Enabled());
+    const Vector6d AdT1 = AdT(T, V);
+    const Vector6d AdInvT1 = AdInvT(T, V);
+    const Vector6d dAdInvT1 = dAdInvT(T, F);
+    const Vector6d ad1 = ad(V, F);
+    const Vector6d dad1 = dad(V, F);
+    const Matrix6d I1 = transformInertia(T, I);
+
+    math::detail::setAvx2Enabled(true);
+    EXPECT_TRUE(math::detail::isAvx2Enabled());
+    EXPECT_TRUE(equals(AdT(T, V), AdT1, 1e-12));
+    EXPECT_TRUE(equals(AdInvT(T, V), AdInvT1, 1e-12));
+    EXPECT_TRUE(equals(dAdInvT(T, F), dAdInvT1, 1e-12));
+    EXPECT_TRUE(equals(ad(V, F), ad1, 1e-12));
+    EXPECT_TRUE(equals(dad(V, F), dad1, 1e-12));
+    EXPECT_TRUE(equals(transformInertia(T, I), I1, 1e-12));
+  }
+
+  math::detail::setAvx2Enabled(wasEnabled);
+}
+
+//==============================================================================
+TEST(MATH, PerformanceComparisonOfAvx2SpatialKernels)
+{
+  if (!math::detail::isAvx2Supported())
+  {
+    std::cout << "AVX2/FMA is not supported on this machine. Skipping.\n";
+    return;
+  }
+
+#ifndef NDEBUG
+  const int testCount = 1e+2;
+#else
+  const int testCount = 1e+6;
+#endif
+
+  const bool wasEnabled = math::detail::isAvx2Enabled();
+
+  const Isometry3d T = expMap(Vector6d::Random());
+  const Vector6d V = Vector6d::Random();
+  const Matrix6d M = Matrix6d::Random();
+  const Matrix6d I = M * M.transpose();
+
+  // Chain of 20 revolute joints for timing the forward dynamics
+  SkeletonPtr skel = Skeleton::create();
+  BodyNode* parent = nullptr;
+  for (int i = 0; i < 20; ++i)
+  {
+    RevoluteJoint::Properties properties;
+    properties.mAxis = Vector3d::Random().normalized();
+    properties.mT_ParentBodyToJoint.translation() = Vector3d(0.0, 0.0, 0.5);
+    parent = skel->createJointAndBodyNodePair<RevoluteJoint>(
+        parent, properties).second;
+  }
+  const VectorXd q = VectorXd::Random(skel->getNumDofs());
+  skel->setVelocities(VectorXd::Random(skel->getNumDofs()));
+
+  for (const bool enabled : {false, true})
+  {
+    math::detail::setAvx2Enabled(enabled);
+    const std::string suffix = enabled ? " - AVX2" : " - scalar";
+
+    Vector6d res = Vector6d::Zero();
+    Timer tAdT("AdT" + suffix);
+    tAdT.start();
+    for (int i = 0; i < testCount; ++i)
+      res += AdT(T, V);
+    tAdT.stop();
+
+    Timer tdAdInvT("dAdInvT" + suffix);
+    tdAdInvT.start();
+    for (int i = 0; i < testCount; ++i)
+      res += dAdInvT(T, V);
+    tdAdInvT.stop();
+
+    Matrix6d resI = Matrix6d::Zero();
+    Timer tInertia("transformInertia" + suffix);
+    tInertia.start();
+    for (int i = 0; i < testCount; ++i)
+      resI += transformInertia(T, I);
+    tInertia.stop();
+
+    Timer tFD("computeForwardDynamics" + suffix);
+    tFD.start();
+    for (int i = 0; i < testCount / 100; ++i)
+    {
+      skel->setPositions(q);
+      skel->computeForwardDynamics();
+    }
+    tFD.stop();
+
+    EXPECT_FALSE(isNan(res));
+    EXPECT_FALSE(isNan(resI));
+
+    tAdT.print();
+    tdAdInvT.print();
+    tInertia.print();
+    tFD.print();
+  }
+
+  math::detail::setAvx2Enabled(wasEnabled);
+}
@@ -9,6 +9,8 @@
 #include <gtest/gtest.h>
 #include <Eigen/Core>
 #include <dart/dart.hpp>
+#include "dart/planning/KdTree.hpp"
+#include "dart/planning/RRT.hpp"
 #if HAVE_FLANN
 #include <flann/flann.hpp>
 #endif // HAVE_FLANN
@@ -49,3 +51,152 @@ TEST(NEAREST_NEIGHBOR, 2D) {
     EXPECT_TRUE(equality);
 }
 #endif // HAVE_FLANN
+
+/* ********************************************************************************************* */
+TEST(NEAREST_NEIGHBOR, KdTree2D) {
+
+    // Same points and query as above
+    dart::planning::KdTree tree(2);
+    Eigen::Vector2d p1 (-3.04159, -3.04159), p2 (-2.96751, -2.97443), p3 (-2.91946, -2.88672);
+    EXPECT_EQ(0u, tree.addPoint(p1));
+    EXPECT_EQ(1u, tree.addPoint(p2));
+    EXPECT_EQ(2u, tree.addPoint(p3));
+    EXPECT_EQ(3u, tree.getNumPoints());
+
+    Eigen::Vector2d sample (-2.26654, 2.2874);
+    double distance;
+    int nearest = tree.getNearest(sample, &distance);
+    EXPECT_EQ(2, nearest);
+    EXPECT_NEAR((sample - p3).squaredNorm(), distance, 1e-12);
+    EXPECT_TRUE(equals(Eigen::VectorXd(tree.getPoint(nearest)), Eigen::VectorXd(p3), 1e-12));
+}
+
+/* ********************************************************************************************* */
+TEST(NEAREST_NEIGHBOR, KdTreeBruteForce) {
+
+    // Compare against a linear search, including points that lie on a line as created by
+    // repeated RRT steps towards the same target
+    const std::size_t dim = 5;
+    dart::planning::KdTree tree(dim);
+    EXPECT_EQ(-1, tree.getNearest(Eigen::VectorXd::Zero(dim)));
+
+    std::vector<Eigen::VectorXd> points;
+    for(std::size_t i = 0; i < 1000; ++i) {
+        Eigen::VectorXd point = Eigen::VectorXd::Random(dim);
+        if(i % 2 == 0) point = Eigen::VectorXd::Constant(dim, 0.001 * i);
+        points.push_back(point);
+        tree.addPoint(point);
+    }
+
+    for(std::size_t i = 0; i < 200; ++i) {
+        Eigen::VectorXd query = 1.2 * Eigen::VectorXd::Random(dim);
+        int expected = 0;
+        for(std::size_t j = 1; j < points.size(); ++j) {
+            if((points[j] - query).squaredNorm() < (points[expected] - query).squaredNorm())
+                expected = j;
+        }
+        EXPECT_EQ(expected, tree.getNearest(query));
+    }
+}
+
+/* ********************************************************************************************* */
+/// An RRT that treats the half-space x > 0 as an obstacle on top of the obstacles in the world
+class HalfSpaceRRT : public dart::planning::RRT {
+public:
+    using RRT::RRT;
+
+    bool checkCollisions(const Eigen::VectorXd &c) override {
+        return c[0] > 0.0 || RRT::checkCollisions(c);
+    }
+};
+
+/* ********************************************************************************************* */
+TEST(NEAREST_NEIGHBOR, ParallelRRT) {
+
+    using namespace dart;
+
+    // A small box that moves in the xy-plane around a large box
+    dynamics::SkeletonPtr robot = createBox(Vector3d(0.2, 0.2, 0.2));
+    std::vector<std::size_t> dofs = {3, 4};
+    for(std::size_t i = 0; i < dofs.size(); ++i)
+        robot->getDof(dofs[i])->setPositionLimits(-3.0, 3.0);
+
+    simulation::WorldPtr world = simulation::World::create();
+    world->addSkeleton(robot);
+    world->addSkeleton(createBox(Vector3d(1.0, 1.0, 1.0)));
+
+    const double stepSize = 0.05;
+    Eigen::Vector2d start(-2.0, -2.0), goal(2.0, 2.0);
+
+    // Grow a single tree with several threads. The threads that are already stepping when the
+    // tree reaches the size may add a node each.
+    planning::RRT rrt(world, robot, dofs, start, stepSize);
+    const std::size_t numAdded = rrt.growParallel(200, 4);
+    EXPECT_EQ(rrt.getSize(), numAdded + 1u);
+    EXPECT_LE(200u, rrt.getSize());
+    EXPECT_GE(203u, rrt.getSize());
+    for(std::size_t i = 1; i < rrt.getSize(); ++i) {
+        int parent = rrt.parentVector[i];
+        ASSERT_LE(0, parent);
+        EXPECT_NEAR(stepSize, (rrt.getConfig(i) - rrt.getConfig(parent)).norm(), 1e-9);
+    }
+
+    // The parallel growth goes through the overridden collision check
+    HalfSpaceRRT halfSpaceRrt(world, robot, dofs, start, stepSize);
+    halfSpaceRrt.growParallel(200, 4);
+    EXPECT_LE(200u, halfSpaceRrt.getSize());
+    for(std::size_t i = 0; i < halfSpaceRrt.getSize(); ++i)
+        EXPECT_GE(0.0, halfSpaceRrt.getConfig(i)[0]);
+
+    // Grow two trees towards each other and trace the path through the meeting nodes
+    planning::RRT startRrt(world, robot, dofs, start, stepSize);
+    planning::RRT goalRrt(world, robot, dofs, goal, stepSize);
+    int startNode, goalNode;
+    ASSERT_TRUE(planning::RRT::connectParallel(startRrt, goalRrt, 10000, startNode, goalNode));
+
+    std::list<Eigen::VectorXd> path;
+    startRrt.tracePath(startNode, path);
+    goalRrt.tracePath(goalNode, path, true);
+    EXPECT_TRUE(equals(path.front(), Eigen::VectorXd(start)));
+    EXPECT_TRUE(equals(path.back(), Eigen::VectorXd(goal)));
+    for(auto it = path.begin(), next = ++path.begin(); next != path.end(); ++it, ++next) {
+        EXPECT_GE(stepSize + 1e-9, (*next - *it).norm());
+        robot->setPositions(dofs, *it);
+        EXPECT_FALSE(world->checkCollision());
+    }
+}
+
+/* ********************************************************************************************* */
+TEST(NEAREST_NEIGHBOR, SeededRRT) {
+
+    using namespace dart;
+
+    dynamics::SkeletonPtr robot = createBox(Vector3d(0.2, 0.2, 0.2));
+    std::vector<std::size_t> dofs = {3, 4};
+    for(std::size_t i = 0; i < dofs.size(); ++i)
+        robot->getDof(dofs[i])->setPositionLimits(-3.0, 3.0);
+
+    simulation::WorldPtr world = simulation::World::create();
+    world->addSkeleton(robot);
+
+    const Eigen::Vector2d start(0.0, 0.0);
+    auto growTree = [&](unsigned int seed, unsigned int streamId) {
+        math::Random::setSeed(seed);
+        planning::RRT rrt(world, robot, dofs, start, 0.05, streamId);
+        for(int i = 0; i < 50; ++i)
+            rrt.tryStep();
+        std::vector<Eigen::VectorXd> configs;
+        for(std::size_t i = 0; i < rrt.getSize(); ++i)
+            configs.push_back(rrt.getConfig(static_cast<int>(i)));
+        return configs;
+    };
+
+    // The same seed and stream id grow the same tree
+    const std::vector<Eigen::VectorXd> tree = growTree(3u, 0u);
+    ASSERT_LT(1u, tree.size());
+    EXPECT_TRUE(tree == growTree(3u, 0u));
+
+    // Another stream id or seed grows another tree
+    EXPECT_FALSE(tree == growTree(3u, 1u));
+    EXPECT_FALSE(tree == growTree(4u, 0u));
+}
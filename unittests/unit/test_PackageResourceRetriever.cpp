@@ -355,3 +355,47 @@ TEST(PackageResourceRetriever, retrieve_FallsBackOnSecondUri)
   EXPECT_EQ(expected1, mockRetriever->mRetrieve[0]);
   EXPECT_EQ(expected2, mockRetriever->mRetrieve[1]);
 }
+
+TEST(PackageResourceRetriever, retrieve_RemembersResolvedPackagePath)
+{
+#ifdef _WIN32
+  const char* expected1 = "file:///" DART_DATA_LOCAL_PATH"test1/foo";
+  const char* expected2 = "file:///" DART_DATA_LOCAL_PATH"test2/foo";
+#else
+  const char* expected1 = "file://" DART_DATA_LOCAL_PATH"test1/foo";
+  const char* expected2 = "file://" DART_DATA_LOCAL_PATH"test2/foo";
+#endif
+
+  // Only has the files of the second package directory.
+  struct SecondPathRetriever : public PresentResourceRetriever
+  {
+    explicit SecondPathRetriever(const std::string& path) : mPath(path) {}
+
+    ResourcePtr retrieve(const Uri& _uri) override
+    {
+      const auto resource = PresentResourceRetriever::retrieve(_uri);
+      return _uri.toString() == mPath ? resource : nullptr;
+    }
+
+    std::string mPath;
+  };
+
+  auto mockRetriever = std::make_shared<SecondPathRetriever>(expected2);
+  PackageResourceRetriever retriever(mockRetriever);
+  retriever.addPackageDirectory("test", DART_DATA_LOCAL_PATH"test1");
+  retriever.addPackageDirectory("test", DART_DATA_LOCAL_PATH"test2");
+
+  const auto uri = Uri::createFromString("package://test/foo");
+  EXPECT_TRUE(retriever.retrieve(uri) != nullptr);
+  EXPECT_TRUE(retriever.retrieve(uri) != nullptr);
+  ASSERT_EQ(3u, mockRetriever->mRetrieve.size());
+  EXPECT_EQ(expected1, mockRetriever->mRetrieve[0]);
+  EXPECT_EQ(expected2, mockRetriever->mRetrieve[1]);
+  EXPECT_EQ(expected2, mockRetriever->mRetrieve[2]);
+
+  // Adding a package directory may change the resolution.
+  retriever.addPackageDirectory("test", DART_DATA_LOCAL_PATH"test3");
+  EXPECT_TRUE(retriever.retrieve(uri) != nullptr);
+  ASSERT_EQ(5u, mockRetriever->mRetrieve.size());
+  EXPECT_EQ(expected1, mockRetriever->mRetrieve[3]);
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <thread>
+#include <gtest/gtest.h>
+#include "dart/planning/PathFollowingTrajectory.hpp"
+#include "TestHelpers.hpp"
+
+using namespace dart;
+
+//==============================================================================
+std::list<Eigen::VectorXd> createRandomWaypoints(
+    std::size_t numWaypoints, std::size_t numDofs)
+{
+  std::list<Eigen::VectorXd> waypoints;
+  for (std::size_t i = 0; i < numWaypoints; ++i)
+    waypoints.push_back(Eigen::VectorXd::Random(numDofs));
+
+  return waypoints;
+}
+
+//==============================================================================
+TEST(PathFollowingTrajectory, Sample)
+{
+  std::srand(0);
+  const std::size_t numDofs = 3;
+  planning::Path path(createRandomWaypoints(10, numDofs), 0.1);
+  planning::PathFollowingTrajectory trajectory(
+      path,
+      Eigen::VectorXd::Constant(numDofs, 1.0),
+      Eigen::VectorXd::Constant(numDofs, 1.0));
+  ASSERT_TRUE(trajectory.isValid());
+
+  const double duration = trajectory.getDuration();
+  EXPECT_TRUE(equals(trajectory.getPosition(0.0), path.getConfig(0.0)));
+  EXPECT_TRUE(
+      equals(trajectory.getPosition(duration), path.getConfig(path.getLength())));
+
+  // Sorted times, followed by times in random order and out of range
+  Eigen::VectorXd times(150);
+  times.head(100).setLinSpaced(0.0, duration);
+  times.tail(50) = 0.5 * duration * (Eigen::VectorXd::Random(50).array() + 1.0);
+  times[120] = 2.0 * duration;
+
+  Eigen::MatrixXd positions;
+  Eigen::MatrixXd velocities;
+  trajectory.sample(times, positions, velocities);
+  ASSERT_EQ(numDofs, static_cast<std::size_t>(positions.rows()));
+  ASSERT_EQ(times.size(), positions.cols());
+  ASSERT_EQ(times.size(), velocities.cols());
+
+  const Eigen::MatrixXd positionsOnly = trajectory.sample(times);
+  for (int i = 0; i < times.size(); ++i)
+  {
+    const Eigen::VectorXd position = trajectory.getPosition(times[i]);
+    EXPECT_TRUE(equals(position, Eigen::VectorXd(positions.col(i))));
+    EXPECT_TRUE(equals(position, Eigen::VectorXd(positionsOnly.col(i))));
+    EXPECT_TRUE(equals(
+        trajectory.getVelocity(times[i]), Eigen::VectorXd(velocities.col(i))));
+  }
+}
+
+//==============================================================================
+TEST(PathFollowingTrajectory, ConcurrentSampling)
+{
+  std::srand(1);
+  const std::size_t numDofs = 4;
+  planning::Path path(createRandomWaypoints(20, numDofs), 0.05);
+  const planning::PathFollowingTrajectory trajectory(
+      path,
+      Eigen::VectorXd::Constant(numDofs, 2.0),
+      Eigen::VectorXd::Constant(numDofs, 3.0));
+  ASSERT_TRUE(trajectory.isValid());
+
+  Eigen::VectorXd times(500);
+  times.setLinSpaced(0.0, trajectory.getDuration());
+  const Eigen::MatrixXd expected = trajectory.sample(times);
+
+  // Each thread samples the times in a different order
+  const std::size_t numThreads = 4;
+  std::vector<Eigen::MatrixXd> results(numThreads);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < numThreads; ++i)
+  {
+    threads.emplace_back([&, i]() {
+      results[i].resize(numDofs, times.size());
+      for (int j = 0; j < times.size(); ++j)
+      {
+        const int k = (i % 2 == 0) ? j : times.size() - 1 - j;
+        results[i].col(k) = trajectory.getPosition(times[k]);
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+
+  for (std::size_t i = 0; i < numThreads; ++i)
+    EXPECT_TRUE(equals(expected, results[i]));
+}
+
+//==============================================================================
+TEST(PathFollowingTrajectory, MatchesReferenceTrajectory)
+{
+  // Long straight segments with velocity and acceleration limited phases
+  std::list<Eigen::VectorXd> waypoints;
+  waypoints.push_back(Eigen::Vector3d(0.0, 0.0, 0.0));
+  waypoints.push_back(Eigen::Vector3d(4.0, 1.0, -2.0));
+  waypoints.push_back(Eigen::Vector3d(4.5, 3.0, -1.5));
+  waypoints.push_back(Eigen::Vector3d(1.0, 2.5, 0.5));
+  waypoints.push_back(Eigen::Vector3d(1.2, -0.5, 0.0));
+  waypoints.push_back(Eigen::Vector3d(-3.0, -1.0, 2.0));
+
+  planning::Path path(waypoints, 0.1);
+  planning::PathFollowingTrajectory trajectory(
+      path, Eigen::Vector3d(1.0, 0.8, 1.5), Eigen::Vector3d(2.0, 1.0, 1.5));
+  ASSERT_TRUE(trajectory.isValid());
+
+  // Computed by the implementation that integrated every segment with fixed
+  // time steps. The closed-form integration of the straight segments places
+  // the steps differently, which changes the result far below the distance
+  // covered in one time step.
+  const double tolerance = 1e-5;
+  const double referenceDuration = 19.338847142389969;
+  const double referencePositions[11][3] = {
+      {0.0000000000, 0.0000000000, 0.0000000000},
+      {1.6838847142, 0.4209711786, -0.8419423571},
+      {3.6176736280, 0.9044184070, -1.8088368140},
+      {4.2946537827, 2.1786151309, -1.7053462173},
+      {3.9353233054, 2.9193319008, -1.1773276031},
+      {2.0014385911, 2.6430626559, -0.0722506235},
+      {1.0371484114, 1.9427738296, 0.4071289716},
+      {1.1402889295, 0.3956660582, 0.1492776764},
+      {0.6177694285, -0.5693131633, 0.2772526531},
+      {-1.3161152858, -0.7995375340, 1.1981501361},
+      {-3.0000000000, -1.0000000000, 2.0000000000}};
+
+  EXPECT_NEAR(referenceDuration, trajectory.getDuration(), tolerance);
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    const Eigen::Vector3d expected(referencePositions[i]);
+    const Eigen::VectorXd position
+        = trajectory.getPosition(referenceDuration * i / 10.0);
+    EXPECT_TRUE(equals(expected, Eigen::Vector3d(position), tolerance));
+  }
+  EXPECT_TRUE(equals(
+      Eigen::Vector3d(referencePositions[10]),
+      Eigen::Vector3d(trajectory.getPosition(trajectory.getDuration())),
+      tolerance));
+}
@@ -30,6 +30,7 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <thread>
 #include <gtest/gtest.h>
 #include <dart/math/Random.hpp>
 #include "TestHelpers.hpp"
@@ -320,3 +321,107 @@ TEST(Random, SetSeed)
     EXPECT_EQ(third[i], math::Random::uniform(min, max));
   }
 }
+
+//==============================================================================
+TEST(Random, StreamReproducibility)
+{
+  math::RandomStream stream1(7u, 3u);
+  math::RandomStream stream2 = math::Random::createStream(3u);
+  stream2.setSeed(7u, 3u);
+  math::RandomStream other(7u, 4u);
+
+  EXPECT_EQ(stream1.getSeed(), 7u);
+  EXPECT_EQ(stream1.getStreamId(), 3u);
+
+  bool differs = false;
+  for (int i = 0; i < 10; ++i)
+  {
+    const double value = stream1.uniform(0.0, 1.0);
+    EXPECT_EQ(value, stream2.uniform(0.0, 1.0));
+    if (value != other.uniform(0.0, 1.0))
+      differs = true;
+  }
+  EXPECT_TRUE(differs);
+
+  // Sampling from a stream doesn't advance the global generator
+  math::Random::setSeed(5u);
+  const double expected = math::Random::uniform(0.0, 1.0);
+  math::Random::setSeed(5u);
+  stream1.normal(0.0, 1.0);
+  EXPECT_EQ(expected, math::Random::uniform(0.0, 1.0));
+}
+
+//==============================================================================
+TEST(Random, StreamsInThreads)
+{
+  const std::size_t numStreams = 8u;
+  const int size = 1000;
+
+  auto sample = [&](std::size_t streamId, Eigen::VectorXd& out) {
+    math::RandomStream stream(42u, static_cast<unsigned int>(streamId));
+    out.resize(size);
+    stream.fillNormal(out, 0.0, 1.0);
+  };
+
+  std::vector<Eigen::VectorXd> serial(numStreams);
+  for (std::size_t i = 0u; i < numStreams; ++i)
+    sample(i, serial[i]);
+
+  std::vector<Eigen::VectorXd> parallel(numStreams);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0u; i < numStreams; ++i)
+    threads.emplace_back(sample, i, std::ref(parallel[i]));
+  for (auto& thread : threads)
+    thread.join();
+
+  for (std::size_t i = 0u; i < numStreams; ++i)
+    EXPECT_TRUE(serial[i] == parallel[i]);
+}
+
+//==============================================================================
+TEST(Random, FillMatrix)
+{
+  math::RandomStream stream(1u);
+
+  Eigen::MatrixXd uniformd(100, 100);
+  stream.fillUniform(uniformd, -2.0, 3.0);
+  EXPECT_TRUE((uniformd.array() >= -2.0).all());
+  EXPECT_TRUE((uniformd.array() < 3.0).all());
+  EXPECT_NEAR(uniformd.mean(), 0.5, 0.05);
+
+  Eigen::Matrix<int, 4, 5> uniformi;
+  math::Random::fillUniform(uniformi, -3, 3);
+  EXPECT_TRUE((uniformi.array() >= -3).all());
+  EXPECT_TRUE((uniformi.array() <= 3).all());
+
+  Eigen::MatrixXd normald(100, 100);
+  stream.fillNormal(normald, 1.0, 2.0);
+  const double mean = normald.mean();
+  const double variance
+      = (normald.array() - mean).square().sum() / (normald.size() - 1);
+  EXPECT_NEAR(mean, 1.0, 0.1);
+  EXPECT_NEAR(variance, 4.0, 0.2);
+
+  // Sizes that don't fill the last block or the last pair of normal numbers
+  Eigen::VectorXd oddNormal(1001);
+  stream.fillNormal(oddNormal, -1.0, 0.5);
+  EXPECT_TRUE(oddNormal.allFinite());
+  EXPECT_NEAR(oddNormal.mean(), -1.0, 0.1);
+  EXPECT_FALSE(oddNormal.tail<2>().isZero());
+
+  // Blocks are filled in place, including temporary ones
+  Eigen::MatrixXf matf = Eigen::MatrixXf::Zero(4, 4);
+  math::Random::fillNormal(matf.topLeftCorner(2, 2), 0.0f, 1.0f);
+  EXPECT_TRUE(matf.bottomRows(2).isZero());
+  EXPECT_FALSE(matf.topLeftCorner(2, 2).isZero());
+  stream.fillUniform(matf.col(3), 5.0f, 6.0f);
+  EXPECT_TRUE((matf.col(3).array() >= 5.0f).all());
+  EXPECT_TRUE(matf.bottomLeftCorner(2, 3).isZero());
+
+  // The storage order doesn't change the sampled values
+  Eigen::Matrix<double, 3, 4, Eigen::RowMajor> rowMajor;
+  Eigen::Matrix<double, 3, 4> colMajor;
+  math::RandomStream(9u).fillUniform(rowMajor, 0.0, 1.0);
+  math::RandomStream(9u).fillUniform(colMajor, 0.0, 1.0);
+  EXPECT_TRUE(rowMajor == colMajor);
+}
@@ -34,6 +34,7 @@
 #include <gtest/gtest.h>
 #include "TestHelpers.hpp"
 
+#include "dart/common/Timer.hpp"
 #include "dart/dynamics/SoftBodyNode.hpp"
 #include "dart/dynamics/RevoluteJoint.hpp"
 #include "dart/dynamics/PlanarJoint.hpp"
@@ -120,6 +121,45 @@ TEST(SdfParser, ParsingSDFFiles)
   }
 }
 
+//==============================================================================
+TEST(SdfParser, ParallelWorldLoading)
+{
+  const std::string worldFile = "dart://sample/sdf/benchmark.world";
+
+  common::Timer serialTimer("Serial loading of " + worldFile);
+  serialTimer.start();
+  WorldPtr serialWorld = SdfParser::readWorld(worldFile);
+  serialTimer.stop();
+
+  common::Timer parallelTimer("Parallel loading of " + worldFile);
+  parallelTimer.start();
+  WorldPtr parallelWorld = SdfParser::readWorld(worldFile, nullptr, 0u);
+  parallelTimer.stop();
+
+  serialTimer.print();
+  parallelTimer.print();
+
+  ASSERT_NE(serialWorld, nullptr);
+  ASSERT_NE(parallelWorld, nullptr);
+  ASSERT_EQ(serialWorld->getNumSkeletons(), parallelWorld->getNumSkeletons());
+
+  // Models must be added in document order
+  for (std::size_t i = 0u; i < serialWorld->getNumSkeletons(); ++i)
+  {
+    const SkeletonPtr serialSkel = serialWorld->getSkeleton(i);
+    const SkeletonPtr parallelSkel = parallelWorld->getSkeleton(i);
+
+    EXPECT_EQ(serialSkel->getName(), parallelSkel->getName());
+    EXPECT_EQ(serialSkel->getNumBodyNodes(), parallelSkel->getNumBodyNodes());
+    EXPECT_EQ(serialSkel->getNumDofs(), parallelSkel->getNumDofs());
+    EXPECT_TRUE(equals(serialSkel->getPositions(),
+                       parallelSkel->getPositions()));
+  }
+
+  for (auto i = 0u; i < 10u; ++i)
+    parallelWorld->step();
+}
+
 //==============================================================================
 TEST(SdfParser, ReadMaterial)
 {
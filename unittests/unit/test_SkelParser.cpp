@@ -526,3 +526,57 @@ TEST(SkelParser, Shapes)
   skel = world->getSkeleton("mesh skeleton");
   EXPECT_NE(skel, nullptr);
 }
+
+//==============================================================================
+TEST(SkelParser, ParallelWorldLoading)
+{
+  const std::vector<std::string> worldFiles = {
+    "dart://sample/skel/shapes.skel",
+    "dart://sample/skel/mesh_collision.skel",
+    "dart://sample/skel/softBodies.skel"
+  };
+
+  for (const auto& worldFile : worldFiles)
+  {
+    common::Timer serialTimer("Serial loading of " + worldFile);
+    serialTimer.start();
+    WorldPtr serialWorld = SkelParser::readWorld(worldFile);
+    serialTimer.stop();
+
+    common::Timer parallelTimer("Parallel loading of " + worldFile);
+    parallelTimer.start();
+    WorldPtr parallelWorld = SkelParser::readWorld(worldFile, nullptr, 0u);
+    parallelTimer.stop();
+
+    serialTimer.print();
+    parallelTimer.print();
+
+    ASSERT_NE(serialWorld, nullptr);
+    ASSERT_NE(parallelWorld, nullptr);
+    ASSERT_EQ(serialWorld->getNumSkeletons(),
+              parallelWorld->getNumSkeletons());
+
+    // Skeletons must be added in document order regardless of which thread
+    // finished first
+    for (std::size_t i = 0u; i < serialWorld->getNumSkeletons(); ++i)
+    {
+      const SkeletonPtr serialSkel = serialWorld->getSkeleton(i);
+      const SkeletonPtr parallelSkel = parallelWorld->getSkeleton(i);
+
+      EXPECT_EQ(serialSkel->getName(), parallelSkel->getName());
+      ASSERT_EQ(serialSkel->getNumBodyNodes(),
+                parallelSkel->getNumBodyNodes());
+      EXPECT_EQ(serialSkel->getNumDofs(), parallelSkel->getNumDofs());
+      EXPECT_TRUE(equals(serialSkel->getPositions(),
+                         parallelSkel->getPositions()));
+
+      for (std::size_t j = 0u; j < serialSkel->getNumBodyNodes(); ++j)
+      {
+        EXPECT_EQ(serialSkel->getBodyNode(j)->getName(),
+                  parallelSkel->getBodyNode(j)->getName());
+        EXPECT_EQ(serialSkel->getBodyNode(j)->getNumShapeNodes(),
+                  parallelSkel->getBodyNode(j)->getNumShapeNodes());
+      }
+    }
+  }
+}